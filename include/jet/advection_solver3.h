@@ -12,6 +12,7 @@
 #include <jet/constants.h>
 #include <jet/face_centered_grid3.h>
 #include <jet/scalar_grid3.h>
+#include <jet/sparse_scalar_grid3.h>
 #include <limits>
 #include <memory>
 
@@ -56,6 +57,33 @@ class AdvectionSolver3 {
         const ScalarField3& boundarySdf
             = ConstantScalarField3(kMaxD)) = 0;
 
+    //!
+    //! \brief Solves advection equation for given level set within the band.
+    //!
+    //! This function solves the advection equation only for the data points
+    //! whose |input| is less than or equal to \p bandWidth. The rest of the
+    //! output is set to the input clamped to [-bandWidth, bandWidth]. The
+    //! default implementation advects the entire grid and clamps the result,
+    //! while the solvers that support the narrow band only visit the data
+    //! points in the band.
+    //!
+    //! \param input Input level set grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param bandWidth Half-width of the narrow band.
+    //! \param output Output level set grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    virtual void advectNarrowBand(
+        const ScalarGrid3& input,
+        const VectorField3& flow,
+        double dt,
+        double bandWidth,
+        ScalarGrid3* output,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD));
+
     //!
     //! \brief Solves advection equation for given collocated vector grid.
     //!
@@ -109,6 +137,32 @@ class AdvectionSolver3 {
         FaceCenteredGrid3* output,
         const ScalarField3& boundarySdf
             = ConstantScalarField3(kMaxD));
+
+    //!
+    //! \brief Solves advection equation for given sparse scalar grid.
+    //!
+    //! This function solves the advection equation for the sparse scalar grid
+    //! \p input which has the same shape as \p output. Only the tiles of the
+    //! result that differ from the background value of \p input are
+    //! activated in \p output. The default implementation copies \p input
+    //! to a dense grid, advects it, and copies the result back, so it needs
+    //! the memory of the dense grid while advecting. The solvers that support
+    //! the sparse grids advect them without the dense copy.
+    //!
+    //! \param input Input sparse scalar grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param output Output sparse scalar grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    virtual void advect(
+        const SparseScalarGrid3& input,
+        const VectorField3& flow,
+        double dt,
+        SparseScalarGrid3* output,
+        const ScalarField3& boundarySdf
+            = ConstantScalarField3(kMaxD));
 };
 
 //! Shared pointer type for the 3-D advection solver.
@@ -0,0 +1,97 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_ALIGNED_ALLOCATOR_H_
+#define INCLUDE_JET_ALIGNED_ALLOCATOR_H_
+
+#include <jet/macros.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#ifdef JET_WINDOWS
+#include <malloc.h>
+#endif
+
+namespace jet {
+
+//! Alignment (in bytes) used for SIMD-friendly arrays, which is the cache line
+//! size of most x86 and ARM processors.
+constexpr size_t kSimdAlignment = 64;
+
+//!
+//! \brief Standard allocator with custom alignment.
+//!
+//! This allocator can be used with std::vector to allocate arrays whose first
+//! element is aligned to \p Alignment bytes, such as the arrays loaded by
+//! SIMD instructions.
+//!
+//! \tparam T Value type.
+//! \tparam Alignment Alignment in bytes. Must be a power of two and a multiple
+//!                   of sizeof(void*).
+//!
+template <typename T, size_t Alignment = kSimdAlignment>
+class AlignedAllocator {
+ public:
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() {}
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    //! Allocates memory for \p n elements.
+    T* allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+
+        void* ptr = nullptr;
+#ifdef JET_WINDOWS
+        ptr = _aligned_malloc(n * sizeof(T), Alignment);
+#else
+        if (posix_memalign(&ptr, Alignment, n * sizeof(T)) != 0) {
+            ptr = nullptr;
+        }
+#endif
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<T*>(ptr);
+    }
+
+    //! Deallocates the memory allocated by this allocator.
+    void deallocate(T* ptr, size_t) {
+#ifdef JET_WINDOWS
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+    }
+};
+
+template <typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment>&,
+                const AlignedAllocator<U, Alignment>&) {
+    return true;
+}
+
+template <typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment>&,
+                const AlignedAllocator<U, Alignment>&) {
+    return false;
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_ALIGNED_ALLOCATOR_H_
@@ -0,0 +1,134 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_AMG_H_
+#define INCLUDE_JET_AMG_H_
+
+#include <jet/matrix_csr.h>
+#include <jet/vector_n.h>
+
+#include <vector>
+
+namespace jet {
+
+//! Algebraic multigrid parameters.
+struct AmgParameters {
+    //! Max number of levels including the finest one.
+    size_t maxNumberOfLevels = 10;
+
+    //! Levels with this number of rows or fewer are not coarsened further,
+    //! and they are solved with the dense Cholesky factorization.
+    size_t maxCoarsestSize = 256;
+
+    //! Off-diagonal a_ij is a strong connection if
+    //! |a_ij| >= strengthThreshold * sqrt(a_ii * a_jj).
+    double strengthThreshold = 0.08;
+
+    //! Weight of the damped Jacobi step that smooths the prolongation,
+    //! divided by the estimated spectral radius of D^-1 A.
+    double prolongationWeight = 4.0 / 3.0;
+
+    //! Degree of the Chebyshev polynomial smoother applied before and after
+    //! the coarse correction.
+    unsigned int smootherDegree = 3;
+
+    //! Ratio of the largest to the smallest eigenvalue of D^-1 A that the
+    //! smoother damps. The lower part of the spectrum is left to the coarser
+    //! levels.
+    double smootherEigenvalueRatio = 30.0;
+
+    //! Number of smoother applications at the coarsest level if it is too
+    //! large for the direct solve.
+    unsigned int numberOfCoarsestIter = 10;
+};
+
+//!
+//! \brief Smoothed aggregation algebraic multigrid hierarchy.
+//!
+//! The rows of a symmetric positive (semi-)definite matrix are grouped into
+//! aggregates of strongly connected rows. The piecewise-constant tentative
+//! prolongation is smoothed by a damped Jacobi step, the restriction is its
+//! transpose, and each coarser matrix is the Galerkin product R A P. Except
+//! for the aggregation, the setup runs in parallel; every row is computed
+//! independently, so the hierarchy does not depend on the number of threads.
+//!
+//! The V-cycle is a symmetric linear operator, so it can precondition CG.
+//! The hierarchy keeps a reference to the finest matrix.
+//!
+template <typename T>
+class AmgHierarchy {
+ public:
+    //! Builds the hierarchy for given matrix with given parameters.
+    void build(const MatrixCsr<T>& A, const AmgParameters& params);
+
+    //!
+    //! \brief Rebuilds the hierarchy for given matrix with the same sparsity.
+    //!
+    //! The transfer operators from the last build are reused, and only the
+    //! coarser matrices and the smoothers are recomputed.
+    //!
+    void rebuild(const MatrixCsr<T>& A);
+
+    //! Returns true if given matrix has the same sparsity pattern as the one
+    //! the hierarchy was built with.
+    bool hasSameSparsity(const MatrixCsr<T>& A) const;
+
+    //! Applies a V-cycle to \p b from the zero initial guess.
+    void vCycle(const VectorN<T>& b, VectorN<T>* x);
+
+    //! Returns the number of levels.
+    size_t numberOfLevels() const;
+
+    //! Returns the matrix at given level.
+    const MatrixCsr<T>& matrix(size_t level) const;
+
+    //! Returns the prolongation from level + 1 to given level.
+    const MatrixCsr<T>& prolongation(size_t level) const;
+
+ private:
+    struct Level {
+        MatrixCsr<T> A;
+        MatrixCsr<T> P;
+        MatrixCsr<T> R;
+        VectorN<T> invDiag;
+        T upperEigenvalue = 1;
+        VectorN<T> x;
+        VectorN<T> b;
+        VectorN<T> r;
+        VectorN<T> p;
+    };
+
+    AmgParameters _params;
+    const MatrixCsr<T>* _finest = nullptr;
+    std::vector<Level> _levels;
+    std::vector<size_t> _rowPointers;
+    std::vector<size_t> _columnIndices;
+
+    // Dense lower Cholesky factor of the coarsest matrix. The zero pivots of
+    // a singular matrix are stored as zero and skipped in the solve.
+    std::vector<T> _cholesky;
+
+    void setupSmoothers();
+
+    void cycle(size_t level, const VectorN<T>& b, VectorN<T>* x);
+
+    void smooth(size_t level, const VectorN<T>& b, bool isZeroInitialGuess,
+                VectorN<T>* x);
+
+    void solveCoarsest(const VectorN<T>& b, VectorN<T>* x);
+};
+
+//! Single-precision algebraic multigrid hierarchy.
+typedef AmgHierarchy<float> AmgHierarchyF;
+
+//! Double-precision algebraic multigrid hierarchy.
+typedef AmgHierarchy<double> AmgHierarchyD;
+
+}  // namespace jet
+
+#include "detail/amg-inl.h"
+
+#endif  // INCLUDE_JET_AMG_H_
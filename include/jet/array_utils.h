@@ -139,7 +139,8 @@ void copyRange3(
 //! region. It iterates multiple times to propagate the 'valid' values to nearby
 //! 'invalid' region. The maximum distance of the propagation is equal to
 //! numberOfIterations. The input parameters 'valid' and 'data' should be
-//! collocated.
+//! collocated. Each iteration only visits the frontier of the valid region,
+//! and the frontier cells are updated in parallel.
 //!
 //! \param input - data to extrapolate
 //! \param valid - set 1 if valid, else 0.
@@ -153,6 +154,32 @@ void extrapolateToRegion(
     unsigned int numberOfIterations,
     ArrayAccessor2<T> output);
 
+//!
+//! \brief Extrapolates 2-D face-centered data from 'valid' (1) to 'invalid'
+//! (0) region.
+//!
+//! This function works the same as the single-array version for the u and v
+//! components, but advances both extrapolation fronts together so that each
+//! iteration runs one parallel pass over the frontier cells of both arrays.
+//!
+//! \param uInput - u data to extrapolate
+//! \param vInput - v data to extrapolate
+//! \param uValid - set 1 if u is valid, else 0.
+//! \param vValid - set 1 if v is valid, else 0.
+//! \param numberOfIterations - number of iterations for propagation
+//! \param uOutput - extrapolated u output
+//! \param vOutput - extrapolated v output
+//!
+template <typename T>
+void extrapolateToRegion(
+    const ConstArrayAccessor2<T>& uInput,
+    const ConstArrayAccessor2<T>& vInput,
+    const ConstArrayAccessor2<char>& uValid,
+    const ConstArrayAccessor2<char>& vValid,
+    unsigned int numberOfIterations,
+    ArrayAccessor2<T> uOutput,
+    ArrayAccessor2<T> vOutput);
+
 //!
 //! \brief Extrapolates 3-D input data from 'valid' (1) to 'invalid' (0) region.
 //!
@@ -160,7 +187,8 @@ void extrapolateToRegion(
 //! region. It iterates multiple times to propagate the 'valid' values to nearby
 //! 'invalid' region. The maximum distance of the propagation is equal to
 //! numberOfIterations. The input parameters 'valid' and 'data' should be
-//! collocated.
+//! collocated. Each iteration only visits the frontier of the valid region,
+//! and the frontier cells are updated in parallel.
 //!
 //! \param input - data to extrapolate
 //! \param valid - set 1 if valid, else 0.
@@ -174,6 +202,39 @@ void extrapolateToRegion(
     unsigned int numberOfIterations,
     ArrayAccessor3<T> output);
 
+//!
+//! \brief Extrapolates 3-D face-centered data from 'valid' (1) to 'invalid'
+//! (0) region.
+//!
+//! This function works the same as the single-array version for the u, v,
+//! and w components, but advances the three extrapolation fronts together so
+//! that each iteration runs one parallel pass over the frontier cells of all
+//! the arrays.
+//!
+//! \param uInput - u data to extrapolate
+//! \param vInput - v data to extrapolate
+//! \param wInput - w data to extrapolate
+//! \param uValid - set 1 if u is valid, else 0.
+//! \param vValid - set 1 if v is valid, else 0.
+//! \param wValid - set 1 if w is valid, else 0.
+//! \param numberOfIterations - number of iterations for propagation
+//! \param uOutput - extrapolated u output
+//! \param vOutput - extrapolated v output
+//! \param wOutput - extrapolated w output
+//!
+template <typename T>
+void extrapolateToRegion(
+    const ConstArrayAccessor3<T>& uInput,
+    const ConstArrayAccessor3<T>& vInput,
+    const ConstArrayAccessor3<T>& wInput,
+    const ConstArrayAccessor3<char>& uValid,
+    const ConstArrayAccessor3<char>& vValid,
+    const ConstArrayAccessor3<char>& wValid,
+    unsigned int numberOfIterations,
+    ArrayAccessor3<T> uOutput,
+    ArrayAccessor3<T> vOutput,
+    ArrayAccessor3<T> wOutput);
+
 //!
 //! \brief Converts 2-D array to Comma Separated Value (CSV) stream.
 //!
@@ -31,6 +31,11 @@ struct NullCgPreconditioner final {
 //!
 //! \brief Solves conjugate gradient.
 //!
+//! If BlasType provides the fused operations mvmAndDot and axpyPairAndDot
+//! (see FdmBlas3 for the signatures), they are used to reduce the number of
+//! passes over the vectors per iteration. Otherwise, the solver falls back to
+//! the basic operations.
+//!
 template <typename BlasType>
 void cg(
     const typename BlasType::MatrixType& A,
@@ -48,6 +53,8 @@ void cg(
 //!
 //! \brief Solves pre-conditioned conjugate gradient.
 //!
+//! Uses the fused operations of BlasType if available, the same as cg.
+//!
 template <
     typename BlasType,
     typename PrecondType>
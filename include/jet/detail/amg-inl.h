@@ -0,0 +1,700 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_AMG_INL_H_
+#define INCLUDE_JET_DETAIL_AMG_INL_H_
+
+#include <jet/amg.h>
+#include <jet/constants.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace jet {
+
+namespace internal {
+
+// Number of the Lanczos iterations to estimate the spectral radius.
+const unsigned int kAmgLanczosIterations = 10;
+
+// Number of the bisection iterations for the largest eigenvalue of the
+// Lanczos tridiagonal matrix.
+const unsigned int kAmgBisectionIterations = 64;
+
+// Safety margin over the estimated spectral radius for the smoother.
+const double kAmgSpectralRadiusMargin = 1.1;
+
+// Computes C = A * B row by row. Each row accumulates the products in the
+// order of the nonzeros of A and B, and its columns are sorted, so the result
+// is the same regardless of how the rows are distributed over the threads.
+template <typename T>
+void amgMultiply(const MatrixCsr<T>& A, const MatrixCsr<T>& B,
+                 MatrixCsr<T>* C) {
+    const size_t n = A.rows();
+    const size_t m = B.cols();
+    const size_t* ap = A.rowPointersData();
+    const size_t* ac = A.columnIndicesData();
+    const T* av = A.nonZeroData();
+    const size_t* bp = B.rowPointersData();
+    const size_t* bc = B.columnIndicesData();
+    const T* bv = B.nonZeroData();
+
+    std::vector<size_t> pointers(n + 1, 0);
+
+    parallelRangeFor(kZeroSize, n, [&](size_t begin, size_t end) {
+        std::vector<size_t> marker(m, kMaxSize);
+        for (size_t i = begin; i < end; ++i) {
+            size_t count = 0;
+            for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+                const size_t k = ac[a];
+                for (size_t b = bp[k]; b < bp[k + 1]; ++b) {
+                    if (marker[bc[b]] != i) {
+                        marker[bc[b]] = i;
+                        ++count;
+                    }
+                }
+            }
+            pointers[i + 1] = count;
+        }
+    });
+
+    for (size_t i = 0; i < n; ++i) {
+        pointers[i + 1] += pointers[i];
+    }
+
+    C->reserve(n, m, pointers[n]);
+    std::copy(pointers.begin(), pointers.end(), C->rowPointersBegin());
+    auto cc = C->columnIndicesBegin();
+    T* cv = C->nonZeroData();
+
+    parallelRangeFor(kZeroSize, n, [&](size_t begin, size_t end) {
+        std::vector<size_t> position(m, kMaxSize);
+        std::vector<std::pair<size_t, T>> row;
+        for (size_t i = begin; i < end; ++i) {
+            row.clear();
+            for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+                const size_t k = ac[a];
+                for (size_t b = bp[k]; b < bp[k + 1]; ++b) {
+                    const size_t j = bc[b];
+                    // Positions from the previous rows are stale.
+                    if (position[j] == kMaxSize || position[j] < pointers[i]) {
+                        position[j] = pointers[i] + row.size();
+                        row.emplace_back(j, av[a] * bv[b]);
+                    } else {
+                        row[position[j] - pointers[i]].second += av[a] * bv[b];
+                    }
+                }
+            }
+
+            std::sort(row.begin(), row.end(),
+                      [](const std::pair<size_t, T>& x,
+                         const std::pair<size_t, T>& y) {
+                          return x.first < y.first;
+                      });
+
+            for (size_t c = 0; c < row.size(); ++c) {
+                cc[pointers[i] + c] = row[c].first;
+                cv[pointers[i] + c] = row[c].second;
+            }
+        }
+    });
+}
+
+// Computes the transpose of A.
+template <typename T>
+void amgTranspose(const MatrixCsr<T>& A, MatrixCsr<T>* At) {
+    const size_t n = A.rows();
+    const size_t m = A.cols();
+    const size_t* ap = A.rowPointersData();
+    const size_t* ac = A.columnIndicesData();
+    const T* av = A.nonZeroData();
+
+    std::vector<size_t> pointers(m + 1, 0);
+    for (size_t a = 0; a < A.numberOfNonZeros(); ++a) {
+        ++pointers[ac[a] + 1];
+    }
+    for (size_t j = 0; j < m; ++j) {
+        pointers[j + 1] += pointers[j];
+    }
+
+    At->reserve(m, n, A.numberOfNonZeros());
+    std::copy(pointers.begin(), pointers.end(), At->rowPointersBegin());
+    auto tc = At->columnIndicesBegin();
+    T* tv = At->nonZeroData();
+
+    // Visiting the rows in order keeps the columns of At sorted.
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+            const size_t pos = pointers[ac[a]]++;
+            tc[pos] = i;
+            tv[pos] = av[a];
+        }
+    }
+}
+
+// Returns the diagonal of A.
+template <typename T>
+VectorN<T> amgDiagonal(const MatrixCsr<T>& A) {
+    VectorN<T> diag(A.rows(), 0);
+    parallelFor(kZeroSize, A.rows(), [&](size_t i) {
+        for (size_t a = A.rowPointer(i); a < A.rowPointer(i + 1); ++a) {
+            if (A.columnIndex(a) == i) {
+                diag[i] = A.nonZero(a);
+            }
+        }
+    });
+    return diag;
+}
+
+// Computes r = b - A x.
+template <typename T>
+void amgResidual(const MatrixCsr<T>& A, const VectorN<T>& x,
+                 const VectorN<T>& b, VectorN<T>* r) {
+    const size_t* ap = A.rowPointersData();
+    const size_t* ac = A.columnIndicesData();
+    const T* av = A.nonZeroData();
+    parallelFor(kZeroSize, A.rows(), [&](size_t i) {
+        T sum = b[i];
+        for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+            sum -= av[a] * x[ac[a]];
+        }
+        (*r)[i] = sum;
+    });
+}
+
+// Computes y = A x (or y += A x if isAdding is true).
+template <typename T>
+void amgMultiply(const MatrixCsr<T>& A, const VectorN<T>& x, bool isAdding,
+                 VectorN<T>* y) {
+    const size_t* ap = A.rowPointersData();
+    const size_t* ac = A.columnIndicesData();
+    const T* av = A.nonZeroData();
+    parallelFor(kZeroSize, A.rows(), [&](size_t i) {
+        T sum = isAdding ? (*y)[i] : 0;
+        for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+            sum += av[a] * x[ac[a]];
+        }
+        (*y)[i] = sum;
+    });
+}
+
+// Estimates the largest eigenvalue of D^-1 A by the Lanczos iteration on
+// D^-1/2 A D^-1/2. The initial vector is pseudo-random but fixed, so the
+// estimate is deterministic.
+template <typename T>
+T amgSpectralRadius(const MatrixCsr<T>& A, const VectorN<T>& diag) {
+    const size_t n = A.rows();
+    if (n == 0) {
+        return 1;
+    }
+
+    VectorN<T> invSqrtDiag(n), u(n), v(n), w(n), vPrev(n, 0);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        invSqrtDiag[i] = (diag[i] > 0) ? 1 / std::sqrt(diag[i]) : 0;
+
+        // SplitMix64 hash of the index
+        uint64_t z = i + 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        z ^= z >> 31;
+        v[i] = static_cast<T>(z >> 11) / static_cast<T>(1ull << 53) - T(0.5);
+    });
+    v /= v.length();
+
+    std::vector<double> alpha;
+    std::vector<double> beta;
+    const size_t numberOfIterations =
+        std::min<size_t>(kAmgLanczosIterations, n);
+    for (size_t k = 0; k < numberOfIterations; ++k) {
+        parallelFor(kZeroSize, n,
+                    [&](size_t i) { u[i] = invSqrtDiag[i] * v[i]; });
+        amgMultiply(A, u, false, &w);
+        parallelFor(kZeroSize, n, [&](size_t i) { w[i] *= invSqrtDiag[i]; });
+
+        const T a = w.dot(v);
+        const T b = beta.empty() ? T(0) : static_cast<T>(beta.back());
+        parallelFor(kZeroSize, n,
+                    [&](size_t i) { w[i] -= a * v[i] + b * vPrev[i]; });
+        alpha.push_back(a);
+
+        const T wLength = w.length();
+        if (wLength <= std::numeric_limits<T>::epsilon() * std::fabs(a)) {
+            break;
+        }
+        beta.push_back(wLength);
+        vPrev.set(v);
+        parallelFor(kZeroSize, n, [&](size_t i) { v[i] = w[i] / wLength; });
+    }
+
+    // Largest eigenvalue of the tridiagonal matrix by the bisection with the
+    // Sturm sequence, starting from its Gershgorin bounds.
+    const size_t m = alpha.size();
+    double lower = kMaxD;
+    double upper = -kMaxD;
+    for (size_t i = 0; i < m; ++i) {
+        const double radius = ((i > 0) ? beta[i - 1] : 0.0) +
+                              ((i + 1 < m) ? beta[i] : 0.0);
+        lower = std::min(lower, alpha[i] - radius);
+        upper = std::max(upper, alpha[i] + radius);
+    }
+    for (unsigned int iter = 0; iter < kAmgBisectionIterations; ++iter) {
+        const double mid = 0.5 * (lower + upper);
+
+        // Number of the eigenvalues smaller than mid
+        size_t count = 0;
+        double d = 1.0;
+        for (size_t i = 0; i < m; ++i) {
+            const double b2 = (i > 0) ? beta[i - 1] * beta[i - 1] : 0.0;
+            d = alpha[i] - mid - b2 / d;
+            if (d == 0.0) {
+                d = -kEpsilonD;
+            }
+            count += (d < 0.0);
+        }
+
+        if (count == m) {
+            upper = mid;
+        } else {
+            lower = mid;
+        }
+    }
+
+    return std::max(static_cast<T>(upper), T(kEpsilonD));
+}
+
+// Groups the rows of A into aggregates. Returns the number of aggregates, and
+// the aggregate of each row (or kMaxSize for rows without any strong
+// connection) is stored in aggregates.
+template <typename T>
+size_t amgAggregate(const MatrixCsr<T>& A, const VectorN<T>& diag,
+                    double strengthThreshold, std::vector<char>* isStrong,
+                    std::vector<size_t>* aggregates) {
+    const size_t n = A.rows();
+    const size_t* ap = A.rowPointersData();
+    const size_t* ac = A.columnIndicesData();
+    const T* av = A.nonZeroData();
+
+    isStrong->assign(A.numberOfNonZeros(), 0);
+    std::vector<char> hasStrong(n, 0);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+            const size_t j = ac[a];
+            const double threshold =
+                strengthThreshold *
+                std::sqrt(std::fabs(static_cast<double>(diag[i]) * diag[j]));
+            if (j != i && av[a] != 0 && std::fabs(av[a]) >= threshold) {
+                (*isStrong)[a] = 1;
+                hasStrong[i] = 1;
+            }
+        }
+    });
+
+    auto& agg = *aggregates;
+    agg.assign(n, kMaxSize);
+    size_t numberOfAggregates = 0;
+
+    // 1) Rows whose strong neighbors are all free become the roots.
+    for (size_t i = 0; i < n; ++i) {
+        if (!hasStrong[i] || agg[i] != kMaxSize) {
+            continue;
+        }
+        bool isFree = true;
+        for (size_t a = ap[i]; a < ap[i + 1] && isFree; ++a) {
+            isFree = !(*isStrong)[a] || agg[ac[a]] == kMaxSize;
+        }
+        if (isFree) {
+            agg[i] = numberOfAggregates;
+            for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+                if ((*isStrong)[a]) {
+                    agg[ac[a]] = numberOfAggregates;
+                }
+            }
+            ++numberOfAggregates;
+        }
+    }
+
+    // 2) The remaining rows join an aggregate of their strong neighbors.
+    const std::vector<size_t> roots = agg;
+    for (size_t i = 0; i < n; ++i) {
+        if (!hasStrong[i] || agg[i] != kMaxSize) {
+            continue;
+        }
+        for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+            if ((*isStrong)[a] && roots[ac[a]] != kMaxSize) {
+                agg[i] = roots[ac[a]];
+                break;
+            }
+        }
+    }
+
+    // 3) Whatever is left forms new aggregates with the free neighbors.
+    for (size_t i = 0; i < n; ++i) {
+        if (!hasStrong[i] || agg[i] != kMaxSize) {
+            continue;
+        }
+        agg[i] = numberOfAggregates;
+        for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+            if ((*isStrong)[a] && agg[ac[a]] == kMaxSize) {
+                agg[ac[a]] = numberOfAggregates;
+            }
+        }
+        ++numberOfAggregates;
+    }
+
+    return numberOfAggregates;
+}
+
+// Builds the smoothed prolongation P = (I - w D_F^-1 A_F) P_0, where P_0 is
+// the piecewise-constant prolongation of the aggregates and A_F is A without
+// the weak connections, which are lumped into its diagonal D_F.
+template <typename T>
+void amgProlongation(const MatrixCsr<T>& A, const std::vector<char>& isStrong,
+                     const std::vector<size_t>& aggregates,
+                     size_t numberOfAggregates, double prolongationWeight,
+                     MatrixCsr<T>* P) {
+    const size_t n = A.rows();
+    const size_t* ap = A.rowPointersData();
+    const size_t* ac = A.columnIndicesData();
+    const T* av = A.nonZeroData();
+
+    // Filtered matrix with the diagonal first in each row
+    MatrixCsr<T> filtered;
+    std::vector<size_t> pointers(n + 1, 0);
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        size_t count = 1;
+        for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+            count += isStrong[a];
+        }
+        pointers[i + 1] = count;
+    });
+    for (size_t i = 0; i < n; ++i) {
+        pointers[i + 1] += pointers[i];
+    }
+
+    filtered.reserve(n, n, pointers[n]);
+    std::copy(pointers.begin(), pointers.end(), filtered.rowPointersBegin());
+    auto fc = filtered.columnIndicesBegin();
+    T* fv = filtered.nonZeroData();
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        T diag = 0;
+        size_t pos = pointers[i] + 1;
+        for (size_t a = ap[i]; a < ap[i + 1]; ++a) {
+            if (isStrong[a]) {
+                fc[pos] = ac[a];
+                fv[pos] = av[a];
+                ++pos;
+            } else {
+                diag += av[a];
+            }
+        }
+        fc[pointers[i]] = i;
+        fv[pointers[i]] = diag;
+    });
+
+    VectorN<T> diag(n, 0);
+    parallelFor(kZeroSize, n, [&](size_t i) { diag[i] = fv[pointers[i]]; });
+    const T omega =
+        static_cast<T>(prolongationWeight) / amgSpectralRadius(filtered, diag);
+
+    // I - w D_F^-1 A_F in place
+    parallelFor(kZeroSize, n, [&](size_t i) {
+        const T scale = (diag[i] > 0) ? omega / diag[i] : 0;
+        for (size_t a = pointers[i]; a < pointers[i + 1]; ++a) {
+            fv[a] = -scale * fv[a];
+        }
+        fv[pointers[i]] += 1;
+    });
+
+    // Piecewise-constant prolongation of the aggregates
+    for (size_t i = 0; i < n; ++i) {
+        pointers[i + 1] = pointers[i] + (aggregates[i] != kMaxSize);
+    }
+    MatrixCsr<T> tentative;
+    tentative.reserve(n, numberOfAggregates, pointers[n]);
+    std::copy(pointers.begin(), pointers.end(), tentative.rowPointersBegin());
+    auto tc = tentative.columnIndicesBegin();
+    T* tv = tentative.nonZeroData();
+    for (size_t i = 0; i < n; ++i) {
+        if (aggregates[i] != kMaxSize) {
+            tc[pointers[i]] = aggregates[i];
+            tv[pointers[i]] = 1;
+        }
+    }
+
+    amgMultiply(filtered, tentative, P);
+}
+
+// Applies the Chebyshev polynomial smoother of given degree, which damps the
+// error components with the eigenvalues of D^-1 A in [lower, upper]. Starting
+// from the zero initial guess, the smoother is a symmetric linear operator.
+template <typename T>
+void amgSmooth(const MatrixCsr<T>& A, const VectorN<T>& b,
+               const VectorN<T>& invDiag, T lower, T upper,
+               unsigned int degree, bool isZeroInitialGuess, VectorN<T>* x,
+               VectorN<T>* r, VectorN<T>* p) {
+    const T theta = (upper + lower) / 2;
+    const T delta = (upper - lower) / 2;
+    const T sigma = theta / delta;
+    T rho = 1 / sigma;
+
+    if (isZeroInitialGuess) {
+        x->set(0);
+    }
+
+    for (unsigned int k = 0; k < degree; ++k) {
+        if (k == 0 && isZeroInitialGuess) {
+            parallelFor(kZeroSize, x->size(), [&](size_t i) {
+                (*p)[i] = invDiag[i] * b[i] / theta;
+                (*x)[i] = (*p)[i];
+            });
+        } else if (k == 0) {
+            amgResidual(A, *x, b, r);
+            parallelFor(kZeroSize, x->size(), [&](size_t i) {
+                (*p)[i] = invDiag[i] * (*r)[i] / theta;
+                (*x)[i] += (*p)[i];
+            });
+        } else {
+            amgResidual(A, *x, b, r);
+            const T rhoNew = 1 / (2 * sigma - rho);
+            parallelFor(kZeroSize, x->size(), [&](size_t i) {
+                (*p)[i] = rhoNew * rho * (*p)[i] +
+                          2 * rhoNew / delta * invDiag[i] * (*r)[i];
+                (*x)[i] += (*p)[i];
+            });
+            rho = rhoNew;
+        }
+    }
+}
+
+}  // namespace internal
+
+template <typename T>
+void AmgHierarchy<T>::build(const MatrixCsr<T>& A,
+                            const AmgParameters& params) {
+    _params = params;
+    _finest = &A;
+    _rowPointers.assign(A.rowPointersBegin(), A.rowPointersEnd());
+    _columnIndices.assign(A.columnIndicesBegin(), A.columnIndicesEnd());
+
+    _levels.clear();
+    _levels.emplace_back();
+
+    std::vector<char> isStrong;
+    std::vector<size_t> aggregates;
+    while (_levels.size() < _params.maxNumberOfLevels) {
+        Level& finer = _levels.back();
+        const MatrixCsr<T>& finerA = matrix(_levels.size() - 1);
+        if (finerA.rows() <= _params.maxCoarsestSize) {
+            break;
+        }
+
+        const size_t numberOfAggregates = internal::amgAggregate(
+            finerA, internal::amgDiagonal(finerA), _params.strengthThreshold,
+            &isStrong, &aggregates);
+        if (numberOfAggregates == 0 || numberOfAggregates == finerA.rows()) {
+            break;
+        }
+
+        internal::amgProlongation(finerA, isStrong, aggregates,
+                                  numberOfAggregates,
+                                  _params.prolongationWeight, &finer.P);
+        internal::amgTranspose(finer.P, &finer.R);
+
+        Level coarser;
+        MatrixCsr<T> ap;
+        internal::amgMultiply(finerA, finer.P, &ap);
+        internal::amgMultiply(finer.R, ap, &coarser.A);
+        _levels.push_back(std::move(coarser));
+    }
+
+    setupSmoothers();
+}
+
+template <typename T>
+void AmgHierarchy<T>::rebuild(const MatrixCsr<T>& A) {
+    JET_ASSERT(hasSameSparsity(A));
+
+    _finest = &A;
+    for (size_t level = 0; level + 1 < _levels.size(); ++level) {
+        MatrixCsr<T> ap;
+        internal::amgMultiply(matrix(level), _levels[level].P, &ap);
+        internal::amgMultiply(_levels[level].R, ap, &_levels[level + 1].A);
+    }
+
+    setupSmoothers();
+}
+
+template <typename T>
+bool AmgHierarchy<T>::hasSameSparsity(const MatrixCsr<T>& A) const {
+    return !_levels.empty() && A.rows() + 1 == _rowPointers.size() &&
+           A.numberOfNonZeros() == _columnIndices.size() &&
+           std::equal(_rowPointers.begin(), _rowPointers.end(),
+                      A.rowPointersBegin()) &&
+           std::equal(_columnIndices.begin(), _columnIndices.end(),
+                      A.columnIndicesBegin());
+}
+
+template <typename T>
+void AmgHierarchy<T>::vCycle(const VectorN<T>& b, VectorN<T>* x) {
+    JET_ASSERT(!_levels.empty());
+    if (x->size() != b.size()) {
+        x->resize(b.size());
+    }
+    cycle(0, b, x);
+}
+
+template <typename T>
+size_t AmgHierarchy<T>::numberOfLevels() const {
+    return _levels.size();
+}
+
+template <typename T>
+const MatrixCsr<T>& AmgHierarchy<T>::matrix(size_t level) const {
+    return (level == 0) ? *_finest : _levels[level].A;
+}
+
+template <typename T>
+const MatrixCsr<T>& AmgHierarchy<T>::prolongation(size_t level) const {
+    return _levels[level].P;
+}
+
+template <typename T>
+void AmgHierarchy<T>::setupSmoothers() {
+    for (size_t level = 0; level < _levels.size(); ++level) {
+        const MatrixCsr<T>& A = matrix(level);
+        Level& l = _levels[level];
+        const size_t n = A.rows();
+
+        l.invDiag = internal::amgDiagonal(A);
+        l.upperEigenvalue =
+            static_cast<T>(internal::kAmgSpectralRadiusMargin) *
+            internal::amgSpectralRadius(A, l.invDiag);
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            l.invDiag[i] = (l.invDiag[i] > 0) ? 1 / l.invDiag[i] : 0;
+        });
+
+        l.r.resize(n, 0);
+        l.p.resize(n, 0);
+        if (level > 0) {
+            l.x.resize(n, 0);
+            l.b.resize(n, 0);
+        }
+    }
+
+    // Factorize the coarsest matrix if it is small enough.
+    _cholesky.clear();
+    const MatrixCsr<T>& A = matrix(_levels.size() - 1);
+    const size_t n = A.rows();
+    if (n > _params.maxCoarsestSize) {
+        return;
+    }
+
+    _cholesky.assign(n * n, 0);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t a = A.rowPointer(i); a < A.rowPointer(i + 1); ++a) {
+            if (A.columnIndex(a) <= i) {
+                _cholesky[i * n + A.columnIndex(a)] = A.nonZero(a);
+            }
+        }
+    }
+
+    const T tolerance = std::sqrt(std::numeric_limits<T>::epsilon());
+    for (size_t i = 0; i < n; ++i) {
+        T* li = &_cholesky[i * n];
+        for (size_t j = 0; j <= i; ++j) {
+            const T* lj = &_cholesky[j * n];
+            T sum = li[j];
+            for (size_t k = 0; k < j; ++k) {
+                sum -= li[k] * lj[k];
+            }
+
+            if (j < i) {
+                li[j] = (lj[j] > 0) ? sum / lj[j] : 0;
+            } else {
+                // A (numerically) zero pivot of a singular matrix
+                li[i] = (sum > tolerance * std::fabs(li[i])) ? std::sqrt(sum)
+                                                             : 0;
+            }
+        }
+    }
+}
+
+template <typename T>
+void AmgHierarchy<T>::cycle(size_t level, const VectorN<T>& b,
+                            VectorN<T>* x) {
+    const MatrixCsr<T>& A = matrix(level);
+    Level& l = _levels[level];
+
+    if (level + 1 == _levels.size()) {
+        if (_cholesky.empty()) {
+            for (unsigned int iter = 0; iter < _params.numberOfCoarsestIter;
+                 ++iter) {
+                smooth(level, b, iter == 0, x);
+            }
+        } else {
+            solveCoarsest(b, x);
+        }
+        return;
+    }
+
+    Level& coarser = _levels[level + 1];
+
+    smooth(level, b, true, x);
+
+    internal::amgResidual(A, *x, b, &l.r);
+    internal::amgMultiply(l.R, l.r, false, &coarser.b);
+    cycle(level + 1, coarser.b, &coarser.x);
+    internal::amgMultiply(l.P, coarser.x, true, x);
+
+    smooth(level, b, false, x);
+}
+
+template <typename T>
+void AmgHierarchy<T>::smooth(size_t level, const VectorN<T>& b,
+                             bool isZeroInitialGuess, VectorN<T>* x) {
+    Level& l = _levels[level];
+    internal::amgSmooth(matrix(level), b, l.invDiag,
+                        l.upperEigenvalue /
+                            static_cast<T>(_params.smootherEigenvalueRatio),
+                        l.upperEigenvalue, _params.smootherDegree,
+                        isZeroInitialGuess, x, &l.r, &l.p);
+}
+
+template <typename T>
+void AmgHierarchy<T>::solveCoarsest(const VectorN<T>& b, VectorN<T>* x) {
+    const size_t n = b.size();
+
+    // L y = b
+    for (size_t i = 0; i < n; ++i) {
+        const T* li = &_cholesky[i * n];
+        T sum = b[i];
+        for (size_t k = 0; k < i; ++k) {
+            sum -= li[k] * (*x)[k];
+        }
+        (*x)[i] = (li[i] > 0) ? sum / li[i] : 0;
+    }
+
+    // L^T x = y
+    for (size_t i = n; i-- > 0;) {
+        const T lii = _cholesky[i * n + i];
+        if (lii > 0) {
+            (*x)[i] /= lii;
+            for (size_t k = 0; k < i; ++k) {
+                (*x)[k] -= _cholesky[i * n + k] * (*x)[i];
+            }
+        } else {
+            (*x)[i] = 0;
+        }
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_AMG_INL_H_
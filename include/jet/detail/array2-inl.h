@@ -84,6 +84,11 @@ void Array<T, 2>::clear() {
 
 template <typename T>
 void Array<T, 2>::resize(const Size2& size, const T& initVal) {
+    // Keeps the buffer and the elements if the size does not change.
+    if (size == _size) {
+        return;
+    }
+
     Array grid;
     grid._data.resize(size.x * size.y, initVal);
     grid._size = size;
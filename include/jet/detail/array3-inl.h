@@ -93,6 +93,11 @@ void Array<T, 3>::clear() {
 
 template <typename T>
 void Array<T, 3>::resize(const Size3& size, const T& initVal) {
+    // Keeps the buffer and the elements if the size does not change.
+    if (size == _size) {
+        return;
+    }
+
     Array grid;
     grid._data.resize(size.x * size.y * size.z, initVal);
     grid._size = size;
@@ -11,9 +11,13 @@
 #include <jet/array2.h>
 #include <jet/array3.h>
 #include <jet/parallel.h>
+#include <jet/point2.h>
+#include <jet/point3.h>
 #include <jet/serial.h>
 #include <jet/type_helpers.h>
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 namespace jet {
 
@@ -109,136 +113,464 @@ void copyRange3(
         });
 }
 
+namespace internal {
+
+// Frontier cells are processed in chunks of this size so that one parallel
+// loop can cover the frontiers of several arrays at once.
+const size_t kExtrapolationChunkSize = 256;
+
+// Extrapolation state of a single 2-D array. Only the frontier, the invalid
+// cells next to the valid region, is visited at each iteration.
 template <typename T>
-void extrapolateToRegion(
-    const ConstArrayAccessor2<T>& input,
-    const ConstArrayAccessor2<char>& valid,
-    unsigned int numberOfIterations,
-    ArrayAccessor2<T> output) {
-    const Size2 size = input.size();
+class RegionExtrapolator2 {
+ public:
+    typedef Point2UI PointType;
+
+    RegionExtrapolator2(
+        const ConstArrayAccessor2<T>& input,
+        const ConstArrayAccessor2<char>& valid,
+        ArrayAccessor2<T> output)
+    : _output(output), _valid(input.size()) {
+        const Size2 size = input.size();
+
+        JET_ASSERT(size == valid.size());
+        JET_ASSERT(size == output.size());
+
+        _valid.parallelForEachIndex([&](size_t i, size_t j) {
+            _valid(i, j) = valid(i, j) ? 1 : 0;
+            output(i, j) = input(i, j);
+        });
 
-    JET_ASSERT(size == valid.size());
-    JET_ASSERT(size == output.size());
+        std::vector<std::vector<Point2UI>> rows(size.y);
+        parallelFor(kZeroSize, size.y, [&](size_t j) {
+            Point2UI nb;
+            for (size_t i = 0; i < size.x; ++i) {
+                if (!_valid(i, j) && findFirstValidNeighbor(i, j, &nb)) {
+                    rows[j].push_back(Point2UI(i, j));
+                }
+            }
+        });
 
-    Array2<char> valid0(size);
-    Array2<char> valid1(size);
+        for (const auto& row : rows) {
+            _frontier.insert(_frontier.end(), row.begin(), row.end());
+        }
+    }
 
-    valid0.parallelForEachIndex([&](size_t i, size_t j) {
-        valid0(i, j) = valid(i, j);
-        output(i, j) = input(i, j);
-    });
+    const std::vector<Point2UI>& frontier() const {
+        return _frontier;
+    }
 
-    for (unsigned int iter = 0; iter < numberOfIterations; ++iter) {
-        valid0.forEachIndex([&](size_t i, size_t j) {
+    void setFrontier(std::vector<Point2UI>* frontier) {
+        _frontier.swap(*frontier);
+    }
+
+    // Averages the valid neighbors of the frontier cells in [begin, end).
+    // Only the frontier cells are written and only the valid cells are read,
+    // so the chunks can be processed in any order.
+    void extrapolate(size_t begin, size_t end) {
+        const Size2 size = _valid.size();
+
+        for (size_t n = begin; n < end; ++n) {
+            const size_t i = _frontier[n].x;
+            const size_t j = _frontier[n].y;
             T sum = zero<T>();
             unsigned int count = 0;
 
-            if (!valid0(i, j)) {
-                if (i + 1 < size.x && valid0(i + 1, j)) {
-                    sum += output(i + 1, j);
-                    ++count;
-                }
+            if (i + 1 < size.x && _valid(i + 1, j)) {
+                sum += _output(i + 1, j);
+                ++count;
+            }
 
-                if (i > 0 && valid0(i - 1, j)) {
-                    sum += output(i - 1, j);
-                    ++count;
-                }
+            if (i > 0 && _valid(i - 1, j)) {
+                sum += _output(i - 1, j);
+                ++count;
+            }
 
-                if (j + 1 < size.y && valid0(i, j + 1)) {
-                    sum += output(i, j + 1);
-                    ++count;
-                }
+            if (j + 1 < size.y && _valid(i, j + 1)) {
+                sum += _output(i, j + 1);
+                ++count;
+            }
 
-                if (j > 0 && valid0(i, j - 1)) {
-                    sum += output(i, j - 1);
-                    ++count;
-                }
+            if (j > 0 && _valid(i, j - 1)) {
+                sum += _output(i, j - 1);
+                ++count;
+            }
 
-                if (count > 0) {
-                    output(i, j)
-                        = sum
-                        / static_cast<typename ScalarType<T>::value>(count);
-                    valid1(i, j) = 1;
-                }
-            } else {
-                valid1(i, j) = 1;
+            _output(i, j)
+                = sum / static_cast<typename ScalarType<T>::value>(count);
+        }
+    }
+
+    void validate(size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            _valid(_frontier[n]) = 1;
+        }
+    }
+
+    // Collects the invalid neighbors of the frontier cells in [begin, end).
+    // A cell next to several frontier cells is collected only by its first
+    // valid neighbor, so the next frontier has no duplicates.
+    void findNextFrontier(
+        size_t begin, size_t end, std::vector<Point2UI>* next) const {
+        const Size2 size = _valid.size();
+
+        auto visit = [&](const Point2UI& pt, size_t i, size_t j) {
+            Point2UI nb;
+            if (!_valid(i, j)
+                && findFirstValidNeighbor(i, j, &nb) && nb == pt) {
+                next->push_back(Point2UI(i, j));
             }
-        });
+        };
 
-        valid0.swap(valid1);
+        for (size_t n = begin; n < end; ++n) {
+            const Point2UI& pt = _frontier[n];
+            if (pt.x + 1 < size.x) {
+                visit(pt, pt.x + 1, pt.y);
+            }
+            if (pt.x > 0) {
+                visit(pt, pt.x - 1, pt.y);
+            }
+            if (pt.y + 1 < size.y) {
+                visit(pt, pt.x, pt.y + 1);
+            }
+            if (pt.y > 0) {
+                visit(pt, pt.x, pt.y - 1);
+            }
+        }
     }
-}
 
+ private:
+    ArrayAccessor2<T> _output;
+    Array2<char> _valid;
+    std::vector<Point2UI> _frontier;
+
+    bool findFirstValidNeighbor(size_t i, size_t j, Point2UI* nb) const {
+        const Size2 size = _valid.size();
+
+        if (i + 1 < size.x && _valid(i + 1, j)) {
+            *nb = Point2UI(i + 1, j);
+        } else if (i > 0 && _valid(i - 1, j)) {
+            *nb = Point2UI(i - 1, j);
+        } else if (j + 1 < size.y && _valid(i, j + 1)) {
+            *nb = Point2UI(i, j + 1);
+        } else if (j > 0 && _valid(i, j - 1)) {
+            *nb = Point2UI(i, j - 1);
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+};
+
+// Extrapolation state of a single 3-D array. Only the frontier, the invalid
+// cells next to the valid region, is visited at each iteration.
 template <typename T>
-void extrapolateToRegion(
-    const ConstArrayAccessor3<T>& input,
-    const ConstArrayAccessor3<char>& valid,
-    unsigned int numberOfIterations,
-    ArrayAccessor3<T> output) {
-    const Size3 size = input.size();
+class RegionExtrapolator3 {
+ public:
+    typedef Point3UI PointType;
+
+    RegionExtrapolator3(
+        const ConstArrayAccessor3<T>& input,
+        const ConstArrayAccessor3<char>& valid,
+        ArrayAccessor3<T> output)
+    : _output(output), _valid(input.size()) {
+        const Size3 size = input.size();
+
+        JET_ASSERT(size == valid.size());
+        JET_ASSERT(size == output.size());
+
+        _valid.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            _valid(i, j, k) = valid(i, j, k) ? 1 : 0;
+            output(i, j, k) = input(i, j, k);
+        });
 
-    JET_ASSERT(size == valid.size());
-    JET_ASSERT(size == output.size());
+        std::vector<std::vector<Point3UI>> slices(size.z);
+        parallelFor(kZeroSize, size.z, [&](size_t k) {
+            Point3UI nb;
+            for (size_t j = 0; j < size.y; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    if (!_valid(i, j, k)
+                        && findFirstValidNeighbor(i, j, k, &nb)) {
+                        slices[k].push_back(Point3UI(i, j, k));
+                    }
+                }
+            }
+        });
 
-    Array3<char> valid0(size);
-    Array3<char> valid1(size);
+        for (const auto& slice : slices) {
+            _frontier.insert(_frontier.end(), slice.begin(), slice.end());
+        }
+    }
 
-    valid0.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        valid0(i, j, k) = valid(i, j, k);
-        output(i, j, k) = input(i, j, k);
-    });
+    const std::vector<Point3UI>& frontier() const {
+        return _frontier;
+    }
 
-    for (unsigned int iter = 0; iter < numberOfIterations; ++iter) {
-        valid0.forEachIndex([&](size_t i, size_t j, size_t k) {
+    void setFrontier(std::vector<Point3UI>* frontier) {
+        _frontier.swap(*frontier);
+    }
+
+    // Averages the valid neighbors of the frontier cells in [begin, end).
+    // Only the frontier cells are written and only the valid cells are read,
+    // so the chunks can be processed in any order.
+    void extrapolate(size_t begin, size_t end) {
+        const Size3 size = _valid.size();
+
+        for (size_t n = begin; n < end; ++n) {
+            const size_t i = _frontier[n].x;
+            const size_t j = _frontier[n].y;
+            const size_t k = _frontier[n].z;
             T sum = zero<T>();
             unsigned int count = 0;
 
-            if (!valid0(i, j, k)) {
-                if (i + 1 < size.x && valid0(i + 1, j, k)) {
-                    sum += output(i + 1, j, k);
-                    ++count;
-                }
+            if (i + 1 < size.x && _valid(i + 1, j, k)) {
+                sum += _output(i + 1, j, k);
+                ++count;
+            }
 
-                if (i > 0 && valid0(i - 1, j, k)) {
-                    sum += output(i - 1, j, k);
-                    ++count;
-                }
+            if (i > 0 && _valid(i - 1, j, k)) {
+                sum += _output(i - 1, j, k);
+                ++count;
+            }
 
-                if (j + 1 < size.y && valid0(i, j + 1, k)) {
-                    sum += output(i, j + 1, k);
-                    ++count;
-                }
+            if (j + 1 < size.y && _valid(i, j + 1, k)) {
+                sum += _output(i, j + 1, k);
+                ++count;
+            }
 
-                if (j > 0 && valid0(i, j - 1, k)) {
-                    sum += output(i, j - 1, k);
-                    ++count;
-                }
+            if (j > 0 && _valid(i, j - 1, k)) {
+                sum += _output(i, j - 1, k);
+                ++count;
+            }
 
-                if (k + 1 < size.z && valid0(i, j, k + 1)) {
-                    sum += output(i, j, k + 1);
-                    ++count;
-                }
+            if (k + 1 < size.z && _valid(i, j, k + 1)) {
+                sum += _output(i, j, k + 1);
+                ++count;
+            }
 
-                if (k > 0 && valid0(i, j, k - 1)) {
-                    sum += output(i, j, k - 1);
-                    ++count;
-                }
+            if (k > 0 && _valid(i, j, k - 1)) {
+                sum += _output(i, j, k - 1);
+                ++count;
+            }
 
-                if (count > 0) {
-                    output(i, j, k)
-                        = sum
-                        / static_cast<typename ScalarType<T>::value>(count);
-                    valid1(i, j, k) = 1;
-                }
-            } else {
-                valid1(i, j, k) = 1;
+            _output(i, j, k)
+                = sum / static_cast<typename ScalarType<T>::value>(count);
+        }
+    }
+
+    void validate(size_t begin, size_t end) {
+        for (size_t n = begin; n < end; ++n) {
+            _valid(_frontier[n]) = 1;
+        }
+    }
+
+    // Collects the invalid neighbors of the frontier cells in [begin, end).
+    // A cell next to several frontier cells is collected only by its first
+    // valid neighbor, so the next frontier has no duplicates.
+    void findNextFrontier(
+        size_t begin, size_t end, std::vector<Point3UI>* next) const {
+        const Size3 size = _valid.size();
+
+        auto visit = [&](const Point3UI& pt, size_t i, size_t j, size_t k) {
+            Point3UI nb;
+            if (!_valid(i, j, k)
+                && findFirstValidNeighbor(i, j, k, &nb) && nb == pt) {
+                next->push_back(Point3UI(i, j, k));
             }
-        });
+        };
 
-        valid0.swap(valid1);
+        for (size_t n = begin; n < end; ++n) {
+            const Point3UI& pt = _frontier[n];
+            if (pt.x + 1 < size.x) {
+                visit(pt, pt.x + 1, pt.y, pt.z);
+            }
+            if (pt.x > 0) {
+                visit(pt, pt.x - 1, pt.y, pt.z);
+            }
+            if (pt.y + 1 < size.y) {
+                visit(pt, pt.x, pt.y + 1, pt.z);
+            }
+            if (pt.y > 0) {
+                visit(pt, pt.x, pt.y - 1, pt.z);
+            }
+            if (pt.z + 1 < size.z) {
+                visit(pt, pt.x, pt.y, pt.z + 1);
+            }
+            if (pt.z > 0) {
+                visit(pt, pt.x, pt.y, pt.z - 1);
+            }
+        }
+    }
+
+ private:
+    ArrayAccessor3<T> _output;
+    Array3<char> _valid;
+    std::vector<Point3UI> _frontier;
+
+    bool findFirstValidNeighbor(
+        size_t i, size_t j, size_t k, Point3UI* nb) const {
+        const Size3 size = _valid.size();
+
+        if (i + 1 < size.x && _valid(i + 1, j, k)) {
+            *nb = Point3UI(i + 1, j, k);
+        } else if (i > 0 && _valid(i - 1, j, k)) {
+            *nb = Point3UI(i - 1, j, k);
+        } else if (j + 1 < size.y && _valid(i, j + 1, k)) {
+            *nb = Point3UI(i, j + 1, k);
+        } else if (j > 0 && _valid(i, j - 1, k)) {
+            *nb = Point3UI(i, j - 1, k);
+        } else if (k + 1 < size.z && _valid(i, j, k + 1)) {
+            *nb = Point3UI(i, j, k + 1);
+        } else if (k > 0 && _valid(i, j, k - 1)) {
+            *nb = Point3UI(i, j, k - 1);
+        } else {
+            return false;
+        }
+
+        return true;
+    }
+};
+
+// Advances the frontiers of all the extrapolators together. Each iteration
+// runs three parallel passes over the combined frontier chunks: averaging
+// from the valid cells, marking the frontier valid, and collecting the next
+// frontier. Since the first pass never reads a cell it writes, the result is
+// identical to the Jacobi-style update over the whole array.
+template <typename Extrapolator>
+void extrapolateToRegion(
+    std::vector<Extrapolator>* extrapolators,
+    unsigned int numberOfIterations) {
+    typedef typename Extrapolator::PointType PointType;
+
+    struct Chunk {
+        size_t index;
+        size_t begin;
+        size_t end;
+    };
+
+    std::vector<Chunk> chunks;
+    std::vector<std::vector<PointType>> nextFrontiers;
+    std::vector<PointType> frontier;
+
+    for (unsigned int iter = 0; iter < numberOfIterations; ++iter) {
+        chunks.clear();
+        for (size_t e = 0; e < extrapolators->size(); ++e) {
+            const size_t n = (*extrapolators)[e].frontier().size();
+            for (size_t b = 0; b < n; b += kExtrapolationChunkSize) {
+                chunks.push_back(
+                    {e, b, std::min(n, b + kExtrapolationChunkSize)});
+            }
+        }
+
+        if (chunks.empty()) {
+            break;
+        }
+
+        const ExecutionPolicy policy = (chunks.size() > 1)
+            ? ExecutionPolicy::kParallel
+            : ExecutionPolicy::kSerial;
+
+        parallelFor(kZeroSize, chunks.size(), [&](size_t c) {
+            const Chunk& chunk = chunks[c];
+            (*extrapolators)[chunk.index].extrapolate(chunk.begin, chunk.end);
+        }, policy);
+
+        parallelFor(kZeroSize, chunks.size(), [&](size_t c) {
+            const Chunk& chunk = chunks[c];
+            (*extrapolators)[chunk.index].validate(chunk.begin, chunk.end);
+        }, policy);
+
+        if (iter + 1 == numberOfIterations) {
+            break;
+        }
+
+        nextFrontiers.assign(chunks.size(), std::vector<PointType>());
+        parallelFor(kZeroSize, chunks.size(), [&](size_t c) {
+            const Chunk& chunk = chunks[c];
+            (*extrapolators)[chunk.index].findNextFrontier(
+                chunk.begin, chunk.end, &nextFrontiers[c]);
+        }, policy);
+
+        // Concatenate in chunk order to keep the frontier deterministic
+        size_t c = 0;
+        for (size_t e = 0; e < extrapolators->size(); ++e) {
+            frontier.clear();
+            for (; c < chunks.size() && chunks[c].index == e; ++c) {
+                frontier.insert(
+                    frontier.end(),
+                    nextFrontiers[c].begin(),
+                    nextFrontiers[c].end());
+            }
+            (*extrapolators)[e].setFrontier(&frontier);
+        }
     }
 }
 
+}  // namespace internal
+
+template <typename T>
+void extrapolateToRegion(
+    const ConstArrayAccessor2<T>& input,
+    const ConstArrayAccessor2<char>& valid,
+    unsigned int numberOfIterations,
+    ArrayAccessor2<T> output) {
+    std::vector<internal::RegionExtrapolator2<T>> extrapolators;
+    extrapolators.emplace_back(input, valid, output);
+
+    internal::extrapolateToRegion(&extrapolators, numberOfIterations);
+}
+
+template <typename T>
+void extrapolateToRegion(
+    const ConstArrayAccessor2<T>& uInput,
+    const ConstArrayAccessor2<T>& vInput,
+    const ConstArrayAccessor2<char>& uValid,
+    const ConstArrayAccessor2<char>& vValid,
+    unsigned int numberOfIterations,
+    ArrayAccessor2<T> uOutput,
+    ArrayAccessor2<T> vOutput) {
+    std::vector<internal::RegionExtrapolator2<T>> extrapolators;
+    extrapolators.reserve(2);
+    extrapolators.emplace_back(uInput, uValid, uOutput);
+    extrapolators.emplace_back(vInput, vValid, vOutput);
+
+    internal::extrapolateToRegion(&extrapolators, numberOfIterations);
+}
+
+template <typename T>
+void extrapolateToRegion(
+    const ConstArrayAccessor3<T>& input,
+    const ConstArrayAccessor3<char>& valid,
+    unsigned int numberOfIterations,
+    ArrayAccessor3<T> output) {
+    std::vector<internal::RegionExtrapolator3<T>> extrapolators;
+    extrapolators.emplace_back(input, valid, output);
+
+    internal::extrapolateToRegion(&extrapolators, numberOfIterations);
+}
+
+template <typename T>
+void extrapolateToRegion(
+    const ConstArrayAccessor3<T>& uInput,
+    const ConstArrayAccessor3<T>& vInput,
+    const ConstArrayAccessor3<T>& wInput,
+    const ConstArrayAccessor3<char>& uValid,
+    const ConstArrayAccessor3<char>& vValid,
+    const ConstArrayAccessor3<char>& wValid,
+    unsigned int numberOfIterations,
+    ArrayAccessor3<T> uOutput,
+    ArrayAccessor3<T> vOutput,
+    ArrayAccessor3<T> wOutput) {
+    std::vector<internal::RegionExtrapolator3<T>> extrapolators;
+    extrapolators.reserve(3);
+    extrapolators.emplace_back(uInput, uValid, uOutput);
+    extrapolators.emplace_back(vInput, vValid, vOutput);
+    extrapolators.emplace_back(wInput, wValid, wOutput);
+
+    internal::extrapolateToRegion(&extrapolators, numberOfIterations);
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_ARRAY_UTILS_INL_H_
@@ -8,10 +8,139 @@
 #define INCLUDE_JET_DETAIL_CG_INL_H_
 
 #include <jet/constants.h>
+
 #include <limits>
+#include <type_traits>
+#include <utility>
 
 namespace jet {
 
+namespace internal {
+
+// Detects whether BlasType provides the fused operations mvmAndDot and
+// axpyPairAndDot. If it does, CG uses them to reduce the number of passes over
+// the vectors per iteration.
+template <typename BlasType>
+struct HasFusedCgOperations {
+    typedef typename BlasType::MatrixType M;
+    typedef typename BlasType::VectorType V;
+
+    template <typename B>
+    static auto test(int) -> decltype(
+        B::mvmAndDot(std::declval<const M&>(), std::declval<const V&>(),
+                     std::declval<V*>()),
+        B::axpyPairAndDot(0.0, std::declval<const V&>(),
+                          std::declval<const V&>(), std::declval<V*>(),
+                          std::declval<V*>()),
+        std::true_type());
+
+    template <typename B>
+    static std::false_type test(...);
+
+    typedef decltype(test<BlasType>(0)) type;
+};
+
+// Computes q = Ad and returns d.q
+template <typename BlasType>
+double mvmAndDot(const typename BlasType::MatrixType& A,
+                 const typename BlasType::VectorType& d,
+                 typename BlasType::VectorType* q, std::true_type) {
+    return BlasType::mvmAndDot(A, d, q);
+}
+
+template <typename BlasType>
+double mvmAndDot(const typename BlasType::MatrixType& A,
+                 const typename BlasType::VectorType& d,
+                 typename BlasType::VectorType* q, std::false_type) {
+    BlasType::mvm(A, d, q);
+    return BlasType::dot(d, *q);
+}
+
+// Computes x = x + alpha*d and r = r - alpha*q
+template <typename BlasType>
+void axpyPair(double alpha, const typename BlasType::VectorType& d,
+              const typename BlasType::VectorType& q,
+              typename BlasType::VectorType* x,
+              typename BlasType::VectorType* r, std::true_type) {
+    BlasType::axpyPairAndDot(alpha, d, q, x, r);
+}
+
+template <typename BlasType>
+void axpyPair(double alpha, const typename BlasType::VectorType& d,
+              const typename BlasType::VectorType& q,
+              typename BlasType::VectorType* x,
+              typename BlasType::VectorType* r, std::false_type) {
+    BlasType::axpy(alpha, d, *x, x);
+    BlasType::axpy(-alpha, q, *r, r);
+}
+
+// CG without preconditioner using the fused operations. Since the
+// preconditioned residual s is r itself, s is neither computed nor used, and
+// each iteration takes three passes: q = Ad with d.q, the updates of x and r
+// with r.r, and the update of d.
+template <typename BlasType>
+void cg(const typename BlasType::MatrixType& A,
+        const typename BlasType::VectorType& b,
+        unsigned int maxNumberOfIterations, double tolerance,
+        typename BlasType::VectorType* x, typename BlasType::VectorType* r,
+        typename BlasType::VectorType* d, typename BlasType::VectorType* q,
+        typename BlasType::VectorType*, unsigned int* lastNumberOfIterations,
+        double* lastResidualNorm, std::true_type) {
+    // Clear
+    BlasType::set(0, r);
+    BlasType::set(0, q);
+
+    // r = b - Ax
+    BlasType::residual(A, *x, b, r);
+
+    // d = r
+    BlasType::set(*r, d);
+
+    // sigmaNew = r.r
+    double sigmaNew = BlasType::dot(*r, *r);
+
+    unsigned int iter = 0;
+    bool trigger = false;
+    while (sigmaNew > square(tolerance) && iter < maxNumberOfIterations) {
+        // q = Ad, alpha = sigmaNew/d.q
+        double alpha = sigmaNew / BlasType::mvmAndDot(A, *d, q);
+
+        // sigmaOld = sigmaNew
+        double sigmaOld = sigmaNew;
+
+        // if i is divisible by 50...
+        if (trigger || (iter % 50 == 0 && iter > 0)) {
+            // x = x + alpha*d, r = b - Ax, sigmaNew = r.r
+            BlasType::axpy(alpha, *d, *x, x);
+            BlasType::residual(A, *x, b, r);
+            sigmaNew = BlasType::dot(*r, *r);
+            trigger = false;
+        } else {
+            // x = x + alpha*d, r = r - alpha*q, sigmaNew = r.r
+            sigmaNew = BlasType::axpyPairAndDot(alpha, *d, *q, x, r);
+        }
+
+        if (sigmaNew > sigmaOld) {
+            trigger = true;
+        }
+
+        // beta = sigmaNew/sigmaOld
+        double beta = sigmaNew / sigmaOld;
+
+        // d = r + beta*d
+        BlasType::axpy(beta, *d, *r, d);
+
+        ++iter;
+    }
+
+    *lastNumberOfIterations = iter;
+
+    // std::fabs(sigmaNew) - Workaround for negative zero
+    *lastResidualNorm = std::sqrt(std::fabs(sigmaNew));
+}
+
+}  // namespace internal
+
 template <
     typename BlasType,
     typename PrecondType>
@@ -43,26 +172,24 @@ void pcg(
     // sigmaNew = r.d
     double sigmaNew = BlasType::dot(*r, *d);
 
+    typename internal::HasFusedCgOperations<BlasType>::type hasFused;
+
     unsigned int iter = 0;
     bool trigger = false;
     while (sigmaNew > square(tolerance) && iter < maxNumberOfIterations) {
-        // q = Ad
-        BlasType::mvm(A, *d, q);
-
-        // alpha = sigmaNew/d.q
-        double alpha = sigmaNew / BlasType::dot(*d, *q);
-
-        // x = x + alpha*d
-        BlasType::axpy(alpha, *d, *x, x);
+        // q = Ad, alpha = sigmaNew/d.q
+        double alpha =
+            sigmaNew / internal::mvmAndDot<BlasType>(A, *d, q, hasFused);
 
         // if i is divisible by 50...
         if (trigger || (iter % 50 == 0 && iter > 0)) {
-            // r = b - Ax
+            // x = x + alpha*d, r = b - Ax
+            BlasType::axpy(alpha, *d, *x, x);
             BlasType::residual(A, *x, b, r);
             trigger = false;
         } else {
-            // r = r - alpha*q
-            BlasType::axpy(-alpha, *q, *r, r);
+            // x = x + alpha*d, r = r - alpha*q
+            internal::axpyPair<BlasType>(alpha, *d, *q, x, r, hasFused);
         }
 
         // s = M^-1r
@@ -93,6 +220,37 @@ void pcg(
     *lastResidualNorm = std::sqrt(std::fabs(sigmaNew));
 }
 
+namespace internal {
+
+// CG without the fused operations, which runs PCG with the identity
+// preconditioner.
+template <typename BlasType>
+void cg(const typename BlasType::MatrixType& A,
+        const typename BlasType::VectorType& b,
+        unsigned int maxNumberOfIterations, double tolerance,
+        typename BlasType::VectorType* x, typename BlasType::VectorType* r,
+        typename BlasType::VectorType* d, typename BlasType::VectorType* q,
+        typename BlasType::VectorType* s, unsigned int* lastNumberOfIterations,
+        double* lastResidualNorm, std::false_type) {
+    typedef NullCgPreconditioner<BlasType> PrecondType;
+    PrecondType precond;
+    pcg<BlasType, PrecondType>(
+        A,
+        b,
+        maxNumberOfIterations,
+        tolerance,
+        &precond,
+        x,
+        r,
+        d,
+        q,
+        s,
+        lastNumberOfIterations,
+        lastResidualNorm);
+}
+
+}  // namespace internal
+
 template <typename BlasType>
 void cg(
     const typename BlasType::MatrixType& A,
@@ -106,21 +264,19 @@ void cg(
     typename BlasType::VectorType* s,
     unsigned int* lastNumberOfIterations,
     double* lastResidualNorm) {
-    typedef NullCgPreconditioner<BlasType> PrecondType;
-    PrecondType precond;
-    pcg<BlasType, PrecondType>(
+    internal::cg<BlasType>(
         A,
         b,
         maxNumberOfIterations,
         tolerance,
-        &precond,
         x,
         r,
         d,
         q,
         s,
         lastNumberOfIterations,
-        lastResidualNorm);
+        lastResidualNorm,
+        typename internal::HasFusedCgOperations<BlasType>::type());
 }
 
 }  // namespace jet
@@ -0,0 +1,72 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_FDM_LINEAR_SYSTEM3_INL_H_
+#define INCLUDE_JET_DETAIL_FDM_LINEAR_SYSTEM3_INL_H_
+
+#include <jet/fdm_linear_system3.h>
+
+namespace jet {
+
+template <typename Callback>
+void FdmStencilMatrix3::forEachLowerNeighbor(size_t row,
+                                             const Callback& func) const {
+    const Size3 size = rowIndices.size();
+    const size_t strideY = size.x;
+    const size_t strideZ = size.x * size.y;
+    const uint32_t* map = rowIndices.data();
+    const size_t c = cellIndices[row];
+
+    // The point before (0, j, k) is (width - 1, j - 1, k) whose coupling to
+    // the right is zero, and the same goes for the other axes. So only the
+    // range of the linear index has to be checked.
+    if (c >= 1) {
+        const uint32_t n = map[c - 1];
+        if (n != kInvalidRow && rows[n].right != 0.0f) {
+            func(static_cast<size_t>(n), static_cast<double>(rows[n].right));
+        }
+    }
+    if (c >= strideY) {
+        const uint32_t n = map[c - strideY];
+        if (n != kInvalidRow && rows[n].up != 0.0f) {
+            func(static_cast<size_t>(n), static_cast<double>(rows[n].up));
+        }
+    }
+    if (c >= strideZ) {
+        const uint32_t n = map[c - strideZ];
+        if (n != kInvalidRow && rows[n].front != 0.0f) {
+            func(static_cast<size_t>(n), static_cast<double>(rows[n].front));
+        }
+    }
+}
+
+template <typename Callback>
+void FdmStencilMatrix3::forEachUpperNeighbor(size_t row,
+                                             const Callback& func) const {
+    const Size3 size = rowIndices.size();
+    const size_t strideY = size.x;
+    const size_t strideZ = size.x * size.y;
+    const uint32_t* map = rowIndices.data();
+    const size_t c = cellIndices[row];
+    const FdmMatrixRow3F& r = rows[row];
+
+    // Non-zero couplings always refer to active points inside the grid.
+    if (r.right != 0.0f) {
+        func(static_cast<size_t>(map[c + 1]), static_cast<double>(r.right));
+    }
+    if (r.up != 0.0f) {
+        func(static_cast<size_t>(map[c + strideY]),
+             static_cast<double>(r.up));
+    }
+    if (r.front != 0.0f) {
+        func(static_cast<size_t>(map[c + strideZ]),
+             static_cast<double>(r.front));
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_FDM_LINEAR_SYSTEM3_INL_H_
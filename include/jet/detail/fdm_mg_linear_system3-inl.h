@@ -35,18 +35,23 @@ template <typename T>
 void FdmMgUtils3::resizeArrayWithFinest(const Size3& finestResolution,
                                         size_t maxNumberOfLevels,
                                         std::vector<Array3<T>>* levels) {
+    maxNumberOfLevels = std::max(maxNumberOfLevels, kOneSize);
+
+    // Cell-centered coarsening: each level takes ceil(n / 2) cells per axis.
+    std::vector<Size3> resolutions(1, finestResolution);
     Size3 res = finestResolution;
-    size_t i = 1;
-    for (; i < maxNumberOfLevels; ++i) {
-        if (res.x % 2 == 0 && res.y % 2 == 0 && res.z % 2 == 0) {
-            res.x = res.x >> 1;
-            res.y = res.y >> 1;
-            res.z = res.z >> 1;
-        } else {
-            break;
-        }
+    while (resolutions.size() < maxNumberOfLevels && res.x > 1 && res.y > 1 &&
+           res.z > 1) {
+        res.x = (res.x + 1) >> 1;
+        res.y = (res.y + 1) >> 1;
+        res.z = (res.z + 1) >> 1;
+        resolutions.push_back(res);
+    }
+
+    levels->resize(resolutions.size());
+    for (size_t level = 0; level < resolutions.size(); ++level) {
+        (*levels)[level].resize(resolutions[level]);
     }
-    resizeArrayWithCoarsest(res, i, levels);
 }
 
 }  // namespace jet
@@ -0,0 +1,90 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_GRID_SAMPLERS2_INL_H_
+#define INCLUDE_JET_DETAIL_GRID_SAMPLERS2_INL_H_
+
+#include <jet/macros.h>
+#include <jet/math_utils.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace jet {
+
+template <typename T, typename R>
+LinearFaceCenteredArraySampler2<T, R>::LinearFaceCenteredArraySampler2(
+    const ConstArrayAccessor2<T>& uAccessor,
+    const ConstArrayAccessor2<T>& vAccessor, const Vector2<R>& gridSpacing,
+    const Vector2<R>& uOrigin, const Vector2<R>& vOrigin)
+    : _uAccessor(uAccessor),
+      _vAccessor(vAccessor),
+      _gridSpacing(gridSpacing),
+      _alignedOrigin(uOrigin.x, vOrigin.y),
+      _shiftedOrigin(vOrigin.x, uOrigin.y),
+      _alignedSize(uAccessor.size().x, vAccessor.size().y),
+      _shiftedSize(vAccessor.size().x, uAccessor.size().y) {}
+
+template <typename T, typename R>
+Vector2<T> LinearFaceCenteredArraySampler2<T, R>::operator()(
+    const Vector2<R>& pt) const {
+    // a: aligned with the faces, s: shifted by the half grid spacing.
+    ssize_t ia, ja, is, js;
+    R fxa, fya, fxs, fys;
+
+    JET_ASSERT(_gridSpacing.x > std::numeric_limits<R>::epsilon() &&
+               _gridSpacing.y > std::numeric_limits<R>::epsilon());
+    const Vector2<R> na = (pt - _alignedOrigin) / _gridSpacing;
+    const Vector2<R> ns = (pt - _shiftedOrigin) / _gridSpacing;
+
+    const ssize_t iSizeA = static_cast<ssize_t>(_alignedSize.x);
+    const ssize_t jSizeA = static_cast<ssize_t>(_alignedSize.y);
+    const ssize_t iSizeS = static_cast<ssize_t>(_shiftedSize.x);
+    const ssize_t jSizeS = static_cast<ssize_t>(_shiftedSize.y);
+
+    getBarycentric(na.x, 0, iSizeA - 1, &ia, &fxa);
+    getBarycentric(na.y, 0, jSizeA - 1, &ja, &fya);
+    getBarycentric(ns.x, 0, iSizeS - 1, &is, &fxs);
+    getBarycentric(ns.y, 0, jSizeS - 1, &js, &fys);
+
+    const ssize_t ip1a = std::min(ia + 1, iSizeA - 1);
+    const ssize_t jp1a = std::min(ja + 1, jSizeA - 1);
+    const ssize_t ip1s = std::min(is + 1, iSizeS - 1);
+    const ssize_t jp1s = std::min(js + 1, jSizeS - 1);
+
+    const ConstArrayAccessor2<T>& u = _uAccessor;
+    const ConstArrayAccessor2<T>& v = _vAccessor;
+
+    return Vector2<T>(bilerp(u(ia, js), u(ip1a, js), u(ia, jp1s),
+                             u(ip1a, jp1s), fxa, fys),
+                      bilerp(v(is, ja), v(ip1s, ja), v(is, jp1a),
+                             v(ip1s, jp1a), fxs, fya));
+}
+
+template <typename GridType>
+LinearGridSampler2<GridType>::LinearGridSampler2(const GridType& grid)
+    : _sampler(grid.constDataAccessor(), grid.gridSpacing(),
+               grid.dataOrigin()) {}
+
+template <typename GridType>
+typename LinearGridSampler2<GridType>::ValueType LinearGridSampler2<
+    GridType>::operator()(const Vector2D& pt) const {
+    return _sampler(pt);
+}
+
+inline LinearGridSampler2<FaceCenteredGrid2>::LinearGridSampler2(
+    const FaceCenteredGrid2& grid)
+    : _sampler(grid.uConstAccessor(), grid.vConstAccessor(),
+               grid.gridSpacing(), grid.uOrigin(), grid.vOrigin()) {}
+
+inline Vector2D LinearGridSampler2<FaceCenteredGrid2>::operator()(
+    const Vector2D& pt) const {
+    return _sampler(pt);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_GRID_SAMPLERS2_INL_H_
@@ -0,0 +1,110 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_GRID_SAMPLERS3_INL_H_
+#define INCLUDE_JET_DETAIL_GRID_SAMPLERS3_INL_H_
+
+#include <jet/macros.h>
+#include <jet/math_utils.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace jet {
+
+template <typename T, typename R>
+LinearFaceCenteredArraySampler3<T, R>::LinearFaceCenteredArraySampler3(
+    const ConstArrayAccessor3<T>& uAccessor,
+    const ConstArrayAccessor3<T>& vAccessor,
+    const ConstArrayAccessor3<T>& wAccessor, const Vector3<R>& gridSpacing,
+    const Vector3<R>& uOrigin, const Vector3<R>& vOrigin,
+    const Vector3<R>& wOrigin)
+    : _uAccessor(uAccessor),
+      _vAccessor(vAccessor),
+      _wAccessor(wAccessor),
+      _gridSpacing(gridSpacing),
+      _alignedOrigin(uOrigin.x, vOrigin.y, wOrigin.z),
+      _shiftedOrigin(vOrigin.x, uOrigin.y, uOrigin.z),
+      _alignedSize(uAccessor.size().x, vAccessor.size().y,
+                   wAccessor.size().z),
+      _shiftedSize(vAccessor.size().x, uAccessor.size().y,
+                   uAccessor.size().z) {}
+
+template <typename T, typename R>
+Vector3<T> LinearFaceCenteredArraySampler3<T, R>::operator()(
+    const Vector3<R>& pt) const {
+    // a: aligned with the faces, s: shifted by the half grid spacing.
+    ssize_t ia, ja, ka, is, js, ks;
+    R fxa, fya, fza, fxs, fys, fzs;
+
+    JET_ASSERT(_gridSpacing.x > std::numeric_limits<R>::epsilon() &&
+               _gridSpacing.y > std::numeric_limits<R>::epsilon() &&
+               _gridSpacing.z > std::numeric_limits<R>::epsilon());
+    const Vector3<R> na = (pt - _alignedOrigin) / _gridSpacing;
+    const Vector3<R> ns = (pt - _shiftedOrigin) / _gridSpacing;
+
+    const ssize_t iSizeA = static_cast<ssize_t>(_alignedSize.x);
+    const ssize_t jSizeA = static_cast<ssize_t>(_alignedSize.y);
+    const ssize_t kSizeA = static_cast<ssize_t>(_alignedSize.z);
+    const ssize_t iSizeS = static_cast<ssize_t>(_shiftedSize.x);
+    const ssize_t jSizeS = static_cast<ssize_t>(_shiftedSize.y);
+    const ssize_t kSizeS = static_cast<ssize_t>(_shiftedSize.z);
+
+    getBarycentric(na.x, 0, iSizeA - 1, &ia, &fxa);
+    getBarycentric(na.y, 0, jSizeA - 1, &ja, &fya);
+    getBarycentric(na.z, 0, kSizeA - 1, &ka, &fza);
+    getBarycentric(ns.x, 0, iSizeS - 1, &is, &fxs);
+    getBarycentric(ns.y, 0, jSizeS - 1, &js, &fys);
+    getBarycentric(ns.z, 0, kSizeS - 1, &ks, &fzs);
+
+    const ssize_t ip1a = std::min(ia + 1, iSizeA - 1);
+    const ssize_t jp1a = std::min(ja + 1, jSizeA - 1);
+    const ssize_t kp1a = std::min(ka + 1, kSizeA - 1);
+    const ssize_t ip1s = std::min(is + 1, iSizeS - 1);
+    const ssize_t jp1s = std::min(js + 1, jSizeS - 1);
+    const ssize_t kp1s = std::min(ks + 1, kSizeS - 1);
+
+    const ConstArrayAccessor3<T>& u = _uAccessor;
+    const ConstArrayAccessor3<T>& v = _vAccessor;
+    const ConstArrayAccessor3<T>& w = _wAccessor;
+
+    return Vector3<T>(
+        trilerp(u(ia, js, ks), u(ip1a, js, ks), u(ia, jp1s, ks),
+                u(ip1a, jp1s, ks), u(ia, js, kp1s), u(ip1a, js, kp1s),
+                u(ia, jp1s, kp1s), u(ip1a, jp1s, kp1s), fxa, fys, fzs),
+        trilerp(v(is, ja, ks), v(ip1s, ja, ks), v(is, jp1a, ks),
+                v(ip1s, jp1a, ks), v(is, ja, kp1s), v(ip1s, ja, kp1s),
+                v(is, jp1a, kp1s), v(ip1s, jp1a, kp1s), fxs, fya, fzs),
+        trilerp(w(is, js, ka), w(ip1s, js, ka), w(is, jp1s, ka),
+                w(ip1s, jp1s, ka), w(is, js, kp1a), w(ip1s, js, kp1a),
+                w(is, jp1s, kp1a), w(ip1s, jp1s, kp1a), fxs, fys, fza));
+}
+
+template <typename GridType>
+LinearGridSampler3<GridType>::LinearGridSampler3(const GridType& grid)
+    : _sampler(grid.constDataAccessor(), grid.gridSpacing(),
+               grid.dataOrigin()) {}
+
+template <typename GridType>
+typename LinearGridSampler3<GridType>::ValueType LinearGridSampler3<
+    GridType>::operator()(const Vector3D& pt) const {
+    return _sampler(pt);
+}
+
+inline LinearGridSampler3<FaceCenteredGrid3>::LinearGridSampler3(
+    const FaceCenteredGrid3& grid)
+    : _sampler(grid.uConstAccessor(), grid.vConstAccessor(),
+               grid.wConstAccessor(), grid.gridSpacing(), grid.uOrigin(),
+               grid.vOrigin(), grid.wOrigin()) {}
+
+inline Vector3D LinearGridSampler3<FaceCenteredGrid3>::operator()(
+    const Vector3D& pt) const {
+    return _sampler(pt);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_GRID_SAMPLERS3_INL_H_
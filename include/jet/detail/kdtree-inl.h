@@ -63,9 +63,9 @@ void KdTree<T, K>::build(const ConstArrayAccessor1<Point>& points) {
 }
 
 template <typename T, size_t K>
-void KdTree<T, K>::forEachNearbyPoint(
-    const Point& origin, T radius,
-    const std::function<void(size_t, const Point&)>& callback) const {
+template <typename Callback>
+void KdTree<T, K>::forEachNearbyPoint(const Point& origin, T radius,
+                                      const Callback& callback) const {
     const T r2 = radius * radius;
 
     // prepare to traverse the tree for sphere
@@ -14,9 +14,10 @@ namespace jet {
 namespace internal {
 
 template <typename BlasType>
-MgResult mgVCycle(const MgMatrix<BlasType>& A, MgParameters<BlasType> params,
-                  unsigned int currentLevel, MgVector<BlasType>* x,
-                  MgVector<BlasType>* b, MgVector<BlasType>* buffer) {
+void mgCycle(const MgMatrix<BlasType>& A, MgParameters<BlasType> params,
+             MgCycleType cycleType, unsigned int currentLevel,
+             MgVector<BlasType>* x, MgVector<BlasType>* b,
+             MgVector<BlasType>* buffer) {
     // 1) Relax a few times on Ax = b, with arbitrary x
     params.relaxFunc(A[currentLevel], (*b)[currentLevel],
                      params.numberOfRestrictionIter, params.maxTolerance,
@@ -33,7 +34,24 @@ MgResult mgVCycle(const MgMatrix<BlasType>& A, MgParameters<BlasType> params,
 
         params.maxTolerance *= 0.5;
         // Solve Ae = r
-        mgVCycle(A, params, currentLevel + 1, x, b, buffer);
+        switch (cycleType) {
+            case MgCycleType::kW:
+                mgCycle(A, params, MgCycleType::kW, currentLevel + 1, x, b,
+                        buffer);
+                mgCycle(A, params, MgCycleType::kW, currentLevel + 1, x, b,
+                        buffer);
+                break;
+            case MgCycleType::kF:
+                mgCycle(A, params, MgCycleType::kF, currentLevel + 1, x, b,
+                        buffer);
+                mgCycle(A, params, MgCycleType::kV, currentLevel + 1, x, b,
+                        buffer);
+                break;
+            default:
+                mgCycle(A, params, MgCycleType::kV, currentLevel + 1, x, b,
+                        buffer);
+                break;
+        }
         params.maxTolerance *= 2.0;
 
         // 3) correct
@@ -49,21 +67,32 @@ MgResult mgVCycle(const MgMatrix<BlasType>& A, MgParameters<BlasType> params,
                              params.numberOfFinalIter, params.maxTolerance,
                              &((*x)[currentLevel]), &((*buffer)[currentLevel]));
         }
-    } else {
+    } else if (params.coarsestSolveFunc) {
         // 5) solve directly with initial guess x
+        params.coarsestSolveFunc(A[currentLevel], (*b)[currentLevel],
+                                 params.numberOfCoarsestIter,
+                                 params.maxTolerance, &((*x)[currentLevel]),
+                                 &((*buffer)[currentLevel]));
+    } else {
+        // 5) solve with relaxation with initial guess x
         params.relaxFunc(A[currentLevel], (*b)[currentLevel],
                          params.numberOfCoarsestIter, params.maxTolerance,
                          &((*x)[currentLevel]), &((*buffer)[currentLevel]));
-
-        BlasType::residual(A[currentLevel], (*x)[currentLevel],
-                           (*b)[currentLevel], &(*buffer)[currentLevel]);
     }
+}
 
-    BlasType::residual(A[currentLevel], (*x)[currentLevel], (*b)[currentLevel],
-                       &(*buffer)[currentLevel]);
+template <typename BlasType>
+MgResult mgCycle(const MgMatrix<BlasType>& A,
+                 const MgParameters<BlasType>& params, MgCycleType cycleType,
+                 MgVector<BlasType>* x, MgVector<BlasType>* b,
+                 MgVector<BlasType>* buffer) {
+    mgCycle<BlasType>(A, params, cycleType, 0u, x, b, buffer);
+
+    // Only the finest residual is reported, so the coarser levels skip it.
+    BlasType::residual(A[0], (*x)[0], (*b)[0], &(*buffer)[0]);
 
     MgResult result;
-    result.lastResidualNorm = BlasType::l2Norm((*buffer)[currentLevel]);
+    result.lastResidualNorm = BlasType::l2Norm((*buffer)[0]);
     return result;
 }
 
@@ -115,8 +144,18 @@ template <typename BlasType>
 MgResult mgVCycle(const MgMatrix<BlasType>& A, MgParameters<BlasType> params,
                   MgVector<BlasType>* x, MgVector<BlasType>* b,
                   MgVector<BlasType>* buffer) {
-    return internal::mgVCycle<BlasType>(A, params, 0u, x, b, buffer);
+    return internal::mgCycle<BlasType>(A, params, MgCycleType::kV, x, b,
+                                       buffer);
+}
+
+template <typename BlasType>
+MgResult mgCycle(const MgMatrix<BlasType>& A, MgParameters<BlasType> params,
+                 MgVector<BlasType>* x, MgVector<BlasType>* b,
+                 MgVector<BlasType>* buffer) {
+    return internal::mgCycle<BlasType>(A, params, params.cycleType, x, b,
+                                       buffer);
 }
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_MG_INL_H_
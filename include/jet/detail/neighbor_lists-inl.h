@@ -0,0 +1,43 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_NEIGHBOR_LISTS_INL_H_
+#define INCLUDE_JET_DETAIL_NEIGHBOR_LISTS_INL_H_
+
+#include <jet/macros.h>
+#include <jet/neighbor_lists.h>
+
+#include <limits>
+
+namespace jet {
+
+template <typename ForEachPairFunc>
+void NeighborLists::build(size_t numberOfPoints,
+                          const ForEachPairFunc& forEachPair) {
+    JET_THROW_INVALID_ARG_IF(
+        numberOfPoints > std::numeric_limits<uint32_t>::max());
+
+    // Count neighbors per point. _offsets[i + 1] holds the count of point i
+    // until the prefix sum below turns it into the end offset.
+    _offsets.assign(numberOfPoints + 1, 0);
+    forEachPair([&](size_t i, size_t) { ++_offsets[i + 1]; });
+
+    for (size_t i = 0; i < numberOfPoints; ++i) {
+        _offsets[i + 1] += _offsets[i];
+    }
+
+    // Fill neighbor indices. Each point writes to its own range, so a cursor
+    // per point is enough to avoid any synchronization.
+    _indices.resize(_offsets[numberOfPoints]);
+    std::vector<size_t> cursors(_offsets.begin(), _offsets.end() - 1);
+    forEachPair([&](size_t i, size_t j) {
+        _indices[cursors[i]++] = static_cast<uint32_t>(j);
+    });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_NEIGHBOR_LISTS_INL_H_
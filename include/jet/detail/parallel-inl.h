@@ -20,14 +20,53 @@
 #include <tbb/parallel_reduce.h>
 #include <tbb/parallel_sort.h>
 #include <tbb/task.h>
-#elif defined(JET_TASKING_CPP11THREADS)
-#include <thread>
 #endif
 
 namespace jet {
 
 namespace internal {
 
+// Runs func(chunk) for each chunk in [0, numberOfChunks) on the persistent
+// thread pool, and returns when all the chunks are done.
+void runChunks(size_t numberOfChunks, const std::function<void(size_t)>& func);
+
+// Submits a task to the persistent thread pool without waiting for it.
+void submitTask(std::function<void()> task);
+
+#ifdef JET_TASKING_CPP11THREADS
+// Number of chunks per thread when splitting a range for the thread pool.
+// Splitting finer than the number of threads lets the idle threads steal the
+// remaining work of the busy ones.
+const size_t kChunksPerThread = 4;
+
+template <typename IndexType>
+size_t numberOfChunks(IndexType start, IndexType end, ExecutionPolicy policy) {
+    const size_t n = static_cast<size_t>(end - start);
+    if (n == 0 || policy == ExecutionPolicy::kSerial) {
+        return std::min(n, kOneSize);
+    }
+
+    unsigned int numThreadsHint = maxNumberOfThreads();
+    const size_t numThreads = (numThreadsHint == 0u ? 8u : numThreadsHint);
+    return std::min(n, numThreads * kChunksPerThread);
+}
+
+// Splits [start, end) into numberOfChunks contiguous sub-ranges and calls
+// func(chunk, begin, end) for each of them on the thread pool.
+template <typename IndexType, typename Function>
+void forEachChunk(IndexType start, IndexType end, size_t numberOfChunks,
+                  const Function& func) {
+    const size_t n = static_cast<size_t>(end - start);
+    runChunks(numberOfChunks, [&](size_t chunk) {
+        const IndexType i1 =
+            start + static_cast<IndexType>(n * chunk / numberOfChunks);
+        const IndexType i2 =
+            start + static_cast<IndexType>(n * (chunk + 1) / numberOfChunks);
+        func(chunk, i1, i2);
+    });
+}
+#endif
+
 // NOTE - This abstraction takes a lambda which should take captured
 //        variables by *value* to ensure no captured references race
 //        with the task itself.
@@ -47,8 +86,7 @@ inline void schedule(TASK_T&& fcn) {
         LocalTBBTask(std::forward<TASK_T>(fcn));
     tbb::task::enqueue(*tbb_node);
 #elif defined(JET_TASKING_CPP11THREADS)
-    std::thread thread(fcn);
-    thread.detach();
+    submitTask(std::function<void()>(std::forward<TASK_T>(fcn)));
 #else  // OpenMP or Serial --> synchronous!
     fcn();
 #endif
@@ -122,34 +160,29 @@ void parallelMergeSort(RandomIterator a, size_t size, RandomIterator2 temp,
     if (numThreads == 1) {
         std::sort(a, a + size, compareFunction);
     } else if (numThreads > 1) {
-        std::vector<std::future<void>> pool;
-        pool.reserve(2);
-
-        auto launchRange = [compareFunction](RandomIterator begin, size_t k2,
-                                             RandomIterator2 temp,
-                                             unsigned int numThreads) {
-            parallelMergeSort(begin, k2, temp, numThreads, compareFunction);
-        };
-
-        pool.emplace_back(internal::async(
-            [=]() { launchRange(a, size / 2, temp, numThreads / 2); }));
-
-        pool.emplace_back(internal::async([=]() {
-            launchRange(a + size / 2, size - size / 2, temp + size / 2,
-                        numThreads - numThreads / 2);
-        }));
-
-        // Wait for jobs to finish
-        for (auto& f : pool) {
-            if (f.valid()) {
-                f.wait();
+        // Sort the two halves as nested parallel tasks. Waiting on futures
+        // would block the pool threads, while the nested loop keeps the
+        // waiting thread busy with the pending tasks.
+        parallelFor(0, 2, [&](int half) {
+            if (half == 0) {
+                parallelMergeSort(a, size / 2, temp, numThreads / 2,
+                                  compareFunction);
+            } else {
+                parallelMergeSort(a + size / 2, size - size / 2,
+                                  temp + size / 2,
+                                  numThreads - numThreads / 2,
+                                  compareFunction);
             }
-        }
+        });
 
         merge(a, size, temp, compareFunction);
     }
 }
 
+// Number of chunks of parallelDeterministicReduce. It depends only on the
+// range, so that the results do not depend on the number of threads.
+const size_t kNumberOfDeterministicReduceChunks = 256;
+
 }  // namespace internal
 
 template <typename RandomIterator, typename T>
@@ -183,46 +216,15 @@ void parallelFor(IndexType start, IndexType end, const Function& func,
     }
 
 #elif JET_TASKING_CPP11THREADS
-    // Estimate number of threads in the pool
-    unsigned int numThreadsHint = maxNumberOfThreads();
-    const unsigned int numThreads =
-        (policy == ExecutionPolicy::kParallel)
-            ? (numThreadsHint == 0u ? 8u : numThreadsHint)
-            : 1;
-
-    // Size of a slice for the range functions
-    IndexType n = end - start + 1;
-    IndexType slice =
-        (IndexType)std::round(n / static_cast<double>(numThreads));
-    slice = std::max(slice, IndexType(1));
-
-    // [Helper] Inner loop
-    auto launchRange = [&func](IndexType k1, IndexType k2) {
-        for (IndexType k = k1; k < k2; k++) {
-            func(k);
-        }
-    };
-
-    // Create pool and launch jobs
-    std::vector<std::thread> pool;
-    pool.reserve(numThreads);
-    IndexType i1 = start;
-    IndexType i2 = std::min(start + slice, end);
-    for (unsigned int i = 0; i + 1 < numThreads && i1 < end; ++i) {
-        pool.emplace_back(launchRange, i1, i2);
-        i1 = i2;
-        i2 = std::min(i2 + slice, end);
-    }
-    if (i1 < end) {
-        pool.emplace_back(launchRange, i1, end);
-    }
-
-    // Wait for jobs to finish
-    for (std::thread& t : pool) {
-        if (t.joinable()) {
-            t.join();
-        }
-    }
+    const size_t numberOfChunks =
+        internal::numberOfChunks(start, end, policy);
+
+    internal::forEachChunk(start, end, numberOfChunks,
+                           [&func](size_t, IndexType k1, IndexType k2) {
+                               for (IndexType k = k1; k < k2; ++k) {
+                                   func(k);
+                               }
+                           });
 #else
 
 #ifdef JET_TASKING_OPENMP
@@ -266,6 +268,15 @@ void parallelRangeFor(IndexType start, IndexType end, const Function& func,
         func(start, end);
     }
 
+#elif JET_TASKING_CPP11THREADS
+    const size_t numberOfChunks =
+        internal::numberOfChunks(start, end, policy);
+
+    internal::forEachChunk(start, end, numberOfChunks,
+                           [&func](size_t, IndexType k1, IndexType k2) {
+                               func(k1, k2);
+                           });
+
 #else
     // Estimate number of threads in the pool
     unsigned int numThreadsHint = maxNumberOfThreads();
@@ -379,6 +390,27 @@ Value parallelReduce(IndexType start, IndexType end, const Value& identity,
         return func(start, end, identity);
     }
 
+#elif JET_TASKING_CPP11THREADS
+    const size_t numberOfChunks =
+        internal::numberOfChunks(start, end, policy);
+
+    // Results
+    std::vector<Value> results(numberOfChunks, identity);
+
+    internal::forEachChunk(
+        start, end, numberOfChunks,
+        [&](size_t chunk, IndexType k1, IndexType k2) {
+            results[chunk] = func(k1, k2, identity);
+        });
+
+    // Gather
+    Value finalResult = identity;
+    for (const Value& val : results) {
+        finalResult = reduce(val, finalResult);
+    }
+
+    return finalResult;
+
 #else
     // Estimate number of threads in the pool
     unsigned int numThreadsHint = maxNumberOfThreads();
@@ -434,6 +466,45 @@ Value parallelReduce(IndexType start, IndexType end, const Value& identity,
 #endif
 }
 
+template <typename IndexType, typename Value, typename Function,
+          typename Reduce>
+Value parallelDeterministicReduce(IndexType start, IndexType end,
+                                  const Value& identity, const Function& func,
+                                  const Reduce& reduce,
+                                  ExecutionPolicy policy) {
+    if (start >= end) {
+        return identity;
+    }
+
+    // Split into the chunks of balanced sizes; the first n % numberOfChunks
+    // chunks take one more index.
+    const size_t n = static_cast<size_t>(end - start);
+    const size_t numberOfChunks =
+        std::min(n, internal::kNumberOfDeterministicReduceChunks);
+    const size_t chunkSize = n / numberOfChunks;
+    const size_t remainder = n % numberOfChunks;
+    auto chunkBegin = [&](size_t chunk) {
+        return start + static_cast<IndexType>(chunk * chunkSize +
+                                              std::min(chunk, remainder));
+    };
+
+    std::vector<Value> results(numberOfChunks, identity);
+    parallelFor(kZeroSize, numberOfChunks,
+                [&](size_t chunk) {
+                    results[chunk] = func(chunkBegin(chunk),
+                                          chunkBegin(chunk + 1), identity);
+                },
+                policy);
+
+    // Combine in the index order
+    Value finalResult = identity;
+    for (const Value& val : results) {
+        finalResult = reduce(finalResult, val);
+    }
+
+    return finalResult;
+}
+
 template <typename RandomIterator, typename CompareFunction>
 void parallelSort(RandomIterator begin, RandomIterator end,
                   CompareFunction compareFunction, ExecutionPolicy policy) {
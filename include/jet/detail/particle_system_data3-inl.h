@@ -0,0 +1,47 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_PARTICLE_SYSTEM_DATA3_INL_H_
+#define INCLUDE_JET_DETAIL_PARTICLE_SYSTEM_DATA3_INL_H_
+
+#include <jet/parallel.h>
+#include <jet/particle_system_data3.h>
+
+namespace jet {
+
+template <typename Callback>
+void ParticleSystemData3::forEachNearbyPoint(
+    const Vector3D& origin,
+    double radius,
+    const Callback& callback) const {
+    if (_parallelHashGridSearcher != nullptr) {
+        _parallelHashGridSearcher->forEachNearbyPoint(
+            origin, radius, callback);
+    } else {
+        _neighborSearcher->forEachNearbyPoint(origin, radius, callback);
+    }
+}
+
+template <typename Callback>
+void ParticleSystemData3::parallelForEachNearbyPoint(
+    double radius, const Callback& callback) const {
+    if (_parallelHashGridSearcher != nullptr) {
+        _parallelHashGridSearcher->parallelForEachNearbyPoint(
+            radius, callback);
+    } else {
+        auto points = positions();
+        parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
+            _neighborSearcher->forEachNearbyPoint(
+                points[i], radius, [&](size_t j, const Vector3D& xj) {
+                    callback(i, j, xj);
+                });
+        });
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_PARTICLE_SYSTEM_DATA3_INL_H_
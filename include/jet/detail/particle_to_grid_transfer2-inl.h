@@ -0,0 +1,174 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_PARTICLE_TO_GRID_TRANSFER2_INL_H_
+#define INCLUDE_JET_DETAIL_PARTICLE_TO_GRID_TRANSFER2_INL_H_
+
+#include <jet/array_samplers2.h>
+#include <jet/parallel.h>
+#include <jet/particle_to_grid_transfer2.h>
+
+#include <algorithm>
+#include <array>
+
+namespace jet {
+
+template <typename PositionFunc, typename ValueFunc>
+void ParticleToGridTransfer2::transfer(
+    size_t numberOfParticles,
+    const PositionFunc& positionFunc,
+    const ValueFunc& valueFunc,
+    const Vector2D& gridSpacing,
+    const Vector2D& origin,
+    ArrayAccessor2<double> values,
+    ArrayAccessor2<char> markers) {
+    const Size2 res = values.size();
+    JET_ASSERT(markers.size() == res);
+
+    if (res.x == 0 || res.y == 0) {
+        return;
+    }
+
+    LinearArraySampler2<double, double> sampler(
+        ConstArrayAccessor2<double>(values), gridSpacing, origin);
+
+    // Bucket particles by the lower corner of their stencil
+    _positions.resize(numberOfParticles);
+    _keys.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t p) {
+        std::array<Point2UI, 4> indices;
+        std::array<double, 4> weights;
+
+        _positions[p] = positionFunc(p);
+        sampler.getCoordinatesAndWeights(_positions[p], &indices, &weights);
+        _keys[p] = indices[0].x + res.x * indices[0].y;
+    });
+
+    buildBuckets(res);
+
+    if (_isDeterministic) {
+        gatherInParticleOrder(sampler, valueFunc, values, markers);
+        return;
+    }
+
+    // Particles in a bucket only touch the grid points at the lower corner of
+    // the bucket, so two buckets whose y-indices differ by two or more never
+    // write to the same grid point. Scatter even and odd rows in two passes,
+    // each of which processes its rows in parallel.
+    _weightSums.resize(res);
+    parallelFor(
+        kZeroSize, res.x, kZeroSize, res.y,
+        [&](size_t i, size_t j) {
+            values(i, j) = 0.0;
+            markers(i, j) = 0;
+            _weightSums(i, j) = 0.0;
+        });
+
+    for (size_t parity = 0; parity < 2; ++parity) {
+        const size_t numRows = (res.y + 1 - parity) / 2;
+
+        parallelFor(kZeroSize, numRows, [&](size_t row) {
+            const size_t bj = 2 * row + parity;
+            const size_t begin = _bucketStarts[res.x * bj];
+            const size_t end = _bucketStarts[res.x * (bj + 1)];
+            for (size_t s = begin; s < end; ++s) {
+                std::array<Point2UI, 4> indices;
+                std::array<double, 4> weights;
+
+                const size_t p = _sortedIndices[s];
+                const Vector2D& pt = _positions[p];
+                sampler.getCoordinatesAndWeights(pt, &indices, &weights);
+                for (int c = 0; c < 4; ++c) {
+                    values(indices[c]) +=
+                        weights[c] * valueFunc(p, pt, indices[c]);
+                    _weightSums(indices[c]) += weights[c];
+                    markers(indices[c]) = 1;
+                }
+            }
+        });
+    }
+
+    parallelFor(
+        kZeroSize, res.x, kZeroSize, res.y,
+        [&](size_t i, size_t j) {
+            if (_weightSums(i, j) > 0.0) {
+                values(i, j) /= _weightSums(i, j);
+            }
+        });
+}
+
+template <typename ValueFunc>
+void ParticleToGridTransfer2::gatherInParticleOrder(
+    const LinearArraySampler2<double, double>& sampler,
+    const ValueFunc& valueFunc,
+    ArrayAccessor2<double> values,
+    ArrayAccessor2<char> markers) {
+    const Size2 res = values.size();
+
+    parallelFor(
+        kZeroSize, res.x, kZeroSize, res.y,
+        [&](size_t i, size_t j) {
+            const Point2UI gridIndex(i, j);
+            double sum = 0.0;
+            double weightSum = 0.0;
+            bool isTouched = false;
+
+            // Collect the buckets whose stencils can cover this grid point
+            std::array<size_t, 4> begins;
+            std::array<size_t, 4> ends;
+            size_t numRanges = 0;
+            for (size_t bj = (j > 0) ? j - 1 : 0; bj <= j; ++bj) {
+                for (size_t bi = (i > 0) ? i - 1 : 0; bi <= i; ++bi) {
+                    size_t key = bi + res.x * bj;
+                    if (_bucketStarts[key] < _bucketStarts[key + 1]) {
+                        begins[numRanges] = _bucketStarts[key];
+                        ends[numRanges] = _bucketStarts[key + 1];
+                        ++numRanges;
+                    }
+                }
+            }
+
+            // Merge the buckets so that particles are visited in the same
+            // order as the serial scatter.
+            while (true) {
+                size_t best = numRanges;
+                for (size_t r = 0; r < numRanges; ++r) {
+                    if (begins[r] < ends[r]
+                        && (best == numRanges
+                            || _sortedIndices[begins[r]]
+                                < _sortedIndices[begins[best]])) {
+                        best = r;
+                    }
+                }
+                if (best == numRanges) {
+                    break;
+                }
+
+                std::array<Point2UI, 4> indices;
+                std::array<double, 4> weights;
+
+                const size_t p = _sortedIndices[begins[best]];
+                const Vector2D& pt = _positions[p];
+                sampler.getCoordinatesAndWeights(pt, &indices, &weights);
+                for (int c = 0; c < 4; ++c) {
+                    if (indices[c] == gridIndex) {
+                        sum += weights[c] * valueFunc(p, pt, gridIndex);
+                        weightSum += weights[c];
+                        isTouched = true;
+                    }
+                }
+
+                ++begins[best];
+            }
+
+            values(i, j) = (weightSum > 0.0) ? sum / weightSum : sum;
+            markers(i, j) = isTouched ? 1 : 0;
+        });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_PARTICLE_TO_GRID_TRANSFER2_INL_H_
@@ -0,0 +1,176 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_PARTICLE_TO_GRID_TRANSFER3_INL_H_
+#define INCLUDE_JET_DETAIL_PARTICLE_TO_GRID_TRANSFER3_INL_H_
+
+#include <jet/array_samplers3.h>
+#include <jet/parallel.h>
+#include <jet/particle_to_grid_transfer3.h>
+
+#include <algorithm>
+#include <array>
+
+namespace jet {
+
+template <typename PositionFunc, typename ValueFunc>
+void ParticleToGridTransfer3::transfer(
+    size_t numberOfParticles,
+    const PositionFunc& positionFunc,
+    const ValueFunc& valueFunc,
+    const Vector3D& gridSpacing,
+    const Vector3D& origin,
+    ArrayAccessor3<double> values,
+    ArrayAccessor3<char> markers) {
+    const Size3 res = values.size();
+    JET_ASSERT(markers.size() == res);
+
+    if (res.x == 0 || res.y == 0 || res.z == 0) {
+        return;
+    }
+
+    LinearArraySampler3<double, double> sampler(
+        ConstArrayAccessor3<double>(values), gridSpacing, origin);
+
+    // Bucket particles by the lower corner of their stencil
+    _positions.resize(numberOfParticles);
+    _keys.resize(numberOfParticles);
+    parallelFor(kZeroSize, numberOfParticles, [&](size_t p) {
+        std::array<Point3UI, 8> indices;
+        std::array<double, 8> weights;
+
+        _positions[p] = positionFunc(p);
+        sampler.getCoordinatesAndWeights(_positions[p], &indices, &weights);
+        _keys[p] = indices[0].x + res.x * (indices[0].y + res.y * indices[0].z);
+    });
+
+    buildBuckets(res);
+
+    if (_isDeterministic) {
+        gatherInParticleOrder(sampler, valueFunc, values, markers);
+        return;
+    }
+
+    // Particles in a bucket only touch the grid points at the lower corner of
+    // the bucket, so two buckets whose z-indices differ by two or more never
+    // write to the same grid point. Scatter even and odd z-slices in two
+    // passes, each of which processes its slices in parallel.
+    _weightSums.resize(res);
+    parallelFor(
+        kZeroSize, res.x, kZeroSize, res.y, kZeroSize, res.z,
+        [&](size_t i, size_t j, size_t k) {
+            values(i, j, k) = 0.0;
+            markers(i, j, k) = 0;
+            _weightSums(i, j, k) = 0.0;
+        });
+
+    for (size_t parity = 0; parity < 2; ++parity) {
+        const size_t numSlices = (res.z + 1 - parity) / 2;
+
+        parallelFor(kZeroSize, numSlices, [&](size_t slice) {
+            const size_t bk = 2 * slice + parity;
+            const size_t begin = _bucketStarts[res.x * res.y * bk];
+            const size_t end = _bucketStarts[res.x * res.y * (bk + 1)];
+            for (size_t s = begin; s < end; ++s) {
+                std::array<Point3UI, 8> indices;
+                std::array<double, 8> weights;
+
+                const size_t p = _sortedIndices[s];
+                const Vector3D& pt = _positions[p];
+                sampler.getCoordinatesAndWeights(pt, &indices, &weights);
+                for (int c = 0; c < 8; ++c) {
+                    values(indices[c]) +=
+                        weights[c] * valueFunc(p, pt, indices[c]);
+                    _weightSums(indices[c]) += weights[c];
+                    markers(indices[c]) = 1;
+                }
+            }
+        });
+    }
+
+    parallelFor(
+        kZeroSize, res.x, kZeroSize, res.y, kZeroSize, res.z,
+        [&](size_t i, size_t j, size_t k) {
+            if (_weightSums(i, j, k) > 0.0) {
+                values(i, j, k) /= _weightSums(i, j, k);
+            }
+        });
+}
+
+template <typename ValueFunc>
+void ParticleToGridTransfer3::gatherInParticleOrder(
+    const LinearArraySampler3<double, double>& sampler,
+    const ValueFunc& valueFunc,
+    ArrayAccessor3<double> values,
+    ArrayAccessor3<char> markers) {
+    const Size3 res = values.size();
+
+    parallelFor(
+        kZeroSize, res.x, kZeroSize, res.y, kZeroSize, res.z,
+        [&](size_t i, size_t j, size_t k) {
+            const Point3UI gridIndex(i, j, k);
+            double sum = 0.0;
+            double weightSum = 0.0;
+            bool isTouched = false;
+
+            // Collect the buckets whose stencils can cover this grid point
+            std::array<size_t, 8> begins;
+            std::array<size_t, 8> ends;
+            size_t numRanges = 0;
+            for (size_t bk = (k > 0) ? k - 1 : 0; bk <= k; ++bk) {
+                for (size_t bj = (j > 0) ? j - 1 : 0; bj <= j; ++bj) {
+                    for (size_t bi = (i > 0) ? i - 1 : 0; bi <= i; ++bi) {
+                        size_t key = bi + res.x * (bj + res.y * bk);
+                        if (_bucketStarts[key] < _bucketStarts[key + 1]) {
+                            begins[numRanges] = _bucketStarts[key];
+                            ends[numRanges] = _bucketStarts[key + 1];
+                            ++numRanges;
+                        }
+                    }
+                }
+            }
+
+            // Merge the buckets so that particles are visited in the same
+            // order as the serial scatter.
+            while (true) {
+                size_t best = numRanges;
+                for (size_t r = 0; r < numRanges; ++r) {
+                    if (begins[r] < ends[r]
+                        && (best == numRanges
+                            || _sortedIndices[begins[r]]
+                                < _sortedIndices[begins[best]])) {
+                        best = r;
+                    }
+                }
+                if (best == numRanges) {
+                    break;
+                }
+
+                std::array<Point3UI, 8> indices;
+                std::array<double, 8> weights;
+
+                const size_t p = _sortedIndices[begins[best]];
+                const Vector3D& pt = _positions[p];
+                sampler.getCoordinatesAndWeights(pt, &indices, &weights);
+                for (int c = 0; c < 8; ++c) {
+                    if (indices[c] == gridIndex) {
+                        sum += weights[c] * valueFunc(p, pt, gridIndex);
+                        weightSum += weights[c];
+                        isTouched = true;
+                    }
+                }
+
+                ++begins[best];
+            }
+
+            values(i, j, k) = (weightSum > 0.0) ? sum / weightSum : sum;
+            markers(i, j, k) = isTouched ? 1 : 0;
+        });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_PARTICLE_TO_GRID_TRANSFER3_INL_H_
@@ -0,0 +1,58 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_HASH_GRID_SEARCHER2_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_HASH_GRID_SEARCHER2_INL_H_
+
+#include <jet/parallel.h>
+#include <jet/point_hash_grid_searcher2.h>
+
+namespace jet {
+
+template <typename Callback>
+void PointHashGridSearcher2::forEachNearbyPoint(
+    const Vector2D& origin,
+    double radius,
+    const Callback& callback) const {
+    if (_buckets.empty()) {
+        return;
+    }
+
+    size_t nearbyKeys[4];
+    getNearbyKeys(origin, nearbyKeys);
+
+    const double queryRadiusSquared = radius * radius;
+
+    for (int i = 0; i < 4; i++) {
+        const auto& bucket = _buckets[nearbyKeys[i]];
+        size_t numberOfPointsInBucket = bucket.size();
+
+        for (size_t j = 0; j < numberOfPointsInBucket; ++j) {
+            size_t pointIndex = bucket[j];
+            double rSquared = (_points[pointIndex] - origin).lengthSquared();
+            if (rSquared <= queryRadiusSquared) {
+                callback(pointIndex, _points[pointIndex]);
+            }
+        }
+    }
+}
+
+template <typename Callback>
+void PointHashGridSearcher2::parallelForEachNearbyPoint(
+    double radius, const Callback& callback) const {
+    parallelFor(kZeroSize, _buckets.size(), [&](size_t key) {
+        for (size_t i : _buckets[key]) {
+            forEachNearbyPoint(
+                _points[i], radius, [&](size_t j, const Vector2D& xj) {
+                    callback(i, j, xj);
+                });
+        }
+    });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_POINT_HASH_GRID_SEARCHER2_INL_H_
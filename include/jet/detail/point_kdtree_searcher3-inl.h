@@ -0,0 +1,24 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_KDTREE_SEARCHER3_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_KDTREE_SEARCHER3_INL_H_
+
+#include <jet/point_kdtree_searcher3.h>
+
+namespace jet {
+
+template <typename Callback>
+void PointKdTreeSearcher3::forEachNearbyPoint(
+    const Vector3D& origin,
+    double radius,
+    const Callback& callback) const {
+    _tree.forEachNearbyPoint(origin, radius, callback);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_POINT_KDTREE_SEARCHER3_INL_H_
@@ -0,0 +1,59 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_POINT_PARALLEL_HASH_GRID_SEARCHER2_INL_H_
+#define INCLUDE_JET_DETAIL_POINT_PARALLEL_HASH_GRID_SEARCHER2_INL_H_
+
+#include <jet/parallel.h>
+#include <jet/point_parallel_hash_grid_searcher2.h>
+
+namespace jet {
+
+template <typename Callback>
+void PointParallelHashGridSearcher2::forEachNearbyPoint(
+    const Vector2D& origin,
+    double radius,
+    const Callback& callback) const {
+    size_t nearbyKeys[4];
+    getNearbyKeys(origin, nearbyKeys);
+
+    const double queryRadiusSquared = radius * radius;
+
+    for (int i = 0; i < 4; i++) {
+        size_t nearbyKey = nearbyKeys[i];
+        size_t start = _startIndexTable[nearbyKey];
+        size_t end = _endIndexTable[nearbyKey];
+
+        // Empty bucket -- continue to next bucket
+        if (start == kMaxSize) {
+            continue;
+        }
+
+        for (size_t j = start; j < end; ++j) {
+            Vector2D direction = _points[j] - origin;
+            double distanceSquared = direction.lengthSquared();
+            if (distanceSquared <= queryRadiusSquared) {
+                callback(_sortedIndices[j], _points[j]);
+            }
+        }
+    }
+}
+
+template <typename Callback>
+void PointParallelHashGridSearcher2::parallelForEachNearbyPoint(
+    double radius, const Callback& callback) const {
+    parallelFor(kZeroSize, _points.size(), [&](size_t s) {
+        const size_t i = _sortedIndices[s];
+        forEachNearbyPoint(
+            _points[s], radius, [&](size_t j, const Vector2D& xj) {
+                callback(i, j, xj);
+            });
+    });
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_POINT_PARALLEL_HASH_GRID_SEARCHER2_INL_H_
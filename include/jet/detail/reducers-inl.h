@@ -0,0 +1,146 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_REDUCERS_INL_H_
+#define INCLUDE_JET_DETAIL_REDUCERS_INL_H_
+
+#include <jet/constants.h>
+#include <jet/macros.h>
+#include <jet/math_utils.h>
+
+#include <algorithm>
+
+namespace jet {
+
+template <typename T>
+MaxReducer<T>::MaxReducer(const T& lowest) : _identity(lowest) {}
+
+template <typename T>
+typename MaxReducer<T>::ValueType MaxReducer<T>::identity() const {
+    return _identity;
+}
+
+template <typename T>
+void MaxReducer<T>::accumulate(ValueType* result, const T& value,
+                               size_t) const {
+    *result = std::max(*result, value);
+}
+
+template <typename T>
+typename MaxReducer<T>::ValueType MaxReducer<T>::operator()(
+    const ValueType& a, const ValueType& b) const {
+    return std::max(a, b);
+}
+
+template <typename T>
+MinReducer<T>::MinReducer(const T& highest) : _identity(highest) {}
+
+template <typename T>
+typename MinReducer<T>::ValueType MinReducer<T>::identity() const {
+    return _identity;
+}
+
+template <typename T>
+void MinReducer<T>::accumulate(ValueType* result, const T& value,
+                               size_t) const {
+    *result = std::min(*result, value);
+}
+
+template <typename T>
+typename MinReducer<T>::ValueType MinReducer<T>::operator()(
+    const ValueType& a, const ValueType& b) const {
+    return std::min(a, b);
+}
+
+template <typename T>
+typename AbsMaxReducer<T>::ValueType AbsMaxReducer<T>::identity() const {
+    return static_cast<T>(0);
+}
+
+template <typename T>
+void AbsMaxReducer<T>::accumulate(ValueType* result, const T& value,
+                                  size_t) const {
+    *result = absmax(*result, value);
+}
+
+template <typename T>
+typename AbsMaxReducer<T>::ValueType AbsMaxReducer<T>::operator()(
+    const ValueType& a, const ValueType& b) const {
+    return absmax(a, b);
+}
+
+template <typename T>
+void KahanSum<T>::add(const T& value) {
+    const T y = value - compensation;
+    const T t = sum + y;
+    compensation = (t - sum) - y;
+    sum = t;
+}
+
+template <typename T>
+typename KahanSumReducer<T>::ValueType KahanSumReducer<T>::identity() const {
+    return ValueType();
+}
+
+template <typename T>
+void KahanSumReducer<T>::accumulate(ValueType* result, const T& value,
+                                    size_t) const {
+    result->add(value);
+}
+
+template <typename T>
+typename KahanSumReducer<T>::ValueType KahanSumReducer<T>::operator()(
+    const ValueType& a, const ValueType& b) const {
+    ValueType result = a;
+    result.add(b.sum);
+    result.add(-b.compensation);
+    return result;
+}
+
+template <typename T>
+typename ArgMaxReducer<T>::ValueType ArgMaxReducer<T>::identity() const {
+    return ValueType(std::numeric_limits<T>::lowest(), kMaxSize);
+}
+
+template <typename T>
+void ArgMaxReducer<T>::accumulate(ValueType* result, const T& value,
+                                  size_t index) const {
+    if (result->second == kMaxSize || value > result->first) {
+        *result = ValueType(value, index);
+    }
+}
+
+template <typename T>
+typename ArgMaxReducer<T>::ValueType ArgMaxReducer<T>::operator()(
+    const ValueType& a, const ValueType& b) const {
+    if (a.second == kMaxSize || b.first > a.first) {
+        return b;
+    }
+    return a;
+}
+
+template <typename IndexType, typename Function, typename Reducer>
+typename Reducer::ValueType parallelMapReduce(IndexType beginIndex,
+                                              IndexType endIndex,
+                                              const Function& func,
+                                              const Reducer& reducer,
+                                              ExecutionPolicy policy) {
+    typedef typename Reducer::ValueType ValueType;
+
+    return parallelDeterministicReduce(
+        beginIndex, endIndex, reducer.identity(),
+        [&](IndexType begin, IndexType end, ValueType result) {
+            for (IndexType i = begin; i < end; ++i) {
+                reducer.accumulate(&result, func(i), static_cast<size_t>(i));
+            }
+            return result;
+        },
+        reducer, policy);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_REDUCERS_INL_H_
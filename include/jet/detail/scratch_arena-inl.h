@@ -0,0 +1,124 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_SCRATCH_ARENA_INL_H_
+#define INCLUDE_JET_DETAIL_SCRATCH_ARENA_INL_H_
+
+#include <jet/macros.h>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace jet {
+
+template <typename T>
+ScratchBuffer<T>::ScratchBuffer() {}
+
+template <typename T>
+ScratchBuffer<T>::ScratchBuffer(ScratchArena* arena, void* block,
+                                size_t sizeClass, size_t size)
+    : _arena(arena),
+      _data(static_cast<T*>(block)),
+      _size(size),
+      _sizeClass(sizeClass) {
+    for (size_t i = 0; i < _size; ++i) {
+        new (_data + i) T;
+    }
+}
+
+template <typename T>
+ScratchBuffer<T>::ScratchBuffer(ScratchBuffer&& other)
+    : _arena(other._arena),
+      _data(other._data),
+      _size(other._size),
+      _sizeClass(other._sizeClass) {
+    other._arena = nullptr;
+    other._data = nullptr;
+    other._size = 0;
+}
+
+template <typename T>
+ScratchBuffer<T>::~ScratchBuffer() {
+    release();
+}
+
+template <typename T>
+ScratchBuffer<T>& ScratchBuffer<T>::operator=(ScratchBuffer&& other) {
+    if (this != &other) {
+        release();
+        std::swap(_arena, other._arena);
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_sizeClass, other._sizeClass);
+    }
+    return *this;
+}
+
+template <typename T>
+size_t ScratchBuffer<T>::size() const {
+    return _size;
+}
+
+template <typename T>
+T* ScratchBuffer<T>::data() {
+    return _data;
+}
+
+template <typename T>
+const T* ScratchBuffer<T>::data() const {
+    return _data;
+}
+
+template <typename T>
+ArrayAccessor1<T> ScratchBuffer<T>::accessor() {
+    return ArrayAccessor1<T>(_size, _data);
+}
+
+template <typename T>
+ConstArrayAccessor1<T> ScratchBuffer<T>::constAccessor() const {
+    return ConstArrayAccessor1<T>(_size, _data);
+}
+
+template <typename T>
+T& ScratchBuffer<T>::operator[](size_t i) {
+    JET_ASSERT(i < _size);
+    return _data[i];
+}
+
+template <typename T>
+const T& ScratchBuffer<T>::operator[](size_t i) const {
+    JET_ASSERT(i < _size);
+    return _data[i];
+}
+
+template <typename T>
+void ScratchBuffer<T>::release() {
+    if (_arena != nullptr) {
+        _arena->release(_data, _sizeClass);
+        _arena = nullptr;
+        _data = nullptr;
+        _size = 0;
+    }
+}
+
+template <typename T>
+ScratchBuffer<T> ScratchArena::allocate(size_t size) {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "The elements are never destructed.");
+
+    if (size == 0) {
+        return ScratchBuffer<T>();
+    }
+
+    size_t sizeClass = 0;
+    void* block = acquire(size * sizeof(T), &sizeClass);
+    return ScratchBuffer<T>(this, block, sizeClass, size);
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_SCRATCH_ARENA_INL_H_
@@ -0,0 +1,225 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_SIMD_INL_H_
+#define INCLUDE_JET_DETAIL_SIMD_INL_H_
+
+#include <jet/simd.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace jet {
+
+#if defined(JET_SIMD_AVX2)
+
+inline SimdDouble::SimdDouble() : _v(_mm256_setzero_pd()) {}
+
+inline SimdDouble::SimdDouble(double s) : _v(_mm256_set1_pd(s)) {}
+
+inline SimdDouble::SimdDouble(NativeType v) : _v(v) {}
+
+inline SimdDouble SimdDouble::load(const double* ptr) {
+    return _mm256_loadu_pd(ptr);
+}
+
+inline SimdDouble SimdDouble::gather(
+    const double* base, const uint32_t* indices) {
+    const __m128i idx =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices));
+    // The masked form with a zero source avoids reading an undefined
+    // register, which some compilers warn about.
+    const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, idx, all, 8);
+}
+
+inline SimdDouble SimdDouble::laneMask(size_t n) {
+    const __m256d lanes = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+    const __m256d mask = _mm256_cmp_pd(
+        lanes, _mm256_set1_pd(static_cast<double>(n)), _CMP_LT_OQ);
+    return _mm256_and_pd(mask, _mm256_set1_pd(1.0));
+}
+
+inline SimdDouble SimdDouble::min(const SimdDouble& a, const SimdDouble& b) {
+    return _mm256_min_pd(a._v, b._v);
+}
+
+inline SimdDouble SimdDouble::max(const SimdDouble& a, const SimdDouble& b) {
+    return _mm256_max_pd(a._v, b._v);
+}
+
+inline SimdDouble SimdDouble::sqrt(const SimdDouble& a) {
+    return _mm256_sqrt_pd(a._v);
+}
+
+inline SimdDouble SimdDouble::reciprocalIfPositive(const SimdDouble& a) {
+    const __m256d mask =
+        _mm256_cmp_pd(a._v, _mm256_setzero_pd(), _CMP_GT_OQ);
+    return _mm256_and_pd(mask, _mm256_div_pd(_mm256_set1_pd(1.0), a._v));
+}
+
+inline void SimdDouble::store(double* ptr) const { _mm256_storeu_pd(ptr, _v); }
+
+inline double SimdDouble::sum() const {
+    const __m128d lo = _mm256_castpd256_pd128(_v);
+    const __m128d hi = _mm256_extractf128_pd(_v, 1);
+    const __m128d s = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+inline SimdDouble operator+(const SimdDouble& a, const SimdDouble& b) {
+    return _mm256_add_pd(a.native(), b.native());
+}
+
+inline SimdDouble operator-(const SimdDouble& a, const SimdDouble& b) {
+    return _mm256_sub_pd(a.native(), b.native());
+}
+
+inline SimdDouble operator*(const SimdDouble& a, const SimdDouble& b) {
+    return _mm256_mul_pd(a.native(), b.native());
+}
+
+inline SimdDouble operator/(const SimdDouble& a, const SimdDouble& b) {
+    return _mm256_div_pd(a.native(), b.native());
+}
+
+#elif defined(JET_SIMD_SSE2)
+
+inline SimdDouble::SimdDouble() : _v(_mm_setzero_pd()) {}
+
+inline SimdDouble::SimdDouble(double s) : _v(_mm_set1_pd(s)) {}
+
+inline SimdDouble::SimdDouble(NativeType v) : _v(v) {}
+
+inline SimdDouble SimdDouble::load(const double* ptr) {
+    return _mm_loadu_pd(ptr);
+}
+
+inline SimdDouble SimdDouble::gather(
+    const double* base, const uint32_t* indices) {
+    return _mm_set_pd(base[indices[1]], base[indices[0]]);
+}
+
+inline SimdDouble SimdDouble::laneMask(size_t n) {
+    return _mm_set_pd(n > 1 ? 1.0 : 0.0, n > 0 ? 1.0 : 0.0);
+}
+
+inline SimdDouble SimdDouble::min(const SimdDouble& a, const SimdDouble& b) {
+    return _mm_min_pd(a._v, b._v);
+}
+
+inline SimdDouble SimdDouble::max(const SimdDouble& a, const SimdDouble& b) {
+    return _mm_max_pd(a._v, b._v);
+}
+
+inline SimdDouble SimdDouble::sqrt(const SimdDouble& a) {
+    return _mm_sqrt_pd(a._v);
+}
+
+inline SimdDouble SimdDouble::reciprocalIfPositive(const SimdDouble& a) {
+    const __m128d mask = _mm_cmpgt_pd(a._v, _mm_setzero_pd());
+    return _mm_and_pd(mask, _mm_div_pd(_mm_set1_pd(1.0), a._v));
+}
+
+inline void SimdDouble::store(double* ptr) const { _mm_storeu_pd(ptr, _v); }
+
+inline double SimdDouble::sum() const {
+    return _mm_cvtsd_f64(_mm_add_sd(_v, _mm_unpackhi_pd(_v, _v)));
+}
+
+inline SimdDouble operator+(const SimdDouble& a, const SimdDouble& b) {
+    return _mm_add_pd(a.native(), b.native());
+}
+
+inline SimdDouble operator-(const SimdDouble& a, const SimdDouble& b) {
+    return _mm_sub_pd(a.native(), b.native());
+}
+
+inline SimdDouble operator*(const SimdDouble& a, const SimdDouble& b) {
+    return _mm_mul_pd(a.native(), b.native());
+}
+
+inline SimdDouble operator/(const SimdDouble& a, const SimdDouble& b) {
+    return _mm_div_pd(a.native(), b.native());
+}
+
+#else
+
+inline SimdDouble::SimdDouble() : _v(0.0) {}
+
+inline SimdDouble::SimdDouble(double s) : _v(s) {}
+
+inline SimdDouble SimdDouble::load(const double* ptr) {
+    return SimdDouble(*ptr);
+}
+
+inline SimdDouble SimdDouble::gather(
+    const double* base, const uint32_t* indices) {
+    return SimdDouble(base[indices[0]]);
+}
+
+inline SimdDouble SimdDouble::laneMask(size_t n) {
+    return SimdDouble(n > 0 ? 1.0 : 0.0);
+}
+
+inline SimdDouble SimdDouble::min(const SimdDouble& a, const SimdDouble& b) {
+    return SimdDouble(std::min(a._v, b._v));
+}
+
+inline SimdDouble SimdDouble::max(const SimdDouble& a, const SimdDouble& b) {
+    return SimdDouble(std::max(a._v, b._v));
+}
+
+inline SimdDouble SimdDouble::sqrt(const SimdDouble& a) {
+    return SimdDouble(std::sqrt(a._v));
+}
+
+inline SimdDouble SimdDouble::reciprocalIfPositive(const SimdDouble& a) {
+    return SimdDouble(a._v > 0.0 ? 1.0 / a._v : 0.0);
+}
+
+inline void SimdDouble::store(double* ptr) const { *ptr = _v; }
+
+inline double SimdDouble::sum() const { return _v; }
+
+inline SimdDouble operator+(const SimdDouble& a, const SimdDouble& b) {
+    return SimdDouble(a.native() + b.native());
+}
+
+inline SimdDouble operator-(const SimdDouble& a, const SimdDouble& b) {
+    return SimdDouble(a.native() - b.native());
+}
+
+inline SimdDouble operator*(const SimdDouble& a, const SimdDouble& b) {
+    return SimdDouble(a.native() * b.native());
+}
+
+inline SimdDouble operator/(const SimdDouble& a, const SimdDouble& b) {
+    return SimdDouble(a.native() / b.native());
+}
+
+#endif
+
+inline SimdDouble::NativeType SimdDouble::native() const { return _v; }
+
+inline SimdDouble& SimdDouble::operator+=(const SimdDouble& other) {
+    *this = *this + other;
+    return *this;
+}
+
+inline SimdDouble& SimdDouble::operator-=(const SimdDouble& other) {
+    *this = *this - other;
+    return *this;
+}
+
+inline SimdDouble& SimdDouble::operator*=(const SimdDouble& other) {
+    *this = *this * other;
+    return *this;
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_SIMD_INL_H_
@@ -73,6 +73,28 @@ inline double SphStdKernel2::secondDerivative(double distance) const {
 }
 
 
+inline SimdDouble SphStdKernel2::operator()(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance * distance / SimdDouble(h2), SimdDouble());
+    return SimdDouble(4.0 / (kPiD * h2)) * x * x * x;
+}
+
+inline SimdDouble SphStdKernel2::firstDerivative(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance * distance / SimdDouble(h2), SimdDouble());
+    return SimdDouble(-24.0 / (kPiD * h4)) * distance * x * x;
+}
+
+inline SimdDouble SphStdKernel2::secondDerivative(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::min(
+        distance * distance / SimdDouble(h2), SimdDouble(1.0));
+    return SimdDouble(24.0 / (kPiD * h4)) * (SimdDouble(1.0) - x)
+        * (SimdDouble(5.0) * x - SimdDouble(1.0));
+}
+
 inline SphSpikyKernel2::SphSpikyKernel2()
     : h(0), h2(0), h3(0), h4(0), h5(0) {}
 
@@ -125,6 +147,27 @@ inline double SphSpikyKernel2::secondDerivative(double distance) const {
     }
 }
 
+inline SimdDouble SphSpikyKernel2::operator()(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance / SimdDouble(h), SimdDouble());
+    return SimdDouble(10.0 / (kPiD * h2)) * x * x * x;
+}
+
+inline SimdDouble SphSpikyKernel2::firstDerivative(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance / SimdDouble(h), SimdDouble());
+    return SimdDouble(-30.0 / (kPiD * h3)) * x * x;
+}
+
+inline SimdDouble SphSpikyKernel2::secondDerivative(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance / SimdDouble(h), SimdDouble());
+    return SimdDouble(60.0 / (kPiD * h4)) * x;
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_SPH_KERNELS2_INL_H_
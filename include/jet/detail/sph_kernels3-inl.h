@@ -68,6 +68,28 @@ inline double SphStdKernel3::secondDerivative(double distance) const {
     }
 }
 
+inline SimdDouble SphStdKernel3::operator()(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance * distance / SimdDouble(h2), SimdDouble());
+    return SimdDouble(315.0 / (64.0 * kPiD * h3)) * x * x * x;
+}
+
+inline SimdDouble SphStdKernel3::firstDerivative(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance * distance / SimdDouble(h2), SimdDouble());
+    return SimdDouble(-945.0 / (32.0 * kPiD * h5)) * distance * x * x;
+}
+
+inline SimdDouble SphStdKernel3::secondDerivative(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::min(
+        distance * distance / SimdDouble(h2), SimdDouble(1.0));
+    return SimdDouble(945.0 / (32.0 * kPiD * h5)) * (SimdDouble(1.0) - x)
+        * (SimdDouble(3.0) * x - SimdDouble(1.0));
+}
+
 inline SphSpikyKernel3::SphSpikyKernel3()
     : h(0), h2(0), h3(0), h4(0), h5(0) {}
 
@@ -120,6 +142,27 @@ inline double SphSpikyKernel3::secondDerivative(double distance) const {
     }
 }
 
+inline SimdDouble SphSpikyKernel3::operator()(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance / SimdDouble(h), SimdDouble());
+    return SimdDouble(15.0 / (kPiD * h3)) * x * x * x;
+}
+
+inline SimdDouble SphSpikyKernel3::firstDerivative(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance / SimdDouble(h), SimdDouble());
+    return SimdDouble(-45.0 / (kPiD * h4)) * x * x;
+}
+
+inline SimdDouble SphSpikyKernel3::secondDerivative(
+    const SimdDouble& distance) const {
+    const SimdDouble x = SimdDouble::max(
+        SimdDouble(1.0) - distance / SimdDouble(h), SimdDouble());
+    return SimdDouble(90.0 / (kPiD * h5)) * x;
+}
+
 }  // namespace jet
 
 #endif  // INCLUDE_JET_DETAIL_SPH_KERNELS3_INL_H_
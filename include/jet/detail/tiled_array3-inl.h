@@ -0,0 +1,352 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_DETAIL_TILED_ARRAY3_INL_H_
+#define INCLUDE_JET_DETAIL_TILED_ARRAY3_INL_H_
+
+#include <jet/constants.h>
+#include <jet/macros.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>  // just make cpplint happy..
+#include <vector>
+
+namespace jet {
+
+template <typename T>
+const size_t TiledArray3<T>::kTileSize;
+
+template <typename T>
+const size_t TiledArray3<T>::kTileVolume;
+
+template <typename T>
+const size_t TiledArray3<T>::kInactiveTile;
+
+template <typename T>
+TiledArray3<T>::TiledArray3() {}
+
+template <typename T>
+TiledArray3<T>::TiledArray3(const Size3& size, const T& background) {
+    resize(size, background);
+}
+
+template <typename T>
+void TiledArray3<T>::resize(const Size3& size, const T& background) {
+    _size = size;
+    _tileResolution = Size3((size.x + kTileSize - 1) / kTileSize,
+                            (size.y + kTileSize - 1) / kTileSize,
+                            (size.z + kTileSize - 1) / kTileSize);
+    _background = background;
+
+    _tileTable.assign(
+        _tileResolution.x * _tileResolution.y * _tileResolution.z,
+        kInactiveTile);
+    _activeTiles.clear();
+    _values.clear();
+}
+
+template <typename T>
+void TiledArray3<T>::clear() {
+    std::fill(_tileTable.begin(), _tileTable.end(), kInactiveTile);
+    _activeTiles.clear();
+    _values.clear();
+}
+
+template <typename T>
+const Size3& TiledArray3<T>::size() const {
+    return _size;
+}
+
+template <typename T>
+const Size3& TiledArray3<T>::tileResolution() const {
+    return _tileResolution;
+}
+
+template <typename T>
+const T& TiledArray3<T>::background() const {
+    return _background;
+}
+
+template <typename T>
+void TiledArray3<T>::setBackground(const T& background) {
+    _background = background;
+    clear();
+}
+
+template <typename T>
+size_t TiledArray3<T>::numberOfActiveTiles() const {
+    return _activeTiles.size();
+}
+
+template <typename T>
+size_t TiledArray3<T>::memoryUsage() const {
+    return _tileTable.capacity() * sizeof(size_t) +
+           _activeTiles.capacity() * sizeof(size_t) +
+           _values.capacity() * sizeof(T);
+}
+
+template <typename T>
+bool TiledArray3<T>::isTileActive(size_t ti, size_t tj, size_t tk) const {
+    return _tileTable[tileIndex(ti, tj, tk)] != kInactiveTile;
+}
+
+template <typename T>
+bool TiledArray3<T>::isActive(size_t i, size_t j, size_t k) const {
+    return slot(i, j, k) != kInactiveTile;
+}
+
+template <typename T>
+const T& TiledArray3<T>::operator()(size_t i, size_t j, size_t k) const {
+    const size_t s = slot(i, j, k);
+    if (s == kInactiveTile) {
+        return _background;
+    }
+    return _values[s * kTileVolume + offset(i, j, k)];
+}
+
+template <typename T>
+T* TiledArray3<T>::find(size_t i, size_t j, size_t k) {
+    const size_t s = slot(i, j, k);
+    if (s == kInactiveTile) {
+        return nullptr;
+    }
+    return &_values[s * kTileVolume + offset(i, j, k)];
+}
+
+template <typename T>
+void TiledArray3<T>::set(size_t i, size_t j, size_t k, const T& value) {
+    T* v = find(i, j, k);
+    if (v != nullptr) {
+        *v = value;
+    } else if (value != _background) {
+        T* tile = activateTile(i / kTileSize, j / kTileSize, k / kTileSize);
+        tile[offset(i, j, k)] = value;
+    }
+}
+
+template <typename T>
+T* TiledArray3<T>::activateTile(size_t ti, size_t tj, size_t tk) {
+    const size_t idx = tileIndex(ti, tj, tk);
+    size_t s = _tileTable[idx];
+    if (s == kInactiveTile) {
+        s = _activeTiles.size();
+        _tileTable[idx] = s;
+        _activeTiles.push_back(idx);
+        _values.resize(_values.size() + kTileVolume, _background);
+    }
+    return &_values[s * kTileVolume];
+}
+
+template <typename T>
+void TiledArray3<T>::deactivateTile(size_t ti, size_t tj, size_t tk) {
+    const size_t idx = tileIndex(ti, tj, tk);
+    const size_t s = _tileTable[idx];
+    if (s == kInactiveTile) {
+        return;
+    }
+
+    // Moves the last tile into the freed slot.
+    const size_t last = _activeTiles.size() - 1;
+    if (s != last) {
+        std::copy(_values.begin() + last * kTileVolume,
+                  _values.begin() + (last + 1) * kTileVolume,
+                  _values.begin() + s * kTileVolume);
+        _activeTiles[s] = _activeTiles[last];
+        _tileTable[_activeTiles[s]] = s;
+    }
+
+    _tileTable[idx] = kInactiveTile;
+    _activeTiles.pop_back();
+    _values.resize(last * kTileVolume);
+}
+
+template <typename T>
+void TiledArray3<T>::prune(const T& tolerance) {
+    const size_t numberOfTiles = _activeTiles.size();
+    std::vector<char> isUniform(numberOfTiles);
+
+    parallelFor(kZeroSize, numberOfTiles, [&](size_t s) {
+        const T* tile = &_values[s * kTileVolume];
+        isUniform[s] = std::all_of(tile, tile + kTileVolume, [&](T v) {
+            return std::fabs(v - _background) <= tolerance;
+        });
+    });
+
+    size_t newNumberOfTiles = 0;
+    for (size_t s = 0; s < numberOfTiles; ++s) {
+        const size_t idx = _activeTiles[s];
+        if (isUniform[s]) {
+            _tileTable[idx] = kInactiveTile;
+            continue;
+        }
+
+        if (newNumberOfTiles != s) {
+            std::copy(_values.begin() + s * kTileVolume,
+                      _values.begin() + (s + 1) * kTileVolume,
+                      _values.begin() + newNumberOfTiles * kTileVolume);
+            _activeTiles[newNumberOfTiles] = idx;
+            _tileTable[idx] = newNumberOfTiles;
+        }
+        ++newNumberOfTiles;
+    }
+
+    _activeTiles.resize(newNumberOfTiles);
+    _values.resize(newNumberOfTiles * kTileVolume);
+}
+
+template <typename T>
+void TiledArray3<T>::copyFrom(const ConstArrayAccessor3<T>& other,
+                              const T& tolerance) {
+    JET_ASSERT(other.size() == _size);
+
+    clear();
+
+    // Finds the tiles to activate in parallel, and activates them serially
+    // in the order of the tile index.
+    const size_t numberOfTiles = _tileTable.size();
+    std::vector<char> isOccupied(numberOfTiles);
+    parallelFor(kZeroSize, numberOfTiles, [&](size_t idx) {
+        bool occupied = false;
+        forEachIndexInTile(idx, [&](size_t i, size_t j, size_t k) {
+            occupied |= std::fabs(other(i, j, k) - _background) > tolerance;
+        });
+        isOccupied[idx] = occupied;
+    });
+
+    const size_t numberOfActiveTiles = static_cast<size_t>(
+        std::count(isOccupied.begin(), isOccupied.end(), 1));
+    _activeTiles.reserve(numberOfActiveTiles);
+    _values.reserve(numberOfActiveTiles * kTileVolume);
+    for (size_t idx = 0; idx < numberOfTiles; ++idx) {
+        if (isOccupied[idx]) {
+            _tileTable[idx] = _activeTiles.size();
+            _activeTiles.push_back(idx);
+        }
+    }
+    _values.resize(numberOfActiveTiles * kTileVolume, _background);
+
+    parallelFor(kZeroSize, numberOfActiveTiles, [&](size_t s) {
+        T* tile = &_values[s * kTileVolume];
+        forEachIndexInTile(_activeTiles[s],
+                           [&](size_t i, size_t j, size_t k) {
+                               tile[offset(i, j, k)] = other(i, j, k);
+                           });
+    });
+}
+
+template <typename T>
+void TiledArray3<T>::copyTo(ArrayAccessor3<T> other) const {
+    JET_ASSERT(other.size() == _size);
+
+    parallelFor(kZeroSize, _tileTable.size(), [&](size_t idx) {
+        const size_t s = _tileTable[idx];
+        if (s == kInactiveTile) {
+            forEachIndexInTile(idx, [&](size_t i, size_t j, size_t k) {
+                other(i, j, k) = _background;
+            });
+        } else {
+            const T* tile = &_values[s * kTileVolume];
+            forEachIndexInTile(idx, [&](size_t i, size_t j, size_t k) {
+                other(i, j, k) = tile[offset(i, j, k)];
+            });
+        }
+    });
+}
+
+template <typename T>
+template <typename Callback>
+void TiledArray3<T>::forEachActiveTile(Callback func) const {
+    for (size_t idx : _activeTiles) {
+        func(idx % _tileResolution.x,
+             (idx / _tileResolution.x) % _tileResolution.y,
+             idx / (_tileResolution.x * _tileResolution.y));
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void TiledArray3<T>::parallelForEachActiveTile(Callback func) const {
+    parallelFor(kZeroSize, _activeTiles.size(), [&](size_t s) {
+        const size_t idx = _activeTiles[s];
+        func(idx % _tileResolution.x,
+             (idx / _tileResolution.x) % _tileResolution.y,
+             idx / (_tileResolution.x * _tileResolution.y));
+    });
+}
+
+template <typename T>
+template <typename Callback>
+void TiledArray3<T>::forEachActiveIndex(Callback func) const {
+    for (size_t idx : _activeTiles) {
+        forEachIndexInTile(idx, func);
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void TiledArray3<T>::parallelForEachActiveIndex(Callback func) const {
+    parallelFor(kZeroSize, _activeTiles.size(), [&](size_t s) {
+        forEachIndexInTile(_activeTiles[s], func);
+    });
+}
+
+template <typename T>
+void TiledArray3<T>::swap(TiledArray3& other) {
+    std::swap(_size, other._size);
+    std::swap(_tileResolution, other._tileResolution);
+    std::swap(_background, other._background);
+    _tileTable.swap(other._tileTable);
+    _activeTiles.swap(other._activeTiles);
+    _values.swap(other._values);
+}
+
+template <typename T>
+size_t TiledArray3<T>::tileIndex(size_t ti, size_t tj, size_t tk) const {
+    JET_ASSERT(ti < _tileResolution.x && tj < _tileResolution.y &&
+               tk < _tileResolution.z);
+    return ti + _tileResolution.x * (tj + _tileResolution.y * tk);
+}
+
+template <typename T>
+size_t TiledArray3<T>::slot(size_t i, size_t j, size_t k) const {
+    return _tileTable[tileIndex(i / kTileSize, j / kTileSize, k / kTileSize)];
+}
+
+template <typename T>
+size_t TiledArray3<T>::offset(size_t i, size_t j, size_t k) {
+    return (i % kTileSize) +
+           kTileSize * ((j % kTileSize) + kTileSize * (k % kTileSize));
+}
+
+template <typename T>
+template <typename Callback>
+void TiledArray3<T>::forEachIndexInTile(size_t linearTileIndex,
+                                        Callback func) const {
+    const size_t ti = linearTileIndex % _tileResolution.x;
+    const size_t tj = (linearTileIndex / _tileResolution.x) % _tileResolution.y;
+    const size_t tk = linearTileIndex / (_tileResolution.x * _tileResolution.y);
+
+    const size_t iBegin = ti * kTileSize;
+    const size_t jBegin = tj * kTileSize;
+    const size_t kBegin = tk * kTileSize;
+    const size_t iEnd = std::min(iBegin + kTileSize, _size.x);
+    const size_t jEnd = std::min(jBegin + kTileSize, _size.y);
+    const size_t kEnd = std::min(kBegin + kTileSize, _size.z);
+
+    for (size_t k = kBegin; k < kEnd; ++k) {
+        for (size_t j = jBegin; j < jEnd; ++j) {
+            for (size_t i = iBegin; i < iEnd; ++i) {
+                func(i, j, k);
+            }
+        }
+    }
+}
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_DETAIL_TILED_ARRAY3_INL_H_
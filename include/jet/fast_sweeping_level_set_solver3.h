@@ -0,0 +1,107 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
+#define INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
+
+#include <jet/level_set_solver3.h>
+#include <memory>
+
+namespace jet {
+
+//!
+//! \brief Three-dimensional parallel fast sweeping method implementation.
+//!
+//! This class implements 3-D fast sweeping method which solves the same
+//! first-order upwind discretization as FmmLevelSetSolver3 by Gauss-Seidel
+//! iterations with eight alternating sweep orderings instead of a priority
+//! queue. Within a sweep, the grid points on the same hyperplane
+//! i + j + k = const do not depend on each other, so each hyperplane is
+//! updated in parallel, and the result is identical to the serial sweep.
+//!
+//! \see Zhao, Hongkai. "A fast sweeping method for eikonal equations."
+//!     Mathematics of computation 74.250 (2005): 603-627.
+//! \see Detrixhe, Miles, Frederic Gibou, and Chohong Min. "A parallel fast
+//!     sweeping method for the Eikonal equation." Journal of Computational
+//!     Physics 237 (2013): 46-55.
+//!
+class FastSweepingLevelSetSolver3 final : public LevelSetSolver3 {
+ public:
+    //! Default constructor.
+    FastSweepingLevelSetSolver3();
+
+    //!
+    //! Reinitializes given scalar field to signed-distance field.
+    //!
+    //! \param inputSdf Input signed-distance field which can be distorted.
+    //! \param maxDistance Max range of reinitialization.
+    //! \param outputSdf Output signed-distance field.
+    //!
+    void reinitialize(
+        const ScalarGrid3& inputSdf,
+        double maxDistance,
+        ScalarGrid3* outputSdf) override;
+
+    //!
+    //! Extrapolates given scalar field from negative to positive SDF region.
+    //!
+    //! \param input Input scalar field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output scalar field.
+    //!
+    void extrapolate(
+        const ScalarGrid3& input,
+        const ScalarField3& sdf,
+        double maxDistance,
+        ScalarGrid3* output) override;
+
+    //!
+    //! Extrapolates given collocated vector field from negative to positive SDF
+    //! region.
+    //!
+    //! \param input Input collocated vector field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output collocated vector field.
+    //!
+    void extrapolate(
+        const CollocatedVectorGrid3& input,
+        const ScalarField3& sdf,
+        double maxDistance,
+        CollocatedVectorGrid3* output) override;
+
+    //!
+    //! Extrapolates given face-centered vector field from negative to positive
+    //! SDF region.
+    //!
+    //! \param input Input face-centered field to be extrapolated.
+    //! \param sdf Reference signed-distance field.
+    //! \param maxDistance Max range of extrapolation.
+    //! \param output Output face-centered vector field.
+    //!
+    void extrapolate(
+        const FaceCenteredGrid3& input,
+        const ScalarField3& sdf,
+        double maxDistance,
+        FaceCenteredGrid3* output) override;
+
+ private:
+    void extrapolate(
+        const ConstArrayAccessor3<double>& input,
+        const ConstArrayAccessor3<double>& sdf,
+        const Vector3D& gridSpacing,
+        double maxDistance,
+        ArrayAccessor3<double> output);
+};
+
+//! Shared pointer type for the FastSweepingLevelSetSolver3.
+typedef std::shared_ptr<FastSweepingLevelSetSolver3>
+    FastSweepingLevelSetSolver3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FAST_SWEEPING_LEVEL_SET_SOLVER3_H_
@@ -0,0 +1,105 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_FDM_AMGPCG_SOLVER2_H_
+#define INCLUDE_JET_FDM_AMGPCG_SOLVER2_H_
+
+#include <jet/amg.h>
+#include <jet/fdm_linear_system_solver2.h>
+
+namespace jet {
+
+//!
+//! \brief 2-D finite difference-type linear system solver using conjugate
+//!        gradient preconditioned by algebraic multigrid (AMG).
+//!
+//! Unlike FdmMgpcgSolver2, the multigrid hierarchy is built from the matrix
+//! itself, so irregular fluid domains and the fractional (cut-cell)
+//! coefficients are coarsened as they are. The dense system is converted to
+//! the compressed matrix before solving. If the hierarchy reuse is enabled
+//! and the sparsity pattern of the matrix is the same as the last solve, the
+//! transfer operators are reused and only the coarser matrices are
+//! recomputed.
+//!
+//! \see AmgHierarchy
+//!
+class FdmAmgpcgSolver2 final : public FdmLinearSystemSolver2 {
+ public:
+    //! Constructs the solver with given parameters.
+    FdmAmgpcgSolver2(unsigned int maxNumberOfIterations, double tolerance,
+                     const AmgParameters& params = AmgParameters());
+
+    //! Solves the given linear system.
+    bool solve(FdmLinearSystem2* system) override;
+
+    //! Solves the given compressed linear system.
+    bool solveCompressed(FdmCompressedLinearSystem2* system) override;
+
+    //! Returns the max number of PCG iterations.
+    unsigned int maxNumberOfIterations() const;
+
+    //! Returns the last number of PCG iterations the solver made.
+    unsigned int lastNumberOfIterations() const override;
+
+    //! Returns the max residual tolerance for the PCG method.
+    double tolerance() const;
+
+    //! Returns the last residual after the PCG iterations.
+    double lastResidual() const;
+
+    //! Returns the AMG parameters.
+    const AmgParameters& params() const;
+
+    //! Returns the number of levels of the last AMG hierarchy.
+    size_t lastNumberOfLevels() const;
+
+    //! Returns true if the hierarchy is reused when the sparsity pattern of
+    //! the matrix does not change.
+    bool isReusingHierarchy() const;
+
+    //! Sets true to reuse the hierarchy when the sparsity pattern of the
+    //! matrix does not change.
+    void setIsReusingHierarchy(bool isReusing);
+
+    //! Returns true if the last solve reused the previous hierarchy.
+    bool isLastHierarchyReused() const;
+
+ private:
+    struct Preconditioner final {
+        AmgHierarchyD* hierarchy;
+
+        void solve(const VectorND& b, VectorND* x);
+    };
+
+    unsigned int _maxNumberOfIterations;
+    unsigned int _lastNumberOfIterations;
+    double _tolerance;
+    double _lastResidualNorm;
+    AmgParameters _params;
+    bool _isReusingHierarchy = true;
+    bool _isLastHierarchyReused = false;
+
+    AmgHierarchyD _hierarchy;
+    Preconditioner _precond;
+
+    // Compressed copy of the dense system
+    FdmCompressedLinearSystem2 _compSystem;
+
+    VectorND _r;
+    VectorND _d;
+    VectorND _q;
+    VectorND _s;
+
+    bool solveCsr(const MatrixCsrD& matrix, const VectorND& rhs,
+                  VectorND* solution);
+};
+
+//! Shared pointer type for the FdmAmgpcgSolver2.
+typedef std::shared_ptr<FdmAmgpcgSolver2> FdmAmgpcgSolver2Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_FDM_AMGPCG_SOLVER2_H_
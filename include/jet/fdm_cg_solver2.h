@@ -13,6 +13,12 @@ namespace jet {
 
 //! \brief 2-D finite difference-type linear system solver using conjugate
 //!        gradient.
+//!
+//! When single precision is enabled, the double-precision systems are solved
+//! with mixed-precision iterative refinement: the residual is evaluated in
+//! double precision while the correction is computed by CG with float vectors
+//! on the double-precision matrix (FdmMixedBlas). No float copy of the matrix
+//! is made, so the solve takes less memory than the double-precision CG.
 class FdmCgSolver2 final : public FdmLinearSystemSolver2 {
  public:
     //! Constructs the solver with given parameters.
@@ -21,6 +27,9 @@ class FdmCgSolver2 final : public FdmLinearSystemSolver2 {
     //! Solves the given linear system.
     bool solve(FdmLinearSystem2* system) override;
 
+    //! Solves the given single-precision linear system.
+    bool solve(FdmLinearSystem2F* system);
+
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem2* system) override;
 
@@ -28,7 +37,7 @@ class FdmCgSolver2 final : public FdmLinearSystemSolver2 {
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of CG iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the CG method.
     double tolerance() const;
@@ -36,11 +45,22 @@ class FdmCgSolver2 final : public FdmLinearSystemSolver2 {
     //! Returns the last residual after the CG iterations.
     double lastResidual() const;
 
+    //! Returns true if the single-precision path is used for FdmLinearSystem2.
+    bool isUsingSinglePrecision() const;
+
+    //! \brief Sets true to solve FdmLinearSystem2 in single precision.
+    //!
+    //! The solution is refined in double precision, so the result is as
+    //! accurate as the double-precision CG as long as the system is not too
+    //! ill-conditioned for the float correction solves. Default is false.
+    void setIsUsingSinglePrecision(bool isUsing);
+
  private:
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
     double _tolerance;
     double _lastResidual;
+    bool _isUsingSinglePrecision = false;
 
     // Uncompressed vectors
     FdmVector2 _r;
@@ -54,8 +74,21 @@ class FdmCgSolver2 final : public FdmLinearSystemSolver2 {
     VectorND _qComp;
     VectorND _sComp;
 
+    // Single-precision vectors
+    FdmVector2F _rF;
+    FdmVector2F _dF;
+    FdmVector2F _qF;
+    FdmVector2F _sF;
+    FdmVector2F _residualF;
+    FdmVector2F _correctionF;
+
+    void solveSinglePrecision(FdmLinearSystem2F* system, double tolerance,
+                              unsigned int maxNumberOfIterations);
+    bool solveMixedPrecision(FdmLinearSystem2* system);
+
     void clearUncompressedVectors();
     void clearCompressedVectors();
+    void clearSinglePrecisionVectors();
 };
 
 //! Shared pointer type for the FdmCgSolver2.
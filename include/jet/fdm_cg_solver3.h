@@ -13,6 +13,12 @@ namespace jet {
 
 //! \brief 3-D finite difference-type linear system solver using conjugate
 //!        gradient.
+//!
+//! When single precision is enabled, the double-precision systems are solved
+//! with mixed-precision iterative refinement: the residual is evaluated in
+//! double precision while the correction is computed by CG with float vectors
+//! on the double-precision matrix (FdmMixedBlas). No float copy of the matrix
+//! is made, so the solve takes less memory than the double-precision CG.
 class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
  public:
     //! Constructs the solver with given parameters.
@@ -21,14 +27,20 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given linear system.
     bool solve(FdmLinearSystem3* system) override;
 
+    //! Solves the given single-precision linear system.
+    bool solve(FdmLinearSystem3F* system);
+
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem3* system) override;
 
+    //! Solves the given linear system with the compact stencil matrix.
+    bool solveStencil(FdmStencilLinearSystem3* system) override;
+
     //! Returns the max number of CG iterations.
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of CG iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the CG method.
     double tolerance() const;
@@ -36,11 +48,22 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     //! Returns the last residual after the CG iterations.
     double lastResidual() const;
 
+    //! Returns true if the single-precision path is used for FdmLinearSystem3.
+    bool isUsingSinglePrecision() const;
+
+    //! \brief Sets true to solve FdmLinearSystem3 in single precision.
+    //!
+    //! The solution is refined in double precision, so the result is as
+    //! accurate as the double-precision CG as long as the system is not too
+    //! ill-conditioned for the float correction solves. Default is false.
+    void setIsUsingSinglePrecision(bool isUsing);
+
  private:
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
     double _tolerance;
     double _lastResidual;
+    bool _isUsingSinglePrecision = false;
 
     // Uncompressed vectors
     FdmVector3 _r;
@@ -48,14 +71,27 @@ class FdmCgSolver3 final : public FdmLinearSystemSolver3 {
     FdmVector3 _q;
     FdmVector3 _s;
 
-    // Compressed vectors
+    // Compressed (and stencil) vectors
     VectorND _rComp;
     VectorND _dComp;
     VectorND _qComp;
     VectorND _sComp;
 
+    // Single-precision vectors
+    FdmVector3F _rF;
+    FdmVector3F _dF;
+    FdmVector3F _qF;
+    FdmVector3F _sF;
+    FdmVector3F _residualF;
+    FdmVector3F _correctionF;
+
+    void solveSinglePrecision(FdmLinearSystem3F* system, double tolerance,
+                              unsigned int maxNumberOfIterations);
+    bool solveMixedPrecision(FdmLinearSystem3* system);
+
     void clearUncompressedVectors();
     void clearCompressedVectors();
+    void clearSinglePrecisionVectors();
 };
 
 //! Shared pointer type for the FdmCgSolver3.
@@ -31,7 +31,7 @@ class FdmGaussSeidelSolver2 final : public FdmLinearSystemSolver2 {
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of Gauss-Seidel iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the Gauss-Seidel method.
     double tolerance() const;
@@ -49,6 +49,11 @@ class FdmGaussSeidelSolver2 final : public FdmLinearSystemSolver2 {
     static void relax(const FdmMatrix2& A, const FdmVector2& b,
                       double sorFactor, FdmVector2* x);
 
+    //! \brief Performs single natural Gauss-Seidel relaxation step for
+    //!        single-precision sys.
+    static void relax(const FdmMatrix2F& A, const FdmVector2F& b,
+                      double sorFactor, FdmVector2F* x);
+
     //! \brief Performs single natural Gauss-Seidel relaxation step for
     //!        compressed sys.
     static void relax(const MatrixCsrD& A, const VectorND& b, double sorFactor,
@@ -58,6 +63,11 @@ class FdmGaussSeidelSolver2 final : public FdmLinearSystemSolver2 {
     static void relaxRedBlack(const FdmMatrix2& A, const FdmVector2& b,
                               double sorFactor, FdmVector2* x);
 
+    //! \brief Performs single Red-Black Gauss-Seidel relaxation step for
+    //!        single-precision sys.
+    static void relaxRedBlack(const FdmMatrix2F& A, const FdmVector2F& b,
+                              double sorFactor, FdmVector2F* x);
+
  private:
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
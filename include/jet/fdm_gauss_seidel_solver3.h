@@ -27,11 +27,14 @@ class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem3* system) override;
 
+    //! Solves the given linear system with the compact stencil matrix.
+    bool solveStencil(FdmStencilLinearSystem3* system) override;
+
     //! Returns the max number of Gauss-Seidel iterations.
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of Gauss-Seidel iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the Gauss-Seidel method.
     double tolerance() const;
@@ -49,15 +52,30 @@ class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
     static void relax(const FdmMatrix3& A, const FdmVector3& b,
                       double sorFactor, FdmVector3* x);
 
+    //! \brief Performs single natural Gauss-Seidel relaxation step for
+    //!        single-precision sys.
+    static void relax(const FdmMatrix3F& A, const FdmVector3F& b,
+                      double sorFactor, FdmVector3F* x);
+
     //! \brief Performs single natural Gauss-Seidel relaxation step for
     //!        compressed sys.
     static void relax(const MatrixCsrD& A, const VectorND& b, double sorFactor,
                       VectorND* x);
 
+    //! \brief Performs single natural Gauss-Seidel relaxation step for the
+    //!        stencil matrix.
+    static void relax(const FdmStencilMatrix3& A, const VectorND& b,
+                      double sorFactor, VectorND* x);
+
     //! Performs single Red-Black Gauss-Seidel relaxation step.
     static void relaxRedBlack(const FdmMatrix3& A, const FdmVector3& b,
                               double sorFactor, FdmVector3* x);
 
+    //! \brief Performs single Red-Black Gauss-Seidel relaxation step for
+    //!        single-precision sys.
+    static void relaxRedBlack(const FdmMatrix3F& A, const FdmVector3F& b,
+                              double sorFactor, FdmVector3F* x);
+
  private:
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
@@ -70,7 +88,7 @@ class FdmGaussSeidelSolver3 final : public FdmLinearSystemSolver3 {
     // Uncompressed vectors
     FdmVector3 _residual;
 
-    // Compressed vectors
+    // Compressed (and stencil) vectors
     VectorND _residualComp;
 
     void clearUncompressedVectors();
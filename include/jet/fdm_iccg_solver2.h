@@ -9,12 +9,22 @@
 
 #include <jet/fdm_cg_solver2.h>
 
+#include <vector>
+
 namespace jet {
 
 //!
 //! \brief 2-D finite difference-type linear system solver using incomplete
 //!        Cholesky conjugate gradient (ICCG).
 //!
+//! The incomplete Cholesky preconditioner is built and applied serially by
+//! default. When the parallel preconditioner is enabled, the triangular solves
+//! are scheduled by wavefronts: square tiles ordered by the anti-diagonals of
+//! the grid for FdmMatrix2, and dependency levels for the compressed matrix.
+//! The work in the same wavefront is processed in parallel. Every point still
+//! sees the same values from its neighbors, so the preconditioner and the
+//! number of iterations are identical to the serial version.
+//!
 class FdmIccgSolver2 final : public FdmLinearSystemSolver2 {
  public:
     //! Constructs the solver with given parameters.
@@ -30,7 +40,7 @@ class FdmIccgSolver2 final : public FdmLinearSystemSolver2 {
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of Jacobi iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the Jacobi method.
     double tolerance() const;
@@ -38,11 +48,25 @@ class FdmIccgSolver2 final : public FdmLinearSystemSolver2 {
     //! Returns the last residual after the Jacobi iterations.
     double lastResidual() const;
 
+    //! Returns true if the preconditioner is built and applied in parallel.
+    bool isUsingParallelPreconditioner() const;
+
+    //! Sets true to build and apply the preconditioner in parallel.
+    void setIsUsingParallelPreconditioner(bool isUsing);
+
  private:
+    // Groups of rows processed one after another in the triangular solves.
+    struct LevelSchedule final {
+        std::vector<size_t> pointers;
+        std::vector<size_t> rows;
+        std::vector<char> isParallel;
+    };
+
     struct Preconditioner final {
         ConstArrayAccessor2<FdmMatrixRow2> A;
         FdmVector2 d;
         FdmVector2 y;
+        bool isParallel = false;
 
         void build(const FdmMatrix2& matrix);
 
@@ -53,6 +77,9 @@ class FdmIccgSolver2 final : public FdmLinearSystemSolver2 {
         const MatrixCsrD* A;
         VectorND d;
         VectorND y;
+        bool isParallel = false;
+        LevelSchedule lowerLevels;
+        LevelSchedule upperLevels;
 
         void build(const MatrixCsrD& matrix);
 
@@ -9,12 +9,23 @@
 
 #include <jet/fdm_cg_solver3.h>
 
+#include <vector>
+
 namespace jet {
 
 //!
 //! \brief 3-D finite difference-type linear system solver using incomplete
 //!        Cholesky conjugate gradient (ICCG).
 //!
+//! The incomplete Cholesky preconditioner is built and applied serially by
+//! default. When the parallel preconditioner is enabled, the triangular solves
+//! are scheduled by wavefronts: tiles of x-lines ordered by the anti-diagonals
+//! of the yz-plane for FdmMatrix3, and dependency levels for the compressed
+//! and stencil matrices. The work in the same wavefront is processed in
+//! parallel. Every point still sees the same values from its neighbors, so the
+//! preconditioner and the number of iterations are identical to the serial
+//! version.
+//!
 class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
  public:
     //! Constructs the solver with given parameters.
@@ -26,11 +37,14 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem3* system) override;
 
+    //! Solves the given linear system with the compact stencil matrix.
+    bool solveStencil(FdmStencilLinearSystem3* system) override;
+
     //! Returns the max number of ICCG iterations.
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of ICCG iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the ICCG method.
     double tolerance() const;
@@ -38,11 +52,25 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     //! Returns the last residual after the ICCG iterations.
     double lastResidual() const;
 
+    //! Returns true if the preconditioner is built and applied in parallel.
+    bool isUsingParallelPreconditioner() const;
+
+    //! Sets true to build and apply the preconditioner in parallel.
+    void setIsUsingParallelPreconditioner(bool isUsing);
+
  private:
+    // Groups of rows processed one after another in the triangular solves.
+    struct LevelSchedule final {
+        std::vector<size_t> pointers;
+        std::vector<size_t> rows;
+        std::vector<char> isParallel;
+    };
+
     struct Preconditioner final {
         ConstArrayAccessor3<FdmMatrixRow3> A;
         FdmVector3 d;
         FdmVector3 y;
+        bool isParallel = false;
 
         void build(const FdmMatrix3& matrix);
 
@@ -53,12 +81,28 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
         const MatrixCsrD* A;
         VectorND d;
         VectorND y;
+        bool isParallel = false;
+        LevelSchedule lowerLevels;
+        LevelSchedule upperLevels;
 
         void build(const MatrixCsrD& matrix);
 
         void solve(const VectorND& b, VectorND* x);
     };
 
+    struct PreconditionerStencil final {
+        const FdmStencilMatrix3* A;
+        VectorND d;
+        VectorND y;
+        bool isParallel = false;
+        LevelSchedule lowerLevels;
+        LevelSchedule upperLevels;
+
+        void build(const FdmStencilMatrix3& matrix);
+
+        void solve(const VectorND& b, VectorND* x);
+    };
+
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
     double _tolerance;
@@ -71,12 +115,13 @@ class FdmIccgSolver3 final : public FdmLinearSystemSolver3 {
     FdmVector3 _s;
     Preconditioner _precond;
 
-    // Compressed vectors and preconditioner
+    // Compressed (and stencil) vectors and preconditioners
     VectorND _rComp;
     VectorND _dComp;
     VectorND _qComp;
     VectorND _sComp;
     PreconditionerCompressed _precondComp;
+    PreconditionerStencil _precondStencil;
 
     void clearUncompressedVectors();
     void clearCompressedVectors();
@@ -28,7 +28,7 @@ class FdmJacobiSolver2 final : public FdmLinearSystemSolver2 {
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of Jacobi iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the Jacobi method.
     double tolerance() const;
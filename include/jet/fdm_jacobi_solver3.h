@@ -24,11 +24,14 @@ class FdmJacobiSolver3 final : public FdmLinearSystemSolver3 {
     //! Solves the given compressed linear system.
     bool solveCompressed(FdmCompressedLinearSystem3* system) override;
 
+    //! Solves the given linear system with the compact stencil matrix.
+    bool solveStencil(FdmStencilLinearSystem3* system) override;
+
     //! Returns the max number of Jacobi iterations.
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of Jacobi iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the Jacobi method.
     double tolerance() const;
@@ -44,6 +47,10 @@ class FdmJacobiSolver3 final : public FdmLinearSystemSolver3 {
     static void relax(const MatrixCsrD& A, const VectorND& b, VectorND* x,
                       VectorND* xTemp);
 
+    //! Performs single Jacobi relaxation step for the stencil matrix.
+    static void relax(const FdmStencilMatrix3& A, const VectorND& b,
+                      VectorND* x, VectorND* xTemp);
+
  private:
     unsigned int _maxNumberOfIterations;
     unsigned int _lastNumberOfIterations;
@@ -55,7 +62,7 @@ class FdmJacobiSolver3 final : public FdmLinearSystemSolver3 {
     FdmVector3 _xTemp;
     FdmVector3 _residual;
 
-    // Compressed vectors
+    // Compressed (and stencil) vectors
     VectorND _xTempComp;
     VectorND _residualComp;
 
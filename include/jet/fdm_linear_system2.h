@@ -26,12 +26,30 @@ struct FdmMatrixRow2 {
     double up = 0.0;
 };
 
+//! The row of FdmMatrix2F where row corresponds to (i, j) grid point.
+struct FdmMatrixRow2F {
+    //! Diagonal component of the matrix (row, row).
+    float center = 0.0f;
+
+    //! Off-diagonal element where colum refers to (i+1, j) grid point.
+    float right = 0.0f;
+
+    //! Off-diagonal element where column refers to (i, j+1) grid point.
+    float up = 0.0f;
+};
+
 //! Vector type for 2-D finite differencing.
 typedef Array2<double> FdmVector2;
 
 //! Matrix type for 2-D finite differencing.
 typedef Array2<FdmMatrixRow2> FdmMatrix2;
 
+//! Single-precision vector type for 2-D finite differencing.
+typedef Array2<float> FdmVector2F;
+
+//! Single-precision matrix type for 2-D finite differencing.
+typedef Array2<FdmMatrixRow2F> FdmMatrix2F;
+
 //! Linear system (Ax=b) for 2-D finite differencing.
 struct FdmLinearSystem2 {
     //! System matrix.
@@ -50,6 +68,24 @@ struct FdmLinearSystem2 {
     void resize(const Size2& size);
 };
 
+//! Single-precision linear system (Ax=b) for 2-D finite differencing.
+struct FdmLinearSystem2F {
+    //! System matrix.
+    FdmMatrix2F A;
+
+    //! Solution vector.
+    FdmVector2F x;
+
+    //! RHS vector.
+    FdmVector2F b;
+
+    //! Clears all the data.
+    void clear();
+
+    //! Resizes the arrays with given grid size.
+    void resize(const Size2& size);
+};
+
 //! Compressed linear system (Ax=b) for 2-D finite differencing.
 struct FdmCompressedLinearSystem2 {
     //! System matrix.
@@ -95,6 +131,17 @@ struct FdmBlas2 {
     static void mvm(const MatrixType& m, const VectorType& v,
                     VectorType* result);
 
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
     //! Computes residual vector (b - ax).
     static void residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
@@ -106,6 +153,123 @@ struct FdmBlas2 {
     static ScalarType lInfNorm(const VectorType& v);
 };
 
+//!
+//! \brief Single-precision BLAS operator wrapper for 2-D finite differencing.
+//!
+//! Vectors and matrices are stored in float, which halves the memory traffic
+//! of the matrix-vector products compared to FdmBlas2. Dot products and
+//! norms are accumulated in double precision.
+//!
+struct FdmBlas2F {
+    typedef float ScalarType;
+    typedef FdmVector2F VectorType;
+    typedef FdmMatrix2F MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(const VectorType& v, VectorType* result);
+
+    //! Sets entire element of given matrix \p result with scalar \p s.
+    static void set(ScalarType s, MatrixType* result);
+
+    //! Copies entire element of given matrix \p result with other matrix \p v.
+    static void set(const MatrixType& m, MatrixType* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y are
+    //! vectors.
+    static void axpy(double a, const VectorType& x, const VectorType& y,
+                     VectorType* result);
+
+    //! Performs matrix-vector multiplication.
+    static void mvm(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
+    //! Computes residual vector (b - ax).
+    static void residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    static double l2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    static double lInfNorm(const VectorType& v);
+};
+
+//!
+//! \brief Mixed-precision BLAS operator wrapper for 2-D finite differencing.
+//!
+//! Vectors are stored in float while the matrix stays in double, so a
+//! single-precision solve can run on a double-precision system without a
+//! float copy of the matrix. The matrix-vector products are evaluated in
+//! double precision and rounded to float.
+//!
+struct FdmMixedBlas2 {
+    typedef float ScalarType;
+    typedef FdmVector2F VectorType;
+    typedef FdmMatrix2 MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(const VectorType& v, VectorType* result);
+
+    //! Sets entire element of given matrix \p result with scalar \p s.
+    static void set(ScalarType s, MatrixType* result);
+
+    //! Copies entire element of given matrix \p result with other matrix \p v.
+    static void set(const MatrixType& m, MatrixType* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y are
+    //! vectors.
+    static void axpy(double a, const VectorType& x, const VectorType& y,
+                     VectorType* result);
+
+    //! Performs matrix-vector multiplication.
+    static void mvm(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
+    //! Computes residual vector (b - ax).
+    static void residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    static double l2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    static double lInfNorm(const VectorType& v);
+};
+
 //! BLAS operator wrapper for compressed 2-D finite differencing.
 struct FdmCompressedBlas2 {
     typedef double ScalarType;
@@ -136,6 +300,17 @@ struct FdmCompressedBlas2 {
     static void mvm(const MatrixType& m, const VectorType& v,
                     VectorType* result);
 
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
     //! Computes residual vector (b - ax).
     static void residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
@@ -12,6 +12,9 @@
 #include <jet/matrix_csr.h>
 #include <jet/vector_n.h>
 
+#include <cstdint>
+#include <functional>
+
 namespace jet {
 
 //! The row of FdmMatrix3 where row corresponds to (i, j, k) grid point.
@@ -29,12 +32,88 @@ struct FdmMatrixRow3 {
     double front = 0.0;
 };
 
+//! The row of FdmMatrix3F where row corresponds to (i, j, k) grid point.
+struct FdmMatrixRow3F {
+    //! Diagonal component of the matrix (row, row).
+    float center = 0.0f;
+
+    //! Off-diagonal element where colum refers to (i+1, j, k) grid point.
+    float right = 0.0f;
+
+    //! Off-diagonal element where column refers to (i, j+1, k) grid point.
+    float up = 0.0f;
+
+    //! OFf-diagonal element where column refers to (i, j, k+1) grid point.
+    float front = 0.0f;
+};
+
 //! Vector type for 3-D finite differencing.
 typedef Array3<double> FdmVector3;
 
 //! Matrix type for 3-D finite differencing.
 typedef Array3<FdmMatrixRow3> FdmMatrix3;
 
+//! Single-precision vector type for 3-D finite differencing.
+typedef Array3<float> FdmVector3F;
+
+//! Single-precision matrix type for 3-D finite differencing.
+typedef Array3<FdmMatrixRow3F> FdmMatrix3F;
+
+//!
+//! \brief Compact 7-point stencil matrix for 3-D finite differencing.
+//!
+//! Unlike FdmMatrix3, only the rows of the active grid points (such as the
+//! fluid cells of a pressure system) are stored, in the order of the grid
+//! points. Each row keeps the diagonal and the couplings to the (i+1, j, k),
+//! (i, j+1, k), and (i, j, k+1) points in single precision. The couplings to
+//! the lower neighbors are read from the rows of those neighbors since the
+//! matrix is symmetric, and the neighbors are found through a grid-sized map
+//! from the grid points to the rows. A row takes about 24 bytes while a row of
+//! MatrixCsrD with six neighbors takes 120 bytes.
+//!
+//! A coupling must be zero if it refers to an inactive point or a point
+//! outside of the grid.
+//!
+struct FdmStencilMatrix3 {
+    //! Row index of the inactive grid points.
+    static const uint32_t kInvalidRow;
+
+    //! Coefficients of the rows.
+    Array1<FdmMatrixRow3F> rows;
+
+    //! Linear index (i + width * (j + height * k)) of the grid point of each
+    //! row.
+    Array1<uint32_t> cellIndices;
+
+    //! Row index of each grid point, or kInvalidRow if the point is inactive.
+    Array3<uint32_t> rowIndices;
+
+    //! Clears all the data.
+    void clear();
+
+    //!
+    //! \brief Resizes the matrix with given grid size.
+    //!
+    //! The grid points where \p isActive returns true become the rows of the
+    //! matrix, and all the coefficients are set to zero.
+    //!
+    void resize(const Size3& size,
+                const std::function<bool(size_t, size_t, size_t)>& isActive);
+
+    //! Returns the number of rows.
+    size_t numberOfRows() const;
+
+    //! Invokes \p func(neighborRow, coupling) for the neighbors of given row
+    //! that come before the row, i.e. (i-1, j, k), (i, j-1, k), (i, j, k-1).
+    template <typename Callback>
+    void forEachLowerNeighbor(size_t row, const Callback& func) const;
+
+    //! Invokes \p func(neighborRow, coupling) for the neighbors of given row
+    //! that come after the row, i.e. (i+1, j, k), (i, j+1, k), (i, j, k+1).
+    template <typename Callback>
+    void forEachUpperNeighbor(size_t row, const Callback& func) const;
+};
+
 //! Linear system (Ax=b) for 3-D finite differencing.
 struct FdmLinearSystem3 {
     //! System matrix.
@@ -53,6 +132,24 @@ struct FdmLinearSystem3 {
     void resize(const Size3& size);
 };
 
+//! Single-precision linear system (Ax=b) for 3-D finite differencing.
+struct FdmLinearSystem3F {
+    //! System matrix.
+    FdmMatrix3F A;
+
+    //! Solution vector.
+    FdmVector3F x;
+
+    //! RHS vector.
+    FdmVector3F b;
+
+    //! Clears all the data.
+    void clear();
+
+    //! Resizes the arrays with given grid size.
+    void resize(const Size3& size);
+};
+
 //! Compressed linear system (Ax=b) for 3-D finite differencing.
 struct FdmCompressedLinearSystem3 {
     //! System matrix.
@@ -68,6 +165,27 @@ struct FdmCompressedLinearSystem3 {
     void clear();
 };
 
+//! Linear system (Ax=b) for 3-D finite differencing with the compact
+//! 7-point stencil matrix. The vectors store the active grid points only.
+struct FdmStencilLinearSystem3 {
+    //! System matrix.
+    FdmStencilMatrix3 A;
+
+    //! Solution vector.
+    VectorND x;
+
+    //! RHS vector.
+    VectorND b;
+
+    //! Clears all the data.
+    void clear();
+
+    //! Resizes the matrix and the vectors with given grid size, keeping the
+    //! grid points where \p isActive returns true.
+    void resize(const Size3& size,
+                const std::function<bool(size_t, size_t, size_t)>& isActive);
+};
+
 //! BLAS operator wrapper for 3-D finite differencing.
 struct FdmBlas3 {
     typedef double ScalarType;
@@ -98,6 +216,17 @@ struct FdmBlas3 {
     static void mvm(const MatrixType& m, const VectorType& v,
                     VectorType* result);
 
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
     //! Computes residual vector (b - ax).
     static void residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
@@ -109,6 +238,123 @@ struct FdmBlas3 {
     static ScalarType lInfNorm(const VectorType& v);
 };
 
+//!
+//! \brief Single-precision BLAS operator wrapper for 3-D finite differencing.
+//!
+//! Vectors and matrices are stored in float, which halves the memory traffic
+//! of the matrix-vector products compared to FdmBlas3. Dot products and
+//! norms are accumulated in double precision.
+//!
+struct FdmBlas3F {
+    typedef float ScalarType;
+    typedef FdmVector3F VectorType;
+    typedef FdmMatrix3F MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(const VectorType& v, VectorType* result);
+
+    //! Sets entire element of given matrix \p result with scalar \p s.
+    static void set(ScalarType s, MatrixType* result);
+
+    //! Copies entire element of given matrix \p result with other matrix \p v.
+    static void set(const MatrixType& m, MatrixType* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y are
+    //! vectors.
+    static void axpy(double a, const VectorType& x, const VectorType& y,
+                     VectorType* result);
+
+    //! Performs matrix-vector multiplication.
+    static void mvm(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
+    //! Computes residual vector (b - ax).
+    static void residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    static double l2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    static double lInfNorm(const VectorType& v);
+};
+
+//!
+//! \brief Mixed-precision BLAS operator wrapper for 3-D finite differencing.
+//!
+//! Vectors are stored in float while the matrix stays in double, so a
+//! single-precision solve can run on a double-precision system without a
+//! float copy of the matrix. The matrix-vector products are evaluated in
+//! double precision and rounded to float.
+//!
+struct FdmMixedBlas3 {
+    typedef float ScalarType;
+    typedef FdmVector3F VectorType;
+    typedef FdmMatrix3 MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(const VectorType& v, VectorType* result);
+
+    //! Sets entire element of given matrix \p result with scalar \p s.
+    static void set(ScalarType s, MatrixType* result);
+
+    //! Copies entire element of given matrix \p result with other matrix \p v.
+    static void set(const MatrixType& m, MatrixType* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y are
+    //! vectors.
+    static void axpy(double a, const VectorType& x, const VectorType& y,
+                     VectorType* result);
+
+    //! Performs matrix-vector multiplication.
+    static void mvm(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
+    //! Computes residual vector (b - ax).
+    static void residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    static double l2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    static double lInfNorm(const VectorType& v);
+};
+
 //! BLAS operator wrapper for compressed 3-D finite differencing.
 struct FdmCompressedBlas3 {
     typedef double ScalarType;
@@ -139,6 +385,70 @@ struct FdmCompressedBlas3 {
     static void mvm(const MatrixType& m, const VectorType& v,
                     VectorType* result);
 
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
+    //! Computes residual vector (b - ax).
+    static void residual(const MatrixType& a, const VectorType& x,
+                         const VectorType& b, VectorType* result);
+
+    //! Returns L2-norm of the given vector \p v.
+    static ScalarType l2Norm(const VectorType& v);
+
+    //! Returns Linf-norm of the given vector \p v.
+    static ScalarType lInfNorm(const VectorType& v);
+};
+
+//! BLAS operator wrapper for 3-D finite differencing with the compact 7-point
+//! stencil matrix.
+struct FdmStencilBlas3 {
+    typedef double ScalarType;
+    typedef VectorND VectorType;
+    typedef FdmStencilMatrix3 MatrixType;
+
+    //! Sets entire element of given vector \p result with scalar \p s.
+    static void set(ScalarType s, VectorType* result);
+
+    //! Copies entire element of given vector \p result with other vector \p v.
+    static void set(const VectorType& v, VectorType* result);
+
+    //! Sets entire element of given matrix \p result with scalar \p s.
+    static void set(ScalarType s, MatrixType* result);
+
+    //! Copies entire element of given matrix \p result with other matrix \p v.
+    static void set(const MatrixType& m, MatrixType* result);
+
+    //! Performs dot product with vector \p a and \p b.
+    static double dot(const VectorType& a, const VectorType& b);
+
+    //! Performs ax + y operation where \p a is a matrix and \p x and \p y are
+    //! vectors.
+    static void axpy(double a, const VectorType& x, const VectorType& y,
+                     VectorType* result);
+
+    //! Performs matrix-vector multiplication.
+    static void mvm(const MatrixType& m, const VectorType& v,
+                    VectorType* result);
+
+    //! Performs matrix-vector multiplication and returns the dot product of
+    //! \p v and the result in a single pass.
+    static double mvmAndDot(const MatrixType& m, const VectorType& v,
+                            VectorType* result);
+
+    //! Performs x = x + a * d and r = r - a * q, and returns the dot product
+    //! of the updated r with itself in a single pass.
+    static double axpyPairAndDot(double a, const VectorType& d,
+                                 const VectorType& q, VectorType* x,
+                                 VectorType* r);
+
     //! Computes residual vector (b - ax).
     static void residual(const MatrixType& a, const VectorType& x,
                          const VectorType& b, VectorType* result);
@@ -152,4 +462,6 @@ struct FdmCompressedBlas3 {
 
 }  // namespace jet
 
+#include "detail/fdm_linear_system3-inl.h"
+
 #endif  // INCLUDE_JET_FDM_LINEAR_SYSTEM3_H_
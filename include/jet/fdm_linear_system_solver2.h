@@ -25,6 +25,27 @@ class FdmLinearSystemSolver2 {
 
     //! Solves the given compressed linear system.
     virtual bool solveCompressed(FdmCompressedLinearSystem2*) { return false; }
+
+    //! Returns the last number of iterations the solver made.
+    virtual unsigned int lastNumberOfIterations() const { return 0; }
+
+    //! Returns true if the solver starts from the given solution vector.
+    bool isUsingInitialGuess() const { return _isUsingInitialGuess; }
+
+    //!
+    //! \brief Sets true to start from the given solution vector.
+    //!
+    //! By default, iterative solvers that start from zero ignore the input
+    //! solution vector. When the solution of the previous solve is a good
+    //! estimate, such as the pressure of the last time step, enabling this
+    //! option saves iterations.
+    //!
+    void setIsUsingInitialGuess(bool isUsing) {
+        _isUsingInitialGuess = isUsing;
+    }
+
+ private:
+    bool _isUsingInitialGuess = false;
 };
 
 //! Shared pointer type for the FdmLinearSystemSolver2.
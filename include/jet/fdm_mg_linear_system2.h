@@ -44,8 +44,10 @@ struct FdmMgLinearSystem2 {
     //! \brief Resizes the system with the finest resolution and max number of
     //! levels.
     //!
-    //! This function resizes the system with multiple levels until the
-    //! resolution is divisible with 2^(level-1).
+    //! Each coarser level takes ceil(n / 2) cells per axis, so odd and
+    //! non-power-of-two resolutions are coarsened as well. The coarsening
+    //! stops when any axis reaches a single cell or when the number of levels
+    //! reaches \p maxNumberOfLevels.
     //!
     //! \param finestResolution - The finest grid resolution.
     //! \param maxNumberOfLevels - Maximum number of multigrid levels.
@@ -54,15 +56,66 @@ struct FdmMgLinearSystem2 {
                           size_t maxNumberOfLevels);
 };
 
+//! Single-precision multigrid-style 2-D FDM matrix.
+typedef MgMatrix<FdmBlas2F> FdmMgMatrix2F;
+
+//! Single-precision multigrid-style 2-D FDM vector.
+typedef MgVector<FdmBlas2F> FdmMgVector2F;
+
+//! Single-precision multigrid-style 2-D linear system.
+struct FdmMgLinearSystem2F {
+    //! The system matrix.
+    FdmMgMatrix2F A;
+
+    //! The solution vector.
+    FdmMgVector2F x;
+
+    //! The RHS vector.
+    FdmMgVector2F b;
+
+    //! Clears the linear system.
+    void clear();
+
+    //! Returns the number of multigrid levels.
+    size_t numberOfLevels() const;
+
+    //! Resizes the system with the coarsest resolution and number of levels.
+    void resizeWithCoarsest(const Size2 &coarsestResolution,
+                            size_t numberOfLevels);
+
+    //! Resizes the system with the finest resolution and max number of
+    //! levels.
+    void resizeWithFinest(const Size2 &finestResolution,
+                          size_t maxNumberOfLevels);
+};
+
 //! Multigrid utilities for 2-D FDM system.
 class FdmMgUtils2 {
  public:
-    //! Restricts given finer grid to the coarser grid.
+    //!
+    //! \brief Restricts given finer grid to the coarser grid.
+    //!
+    //! The finer grid can have either 2n or 2n - 1 cells along each axis for
+    //! n coarser cells. For the odd case, the finer grid is padded with a
+    //! zero cell. Thus every finer cell contributes the same total weight, and
+    //! zero-sum residuals of pure Neumann systems stay zero-sum.
+    //!
     static void restrict(const FdmVector2 &finer, FdmVector2 *coarser);
 
-    //! Corrects given coarser grid to the finer grid.
+    //! Restricts given single-precision finer grid to the coarser grid.
+    static void restrict(const FdmVector2F &finer, FdmVector2F *coarser);
+
+    //!
+    //! \brief Corrects given coarser grid to the finer grid.
+    //!
+    //! Same as restrict, the finer grid can have either 2n or 2n - 1 cells
+    //! along each axis for n coarser cells.
+    //!
     static void correct(const FdmVector2 &coarser, FdmVector2 *finer);
 
+    //! Corrects given single-precision coarser grid to the finer grid.
+    static void correct(const FdmVector2F &coarser, FdmVector2F *finer);
+
     //! Resizes the array with the coarsest resolution and number of levels.
     template <typename T>
     static void resizeArrayWithCoarsest(const Size2 &coarsestResolution,
@@ -73,8 +126,10 @@ class FdmMgUtils2 {
     //! \brief Resizes the array with the finest resolution and max number of
     //! levels.
     //!
-    //! This function resizes the system with multiple levels until the
-    //! resolution is divisible with 2^(level-1).
+    //! Each coarser level takes ceil(n / 2) cells per axis, so odd and
+    //! non-power-of-two resolutions are coarsened as well. The coarsening
+    //! stops when any axis reaches a single cell or when the number of levels
+    //! reaches \p maxNumberOfLevels.
     //!
     //! \param finestResolution - The finest grid resolution.
     //! \param maxNumberOfLevels - Maximum number of multigrid levels.
@@ -44,8 +44,10 @@ struct FdmMgLinearSystem3 {
     //! \brief Resizes the system with the finest resolution and max number of
     //! levels.
     //!
-    //! This function resizes the system with multiple levels until the
-    //! resolution is divisible with 2^(level-1).
+    //! Each coarser level takes ceil(n / 2) cells per axis, so odd and
+    //! non-power-of-two resolutions are coarsened as well. The coarsening
+    //! stops when any axis reaches a single cell or when the number of levels
+    //! reaches \p maxNumberOfLevels.
     //!
     //! \param finestResolution - The finest grid resolution.
     //! \param maxNumberOfLevels - Maximum number of multigrid levels.
@@ -54,15 +56,66 @@ struct FdmMgLinearSystem3 {
                           size_t maxNumberOfLevels);
 };
 
+//! Single-precision multigrid-style 3-D FDM matrix.
+typedef MgMatrix<FdmBlas3F> FdmMgMatrix3F;
+
+//! Single-precision multigrid-style 3-D FDM vector.
+typedef MgVector<FdmBlas3F> FdmMgVector3F;
+
+//! Single-precision multigrid-style 3-D linear system.
+struct FdmMgLinearSystem3F {
+    //! The system matrix.
+    FdmMgMatrix3F A;
+
+    //! The solution vector.
+    FdmMgVector3F x;
+
+    //! The RHS vector.
+    FdmMgVector3F b;
+
+    //! Clears the linear system.
+    void clear();
+
+    //! Returns the number of multigrid levels.
+    size_t numberOfLevels() const;
+
+    //! Resizes the system with the coarsest resolution and number of levels.
+    void resizeWithCoarsest(const Size3 &coarsestResolution,
+                            size_t numberOfLevels);
+
+    //! Resizes the system with the finest resolution and max number of
+    //! levels.
+    void resizeWithFinest(const Size3 &finestResolution,
+                          size_t maxNumberOfLevels);
+};
+
 //! Multigrid utilities for 2-D FDM system.
 class FdmMgUtils3 {
  public:
-    //! Restricts given finer grid to the coarser grid.
+    //!
+    //! \brief Restricts given finer grid to the coarser grid.
+    //!
+    //! The finer grid can have either 2n or 2n - 1 cells along each axis for
+    //! n coarser cells. For the odd case, the finer grid is padded with a
+    //! zero cell. Thus every finer cell contributes the same total weight, and
+    //! zero-sum residuals of pure Neumann systems stay zero-sum.
+    //!
     static void restrict(const FdmVector3 &finer, FdmVector3 *coarser);
 
-    //! Corrects given coarser grid to the finer grid.
+    //! Restricts given single-precision finer grid to the coarser grid.
+    static void restrict(const FdmVector3F &finer, FdmVector3F *coarser);
+
+    //!
+    //! \brief Corrects given coarser grid to the finer grid.
+    //!
+    //! Same as restrict, the finer grid can have either 2n or 2n - 1 cells
+    //! along each axis for n coarser cells.
+    //!
     static void correct(const FdmVector3 &coarser, FdmVector3 *finer);
 
+    //! Corrects given single-precision coarser grid to the finer grid.
+    static void correct(const FdmVector3F &coarser, FdmVector3F *finer);
+
     //! Resizes the array with the coarsest resolution and number of levels.
     template <typename T>
     static void resizeArrayWithCoarsest(const Size3 &coarsestResolution,
@@ -73,8 +126,10 @@ class FdmMgUtils3 {
     //! \brief Resizes the array with the finest resolution and max number of
     //! levels.
     //!
-    //! This function resizes the system with multiple levels until the
-    //! resolution is divisible with 2^(level-1).
+    //! Each coarser level takes ceil(n / 2) cells per axis, so odd and
+    //! non-power-of-two resolutions are coarsened as well. The coarsening
+    //! stops when any axis reaches a single cell or when the number of levels
+    //! reaches \p maxNumberOfLevels.
     //!
     //! \param finestResolution - The finest grid resolution.
     //! \param maxNumberOfLevels - Maximum number of multigrid levels.
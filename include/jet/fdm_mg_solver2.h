@@ -32,20 +32,53 @@ class FdmMgSolver2 : public FdmLinearSystemSolver2 {
     //! Returns the Multigrid parameters.
     const MgParameters<FdmBlas2>& params() const;
 
+    //! Returns the Multigrid parameters for the single-precision system.
+    const MgParameters<FdmBlas2F>& singlePrecisionParams() const;
+
     //! Returns the SOR (Successive Over Relaxation) factor.
     double sorFactor() const;
 
     //! Returns true if red-black ordering is enabled.
     bool useRedBlackOrdering() const;
 
+    //! Returns the multigrid cycle type.
+    MgCycleType cycleType() const;
+
+    //! Sets the multigrid cycle type.
+    void setCycleType(MgCycleType cycleType);
+
+    //! Returns true if CG solves the coarsest level.
+    bool isUsingCgAtCoarsestLevel() const;
+
+    //!
+    //! \brief Sets true to solve the coarsest level with CG.
+    //!
+    //! CG runs up to numberOfCoarsestIter iterations on the coarsest level
+    //! instead of the relaxation, which makes the coarsest solve nearly exact
+    //! when the coarsest grid is small.
+    //!
+    void setIsUsingCgAtCoarsestLevel(bool isUsing);
+
     //! No-op. Multigrid-type solvers do not solve FdmLinearSystem2.
     bool solve(FdmLinearSystem2* system) final;
 
     //! Solves Multigrid linear system.
     virtual bool solve(FdmMgLinearSystem2* system);
 
+    //!
+    //! \brief Solves single-precision Multigrid linear system.
+    //!
+    //! Runs the same cycle as the double-precision solve with float vectors
+    //! and matrices on every level, which halves the memory of the system
+    //! and the traffic of the relaxation sweeps.
+    //!
+    virtual bool solve(FdmMgLinearSystem2F* system);
+
  private:
     MgParameters<FdmBlas2> _mgParams;
+    MgParameters<FdmBlas2F> _mgParamsF;
+    FdmMgVector2 _buffer;
+    FdmMgVector2F _bufferF;
     double _sorFactor;
     bool _useRedBlackOrdering;
 };
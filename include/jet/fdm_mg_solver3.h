@@ -32,20 +32,53 @@ class FdmMgSolver3 : public FdmLinearSystemSolver3 {
     //! Returns the Multigrid parameters.
     const MgParameters<FdmBlas3>& params() const;
 
+    //! Returns the Multigrid parameters for the single-precision system.
+    const MgParameters<FdmBlas3F>& singlePrecisionParams() const;
+
     //! Returns the SOR (Successive Over Relaxation) factor.
     double sorFactor() const;
 
     //! Returns true if red-black ordering is enabled.
     bool useRedBlackOrdering() const;
 
+    //! Returns the multigrid cycle type.
+    MgCycleType cycleType() const;
+
+    //! Sets the multigrid cycle type.
+    void setCycleType(MgCycleType cycleType);
+
+    //! Returns true if CG solves the coarsest level.
+    bool isUsingCgAtCoarsestLevel() const;
+
+    //!
+    //! \brief Sets true to solve the coarsest level with CG.
+    //!
+    //! CG runs up to numberOfCoarsestIter iterations on the coarsest level
+    //! instead of the relaxation, which makes the coarsest solve nearly exact
+    //! when the coarsest grid is small.
+    //!
+    void setIsUsingCgAtCoarsestLevel(bool isUsing);
+
     //! No-op. Multigrid-type solvers do not solve FdmLinearSystem3.
     bool solve(FdmLinearSystem3* system) final;
 
     //! Solves Multigrid linear system.
     virtual bool solve(FdmMgLinearSystem3* system);
 
+    //!
+    //! \brief Solves single-precision Multigrid linear system.
+    //!
+    //! Runs the same cycle as the double-precision solve with float vectors
+    //! and matrices on every level, which halves the memory of the system
+    //! and the traffic of the relaxation sweeps.
+    //!
+    virtual bool solve(FdmMgLinearSystem3F* system);
+
  private:
     MgParameters<FdmBlas3> _mgParams;
+    MgParameters<FdmBlas3F> _mgParamsF;
+    FdmMgVector3 _buffer;
+    FdmMgVector3F _bufferF;
     double _sorFactor;
     bool _useRedBlackOrdering;
 };
@@ -43,11 +43,14 @@ class FdmMgpcgSolver2 final : public FdmMgSolver2 {
     //! Solves the given linear system.
     bool solve(FdmMgLinearSystem2* system) override;
 
+    //! Solves the given single-precision linear system.
+    bool solve(FdmMgLinearSystem2F* system) override;
+
     //! Returns the max number of Jacobi iterations.
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of Jacobi iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the Jacobi method.
     double tolerance() const;
@@ -56,13 +59,19 @@ class FdmMgpcgSolver2 final : public FdmMgSolver2 {
     double lastResidual() const;
 
  private:
+    template <typename BlasType>
     struct Preconditioner final {
-        FdmMgLinearSystem2* system;
-        MgParameters<FdmBlas2> mgParams;
+        const MgMatrix<BlasType>* A = nullptr;
+        MgParameters<BlasType> mgParams;
+        MgVector<BlasType> mgX;
+        MgVector<BlasType> mgB;
+        MgVector<BlasType> mgBuffer;
 
-        void build(FdmMgLinearSystem2* system, MgParameters<FdmBlas2> mgParams);
+        void build(const MgMatrix<BlasType>* A, const MgVector<BlasType>& x,
+                   MgParameters<BlasType> mgParams);
 
-        void solve(const FdmVector2& b, FdmVector2* x);
+        void solve(const typename BlasType::VectorType& b,
+                   typename BlasType::VectorType* x);
     };
 
     unsigned int _maxNumberOfIterations;
@@ -74,7 +83,23 @@ class FdmMgpcgSolver2 final : public FdmMgSolver2 {
     FdmVector2 _d;
     FdmVector2 _q;
     FdmVector2 _s;
-    Preconditioner _precond;
+    Preconditioner<FdmBlas2> _precond;
+
+    FdmVector2F _rF;
+    FdmVector2F _dF;
+    FdmVector2F _qF;
+    FdmVector2F _sF;
+    Preconditioner<FdmBlas2F> _precondF;
+
+    template <typename BlasType>
+    bool solveImpl(const MgMatrix<BlasType>* A, MgVector<BlasType>* x,
+                   MgVector<BlasType>* b,
+                   const MgParameters<BlasType>& mgParams,
+                   typename BlasType::VectorType* r,
+                   typename BlasType::VectorType* d,
+                   typename BlasType::VectorType* q,
+                   typename BlasType::VectorType* s,
+                   Preconditioner<BlasType>* precond);
 };
 
 //! Shared pointer type for the FdmMgpcgSolver2.
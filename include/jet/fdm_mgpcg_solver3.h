@@ -43,11 +43,14 @@ class FdmMgpcgSolver3 final : public FdmMgSolver3 {
     //! Solves the given linear system.
     bool solve(FdmMgLinearSystem3* system) override;
 
+    //! Solves the given single-precision linear system.
+    bool solve(FdmMgLinearSystem3F* system) override;
+
     //! Returns the max number of Jacobi iterations.
     unsigned int maxNumberOfIterations() const;
 
     //! Returns the last number of Jacobi iterations the solver made.
-    unsigned int lastNumberOfIterations() const;
+    unsigned int lastNumberOfIterations() const override;
 
     //! Returns the max residual tolerance for the Jacobi method.
     double tolerance() const;
@@ -56,13 +59,19 @@ class FdmMgpcgSolver3 final : public FdmMgSolver3 {
     double lastResidual() const;
 
  private:
+    template <typename BlasType>
     struct Preconditioner final {
-        FdmMgLinearSystem3* system;
-        MgParameters<FdmBlas3> mgParams;
+        const MgMatrix<BlasType>* A = nullptr;
+        MgParameters<BlasType> mgParams;
+        MgVector<BlasType> mgX;
+        MgVector<BlasType> mgB;
+        MgVector<BlasType> mgBuffer;
 
-        void build(FdmMgLinearSystem3* system, MgParameters<FdmBlas3> mgParams);
+        void build(const MgMatrix<BlasType>* A, const MgVector<BlasType>& x,
+                   MgParameters<BlasType> mgParams);
 
-        void solve(const FdmVector3& b, FdmVector3* x);
+        void solve(const typename BlasType::VectorType& b,
+                   typename BlasType::VectorType* x);
     };
 
     unsigned int _maxNumberOfIterations;
@@ -74,7 +83,23 @@ class FdmMgpcgSolver3 final : public FdmMgSolver3 {
     FdmVector3 _d;
     FdmVector3 _q;
     FdmVector3 _s;
-    Preconditioner _precond;
+    Preconditioner<FdmBlas3> _precond;
+
+    FdmVector3F _rF;
+    FdmVector3F _dF;
+    FdmVector3F _qF;
+    FdmVector3F _sF;
+    Preconditioner<FdmBlas3F> _precondF;
+
+    template <typename BlasType>
+    bool solveImpl(const MgMatrix<BlasType>* A, MgVector<BlasType>* x,
+                   MgVector<BlasType>* b,
+                   const MgParameters<BlasType>& mgParams,
+                   typename BlasType::VectorType* r,
+                   typename BlasType::VectorType* d,
+                   typename BlasType::VectorType* q,
+                   typename BlasType::VectorType* s,
+                   Preconditioner<BlasType>* precond);
 };
 
 //! Shared pointer type for the FdmMgpcgSolver3.
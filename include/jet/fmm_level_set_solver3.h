@@ -8,7 +8,10 @@
 #define INCLUDE_JET_FMM_LEVEL_SET_SOLVER3_H_
 
 #include <jet/level_set_solver3.h>
+#include <jet/point3.h>
+
 #include <memory>
+#include <vector>
 
 namespace jet {
 
@@ -40,6 +43,18 @@ class FmmLevelSetSolver3 final : public LevelSetSolver3 {
         double maxDistance,
         ScalarGrid3* outputSdf) override;
 
+    //!
+    //! Reinitializes given scalar field only within the narrow band.
+    //!
+    //! \param inputSdf Input signed-distance field which can be distorted.
+    //! \param bandWidth Half-width of the narrow band.
+    //! \param outputSdf Output signed-distance field.
+    //!
+    void reinitializeNarrowBand(
+        const ScalarGrid3& inputSdf,
+        double bandWidth,
+        ScalarGrid3* outputSdf) override;
+
     //!
     //! Extrapolates given scalar field from negative to positive SDF region.
     //!
@@ -85,6 +100,12 @@ class FmmLevelSetSolver3 final : public LevelSetSolver3 {
         FaceCenteredGrid3* output) override;
 
  private:
+    void reinitialize(
+        const ScalarGrid3& inputSdf,
+        double maxDistance,
+        const std::vector<Point3UI>* band,
+        ScalarGrid3* outputSdf);
+
     void extrapolate(
         const ConstArrayAccessor3<double>& input,
         const ConstArrayAccessor3<double>& sdf,
@@ -229,6 +229,15 @@ class GridFluidSolver3 : public PhysicsAnimation {
     //! Computes the advection term using the advection solver.
     virtual void computeAdvection(double timeIntervalInSeconds);
 
+    //!
+    //! \brief Advects the advectable scalar data at given index.
+    //!
+    //! This function is called by GridFluidSolver3::computeAdvection for each
+    //! advectable scalar data. By default, it advects the entire grid using
+    //! the advection solver and extrapolates the result into the collider.
+    //!
+    virtual void advectScalarData(size_t index, double timeIntervalInSeconds);
+
     //!
     //! \breif Returns the signed-distance representation of the fluid.
     //!
@@ -10,6 +10,7 @@
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/custom_vector_field3.h>
 #include <jet/grid_boundary_condition_solver3.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
 
 #include <memory>
 
@@ -21,7 +22,10 @@ namespace jet {
 //! This class constrains the velocity field by projecting the flow to the
 //! signed-distance field representation of the collider. This implementation
 //! should pair up with GridFractionalSinglePhasePressureSolver3 to provide
-//! sub-grid resolutional velocity projection.
+//! sub-grid resolutional velocity projection. The signed-distance field of
+//! the collider is a CellCenteredScalarGrid3. When there is no collider, it is
+//! a SparseCellCenteredScalarGrid3 with no active tile, so no memory is
+//! allocated for it.
 //!
 class GridFractionalBoundaryConditionSolver3
     : public GridBoundaryConditionSolver3 {
@@ -58,6 +62,7 @@ class GridFractionalBoundaryConditionSolver3
 
  private:
     CellCenteredScalarGrid3Ptr _colliderSdf;
+    SparseCellCenteredScalarGrid3Ptr _emptyColliderSdf;
     CustomVectorField3Ptr _colliderVel;
 };
 
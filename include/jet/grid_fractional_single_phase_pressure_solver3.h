@@ -8,6 +8,7 @@
 #define INCLUDE_JET_GRID_FRACTIONAL_SINGLE_PHASE_PRESSURE_SOLVER3_H_
 
 #include <jet/cell_centered_scalar_grid3.h>
+#include <jet/fdm_cg_solver3.h>
 #include <jet/fdm_linear_system_solver3.h>
 #include <jet/fdm_mg_linear_system3.h>
 #include <jet/fdm_mg_solver3.h>
@@ -99,12 +100,77 @@ class GridFractionalSinglePhasePressureSolver3 : public GridPressureSolver3 {
     //! Returns the pressure field.
     const FdmVector3& pressure() const;
 
+    //! Returns true if the pressure system is stored in single precision.
+    bool isUsingSinglePrecision() const;
+
+    //!
+    //! \brief Sets true to store the pressure system in single precision.
+    //!
+    //! The matrix and the vectors of the uncompressed system are built as
+    //! FdmLinearSystem3F and solved by float CG, which takes about 40% less
+    //! memory than the double system and its CG vectors. With a multigrid
+    //! solver (FdmMgSolver3 or FdmMgpcgSolver3), every level is built as
+    //! FdmMgLinearSystem3F and the cycle runs in float. Only the pressure
+    //! field is kept in double. It applies to these solvers, where the
+    //! compressed system is not used by CG; otherwise the double system is
+    //! built. Default is false.
+    //!
+    void setIsUsingSinglePrecision(bool isUsing);
+
+    //! Returns true if the solve starts from the last pressure.
+    bool isWarmStarting() const;
+
+    //!
+    //! \brief Sets true to start the solve from the last pressure.
+    //!
+    //! For smooth flows, the pressure of the last time step is close to the
+    //! new one, so the iterative linear system solver converges in fewer
+    //! iterations. The previous pressure is used only if the grid resolution
+    //! did not change. Default is false.
+    //!
+    void setIsWarmStarting(bool isWarmStarting);
+
+    //! Returns the number of iterations the linear system solver made in the
+    //! last solve.
+    unsigned int lastNumberOfIterations() const;
+
+    //!
+    //! \brief Returns the number of iterations saved by the warm start in
+    //!        the last solve.
+    //!
+    //! The saving is measured against the last solve that started from
+    //! zero, so it is an estimate that can be negative when the problem gets
+    //! harder over time. Returns zero if the last solve was not
+    //! warm-started.
+    //!
+    int lastNumberOfSavedIterations() const;
+
+    //! Returns true if the compressed system uses the compact stencil matrix.
+    bool isUsingStencilSystem() const;
+
+    //!
+    //! \brief Sets true to build the compressed system with the compact
+    //!        stencil matrix (FdmStencilLinearSystem3) instead of MatrixCsrD.
+    //!
+    //! The stencil matrix stores the coefficients in single precision and
+    //! takes a fraction of the memory of MatrixCsrD. It only applies when the
+    //! compressed system is used with a non-multigrid solver. Default is
+    //! false.
+    //!
+    void setIsUsingStencilSystem(bool isUsing);
+
  private:
     FdmLinearSystem3 _system;
     FdmCompressedLinearSystem3 _compSystem;
+    FdmStencilLinearSystem3 _stencilSystem;
+    bool _isUsingStencilSystem = false;
+    FdmLinearSystem3F _systemF;
+    bool _isUsingSinglePrecision = false;
     FdmLinearSystemSolver3Ptr _systemSolver;
+    FdmCgSolver3Ptr _cgSystemSolver;
 
     FdmMgLinearSystem3 _mgSystem;
+    FdmMgLinearSystem3F _mgSystemF;
     FdmMgSolver3Ptr _mgSystemSolver;
 
     std::vector<Array3<float>> _uWeights;
@@ -114,11 +180,22 @@ class GridFractionalSinglePhasePressureSolver3 : public GridPressureSolver3 {
 
     std::function<Vector3D(const Vector3D&)> _boundaryVel;
 
+    bool _isWarmStarting = false;
+    unsigned int _lastNumberOfIterations = 0;
+    unsigned int _coldStartNumberOfIterations = 0;
+    int _lastNumberOfSavedIterations = 0;
+
     void buildWeights(const FaceCenteredGrid3& input,
                       const ScalarField3& boundarySdf,
                       const VectorField3& boundaryVelocity,
                       const ScalarField3& fluidSdf);
 
+    bool isSolvingInSinglePrecision(bool useCompressed) const;
+
+    void solveSinglePrecision(bool isWarmStart);
+
+    void compressSolution();
+
     void decompressSolution();
 
     virtual void buildSystem(const FaceCenteredGrid3& input,
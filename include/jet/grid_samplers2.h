@@ -0,0 +1,130 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_GRID_SAMPLERS2_H_
+#define INCLUDE_JET_GRID_SAMPLERS2_H_
+
+#include <jet/array_samplers2.h>
+#include <jet/face_centered_grid2.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace jet {
+
+//!
+//! \brief 2-D linear sampler for the face-centered arrays.
+//!
+//! This class samples the u and v arrays of the face-centered (MAC) layout
+//! at once. Along each axis, the data points are either aligned with the
+//! cell faces normal to the axis or shifted by the half grid spacing, so the
+//! two components share the cell indices and weights per axis instead of
+//! computing them twice. The result is identical to sampling each array with
+//! LinearArraySampler2.
+//!
+//! \tparam T - The value type to sample.
+//! \tparam R - The real number type.
+//!
+template <typename T, typename R>
+class LinearFaceCenteredArraySampler2 final {
+ public:
+    static_assert(
+        std::is_floating_point<R>::value,
+        "Samplers only can be instantiated with floating point types");
+
+    //! Constructs an empty sampler.
+    LinearFaceCenteredArraySampler2() = default;
+
+    //!
+    //! \brief Constructs a sampler with the u and v arrays, the grid spacing,
+    //!        and the positions of the first elements of the arrays.
+    //!
+    LinearFaceCenteredArraySampler2(const ConstArrayAccessor2<T>& uAccessor,
+                                    const ConstArrayAccessor2<T>& vAccessor,
+                                    const Vector2<R>& gridSpacing,
+                                    const Vector2<R>& uOrigin,
+                                    const Vector2<R>& vOrigin);
+
+    //! Returns the sampled value at point \p pt.
+    Vector2<T> operator()(const Vector2<R>& pt) const;
+
+ private:
+    ConstArrayAccessor2<T> _uAccessor;
+    ConstArrayAccessor2<T> _vAccessor;
+    Vector2<R> _gridSpacing;
+
+    // Origins and sizes of the lattices aligned with the cell faces, which
+    // are (u.x, v.y), and the ones shifted by the half grid spacing, which
+    // are (v.x, u.y).
+    Vector2<R> _alignedOrigin;
+    Vector2<R> _shiftedOrigin;
+    Size2 _alignedSize;
+    Size2 _shiftedSize;
+};
+
+//!
+//! \brief 2-D statically-typed linear sampler for the collocated grids.
+//!
+//! Unlike ScalarGrid2::sample and CollocatedVectorGrid2::sample, which go
+//! through the virtual function and std::function, this sampler is resolved
+//! at compile time so the bilinear interpolation is inlined into the caller.
+//! It can be instantiated with the cell-centered and vertex-centered scalar
+//! and vector grids. The sampler keeps a reference to the grid data, so it
+//! becomes invalid if the grid is resized.
+//!
+//! \tparam GridType - The grid type.
+//!
+template <typename GridType>
+class LinearGridSampler2 final {
+ public:
+    //! The value type of the grid.
+    typedef typename std::decay<decltype(
+        std::declval<const GridType&>().constDataAccessor()(0, 0))>::type
+        ValueType;
+
+    //! Constructs an empty sampler.
+    LinearGridSampler2() = default;
+
+    //! Constructs a sampler for given grid.
+    explicit LinearGridSampler2(const GridType& grid);
+
+    //! Returns the sampled value at point \p pt.
+    ValueType operator()(const Vector2D& pt) const;
+
+ private:
+    LinearArraySampler2<ValueType, double> _sampler{
+        ConstArrayAccessor2<ValueType>(), Vector2D(1, 1), Vector2D()};
+};
+
+//!
+//! \brief 2-D statically-typed linear sampler for the face-centered grid.
+//!
+//! \see LinearFaceCenteredArraySampler2
+//!
+template <>
+class LinearGridSampler2<FaceCenteredGrid2> final {
+ public:
+    //! The value type of the grid.
+    typedef Vector2D ValueType;
+
+    //! Constructs an empty sampler.
+    LinearGridSampler2() = default;
+
+    //! Constructs a sampler for given grid.
+    explicit LinearGridSampler2(const FaceCenteredGrid2& grid);
+
+    //! Returns the sampled value at point \p pt.
+    Vector2D operator()(const Vector2D& pt) const;
+
+ private:
+    LinearFaceCenteredArraySampler2<double, double> _sampler;
+};
+
+}  // namespace jet
+
+#include "detail/grid_samplers2-inl.h"
+
+#endif  // INCLUDE_JET_GRID_SAMPLERS2_H_
@@ -0,0 +1,133 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_GRID_SAMPLERS3_H_
+#define INCLUDE_JET_GRID_SAMPLERS3_H_
+
+#include <jet/array_samplers3.h>
+#include <jet/face_centered_grid3.h>
+
+#include <type_traits>
+#include <utility>
+
+namespace jet {
+
+//!
+//! \brief 3-D linear sampler for the face-centered arrays.
+//!
+//! This class samples the u, v, and w arrays of the face-centered (MAC)
+//! layout at once. Along each axis, the data points are either aligned with
+//! the cell faces normal to the axis or shifted by the half grid spacing, so
+//! the three components share the two sets of cell indices and weights per
+//! axis instead of computing them three times. The result is identical to
+//! sampling each array with LinearArraySampler3.
+//!
+//! \tparam T - The value type to sample.
+//! \tparam R - The real number type.
+//!
+template <typename T, typename R>
+class LinearFaceCenteredArraySampler3 final {
+ public:
+    static_assert(
+        std::is_floating_point<R>::value,
+        "Samplers only can be instantiated with floating point types");
+
+    //! Constructs an empty sampler.
+    LinearFaceCenteredArraySampler3() = default;
+
+    //!
+    //! \brief Constructs a sampler with the u, v, and w arrays, the grid
+    //!        spacing, and the positions of the first elements of the arrays.
+    //!
+    LinearFaceCenteredArraySampler3(const ConstArrayAccessor3<T>& uAccessor,
+                                    const ConstArrayAccessor3<T>& vAccessor,
+                                    const ConstArrayAccessor3<T>& wAccessor,
+                                    const Vector3<R>& gridSpacing,
+                                    const Vector3<R>& uOrigin,
+                                    const Vector3<R>& vOrigin,
+                                    const Vector3<R>& wOrigin);
+
+    //! Returns the sampled value at point \p pt.
+    Vector3<T> operator()(const Vector3<R>& pt) const;
+
+ private:
+    ConstArrayAccessor3<T> _uAccessor;
+    ConstArrayAccessor3<T> _vAccessor;
+    ConstArrayAccessor3<T> _wAccessor;
+    Vector3<R> _gridSpacing;
+
+    // Origins and sizes of the lattices aligned with the cell faces, which
+    // are (u.x, v.y, w.z), and the ones shifted by the half grid spacing,
+    // which are (v.x, u.y, u.z).
+    Vector3<R> _alignedOrigin;
+    Vector3<R> _shiftedOrigin;
+    Size3 _alignedSize;
+    Size3 _shiftedSize;
+};
+
+//!
+//! \brief 3-D statically-typed linear sampler for the collocated grids.
+//!
+//! Unlike ScalarGrid3::sample and CollocatedVectorGrid3::sample, which go
+//! through the virtual function and std::function, this sampler is resolved
+//! at compile time so the trilinear interpolation is inlined into the
+//! caller. It can be instantiated with the cell-centered and vertex-centered
+//! scalar and vector grids. The sampler keeps a reference to the grid data,
+//! so it becomes invalid if the grid is resized.
+//!
+//! \tparam GridType - The grid type.
+//!
+template <typename GridType>
+class LinearGridSampler3 final {
+ public:
+    //! The value type of the grid.
+    typedef typename std::decay<decltype(
+        std::declval<const GridType&>().constDataAccessor()(0, 0, 0))>::type
+        ValueType;
+
+    //! Constructs an empty sampler.
+    LinearGridSampler3() = default;
+
+    //! Constructs a sampler for given grid.
+    explicit LinearGridSampler3(const GridType& grid);
+
+    //! Returns the sampled value at point \p pt.
+    ValueType operator()(const Vector3D& pt) const;
+
+ private:
+    LinearArraySampler3<ValueType, double> _sampler{
+        ConstArrayAccessor3<ValueType>(), Vector3D(1, 1, 1), Vector3D()};
+};
+
+//!
+//! \brief 3-D statically-typed linear sampler for the face-centered grid.
+//!
+//! \see LinearFaceCenteredArraySampler3
+//!
+template <>
+class LinearGridSampler3<FaceCenteredGrid3> final {
+ public:
+    //! The value type of the grid.
+    typedef Vector3D ValueType;
+
+    //! Constructs an empty sampler.
+    LinearGridSampler3() = default;
+
+    //! Constructs a sampler for given grid.
+    explicit LinearGridSampler3(const FaceCenteredGrid3& grid);
+
+    //! Returns the sampled value at point \p pt.
+    Vector3D operator()(const Vector3D& pt) const;
+
+ private:
+    LinearFaceCenteredArraySampler3<double, double> _sampler;
+};
+
+}  // namespace jet
+
+#include "detail/grid_samplers3-inl.h"
+
+#endif  // INCLUDE_JET_GRID_SAMPLERS3_H_
@@ -7,6 +7,7 @@
 #ifndef INCLUDE_JET_GRID_SINGLE_PHASE_PRESSURE_SOLVER2_H_
 #define INCLUDE_JET_GRID_SINGLE_PHASE_PRESSURE_SOLVER2_H_
 
+#include <jet/fdm_cg_solver2.h>
 #include <jet/fdm_linear_system_solver2.h>
 #include <jet/fdm_mg_linear_system2.h>
 #include <jet/fdm_mg_solver2.h>
@@ -90,21 +91,88 @@ class GridSinglePhasePressureSolver2 : public GridPressureSolver2 {
     //! Returns the pressure field.
     const FdmVector2& pressure() const;
 
+    //! Returns true if the pressure system is stored in single precision.
+    bool isUsingSinglePrecision() const;
+
+    //!
+    //! \brief Sets true to store the pressure system in single precision.
+    //!
+    //! The matrix and the vectors of the uncompressed system are built as
+    //! FdmLinearSystem2F and solved by float CG, which takes about 40% less
+    //! memory than the double system and its CG vectors. With a multigrid
+    //! solver (FdmMgSolver2 or FdmMgpcgSolver2), every level is built as
+    //! FdmMgLinearSystem2F and the cycle runs in float. Only the pressure
+    //! field is kept in double. It applies to these solvers, where the
+    //! compressed system is not used by CG; otherwise the double system is
+    //! built. Default is false.
+    //!
+    void setIsUsingSinglePrecision(bool isUsing);
+
+    //! Returns true if the solve starts from the last pressure.
+    bool isWarmStarting() const;
+
+    //!
+    //! \brief Sets true to start the solve from the last pressure.
+    //!
+    //! For smooth flows, the pressure of the last time step is close to the
+    //! new one, so the iterative linear system solver converges in fewer
+    //! iterations. The previous pressure is used only if the grid resolution
+    //! did not change. Default is false.
+    //!
+    void setIsWarmStarting(bool isWarmStarting);
+
+    //! Returns the number of iterations the linear system solver made in the
+    //! last solve.
+    unsigned int lastNumberOfIterations() const;
+
+    //!
+    //! \brief Returns the number of iterations saved by the warm start in
+    //!        the last solve.
+    //!
+    //! The saving is measured against the last solve that started from
+    //! zero, so it is an estimate that can be negative when the problem gets
+    //! harder over time. Returns zero if the last solve was not
+    //! warm-started.
+    //!
+    int lastNumberOfSavedIterations() const;
+
  private:
     FdmLinearSystem2 _system;
     FdmCompressedLinearSystem2 _compSystem;
+    FdmLinearSystem2F _systemF;
+    bool _isUsingSinglePrecision = false;
     FdmLinearSystemSolver2Ptr _systemSolver;
+    FdmCgSolver2Ptr _cgSystemSolver;
 
     FdmMgLinearSystem2 _mgSystem;
+    FdmMgLinearSystem2F _mgSystemF;
     FdmMgSolver2Ptr _mgSystemSolver;
 
     std::vector<Array2<char>> _markers;
 
+    bool _isWarmStarting = false;
+    unsigned int _lastNumberOfIterations = 0;
+    unsigned int _coldStartNumberOfIterations = 0;
+    int _lastNumberOfSavedIterations = 0;
+
+    // Finest markers and grid spacing of the last build, and the blocks of
+    // each level whose markers changed since then. Only the coarser markers
+    // and the matrix rows around the changed blocks are rebuilt.
+    Array2<char> _lastMarkers;
+    Vector2D _lastGridSpacing;
+    std::vector<Array2<char>> _dirtyBlocks;
+
     void buildMarkers(const Size2& size,
                       const std::function<Vector2D(size_t, size_t)>& pos,
                       const ScalarField2& boundarySdf,
                       const ScalarField2& fluidSdf);
 
+    bool isSolvingInSinglePrecision(bool useCompressed) const;
+
+    void solveSinglePrecision(bool isWarmStart);
+
+    void compressSolution();
+
     void decompressSolution();
 
     virtual void buildSystem(const FaceCenteredGrid2& input,
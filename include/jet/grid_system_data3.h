@@ -10,6 +10,7 @@
 #include <jet/face_centered_grid3.h>
 #include <jet/scalar_grid3.h>
 #include <jet/serialization.h>
+#include <jet/sparse_scalar_grid3.h>
 #include <memory>
 #include <vector>
 
@@ -21,7 +22,9 @@ namespace jet {
 //! This class is the key data structure for storing grid system data. To
 //! represent a grid system for fluid simulation, velocity field is defined as a
 //! face-centered (MAC) grid by default. It can also have additional scalar or
-//! vector attributes by adding extra data layer.
+//! vector attributes by adding extra data layer. Scalar layers that are mostly
+//! constant, such as a smoke density in a large domain, can be added as sparse
+//! layers which only store the tiles that differ from the background value.
 //!
 class GridSystemData3 : public Serializable {
  public:
@@ -169,6 +172,42 @@ class GridSystemData3 : public Serializable {
         const VectorGridBuilder3Ptr& builder,
         const Vector3D& initialVal = Vector3D());
 
+    //!
+    //! \brief      Adds a non-advectable sparse scalar data grid by passing
+    //!     its builder and background value.
+    //!
+    //! This function adds a new sparse scalar data grid. Only the tiles that
+    //! differ from the background value occupy memory. This layer is not
+    //! advectable, and is kept in a separate list from the dense scalar data.
+    //! For the future access of this layer, its index is returned.
+    //!
+    //! \param[in]  builder    The sparse grid builder.
+    //! \param[in]  background The background value.
+    //!
+    //! \return     Index of the data.
+    //!
+    size_t addSparseScalarData(
+        const SparseScalarGridBuilder3Ptr& builder,
+        double background = 0.0);
+
+    //!
+    //! \brief      Adds an advectable sparse scalar data grid by passing its
+    //!     builder and background value.
+    //!
+    //! This function adds a new sparse scalar data grid. Only the tiles that
+    //! differ from the background value occupy memory. This layer is
+    //! advectable, and is kept in a separate list from the dense scalar data.
+    //! For the future access of this layer, its index is returned.
+    //!
+    //! \param[in]  builder    The sparse grid builder.
+    //! \param[in]  background The background value.
+    //!
+    //! \return     Index of the data.
+    //!
+    size_t addAdvectableSparseScalarData(
+        const SparseScalarGridBuilder3Ptr& builder,
+        double background = 0.0);
+
     //!
     //! \brief      Returns the velocity field.
     //!
@@ -202,6 +241,12 @@ class GridSystemData3 : public Serializable {
     //! Returns the advectable vector data at given index.
     const VectorGrid3Ptr& advectableVectorDataAt(size_t idx) const;
 
+    //! Returns the non-advectable sparse scalar data at given index.
+    const SparseScalarGrid3Ptr& sparseScalarDataAt(size_t idx) const;
+
+    //! Returns the advectable sparse scalar data at given index.
+    const SparseScalarGrid3Ptr& advectableSparseScalarDataAt(size_t idx) const;
+
     //! Returns the number of non-advectable scalar data.
     size_t numberOfScalarData() const;
 
@@ -214,6 +259,12 @@ class GridSystemData3 : public Serializable {
     //! Returns the number of advectable vector data.
     size_t numberOfAdvectableVectorData() const;
 
+    //! Returns the number of non-advectable sparse scalar data.
+    size_t numberOfSparseScalarData() const;
+
+    //! Returns the number of advectable sparse scalar data.
+    size_t numberOfAdvectableSparseScalarData() const;
+
     //! Serialize the data to the given buffer.
     void serialize(std::vector<uint8_t>* buffer) const override;
 
@@ -231,6 +282,8 @@ class GridSystemData3 : public Serializable {
     std::vector<VectorGrid3Ptr> _vectorDataList;
     std::vector<ScalarGrid3Ptr> _advectableScalarDataList;
     std::vector<VectorGrid3Ptr> _advectableVectorDataList;
+    std::vector<SparseScalarGrid3Ptr> _sparseScalarDataList;
+    std::vector<SparseScalarGrid3Ptr> _advectableSparseScalarDataList;
 };
 
 //! Shared pointer type of GridSystemData3.
@@ -8,6 +8,9 @@
 #define INCLUDE_JET_ITERATIVE_LEVEL_SET_SOLVER3_H_
 
 #include <jet/level_set_solver3.h>
+#include <jet/point3.h>
+
+#include <vector>
 
 namespace jet {
 
@@ -40,6 +43,16 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
     void reinitialize(const ScalarGrid3& inputSdf, double maxDistance,
                       ScalarGrid3* outputSdf) override;
 
+    //!
+    //! Reinitializes given scalar field only within the narrow band.
+    //!
+    //! \param inputSdf Input signed-distance field which can be distorted.
+    //! \param bandWidth Half-width of the narrow band.
+    //! \param outputSdf Output signed-distance field.
+    //!
+    void reinitializeNarrowBand(const ScalarGrid3& inputSdf, double bandWidth,
+                                ScalarGrid3* outputSdf) override;
+
     //!
     //! Extrapolates given scalar field from negative to positive SDF region.
     //!
@@ -103,6 +116,10 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
                      const Vector3D& gridSpacing, double maxDistance,
                      ArrayAccessor3<double> output);
 
+    double reinitializeAt(const ConstArrayAccessor3<double>& sdf,
+                          const Vector3D& gridSpacing, double dtau, size_t i,
+                          size_t j, size_t k) const;
+
     static unsigned int distanceToNumberOfIterations(double distance,
                                                      double dtau);
 
@@ -112,6 +129,10 @@ class IterativeLevelSetSolver3 : public LevelSetSolver3 {
 
     double pseudoTimeStep(ConstArrayAccessor3<double> sdf,
                           const Vector3D& gridSpacing);
+
+    double pseudoTimeStep(ConstArrayAccessor3<double> sdf,
+                          const Vector3D& gridSpacing,
+                          const std::vector<Point3UI>& band);
 };
 
 typedef std::shared_ptr<IterativeLevelSetSolver3> IterativeLevelSetSolver3Ptr;
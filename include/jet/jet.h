@@ -8,6 +8,7 @@
 #define INCLUDE_JET_JET_H_
 #include <jet/advection_solver2.h>
 #include <jet/advection_solver3.h>
+#include <jet/amg.h>
 #include <jet/animation.h>
 #include <jet/anisotropic_points_to_implicit2.h>
 #include <jet/anisotropic_points_to_implicit3.h>
@@ -65,7 +66,11 @@
 #include <jet/eno_level_set_solver3.h>
 #include <jet/face_centered_grid2.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/fast_sweeping_level_set_solver2.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
 #include <jet/fcc_lattice_point_generator.h>
+#include <jet/fdm_amgpcg_solver2.h>
+#include <jet/fdm_amgpcg_solver3.h>
 #include <jet/fdm_cg_solver2.h>
 #include <jet/fdm_cg_solver3.h>
 #include <jet/fdm_gauss_seidel_solver2.h>
@@ -118,6 +123,8 @@
 #include <jet/grid_point_generator3.h>
 #include <jet/grid_pressure_solver2.h>
 #include <jet/grid_pressure_solver3.h>
+#include <jet/grid_samplers2.h>
+#include <jet/grid_samplers3.h>
 #include <jet/grid_single_phase_pressure_solver2.h>
 #include <jet/grid_single_phase_pressure_solver3.h>
 #include <jet/grid_smoke_solver2.h>
@@ -143,6 +150,8 @@
 #include <jet/list_query_engine2.h>
 #include <jet/list_query_engine3.h>
 #include <jet/logging.h>
+#include <jet/mac_cormack_advection2.h>
+#include <jet/mac_cormack_advection3.h>
 #include <jet/macros.h>
 #include <jet/marching_cubes.h>
 #include <jet/math_utils.h>
@@ -193,11 +202,13 @@
 #include <jet/point_simple_list_searcher3.h>
 #include <jet/points_to_implicit2.h>
 #include <jet/points_to_implicit3.h>
+#include <jet/profiler.h>
 #include <jet/quadtree.h>
 #include <jet/quaternion.h>
 #include <jet/ray.h>
 #include <jet/ray2.h>
 #include <jet/ray3.h>
+#include <jet/reducers.h>
 #include <jet/rigid_body_collider2.h>
 #include <jet/rigid_body_collider3.h>
 #include <jet/samplers.h>
@@ -205,6 +216,7 @@
 #include <jet/scalar_field3.h>
 #include <jet/scalar_grid2.h>
 #include <jet/scalar_grid3.h>
+#include <jet/scratch_arena.h>
 #include <jet/semi_lagrangian2.h>
 #include <jet/semi_lagrangian3.h>
 #include <jet/serial.h>
@@ -212,6 +224,10 @@
 #include <jet/size.h>
 #include <jet/size2.h>
 #include <jet/size3.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
+#include <jet/sparse_face_centered_grid3.h>
+#include <jet/sparse_scalar_grid3.h>
+#include <jet/sparse_vertex_centered_scalar_grid3.h>
 #include <jet/sph_kernels2.h>
 #include <jet/sph_kernels3.h>
 #include <jet/sph_points_to_implicit2.h>
@@ -231,6 +247,7 @@
 #include <jet/surface_to_implicit2.h>
 #include <jet/surface_to_implicit3.h>
 #include <jet/svd.h>
+#include <jet/tiled_array3.h>
 #include <jet/timer.h>
 #include <jet/transform2.h>
 #include <jet/transform3.h>
@@ -72,11 +72,12 @@ class KdTree final {
     //!
     //! \param[in]  origin   The origin position.
     //! \param[in]  radius   The search radius.
-    //! \param[in]  callback The callback function.
+    //! \param[in]  callback The callback function with the signature of
+    //!                      void(size_t, const Point&).
     //!
-    void forEachNearbyPoint(
-        const Point& origin, T radius,
-        const std::function<void(size_t, const Point&)>& callback) const;
+    template <typename Callback>
+    void forEachNearbyPoint(const Point& origin, T radius,
+                            const Callback& callback) const;
 
     //!
     //! Returns true if there are any nearby points for given origin within
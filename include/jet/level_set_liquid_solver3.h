@@ -51,6 +51,21 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3 {
     //! Sets minimum reinitialization distance.
     void setMinReinitializeDistance(double distance);
 
+    //! Returns the narrow band half-width in number of grid cells.
+    double narrowBandWidth() const;
+
+    //!
+    //! \brief Sets the narrow band half-width in number of grid cells.
+    //!
+    //! When \p width is positive, the level set is advected, reinitialized,
+    //! and used for velocity extrapolation only within the band around the
+    //! zero level set, and the values outside the band are clamped to
+    //! +/- band width. The effective band is widened to cover at least the
+    //! distance the front can travel in a time-step plus two cells. Zero,
+    //! which is the default, disables the narrow band.
+    //!
+    void setNarrowBandWidth(double width);
+
     //!
     //! \brief Enables (or disables) global compensation feature flag.
     //!
@@ -86,6 +101,9 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3 {
     //! Customizes advection step.
     void computeAdvection(double timeIntervalInSeconds) override;
 
+    //! Advects the level set only within the band if the band is enabled.
+    void advectScalarData(size_t index, double timeIntervalInSeconds) override;
+
     //!
     //! \brief Returns fluid region as a signed-distance field.
     //!
@@ -99,11 +117,14 @@ class LevelSetLiquidSolver3 : public GridFluidSolver3 {
     size_t _signedDistanceFieldId;
     LevelSetSolver3Ptr _levelSetSolver;
     double _minReinitializeDistance = 10.0;
+    double _narrowBandWidth = 0.0;
     bool _isGlobalCompensationEnabled = false;
     double _lastKnownVolume = 0.0;
 
     void reinitialize(double currentCfl);
 
+    double bandWidth(double currentCfl) const;
+
     void extrapolateVelocityToAir(double currentCfl);
 
     void addVolume(double volDiff);
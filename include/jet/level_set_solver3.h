@@ -35,6 +35,24 @@ class LevelSetSolver3 {
         double maxDistance,
         ScalarGrid3* outputSdf) = 0;
 
+    //!
+    //! \brief Reinitializes given scalar field within the narrow band.
+    //!
+    //! This function reinitializes the data points whose |input| is less than
+    //! or equal to \p bandWidth, and clamps the rest of the output to
+    //! [-bandWidth, bandWidth]. The default implementation reinitializes the
+    //! entire grid up to \p bandWidth and clamps the result, while the solvers
+    //! that support the narrow band only visit the data points in the band.
+    //!
+    //! \param inputSdf Input signed-distance field which can be distorted.
+    //! \param bandWidth Half-width of the narrow band.
+    //! \param outputSdf Output signed-distance field.
+    //!
+    virtual void reinitializeNarrowBand(
+        const ScalarGrid3& inputSdf,
+        double bandWidth,
+        ScalarGrid3* outputSdf);
+
     //!
     //! Extrapolates given scalar field from negative to positive SDF region.
     //!
@@ -13,6 +13,17 @@
 
 namespace jet {
 
+//!
+//! Minimum logging level compiled into the binary.
+//!
+//! The logs below this level are compiled out, which can be set with
+//! JET_MIN_LOGGING_LEVEL CMake option. The value is the integer value of the
+//! LoggingLevel, so that 0 keeps all the logs and 5 removes them all.
+//!
+#ifndef JET_MIN_LOGGING_LEVEL
+#define JET_MIN_LOGGING_LEVEL 0
+#endif
+
 //! Level of the logging.
 //! All < Debug < Info < Warn < Error < Off.
 enum class LoggingLevel : uint8_t {
@@ -28,7 +39,10 @@ enum class LoggingLevel : uint8_t {
 //! \brief Super simple logger implementation.
 //!
 //! This is a super simple logger implementation that has minimal logging
-//! capability. Currently, the class doesn't support multi-thread logging.
+//! capability. The message is written when the logger is destroyed, either
+//! directly to the stream or through the asynchronous sink (see
+//! Logging::setAsync). Prefer JET_INFO and the other macros which skip
+//! formatting the message if the level is disabled.
 //!
 class Logger final {
  public:
@@ -74,11 +88,45 @@ class Logging {
     //! Sets the logging level.
     static void setLevel(LoggingLevel level);
 
+    //! Returns true if the logs of given level are written.
+    static bool isEnabled(LoggingLevel level);
+
     //! Mutes the logger.
     static void mute();
 
     //! Un-mutes the logger.
     static void unmute();
+
+    //!
+    //! \brief Enables or disables the asynchronous sink.
+    //!
+    //! When enabled, each thread queues its messages into its own lock-free
+    //! buffer and a background thread writes them to the streams, so logging
+    //! threads never wait for the stream or for each other. The messages of a
+    //! single thread are written in order. Disabling the sink writes out the
+    //! queued messages and stops the background thread. The sink is disabled
+    //! by default.
+    //!
+    static void setAsync(bool isAsync);
+
+    //! Returns true if the asynchronous sink is enabled.
+    static bool isAsync();
+
+    //!
+    //! \brief Writes out the messages queued in the asynchronous sink.
+    //!
+    //! The messages logged by other threads while flushing may not be written
+    //! out. The stream setters flush before changing the streams, but a
+    //! stream that is about to be destroyed should be flushed (or the sink
+    //! disabled) explicitly.
+    //!
+    static void flush();
+};
+
+//! Turns a logger expression into void for the logging macros.
+struct LoggerVoidify {
+    //! Discards the logger expression.
+    void operator&(const Logger&) const {}
 };
 
 //! Info-level logger.
@@ -93,19 +141,28 @@ extern Logger errorLogger;
 //! Debug-level logger.
 extern Logger debugLogger;
 
-#define JET_INFO \
-    (Logger(LoggingLevel::Info) << Logging::getHeader(LoggingLevel::Info) \
-     << "[" << __FILE__ << ":" << __LINE__ << " (" << __func__ << ")] ")
-#define JET_WARN \
-    (Logger(LoggingLevel::Warn) << Logging::getHeader(LoggingLevel::Warn) \
-     << "[" << __FILE__ << ":" << __LINE__ << " (" << __func__ << ")] ")
-#define JET_ERROR \
-    (Logger(LoggingLevel::Error) << Logging::getHeader(LoggingLevel::Error) \
-     << "[" << __FILE__ << ":" << __LINE__ << " (" << __func__ << ")] ")
-#define JET_DEBUG \
-    (Logger(LoggingLevel::Debug) << Logging::getHeader(LoggingLevel::Debug) \
-     << "[" << __FILE__ << ":" << __LINE__ << " (" << __func__ << ")] ")
-
 }  // namespace jet
 
+//! Returns true if the logs of given level are compiled in and enabled.
+#define JET_LOG_IS_ON(level)                             \
+    (static_cast<int>(level) >= JET_MIN_LOGGING_LEVEL && \
+     ::jet::Logging::isEnabled(level))
+
+//!
+//! Logs with given level. The stream arguments are not evaluated if the level
+//! is disabled.
+//!
+#define JET_LOG(level)                                                     \
+    !JET_LOG_IS_ON(level)                                                  \
+        ? (void)0                                                          \
+        : ::jet::LoggerVoidify() &                                         \
+              ::jet::Logger(level)                                         \
+                  << ::jet::Logging::getHeader(level) << "[" << __FILE__   \
+                  << ":" << __LINE__ << " (" << __func__ << ")] "
+
+#define JET_INFO JET_LOG(::jet::LoggingLevel::Info)
+#define JET_WARN JET_LOG(::jet::LoggingLevel::Warn)
+#define JET_ERROR JET_LOG(::jet::LoggingLevel::Error)
+#define JET_DEBUG JET_LOG(::jet::LoggingLevel::Debug)
+
 #endif  // INCLUDE_JET_LOGGING_H_
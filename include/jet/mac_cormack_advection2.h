@@ -0,0 +1,128 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_MAC_CORMACK_ADVECTION2_H_
+#define INCLUDE_JET_MAC_CORMACK_ADVECTION2_H_
+
+#include <jet/advection_solver2.h>
+#include <jet/array2.h>
+#include <limits>
+
+namespace jet {
+
+//!
+//! \brief Implementation of 2-D MacCormack advection solver.
+//!
+//! This class implements the modified MacCormack scheme from Selle et al.
+//! The forward semi-Lagrangian step is traced back in time, and its result is
+//! traced forward again to estimate the error of the forward step, which
+//! corrects the result by the half of the error (the same correction BFECC
+//! makes with one less interpolation). The result is clamped to the range of
+//! the data points that the forward step interpolates, so the scheme is
+//! second-order accurate in smooth regions and does not create new extrema.
+//! Both passes run in parallel, and the intermediate data are kept between
+//! the calls so the advection does not allocate memory every time step.
+//!
+//! \see A. Selle, R. Fedkiw, B. Kim, Y. Liu, and J. Rossignac. An
+//!      unconditionally stable MacCormack method. Journal of Scientific
+//!      Computing, 35(2-3):350-371, 2008.
+//!
+class MacCormackAdvection2 final : public AdvectionSolver2 {
+ public:
+    //! Constructs the solver.
+    MacCormackAdvection2();
+
+    //!
+    //! \brief Computes MacCormack advection for given scalar grid.
+    //!
+    //! This function solves advection equation for given scalar field
+    //! \p input and underlying vector field \p flow that carries the input
+    //! field. The solution after solving the equation for given time-step
+    //! \p dt is stored in scalar field \p output. The boundary interface is
+    //! given by a signed-distance field. The field is negative inside the
+    //! boundary. By default, a constant field with max double value (kMaxD)
+    //! is used, meaning no boundary.
+    //!
+    //! \param input Input scalar grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param output Output scalar grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(const ScalarGrid2& input, const VectorField2& flow, double dt,
+                ScalarGrid2* output,
+                const ScalarField2& boundarySdf = ConstantScalarField2(
+                    std::numeric_limits<double>::max())) override;
+
+    //!
+    //! \brief Computes MacCormack advection for given collocated vector grid.
+    //!
+    //! \param input Input vector grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param output Output vector grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(const CollocatedVectorGrid2& input, const VectorField2& flow,
+                double dt, CollocatedVectorGrid2* output,
+                const ScalarField2& boundarySdf = ConstantScalarField2(
+                    std::numeric_limits<double>::max())) override;
+
+    //!
+    //! \brief Computes MacCormack advection for given face-centered vector
+    //!        grid.
+    //!
+    //! \param input Input vector grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param output Output vector grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(const FaceCenteredGrid2& input, const VectorField2& flow,
+                double dt, FaceCenteredGrid2* output,
+                const ScalarField2& boundarySdf = ConstantScalarField2(
+                    std::numeric_limits<double>::max())) override;
+
+    //! Returns true if the result is clamped by the limiter.
+    bool isClamping() const;
+
+    //!
+    //! \brief Sets true to clamp the result by the limiter.
+    //!
+    //! Without the limiter, the scheme may create new extrema near
+    //! discontinuities, which can grow over the time-steps when the CFL
+    //! number is large. The limiter is on by default.
+    //!
+    void setIsClamping(bool isClamping);
+
+ private:
+    // Forward step result and its bounds for a single array.
+    template <typename T>
+    struct ForwardStep {
+        Array2<T> values;
+        Array2<T> lower;
+        Array2<T> upper;
+    };
+
+    bool _isClamping = true;
+
+    // One set per advected array, so each keeps its size across the calls
+    // and the arrays are allocated only once.
+    ForwardStep<double> _scalarStep;
+    ForwardStep<Vector2D> _vectorStep;
+    ForwardStep<double> _uStep;
+    ForwardStep<double> _vStep;
+};
+
+//! Shared pointer type for the MacCormackAdvection2.
+typedef std::shared_ptr<MacCormackAdvection2> MacCormackAdvection2Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_MAC_CORMACK_ADVECTION2_H_
@@ -54,6 +54,18 @@ using MgCorrectFunc =
     std::function<void(const typename BlasType::VectorType& coarser,
                        typename BlasType::VectorType* finer)>;
 
+//! Multigrid cycle type.
+enum class MgCycleType {
+    //! Visits each coarser level once per cycle.
+    kV,
+
+    //! Visits each coarser level twice per cycle.
+    kW,
+
+    //! Recurses with an F-cycle and then a V-cycle on each coarser level.
+    kF
+};
+
 //! Multigrid input parameter set.
 template <typename BlasType>
 struct MgParameters {
@@ -81,6 +93,15 @@ struct MgParameters {
     //! Correction function that maps coarser to finer grid.
     MgCorrectFunc<BlasType> correctFunc;
 
+    //!
+    //! Solver for the coarsest level such as CG. If not set, relaxFunc is
+    //! invoked numberOfCoarsestIter times instead.
+    //!
+    MgRelaxFunc<BlasType> coarsestSolveFunc;
+
+    //! Cycle type used by mgCycle.
+    MgCycleType cycleType = MgCycleType::kV;
+
     //! Max error tolerance.
     double maxTolerance = 1e-9;
 };
@@ -101,6 +122,19 @@ template <typename BlasType>
 MgResult mgVCycle(const MgMatrix<BlasType>& A, MgParameters<BlasType> params,
                   MgVector<BlasType>* x, MgVector<BlasType>* b,
                   MgVector<BlasType>* buffer);
+
+//!
+//! \brief Performs Multigrid with the cycle type from the parameters.
+//!
+//! For given linear system matrix \p A and RHS vector \p b, this function
+//! computes the solution \p x using Multigrid method with V-, W-, or F-cycle
+//! as specified by MgParameters::cycleType.
+//!
+template <typename BlasType>
+MgResult mgCycle(const MgMatrix<BlasType>& A, MgParameters<BlasType> params,
+                 MgVector<BlasType>* x, MgVector<BlasType>* b,
+                 MgVector<BlasType>* buffer);
+
 }  // namespace jet
 
 #include "detail/mg-inl.h"
@@ -0,0 +1,93 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_NEIGHBOR_LISTS_H_
+#define INCLUDE_JET_NEIGHBOR_LISTS_H_
+
+#include <jet/array_accessor1.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Compact neighbor lists.
+//!
+//! This class stores the neighbor lists of all the points in compressed sparse
+//! row (CSR) format. The neighbor indices of every point are packed into a
+//! single flat array of 32-bit indices, and the offset table points to the
+//! beginning of each point's range. Compared to std::vector of std::vector,
+//! this layout requires only two allocations and keeps the neighbors of
+//! consecutive points next to each other in memory.
+//!
+class NeighborLists final {
+ public:
+    //! Constructs empty neighbor lists.
+    NeighborLists();
+
+    //! Returns the number of lists (points).
+    size_t size() const;
+
+    //! Returns true if there are no lists.
+    bool empty() const;
+
+    //! Returns the total number of neighbors stored in all the lists.
+    size_t numberOfNeighbors() const;
+
+    //! Returns the number of neighbors of i-th point.
+    size_t numberOfNeighbors(size_t i) const;
+
+    //! Returns the neighbor list of i-th point.
+    ConstArrayAccessor1<uint32_t> operator[](size_t i) const;
+
+    //! Returns the offset table whose size is size() + 1.
+    const std::vector<size_t>& offsets() const;
+
+    //! Returns the flat neighbor index array.
+    const std::vector<uint32_t>& indices() const;
+
+    //! Removes all the lists.
+    void clear();
+
+    //!
+    //! \brief Builds the lists from the neighbor pairs.
+    //!
+    //! This function builds the lists with two passes over the neighbor pairs.
+    //! The first pass counts the neighbors of each point, and the offsets are
+    //! computed from the counts. The second pass writes the neighbor indices
+    //! into the flat array. \p forEachPair is invoked once per pass with a
+    //! visitor of signature void(size_t i, size_t j) which should be called
+    //! for every neighbor j of point i, in the same order for both passes.
+    //! The visitor may be called concurrently for different i, but all calls
+    //! for the same i must come from a single thread.
+    //!
+    //! \param[in]  numberOfPoints The number of points.
+    //! \param[in]  forEachPair    The function that enumerates the pairs.
+    //!
+    template <typename ForEachPairFunc>
+    void build(size_t numberOfPoints, const ForEachPairFunc& forEachPair);
+
+    //!
+    //! \brief Sets the lists from the CSR data.
+    //!
+    //! \param[in]  offsets The offset table whose size is the number of lists
+    //!                     plus one. The first element must be zero.
+    //! \param[in]  indices The flat neighbor index array.
+    //!
+    void set(const std::vector<size_t>& offsets,
+             const std::vector<uint32_t>& indices);
+
+ private:
+    std::vector<size_t> _offsets;
+    std::vector<uint32_t> _indices;
+};
+
+}  // namespace jet
+
+#include "detail/neighbor_lists-inl.h"
+
+#endif  // INCLUDE_JET_NEIGHBOR_LISTS_H_
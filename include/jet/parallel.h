@@ -202,6 +202,33 @@ Value parallelReduce(IndexType beginIndex, IndexType endIndex,
                      const Reduce& reduce,
                      ExecutionPolicy policy = ExecutionPolicy::kParallel);
 
+//!
+//! \brief      Performs reduce operation in parallel with deterministic result.
+//!
+//! Unlike parallelReduce, the range is split into chunks that depend only on
+//! the size of the range, and the chunk results are reduced in the index order
+//! as reduce(earlier, later). Therefore the result is the same regardless of
+//! the number of threads and the execution policy, even if the reduce
+//! operator is not associative as in the floating-point summation.
+//!
+//! \param[in]  beginIndex The begin index.
+//! \param[in]  endIndex   The end index.
+//! \param[in]  identity   Identity value for the reduce operation.
+//! \param[in]  function   The function for reducing subrange.
+//! \param[in]  reduce     The reduce operator.
+//! \param[in]  policy     The execution policy (parallel or serial).
+//!
+//! \tparam     IndexType  Index type.
+//! \tparam     Value      Value type.
+//! \tparam     Function   Reduce function type.
+//!
+template <typename IndexType, typename Value, typename Function,
+          typename Reduce>
+Value parallelDeterministicReduce(
+    IndexType beginIndex, IndexType endIndex, const Value& identity,
+    const Function& func, const Reduce& reduce,
+    ExecutionPolicy policy = ExecutionPolicy::kParallel);
+
 //!
 //! \brief      Sorts a container in parallel.
 //!
@@ -237,7 +264,13 @@ void parallelSort(RandomIterator begin, RandomIterator end,
                   CompareFunction compare,
                   ExecutionPolicy policy = ExecutionPolicy::kParallel);
 
-//! Sets maximum number of threads to use.
+//!
+//! \brief      Sets maximum number of threads to use.
+//!
+//! With the C++11 threads tasking system, this function also resizes the
+//! persistent thread pool, so it should not be called while a parallel
+//! function is running.
+//!
 void setMaxNumberOfThreads(unsigned int numThreads);
 
 //! Returns maximum number of threads to use.
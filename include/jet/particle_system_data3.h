@@ -8,8 +8,11 @@
 #define INCLUDE_JET_PARTICLE_SYSTEM_DATA3_H_
 
 #include <jet/array1.h>
+#include <jet/neighbor_lists.h>
 #include <jet/serialization.h>
+#include <jet/soa_vector_array3.h>
 #include <jet/point_neighbor_searcher3.h>
+#include <jet/point_parallel_hash_grid_searcher3.h>
 
 #include <memory>
 #include <vector>
@@ -198,18 +201,125 @@ class ParticleSystemData3 : public Serializable {
     //!
     //! This function returns neighbor lists which is available after calling
     //! PointParallelHashGridSearcher3::buildNeighborLists. Each list stores
-    //! indices of the neighbors.
+    //! indices of the neighbors. The lists are stored in a single flat array,
+    //! see NeighborLists for the layout.
     //!
     //! \return     Neighbor lists.
     //!
-    const std::vector<std::vector<size_t>>& neighborLists() const;
+    const NeighborLists& neighborLists() const;
 
     //! Builds neighbor searcher with given search radius.
     void buildNeighborSearcher(double maxSearchRadius);
 
+    //!
+    //! \brief Invokes the callback function for each nearby particle around
+    //!        the origin within given radius.
+    //!
+    //! This function forwards the query to the current neighbor searcher. If
+    //! the searcher is a PointParallelHashGridSearcher3, which is the default, the
+    //! callback is inlined into the search loop instead of going through the
+    //! virtual interface and std::function.
+    //!
+    //! \param[in]  origin   The origin position.
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function with the signature of
+    //!                      void(size_t, const Vector3D&).
+    //!
+    template <typename Callback>
+    void forEachNearbyPoint(
+        const Vector3D& origin,
+        double radius,
+        const Callback& callback) const;
+
+    //!
+    //! \brief Invokes the callback function for each pair of a particle and
+    //!        its nearby particles within given radius.
+    //!
+    //! The callback has the signature of void(size_t i, size_t j,
+    //! const Vector3D& xj) where i is the index of the particle, and j and xj are
+    //! the index and position of the nearby particle (including i itself).
+    //! The positions are the ones used for building the neighbor searcher.
+    //! Calls for different particles may run concurrently, but all calls for
+    //! the same particle are made from a single thread.
+    //!
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function.
+    //!
+    template <typename Callback>
+    void parallelForEachNearbyPoint(
+        double radius, const Callback& callback) const;
+
     //! Builds neighbor lists with given search radius.
     void buildNeighborLists(double maxSearchRadius);
 
+    //!
+    //! \brief Reorders the particles with given permutation.
+    //!
+    //! After reordering, the i-th particle is the one that was at order[i]
+    //! before the call. Every scalar and vector data, including positions,
+    //! velocities, and forces, is permuted. The neighbor searcher is rebuilt
+    //! with the new positions, and the neighbor lists are cleared, so call
+    //! buildNeighborLists again if needed.
+    //!
+    //! \param[in]  order The permutation of the particle indices.
+    //!
+    void reorderParticles(const std::vector<size_t>& order);
+
+    //!
+    //! \brief Sorts the particles by their hash grid cells.
+    //!
+    //! This function reorders the particles so that particles in the same or
+    //! adjacent cells are stored close to each other, which improves the cache
+    //! locality of the neighbor search and the particle-grid transfer. If the
+    //! current neighbor searcher is a PointParallelHashGridSearcher3 that holds the same
+    //! number of points as this particle system, its sorted order is reused.
+    //! Otherwise, a temporary searcher with the grid spacing of 2 * radius()
+    //! is built. See reorderParticles for the side effects.
+    //!
+    void sortParticles();
+
+    //!
+    //! \brief Returns the permutation of the last reordering.
+    //!
+    //! The i-th particle after the last call of reorderParticles or
+    //! sortParticles is the one that was at lastParticleOrder()[i] before the
+    //! call. Use this to keep external per-particle arrays in sync.
+    //!
+    const std::vector<size_t>& lastParticleOrder() const;
+
+    //! Returns true if the SoA copies of the positions and velocities are kept.
+    bool isUsingSoaLayout() const;
+
+    //!
+    //! \brief Enables or disables the SoA copies of the positions and
+    //!        velocities.
+    //!
+    //! When enabled, soaPositions() and soaVelocities() provide the positions
+    //! and velocities in structure-of-arrays layout so that the solvers can
+    //! run vectorized kernels on them. The AoS data such as positions() stay
+    //! the primary storage; the copies are refreshed by updateSoaLayout(),
+    //! which is also called by buildNeighborLists(). Enabling the layout
+    //! refreshes the copies immediately, and disabling it releases them.
+    //!
+    //! \param[in]  isUsing True to keep the SoA copies.
+    //!
+    void setIsUsingSoaLayout(bool isUsing);
+
+    //! Returns the SoA copy of the positions.
+    const SoaVectorArray3& soaPositions() const;
+
+    //! Returns the SoA copy of the velocities.
+    const SoaVectorArray3& soaVelocities() const;
+
+    //!
+    //! \brief Copies the current positions and velocities to the SoA arrays.
+    //!
+    //! Call this function after changing the positions or velocities outside
+    //! of buildNeighborLists() if the SoA copies are used. Does nothing if the
+    //! SoA layout is disabled.
+    //!
+    void updateSoaLayout();
+
     //! Serializes this particle system data to the buffer.
     void serialize(std::vector<uint8_t>* buffer) const override;
 
@@ -243,7 +353,14 @@ class ParticleSystemData3 : public Serializable {
     std::vector<VectorData> _vectorDataList;
 
     PointNeighborSearcher3Ptr _neighborSearcher;
-    std::vector<std::vector<size_t>> _neighborLists;
+    const PointParallelHashGridSearcher3* _parallelHashGridSearcher = nullptr;
+    NeighborLists _neighborLists;
+    std::vector<size_t> _lastParticleOrder;
+    bool _isUsingSoaLayout = false;
+    SoaVectorArray3 _soaPositions;
+    SoaVectorArray3 _soaVelocities;
+
+    void onNeighborSearcherChanged();
 };
 
 //! Shared pointer type of ParticleSystemData3.
@@ -251,4 +368,6 @@ typedef std::shared_ptr<ParticleSystemData3> ParticleSystemData3Ptr;
 
 }  // namespace jet
 
+#include "detail/particle_system_data3-inl.h"
+
 #endif  // INCLUDE_JET_PARTICLE_SYSTEM_DATA3_H_
@@ -111,6 +111,19 @@ class ParticleSystemSolver2 : public PhysicsAnimation {
     //!
     void setWind(const VectorField2Ptr& newWind);
 
+    //!
+    //! \brief Returns the number of time-steps between particle sorting.
+    //!
+    //! If the interval is greater than zero, the particles are sorted by their
+    //! hash grid cells (see ParticleSystemData2::sortParticles) every
+    //! interval-th time-step, right after the emitter is updated. Zero, which
+    //! is the default, disables the sorting.
+    //!
+    unsigned int particleSortingInterval() const;
+
+    //! Sets the number of time-steps between particle sorting.
+    void setParticleSortingInterval(unsigned int newInterval);
+
     //! Returns builder fox ParticleSystemSolver2.
     static Builder builder();
 
@@ -153,6 +166,8 @@ class ParticleSystemSolver2 : public PhysicsAnimation {
     Collider2Ptr _collider;
     ParticleEmitter2Ptr _emitter;
     VectorField2Ptr _wind;
+    unsigned int _particleSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSorting = 0;
 
     void beginAdvanceTimeStep(double timeStepInSeconds);
 
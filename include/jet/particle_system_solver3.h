@@ -111,6 +111,19 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     //!
     void setWind(const VectorField3Ptr& newWind);
 
+    //!
+    //! \brief Returns the number of time-steps between particle sorting.
+    //!
+    //! If the interval is greater than zero, the particles are sorted by their
+    //! hash grid cells (see ParticleSystemData3::sortParticles) every
+    //! interval-th time-step, right after the emitter is updated. Zero, which
+    //! is the default, disables the sorting.
+    //!
+    unsigned int particleSortingInterval() const;
+
+    //! Sets the number of time-steps between particle sorting.
+    void setParticleSortingInterval(unsigned int newInterval);
+
     //! Returns builder fox ParticleSystemSolver3.
     static Builder builder();
 
@@ -153,6 +166,8 @@ class ParticleSystemSolver3 : public PhysicsAnimation {
     Collider3Ptr _collider;
     ParticleEmitter3Ptr _emitter;
     VectorField3Ptr _wind;
+    unsigned int _particleSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSorting = 0;
 
     void beginAdvanceTimeStep(double timeStepInSeconds);
 
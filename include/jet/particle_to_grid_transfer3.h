@@ -0,0 +1,121 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_PARTICLE_TO_GRID_TRANSFER3_H_
+#define INCLUDE_JET_PARTICLE_TO_GRID_TRANSFER3_H_
+
+#include <jet/array1.h>
+#include <jet/array3.h>
+#include <jet/array_accessor3.h>
+#include <jet/array_samplers3.h>
+#include <jet/size3.h>
+#include <jet/vector3.h>
+
+#include <atomic>
+#include <memory>
+
+namespace jet {
+
+//!
+//! \brief 3-D parallel particle-to-grid transfer.
+//!
+//! This class splats particle quantities onto a regular grid using trilinear
+//! weights and normalizes the result by the accumulated weights, which is the
+//! particle-to-grid (P2G) step of PIC/FLIP/APIC solvers. Scattering from each
+//! particle in parallel would race on the shared grid points, so the particles
+//! are first bucketed by the lower corner of their interpolation stencil with
+//! a counting sort. Since the particles in a bucket only touch the 2x2x2 grid
+//! points at the corner of the bucket, buckets two or more slices apart never
+//! write to the same grid point. Even and odd slices of buckets are thus
+//! scattered in two passes, each of which is race-free and parallel.
+//!
+//! The bucket contents are kept in particle order, so the result is
+//! reproducible and independent of the number of threads. When deterministic
+//! mode is enabled, each grid point instead gathers from its neighboring
+//! buckets in particle index order, which makes the result bitwise identical
+//! to the serial per-particle scatter.
+//!
+class ParticleToGridTransfer3 {
+ public:
+    //! Default constructor.
+    ParticleToGridTransfer3();
+
+    //!
+    //! \brief Copy constructor.
+    //!
+    //! Only the settings are copied; the internal buckets are scratch buffers
+    //! rebuilt on every transfer.
+    //!
+    ParticleToGridTransfer3(const ParticleToGridTransfer3& other);
+
+    //! Returns true if contributions are accumulated in particle order.
+    bool isDeterministic() const;
+
+    //!
+    //! \brief Sets whether contributions are accumulated in particle order.
+    //!
+    //! When enabled, the output matches the serial scatter bit-by-bit at the
+    //! cost of merging the neighboring buckets for every grid point.
+    //!
+    void setIsDeterministic(bool isDeterministic);
+
+    //!
+    //! \brief Transfers particle values to the grid.
+    //!
+    //! For each particle index \p p in [0, \p numberOfParticles),
+    //! \p positionFunc(p) returns the sampling position and
+    //! \p valueFunc(p, position, gridIndex) returns the value splatted to the
+    //! grid point at \p gridIndex. Each grid point of \p values receives the
+    //! weighted average of the contributions (or zero if none), and
+    //! \p markers is set to 1 for every grid point touched by a particle.
+    //!
+    //! \param numberOfParticles Number of particles.
+    //! \param positionFunc Particle position function.
+    //! \param valueFunc Particle value function.
+    //! \param gridSpacing Grid spacing of the target data.
+    //! \param origin Position of the data point at (0, 0, 0).
+    //! \param values Target data to be overwritten.
+    //! \param markers Output markers with the same size as \p values.
+    //!
+    template <typename PositionFunc, typename ValueFunc>
+    void transfer(
+        size_t numberOfParticles,
+        const PositionFunc& positionFunc,
+        const ValueFunc& valueFunc,
+        const Vector3D& gridSpacing,
+        const Vector3D& origin,
+        ArrayAccessor3<double> values,
+        ArrayAccessor3<char> markers);
+
+    //! Copies the settings from the other instance.
+    ParticleToGridTransfer3& operator=(const ParticleToGridTransfer3& other);
+
+ private:
+    bool _isDeterministic = false;
+    Array1<Vector3D> _positions;
+    Array1<size_t> _keys;
+    Array1<size_t> _slots;
+    Array1<size_t> _sortedIndices;
+    Array1<size_t> _bucketStarts;
+    std::unique_ptr<std::atomic<size_t>[]> _bucketCounts;
+    size_t _bucketCountsCapacity = 0;
+    Array3<double> _weightSums;
+
+    void buildBuckets(const Size3& resolution);
+
+    template <typename ValueFunc>
+    void gatherInParticleOrder(
+        const LinearArraySampler3<double, double>& sampler,
+        const ValueFunc& valueFunc,
+        ArrayAccessor3<double> values,
+        ArrayAccessor3<char> markers);
+};
+
+}  // namespace jet
+
+#include "detail/particle_to_grid_transfer3-inl.h"
+
+#endif  // INCLUDE_JET_PARTICLE_TO_GRID_TRANSFER3_H_
@@ -10,6 +10,7 @@
 #include <jet/grid_fluid_solver2.h>
 #include <jet/particle_emitter2.h>
 #include <jet/particle_system_data2.h>
+#include <jet/particle_to_grid_transfer2.h>
 
 namespace jet {
 
@@ -51,12 +52,39 @@ class PicSolver2 : public GridFluidSolver2 {
     //! Sets the particle emitter.
     void setParticleEmitter(const ParticleEmitter2Ptr& newEmitter);
 
+    //!
+    //! \brief Returns true if particle-to-grid transfer is deterministic.
+    //!
+    //! The particle-to-grid transfer runs in parallel and its result does not
+    //! depend on the number of threads. In deterministic mode, contributions
+    //! are accumulated in particle order so that the grid velocity is bitwise
+    //! identical to the serial scatter.
+    //!
+    bool useDeterministicTransfer() const;
+
+    //! Sets whether particle-to-grid transfer should be deterministic.
+    void setUseDeterministicTransfer(bool onoff);
+
+    //!
+    //! \brief Returns the number of time-steps between particle sorting.
+    //!
+    //! If the interval is greater than zero, the particles are sorted by their
+    //! hash grid cells (see ParticleSystemData2::sortParticles) every
+    //! interval-th time-step, right after the emitter is updated. Zero, which
+    //! is the default, disables the sorting.
+    //!
+    unsigned int particleSortingInterval() const;
+
+    //! Sets the number of time-steps between particle sorting.
+    void setParticleSortingInterval(unsigned int newInterval);
+
     //! Returns builder fox PicSolver2.
     static Builder builder();
 
  protected:
     Array2<char> _uMarkers;
     Array2<char> _vMarkers;
+    ParticleToGridTransfer2 _particleToGridTransfer;
 
     //! Initializes the simulator.
     void onInitialize() override;
@@ -79,16 +107,29 @@ class PicSolver2 : public GridFluidSolver2 {
     //! Moves particles.
     virtual void moveParticles(double timeIntervalInSeconds);
 
+    //!
+    //! \brief Invoked after the particles are reordered.
+    //!
+    //! Subclasses with per-particle state that is not stored in the particle
+    //! system data should permute it here. The i-th particle after reordering
+    //! is the one that was at order[i] before.
+    //!
+    virtual void onParticlesReordered(const std::vector<size_t>& order);
+
  private:
     size_t _signedDistanceFieldId;
     ParticleSystemData2Ptr _particles;
     ParticleEmitter2Ptr _particleEmitter;
+    unsigned int _particleSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSorting = 0;
 
     void extrapolateVelocityToAir();
 
     void buildSignedDistanceField();
 
     void updateParticleEmitter(double timeIntervalInSeconds);
+
+    void sortParticlesIfNeeded();
 };
 
 //! Shared pointer type for the PicSolver2.
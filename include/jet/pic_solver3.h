@@ -10,6 +10,7 @@
 #include <jet/grid_fluid_solver3.h>
 #include <jet/particle_emitter3.h>
 #include <jet/particle_system_data3.h>
+#include <jet/particle_to_grid_transfer3.h>
 
 namespace jet {
 
@@ -51,6 +52,32 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Sets the particle emitter.
     void setParticleEmitter(const ParticleEmitter3Ptr& newEmitter);
 
+    //!
+    //! \brief Returns true if particle-to-grid transfer is deterministic.
+    //!
+    //! The particle-to-grid transfer runs in parallel and its result does not
+    //! depend on the number of threads. In deterministic mode, contributions
+    //! are accumulated in particle order so that the grid velocity is bitwise
+    //! identical to the serial scatter.
+    //!
+    bool useDeterministicTransfer() const;
+
+    //! Sets whether particle-to-grid transfer should be deterministic.
+    void setUseDeterministicTransfer(bool onoff);
+
+    //!
+    //! \brief Returns the number of time-steps between particle sorting.
+    //!
+    //! If the interval is greater than zero, the particles are sorted by their
+    //! hash grid cells (see ParticleSystemData3::sortParticles) every
+    //! interval-th time-step, right after the emitter is updated. Zero, which
+    //! is the default, disables the sorting.
+    //!
+    unsigned int particleSortingInterval() const;
+
+    //! Sets the number of time-steps between particle sorting.
+    void setParticleSortingInterval(unsigned int newInterval);
+
     //! Returns builder fox PicSolver3.
     static Builder builder();
 
@@ -58,6 +85,7 @@ class PicSolver3 : public GridFluidSolver3 {
     Array3<char> _uMarkers;
     Array3<char> _vMarkers;
     Array3<char> _wMarkers;
+    ParticleToGridTransfer3 _particleToGridTransfer;
 
     //! Initializes the simulator.
     void onInitialize() override;
@@ -80,16 +108,29 @@ class PicSolver3 : public GridFluidSolver3 {
     //! Moves particles.
     virtual void moveParticles(double timeIntervalInSeconds);
 
+    //!
+    //! \brief Invoked after the particles are reordered.
+    //!
+    //! Subclasses with per-particle state that is not stored in the particle
+    //! system data should permute it here. The i-th particle after reordering
+    //! is the one that was at order[i] before.
+    //!
+    virtual void onParticlesReordered(const std::vector<size_t>& order);
+
  private:
     size_t _signedDistanceFieldId;
     ParticleSystemData3Ptr _particles;
     ParticleEmitter3Ptr _particleEmitter;
+    unsigned int _particleSortingInterval = 0;
+    unsigned int _numberOfStepsSinceSorting = 0;
 
     void extrapolateVelocityToAir();
 
     void buildSignedDistanceField();
 
     void updateParticleEmitter(double timeIntervalInSeconds);
+
+    void sortParticlesIfNeeded();
 };
 
 //! Shared pointer type for the PicSolver3.
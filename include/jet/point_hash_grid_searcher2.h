@@ -75,6 +75,45 @@ class PointHashGridSearcher2 final : public PointNeighborSearcher2 {
         double radius,
         const ForEachNearbyPointFunc& callback) const override;
 
+    //!
+    //! \brief Invokes the callback function for each nearby point around the
+    //!        origin within given radius.
+    //!
+    //! Unlike the virtual overload, this function takes the callback as a
+    //! template parameter so that the compiler can inline it. Prefer this
+    //! version in performance-critical loops where the concrete searcher type
+    //! is known.
+    //!
+    //! \param[in]  origin   The origin position.
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function with the signature of
+    //!                      void(size_t, const Vector2D&).
+    //!
+    template <typename Callback>
+    void forEachNearbyPoint(
+        const Vector2D& origin,
+        double radius,
+        const Callback& callback) const;
+
+    //!
+    //! \brief Invokes the callback function for each pair of a point in the
+    //!        searcher and its nearby points within given radius.
+    //!
+    //! The points are visited in hash bucket order so that consecutive queries
+    //! touch nearby memory. The callback has the signature of
+    //! void(size_t i, size_t j, const Vector2D& xj) where i is the index of the
+    //! query point, and j and xj are the index and position of the nearby
+    //! point (including i itself). Calls for different query points may run
+    //! concurrently, but all calls for the same query point are made from a
+    //! single thread.
+    //!
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function.
+    //!
+    template <typename Callback>
+    void parallelForEachNearbyPoint(
+        double radius, const Callback& callback) const;
+
     //!
     //! Returns true if there are any nearby points for given origin within
     //! radius.
@@ -191,4 +230,6 @@ class PointHashGridSearcher2::Builder final
 
 }  // namespace jet
 
+#include "detail/point_hash_grid_searcher2-inl.h"
+
 #endif  // INCLUDE_JET_POINT_HASH_GRID_SEARCHER2_H_
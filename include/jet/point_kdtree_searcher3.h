@@ -49,6 +49,26 @@ class PointKdTreeSearcher3 final : public PointNeighborSearcher3 {
         const Vector3D& origin, double radius,
         const ForEachNearbyPointFunc& callback) const override;
 
+    //!
+    //! \brief Invokes the callback function for each nearby point around the
+    //!        origin within given radius.
+    //!
+    //! Unlike the virtual overload, this function takes the callback as a
+    //! template parameter so that the compiler can inline it. Prefer this
+    //! version in performance-critical loops where the concrete searcher type
+    //! is known.
+    //!
+    //! \param[in]  origin   The origin position.
+    //! \param[in]  radius   The search radius.
+    //! \param[in]  callback The callback function with the signature of
+    //!                      void(size_t, const Vector3D&).
+    //!
+    template <typename Callback>
+    void forEachNearbyPoint(
+        const Vector3D& origin,
+        double radius,
+        const Callback& callback) const;
+
     //!
     //! Returns true if there are any nearby points for given origin within
     //! radius.
@@ -108,4 +128,6 @@ class PointKdTreeSearcher3::Builder final
 
 }  // namespace jet
 
+#include "detail/point_kdtree_searcher3-inl.h"
+
 #endif  // INCLUDE_JET_POINT_KDTREE_SEARCHER3_H
@@ -87,9 +87,8 @@ class PointParticleEmitter2 final : public ParticleEmitter2 {
         double timeIntervalInSeconds) override;
 
     void emit(
-        Array1<Vector2D>* newPositions,
-        Array1<Vector2D>* newVelocities,
-        size_t maxNewNumberOfParticles);
+        ArrayAccessor1<Vector2D> newPositions,
+        ArrayAccessor1<Vector2D> newVelocities);
 
     double random();
 };
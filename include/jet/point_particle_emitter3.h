@@ -87,9 +87,8 @@ class PointParticleEmitter3 final : public ParticleEmitter3 {
         double timeIntervalInSeconds) override;
 
     void emit(
-        Array1<Vector3D>* newPositions,
-        Array1<Vector3D>* newVelocities,
-        size_t maxNewNumberOfParticles);
+        ArrayAccessor1<Vector3D> newPositions,
+        ArrayAccessor1<Vector3D> newVelocities);
 
     double random();
 };
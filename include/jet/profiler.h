@@ -0,0 +1,133 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_PROFILER_H_
+#define INCLUDE_JET_PROFILER_H_
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace jet {
+
+//! Profiled zone recorded by the Profiler.
+struct ProfilerEvent {
+    //! Name of the zone, which should be a string literal.
+    const char* name = nullptr;
+
+    //! Start time in nanoseconds since the profiler has started.
+    int64_t beginTime = 0;
+
+    //! End time in nanoseconds since the profiler has started.
+    int64_t endTime = 0;
+
+    //! Frame index when the zone was entered.
+    int64_t frameIndex = 0;
+
+    //! Index of the thread that recorded the zone.
+    unsigned int threadIndex = 0;
+
+    //! Number of the enclosing zones on the same thread.
+    unsigned int depth = 0;
+};
+
+//!
+//! \brief Low-overhead hierarchical profiler.
+//!
+//! The zones are recorded by ProfilerScope objects, usually through the
+//! JET_PROFILE_SCOPE macro. Each thread records its zones into its own ring
+//! buffer, so the oldest zones are dropped when a buffer is full. The profiler
+//! is disabled by default, and a disabled profiler only costs a flag check per
+//! zone. Defining JET_DISABLE_PROFILER (or configuring CMake with
+//! JET_USE_PROFILER=OFF) compiles the zones out entirely.
+//!
+//! The recorded zones can be exported to Chrome trace-event JSON, which can be
+//! opened with chrome://tracing, or to a per-frame CSV summary.
+//!
+class Profiler {
+ public:
+    //! Enables or disables recording the zones.
+    static void setEnabled(bool enabled);
+
+    //! Returns true if the zones are being recorded.
+    static bool isEnabled();
+
+    //! Sets the frame index stored with the zones entered after this call.
+    static void setFrameIndex(int64_t frameIndex);
+
+    //! Returns the current frame index.
+    static int64_t frameIndex();
+
+    //! Returns the nanoseconds since the profiler has started.
+    static int64_t now();
+
+    //! Records a zone on the calling thread.
+    static void record(const char* name, int64_t beginTime, int64_t endTime,
+                       unsigned int depth);
+
+    //! Returns the zones recorded by all the threads, ordered by start time.
+    static std::vector<ProfilerEvent> events();
+
+    //! Discards the recorded zones.
+    static void clear();
+
+    //!
+    //! \brief Writes the recorded zones in Chrome trace-event JSON format.
+    //!
+    //! Each zone is written as a complete event ("ph": "X") with the frame
+    //! index in its arguments.
+    //!
+    static void writeChromeTrace(std::ostream* strm);
+
+    //!
+    //! \brief Writes the per-frame summary of the recorded zones as CSV.
+    //!
+    //! Each row has the frame index, the zone name, the number of calls, and
+    //! the total and the maximum durations in seconds of the zone in the
+    //! frame.
+    //!
+    static void writeFrameSummaryCsv(std::ostream* strm);
+};
+
+//!
+//! \brief Records the lifetime of the object as a profiler zone.
+//!
+//! The zone is recorded only if the profiler was enabled when the object was
+//! constructed.
+//!
+class ProfilerScope final {
+ public:
+    //! Enters the zone with given name, which should be a string literal.
+    explicit ProfilerScope(const char* name);
+
+    //! Leaves the zone.
+    ~ProfilerScope();
+
+    ProfilerScope(const ProfilerScope&) = delete;
+
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+ private:
+    const char* _name;
+    int64_t _beginTime;
+    unsigned int _depth;
+};
+
+}  // namespace jet
+
+#define JET_PROFILER_CONCAT_IMPL(a, b) a##b
+#define JET_PROFILER_CONCAT(a, b) JET_PROFILER_CONCAT_IMPL(a, b)
+
+#ifdef JET_DISABLE_PROFILER
+#define JET_PROFILE_SCOPE(name)
+#else
+//! Records the rest of the enclosing scope as a profiler zone.
+#define JET_PROFILE_SCOPE(name)                                           \
+    ::jet::ProfilerScope JET_PROFILER_CONCAT(jetProfilerScope, __LINE__)( \
+        name)
+#endif
+
+#endif  // INCLUDE_JET_PROFILER_H_
@@ -0,0 +1,173 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_REDUCERS_H_
+#define INCLUDE_JET_REDUCERS_H_
+
+#include <jet/parallel.h>
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace jet {
+
+//!
+//! \brief Reducer for the maximum value.
+//!
+//! Like the other reducers, this class can be used with parallelMapReduce,
+//! or be passed as the reduce operator of parallelDeterministicReduce.
+//!
+template <typename T>
+class MaxReducer final {
+ public:
+    typedef T ValueType;
+
+    //! Constructs a reducer whose result is at least \p lowest.
+    explicit MaxReducer(const T& lowest = std::numeric_limits<T>::lowest());
+
+    //! Returns the identity value.
+    ValueType identity() const;
+
+    //! Accumulates the value of given index into \p result.
+    void accumulate(ValueType* result, const T& value, size_t index) const;
+
+    //! Returns the reduction of \p a and \p b, where \p a comes first.
+    ValueType operator()(const ValueType& a, const ValueType& b) const;
+
+ private:
+    T _identity;
+};
+
+//! Reducer for the minimum value.
+template <typename T>
+class MinReducer final {
+ public:
+    typedef T ValueType;
+
+    //! Constructs a reducer whose result is at most \p highest.
+    explicit MinReducer(const T& highest = std::numeric_limits<T>::max());
+
+    //! Returns the identity value.
+    ValueType identity() const;
+
+    //! Accumulates the value of given index into \p result.
+    void accumulate(ValueType* result, const T& value, size_t index) const;
+
+    //! Returns the reduction of \p a and \p b, where \p a comes first.
+    ValueType operator()(const ValueType& a, const ValueType& b) const;
+
+ private:
+    T _identity;
+};
+
+//!
+//! \brief Reducer for the value with the maximum magnitude.
+//!
+//! The sign of the value is kept. Among the values of the same magnitude, the
+//! one with the largest index wins, as with the serial loop over absmax.
+//!
+template <typename T>
+class AbsMaxReducer final {
+ public:
+    typedef T ValueType;
+
+    //! Returns the identity value, which is zero.
+    ValueType identity() const;
+
+    //! Accumulates the value of given index into \p result.
+    void accumulate(ValueType* result, const T& value, size_t index) const;
+
+    //! Returns the reduction of \p a and \p b, where \p a comes first.
+    ValueType operator()(const ValueType& a, const ValueType& b) const;
+};
+
+//! Running sum with the compensation term of the Kahan summation.
+template <typename T>
+struct KahanSum {
+    //! The sum.
+    T sum = 0;
+
+    //! The low-order bits lost from the sum.
+    T compensation = 0;
+
+    //! Adds \p value to the sum.
+    void add(const T& value);
+};
+
+//!
+//! \brief Reducer for the sum with the Kahan summation.
+//!
+//! The error of the compensated sum does not grow with the number of values,
+//! which keeps the sums of millions of values accurate.
+//!
+template <typename T>
+class KahanSumReducer final {
+ public:
+    typedef KahanSum<T> ValueType;
+
+    //! Returns the identity value, which is zero.
+    ValueType identity() const;
+
+    //! Accumulates the value of given index into \p result.
+    void accumulate(ValueType* result, const T& value, size_t index) const;
+
+    //! Returns the reduction of \p a and \p b, where \p a comes first.
+    ValueType operator()(const ValueType& a, const ValueType& b) const;
+};
+
+//!
+//! \brief Reducer for the maximum value and its index.
+//!
+//! The result is the pair of the maximum value and its index. Among the equal
+//! values, the one with the smallest index wins. The index of the identity is
+//! kMaxSize.
+//!
+template <typename T>
+class ArgMaxReducer final {
+ public:
+    typedef std::pair<T, size_t> ValueType;
+
+    //! Returns the identity value.
+    ValueType identity() const;
+
+    //! Accumulates the value of given index into \p result.
+    void accumulate(ValueType* result, const T& value, size_t index) const;
+
+    //! Returns the reduction of \p a and \p b, where \p a comes first.
+    ValueType operator()(const ValueType& a, const ValueType& b) const;
+};
+
+//!
+//! \brief      Reduces the values of the indices in parallel.
+//!
+//! This function reduces func(i) for i in [beginIndex, endIndex) with given
+//! reducer. The range is split with parallelDeterministicReduce, so the
+//! result does not depend on the number of threads.
+//!
+//! \param[in]  beginIndex The begin index.
+//! \param[in]  endIndex   The end index.
+//! \param[in]  func       The function returning the value of an index.
+//! \param[in]  reducer    The reducer such as MaxReducer.
+//! \param[in]  policy     The execution policy (parallel or serial).
+//!
+//! \tparam     IndexType  Index type.
+//! \tparam     Function   Value function type.
+//! \tparam     Reducer    Reducer type.
+//!
+//! \return     The reduced value.
+//!
+template <typename IndexType, typename Function, typename Reducer>
+typename Reducer::ValueType parallelMapReduce(
+    IndexType beginIndex, IndexType endIndex, const Function& func,
+    const Reducer& reducer,
+    ExecutionPolicy policy = ExecutionPolicy::kParallel);
+
+}  // namespace jet
+
+#include "detail/reducers-inl.h"
+
+#endif  // INCLUDE_JET_REDUCERS_H_
@@ -0,0 +1,150 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SCRATCH_ARENA_H_
+#define INCLUDE_JET_SCRATCH_ARENA_H_
+
+#include <jet/array_accessor1.h>
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace jet {
+
+class ScratchArena;
+
+//!
+//! \brief Temporary buffer drawn from a ScratchArena.
+//!
+//! The elements are default-initialized, so the values of the trivial types
+//! such as double are undefined until written. The memory goes back to the
+//! arena when the buffer is destroyed.
+//!
+//! \tparam T - Trivially destructible element type.
+//!
+template <typename T>
+class ScratchBuffer final {
+ public:
+    //! Constructs an empty buffer.
+    ScratchBuffer();
+
+    //! Move constructor.
+    ScratchBuffer(ScratchBuffer&& other);
+
+    //! Returns the memory to the arena.
+    ~ScratchBuffer();
+
+    //! Move assignment operator.
+    ScratchBuffer& operator=(ScratchBuffer&& other);
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    //! Returns the number of elements.
+    size_t size() const;
+
+    //! Returns the raw pointer to the elements.
+    T* data();
+
+    //! Returns the raw pointer to the elements.
+    const T* data() const;
+
+    //! Returns the array accessor.
+    ArrayAccessor1<T> accessor();
+
+    //! Returns the const array accessor.
+    ConstArrayAccessor1<T> constAccessor() const;
+
+    //! Returns the reference to i-th element.
+    T& operator[](size_t i);
+
+    //! Returns the const reference to i-th element.
+    const T& operator[](size_t i) const;
+
+ private:
+    friend class ScratchArena;
+
+    ScratchArena* _arena = nullptr;
+    T* _data = nullptr;
+    size_t _size = 0;
+    size_t _sizeClass = 0;
+
+    ScratchBuffer(ScratchArena* arena, void* block, size_t sizeClass,
+                  size_t size);
+
+    void release();
+};
+
+//!
+//! \brief Cache of memory blocks for the per-step temporary buffers.
+//!
+//! The blocks are grouped into power-of-two size classes. A released block is
+//! kept in the arena and handed out again to the next request of the same
+//! size class, so the solvers that allocate the same temporaries every time
+//! step stop touching the heap after the first step. The arena is not
+//! thread-safe; use threadLocal() and release the buffers on the thread that
+//! has allocated them.
+//!
+class ScratchArena final {
+ public:
+    //! Constructs an empty arena.
+    ScratchArena();
+
+    //! Frees the cached blocks.
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    //! Returns a buffer of \p size default-initialized elements.
+    template <typename T>
+    ScratchBuffer<T> allocate(size_t size);
+
+    //! Returns the number of bytes in the cached blocks.
+    size_t numberOfCachedBytes() const;
+
+    //! Frees the cached blocks.
+    void releaseCachedBlocks();
+
+    //! Returns the arena of the calling thread.
+    static ScratchArena& threadLocal();
+
+    //!
+    //! \brief Returns the number of heap allocations made by all the arenas.
+    //!
+    //! The counters are cumulative; take the difference between two frames to
+    //! get the per-frame numbers.
+    //!
+    static size_t numberOfHeapAllocations();
+
+    //! Returns the number of bytes allocated from the heap by all the arenas.
+    static size_t heapBytesAllocated();
+
+    //! Returns the number of bytes handed out by all the arenas.
+    static size_t bytesServed();
+
+ private:
+    template <typename T>
+    friend class ScratchBuffer;
+
+    static const size_t kNumberOfSizeClasses = 48;
+
+    std::array<std::vector<void*>, kNumberOfSizeClasses> _freeBlocks;
+    size_t _numberOfCachedBytes = 0;
+
+    void* acquire(size_t bytes, size_t* sizeClass);
+
+    void release(void* block, size_t sizeClass);
+};
+
+}  // namespace jet
+
+#include "detail/scratch_arena-inl.h"
+
+#endif  // INCLUDE_JET_SCRATCH_ARENA_H_
@@ -134,10 +134,6 @@ class SemiLagrangian2 : public AdvectionSolver2 {
     //!
     virtual std::function<Vector2D(const Vector2D&)> getVectorSamplerFunc(
         const FaceCenteredGrid2& input) const;
-
- private:
-    Vector2D backTrace(const VectorField2& flow, double dt, double h,
-                       const Vector2D& pt0, const ScalarField2& boundarySdf);
 };
 
 typedef std::shared_ptr<SemiLagrangian2> SemiLagrangian2Ptr;
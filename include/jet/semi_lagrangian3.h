@@ -52,6 +52,27 @@ class SemiLagrangian3 : public AdvectionSolver3 {
                 const ScalarField3& boundarySdf = ConstantScalarField3(
                     std::numeric_limits<double>::max())) final;
 
+    //!
+    //! \brief Computes semi-Langian for given level set within the band.
+    //!
+    //! This function back-traces only the data points whose |input| is less
+    //! than or equal to \p bandWidth. The rest of the output is set to the
+    //! input clamped to [-bandWidth, bandWidth].
+    //!
+    //! \param input Input level set grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param bandWidth Half-width of the narrow band.
+    //! \param output Output level set grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advectNarrowBand(const ScalarGrid3& input, const VectorField3& flow,
+                          double dt, double bandWidth, ScalarGrid3* output,
+                          const ScalarField3& boundarySdf =
+                              ConstantScalarField3(
+                                  std::numeric_limits<double>::max())) final;
+
     //!
     //! \brief Computes semi-Langian for given collocated vector grid.
     //!
@@ -99,6 +120,27 @@ class SemiLagrangian3 : public AdvectionSolver3 {
                 const ScalarField3& boundarySdf = ConstantScalarField3(
                     std::numeric_limits<double>::max())) final;
 
+    //!
+    //! \brief Computes semi-Langian for given sparse scalar grid.
+    //!
+    //! This function back-traces the data points of \p output, which must
+    //! have the same shape as \p input, and samples \p input linearly from
+    //! its tiles without a dense copy. Only the tiles of the result that
+    //! differ from the background value of \p input are activated. The data
+    //! points inside the boundary take the input values.
+    //!
+    //! \param input Input sparse scalar grid.
+    //! \param flow Vector field that advects the input field.
+    //! \param dt Time-step for the advection.
+    //! \param output Output sparse scalar grid.
+    //! \param boundarySdf Boundary interface defined by signed-distance
+    //!     field.
+    //!
+    void advect(const SparseScalarGrid3& input, const VectorField3& flow,
+                double dt, SparseScalarGrid3* output,
+                const ScalarField3& boundarySdf = ConstantScalarField3(
+                    std::numeric_limits<double>::max())) final;
+
  protected:
     //!
     //! \brief Returns spatial interpolation function object for given scalar
@@ -135,10 +177,6 @@ class SemiLagrangian3 : public AdvectionSolver3 {
     //!
     virtual std::function<Vector3D(const Vector3D&)> getVectorSamplerFunc(
         const FaceCenteredGrid3& input) const;
-
- private:
-    Vector3D backTrace(const VectorField3& flow, double dt, double h,
-                       const Vector3D& pt0, const ScalarField3& boundarySdf);
 };
 
 typedef std::shared_ptr<SemiLagrangian3> SemiLagrangian3Ptr;
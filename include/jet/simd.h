@@ -0,0 +1,126 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SIMD_H_
+#define INCLUDE_JET_SIMD_H_
+
+#include <jet/macros.h>
+
+#include <cstddef>
+#include <cstdint>
+
+// Pick the widest instruction set enabled by the compiler flags. Define
+// JET_DISABLE_SIMD to force the scalar fallback.
+#if !defined(JET_DISABLE_SIMD)
+#   if defined(__AVX2__)
+#       define JET_SIMD_AVX2
+#   elif defined(__SSE2__) || defined(_M_X64) || \
+        (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define JET_SIMD_SSE2
+#   endif
+#endif
+
+#if defined(JET_SIMD_AVX2)
+#   include <immintrin.h>
+#elif defined(JET_SIMD_SSE2)
+#   include <emmintrin.h>
+#endif
+
+namespace jet {
+
+#if defined(JET_SIMD_AVX2)
+//! Number of double-precision lanes in SimdDouble.
+constexpr size_t kSimdDoubleWidth = 4;
+#elif defined(JET_SIMD_SSE2)
+//! Number of double-precision lanes in SimdDouble.
+constexpr size_t kSimdDoubleWidth = 2;
+#else
+//! Number of double-precision lanes in SimdDouble.
+constexpr size_t kSimdDoubleWidth = 1;
+#endif
+
+//!
+//! \brief Portable pack of double-precision values.
+//!
+//! This class wraps AVX2 or SSE2 intrinsics depending on the compiler flags,
+//! and falls back to a single scalar otherwise. The number of lanes is
+//! kSimdDoubleWidth. Kernels written with this class compile to the same code
+//! on every platform, only the amount of work per instruction differs.
+//!
+class SimdDouble {
+ public:
+#if defined(JET_SIMD_AVX2)
+    typedef __m256d NativeType;
+#elif defined(JET_SIMD_SSE2)
+    typedef __m128d NativeType;
+#else
+    typedef double NativeType;
+#endif
+
+    //! Constructs a pack with zeros.
+    SimdDouble();
+
+    //! Constructs a pack with all lanes set to \p s.
+    explicit SimdDouble(double s);
+
+#if defined(JET_SIMD_AVX2) || defined(JET_SIMD_SSE2)
+    //! Constructs a pack from the native type.
+    SimdDouble(NativeType v);
+#endif
+
+    //! Loads kSimdDoubleWidth values from \p ptr (no alignment required).
+    static SimdDouble load(const double* ptr);
+
+    //! Loads base[indices[0]], ..., base[indices[kSimdDoubleWidth - 1]].
+    static SimdDouble gather(const double* base, const uint32_t* indices);
+
+    //! Returns a pack whose first \p n lanes are one and the others are zero.
+    static SimdDouble laneMask(size_t n);
+
+    //! Returns lane-wise minimum.
+    static SimdDouble min(const SimdDouble& a, const SimdDouble& b);
+
+    //! Returns lane-wise maximum.
+    static SimdDouble max(const SimdDouble& a, const SimdDouble& b);
+
+    //! Returns lane-wise square root.
+    static SimdDouble sqrt(const SimdDouble& a);
+
+    //! Returns lane-wise 1 / a where a is positive, and zero elsewhere.
+    static SimdDouble reciprocalIfPositive(const SimdDouble& a);
+
+    //! Stores the values to \p ptr (no alignment required).
+    void store(double* ptr) const;
+
+    //! Returns the sum of all the lanes.
+    double sum() const;
+
+    //! Returns the native type.
+    NativeType native() const;
+
+    SimdDouble& operator+=(const SimdDouble& other);
+
+    SimdDouble& operator-=(const SimdDouble& other);
+
+    SimdDouble& operator*=(const SimdDouble& other);
+
+ private:
+    NativeType _v;
+};
+
+SimdDouble operator+(const SimdDouble& a, const SimdDouble& b);
+
+SimdDouble operator-(const SimdDouble& a, const SimdDouble& b);
+
+SimdDouble operator*(const SimdDouble& a, const SimdDouble& b);
+
+SimdDouble operator/(const SimdDouble& a, const SimdDouble& b);
+
+}  // namespace jet
+
+#include "detail/simd-inl.h"
+
+#endif  // INCLUDE_JET_SIMD_H_
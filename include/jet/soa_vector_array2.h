@@ -0,0 +1,74 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SOA_VECTOR_ARRAY2_H_
+#define INCLUDE_JET_SOA_VECTOR_ARRAY2_H_
+
+#include <jet/aligned_allocator.h>
+#include <jet/array_accessor1.h>
+#include <jet/vector2.h>
+
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief 1-D array of 2-D vectors in structure-of-arrays layout.
+//!
+//! This class stores the x and y components of the vectors in three
+//! separate arrays, each aligned to kSimdAlignment bytes. Compared to
+//! Array1<Vector2D>, the same component of consecutive vectors is contiguous,
+//! so the arrays can be loaded directly by SIMD instructions.
+//!
+class SoaVectorArray2 final {
+ public:
+    //! Component array type.
+    typedef std::vector<double, AlignedAllocator<double>> ComponentArray;
+
+    //! Constructs an empty array.
+    SoaVectorArray2();
+
+    //! Constructs an array by copying the vectors.
+    explicit SoaVectorArray2(const ConstArrayAccessor1<Vector2D>& vectors);
+
+    //! Returns the number of vectors.
+    size_t size() const;
+
+    //! Resizes the array. New vectors are zero.
+    void resize(size_t size);
+
+    //! Returns i-th vector.
+    Vector2D operator[](size_t i) const;
+
+    //! Sets i-th vector.
+    void set(size_t i, const Vector2D& value);
+
+    //! Resizes and copies the vectors from AoS layout.
+    void set(const ConstArrayAccessor1<Vector2D>& vectors);
+
+    //! Copies the vectors to AoS layout with the same size.
+    void copyTo(ArrayAccessor1<Vector2D> vectors) const;
+
+    //! Returns the x components.
+    double* x();
+
+    //! Returns the x components.
+    const double* x() const;
+
+    //! Returns the y components.
+    double* y();
+
+    //! Returns the y components.
+    const double* y() const;
+
+ private:
+    ComponentArray _x;
+    ComponentArray _y;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_SOA_VECTOR_ARRAY2_H_
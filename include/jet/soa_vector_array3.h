@@ -0,0 +1,81 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SOA_VECTOR_ARRAY3_H_
+#define INCLUDE_JET_SOA_VECTOR_ARRAY3_H_
+
+#include <jet/aligned_allocator.h>
+#include <jet/array_accessor1.h>
+#include <jet/vector3.h>
+
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief 1-D array of 3-D vectors in structure-of-arrays layout.
+//!
+//! This class stores the x, y, and z components of the vectors in three
+//! separate arrays, each aligned to kSimdAlignment bytes. Compared to
+//! Array1<Vector3D>, the same component of consecutive vectors is contiguous,
+//! so the arrays can be loaded directly by SIMD instructions.
+//!
+class SoaVectorArray3 final {
+ public:
+    //! Component array type.
+    typedef std::vector<double, AlignedAllocator<double>> ComponentArray;
+
+    //! Constructs an empty array.
+    SoaVectorArray3();
+
+    //! Constructs an array by copying the vectors.
+    explicit SoaVectorArray3(const ConstArrayAccessor1<Vector3D>& vectors);
+
+    //! Returns the number of vectors.
+    size_t size() const;
+
+    //! Resizes the array. New vectors are zero.
+    void resize(size_t size);
+
+    //! Returns i-th vector.
+    Vector3D operator[](size_t i) const;
+
+    //! Sets i-th vector.
+    void set(size_t i, const Vector3D& value);
+
+    //! Resizes and copies the vectors from AoS layout.
+    void set(const ConstArrayAccessor1<Vector3D>& vectors);
+
+    //! Copies the vectors to AoS layout with the same size.
+    void copyTo(ArrayAccessor1<Vector3D> vectors) const;
+
+    //! Returns the x components.
+    double* x();
+
+    //! Returns the x components.
+    const double* x() const;
+
+    //! Returns the y components.
+    double* y();
+
+    //! Returns the y components.
+    const double* y() const;
+
+    //! Returns the z components.
+    double* z();
+
+    //! Returns the z components.
+    const double* z() const;
+
+ private:
+    ComponentArray _x;
+    ComponentArray _y;
+    ComponentArray _z;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_SOA_VECTOR_ARRAY3_H_
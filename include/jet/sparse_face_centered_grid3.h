@@ -0,0 +1,217 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SPARSE_FACE_CENTERED_GRID3_H_
+#define INCLUDE_JET_SPARSE_FACE_CENTERED_GRID3_H_
+
+#include <jet/face_centered_grid3.h>
+#include <jet/grid3.h>
+#include <jet/tiled_array3.h>
+#include <jet/vector_field3.h>
+
+#include <memory>
+#include <utility>  // just make cpplint happy..
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief 3-D sparse face-centered (a.k.a MAC or staggered) grid.
+//!
+//! This class implements the face-centered grid of FaceCenteredGrid3 with a
+//! TiledArray3 per velocity component, so only the tiles of 8 x 8 x 8 faces
+//! that differ from the background velocity occupy memory. The grid samples
+//! the same way as FaceCenteredGrid3 does, and converts from and to the dense
+//! grid. The serialized form is the same as FaceCenteredGrid3.
+//!
+class SparseFaceCenteredGrid3 final : public VectorField3, public Grid3 {
+ public:
+    JET_GRID3_TYPE_NAME(SparseFaceCenteredGrid3)
+
+    class Builder;
+
+    //! Constructs empty grid.
+    SparseFaceCenteredGrid3();
+
+    //! Resizes the grid using given parameters.
+    SparseFaceCenteredGrid3(const Size3& resolution,
+                            const Vector3D& gridSpacing = Vector3D(1.0, 1.0,
+                                                                   1.0),
+                            const Vector3D& origin = Vector3D(),
+                            const Vector3D& background = Vector3D());
+
+    //! Copy constructor.
+    SparseFaceCenteredGrid3(const SparseFaceCenteredGrid3& other);
+
+    //!
+    //! \brief Swaps the contents with the given \p other grid.
+    //!
+    //! This function swaps the contents of the grid instance with the given
+    //! grid object \p other only if \p other has the same type with this grid.
+    //!
+    void swap(Grid3* other) override;
+
+    //! Sets the contents with the given \p other grid.
+    void set(const SparseFaceCenteredGrid3& other);
+
+    //! Sets the contents with the given \p other grid.
+    SparseFaceCenteredGrid3& operator=(const SparseFaceCenteredGrid3& other);
+
+    //! Returns the copy of the grid instance.
+    std::shared_ptr<SparseFaceCenteredGrid3> clone() const;
+
+    //! Deactivates all the tiles of the grid.
+    void clear();
+
+    //! Resizes the grid using given parameters and deactivates all the tiles.
+    void resize(const Size3& resolution,
+                const Vector3D& gridSpacing = Vector3D(1, 1, 1),
+                const Vector3D& origin = Vector3D(),
+                const Vector3D& background = Vector3D());
+
+    //! Returns u-value at given data point.
+    const double& u(size_t i, size_t j, size_t k) const;
+
+    //! Returns v-value at given data point.
+    const double& v(size_t i, size_t j, size_t k) const;
+
+    //! Returns w-value at given data point.
+    const double& w(size_t i, size_t j, size_t k) const;
+
+    //! Returns interpolated value at cell center.
+    Vector3D valueAtCellCenter(size_t i, size_t j, size_t k) const;
+
+    //! Returns divergence at cell-center location.
+    double divergenceAtCellCenter(size_t i, size_t j, size_t k) const;
+
+    //! Returns the tiled u data storage.
+    TiledArray3<double>& uData();
+
+    //! Returns the tiled u data storage.
+    const TiledArray3<double>& uData() const;
+
+    //! Returns the tiled v data storage.
+    TiledArray3<double>& vData();
+
+    //! Returns the tiled v data storage.
+    const TiledArray3<double>& vData() const;
+
+    //! Returns the tiled w data storage.
+    TiledArray3<double>& wData();
+
+    //! Returns the tiled w data storage.
+    const TiledArray3<double>& wData() const;
+
+    //! Returns data size of the u component.
+    Size3 uSize() const;
+
+    //! Returns data size of the v component.
+    Size3 vSize() const;
+
+    //! Returns data size of the w component.
+    Size3 wSize() const;
+
+    //! Returns u-data position for the grid point at (0, 0, 0).
+    Vector3D uOrigin() const;
+
+    //! Returns v-data position for the grid point at (0, 0, 0).
+    Vector3D vOrigin() const;
+
+    //! Returns w-data position for the grid point at (0, 0, 0).
+    Vector3D wOrigin() const;
+
+    //! Returns the number of active tiles of all three components.
+    size_t numberOfActiveTiles() const;
+
+    //! Returns the number of bytes allocated for all three components.
+    size_t memoryUsage() const;
+
+    //! Deactivates all the tiles and sets the background value to \p value.
+    void fill(const Vector3D& value);
+
+    //!
+    //! \brief Fills the grid with given function.
+    //!
+    //! The tiles whose values are all within \p tolerance from the
+    //! background value stay inactive.
+    //!
+    void fill(const std::function<Vector3D(const Vector3D&)>& func,
+              double tolerance = 0.0);
+
+    //! Copies the data from the dense grid \p other with the same resolution,
+    //! activating the tiles farther than \p tolerance from the background.
+    void copyFrom(const FaceCenteredGrid3& other, double tolerance = 0.0);
+
+    //! Copies the data to the dense grid \p other with the same resolution.
+    void copyTo(FaceCenteredGrid3* other) const;
+
+    //! Returns sampled value at given position \p x.
+    Vector3D sample(const Vector3D& x) const override;
+
+    //! Returns divergence at given position \p x.
+    double divergence(const Vector3D& x) const override;
+
+    //! Serializes the grid instance to the output buffer.
+    void serialize(std::vector<uint8_t>* buffer) const override;
+
+    //! Deserializes the input buffer to the grid instance.
+    void deserialize(const std::vector<uint8_t>& buffer) override;
+
+    //! Returns builder fox SparseFaceCenteredGrid3.
+    static Builder builder();
+
+ protected:
+    //! Fetches the data into a continuous linear array.
+    void getData(std::vector<double>* data) const override;
+
+    //! Sets the data from a continuous linear array.
+    void setData(const std::vector<double>& data) override;
+
+ private:
+    TiledArray3<double> _dataU;
+    TiledArray3<double> _dataV;
+    TiledArray3<double> _dataW;
+    Vector3D _dataOriginU;
+    Vector3D _dataOriginV;
+    Vector3D _dataOriginW;
+};
+
+//! Shared pointer type for the SparseFaceCenteredGrid3.
+typedef std::shared_ptr<SparseFaceCenteredGrid3> SparseFaceCenteredGrid3Ptr;
+
+//!
+//! \brief Front-end to create SparseFaceCenteredGrid3 objects step by step.
+//!
+class SparseFaceCenteredGrid3::Builder final {
+ public:
+    //! Returns builder with resolution.
+    Builder& withResolution(const Size3& resolution);
+
+    //! Returns builder with grid spacing.
+    Builder& withGridSpacing(const Vector3D& gridSpacing);
+
+    //! Returns builder with grid origin.
+    Builder& withOrigin(const Vector3D& gridOrigin);
+
+    //! Returns builder with background value.
+    Builder& withBackground(const Vector3D& background);
+
+    //! Builds SparseFaceCenteredGrid3 instance.
+    SparseFaceCenteredGrid3 build() const;
+
+    //! Builds shared pointer of SparseFaceCenteredGrid3 instance.
+    SparseFaceCenteredGrid3Ptr makeShared() const;
+
+ private:
+    Size3 _resolution{1, 1, 1};
+    Vector3D _gridSpacing{1, 1, 1};
+    Vector3D _gridOrigin{0, 0, 0};
+    Vector3D _background{0, 0, 0};
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_SPARSE_FACE_CENTERED_GRID3_H_
@@ -0,0 +1,153 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SPARSE_SCALAR_GRID3_H_
+#define INCLUDE_JET_SPARSE_SCALAR_GRID3_H_
+
+#include <jet/grid3.h>
+#include <jet/scalar_grid3.h>
+#include <jet/tiled_array3.h>
+
+#include <memory>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Abstract base class for 3-D sparse scalar grid structure.
+//!
+//! This class stores the grid data in a TiledArray3, so only the tiles of
+//! 8 x 8 x 8 data points that differ from the background value occupy memory.
+//! The grid samples the same way as ScalarGrid3 does, and converts from and
+//! to a dense ScalarGrid3 of the same data layout. The serialized form is the
+//! same as ScalarGrid3, so the dense and the sparse grids can read each other.
+//!
+class SparseScalarGrid3 : public ScalarField3, public Grid3 {
+ public:
+    //! Constructs an empty grid.
+    SparseScalarGrid3();
+
+    //! Default destructor.
+    virtual ~SparseScalarGrid3();
+
+    //! Returns the size of the grid data.
+    virtual Size3 dataSize() const = 0;
+
+    //! Returns data position for the grid point at (0, 0, 0).
+    virtual Vector3D dataOrigin() const = 0;
+
+    //! Returns the copy of the grid instance.
+    virtual std::shared_ptr<SparseScalarGrid3> clone() const = 0;
+
+    //! Deactivates all the tiles of the grid.
+    void clear();
+
+    //! Resizes the grid using given parameters and deactivates all the tiles.
+    void resize(const Size3& resolution,
+                const Vector3D& gridSpacing = Vector3D(1, 1, 1),
+                const Vector3D& origin = Vector3D(),
+                double background = 0.0);
+
+    //! Returns the grid data at given data point.
+    const double& operator()(size_t i, size_t j, size_t k) const;
+
+    //! Returns the gradient vector at given data point.
+    Vector3D gradientAtDataPoint(size_t i, size_t j, size_t k) const;
+
+    //! Returns the tiled data storage.
+    TiledArray3<double>& data();
+
+    //! Returns the tiled data storage.
+    const TiledArray3<double>& data() const;
+
+    //! Returns the function that maps data point to its position.
+    DataPositionFunc dataPosition() const;
+
+    //! Deactivates all the tiles and sets the background value to \p value.
+    void fill(double value);
+
+    //!
+    //! \brief Fills the grid with given position-to-value mapping function.
+    //!
+    //! The tiles whose values are all within \p tolerance from the
+    //! background value stay inactive. The function is evaluated in
+    //! parallel, once per data point.
+    //!
+    void fill(const std::function<double(const Vector3D&)>& func,
+              double tolerance = 0.0);
+
+    //! Copies the data from the dense grid \p other with the same data size,
+    //! activating the tiles farther than \p tolerance from the background.
+    void copyFrom(const ScalarGrid3& other, double tolerance = 0.0);
+
+    //! Copies the data to the dense grid \p other with the same data size.
+    void copyTo(ScalarGrid3* other) const;
+
+    //! Invokes \p func for each data point in the active tiles.
+    void forEachActiveDataPointIndex(
+        const std::function<void(size_t, size_t, size_t)>& func) const;
+
+    //! Invokes \p func for each data point in the active tiles parallelly.
+    void parallelForEachActiveDataPointIndex(
+        const std::function<void(size_t, size_t, size_t)>& func) const;
+
+    // ScalarField3 implementations
+
+    //! Returns the linearly sampled value at given position \p x.
+    double sample(const Vector3D& x) const override;
+
+    //! Returns the gradient vector at given position \p x.
+    Vector3D gradient(const Vector3D& x) const override;
+
+    //! Serializes the grid instance to the output buffer.
+    void serialize(std::vector<uint8_t>* buffer) const override;
+
+    //! Deserializes the input buffer to the grid instance.
+    void deserialize(const std::vector<uint8_t>& buffer) override;
+
+ protected:
+    //! Swaps the data storage with given grid.
+    void swapSparseScalarGrid(SparseScalarGrid3* other);
+
+    //! Sets the data storage with given grid.
+    void setSparseScalarGrid(const SparseScalarGrid3& other);
+
+    //! Fetches the data into a continuous linear array.
+    void getData(std::vector<double>* data) const override;
+
+    //! Sets the data from a continuous linear array.
+    void setData(const std::vector<double>& data) override;
+
+ private:
+    TiledArray3<double> _data;
+};
+
+//! Shared pointer for the SparseScalarGrid3 type.
+typedef std::shared_ptr<SparseScalarGrid3> SparseScalarGrid3Ptr;
+
+//! Abstract base class for 3-D sparse scalar grid builder.
+class SparseScalarGridBuilder3 {
+ public:
+    //! Creates a builder.
+    SparseScalarGridBuilder3();
+
+    //! Default destructor.
+    virtual ~SparseScalarGridBuilder3();
+
+    //! Returns 3-D sparse scalar grid with given parameters.
+    virtual SparseScalarGrid3Ptr build(
+        const Size3& resolution,
+        const Vector3D& gridSpacing,
+        const Vector3D& gridOrigin,
+        double background) const = 0;
+};
+
+//! Shared pointer for the SparseScalarGridBuilder3 type.
+typedef std::shared_ptr<SparseScalarGridBuilder3> SparseScalarGridBuilder3Ptr;
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_SPARSE_SCALAR_GRID3_H_
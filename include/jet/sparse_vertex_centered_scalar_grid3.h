@@ -0,0 +1,125 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_SPARSE_VERTEX_CENTERED_SCALAR_GRID3_H_
+#define INCLUDE_JET_SPARSE_VERTEX_CENTERED_SCALAR_GRID3_H_
+
+#include <jet/sparse_scalar_grid3.h>
+#include <utility>  // just make cpplint happy..
+
+namespace jet {
+
+//!
+//! \brief 3-D sparse vertex-centered scalar grid structure.
+//!
+//! This class represents 3-D vertex-centered scalar grid which extends
+//! SparseScalarGrid3. The data points are defined at the grid vertices
+//! like VertexCenteredScalarGrid3, but only the tiles that differ from the
+//! background value are stored.
+//!
+class SparseVertexCenteredScalarGrid3 final : public SparseScalarGrid3 {
+ public:
+    JET_GRID3_TYPE_NAME(SparseVertexCenteredScalarGrid3)
+
+    class Builder;
+
+    //! Constructs zero-sized grid.
+    SparseVertexCenteredScalarGrid3();
+
+    //! Constructs a grid with given resolution, grid spacing, origin and
+    //! background value.
+    SparseVertexCenteredScalarGrid3(
+        const Size3& resolution,
+        const Vector3D& gridSpacing = Vector3D(1.0, 1.0, 1.0),
+        const Vector3D& origin = Vector3D(),
+        double background = 0.0);
+
+    //! Copy constructor.
+    SparseVertexCenteredScalarGrid3(
+        const SparseVertexCenteredScalarGrid3& other);
+
+    //! Returns the actual data point size.
+    Size3 dataSize() const override;
+
+    //! Returns data position for the grid point at (0, 0, 0).
+    //! Note that this is different from origin() since origin() returns
+    //! the lower corner point of the bounding box.
+    Vector3D dataOrigin() const override;
+
+    //! Returns the copy of the grid instance.
+    std::shared_ptr<SparseScalarGrid3> clone() const override;
+
+    //!
+    //! \brief Swaps the contents with the given \p other grid.
+    //!
+    //! This function swaps the contents of the grid instance with the given
+    //! grid object \p other only if \p other has the same type with this grid.
+    //!
+    void swap(Grid3* other) override;
+
+    //! Sets the contents with the given \p other grid.
+    void set(const SparseVertexCenteredScalarGrid3& other);
+
+    //! Sets the contents with the given \p other grid.
+    SparseVertexCenteredScalarGrid3& operator=(
+        const SparseVertexCenteredScalarGrid3& other);
+
+    //! Returns builder fox SparseVertexCenteredScalarGrid3.
+    static Builder builder();
+};
+
+//! Shared pointer for the SparseVertexCenteredScalarGrid3 type.
+typedef std::shared_ptr<SparseVertexCenteredScalarGrid3>
+    SparseVertexCenteredScalarGrid3Ptr;
+
+//!
+//! \brief Front-end to create SparseVertexCenteredScalarGrid3 objects step by
+//!        step.
+//!
+class SparseVertexCenteredScalarGrid3::Builder final
+    : public SparseScalarGridBuilder3 {
+ public:
+    //! Returns builder with resolution.
+    Builder& withResolution(const Size3& resolution);
+
+    //! Returns builder with grid spacing.
+    Builder& withGridSpacing(const Vector3D& gridSpacing);
+
+    //! Returns builder with grid origin.
+    Builder& withOrigin(const Vector3D& gridOrigin);
+
+    //! Returns builder with background value.
+    Builder& withBackground(double background);
+
+    //! Builds SparseVertexCenteredScalarGrid3 instance.
+    SparseVertexCenteredScalarGrid3 build() const;
+
+    //! Builds shared pointer of SparseVertexCenteredScalarGrid3 instance.
+    SparseVertexCenteredScalarGrid3Ptr makeShared() const;
+
+    //!
+    //! \brief Builds shared pointer of SparseVertexCenteredScalarGrid3
+    //!        instance.
+    //!
+    //! This is an overriding function that implements
+    //! SparseScalarGridBuilder3.
+    //!
+    SparseScalarGrid3Ptr build(
+        const Size3& resolution,
+        const Vector3D& gridSpacing,
+        const Vector3D& gridOrigin,
+        double background) const override;
+
+ private:
+    Size3 _resolution{1, 1, 1};
+    Vector3D _gridSpacing{1, 1, 1};
+    Vector3D _gridOrigin{0, 0, 0};
+    double _background = 0.0;
+};
+
+}  // namespace jet
+
+#endif  // INCLUDE_JET_SPARSE_VERTEX_CENTERED_SCALAR_GRID3_H_
@@ -13,6 +13,7 @@
 #define INCLUDE_JET_SPH_KERNELS2_H_
 
 #include <jet/constants.h>
+#include <jet/simd.h>
 #include <jet/vector2.h>
 
 namespace jet {
@@ -61,6 +62,15 @@ struct SphStdKernel2 {
 
     //! Returns the second derivative at given distance.
     double secondDerivative(double distance) const;
+
+    //! Returns kernel function values at given distances.
+    SimdDouble operator()(const SimdDouble& distance) const;
+
+    //! Returns the first derivatives at given distances.
+    SimdDouble firstDerivative(const SimdDouble& distance) const;
+
+    //! Returns the second derivatives at given distances.
+    SimdDouble secondDerivative(const SimdDouble& distance) const;
 };
 
 //!
@@ -110,6 +120,15 @@ struct SphSpikyKernel2 {
 
     //! Returns the second derivative at given distance.
     double secondDerivative(double distance) const;
+
+    //! Returns kernel function values at given distances.
+    SimdDouble operator()(const SimdDouble& distance) const;
+
+    //! Returns the first derivatives at given distances.
+    SimdDouble firstDerivative(const SimdDouble& distance) const;
+
+    //! Returns the second derivatives at given distances.
+    SimdDouble secondDerivative(const SimdDouble& distance) const;
 };
 
 }  // namespace jet
@@ -69,6 +69,10 @@ class SphSystemData2 : public ParticleSystemData2 {
     //! This function updates the density array by recalculating each particle's
     //! latest nearby particles' position.
     //!
+    //! If the SoA layout is enabled and the neighbor lists are built, the
+    //! densities are computed from the neighbor lists and soaPositions() with
+    //! vectorized kernels instead.
+    //!
     //! \warning You must update the neighbor searcher
     //! (SphSystemData2::buildNeighborSearcher) before calling this function.
     //!
@@ -63,7 +63,13 @@ class SphSystemData3 : public ParticleSystemData3 {
     //! Returns the pressure array accessor (mutable).
     ArrayAccessor1<double> pressures();
 
-    //! Updates the density array with the latest particle positions.
+    //!
+    //! \brief Updates the density array with the latest particle positions.
+    //!
+    //! If the SoA layout is enabled and the neighbor lists are built, the
+    //! densities are computed from the neighbor lists and soaPositions() with
+    //! vectorized kernels. Otherwise, the neighbor searcher is used.
+    //!
     void updateDensities();
 
     //! Sets the target density of this particle system.
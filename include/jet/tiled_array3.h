@@ -0,0 +1,194 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef INCLUDE_JET_TILED_ARRAY3_H_
+#define INCLUDE_JET_TILED_ARRAY3_H_
+
+#include <jet/array_accessor3.h>
+#include <jet/size3.h>
+
+#include <type_traits>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief 3-D sparse array class made of fixed-size tiles.
+//!
+//! This class represents a 3-D array whose index space is split into tiles of
+//! 8 x 8 x 8 elements. Only the active tiles store their values, and the rest
+//! of the array reads the background value. A tile table maps each tile
+//! coordinate to the slot of its values in a contiguous pool, so the access
+//! costs one extra indirection compared to Array3, and the iteration over the
+//! active tiles walks the pool linearly. The values within a tile are stored
+//! i-first, j-next, k-last.
+//!
+//! Activating a tile may reallocate the pool, so tiles must be activated
+//! serially. Reading and writing the values of the active tiles is
+//! thread-safe as long as each element is written by one thread.
+//!
+//! \tparam T - Floating point type to store in the array.
+//!
+template <typename T>
+class TiledArray3 final {
+ public:
+    static_assert(std::is_floating_point<T>::value,
+                  "TiledArray3 only supports floating point types.");
+
+    //! Number of elements per tile along each axis.
+    static const size_t kTileSize = 8;
+
+    //! Number of elements per tile.
+    static const size_t kTileVolume = kTileSize * kTileSize * kTileSize;
+
+    //! Constructs zero-sized array.
+    TiledArray3();
+
+    //! Constructs array with given \p size and \p background value and no
+    //! active tile.
+    explicit TiledArray3(const Size3& size, const T& background = T());
+
+    //! Resizes the array and deactivates all the tiles.
+    void resize(const Size3& size, const T& background = T());
+
+    //! Deactivates all the tiles.
+    void clear();
+
+    //! Returns the size of the array.
+    const Size3& size() const;
+
+    //! Returns the number of tiles along each axis.
+    const Size3& tileResolution() const;
+
+    //! Returns the value of the elements in the inactive tiles.
+    const T& background() const;
+
+    //! Sets the background value and deactivates all the tiles.
+    void setBackground(const T& background);
+
+    //! Returns the number of active tiles.
+    size_t numberOfActiveTiles() const;
+
+    //! Returns the number of bytes allocated for the tiles and the table.
+    size_t memoryUsage() const;
+
+    //! Returns true if the tile at (\p ti, \p tj, \p tk) is active.
+    bool isTileActive(size_t ti, size_t tj, size_t tk) const;
+
+    //! Returns true if the element at (\p i, \p j, \p k) is in an active
+    //! tile.
+    bool isActive(size_t i, size_t j, size_t k) const;
+
+    //! Returns the element at (\p i, \p j, \p k), or the background value if
+    //! the element is not in an active tile.
+    const T& operator()(size_t i, size_t j, size_t k) const;
+
+    //! Returns the pointer to the element at (\p i, \p j, \p k) if it is in an
+    //! active tile, or nullptr otherwise.
+    T* find(size_t i, size_t j, size_t k);
+
+    //!
+    //! \brief Sets the element at (\p i, \p j, \p k) to \p value.
+    //!
+    //! The tile that contains the element is activated unless the value is
+    //! the same as the background.
+    //!
+    void set(size_t i, size_t j, size_t k, const T& value);
+
+    //!
+    //! \brief Activates the tile at (\p ti, \p tj, \p tk).
+    //!
+    //! A newly activated tile is filled with the background value. This
+    //! function returns the pointer to the first value of the tile, which is
+    //! valid until the next activation.
+    //!
+    T* activateTile(size_t ti, size_t tj, size_t tk);
+
+    //! Deactivates the tile at (\p ti, \p tj, \p tk).
+    void deactivateTile(size_t ti, size_t tj, size_t tk);
+
+    //!
+    //! \brief Deactivates the tiles whose values are all within \p tolerance
+    //!        from the background value.
+    //!
+    //! The remaining tiles keep their relative order in the pool.
+    //!
+    void prune(const T& tolerance = T());
+
+    //!
+    //! \brief Copies the dense array \p other into this array.
+    //!
+    //! Only the tiles that contain a value farther than \p tolerance from the
+    //! background value are activated. The size of \p other must be the same
+    //! as this array.
+    //!
+    void copyFrom(const ConstArrayAccessor3<T>& other,
+                  const T& tolerance = T());
+
+    //! Copies this array into the dense array \p other which must have the
+    //! same size.
+    void copyTo(ArrayAccessor3<T> other) const;
+
+    //!
+    //! \brief Iterates the active tiles and invokes \p func with the tile
+    //!        coordinate.
+    //!
+    //! The function is invoked in the order of the activation, which is the
+    //! order of the tiles in the pool.
+    //!
+    template <typename Callback>
+    void forEachActiveTile(Callback func) const;
+
+    //! Iterates the active tiles in parallel and invokes \p func with the
+    //! tile coordinate.
+    template <typename Callback>
+    void parallelForEachActiveTile(Callback func) const;
+
+    //! Iterates the elements of the active tiles within the array size and
+    //! invokes \p func with the element index.
+    template <typename Callback>
+    void forEachActiveIndex(Callback func) const;
+
+    //! Iterates the elements of the active tiles within the array size in
+    //! parallel, and invokes \p func with the element index. Each tile is
+    //! visited by a single thread.
+    template <typename Callback>
+    void parallelForEachActiveIndex(Callback func) const;
+
+    //! Swaps the content of the array with \p other array.
+    void swap(TiledArray3& other);
+
+ private:
+    static const size_t kInactiveTile = static_cast<size_t>(-1);
+
+    Size3 _size;
+    Size3 _tileResolution;
+    T _background = T();
+
+    // Pool slot of each tile, or kInactiveTile.
+    std::vector<size_t> _tileTable;
+
+    // Linear tile index of each pool slot.
+    std::vector<size_t> _activeTiles;
+
+    // Values of the active tiles, kTileVolume per slot.
+    std::vector<T> _values;
+
+    size_t tileIndex(size_t ti, size_t tj, size_t tk) const;
+
+    size_t slot(size_t i, size_t j, size_t k) const;
+
+    static size_t offset(size_t i, size_t j, size_t k);
+
+    template <typename Callback>
+    void forEachIndexInTile(size_t linearTileIndex, Callback func) const;
+};
+
+}  // namespace jet
+
+#include "detail/tiled_array3-inl.h"
+
+#endif  // INCLUDE_JET_TILED_ARRAY3_H_
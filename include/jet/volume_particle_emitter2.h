@@ -167,6 +167,10 @@ class VolumeParticleEmitter2 final : public ParticleEmitter2 {
     bool _isOneShot = true;
     bool _allowOverlapping = false;
 
+    // Kept across the updates to reuse the memory
+    Array1<Vector2D> _newPositions;
+    Array1<Vector2D> _newVelocities;
+
     //!
     //! \brief      Emits particles to the particle system data.
     //!
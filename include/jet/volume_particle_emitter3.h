@@ -166,6 +166,10 @@ class VolumeParticleEmitter3 final : public ParticleEmitter3 {
     bool _isOneShot = true;
     bool _allowOverlapping = false;
 
+    // Kept across the updates to reuse the memory
+    Array1<Vector3D> _newPositions;
+    Array1<Vector3D> _newVelocities;
+
     //!
     //! \brief      Emits particles to the particle system data.
     //!
@@ -5,7 +5,11 @@
 // property of any third parties.
 
 #include <pch.h>
+#include <narrow_band_helpers.h>
 #include <jet/advection_solver3.h>
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/sparse_vertex_centered_scalar_grid3.h>
+#include <jet/vertex_centered_scalar_grid3.h>
 #include <limits>
 
 using namespace jet;
@@ -16,6 +20,21 @@ AdvectionSolver3::AdvectionSolver3() {
 AdvectionSolver3::~AdvectionSolver3() {
 }
 
+void AdvectionSolver3::advectNarrowBand(
+    const ScalarGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    double bandWidth,
+    ScalarGrid3* output,
+    const ScalarField3& boundarySdf) {
+    advect(input, flow, dt, output, boundarySdf);
+
+    auto outputAcc = output->dataAccessor();
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        outputAcc(i, j, k) = clampToNarrowBand(outputAcc(i, j, k), bandWidth);
+    });
+}
+
 void AdvectionSolver3::advect(
     const CollocatedVectorGrid3& source,
     const VectorField3& flow,
@@ -41,3 +60,29 @@ void AdvectionSolver3::advect(
     UNUSED_VARIABLE(target);
     UNUSED_VARIABLE(boundarySdf);
 }
+
+void AdvectionSolver3::advect(
+    const SparseScalarGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    SparseScalarGrid3* output,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    ScalarGrid3Ptr source;
+    if (dynamic_cast<const SparseVertexCenteredScalarGrid3*>(&input)) {
+        source = std::make_shared<VertexCenteredScalarGrid3>(
+            input.resolution(), input.gridSpacing(), input.origin());
+    } else {
+        source = std::make_shared<CellCenteredScalarGrid3>(
+            input.resolution(), input.gridSpacing(), input.origin());
+    }
+    input.copyTo(source.get());
+
+    // Starts from the input so the points inside the boundary keep it.
+    ScalarGrid3Ptr target = source->clone();
+    advect(*source, flow, dt, target.get(), boundarySdf);
+
+    output->fill(input.data().background());
+    output->copyFrom(*target);
+}
@@ -6,7 +6,8 @@
 
 #include <pch.h>
 #include <jet/animation.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
+#include <jet/scratch_arena.h>
 
 #include "./private_helpers.h"
 
@@ -52,15 +53,19 @@ Animation::~Animation() {
 }
 
 void Animation::update(const Frame& frame) {
-    Timer timer;
+    Profiler::setFrameIndex(frame.index);
+    JET_PROFILE_SCOPE("Animation::update");
 
     JET_INFO << "Begin updating frame: " << frame.index
              << " timeIntervalInSeconds: " << frame.timeIntervalInSeconds
              << " (1/" << 1.0 / frame.timeIntervalInSeconds
              << ") seconds";
 
+    const size_t heapBytes = ScratchArena::heapBytesAllocated();
+
     onUpdate(frame);
 
-    JET_INFO << "End updating frame (took " << timer.durationInSeconds()
-             << " seconds)";
+    JET_INFO << "End updating frame (scratch buffers allocated "
+             << ScratchArena::heapBytesAllocated() - heapBytes
+             << " bytes from heap)";
 }
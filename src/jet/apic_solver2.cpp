@@ -35,72 +35,53 @@ void ApicSolver2::transferFromParticlesToGrids() {
     _cX.resize(numberOfParticles);
     _cY.resize(numberOfParticles);
 
-    // Clear velocity to zero
-    flow->fill(Vector2D());
-
     // Weighted-average velocity
     auto u = flow->uAccessor();
     auto v = flow->vAccessor();
     const auto uPos = flow->uPosition();
     const auto vPos = flow->vPosition();
-    Array2<double> uWeight(u.size());
-    Array2<double> vWeight(v.size());
     _uMarkers.resize(u.size());
     _vMarkers.resize(v.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
-    LinearArraySampler2<double, double> uSampler(
-        flow->uConstAccessor(),
-        flow->gridSpacing(),
-        flow->uOrigin());
-    LinearArraySampler2<double, double> vSampler(
-        flow->vConstAccessor(),
-        flow->gridSpacing(),
-        flow->vOrigin());
 
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point2UI, 4> indices;
-        std::array<double, 4> weights;
-
-        auto uPosClamped = positions[i];
-        uPosClamped.y = clamp(
-            uPosClamped.y,
-            bbox.lowerCorner.y + hh.y,
-            bbox.upperCorner.y - hh.y);
-        uSampler.getCoordinatesAndWeights(uPosClamped, &indices, &weights);
-        for (int j = 0; j < 4; ++j) {
-            Vector2D gridPos = uPos(indices[j].x, indices[j].y);
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        [&](size_t i) {
+            auto uPosClamped = positions[i];
+            uPosClamped.y = clamp(
+                uPosClamped.y,
+                bbox.lowerCorner.y + hh.y,
+                bbox.upperCorner.y - hh.y);
+            return uPosClamped;
+        },
+        [&](size_t i, const Vector2D& uPosClamped, const Point2UI& idx) {
+            Vector2D gridPos = uPos(idx.x, idx.y);
             double apicTerm = _cX[i].dot(gridPos - uPosClamped);
-            u(indices[j]) += weights[j] * (velocities[i].x + apicTerm);
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
-
-        auto vPosClamped = positions[i];
-        vPosClamped.x = clamp(
-            vPosClamped.x,
-            bbox.lowerCorner.x + hh.x,
-            bbox.upperCorner.x - hh.x);
-        vSampler.getCoordinatesAndWeights(vPosClamped, &indices, &weights);
-        for (int j = 0; j < 4; ++j) {
-            Vector2D gridPos = vPos(indices[j].x, indices[j].y);
+            return velocities[i].x + apicTerm;
+        },
+        flow->gridSpacing(),
+        flow->uOrigin(),
+        u,
+        _uMarkers.accessor());
+
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        [&](size_t i) {
+            auto vPosClamped = positions[i];
+            vPosClamped.x = clamp(
+                vPosClamped.x,
+                bbox.lowerCorner.x + hh.x,
+                bbox.upperCorner.x - hh.x);
+            return vPosClamped;
+        },
+        [&](size_t i, const Vector2D& vPosClamped, const Point2UI& idx) {
+            Vector2D gridPos = vPos(idx.x, idx.y);
             double apicTerm = _cY[i].dot(gridPos - vPosClamped);
-            v(indices[j]) += weights[j] * (velocities[i].y + apicTerm);
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-    }
-
-    uWeight.parallelForEachIndex([&](size_t i, size_t j) {
-        if (uWeight(i, j) > 0.0) {
-            u(i, j) /= uWeight(i, j);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j) {
-        if (vWeight(i, j) > 0.0) {
-            v(i, j) /= vWeight(i, j);
-        }
-    });
+            return velocities[i].y + apicTerm;
+        },
+        flow->gridSpacing(),
+        flow->vOrigin(),
+        v,
+        _vMarkers.accessor());
 }
 
 void ApicSolver2::transferFromGridsToParticles() {
@@ -157,6 +138,27 @@ void ApicSolver2::transferFromGridsToParticles() {
     });
 }
 
+void ApicSolver2::onParticlesReordered(const std::vector<size_t>& order) {
+    // Particles that are emitted in this time-step have no affine data yet,
+    // which is the same as starting from zero.
+    Array1<Vector2D> cX(order.size());
+    Array1<Vector2D> cY(order.size());
+
+    parallelFor(
+        kZeroSize,
+        order.size(),
+        [&](size_t i) {
+            const size_t j = order[i];
+            if (j < _cX.size()) {
+                cX[i] = _cX[j];
+                cY[i] = _cY[j];
+            }
+        });
+
+    _cX.swap(cX);
+    _cY.swap(cY);
+}
+
 ApicSolver2::Builder ApicSolver2::builder() {
     return Builder();
 }
@@ -37,9 +37,6 @@ void ApicSolver3::transferFromParticlesToGrids() {
     _cY.resize(numberOfParticles);
     _cZ.resize(numberOfParticles);
 
-    // Clear velocity to zero
-    flow->fill(Vector3D());
-
     // Weighted-average velocity
     auto u = flow->uAccessor();
     auto v = flow->vAccessor();
@@ -47,102 +44,81 @@ void ApicSolver3::transferFromParticlesToGrids() {
     const auto uPos = flow->uPosition();
     const auto vPos = flow->vPosition();
     const auto wPos = flow->wPosition();
-    Array3<double> uWeight(u.size());
-    Array3<double> vWeight(v.size());
-    Array3<double> wWeight(w.size());
     _uMarkers.resize(u.size());
     _vMarkers.resize(v.size());
     _wMarkers.resize(w.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
-    _wMarkers.set(0);
-    LinearArraySampler3<double, double> uSampler(
-        flow->uConstAccessor(),
-        flow->gridSpacing(),
-        flow->uOrigin());
-    LinearArraySampler3<double, double> vSampler(
-        flow->vConstAccessor(),
-        flow->gridSpacing(),
-        flow->vOrigin());
-    LinearArraySampler3<double, double> wSampler(
-        flow->wConstAccessor(),
-        flow->gridSpacing(),
-        flow->wOrigin());
 
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point3UI, 8> indices;
-        std::array<double, 8> weights;
-
-        auto uPosClamped = positions[i];
-        uPosClamped.y = clamp(
-            uPosClamped.y,
-            bbox.lowerCorner.y + hh.y,
-            bbox.upperCorner.y - hh.y);
-        uPosClamped.z = clamp(
-            uPosClamped.z,
-            bbox.lowerCorner.z + hh.z,
-            bbox.upperCorner.z - hh.z);
-        uSampler.getCoordinatesAndWeights(uPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = uPos(indices[j].x, indices[j].y, indices[j].z);
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        [&](size_t i) {
+            auto uPosClamped = positions[i];
+            uPosClamped.y = clamp(
+                uPosClamped.y,
+                bbox.lowerCorner.y + hh.y,
+                bbox.upperCorner.y - hh.y);
+            uPosClamped.z = clamp(
+                uPosClamped.z,
+                bbox.lowerCorner.z + hh.z,
+                bbox.upperCorner.z - hh.z);
+            return uPosClamped;
+        },
+        [&](size_t i, const Vector3D& uPosClamped, const Point3UI& idx) {
+            Vector3D gridPos = uPos(idx.x, idx.y, idx.z);
             double apicTerm = _cX[i].dot(gridPos - uPosClamped);
-            u(indices[j]) += weights[j] * (velocities[i].x + apicTerm);
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
-
-        auto vPosClamped = positions[i];
-        vPosClamped.x = clamp(
-            vPosClamped.x,
-            bbox.lowerCorner.x + hh.x,
-            bbox.upperCorner.x - hh.x);
-        vPosClamped.z = clamp(
-            vPosClamped.z,
-            bbox.lowerCorner.z + hh.z,
-            bbox.upperCorner.z - hh.z);
-        vSampler.getCoordinatesAndWeights(vPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = vPos(indices[j].x, indices[j].y, indices[j].z);
+            return velocities[i].x + apicTerm;
+        },
+        flow->gridSpacing(),
+        flow->uOrigin(),
+        u,
+        _uMarkers.accessor());
+
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        [&](size_t i) {
+            auto vPosClamped = positions[i];
+            vPosClamped.x = clamp(
+                vPosClamped.x,
+                bbox.lowerCorner.x + hh.x,
+                bbox.upperCorner.x - hh.x);
+            vPosClamped.z = clamp(
+                vPosClamped.z,
+                bbox.lowerCorner.z + hh.z,
+                bbox.upperCorner.z - hh.z);
+            return vPosClamped;
+        },
+        [&](size_t i, const Vector3D& vPosClamped, const Point3UI& idx) {
+            Vector3D gridPos = vPos(idx.x, idx.y, idx.z);
             double apicTerm = _cY[i].dot(gridPos - vPosClamped);
-            v(indices[j]) += weights[j] * (velocities[i].y + apicTerm);
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-
-        auto wPosClamped = positions[i];
-        wPosClamped.x = clamp(
-            wPosClamped.x,
-            bbox.lowerCorner.x + hh.x,
-            bbox.upperCorner.x - hh.x);
-        wPosClamped.y = clamp(
-            wPosClamped.y,
-            bbox.lowerCorner.y + hh.y,
-            bbox.upperCorner.y - hh.y);
-        wSampler.getCoordinatesAndWeights(wPosClamped, &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            Vector3D gridPos = wPos(indices[j].x, indices[j].y, indices[j].z);
+            return velocities[i].y + apicTerm;
+        },
+        flow->gridSpacing(),
+        flow->vOrigin(),
+        v,
+        _vMarkers.accessor());
+
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        [&](size_t i) {
+            auto wPosClamped = positions[i];
+            wPosClamped.x = clamp(
+                wPosClamped.x,
+                bbox.lowerCorner.x + hh.x,
+                bbox.upperCorner.x - hh.x);
+            wPosClamped.y = clamp(
+                wPosClamped.y,
+                bbox.lowerCorner.y + hh.y,
+                bbox.upperCorner.y - hh.y);
+            return wPosClamped;
+        },
+        [&](size_t i, const Vector3D& wPosClamped, const Point3UI& idx) {
+            Vector3D gridPos = wPos(idx.x, idx.y, idx.z);
             double apicTerm = _cZ[i].dot(gridPos - wPosClamped);
-            w(indices[j]) += weights[j] * (velocities[i].z + apicTerm);
-            wWeight(indices[j]) += weights[j];
-            _wMarkers(indices[j]) = 1;
-        }
-    }
-
-    uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (uWeight(i, j, k) > 0.0) {
-            u(i, j, k) /= uWeight(i, j, k);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (vWeight(i, j, k) > 0.0) {
-            v(i, j, k) /= vWeight(i, j, k);
-        }
-    });
-    wWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (wWeight(i, j, k) > 0.0) {
-            w(i, j, k) /= wWeight(i, j, k);
-        }
-    });
+            return velocities[i].z + apicTerm;
+        },
+        flow->gridSpacing(),
+        flow->wOrigin(),
+        w,
+        _wMarkers.accessor());
 }
 
 void ApicSolver3::transferFromGridsToParticles() {
@@ -228,6 +204,30 @@ void ApicSolver3::transferFromGridsToParticles() {
     });
 }
 
+void ApicSolver3::onParticlesReordered(const std::vector<size_t>& order) {
+    // Particles that are emitted in this time-step have no affine data yet,
+    // which is the same as starting from zero.
+    Array1<Vector3D> cX(order.size());
+    Array1<Vector3D> cY(order.size());
+    Array1<Vector3D> cZ(order.size());
+
+    parallelFor(
+        kZeroSize,
+        order.size(),
+        [&](size_t i) {
+            const size_t j = order[i];
+            if (j < _cX.size()) {
+                cX[i] = _cX[j];
+                cY[i] = _cY[j];
+                cZ[i] = _cZ[j];
+            }
+        });
+
+    _cX.swap(cX);
+    _cY.swap(cY);
+    _cZ.swap(cZ);
+}
+
 ApicSolver3::Builder ApicSolver3::builder() {
     return Builder();
 }
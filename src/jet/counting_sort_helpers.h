@@ -0,0 +1,64 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_COUNTING_SORT_HELPERS_H_
+#define SRC_JET_COUNTING_SORT_HELPERS_H_
+
+#include <jet/constants.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <atomic>
+
+namespace jet {
+
+// Sorts the indices of \p numberOfKeys keys by their keys with a parallel
+// counting sort. The keys must be less than \p numberOfBuckets. Each index
+// takes a slot in its bucket from an atomic counter, a prefix sum over the
+// counts gives the start of each bucket, and the indices are scattered to
+// their slots. The slots are taken in arbitrary order, so each bucket is
+// sorted at the end to make the result independent of thread scheduling.
+//
+// \p bucketCounts and \p slots are the scratch space for \p numberOfBuckets
+// counters and \p numberOfKeys slots. \p bucketStarts receives
+// numberOfBuckets + 1 offsets into \p sortedIndices, which receives
+// numberOfKeys indices.
+inline void parallelCountingSort(const size_t* keys, size_t numberOfKeys,
+                                 size_t numberOfBuckets,
+                                 std::atomic<size_t>* bucketCounts,
+                                 size_t* slots, size_t* bucketStarts,
+                                 size_t* sortedIndices) {
+    // Count
+    parallelFor(kZeroSize, numberOfBuckets, [&](size_t b) {
+        bucketCounts[b].store(0, std::memory_order_relaxed);
+    });
+    parallelFor(kZeroSize, numberOfKeys, [&](size_t i) {
+        slots[i] =
+            bucketCounts[keys[i]].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    // Prefix sum
+    size_t sum = 0;
+    for (size_t b = 0; b < numberOfBuckets; ++b) {
+        bucketStarts[b] = sum;
+        sum += bucketCounts[b].load(std::memory_order_relaxed);
+    }
+    bucketStarts[numberOfBuckets] = sum;
+
+    // Scatter
+    parallelFor(kZeroSize, numberOfKeys, [&](size_t i) {
+        sortedIndices[bucketStarts[keys[i]] + slots[i]] = i;
+    });
+
+    parallelFor(kZeroSize, numberOfBuckets, [&](size_t b) {
+        std::sort(sortedIndices + bucketStarts[b],
+                  sortedIndices + bucketStarts[b + 1]);
+    });
+}
+
+}  // namespace jet
+
+#endif  // SRC_JET_COUNTING_SORT_HELPERS_H_
@@ -0,0 +1,197 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_DIRTY_BLOCK_HELPERS_H_
+#define SRC_JET_DIRTY_BLOCK_HELPERS_H_
+
+#include <jet/array2.h>
+#include <jet/array3.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+
+namespace jet {
+
+// Width of the blocks in which the changes of a cell array are tracked.
+const size_t kDirtyBlockSize = 8;
+
+// Returns the number of blocks that cover \p size cells.
+inline Size2 dirtyBlockResolution(const Size2& size) {
+    return Size2((size.x + kDirtyBlockSize - 1) / kDirtyBlockSize,
+                 (size.y + kDirtyBlockSize - 1) / kDirtyBlockSize);
+}
+
+inline Size3 dirtyBlockResolution(const Size3& size) {
+    return Size3((size.x + kDirtyBlockSize - 1) / kDirtyBlockSize,
+                 (size.y + kDirtyBlockSize - 1) / kDirtyBlockSize,
+                 (size.z + kDirtyBlockSize - 1) / kDirtyBlockSize);
+}
+
+// Flags the blocks where \p cells differ from \p lastCells, which must have
+// the same size. Returns true if any block is flagged.
+inline bool markDirtyBlocks(const Array2<char>& cells,
+                            const Array2<char>& lastCells,
+                            Array2<char>* dirtyBlocks) {
+    const Size2 size = cells.size();
+    dirtyBlocks->resize(dirtyBlockResolution(size));
+
+    dirtyBlocks->parallelForEachIndex([&](size_t bi, size_t bj) {
+        const size_t iEnd = std::min(size.x, (bi + 1) * kDirtyBlockSize);
+        const size_t jEnd = std::min(size.y, (bj + 1) * kDirtyBlockSize);
+
+        char isDirty = 0;
+        for (size_t j = bj * kDirtyBlockSize; j < jEnd && !isDirty; ++j) {
+            for (size_t i = bi * kDirtyBlockSize; i < iEnd; ++i) {
+                if (cells(i, j) != lastCells(i, j)) {
+                    isDirty = 1;
+                    break;
+                }
+            }
+        }
+        (*dirtyBlocks)(bi, bj) = isDirty;
+    });
+
+    return std::any_of(dirtyBlocks->begin(), dirtyBlocks->end(),
+                       [](char isDirty) { return isDirty != 0; });
+}
+
+inline bool markDirtyBlocks(const Array3<char>& cells,
+                            const Array3<char>& lastCells,
+                            Array3<char>* dirtyBlocks) {
+    const Size3 size = cells.size();
+    dirtyBlocks->resize(dirtyBlockResolution(size));
+
+    dirtyBlocks->parallelForEachIndex([&](size_t bi, size_t bj, size_t bk) {
+        const size_t iEnd = std::min(size.x, (bi + 1) * kDirtyBlockSize);
+        const size_t jEnd = std::min(size.y, (bj + 1) * kDirtyBlockSize);
+        const size_t kEnd = std::min(size.z, (bk + 1) * kDirtyBlockSize);
+
+        char isDirty = 0;
+        for (size_t k = bk * kDirtyBlockSize; k < kEnd && !isDirty; ++k) {
+            for (size_t j = bj * kDirtyBlockSize; j < jEnd && !isDirty; ++j) {
+                for (size_t i = bi * kDirtyBlockSize; i < iEnd; ++i) {
+                    if (cells(i, j, k) != lastCells(i, j, k)) {
+                        isDirty = 1;
+                        break;
+                    }
+                }
+            }
+        }
+        (*dirtyBlocks)(bi, bj, bk) = isDirty;
+    });
+
+    return std::any_of(dirtyBlocks->begin(), dirtyBlocks->end(),
+                       [](char isDirty) { return isDirty != 0; });
+}
+
+// Flags the blocks of a coarser multigrid level with \p coarserSize cells
+// that are restricted from a flagged block of the finer level. A coarser
+// cell i reads the finer cells 2i - 1 to 2i + 2, so the coarser block b
+// reads the finer blocks 2b - 1 to 2b + 2.
+inline void coarsenDirtyBlocks(const Array2<char>& finer,
+                               const Size2& coarserSize,
+                               Array2<char>* coarser) {
+    const Size2 m = finer.size();
+    coarser->resize(dirtyBlockResolution(coarserSize));
+
+    coarser->parallelForEachIndex([&](size_t bi, size_t bj) {
+        const size_t iEnd = std::min(2 * bi + 3, m.x);
+        const size_t jEnd = std::min(2 * bj + 3, m.y);
+
+        char isDirty = 0;
+        for (size_t j = (bj > 0) ? 2 * bj - 1 : 0; j < jEnd; ++j) {
+            for (size_t i = (bi > 0) ? 2 * bi - 1 : 0; i < iEnd; ++i) {
+                isDirty |= finer(i, j);
+            }
+        }
+        (*coarser)(bi, bj) = isDirty;
+    });
+}
+
+inline void coarsenDirtyBlocks(const Array3<char>& finer,
+                               const Size3& coarserSize,
+                               Array3<char>* coarser) {
+    const Size3 m = finer.size();
+    coarser->resize(dirtyBlockResolution(coarserSize));
+
+    coarser->parallelForEachIndex([&](size_t bi, size_t bj, size_t bk) {
+        const size_t iEnd = std::min(2 * bi + 3, m.x);
+        const size_t jEnd = std::min(2 * bj + 3, m.y);
+        const size_t kEnd = std::min(2 * bk + 3, m.z);
+
+        char isDirty = 0;
+        for (size_t k = (bk > 0) ? 2 * bk - 1 : 0; k < kEnd; ++k) {
+            for (size_t j = (bj > 0) ? 2 * bj - 1 : 0; j < jEnd; ++j) {
+                for (size_t i = (bi > 0) ? 2 * bi - 1 : 0; i < iEnd; ++i) {
+                    isDirty |= finer(i, j, k);
+                }
+            }
+        }
+        (*coarser)(bi, bj, bk) = isDirty;
+    });
+}
+
+// Calls \p func(iBegin, iEnd, jBegin, jEnd) in parallel with the cell range
+// of each flagged block of an array with \p size cells. If \p withNeighbors
+// is true, the blocks that share a face with a flagged block are visited
+// too, which covers every row whose 5-point stencil reads a flagged cell.
+template <typename Callback>
+void parallelForEachDirtyBlock(const Array2<char>& dirtyBlocks,
+                               const Size2& size, bool withNeighbors,
+                               const Callback& func) {
+    const Size2 n = dirtyBlocks.size();
+
+    dirtyBlocks.parallelForEachIndex([&](size_t bi, size_t bj) {
+        bool isDirty = dirtyBlocks(bi, bj) != 0;
+        if (!isDirty && withNeighbors) {
+            isDirty = (bi > 0 && dirtyBlocks(bi - 1, bj)) ||
+                      (bi + 1 < n.x && dirtyBlocks(bi + 1, bj)) ||
+                      (bj > 0 && dirtyBlocks(bi, bj - 1)) ||
+                      (bj + 1 < n.y && dirtyBlocks(bi, bj + 1));
+        }
+
+        if (isDirty) {
+            func(bi * kDirtyBlockSize,
+                 std::min(size.x, (bi + 1) * kDirtyBlockSize),
+                 bj * kDirtyBlockSize,
+                 std::min(size.y, (bj + 1) * kDirtyBlockSize));
+        }
+    });
+}
+
+// Same as above for 3-D arrays and the 7-point stencil, with \p func called
+// as func(iBegin, iEnd, jBegin, jEnd, kBegin, kEnd).
+template <typename Callback>
+void parallelForEachDirtyBlock(const Array3<char>& dirtyBlocks,
+                               const Size3& size, bool withNeighbors,
+                               const Callback& func) {
+    const Size3 n = dirtyBlocks.size();
+
+    dirtyBlocks.parallelForEachIndex([&](size_t bi, size_t bj, size_t bk) {
+        bool isDirty = dirtyBlocks(bi, bj, bk) != 0;
+        if (!isDirty && withNeighbors) {
+            isDirty = (bi > 0 && dirtyBlocks(bi - 1, bj, bk)) ||
+                      (bi + 1 < n.x && dirtyBlocks(bi + 1, bj, bk)) ||
+                      (bj > 0 && dirtyBlocks(bi, bj - 1, bk)) ||
+                      (bj + 1 < n.y && dirtyBlocks(bi, bj + 1, bk)) ||
+                      (bk > 0 && dirtyBlocks(bi, bj, bk - 1)) ||
+                      (bk + 1 < n.z && dirtyBlocks(bi, bj, bk + 1));
+        }
+
+        if (isDirty) {
+            func(bi * kDirtyBlockSize,
+                 std::min(size.x, (bi + 1) * kDirtyBlockSize),
+                 bj * kDirtyBlockSize,
+                 std::min(size.y, (bj + 1) * kDirtyBlockSize),
+                 bk * kDirtyBlockSize,
+                 std::min(size.z, (bk + 1) * kDirtyBlockSize));
+        }
+    });
+}
+
+}  // namespace jet
+
+#endif  // SRC_JET_DIRTY_BLOCK_HELPERS_H_
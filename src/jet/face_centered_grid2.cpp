@@ -8,6 +8,7 @@
 
 #include <jet/array_samplers2.h>
 #include <jet/face_centered_grid2.h>
+#include <jet/grid_samplers2.h>
 #include <jet/parallel.h>
 #include <jet/serial.h>
 
@@ -334,11 +335,9 @@ void FaceCenteredGrid2::resetSampler() {
     _uLinearSampler = uSampler;
     _vLinearSampler = vSampler;
 
-    _sampler = [uSampler, vSampler](const Vector2D& x) -> Vector2D {
-        double u = uSampler(x);
-        double v = vSampler(x);
-        return Vector2D(u, v);
-    };
+    _sampler = LinearFaceCenteredArraySampler2<double, double>(
+        _dataU.constAccessor(), _dataV.constAccessor(), gridSpacing(),
+        _dataOriginU, _dataOriginV);
 }
 
 FaceCenteredGrid2::Builder FaceCenteredGrid2::builder() { return Builder(); }
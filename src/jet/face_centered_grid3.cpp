@@ -8,6 +8,7 @@
 
 #include <jet/array_samplers3.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/grid_samplers3.h>
 #include <jet/parallel.h>
 #include <jet/serial.h>
 
@@ -458,12 +459,10 @@ void FaceCenteredGrid3::resetSampler() {
     _vLinearSampler = vSampler;
     _wLinearSampler = wSampler;
 
-    _sampler = [uSampler, vSampler, wSampler](const Vector3D& x) -> Vector3D {
-        double u = uSampler(x);
-        double v = vSampler(x);
-        double w = wSampler(x);
-        return Vector3D(u, v, w);
-    };
+    _sampler = LinearFaceCenteredArraySampler3<double, double>(
+        _dataU.constAccessor(), _dataV.constAccessor(),
+        _dataW.constAccessor(), gridSpacing(), _dataOriginU, _dataOriginV,
+        _dataOriginW);
 }
 
 FaceCenteredGrid3::Builder FaceCenteredGrid3::builder() { return Builder(); }
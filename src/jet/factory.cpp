@@ -22,6 +22,8 @@
 #include <jet/point_parallel_hash_grid_searcher3.h>
 #include <jet/point_simple_list_searcher2.h>
 #include <jet/point_simple_list_searcher3.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
+#include <jet/sparse_vertex_centered_scalar_grid3.h>
 #include <jet/vertex_centered_scalar_grid2.h>
 #include <jet/vertex_centered_scalar_grid3.h>
 #include <jet/vertex_centered_vector_grid2.h>
@@ -38,6 +40,8 @@ std::unordered_map<std::string, ScalarGridBuilder2Ptr> sScalarGrid2Builders;
 std::unordered_map<std::string, ScalarGridBuilder3Ptr> sScalarGrid3Builders;
 std::unordered_map<std::string, VectorGridBuilder2Ptr> sVectorGrid2Builders;
 std::unordered_map<std::string, VectorGridBuilder3Ptr> sVectorGrid3Builders;
+std::unordered_map<std::string, SparseScalarGridBuilder3Ptr>
+    sSparseScalarGrid3Builders;
 
 std::unordered_map<std::string, PointNeighborSearcherBuilder2Ptr>
     sPointNeighborSearcher2Builders;
@@ -61,6 +65,9 @@ std::unordered_map<std::string, PointNeighborSearcherBuilder3Ptr>
 #define REGISTER_VECTOR_GRID3_BUILDER(ClassName) \
     REGISTER_BUILDER(sVectorGrid3Builders, ClassName)
 
+#define REGISTER_SPARSE_SCALAR_GRID3_BUILDER(ClassName) \
+    REGISTER_BUILDER(sSparseScalarGrid3Builders, ClassName)
+
 #define REGISTER_POINT_NEIGHBOR_SEARCHER2_BUILDER(ClassName) \
     REGISTER_BUILDER(sPointNeighborSearcher2Builders, ClassName)
 
@@ -84,6 +91,9 @@ class Registry {
         REGISTER_VECTOR_GRID3_BUILDER(FaceCenteredGrid3)
         REGISTER_VECTOR_GRID3_BUILDER(VertexCenteredVectorGrid3)
 
+        REGISTER_SPARSE_SCALAR_GRID3_BUILDER(SparseCellCenteredScalarGrid3)
+        REGISTER_SPARSE_SCALAR_GRID3_BUILDER(SparseVertexCenteredScalarGrid3)
+
         REGISTER_POINT_NEIGHBOR_SEARCHER2_BUILDER(PointHashGridSearcher2)
         REGISTER_POINT_NEIGHBOR_SEARCHER2_BUILDER(
             PointParallelHashGridSearcher2)
@@ -140,6 +150,17 @@ VectorGrid3Ptr Factory::buildVectorGrid3(const std::string& name) {
     }
 }
 
+SparseScalarGrid3Ptr Factory::buildSparseScalarGrid3(
+    const std::string& name) {
+    auto result = sSparseScalarGrid3Builders.find(name);
+    if (result != sSparseScalarGrid3Builders.end()) {
+        auto builder = result->second;
+        return builder->build({0, 0, 0}, {1, 1, 1}, {0, 0, 0}, 0.0);
+    } else {
+        return nullptr;
+    }
+}
+
 PointNeighborSearcher2Ptr Factory::buildPointNeighborSearcher2(
     const std::string& name) {
     auto result = sPointNeighborSearcher2Builders.find(name);
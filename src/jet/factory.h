@@ -9,6 +9,7 @@
 
 #include <jet/scalar_grid2.h>
 #include <jet/scalar_grid3.h>
+#include <jet/sparse_scalar_grid3.h>
 #include <jet/vector_grid2.h>
 #include <jet/vector_grid3.h>
 #include <jet/point_neighbor_searcher2.h>
@@ -27,6 +28,9 @@ class Factory {
 
     static VectorGrid3Ptr buildVectorGrid3(const std::string& name);
 
+    static SparseScalarGrid3Ptr buildSparseScalarGrid3(
+        const std::string& name);
+
     static PointNeighborSearcher2Ptr buildPointNeighborSearcher2(
         const std::string& name);
 
@@ -0,0 +1,148 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_FAST_SWEEPING_HELPERS_H_
+#define SRC_JET_FAST_SWEEPING_HELPERS_H_
+
+#include <jet/constants.h>
+#include <jet/level_set_utils.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+#include <jet/point3.h>
+#include <jet/size3.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace jet {
+
+// Block sizes for the parallel sweeps. The blocks are swept serially, so the
+// parallel loop is launched once per hyperplane of blocks instead of once per
+// hyperplane of grid points.
+const size_t kSweepBlockSize2 = 64;
+const size_t kSweepBlockSize3 = 16;
+
+// Visits the indices (i, j, k) in [0, size) with i + j + k = l.
+template <typename Callback>
+inline void forEachIndexOnPlane(const Size3& size, size_t l,
+                                const Callback& func) {
+    const size_t kBegin =
+        (l + 2 > size.x + size.y) ? l + 2 - size.x - size.y : 0;
+    const size_t kEnd = std::min(size.z, l + 1);
+
+    for (size_t k = kBegin; k < kEnd; ++k) {
+        const size_t ij = l - k;
+        const size_t jBegin = (ij + 1 > size.x) ? ij + 1 - size.x : 0;
+        const size_t jEnd = std::min(size.y, ij + 1);
+
+        for (size_t j = jBegin; j < jEnd; ++j) {
+            func(ij - j, j, k);
+        }
+    }
+}
+
+// Visits every grid point once in the lexicographic order flipped along the
+// given axes. The grid is split into blocks which are swept serially, and the
+// blocks on the same hyperplane bi + bj + bk = const only depend on the blocks
+// on the previous hyperplanes, so each hyperplane of blocks is visited in
+// parallel. Every point still sees its upwind neighbors updated and its
+// downwind neighbors not, so the result is identical to the serial sweep.
+template <typename Callback>
+inline void sweepBlocks(const Size3& size, bool flipX, bool flipY, bool flipZ,
+                        const Callback& func) {
+    if (size.x == 0 || size.y == 0 || size.z == 0) {
+        return;
+    }
+
+    const size_t bs = kSweepBlockSize3;
+    const Size3 numberOfBlocks((size.x + bs - 1) / bs, (size.y + bs - 1) / bs,
+                               (size.z + bs - 1) / bs);
+    const size_t numberOfPlanes =
+        numberOfBlocks.x + numberOfBlocks.y + numberOfBlocks.z - 2;
+
+    std::vector<Point3UI> blocks;
+
+    for (size_t l = 0; l < numberOfPlanes; ++l) {
+        blocks.clear();
+        forEachIndexOnPlane(numberOfBlocks, l,
+                            [&](size_t bi, size_t bj, size_t bk) {
+                                blocks.push_back(Point3UI(bi, bj, bk));
+                            });
+
+        const ExecutionPolicy policy = (blocks.size() > 1)
+                                           ? ExecutionPolicy::kParallel
+                                           : ExecutionPolicy::kSerial;
+
+        parallelFor(kZeroSize, blocks.size(), [&](size_t n) {
+            const Point3UI& b = blocks[n];
+            const size_t iEnd = std::min(size.x, (b.x + 1) * bs);
+            const size_t jEnd = std::min(size.y, (b.y + 1) * bs);
+            const size_t kEnd = std::min(size.z, (b.z + 1) * bs);
+
+            for (size_t k = b.z * bs; k < kEnd; ++k) {
+                for (size_t j = b.y * bs; j < jEnd; ++j) {
+                    for (size_t i = b.x * bs; i < iEnd; ++i) {
+                        func(flipX ? size.x - 1 - i : i,
+                             flipY ? size.y - 1 - j : j,
+                             flipZ ? size.z - 1 - k : k);
+                    }
+                }
+            }
+        }, policy);
+    }
+}
+
+// Returns the distance from the grid point to the interface crossing the
+// edge towards the neighbor, or kMaxD if the edge does not cross it.
+inline double distanceToInterface(double phi, double phiNeighbor, double h) {
+    if (isInsideSdf(phi) == isInsideSdf(phiNeighbor)) {
+        return kMaxD;
+    }
+
+    const double absPhi = std::fabs(phi);
+    return h * absPhi / (absPhi + std::fabs(phiNeighbor));
+}
+
+// Solves the first-order upwind (Godunov) discretization of |grad(d)| = 1
+// given the smaller neighbor along each axis. Axes whose neighbors are
+// larger than the solution do not contribute.
+template <size_t N>
+inline double solveEikonal(const std::array<double, N>& phi,
+                           const std::array<double, N>& gridSpacing) {
+    std::array<std::pair<double, double>, N> terms;
+    for (size_t n = 0; n < N; ++n) {
+        terms[n] = std::make_pair(phi[n], gridSpacing[n]);
+    }
+    std::sort(terms.begin(), terms.end());
+
+    double solution = terms[0].first + terms[0].second;
+    double a = 0.0;
+    double b = 0.0;
+    double c = -1.0;
+
+    for (size_t n = 0; n < N && solution > terms[n].first; ++n) {
+        const double invHSqr = 1.0 / square(terms[n].second);
+        a += invHSqr;
+        b -= terms[n].first * invHSqr;
+        c += square(terms[n].first) * invHSqr;
+
+        const double det = b * b - a * c;
+        if (det < 0.0) {
+            break;
+        }
+
+        solution = (-b + std::sqrt(det)) / a;
+    }
+
+    return solution;
+}
+
+}  // namespace jet
+
+#endif  // SRC_JET_FAST_SWEEPING_HELPERS_H_
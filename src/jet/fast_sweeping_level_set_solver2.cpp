@@ -0,0 +1,294 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <fast_sweeping_helpers.h>
+#include <jet/fast_sweeping_level_set_solver2.h>
+#include <jet/level_set_utils.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+static const char kUnknown = 0;
+static const char kKnown = 1;
+static const char kComputed = 2;
+
+// Visits every grid point four times, once for each sweep ordering. The grid
+// is split into blocks which are swept serially, and the blocks on the same
+// diagonal bi + bj = const only depend on the blocks on the previous
+// diagonals, so each diagonal of blocks is visited in parallel. Every point
+// still sees its upwind neighbors updated and its downwind neighbors not, so
+// the result is identical to the serial sweep.
+template <typename Callback>
+inline void sweep(const Size2& size, const Callback& func) {
+    if (size.x == 0 || size.y == 0) {
+        return;
+    }
+
+    const size_t bs = kSweepBlockSize2;
+    const Size2 numberOfBlocks((size.x + bs - 1) / bs, (size.y + bs - 1) / bs);
+    const size_t numberOfDiagonals = numberOfBlocks.x + numberOfBlocks.y - 1;
+
+    for (int ordering = 0; ordering < 4; ++ordering) {
+        const bool flipX = (ordering & 1) != 0;
+        const bool flipY = (ordering & 2) != 0;
+
+        for (size_t l = 0; l < numberOfDiagonals; ++l) {
+            const size_t bjBegin =
+                (l + 1 > numberOfBlocks.x) ? l + 1 - numberOfBlocks.x : 0;
+            const size_t bjEnd = std::min(numberOfBlocks.y, l + 1);
+
+            const ExecutionPolicy policy = (bjEnd - bjBegin > 1)
+                                               ? ExecutionPolicy::kParallel
+                                               : ExecutionPolicy::kSerial;
+
+            parallelFor(bjBegin, bjEnd, [&](size_t bj) {
+                const size_t bi = l - bj;
+                const size_t iEnd = std::min(size.x, (bi + 1) * bs);
+                const size_t jEnd = std::min(size.y, (bj + 1) * bs);
+
+                for (size_t j = bj * bs; j < jEnd; ++j) {
+                    for (size_t i = bi * bs; i < iEnd; ++i) {
+                        func(flipX ? size.x - 1 - i : i,
+                             flipY ? size.y - 1 - j : j);
+                    }
+                }
+            }, policy);
+        }
+    }
+}
+
+FastSweepingLevelSetSolver2::FastSweepingLevelSetSolver2() {}
+
+void FastSweepingLevelSetSolver2::reinitialize(const ScalarGrid2& inputSdf,
+                                               double maxDistance,
+                                               ScalarGrid2* outputSdf) {
+    JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
+
+    const Size2 size = inputSdf.dataSize();
+    const Vector2D gridSpacing = inputSdf.gridSpacing();
+    const auto input = inputSdf.constDataAccessor();
+
+    Array2<double> dist(size, kMaxD);
+    Array2<char> markers(size, kUnknown);
+
+    // Solve geometrically near the boundary
+    markers.parallelForEachIndex([&](size_t i, size_t j) {
+        const double phi = input(i, j);
+        double distX = kMaxD;
+        double distY = kMaxD;
+
+        if (i > 0) {
+            distX = std::min(distX, distanceToInterface(
+                phi, input(i - 1, j), gridSpacing.x));
+        }
+        if (i + 1 < size.x) {
+            distX = std::min(distX, distanceToInterface(
+                phi, input(i + 1, j), gridSpacing.x));
+        }
+        if (j > 0) {
+            distY = std::min(distY, distanceToInterface(
+                phi, input(i, j - 1), gridSpacing.y));
+        }
+        if (j + 1 < size.y) {
+            distY = std::min(distY, distanceToInterface(
+                phi, input(i, j + 1), gridSpacing.y));
+        }
+
+        if (distX < kMaxD || distY < kMaxD) {
+            double denomSqr = 0.0;
+            if (distX < kMaxD) {
+                denomSqr += 1.0 / square(distX);
+            }
+            if (distY < kMaxD) {
+                denomSqr += 1.0 / square(distY);
+            }
+
+            dist(i, j) = 1.0 / std::sqrt(denomSqr);
+            markers(i, j) = kKnown;
+        }
+    });
+
+    // Propagate the unsigned distance
+    sweep(size, [&](size_t i, size_t j) {
+        if (markers(i, j) == kKnown) {
+            return;
+        }
+
+        double phiX = kMaxD;
+        double phiY = kMaxD;
+
+        if (i > 0) {
+            phiX = std::min(phiX, dist(i - 1, j));
+        }
+        if (i + 1 < size.x) {
+            phiX = std::min(phiX, dist(i + 1, j));
+        }
+        if (j > 0) {
+            phiY = std::min(phiY, dist(i, j - 1));
+        }
+        if (j + 1 < size.y) {
+            phiY = std::min(phiY, dist(i, j + 1));
+        }
+
+        // The solution is larger than the smallest neighbor, so it can
+        // neither improve the current value nor fall within the max distance.
+        const double cutoff = std::min(dist(i, j), maxDistance);
+        if (std::min(phiX, phiY) >= cutoff) {
+            return;
+        }
+
+        dist(i, j) = std::min(
+            dist(i, j),
+            solveEikonal<2>({{phiX, phiY}}, {{gridSpacing.x, gridSpacing.y}}));
+    });
+
+    // Restore the sign, and keep the input beyond the max distance
+    auto output = outputSdf->dataAccessor();
+    markers.parallelForEachIndex([&](size_t i, size_t j) {
+        const double phi = input(i, j);
+        if (dist(i, j) <= maxDistance) {
+            output(i, j) = isInsideSdf(phi) ? -dist(i, j) : dist(i, j);
+        } else {
+            output(i, j) = phi;
+        }
+    });
+}
+
+void FastSweepingLevelSetSolver2::extrapolate(const ScalarGrid2& input,
+                                              const ScalarField2& sdf,
+                                              double maxDistance,
+                                              ScalarGrid2* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    Array2<double> sdfGrid(input.dataSize());
+    auto pos = input.dataPosition();
+    sdfGrid.parallelForEachIndex([&](size_t i, size_t j) {
+        sdfGrid(i, j) = sdf.sample(pos(i, j));
+    });
+
+    extrapolate(input.constDataAccessor(), sdfGrid.constAccessor(),
+                input.gridSpacing(), maxDistance, output->dataAccessor());
+}
+
+void FastSweepingLevelSetSolver2::extrapolate(
+    const CollocatedVectorGrid2& input, const ScalarField2& sdf,
+    double maxDistance, CollocatedVectorGrid2* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    Array2<double> sdfGrid(input.dataSize());
+    auto pos = input.dataPosition();
+    sdfGrid.parallelForEachIndex([&](size_t i, size_t j) {
+        sdfGrid(i, j) = sdf.sample(pos(i, j));
+    });
+
+    const Vector2D gridSpacing = input.gridSpacing();
+
+    Array2<double> u(input.dataSize());
+    Array2<double> u0(input.dataSize());
+    Array2<double> v(input.dataSize());
+    Array2<double> v0(input.dataSize());
+
+    input.parallelForEachDataPointIndex([&](size_t i, size_t j) {
+        u(i, j) = input(i, j).x;
+        v(i, j) = input(i, j).y;
+    });
+
+    extrapolate(u, sdfGrid.constAccessor(), gridSpacing, maxDistance, u0);
+
+    extrapolate(v, sdfGrid.constAccessor(), gridSpacing, maxDistance, v0);
+
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j) {
+        (*output)(i, j).x = u0(i, j);
+        (*output)(i, j).y = v0(i, j);
+    });
+}
+
+void FastSweepingLevelSetSolver2::extrapolate(const FaceCenteredGrid2& input,
+                                              const ScalarField2& sdf,
+                                              double maxDistance,
+                                              FaceCenteredGrid2* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    const Vector2D gridSpacing = input.gridSpacing();
+
+    auto u = input.uConstAccessor();
+    auto uPos = input.uPosition();
+    Array2<double> sdfAtU(u.size());
+    input.parallelForEachUIndex([&](size_t i, size_t j) {
+        sdfAtU(i, j) = sdf.sample(uPos(i, j));
+    });
+
+    extrapolate(u, sdfAtU, gridSpacing, maxDistance, output->uAccessor());
+
+    auto v = input.vConstAccessor();
+    auto vPos = input.vPosition();
+    Array2<double> sdfAtV(v.size());
+    input.parallelForEachVIndex([&](size_t i, size_t j) {
+        sdfAtV(i, j) = sdf.sample(vPos(i, j));
+    });
+
+    extrapolate(v, sdfAtV, gridSpacing, maxDistance, output->vAccessor());
+}
+
+void FastSweepingLevelSetSolver2::extrapolate(
+    const ConstArrayAccessor2<double>& input,
+    const ConstArrayAccessor2<double>& sdf, const Vector2D& gridSpacing,
+    double maxDistance, ArrayAccessor2<double> output) {
+    const Size2 size = input.size();
+    const Vector2D invGridSpacingSqr = 1.0 / (gridSpacing * gridSpacing);
+
+    // Build markers
+    Array2<char> markers(size, kUnknown);
+    markers.parallelForEachIndex([&](size_t i, size_t j) {
+        if (isInsideSdf(sdf(i, j))) {
+            markers(i, j) = kKnown;
+        }
+        output(i, j) = input(i, j);
+    });
+
+    // Solves grad(sdf) . grad(output) = 0 with the upwind neighbors which
+    // have smaller sdf.
+    sweep(size, [&](size_t i, size_t j) {
+        const double phi = sdf(i, j);
+        if (markers(i, j) == kKnown || phi > maxDistance) {
+            return;
+        }
+
+        double sum = 0.0;
+        double weightSum = 0.0;
+
+        auto accumulate = [&](size_t ni, size_t nj, double invHSqr) {
+            const double phiNb = sdf(ni, nj);
+            if (markers(ni, nj) != kUnknown && phiNb < phi) {
+                const double weight = (phi - phiNb) * invHSqr;
+                sum += weight * output(ni, nj);
+                weightSum += weight;
+            }
+        };
+
+        if (i > 0) {
+            accumulate(i - 1, j, invGridSpacingSqr.x);
+        }
+        if (i + 1 < size.x) {
+            accumulate(i + 1, j, invGridSpacingSqr.x);
+        }
+        if (j > 0) {
+            accumulate(i, j - 1, invGridSpacingSqr.y);
+        }
+        if (j + 1 < size.y) {
+            accumulate(i, j + 1, invGridSpacingSqr.y);
+        }
+
+        if (weightSum > 0.0) {
+            output(i, j) = sum / weightSum;
+            markers(i, j) = kComputed;
+        }
+    });
+}
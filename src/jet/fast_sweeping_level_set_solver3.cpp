@@ -0,0 +1,300 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <fast_sweeping_helpers.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
+#include <jet/level_set_utils.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace jet;
+
+static const char kUnknown = 0;
+static const char kKnown = 1;
+static const char kComputed = 2;
+
+// Visits every grid point eight times, once for each sweep ordering.
+template <typename Callback>
+inline void sweep(const Size3& size, const Callback& func) {
+    for (int ordering = 0; ordering < 8; ++ordering) {
+        sweepBlocks(size, (ordering & 1) != 0, (ordering & 2) != 0,
+                    (ordering & 4) != 0, func);
+    }
+}
+
+FastSweepingLevelSetSolver3::FastSweepingLevelSetSolver3() {}
+
+void FastSweepingLevelSetSolver3::reinitialize(const ScalarGrid3& inputSdf,
+                                               double maxDistance,
+                                               ScalarGrid3* outputSdf) {
+    JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
+
+    const Size3 size = inputSdf.dataSize();
+    const Vector3D gridSpacing = inputSdf.gridSpacing();
+    const auto input = inputSdf.constDataAccessor();
+
+    Array3<double> dist(size, kMaxD);
+    Array3<char> markers(size, kUnknown);
+
+    // Solve geometrically near the boundary
+    markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const double phi = input(i, j, k);
+        double distX = kMaxD;
+        double distY = kMaxD;
+        double distZ = kMaxD;
+
+        if (i > 0) {
+            distX = std::min(distX, distanceToInterface(
+                phi, input(i - 1, j, k), gridSpacing.x));
+        }
+        if (i + 1 < size.x) {
+            distX = std::min(distX, distanceToInterface(
+                phi, input(i + 1, j, k), gridSpacing.x));
+        }
+        if (j > 0) {
+            distY = std::min(distY, distanceToInterface(
+                phi, input(i, j - 1, k), gridSpacing.y));
+        }
+        if (j + 1 < size.y) {
+            distY = std::min(distY, distanceToInterface(
+                phi, input(i, j + 1, k), gridSpacing.y));
+        }
+        if (k > 0) {
+            distZ = std::min(distZ, distanceToInterface(
+                phi, input(i, j, k - 1), gridSpacing.z));
+        }
+        if (k + 1 < size.z) {
+            distZ = std::min(distZ, distanceToInterface(
+                phi, input(i, j, k + 1), gridSpacing.z));
+        }
+
+        if (distX < kMaxD || distY < kMaxD || distZ < kMaxD) {
+            double denomSqr = 0.0;
+            if (distX < kMaxD) {
+                denomSqr += 1.0 / square(distX);
+            }
+            if (distY < kMaxD) {
+                denomSqr += 1.0 / square(distY);
+            }
+            if (distZ < kMaxD) {
+                denomSqr += 1.0 / square(distZ);
+            }
+
+            dist(i, j, k) = 1.0 / std::sqrt(denomSqr);
+            markers(i, j, k) = kKnown;
+        }
+    });
+
+    // Propagate the unsigned distance
+    sweep(size, [&](size_t i, size_t j, size_t k) {
+        if (markers(i, j, k) == kKnown) {
+            return;
+        }
+
+        double phiX = kMaxD;
+        double phiY = kMaxD;
+        double phiZ = kMaxD;
+
+        if (i > 0) {
+            phiX = std::min(phiX, dist(i - 1, j, k));
+        }
+        if (i + 1 < size.x) {
+            phiX = std::min(phiX, dist(i + 1, j, k));
+        }
+        if (j > 0) {
+            phiY = std::min(phiY, dist(i, j - 1, k));
+        }
+        if (j + 1 < size.y) {
+            phiY = std::min(phiY, dist(i, j + 1, k));
+        }
+        if (k > 0) {
+            phiZ = std::min(phiZ, dist(i, j, k - 1));
+        }
+        if (k + 1 < size.z) {
+            phiZ = std::min(phiZ, dist(i, j, k + 1));
+        }
+
+        // The solution is larger than the smallest neighbor, so it can
+        // neither improve the current value nor fall within the max distance.
+        const double cutoff = std::min(dist(i, j, k), maxDistance);
+        if (min3(phiX, phiY, phiZ) >= cutoff) {
+            return;
+        }
+
+        dist(i, j, k) = std::min(
+            dist(i, j, k),
+            solveEikonal<3>({{phiX, phiY, phiZ}},
+                            {{gridSpacing.x, gridSpacing.y, gridSpacing.z}}));
+    });
+
+    // Restore the sign, and keep the input beyond the max distance
+    auto output = outputSdf->dataAccessor();
+    markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const double phi = input(i, j, k);
+        if (dist(i, j, k) <= maxDistance) {
+            output(i, j, k) = isInsideSdf(phi) ? -dist(i, j, k) : dist(i, j, k);
+        } else {
+            output(i, j, k) = phi;
+        }
+    });
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(const ScalarGrid3& input,
+                                              const ScalarField3& sdf,
+                                              double maxDistance,
+                                              ScalarGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    Array3<double> sdfGrid(input.dataSize());
+    auto pos = input.dataPosition();
+    sdfGrid.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.sample(pos(i, j, k));
+    });
+
+    extrapolate(input.constDataAccessor(), sdfGrid.constAccessor(),
+                input.gridSpacing(), maxDistance, output->dataAccessor());
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(
+    const CollocatedVectorGrid3& input, const ScalarField3& sdf,
+    double maxDistance, CollocatedVectorGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    Array3<double> sdfGrid(input.dataSize());
+    auto pos = input.dataPosition();
+    sdfGrid.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        sdfGrid(i, j, k) = sdf.sample(pos(i, j, k));
+    });
+
+    const Vector3D gridSpacing = input.gridSpacing();
+
+    Array3<double> u(input.dataSize());
+    Array3<double> u0(input.dataSize());
+    Array3<double> v(input.dataSize());
+    Array3<double> v0(input.dataSize());
+    Array3<double> w(input.dataSize());
+    Array3<double> w0(input.dataSize());
+
+    input.parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        u(i, j, k) = input(i, j, k).x;
+        v(i, j, k) = input(i, j, k).y;
+        w(i, j, k) = input(i, j, k).z;
+    });
+
+    extrapolate(u, sdfGrid.constAccessor(), gridSpacing, maxDistance, u0);
+
+    extrapolate(v, sdfGrid.constAccessor(), gridSpacing, maxDistance, v0);
+
+    extrapolate(w, sdfGrid.constAccessor(), gridSpacing, maxDistance, w0);
+
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        (*output)(i, j, k).x = u0(i, j, k);
+        (*output)(i, j, k).y = v0(i, j, k);
+        (*output)(i, j, k).z = w0(i, j, k);
+    });
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(const FaceCenteredGrid3& input,
+                                              const ScalarField3& sdf,
+                                              double maxDistance,
+                                              FaceCenteredGrid3* output) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    const Vector3D gridSpacing = input.gridSpacing();
+
+    auto u = input.uConstAccessor();
+    auto uPos = input.uPosition();
+    Array3<double> sdfAtU(u.size());
+    input.parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtU(i, j, k) = sdf.sample(uPos(i, j, k));
+    });
+
+    extrapolate(u, sdfAtU, gridSpacing, maxDistance, output->uAccessor());
+
+    auto v = input.vConstAccessor();
+    auto vPos = input.vPosition();
+    Array3<double> sdfAtV(v.size());
+    input.parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtV(i, j, k) = sdf.sample(vPos(i, j, k));
+    });
+
+    extrapolate(v, sdfAtV, gridSpacing, maxDistance, output->vAccessor());
+
+    auto w = input.wConstAccessor();
+    auto wPos = input.wPosition();
+    Array3<double> sdfAtW(w.size());
+    input.parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
+        sdfAtW(i, j, k) = sdf.sample(wPos(i, j, k));
+    });
+
+    extrapolate(w, sdfAtW, gridSpacing, maxDistance, output->wAccessor());
+}
+
+void FastSweepingLevelSetSolver3::extrapolate(
+    const ConstArrayAccessor3<double>& input,
+    const ConstArrayAccessor3<double>& sdf, const Vector3D& gridSpacing,
+    double maxDistance, ArrayAccessor3<double> output) {
+    const Size3 size = input.size();
+    const Vector3D invGridSpacingSqr = 1.0 / (gridSpacing * gridSpacing);
+
+    // Build markers
+    Array3<char> markers(size, kUnknown);
+    markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        if (isInsideSdf(sdf(i, j, k))) {
+            markers(i, j, k) = kKnown;
+        }
+        output(i, j, k) = input(i, j, k);
+    });
+
+    // Solves grad(sdf) . grad(output) = 0 with the upwind neighbors which
+    // have smaller sdf.
+    sweep(size, [&](size_t i, size_t j, size_t k) {
+        const double phi = sdf(i, j, k);
+        if (markers(i, j, k) == kKnown || phi > maxDistance) {
+            return;
+        }
+
+        double sum = 0.0;
+        double weightSum = 0.0;
+
+        auto accumulate = [&](size_t ni, size_t nj, size_t nk, double invHSqr) {
+            const double phiNb = sdf(ni, nj, nk);
+            if (markers(ni, nj, nk) != kUnknown && phiNb < phi) {
+                const double weight = (phi - phiNb) * invHSqr;
+                sum += weight * output(ni, nj, nk);
+                weightSum += weight;
+            }
+        };
+
+        if (i > 0) {
+            accumulate(i - 1, j, k, invGridSpacingSqr.x);
+        }
+        if (i + 1 < size.x) {
+            accumulate(i + 1, j, k, invGridSpacingSqr.x);
+        }
+        if (j > 0) {
+            accumulate(i, j - 1, k, invGridSpacingSqr.y);
+        }
+        if (j + 1 < size.y) {
+            accumulate(i, j + 1, k, invGridSpacingSqr.y);
+        }
+        if (k > 0) {
+            accumulate(i, j, k - 1, invGridSpacingSqr.z);
+        }
+        if (k + 1 < size.z) {
+            accumulate(i, j, k + 1, invGridSpacingSqr.z);
+        }
+
+        if (weightSum > 0.0) {
+            output(i, j, k) = sum / weightSum;
+            markers(i, j, k) = kComputed;
+        }
+    });
+}
@@ -0,0 +1,233 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/cg.h>
+#include <jet/constants.h>
+#include <jet/fdm_amgpcg_solver3.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+// Visits the non-zero elements of the rows of the dense matrix in the
+// increasing order of the columns.
+struct DenseRowVisitor {
+    const FdmMatrix3& a;
+
+    template <typename Callback>
+    void operator()(size_t c, const Callback& func) const {
+        const Size3 size = a.size();
+        const size_t strideZ = size.x * size.y;
+        const size_t i = c % size.x;
+        const size_t j = (c / size.x) % size.y;
+        const size_t k = c / strideZ;
+
+        if (k > 0 && a(i, j, k - 1).front != 0.0) {
+            func(c - strideZ, a(i, j, k - 1).front);
+        }
+        if (j > 0 && a(i, j - 1, k).up != 0.0) {
+            func(c - size.x, a(i, j - 1, k).up);
+        }
+        if (i > 0 && a(i - 1, j, k).right != 0.0) {
+            func(c - 1, a(i - 1, j, k).right);
+        }
+        func(c, a(i, j, k).center);
+        if (i + 1 < size.x && a(i, j, k).right != 0.0) {
+            func(c + 1, a(i, j, k).right);
+        }
+        if (j + 1 < size.y && a(i, j, k).up != 0.0) {
+            func(c + size.x, a(i, j, k).up);
+        }
+        if (k + 1 < size.z && a(i, j, k).front != 0.0) {
+            func(c + strideZ, a(i, j, k).front);
+        }
+    }
+};
+
+// Visits the non-zero elements of the rows of the stencil matrix in the
+// increasing order of the columns.
+struct StencilRowVisitor {
+    const FdmStencilMatrix3& a;
+
+    template <typename Callback>
+    void operator()(size_t row, const Callback& func) const {
+        // The lower neighbors come in the decreasing order of the rows.
+        size_t lowerRows[3];
+        double lowerValues[3];
+        size_t numberOfLowerNeighbors = 0;
+        a.forEachLowerNeighbor(row, [&](size_t neighbor, double value) {
+            lowerRows[numberOfLowerNeighbors] = neighbor;
+            lowerValues[numberOfLowerNeighbors] = value;
+            ++numberOfLowerNeighbors;
+        });
+        while (numberOfLowerNeighbors > 0) {
+            --numberOfLowerNeighbors;
+            func(lowerRows[numberOfLowerNeighbors],
+                 lowerValues[numberOfLowerNeighbors]);
+        }
+
+        func(row, static_cast<double>(a.rows[row].center));
+        a.forEachUpperNeighbor(row, func);
+    }
+};
+
+// Builds the compressed matrix with given number of rows, where
+// forEachRowNonZero(row, func) visits the non-zero elements of the row.
+template <typename Visitor>
+void buildCompressedMatrix(size_t numberOfRows,
+                           const Visitor& forEachRowNonZero,
+                           MatrixCsrD* result) {
+    std::vector<size_t> pointers(numberOfRows + 1, 0);
+    parallelFor(kZeroSize, numberOfRows, [&](size_t row) {
+        forEachRowNonZero(row, [&](size_t, double) { ++pointers[row + 1]; });
+    });
+    for (size_t row = 0; row < numberOfRows; ++row) {
+        pointers[row + 1] += pointers[row];
+    }
+
+    result->reserve(numberOfRows, numberOfRows, pointers[numberOfRows]);
+    std::copy(pointers.begin(), pointers.end(), result->rowPointersBegin());
+    auto columns = result->columnIndicesBegin();
+    double* values = result->nonZeroData();
+    parallelFor(kZeroSize, numberOfRows, [&](size_t row) {
+        size_t pos = pointers[row];
+        forEachRowNonZero(row, [&](size_t column, double value) {
+            columns[pos] = column;
+            values[pos] = value;
+            ++pos;
+        });
+    });
+}
+
+}  // namespace
+
+void FdmAmgpcgSolver3::Preconditioner::solve(const VectorND& b, VectorND* x) {
+    hierarchy->vCycle(b, x);
+}
+
+FdmAmgpcgSolver3::FdmAmgpcgSolver3(unsigned int maxNumberOfIterations,
+                                   double tolerance,
+                                   const AmgParameters& params)
+    : _maxNumberOfIterations(maxNumberOfIterations),
+      _lastNumberOfIterations(0),
+      _tolerance(tolerance),
+      _lastResidualNorm(kMaxD),
+      _params(params) {}
+
+bool FdmAmgpcgSolver3::solve(FdmLinearSystem3* system) {
+    const FdmMatrix3& matrix = system->A;
+    const Size3 size = matrix.size();
+    const size_t numberOfRows = size.x * size.y * size.z;
+
+    JET_ASSERT(matrix.size() == system->b.size());
+    JET_ASSERT(matrix.size() == system->x.size());
+
+    buildCompressedMatrix(numberOfRows, DenseRowVisitor{matrix},
+                          &_compSystem.A);
+
+    _compSystem.b.resize(numberOfRows);
+    _compSystem.x.resize(numberOfRows);
+    parallelFor(kZeroSize, numberOfRows, [&](size_t row) {
+        _compSystem.b[row] = system->b[row];
+        _compSystem.x[row] = system->x[row];
+    });
+
+    const bool result = solveCompressed(&_compSystem);
+
+    parallelFor(kZeroSize, numberOfRows,
+                [&](size_t row) { system->x[row] = _compSystem.x[row]; });
+
+    return result;
+}
+
+bool FdmAmgpcgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
+    return solveCsr(system->A, system->b, &system->x);
+}
+
+bool FdmAmgpcgSolver3::solveStencil(FdmStencilLinearSystem3* system) {
+    const FdmStencilMatrix3& matrix = system->A;
+
+    JET_ASSERT(matrix.numberOfRows() == system->b.size());
+    JET_ASSERT(matrix.numberOfRows() == system->x.size());
+
+    buildCompressedMatrix(matrix.numberOfRows(), StencilRowVisitor{matrix},
+                          &_compSystem.A);
+
+    return solveCsr(_compSystem.A, system->b, &system->x);
+}
+
+unsigned int FdmAmgpcgSolver3::maxNumberOfIterations() const {
+    return _maxNumberOfIterations;
+}
+
+unsigned int FdmAmgpcgSolver3::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+double FdmAmgpcgSolver3::tolerance() const { return _tolerance; }
+
+double FdmAmgpcgSolver3::lastResidual() const { return _lastResidualNorm; }
+
+const AmgParameters& FdmAmgpcgSolver3::params() const { return _params; }
+
+size_t FdmAmgpcgSolver3::lastNumberOfLevels() const {
+    return _hierarchy.numberOfLevels();
+}
+
+bool FdmAmgpcgSolver3::isReusingHierarchy() const {
+    return _isReusingHierarchy;
+}
+
+void FdmAmgpcgSolver3::setIsReusingHierarchy(bool isReusing) {
+    _isReusingHierarchy = isReusing;
+}
+
+bool FdmAmgpcgSolver3::isLastHierarchyReused() const {
+    return _isLastHierarchyReused;
+}
+
+bool FdmAmgpcgSolver3::solveCsr(const MatrixCsrD& matrix, const VectorND& rhs,
+                                VectorND* solution) {
+    size_t size = solution->size();
+    _r.resize(size);
+    _d.resize(size);
+    _q.resize(size);
+    _s.resize(size);
+
+    if (!isUsingInitialGuess()) {
+        solution->set(0.0);
+    }
+    _r.set(0.0);
+    _d.set(0.0);
+    _q.set(0.0);
+    _s.set(0.0);
+
+    _isLastHierarchyReused =
+        _isReusingHierarchy && _hierarchy.hasSameSparsity(matrix);
+    if (_isLastHierarchyReused) {
+        _hierarchy.rebuild(matrix);
+    } else {
+        _hierarchy.build(matrix, _params);
+    }
+    _precond.hierarchy = &_hierarchy;
+
+    pcg<FdmCompressedBlas3, Preconditioner>(
+        matrix, rhs, _maxNumberOfIterations, _tolerance, &_precond, solution,
+        &_r, &_d, &_q, &_s, &_lastNumberOfIterations, &_lastResidualNorm);
+
+    JET_INFO << "Residual after solving AMGPCG: " << _lastResidualNorm
+             << " Number of AMGPCG iterations: " << _lastNumberOfIterations
+             << " Number of AMG levels: " << _hierarchy.numberOfLevels();
+
+    return _lastResidualNorm <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
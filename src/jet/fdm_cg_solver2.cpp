@@ -12,6 +12,30 @@
 
 using namespace jet;
 
+namespace {
+
+// Relative residual reduction of each single-precision correction solve.
+// Float CG stagnates around 1e-6, so stop well before that.
+const double kRefinementReduction = 1e-4;
+
+// Computes r = b - Ax in double precision and stores it in float.
+void computeResidual(const FdmMatrix2& a, const FdmVector2& x,
+                     const FdmVector2& b, FdmVector2F* result) {
+    Size2 size = a.size();
+
+    a.parallelForEachIndex([&](size_t i, size_t j) {
+        const double r =
+            b(i, j) - a(i, j).center * x(i, j) -
+            ((i > 0) ? a(i - 1, j).right * x(i - 1, j) : 0.0) -
+            ((i + 1 < size.x) ? a(i, j).right * x(i + 1, j) : 0.0) -
+            ((j > 0) ? a(i, j - 1).up * x(i, j - 1) : 0.0) -
+            ((j + 1 < size.y) ? a(i, j).up * x(i, j + 1) : 0.0);
+        (*result)(i, j) = static_cast<float>(r);
+    });
+}
+
+}  // namespace
+
 FdmCgSolver2::FdmCgSolver2(unsigned int maxNumberOfIterations, double tolerance)
     : _maxNumberOfIterations(maxNumberOfIterations),
       _lastNumberOfIterations(0),
@@ -26,7 +50,12 @@ bool FdmCgSolver2::solve(FdmLinearSystem2* system) {
     JET_ASSERT(matrix.size() == rhs.size());
     JET_ASSERT(matrix.size() == solution.size());
 
+    if (_isUsingSinglePrecision) {
+        return solveMixedPrecision(system);
+    }
+
     clearCompressedVectors();
+    clearSinglePrecisionVectors();
 
     Size2 size = matrix.size();
     _r.resize(size);
@@ -34,7 +63,9 @@ bool FdmCgSolver2::solve(FdmLinearSystem2* system) {
     _q.resize(size);
     _s.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
     _r.set(0.0);
     _d.set(0.0);
     _q.set(0.0);
@@ -47,12 +78,31 @@ bool FdmCgSolver2::solve(FdmLinearSystem2* system) {
            _lastNumberOfIterations < _maxNumberOfIterations;
 }
 
+bool FdmCgSolver2::solve(FdmLinearSystem2F* system) {
+    JET_ASSERT(system->A.size() == system->b.size());
+    JET_ASSERT(system->A.size() == system->x.size());
+
+    clearUncompressedVectors();
+    clearCompressedVectors();
+    _residualF.clear();
+    _correctionF.clear();
+
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0f);
+    }
+    solveSinglePrecision(system, _tolerance, _maxNumberOfIterations);
+
+    return _lastResidual <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
 bool FdmCgSolver2::solveCompressed(FdmCompressedLinearSystem2* system) {
     MatrixCsrD& matrix = system->A;
     VectorND& solution = system->x;
     VectorND& rhs = system->b;
 
     clearUncompressedVectors();
+    clearSinglePrecisionVectors();
 
     size_t size = solution.size();
     _rComp.resize(size);
@@ -60,7 +110,9 @@ bool FdmCgSolver2::solveCompressed(FdmCompressedLinearSystem2* system) {
     _qComp.resize(size);
     _sComp.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
     _rComp.set(0.0);
     _dComp.set(0.0);
     _qComp.set(0.0);
@@ -86,6 +138,87 @@ double FdmCgSolver2::tolerance() const { return _tolerance; }
 
 double FdmCgSolver2::lastResidual() const { return _lastResidual; }
 
+bool FdmCgSolver2::isUsingSinglePrecision() const {
+    return _isUsingSinglePrecision;
+}
+
+void FdmCgSolver2::setIsUsingSinglePrecision(bool isUsing) {
+    _isUsingSinglePrecision = isUsing;
+}
+
+void FdmCgSolver2::solveSinglePrecision(FdmLinearSystem2F* system,
+                                        double tolerance,
+                                        unsigned int maxNumberOfIterations) {
+    Size2 size = system->A.size();
+    _rF.resize(size);
+    _dF.resize(size);
+    _qF.resize(size);
+    _sF.resize(size);
+
+    cg<FdmBlas2F>(system->A, system->b, maxNumberOfIterations, tolerance,
+                  &system->x, &_rF, &_dF, &_qF, &_sF,
+                  &_lastNumberOfIterations, &_lastResidual);
+}
+
+bool FdmCgSolver2::solveMixedPrecision(FdmLinearSystem2* system) {
+    const FdmMatrix2& matrix = system->A;
+    FdmVector2& solution = system->x;
+    const FdmVector2& rhs = system->b;
+
+    clearUncompressedVectors();
+    clearCompressedVectors();
+
+    Size2 size = matrix.size();
+    _residualF.resize(size);
+    _correctionF.resize(size);
+    _rF.resize(size);
+    _dF.resize(size);
+    _qF.resize(size);
+    _sF.resize(size);
+
+    if (!isUsingInitialGuess()) {
+        solution.set(0.0);
+    }
+    computeResidual(matrix, solution, rhs, &_residualF);
+    double residual = FdmBlas2F::l2Norm(_residualF);
+
+    unsigned int numberOfIterations = 0;
+    while (residual > _tolerance &&
+           numberOfIterations < _maxNumberOfIterations) {
+        // Solve A e = r with float vectors, then x = x + e and r = b - Ax in
+        // double
+        _correctionF.set(0.0f);
+        cg<FdmMixedBlas2>(matrix, _residualF,
+                          _maxNumberOfIterations - numberOfIterations,
+                          std::max(_tolerance,
+                                   kRefinementReduction * residual),
+                          &_correctionF, &_rF, &_dF, &_qF, &_sF,
+                          &_lastNumberOfIterations, &_lastResidual);
+        numberOfIterations += _lastNumberOfIterations;
+
+        solution.parallelForEachIndex([&](size_t i, size_t j) {
+            solution(i, j) += _correctionF(i, j);
+        });
+
+        computeResidual(matrix, solution, rhs, &_residualF);
+        const double newResidual = FdmBlas2F::l2Norm(_residualF);
+
+        // Stop if the float solve cannot reduce the residual anymore
+        const bool isStagnated =
+            _lastNumberOfIterations == 0 || newResidual >= residual;
+        residual = newResidual;
+        if (isStagnated) {
+            break;
+        }
+    }
+
+    _lastNumberOfIterations = numberOfIterations;
+    _lastResidual = residual;
+
+    return _lastResidual <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
 void FdmCgSolver2::clearUncompressedVectors() {
     _r.clear();
     _d.clear();
@@ -99,3 +232,12 @@ void FdmCgSolver2::clearCompressedVectors() {
     _qComp.clear();
     _sComp.clear();
 }
+
+void FdmCgSolver2::clearSinglePrecisionVectors() {
+    _rF.clear();
+    _dF.clear();
+    _qF.clear();
+    _sF.clear();
+    _residualF.clear();
+    _correctionF.clear();
+}
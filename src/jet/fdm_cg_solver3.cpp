@@ -11,6 +11,32 @@
 
 using namespace jet;
 
+namespace {
+
+// Relative residual reduction of each single-precision correction solve.
+// Float CG stagnates around 1e-6, so stop well before that.
+const double kRefinementReduction = 1e-4;
+
+// Computes r = b - Ax in double precision and stores it in float.
+void computeResidual(const FdmMatrix3& a, const FdmVector3& x,
+                     const FdmVector3& b, FdmVector3F* result) {
+    Size3 size = a.size();
+
+    a.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const double r =
+            b(i, j, k) - a(i, j, k).center * x(i, j, k) -
+            ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : 0.0) -
+            ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : 0.0) -
+            ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : 0.0) -
+            ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : 0.0) -
+            ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : 0.0) -
+            ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : 0.0);
+        (*result)(i, j, k) = static_cast<float>(r);
+    });
+}
+
+}  // namespace
+
 FdmCgSolver3::FdmCgSolver3(unsigned int maxNumberOfIterations, double tolerance)
     : _maxNumberOfIterations(maxNumberOfIterations),
       _lastNumberOfIterations(0),
@@ -25,7 +51,12 @@ bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
     JET_ASSERT(matrix.size() == rhs.size());
     JET_ASSERT(matrix.size() == solution.size());
 
+    if (_isUsingSinglePrecision) {
+        return solveMixedPrecision(system);
+    }
+
     clearCompressedVectors();
+    clearSinglePrecisionVectors();
 
     Size3 size = matrix.size();
     _r.resize(size);
@@ -33,7 +64,9 @@ bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
     _q.resize(size);
     _s.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
     _r.set(0.0);
     _d.set(0.0);
     _q.set(0.0);
@@ -46,12 +79,31 @@ bool FdmCgSolver3::solve(FdmLinearSystem3* system) {
            _lastNumberOfIterations < _maxNumberOfIterations;
 }
 
+bool FdmCgSolver3::solve(FdmLinearSystem3F* system) {
+    JET_ASSERT(system->A.size() == system->b.size());
+    JET_ASSERT(system->A.size() == system->x.size());
+
+    clearUncompressedVectors();
+    clearCompressedVectors();
+    _residualF.clear();
+    _correctionF.clear();
+
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0f);
+    }
+    solveSinglePrecision(system, _tolerance, _maxNumberOfIterations);
+
+    return _lastResidual <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
 bool FdmCgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
     MatrixCsrD& matrix = system->A;
     VectorND& solution = system->x;
     VectorND& rhs = system->b;
 
     clearUncompressedVectors();
+    clearSinglePrecisionVectors();
 
     size_t size = solution.size();
     _rComp.resize(size);
@@ -59,7 +111,9 @@ bool FdmCgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
     _qComp.resize(size);
     _sComp.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
     _rComp.set(0.0);
     _dComp.set(0.0);
     _qComp.set(0.0);
@@ -73,6 +127,39 @@ bool FdmCgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
            _lastNumberOfIterations < _maxNumberOfIterations;
 }
 
+bool FdmCgSolver3::solveStencil(FdmStencilLinearSystem3* system) {
+    FdmStencilMatrix3& matrix = system->A;
+    VectorND& solution = system->x;
+    VectorND& rhs = system->b;
+
+    JET_ASSERT(matrix.numberOfRows() == rhs.size());
+    JET_ASSERT(matrix.numberOfRows() == solution.size());
+
+    clearUncompressedVectors();
+    clearSinglePrecisionVectors();
+
+    size_t size = solution.size();
+    _rComp.resize(size);
+    _dComp.resize(size);
+    _qComp.resize(size);
+    _sComp.resize(size);
+
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
+    _rComp.set(0.0);
+    _dComp.set(0.0);
+    _qComp.set(0.0);
+    _sComp.set(0.0);
+
+    cg<FdmStencilBlas3>(matrix, rhs, _maxNumberOfIterations, _tolerance,
+                        &solution, &_rComp, &_dComp, &_qComp, &_sComp,
+                        &_lastNumberOfIterations, &_lastResidual);
+
+    return _lastResidual <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
 unsigned int FdmCgSolver3::maxNumberOfIterations() const {
     return _maxNumberOfIterations;
 }
@@ -85,6 +172,87 @@ double FdmCgSolver3::tolerance() const { return _tolerance; }
 
 double FdmCgSolver3::lastResidual() const { return _lastResidual; }
 
+bool FdmCgSolver3::isUsingSinglePrecision() const {
+    return _isUsingSinglePrecision;
+}
+
+void FdmCgSolver3::setIsUsingSinglePrecision(bool isUsing) {
+    _isUsingSinglePrecision = isUsing;
+}
+
+void FdmCgSolver3::solveSinglePrecision(FdmLinearSystem3F* system,
+                                        double tolerance,
+                                        unsigned int maxNumberOfIterations) {
+    Size3 size = system->A.size();
+    _rF.resize(size);
+    _dF.resize(size);
+    _qF.resize(size);
+    _sF.resize(size);
+
+    cg<FdmBlas3F>(system->A, system->b, maxNumberOfIterations, tolerance,
+                  &system->x, &_rF, &_dF, &_qF, &_sF,
+                  &_lastNumberOfIterations, &_lastResidual);
+}
+
+bool FdmCgSolver3::solveMixedPrecision(FdmLinearSystem3* system) {
+    const FdmMatrix3& matrix = system->A;
+    FdmVector3& solution = system->x;
+    const FdmVector3& rhs = system->b;
+
+    clearUncompressedVectors();
+    clearCompressedVectors();
+
+    Size3 size = matrix.size();
+    _residualF.resize(size);
+    _correctionF.resize(size);
+    _rF.resize(size);
+    _dF.resize(size);
+    _qF.resize(size);
+    _sF.resize(size);
+
+    if (!isUsingInitialGuess()) {
+        solution.set(0.0);
+    }
+    computeResidual(matrix, solution, rhs, &_residualF);
+    double residual = FdmBlas3F::l2Norm(_residualF);
+
+    unsigned int numberOfIterations = 0;
+    while (residual > _tolerance &&
+           numberOfIterations < _maxNumberOfIterations) {
+        // Solve A e = r with float vectors, then x = x + e and r = b - Ax in
+        // double
+        _correctionF.set(0.0f);
+        cg<FdmMixedBlas3>(matrix, _residualF,
+                          _maxNumberOfIterations - numberOfIterations,
+                          std::max(_tolerance,
+                                   kRefinementReduction * residual),
+                          &_correctionF, &_rF, &_dF, &_qF, &_sF,
+                          &_lastNumberOfIterations, &_lastResidual);
+        numberOfIterations += _lastNumberOfIterations;
+
+        solution.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            solution(i, j, k) += _correctionF(i, j, k);
+        });
+
+        computeResidual(matrix, solution, rhs, &_residualF);
+        const double newResidual = FdmBlas3F::l2Norm(_residualF);
+
+        // Stop if the float solve cannot reduce the residual anymore
+        const bool isStagnated =
+            _lastNumberOfIterations == 0 || newResidual >= residual;
+        residual = newResidual;
+        if (isStagnated) {
+            break;
+        }
+    }
+
+    _lastNumberOfIterations = numberOfIterations;
+    _lastResidual = residual;
+
+    return _lastResidual <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
 void FdmCgSolver3::clearUncompressedVectors() {
     _r.clear();
     _d.clear();
@@ -98,3 +266,12 @@ void FdmCgSolver3::clearCompressedVectors() {
     _qComp.clear();
     _sComp.clear();
 }
+
+void FdmCgSolver3::clearSinglePrecisionVectors() {
+    _rF.clear();
+    _dF.clear();
+    _qF.clear();
+    _sF.clear();
+    _residualF.clear();
+    _correctionF.clear();
+}
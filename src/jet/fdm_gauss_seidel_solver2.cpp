@@ -11,6 +11,72 @@
 
 using namespace jet;
 
+namespace {
+
+template <typename Matrix, typename Vector>
+void relaxImpl(const Matrix& A, const Vector& b, double sorFactor,
+               Vector* x_) {
+    Size2 size = A.size();
+    Vector& x = *x_;
+
+    A.forEachIndex([&](size_t i, size_t j) {
+        double r = ((i > 0) ? A(i - 1, j).right * x(i - 1, j) : 0.0) +
+                   ((i + 1 < size.x) ? A(i, j).right * x(i + 1, j) : 0.0) +
+                   ((j > 0) ? A(i, j - 1).up * x(i, j - 1) : 0.0) +
+                   ((j + 1 < size.y) ? A(i, j).up * x(i, j + 1) : 0.0);
+
+        x(i, j) = (1.0 - sorFactor) * x(i, j) +
+                  sorFactor * (b(i, j) - r) / A(i, j).center;
+    });
+}
+
+template <typename Matrix, typename Vector>
+void relaxRedBlackImpl(const Matrix& A, const Vector& b, double sorFactor,
+                       Vector* x_) {
+    Size2 size = A.size();
+    Vector& x = *x_;
+
+    // Red update
+    parallelRangeFor(
+        kZeroSize, size.x, kZeroSize, size.y,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
+            for (size_t j = jBegin; j < jEnd; ++j) {
+                size_t i = j % 2 + iBegin;  // i.e. (0, 0)
+                for (; i < iEnd; i += 2) {
+                    double r =
+                        ((i > 0) ? A(i - 1, j).right * x(i - 1, j) : 0.0) +
+                        ((i + 1 < size.x) ? A(i, j).right * x(i + 1, j) : 0.0) +
+                        ((j > 0) ? A(i, j - 1).up * x(i, j - 1) : 0.0) +
+                        ((j + 1 < size.y) ? A(i, j).up * x(i, j + 1) : 0.0);
+
+                    x(i, j) = (1.0 - sorFactor) * x(i, j) +
+                              sorFactor * (b(i, j) - r) / A(i, j).center;
+                }
+            }
+        });
+
+    // Black update
+    parallelRangeFor(
+        kZeroSize, size.x, kZeroSize, size.y,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
+            for (size_t j = jBegin; j < jEnd; ++j) {
+                size_t i = 1 - j % 2 + iBegin;  // i.e. (1, 0)
+                for (; i < iEnd; i += 2) {
+                    double r =
+                        ((i > 0) ? A(i - 1, j).right * x(i - 1, j) : 0.0) +
+                        ((i + 1 < size.x) ? A(i, j).right * x(i + 1, j) : 0.0) +
+                        ((j > 0) ? A(i, j - 1).up * x(i, j - 1) : 0.0) +
+                        ((j + 1 < size.y) ? A(i, j).up * x(i, j + 1) : 0.0);
+
+                    x(i, j) = (1.0 - sorFactor) * x(i, j) +
+                              sorFactor * (b(i, j) - r) / A(i, j).center;
+                }
+            }
+        });
+}
+
+}  // namespace
+
 FdmGaussSeidelSolver2::FdmGaussSeidelSolver2(unsigned int maxNumberOfIterations,
                                              unsigned int residualCheckInterval,
                                              double tolerance, double sorFactor,
@@ -101,19 +167,13 @@ bool FdmGaussSeidelSolver2::useRedBlackOrdering() const {
 }
 
 void FdmGaussSeidelSolver2::relax(const FdmMatrix2& A, const FdmVector2& b,
-                                  double sorFactor, FdmVector2* x_) {
-    Size2 size = A.size();
-    FdmVector2& x = *x_;
-
-    A.forEachIndex([&](size_t i, size_t j) {
-        double r = ((i > 0) ? A(i - 1, j).right * x(i - 1, j) : 0.0) +
-                   ((i + 1 < size.x) ? A(i, j).right * x(i + 1, j) : 0.0) +
-                   ((j > 0) ? A(i, j - 1).up * x(i, j - 1) : 0.0) +
-                   ((j + 1 < size.y) ? A(i, j).up * x(i, j + 1) : 0.0);
+                                  double sorFactor, FdmVector2* x) {
+    relaxImpl(A, b, sorFactor, x);
+}
 
-        x(i, j) = (1.0 - sorFactor) * x(i, j) +
-                  sorFactor * (b(i, j) - r) / A(i, j).center;
-    });
+void FdmGaussSeidelSolver2::relax(const FdmMatrix2F& A, const FdmVector2F& b,
+                                  double sorFactor, FdmVector2F* x) {
+    relaxImpl(A, b, sorFactor, x);
 }
 
 void FdmGaussSeidelSolver2::relax(const MatrixCsrD& A, const VectorND& b,
@@ -146,47 +206,14 @@ void FdmGaussSeidelSolver2::relax(const MatrixCsrD& A, const VectorND& b,
 
 void FdmGaussSeidelSolver2::relaxRedBlack(const FdmMatrix2& A,
                                           const FdmVector2& b, double sorFactor,
-                                          FdmVector2* x_) {
-    Size2 size = A.size();
-    FdmVector2& x = *x_;
-
-    // Red update
-    parallelRangeFor(
-        kZeroSize, size.x, kZeroSize, size.y,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
-            for (size_t j = jBegin; j < jEnd; ++j) {
-                size_t i = j % 2 + iBegin;  // i.e. (0, 0)
-                for (; i < iEnd; i += 2) {
-                    double r =
-                        ((i > 0) ? A(i - 1, j).right * x(i - 1, j) : 0.0) +
-                        ((i + 1 < size.x) ? A(i, j).right * x(i + 1, j) : 0.0) +
-                        ((j > 0) ? A(i, j - 1).up * x(i, j - 1) : 0.0) +
-                        ((j + 1 < size.y) ? A(i, j).up * x(i, j + 1) : 0.0);
-
-                    x(i, j) = (1.0 - sorFactor) * x(i, j) +
-                              sorFactor * (b(i, j) - r) / A(i, j).center;
-                }
-            }
-        });
-
-    // Black update
-    parallelRangeFor(
-        kZeroSize, size.x, kZeroSize, size.y,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
-            for (size_t j = jBegin; j < jEnd; ++j) {
-                size_t i = 1 - j % 2 + iBegin;  // i.e. (1, 0)
-                for (; i < iEnd; i += 2) {
-                    double r =
-                        ((i > 0) ? A(i - 1, j).right * x(i - 1, j) : 0.0) +
-                        ((i + 1 < size.x) ? A(i, j).right * x(i + 1, j) : 0.0) +
-                        ((j > 0) ? A(i, j - 1).up * x(i, j - 1) : 0.0) +
-                        ((j + 1 < size.y) ? A(i, j).up * x(i, j + 1) : 0.0);
+                                          FdmVector2* x) {
+    relaxRedBlackImpl(A, b, sorFactor, x);
+}
 
-                    x(i, j) = (1.0 - sorFactor) * x(i, j) +
-                              sorFactor * (b(i, j) - r) / A(i, j).center;
-                }
-            }
-        });
+void FdmGaussSeidelSolver2::relaxRedBlack(const FdmMatrix2F& A,
+                                          const FdmVector2F& b,
+                                          double sorFactor, FdmVector2F* x) {
+    relaxRedBlackImpl(A, b, sorFactor, x);
 }
 
 void FdmGaussSeidelSolver2::clearUncompressedVectors() { _residual.clear(); }
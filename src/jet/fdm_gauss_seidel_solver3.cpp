@@ -11,6 +11,103 @@
 
 using namespace jet;
 
+namespace {
+
+template <typename Matrix, typename Vector>
+void relaxImpl(const Matrix& A, const Vector& b, double sorFactor,
+               Vector* x_) {
+    Size3 size = A.size();
+    Vector& x = *x_;
+
+    A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        double r =
+            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0) +
+            ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0) +
+            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
+            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : 0.0) +
+            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0) +
+            ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
+
+        x(i, j, k) = (1.0 - sorFactor) * x(i, j, k) +
+                     sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+    });
+}
+
+template <typename Matrix, typename Vector>
+void relaxRedBlackImpl(const Matrix& A, const Vector& b, double sorFactor,
+                       Vector* x_) {
+    Size3 size = A.size();
+    Vector& x = *x_;
+
+    // Red update
+    parallelRangeFor(
+        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+            size_t kBegin, size_t kEnd) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    size_t i = (j + k) % 2 + iBegin;  // i.e. (0, 0, 0)
+                    for (; i < iEnd; i += 2) {
+                        double r =
+                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
+                                     : 0.0) +
+                            ((i + 1 < size.x)
+                                 ? A(i, j, k).right * x(i + 1, j, k)
+                                 : 0.0) +
+                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
+                                     : 0.0) +
+                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
+                                              : 0.0) +
+                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
+                                     : 0.0) +
+                            ((k + 1 < size.z)
+                                 ? A(i, j, k).front * x(i, j, k + 1)
+                                 : 0.0);
+
+                        x(i, j, k) =
+                            (1.0 - sorFactor) * x(i, j, k) +
+                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+                    }
+                }
+            }
+        });
+
+    // Black update
+    parallelRangeFor(
+        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+            size_t kBegin, size_t kEnd) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    size_t i = 1 - (j + k) % 2 + iBegin;  // i.e. (1, 1, 1)
+                    for (; i < iEnd; i += 2) {
+                        double r =
+                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
+                                     : 0.0) +
+                            ((i + 1 < size.x)
+                                 ? A(i, j, k).right * x(i + 1, j, k)
+                                 : 0.0) +
+                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
+                                     : 0.0) +
+                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
+                                              : 0.0) +
+                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
+                                     : 0.0) +
+                            ((k + 1 < size.z)
+                                 ? A(i, j, k).front * x(i, j, k + 1)
+                                 : 0.0);
+
+                        x(i, j, k) =
+                            (1.0 - sorFactor) * x(i, j, k) +
+                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
+                    }
+                }
+            }
+        });
+}
+
+}  // namespace
+
 FdmGaussSeidelSolver3::FdmGaussSeidelSolver3(unsigned int maxNumberOfIterations,
                                              unsigned int residualCheckInterval,
                                              double tolerance, double sorFactor,
@@ -82,6 +179,33 @@ bool FdmGaussSeidelSolver3::solveCompressed(
     return _lastResidual < _tolerance;
 }
 
+bool FdmGaussSeidelSolver3::solveStencil(FdmStencilLinearSystem3* system) {
+    clearUncompressedVectors();
+
+    _residualComp.resize(system->x.size());
+
+    _lastNumberOfIterations = _maxNumberOfIterations;
+
+    for (unsigned int iter = 0; iter < _maxNumberOfIterations; ++iter) {
+        relax(system->A, system->b, _sorFactor, &system->x);
+
+        if (iter != 0 && iter % _residualCheckInterval == 0) {
+            FdmStencilBlas3::residual(system->A, system->x, system->b,
+                                      &_residualComp);
+
+            if (FdmStencilBlas3::l2Norm(_residualComp) < _tolerance) {
+                _lastNumberOfIterations = iter + 1;
+                break;
+            }
+        }
+    }
+
+    FdmStencilBlas3::residual(system->A, system->x, system->b, &_residualComp);
+    _lastResidual = FdmStencilBlas3::l2Norm(_residualComp);
+
+    return _lastResidual < _tolerance;
+}
+
 unsigned int FdmGaussSeidelSolver3::maxNumberOfIterations() const {
     return _maxNumberOfIterations;
 }
@@ -101,22 +225,13 @@ bool FdmGaussSeidelSolver3::useRedBlackOrdering() const {
 }
 
 void FdmGaussSeidelSolver3::relax(const FdmMatrix3& A, const FdmVector3& b,
-                                  double sorFactor, FdmVector3* x_) {
-    Size3 size = A.size();
-    FdmVector3& x = *x_;
-
-    A.forEachIndex([&](size_t i, size_t j, size_t k) {
-        double r =
-            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k) : 0.0) +
-            ((i + 1 < size.x) ? A(i, j, k).right * x(i + 1, j, k) : 0.0) +
-            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k) : 0.0) +
-            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k) : 0.0) +
-            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1) : 0.0) +
-            ((k + 1 < size.z) ? A(i, j, k).front * x(i, j, k + 1) : 0.0);
+                                  double sorFactor, FdmVector3* x) {
+    relaxImpl(A, b, sorFactor, x);
+}
 
-        x(i, j, k) = (1.0 - sorFactor) * x(i, j, k) +
-                     sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
-    });
+void FdmGaussSeidelSolver3::relax(const FdmMatrix3F& A, const FdmVector3F& b,
+                                  double sorFactor, FdmVector3F* x) {
+    relaxImpl(A, b, sorFactor, x);
 }
 
 void FdmGaussSeidelSolver3::relax(const MatrixCsrD& A, const VectorND& b,
@@ -147,77 +262,34 @@ void FdmGaussSeidelSolver3::relax(const MatrixCsrD& A, const VectorND& b,
     });
 }
 
-void FdmGaussSeidelSolver3::relaxRedBlack(const FdmMatrix3& A,
-                                          const FdmVector3& b, double sorFactor,
-                                          FdmVector3* x_) {
-    Size3 size = A.size();
-    FdmVector3& x = *x_;
-
-    // Red update
-    parallelRangeFor(
-        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
-            size_t kBegin, size_t kEnd) {
-            for (size_t k = kBegin; k < kEnd; ++k) {
-                for (size_t j = jBegin; j < jEnd; ++j) {
-                    size_t i = (j + k) % 2 + iBegin;  // i.e. (0, 0, 0)
-                    for (; i < iEnd; i += 2) {
-                        double r =
-                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
-                                     : 0.0) +
-                            ((i + 1 < size.x)
-                                 ? A(i, j, k).right * x(i + 1, j, k)
-                                 : 0.0) +
-                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
-                                     : 0.0) +
-                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
-                                              : 0.0) +
-                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
-                                     : 0.0) +
-                            ((k + 1 < size.z)
-                                 ? A(i, j, k).front * x(i, j, k + 1)
-                                 : 0.0);
+void FdmGaussSeidelSolver3::relax(const FdmStencilMatrix3& A,
+                                  const VectorND& b, double sorFactor,
+                                  VectorND* x_) {
+    VectorND& x = *x_;
 
-                        x(i, j, k) =
-                            (1.0 - sorFactor) * x(i, j, k) +
-                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
-                    }
-                }
-            }
-        });
+    b.forEachIndex([&](size_t i) {
+        double r = 0.0;
+        auto addNeighbor = [&](size_t j, double coupling) {
+            r += coupling * x[j];
+        };
+        A.forEachLowerNeighbor(i, addNeighbor);
+        A.forEachUpperNeighbor(i, addNeighbor);
+
+        x[i] = (1.0 - sorFactor) * x[i] +
+               sorFactor * (b[i] - r) / A.rows[i].center;
+    });
+}
 
-    // Black update
-    parallelRangeFor(
-        kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
-        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
-            size_t kBegin, size_t kEnd) {
-            for (size_t k = kBegin; k < kEnd; ++k) {
-                for (size_t j = jBegin; j < jEnd; ++j) {
-                    size_t i = 1 - (j + k) % 2 + iBegin;  // i.e. (1, 1, 1)
-                    for (; i < iEnd; i += 2) {
-                        double r =
-                            ((i > 0) ? A(i - 1, j, k).right * x(i - 1, j, k)
-                                     : 0.0) +
-                            ((i + 1 < size.x)
-                                 ? A(i, j, k).right * x(i + 1, j, k)
-                                 : 0.0) +
-                            ((j > 0) ? A(i, j - 1, k).up * x(i, j - 1, k)
-                                     : 0.0) +
-                            ((j + 1 < size.y) ? A(i, j, k).up * x(i, j + 1, k)
-                                              : 0.0) +
-                            ((k > 0) ? A(i, j, k - 1).front * x(i, j, k - 1)
-                                     : 0.0) +
-                            ((k + 1 < size.z)
-                                 ? A(i, j, k).front * x(i, j, k + 1)
-                                 : 0.0);
+void FdmGaussSeidelSolver3::relaxRedBlack(const FdmMatrix3& A,
+                                          const FdmVector3& b, double sorFactor,
+                                          FdmVector3* x) {
+    relaxRedBlackImpl(A, b, sorFactor, x);
+}
 
-                        x(i, j, k) =
-                            (1.0 - sorFactor) * x(i, j, k) +
-                            sorFactor * (b(i, j, k) - r) / A(i, j, k).center;
-                    }
-                }
-            }
-        });
+void FdmGaussSeidelSolver3::relaxRedBlack(const FdmMatrix3F& A,
+                                          const FdmVector3F& b,
+                                          double sorFactor, FdmVector3F* x) {
+    relaxRedBlackImpl(A, b, sorFactor, x);
 }
 
 void FdmGaussSeidelSolver3::clearUncompressedVectors() { _residual.clear(); }
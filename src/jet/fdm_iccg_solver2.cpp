@@ -8,9 +8,175 @@
 
 #include <jet/cg.h>
 #include <jet/fdm_iccg_solver2.h>
+#include <jet/parallel.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 using namespace jet;
 
+namespace {
+
+// Wavefronts with fewer points than this are processed serially since the
+// cost of launching the parallel tasks outweighs the work.
+const size_t kMinParallelWavefrontSize = 4096;
+
+// Size of the wavefront tiles along the x and y-axis.
+const size_t kWavefrontTileSize = 32;
+
+// Invokes func(i, j) for every grid point in the order that respects the
+// dependencies of the triangular solves. The grid is split into tiles which
+// are visited by wavefronts ti + tj = s in increasing (or decreasing if
+// isBackward is true) order of s, and the tiles on the same wavefront are
+// processed in parallel. Within a tile, the points are visited in the same
+// order as forEachIndex (or its reverse), so the result is identical to the
+// serial sweep.
+template <typename Callback>
+void parallelForEachWavefront(const Size2& size, bool isBackward,
+                              const Callback& func) {
+    if (size.x * size.y == 0) {
+        return;
+    }
+
+    const size_t numTilesX = (size.x + kWavefrontTileSize - 1) /
+                             kWavefrontTileSize;
+    const size_t numTilesY = (size.y + kWavefrontTileSize - 1) /
+                             kWavefrontTileSize;
+    const size_t numWaves = numTilesX + numTilesY - 1;
+
+    for (size_t w = 0; w < numWaves; ++w) {
+        const size_t s = isBackward ? numWaves - 1 - w : w;
+        const size_t tjBegin = (s + 1 > numTilesX) ? s + 1 - numTilesX : 0;
+        const size_t tjEnd = std::min(s, numTilesY - 1) + 1;
+
+        auto processTile = [&](size_t tj) {
+            const size_t ti = s - tj;
+            const size_t iBegin = ti * kWavefrontTileSize;
+            const size_t iEnd = std::min(iBegin + kWavefrontTileSize, size.x);
+            const size_t jBegin = tj * kWavefrontTileSize;
+            const size_t jEnd = std::min(jBegin + kWavefrontTileSize, size.y);
+
+            if (isBackward) {
+                for (size_t j = jEnd; j-- > jBegin;) {
+                    for (size_t i = iEnd; i-- > iBegin;) {
+                        func(i, j);
+                    }
+                }
+            } else {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    for (size_t i = iBegin; i < iEnd; ++i) {
+                        func(i, j);
+                    }
+                }
+            }
+        };
+
+        const size_t numPoints = (tjEnd - tjBegin) * kWavefrontTileSize *
+                                 kWavefrontTileSize;
+        if (tjEnd - tjBegin < 2 || numPoints < kMinParallelWavefrontSize) {
+            for (size_t tj = tjBegin; tj < tjEnd; ++tj) {
+                processTile(tj);
+            }
+        } else {
+            parallelFor(tjBegin, tjEnd, processTile);
+        }
+    }
+}
+
+// Groups the rows of the matrix into levels so that the rows in the same level
+// do not depend on each other in the lower (or upper) triangular solve. The
+// levels with enough rows are processed in parallel. The consecutive levels
+// that are too small are merged into a single serial group whose rows are
+// sorted in the order of the serial solve, which respects the dependencies and
+// keeps the memory access contiguous.
+template <typename Schedule>
+void buildLevels(const MatrixCsrD& matrix, bool isUpper, Schedule* schedule) {
+    const size_t n = matrix.rows();
+    const auto rp = matrix.rowPointersBegin();
+    const auto ci = matrix.columnIndicesBegin();
+
+    std::vector<size_t> level(n, 0);
+    size_t numLevels = 0;
+    for (size_t ii = 0; ii < n; ++ii) {
+        const size_t i = isUpper ? n - 1 - ii : ii;
+
+        size_t l = 0;
+        for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+            const size_t j = ci[jj];
+            if (isUpper ? j > i : j < i) {
+                l = std::max(l, level[j] + 1);
+            }
+        }
+
+        level[i] = l;
+        numLevels = std::max(numLevels, l + 1);
+    }
+
+    std::vector<size_t> levelPointers(numLevels + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        ++levelPointers[level[i] + 1];
+    }
+    for (size_t l = 0; l < numLevels; ++l) {
+        levelPointers[l + 1] += levelPointers[l];
+    }
+
+    std::vector<size_t>& rows = schedule->rows;
+    rows.resize(n);
+    std::vector<size_t> offsets(levelPointers.begin(), levelPointers.end());
+    for (size_t i = 0; i < n; ++i) {
+        rows[offsets[level[i]]++] = i;
+    }
+
+    std::vector<size_t>& pointers = schedule->pointers;
+    std::vector<char>& isParallel = schedule->isParallel;
+    pointers.assign(1, 0);
+    isParallel.clear();
+    for (size_t l = 0; l < numLevels; ++l) {
+        const size_t levelSize = levelPointers[l + 1] - levelPointers[l];
+        const bool isLevelParallel = levelSize >= kMinParallelWavefrontSize;
+
+        if (!isLevelParallel && !isParallel.empty() && !isParallel.back()) {
+            pointers.back() = levelPointers[l + 1];
+        } else {
+            pointers.push_back(levelPointers[l + 1]);
+            isParallel.push_back(isLevelParallel);
+        }
+    }
+
+    for (size_t g = 0; g < isParallel.size(); ++g) {
+        if (!isParallel[g]) {
+            auto first = rows.begin() + pointers[g];
+            auto last = rows.begin() + pointers[g + 1];
+            if (isUpper) {
+                std::sort(first, last, std::greater<size_t>());
+            } else {
+                std::sort(first, last);
+            }
+        }
+    }
+}
+
+// Invokes func(i) for every row following the given schedule.
+template <typename Schedule, typename Callback>
+void parallelForEachLevel(const Schedule& schedule, const Callback& func) {
+    const std::vector<size_t>& rows = schedule.rows;
+    for (size_t g = 0; g < schedule.isParallel.size(); ++g) {
+        const size_t begin = schedule.pointers[g];
+        const size_t end = schedule.pointers[g + 1];
+
+        if (schedule.isParallel[g]) {
+            parallelFor(begin, end, [&](size_t ii) { func(rows[ii]); });
+        } else {
+            for (size_t ii = begin; ii < end; ++ii) {
+                func(rows[ii]);
+            }
+        }
+    }
+}
+
+}  // namespace
+
 void FdmIccgSolver2::Preconditioner::build(const FdmMatrix2& matrix) {
     Size2 size = matrix.size();
     A = matrix.constAccessor();
@@ -18,7 +184,7 @@ void FdmIccgSolver2::Preconditioner::build(const FdmMatrix2& matrix) {
     d.resize(size, 0.0);
     y.resize(size, 0.0);
 
-    matrix.forEachIndex([&](size_t i, size_t j) {
+    auto buildCell = [&](size_t i, size_t j) {
         double denom =
             matrix(i, j).center -
             ((i > 0) ? square(matrix(i - 1, j).right) * d(i - 1, j) : 0.0) -
@@ -29,7 +195,13 @@ void FdmIccgSolver2::Preconditioner::build(const FdmMatrix2& matrix) {
         } else {
             d(i, j) = 0.0;
         }
-    });
+    };
+
+    if (isParallel) {
+        parallelForEachWavefront(size, false, buildCell);
+    } else {
+        matrix.forEachIndex(buildCell);
+    }
 }
 
 void FdmIccgSolver2::Preconditioner::solve(const FdmVector2& b, FdmVector2* x) {
@@ -37,19 +209,31 @@ void FdmIccgSolver2::Preconditioner::solve(const FdmVector2& b, FdmVector2* x) {
     ssize_t sx = static_cast<ssize_t>(size.x);
     ssize_t sy = static_cast<ssize_t>(size.y);
 
-    b.forEachIndex([&](size_t i, size_t j) {
+    auto forwardCell = [&](size_t i, size_t j) {
         y(i, j) = (b(i, j) - ((i > 0) ? A(i - 1, j).right * y(i - 1, j) : 0.0) -
                    ((j > 0) ? A(i, j - 1).up * y(i, j - 1) : 0.0)) *
                   d(i, j);
-    });
+    };
+
+    auto backwardCell = [&](size_t i, size_t j) {
+        (*x)(i, j) =
+            (y(i, j) -
+             ((i + 1 < size.x) ? A(i, j).right * (*x)(i + 1, j) : 0.0) -
+             ((j + 1 < size.y) ? A(i, j).up * (*x)(i, j + 1) : 0.0)) *
+            d(i, j);
+    };
+
+    if (isParallel) {
+        parallelForEachWavefront(size, false, forwardCell);
+        parallelForEachWavefront(size, true, backwardCell);
+        return;
+    }
+
+    b.forEachIndex(forwardCell);
 
     for (ssize_t j = sy - 1; j >= 0; --j) {
         for (ssize_t i = sx - 1; i >= 0; --i) {
-            (*x)(i, j) =
-                (y(i, j) -
-                 ((i + 1 < sx) ? A(i, j).right * (*x)(i + 1, j) : 0.0) -
-                 ((j + 1 < sy) ? A(i, j).up * (*x)(i, j + 1) : 0.0)) *
-                d(i, j);
+            backwardCell(i, j);
         }
     }
 }
@@ -67,7 +251,7 @@ void FdmIccgSolver2::PreconditionerCompressed::build(const MatrixCsrD& matrix) {
     const auto ci = A->columnIndicesBegin();
     const auto nnz = A->nonZeroBegin();
 
-    d.forEachIndex([&](size_t i) {
+    auto buildRow = [&](size_t i) {
         const size_t rowBegin = rp[i];
         const size_t rowEnd = rp[i + 1];
 
@@ -87,7 +271,17 @@ void FdmIccgSolver2::PreconditionerCompressed::build(const MatrixCsrD& matrix) {
         } else {
             d[i] = 0.0;
         }
-    });
+    };
+
+    if (isParallel) {
+        buildLevels(matrix, false, &lowerLevels);
+        buildLevels(matrix, true, &upperLevels);
+        parallelForEachLevel(lowerLevels, buildRow);
+    } else {
+        lowerLevels = LevelSchedule();
+        upperLevels = LevelSchedule();
+        d.forEachIndex(buildRow);
+    }
 }
 
 void FdmIccgSolver2::PreconditionerCompressed::solve(const VectorND& b,
@@ -98,7 +292,7 @@ void FdmIccgSolver2::PreconditionerCompressed::solve(const VectorND& b,
     const auto ci = A->columnIndicesBegin();
     const auto nnz = A->nonZeroBegin();
 
-    b.forEachIndex([&](size_t i) {
+    auto forwardRow = [&](size_t i) {
         const size_t rowBegin = rp[i];
         const size_t rowEnd = rp[i + 1];
 
@@ -112,15 +306,15 @@ void FdmIccgSolver2::PreconditionerCompressed::solve(const VectorND& b,
         }
 
         y[i] = sum * d[i];
-    });
+    };
 
-    for (ssize_t i = size - 1; i >= 0; --i) {
+    auto backwardRow = [&](size_t i) {
         const size_t rowBegin = rp[i];
         const size_t rowEnd = rp[i + 1];
 
         double sum = y[i];
         for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
-            ssize_t j = static_cast<ssize_t>(ci[jj]);
+            size_t j = ci[jj];
 
             if (j > i) {
                 sum -= nnz[jj] * (*x)[j];
@@ -128,6 +322,18 @@ void FdmIccgSolver2::PreconditionerCompressed::solve(const VectorND& b,
         }
 
         (*x)[i] = sum * d[i];
+    };
+
+    if (isParallel) {
+        parallelForEachLevel(lowerLevels, forwardRow);
+        parallelForEachLevel(upperLevels, backwardRow);
+        return;
+    }
+
+    b.forEachIndex(forwardRow);
+
+    for (ssize_t i = size - 1; i >= 0; --i) {
+        backwardRow(static_cast<size_t>(i));
     }
 }
 
@@ -156,7 +362,9 @@ bool FdmIccgSolver2::solve(FdmLinearSystem2* system) {
     _q.resize(size);
     _s.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
     _r.set(0.0);
     _d.set(0.0);
     _q.set(0.0);
@@ -188,7 +396,9 @@ bool FdmIccgSolver2::solveCompressed(FdmCompressedLinearSystem2* system) {
     _qComp.resize(size);
     _sComp.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
     _rComp.set(0.0);
     _dComp.set(0.0);
     _qComp.set(0.0);
@@ -220,6 +430,15 @@ double FdmIccgSolver2::tolerance() const { return _tolerance; }
 
 double FdmIccgSolver2::lastResidual() const { return _lastResidualNorm; }
 
+bool FdmIccgSolver2::isUsingParallelPreconditioner() const {
+    return _precond.isParallel;
+}
+
+void FdmIccgSolver2::setIsUsingParallelPreconditioner(bool isUsing) {
+    _precond.isParallel = isUsing;
+    _precondComp.isParallel = isUsing;
+}
+
 void FdmIccgSolver2::clearUncompressedVectors() {
     _r.clear();
     _d.clear();
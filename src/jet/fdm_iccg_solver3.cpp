@@ -7,10 +7,176 @@
 #include <jet/cg.h>
 #include <jet/constants.h>
 #include <jet/fdm_iccg_solver3.h>
+#include <jet/parallel.h>
 #include <pch.h>
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 using namespace jet;
 
+namespace {
+
+// Wavefronts with fewer points than this are processed serially since the
+// cost of launching the parallel tasks outweighs the work.
+const size_t kMinParallelWavefrontSize = 4096;
+
+// Size of the wavefront tiles along the y and z-axis.
+const size_t kWavefrontTileSize = 8;
+
+// Invokes func(i, j, k) for every grid point in the order that respects the
+// dependencies of the triangular solves. The yz-plane is split into tiles, and
+// each tile holds the full x-lines so that the memory access is contiguous.
+// The tiles are visited by wavefronts tj + tk = s in increasing (or decreasing
+// if isBackward is true) order of s, and the tiles on the same wavefront are
+// processed in parallel. Within a tile, the points are visited in the same
+// order as forEachIndex (or its reverse), so the result is identical to the
+// serial sweep.
+template <typename Callback>
+void parallelForEachWavefront(const Size3& size, bool isBackward,
+                              const Callback& func) {
+    if (size.x * size.y * size.z == 0) {
+        return;
+    }
+
+    const size_t numTilesY = (size.y + kWavefrontTileSize - 1) /
+                             kWavefrontTileSize;
+    const size_t numTilesZ = (size.z + kWavefrontTileSize - 1) /
+                             kWavefrontTileSize;
+    const size_t numWaves = numTilesY + numTilesZ - 1;
+
+    for (size_t w = 0; w < numWaves; ++w) {
+        const size_t s = isBackward ? numWaves - 1 - w : w;
+        const size_t tkBegin = (s + 1 > numTilesY) ? s + 1 - numTilesY : 0;
+        const size_t tkEnd = std::min(s, numTilesZ - 1) + 1;
+
+        auto processTile = [&](size_t tk) {
+            const size_t tj = s - tk;
+            const size_t jBegin = tj * kWavefrontTileSize;
+            const size_t jEnd = std::min(jBegin + kWavefrontTileSize, size.y);
+            const size_t kBegin = tk * kWavefrontTileSize;
+            const size_t kEnd = std::min(kBegin + kWavefrontTileSize, size.z);
+
+            if (isBackward) {
+                for (size_t k = kEnd; k-- > kBegin;) {
+                    for (size_t j = jEnd; j-- > jBegin;) {
+                        for (size_t i = size.x; i-- > 0;) {
+                            func(i, j, k);
+                        }
+                    }
+                }
+            } else {
+                for (size_t k = kBegin; k < kEnd; ++k) {
+                    for (size_t j = jBegin; j < jEnd; ++j) {
+                        for (size_t i = 0; i < size.x; ++i) {
+                            func(i, j, k);
+                        }
+                    }
+                }
+            }
+        };
+
+        const size_t numPoints = (tkEnd - tkBegin) * kWavefrontTileSize *
+                                 kWavefrontTileSize * size.x;
+        if (tkEnd - tkBegin < 2 || numPoints < kMinParallelWavefrontSize) {
+            for (size_t tk = tkBegin; tk < tkEnd; ++tk) {
+                processTile(tk);
+            }
+        } else {
+            parallelFor(tkBegin, tkEnd, processTile);
+        }
+    }
+}
+
+// Groups the n rows into levels so that the rows in the same level do not
+// depend on each other in the lower (or upper) triangular solve, where
+// forEachDependency(i, func) invokes func(j) for every row j that row i
+// depends on. The levels with enough rows are processed in parallel. The
+// consecutive levels that are too small are merged into a single serial group
+// whose rows are sorted in the order of the serial solve, which respects the
+// dependencies and keeps the memory access contiguous.
+template <typename Schedule, typename Dependencies>
+void buildLevels(size_t n, bool isUpper, const Dependencies& forEachDependency,
+                 Schedule* schedule) {
+    std::vector<size_t> level(n, 0);
+    size_t numLevels = 0;
+    for (size_t ii = 0; ii < n; ++ii) {
+        const size_t i = isUpper ? n - 1 - ii : ii;
+
+        size_t l = 0;
+        forEachDependency(i, [&](size_t j) {
+            l = std::max(l, level[j] + 1);
+        });
+
+        level[i] = l;
+        numLevels = std::max(numLevels, l + 1);
+    }
+
+    std::vector<size_t> levelPointers(numLevels + 1, 0);
+    for (size_t i = 0; i < n; ++i) {
+        ++levelPointers[level[i] + 1];
+    }
+    for (size_t l = 0; l < numLevels; ++l) {
+        levelPointers[l + 1] += levelPointers[l];
+    }
+
+    std::vector<size_t>& rows = schedule->rows;
+    rows.resize(n);
+    std::vector<size_t> offsets(levelPointers.begin(), levelPointers.end());
+    for (size_t i = 0; i < n; ++i) {
+        rows[offsets[level[i]]++] = i;
+    }
+
+    std::vector<size_t>& pointers = schedule->pointers;
+    std::vector<char>& isParallel = schedule->isParallel;
+    pointers.assign(1, 0);
+    isParallel.clear();
+    for (size_t l = 0; l < numLevels; ++l) {
+        const size_t levelSize = levelPointers[l + 1] - levelPointers[l];
+        const bool isLevelParallel = levelSize >= kMinParallelWavefrontSize;
+
+        if (!isLevelParallel && !isParallel.empty() && !isParallel.back()) {
+            pointers.back() = levelPointers[l + 1];
+        } else {
+            pointers.push_back(levelPointers[l + 1]);
+            isParallel.push_back(isLevelParallel);
+        }
+    }
+
+    for (size_t g = 0; g < isParallel.size(); ++g) {
+        if (!isParallel[g]) {
+            auto first = rows.begin() + pointers[g];
+            auto last = rows.begin() + pointers[g + 1];
+            if (isUpper) {
+                std::sort(first, last, std::greater<size_t>());
+            } else {
+                std::sort(first, last);
+            }
+        }
+    }
+}
+
+// Invokes func(i) for every row following the given schedule.
+template <typename Schedule, typename Callback>
+void parallelForEachLevel(const Schedule& schedule, const Callback& func) {
+    const std::vector<size_t>& rows = schedule.rows;
+    for (size_t g = 0; g < schedule.isParallel.size(); ++g) {
+        const size_t begin = schedule.pointers[g];
+        const size_t end = schedule.pointers[g + 1];
+
+        if (schedule.isParallel[g]) {
+            parallelFor(begin, end, [&](size_t ii) { func(rows[ii]); });
+        } else {
+            for (size_t ii = begin; ii < end; ++ii) {
+                func(rows[ii]);
+            }
+        }
+    }
+}
+
+}  // namespace
+
 void FdmIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
     Size3 size = matrix.size();
     A = matrix.constAccessor();
@@ -18,7 +184,7 @@ void FdmIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
     d.resize(size, 0.0);
     y.resize(size, 0.0);
 
-    matrix.forEachIndex([&](size_t i, size_t j, size_t k) {
+    auto buildCell = [&](size_t i, size_t j, size_t k) {
         double denom =
             matrix(i, j, k).center -
             ((i > 0) ? square(matrix(i - 1, j, k).right) * d(i - 1, j, k)
@@ -32,7 +198,13 @@ void FdmIccgSolver3::Preconditioner::build(const FdmMatrix3& matrix) {
         } else {
             d(i, j, k) = 0.0;
         }
-    });
+    };
+
+    if (isParallel) {
+        parallelForEachWavefront(size, false, buildCell);
+    } else {
+        matrix.forEachIndex(buildCell);
+    }
 }
 
 void FdmIccgSolver3::Preconditioner::solve(const FdmVector3& b, FdmVector3* x) {
@@ -41,25 +213,36 @@ void FdmIccgSolver3::Preconditioner::solve(const FdmVector3& b, FdmVector3* x) {
     ssize_t sy = static_cast<ssize_t>(size.y);
     ssize_t sz = static_cast<ssize_t>(size.z);
 
-    b.forEachIndex([&](size_t i, size_t j, size_t k) {
+    auto forwardCell = [&](size_t i, size_t j, size_t k) {
         y(i, j, k) = (b(i, j, k) -
                       ((i > 0) ? A(i - 1, j, k).right * y(i - 1, j, k) : 0.0) -
                       ((j > 0) ? A(i, j - 1, k).up * y(i, j - 1, k) : 0.0) -
                       ((k > 0) ? A(i, j, k - 1).front * y(i, j, k - 1) : 0.0)) *
                      d(i, j, k);
-    });
+    };
+
+    auto backwardCell = [&](size_t i, size_t j, size_t k) {
+        (*x)(i, j, k) =
+            (y(i, j, k) -
+             ((i + 1 < size.x) ? A(i, j, k).right * (*x)(i + 1, j, k) : 0.0) -
+             ((j + 1 < size.y) ? A(i, j, k).up * (*x)(i, j + 1, k) : 0.0) -
+             ((k + 1 < size.z) ? A(i, j, k).front * (*x)(i, j, k + 1)
+                               : 0.0)) *
+            d(i, j, k);
+    };
+
+    if (isParallel) {
+        parallelForEachWavefront(size, false, forwardCell);
+        parallelForEachWavefront(size, true, backwardCell);
+        return;
+    }
+
+    b.forEachIndex(forwardCell);
 
     for (ssize_t k = sz - 1; k >= 0; --k) {
         for (ssize_t j = sy - 1; j >= 0; --j) {
             for (ssize_t i = sx - 1; i >= 0; --i) {
-                (*x)(i, j, k) =
-                    (y(i, j, k) -
-                     ((i + 1 < sx) ? A(i, j, k).right * (*x)(i + 1, j, k)
-                                   : 0.0) -
-                     ((j + 1 < sy) ? A(i, j, k).up * (*x)(i, j + 1, k) : 0.0) -
-                     ((k + 1 < sz) ? A(i, j, k).front * (*x)(i, j, k + 1)
-                                   : 0.0)) *
-                    d(i, j, k);
+                backwardCell(i, j, k);
             }
         }
     }
@@ -78,7 +261,7 @@ void FdmIccgSolver3::PreconditionerCompressed::build(const MatrixCsrD& matrix) {
     const auto ci = A->columnIndicesBegin();
     const auto nnz = A->nonZeroBegin();
 
-    d.forEachIndex([&](size_t i) {
+    auto buildRow = [&](size_t i) {
         const size_t rowBegin = rp[i];
         const size_t rowEnd = rp[i + 1];
 
@@ -98,7 +281,34 @@ void FdmIccgSolver3::PreconditionerCompressed::build(const MatrixCsrD& matrix) {
         } else {
             d[i] = 0.0;
         }
-    });
+    };
+
+    if (isParallel) {
+        const size_t n = matrix.rows();
+        buildLevels(n, false,
+                    [&](size_t i, const std::function<void(size_t)>& func) {
+                        for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+                            if (ci[jj] < i) {
+                                func(ci[jj]);
+                            }
+                        }
+                    },
+                    &lowerLevels);
+        buildLevels(n, true,
+                    [&](size_t i, const std::function<void(size_t)>& func) {
+                        for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+                            if (ci[jj] > i) {
+                                func(ci[jj]);
+                            }
+                        }
+                    },
+                    &upperLevels);
+        parallelForEachLevel(lowerLevels, buildRow);
+    } else {
+        lowerLevels = LevelSchedule();
+        upperLevels = LevelSchedule();
+        d.forEachIndex(buildRow);
+    }
 }
 
 void FdmIccgSolver3::PreconditionerCompressed::solve(const VectorND& b,
@@ -109,7 +319,7 @@ void FdmIccgSolver3::PreconditionerCompressed::solve(const VectorND& b,
     const auto ci = A->columnIndicesBegin();
     const auto nnz = A->nonZeroBegin();
 
-    b.forEachIndex([&](size_t i) {
+    auto forwardRow = [&](size_t i) {
         const size_t rowBegin = rp[i];
         const size_t rowEnd = rp[i + 1];
 
@@ -123,15 +333,15 @@ void FdmIccgSolver3::PreconditionerCompressed::solve(const VectorND& b,
         }
 
         y[i] = sum * d[i];
-    });
+    };
 
-    for (ssize_t i = size - 1; i >= 0; --i) {
+    auto backwardRow = [&](size_t i) {
         const size_t rowBegin = rp[i];
         const size_t rowEnd = rp[i + 1];
 
         double sum = y[i];
         for (size_t jj = rowBegin; jj < rowEnd; ++jj) {
-            ssize_t j = static_cast<ssize_t>(ci[jj]);
+            size_t j = ci[jj];
 
             if (j > i) {
                 sum -= nnz[jj] * (*x)[j];
@@ -139,6 +349,95 @@ void FdmIccgSolver3::PreconditionerCompressed::solve(const VectorND& b,
         }
 
         (*x)[i] = sum * d[i];
+    };
+
+    if (isParallel) {
+        parallelForEachLevel(lowerLevels, forwardRow);
+        parallelForEachLevel(upperLevels, backwardRow);
+        return;
+    }
+
+    b.forEachIndex(forwardRow);
+
+    for (ssize_t i = size - 1; i >= 0; --i) {
+        backwardRow(static_cast<size_t>(i));
+    }
+}
+
+//
+
+void FdmIccgSolver3::PreconditionerStencil::build(
+    const FdmStencilMatrix3& matrix) {
+    size_t size = matrix.numberOfRows();
+    A = &matrix;
+
+    d.resize(size, 0.0);
+    y.resize(size, 0.0);
+
+    auto buildRow = [&](size_t i) {
+        double denom = A->rows[i].center;
+        A->forEachLowerNeighbor(i, [&](size_t j, double coupling) {
+            denom -= square(coupling) * d[j];
+        });
+
+        if (std::fabs(denom) > 0.0) {
+            d[i] = 1.0 / denom;
+        } else {
+            d[i] = 0.0;
+        }
+    };
+
+    if (isParallel) {
+        buildLevels(size, false,
+                    [&](size_t i, const std::function<void(size_t)>& func) {
+                        A->forEachLowerNeighbor(
+                            i, [&](size_t j, double) { func(j); });
+                    },
+                    &lowerLevels);
+        buildLevels(size, true,
+                    [&](size_t i, const std::function<void(size_t)>& func) {
+                        A->forEachUpperNeighbor(
+                            i, [&](size_t j, double) { func(j); });
+                    },
+                    &upperLevels);
+        parallelForEachLevel(lowerLevels, buildRow);
+    } else {
+        lowerLevels = LevelSchedule();
+        upperLevels = LevelSchedule();
+        d.forEachIndex(buildRow);
+    }
+}
+
+void FdmIccgSolver3::PreconditionerStencil::solve(const VectorND& b,
+                                                  VectorND* x) {
+    const ssize_t size = static_cast<ssize_t>(b.size());
+
+    auto forwardRow = [&](size_t i) {
+        double sum = b[i];
+        A->forEachLowerNeighbor(
+            i, [&](size_t j, double coupling) { sum -= coupling * y[j]; });
+
+        y[i] = sum * d[i];
+    };
+
+    auto backwardRow = [&](size_t i) {
+        double sum = y[i];
+        A->forEachUpperNeighbor(
+            i, [&](size_t j, double coupling) { sum -= coupling * (*x)[j]; });
+
+        (*x)[i] = sum * d[i];
+    };
+
+    if (isParallel) {
+        parallelForEachLevel(lowerLevels, forwardRow);
+        parallelForEachLevel(upperLevels, backwardRow);
+        return;
+    }
+
+    b.forEachIndex(forwardRow);
+
+    for (ssize_t i = size - 1; i >= 0; --i) {
+        backwardRow(static_cast<size_t>(i));
     }
 }
 
@@ -167,7 +466,9 @@ bool FdmIccgSolver3::solve(FdmLinearSystem3* system) {
     _q.resize(size);
     _s.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
     _r.set(0.0);
     _d.set(0.0);
     _q.set(0.0);
@@ -199,7 +500,9 @@ bool FdmIccgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
     _qComp.resize(size);
     _sComp.resize(size);
 
-    system->x.set(0.0);
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
     _rComp.set(0.0);
     _dComp.set(0.0);
     _qComp.set(0.0);
@@ -219,6 +522,41 @@ bool FdmIccgSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
            _lastNumberOfIterations < _maxNumberOfIterations;
 }
 
+bool FdmIccgSolver3::solveStencil(FdmStencilLinearSystem3* system) {
+    FdmStencilMatrix3& matrix = system->A;
+    VectorND& solution = system->x;
+    VectorND& rhs = system->b;
+
+    clearUncompressedVectors();
+
+    size_t size = solution.size();
+    _rComp.resize(size);
+    _dComp.resize(size);
+    _qComp.resize(size);
+    _sComp.resize(size);
+
+    if (!isUsingInitialGuess()) {
+        system->x.set(0.0);
+    }
+    _rComp.set(0.0);
+    _dComp.set(0.0);
+    _qComp.set(0.0);
+    _sComp.set(0.0);
+
+    _precondStencil.build(matrix);
+
+    pcg<FdmStencilBlas3, PreconditionerStencil>(
+        matrix, rhs, _maxNumberOfIterations, _tolerance, &_precondStencil,
+        &solution, &_rComp, &_dComp, &_qComp, &_sComp, &_lastNumberOfIterations,
+        &_lastResidualNorm);
+
+    JET_INFO << "Residual after solving ICCG: " << _lastResidualNorm
+             << " Number of ICCG iterations: " << _lastNumberOfIterations;
+
+    return _lastResidualNorm <= _tolerance ||
+           _lastNumberOfIterations < _maxNumberOfIterations;
+}
+
 unsigned int FdmIccgSolver3::maxNumberOfIterations() const {
     return _maxNumberOfIterations;
 }
@@ -231,6 +569,16 @@ double FdmIccgSolver3::tolerance() const { return _tolerance; }
 
 double FdmIccgSolver3::lastResidual() const { return _lastResidualNorm; }
 
+bool FdmIccgSolver3::isUsingParallelPreconditioner() const {
+    return _precond.isParallel;
+}
+
+void FdmIccgSolver3::setIsUsingParallelPreconditioner(bool isUsing) {
+    _precond.isParallel = isUsing;
+    _precondComp.isParallel = isUsing;
+    _precondStencil.isParallel = isUsing;
+}
+
 void FdmIccgSolver3::clearUncompressedVectors() {
     _r.clear();
     _d.clear();
@@ -80,6 +80,36 @@ bool FdmJacobiSolver3::solveCompressed(FdmCompressedLinearSystem3* system) {
     return _lastResidual < _tolerance;
 }
 
+bool FdmJacobiSolver3::solveStencil(FdmStencilLinearSystem3* system) {
+    clearUncompressedVectors();
+
+    _xTempComp.resize(system->x.size());
+    _residualComp.resize(system->x.size());
+
+    _lastNumberOfIterations = _maxNumberOfIterations;
+
+    for (unsigned int iter = 0; iter < _maxNumberOfIterations; ++iter) {
+        relax(system->A, system->b, &system->x, &_xTempComp);
+
+        _xTempComp.swap(system->x);
+
+        if (iter != 0 && iter % _residualCheckInterval == 0) {
+            FdmStencilBlas3::residual(system->A, system->x, system->b,
+                                      &_residualComp);
+
+            if (FdmStencilBlas3::l2Norm(_residualComp) < _tolerance) {
+                _lastNumberOfIterations = iter + 1;
+                break;
+            }
+        }
+    }
+
+    FdmStencilBlas3::residual(system->A, system->x, system->b, &_residualComp);
+    _lastResidual = FdmStencilBlas3::l2Norm(_residualComp);
+
+    return _lastResidual < _tolerance;
+}
+
 unsigned int FdmJacobiSolver3::maxNumberOfIterations() const {
     return _maxNumberOfIterations;
 }
@@ -140,6 +170,23 @@ void FdmJacobiSolver3::relax(const MatrixCsrD& A, const VectorND& b,
     });
 }
 
+void FdmJacobiSolver3::relax(const FdmStencilMatrix3& A, const VectorND& b,
+                             VectorND* x_, VectorND* xTemp_) {
+    VectorND& x = *x_;
+    VectorND& xTemp = *xTemp_;
+
+    b.parallelForEachIndex([&](size_t i) {
+        double r = 0.0;
+        auto addNeighbor = [&](size_t j, double coupling) {
+            r += coupling * x[j];
+        };
+        A.forEachLowerNeighbor(i, addNeighbor);
+        A.forEachUpperNeighbor(i, addNeighbor);
+
+        xTemp[i] = (b[i] - r) / A.rows[i].center;
+    });
+}
+
 void FdmJacobiSolver3::clearUncompressedVectors() {
     _xTempComp.clear();
     _residualComp.clear();
@@ -10,6 +10,10 @@
 #include <jet/math_utils.h>
 #include <jet/parallel.h>
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 using namespace jet;
 
 void FdmLinearSystem2::clear() {
@@ -26,6 +30,20 @@ void FdmLinearSystem2::resize(const Size2& size) {
 
 //
 
+void FdmLinearSystem2F::clear() {
+    A.clear();
+    x.clear();
+    b.clear();
+}
+
+void FdmLinearSystem2F::resize(const Size2& size) {
+    A.resize(size);
+    x.resize(size);
+    b.resize(size);
+}
+
+//
+
 void FdmCompressedLinearSystem2::clear() {
     A.clear();
     x.clear();
@@ -34,19 +52,20 @@ void FdmCompressedLinearSystem2::clear() {
 
 //
 
-void FdmBlas2::set(double s, FdmVector2* result) { result->set(s); }
+namespace {
 
-void FdmBlas2::set(const FdmVector2& v, FdmVector2* result) { result->set(v); }
+// Shared implementations of FdmBlas2 and FdmBlas2F. Reductions are
+// accumulated in double precision regardless of the value type.
 
-void FdmBlas2::set(double s, FdmMatrix2* result) {
-    FdmMatrixRow2 row;
+template <typename Row>
+void setMatrix(double s, Array2<Row>* result) {
+    Row row;
     row.center = row.right = row.up = s;
     result->set(row);
 }
 
-void FdmBlas2::set(const FdmMatrix2& m, FdmMatrix2* result) { result->set(m); }
-
-double FdmBlas2::dot(const FdmVector2& a, const FdmVector2& b) {
+template <typename T>
+double dotImpl(const Array2<T>& a, const Array2<T>& b) {
     Size2 size = a.size();
 
     JET_THROW_INVALID_ARG_IF(size != b.size());
@@ -55,43 +74,52 @@ double FdmBlas2::dot(const FdmVector2& a, const FdmVector2& b) {
 
     for (size_t j = 0; j < size.y; ++j) {
         for (size_t i = 0; i < size.x; ++i) {
-            result += a(i, j) * b(i, j);
+            result += static_cast<double>(a(i, j)) * b(i, j);
         }
     }
 
     return result;
 }
 
-void FdmBlas2::axpy(double a, const FdmVector2& x, const FdmVector2& y,
-                    FdmVector2* result) {
+template <typename T>
+void axpyImpl(double a, const Array2<T>& x, const Array2<T>& y,
+              Array2<T>* result) {
     Size2 size = x.size();
 
     JET_THROW_INVALID_ARG_IF(size != y.size());
     JET_THROW_INVALID_ARG_IF(size != result->size());
 
+    const T aT = static_cast<T>(a);
     x.parallelForEachIndex(
-        [&](size_t i, size_t j) { (*result)(i, j) = a * x(i, j) + y(i, j); });
+        [&](size_t i, size_t j) { (*result)(i, j) = aT * x(i, j) + y(i, j); });
 }
 
-void FdmBlas2::mvm(const FdmMatrix2& m, const FdmVector2& v,
-                   FdmVector2* result) {
+// Returns (m * v)(i, j).
+template <typename T, typename Row>
+T mvmAt(const Array2<Row>& m, const Array2<T>& v, const Size2& size, size_t i,
+        size_t j) {
+    return m(i, j).center * v(i, j) +
+           ((i > 0) ? m(i - 1, j).right * v(i - 1, j) : T(0)) +
+           ((i + 1 < size.x) ? m(i, j).right * v(i + 1, j) : T(0)) +
+           ((j > 0) ? m(i, j - 1).up * v(i, j - 1) : T(0)) +
+           ((j + 1 < size.y) ? m(i, j).up * v(i, j + 1) : T(0));
+}
+
+template <typename T, typename Row>
+void mvmImpl(const Array2<Row>& m, const Array2<T>& v, Array2<T>* result) {
     Size2 size = m.size();
 
     JET_THROW_INVALID_ARG_IF(size != v.size());
     JET_THROW_INVALID_ARG_IF(size != result->size());
 
     m.parallelForEachIndex([&](size_t i, size_t j) {
-        (*result)(i, j) =
-            m(i, j).center * v(i, j) +
-            ((i > 0) ? m(i - 1, j).right * v(i - 1, j) : 0.0) +
-            ((i + 1 < size.x) ? m(i, j).right * v(i + 1, j) : 0.0) +
-            ((j > 0) ? m(i, j - 1).up * v(i, j - 1) : 0.0) +
-            ((j + 1 < size.y) ? m(i, j).up * v(i, j + 1) : 0.0);
+        (*result)(i, j) = mvmAt(m, v, size, i, j);
     });
 }
 
-void FdmBlas2::residual(const FdmMatrix2& a, const FdmVector2& x,
-                        const FdmVector2& b, FdmVector2* result) {
+template <typename T, typename Row>
+void residualImpl(const Array2<Row>& a, const Array2<T>& x,
+                  const Array2<T>& b, Array2<T>* result) {
     Size2 size = a.size();
 
     JET_THROW_INVALID_ARG_IF(size != x.size());
@@ -101,29 +129,237 @@ void FdmBlas2::residual(const FdmMatrix2& a, const FdmVector2& x,
     a.parallelForEachIndex([&](size_t i, size_t j) {
         (*result)(i, j) =
             b(i, j) - a(i, j).center * x(i, j) -
-            ((i > 0) ? a(i - 1, j).right * x(i - 1, j) : 0.0) -
-            ((i + 1 < size.x) ? a(i, j).right * x(i + 1, j) : 0.0) -
-            ((j > 0) ? a(i, j - 1).up * x(i, j - 1) : 0.0) -
-            ((j + 1 < size.y) ? a(i, j).up * x(i, j + 1) : 0.0);
+            ((i > 0) ? a(i - 1, j).right * x(i - 1, j) : T(0)) -
+            ((i + 1 < size.x) ? a(i, j).right * x(i + 1, j) : T(0)) -
+            ((j > 0) ? a(i, j - 1).up * x(i, j - 1) : T(0)) -
+            ((j + 1 < size.y) ? a(i, j).up * x(i, j + 1) : T(0));
     });
 }
 
-double FdmBlas2::l2Norm(const FdmVector2& v) { return std::sqrt(dot(v, v)); }
-
-double FdmBlas2::lInfNorm(const FdmVector2& v) {
+template <typename T>
+double lInfNormImpl(const Array2<T>& v) {
     Size2 size = v.size();
 
     double result = 0.0;
 
     for (size_t j = 0; j < size.y; ++j) {
         for (size_t i = 0; i < size.x; ++i) {
-            result = absmax(result, v(i, j));
+            result = absmax(result, static_cast<double>(v(i, j)));
         }
     }
 
     return std::fabs(result);
 }
 
+// Returns the sum of func(begin, end) over the consecutive chunks of [0, n).
+// The chunks are evaluated in parallel and summed up in order, so the result
+// does not depend on the number of threads.
+template <typename Func>
+double parallelChunkedSum(size_t n, size_t chunkSize, const Func& func) {
+    const size_t numChunks = (n + chunkSize - 1) / chunkSize;
+    std::vector<double> partialSums(numChunks, 0.0);
+    parallelFor(kZeroSize, numChunks, [&](size_t c) {
+        partialSums[c] =
+            func(c * chunkSize, std::min((c + 1) * chunkSize, n));
+    });
+
+    return std::accumulate(partialSums.begin(), partialSums.end(), 0.0);
+}
+
+template <typename T, typename Row>
+double mvmAndDotImpl(const Array2<Row>& m, const Array2<T>& v,
+                     Array2<T>* result) {
+    Size2 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != v.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    return parallelChunkedSum(size.y, 1, [&](size_t jBegin, size_t jEnd) {
+        double sum = 0.0;
+        for (size_t j = jBegin; j < jEnd; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                const T mv = mvmAt(m, v, size, i, j);
+                (*result)(i, j) = mv;
+                sum += static_cast<double>(v(i, j)) * mv;
+            }
+        }
+        return sum;
+    });
+}
+
+template <typename T>
+double axpyPairAndDotImpl(double a, const Array2<T>& d, const Array2<T>& q,
+                          Array2<T>* x, Array2<T>* r) {
+    Size2 size = d.size();
+
+    JET_THROW_INVALID_ARG_IF(size != q.size());
+    JET_THROW_INVALID_ARG_IF(size != x->size());
+    JET_THROW_INVALID_ARG_IF(size != r->size());
+
+    const T aT = static_cast<T>(a);
+    return parallelChunkedSum(size.y, 1, [&](size_t jBegin, size_t jEnd) {
+        double sum = 0.0;
+        for (size_t j = jBegin; j < jEnd; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                (*x)(i, j) += aT * d(i, j);
+                const T ri = (*r)(i, j) - aT * q(i, j);
+                (*r)(i, j) = ri;
+                sum += static_cast<double>(ri) * ri;
+            }
+        }
+        return sum;
+    });
+}
+
+// Rows per chunk for the reductions of the compressed vectors.
+const size_t kCompressedChunkSize = 4096;
+
+}  // namespace
+
+//
+
+void FdmBlas2::set(double s, FdmVector2* result) { result->set(s); }
+
+void FdmBlas2::set(const FdmVector2& v, FdmVector2* result) { result->set(v); }
+
+void FdmBlas2::set(double s, FdmMatrix2* result) { setMatrix(s, result); }
+
+void FdmBlas2::set(const FdmMatrix2& m, FdmMatrix2* result) { result->set(m); }
+
+double FdmBlas2::dot(const FdmVector2& a, const FdmVector2& b) {
+    return dotImpl(a, b);
+}
+
+void FdmBlas2::axpy(double a, const FdmVector2& x, const FdmVector2& y,
+                    FdmVector2* result) {
+    axpyImpl(a, x, y, result);
+}
+
+void FdmBlas2::mvm(const FdmMatrix2& m, const FdmVector2& v,
+                   FdmVector2* result) {
+    mvmImpl(m, v, result);
+}
+
+double FdmBlas2::mvmAndDot(const FdmMatrix2& m, const FdmVector2& v,
+                           FdmVector2* result) {
+    return mvmAndDotImpl(m, v, result);
+}
+
+double FdmBlas2::axpyPairAndDot(double a, const FdmVector2& d,
+                                const FdmVector2& q, FdmVector2* x,
+                                FdmVector2* r) {
+    return axpyPairAndDotImpl(a, d, q, x, r);
+}
+
+void FdmBlas2::residual(const FdmMatrix2& a, const FdmVector2& x,
+                        const FdmVector2& b, FdmVector2* result) {
+    residualImpl(a, x, b, result);
+}
+
+double FdmBlas2::l2Norm(const FdmVector2& v) { return std::sqrt(dot(v, v)); }
+
+double FdmBlas2::lInfNorm(const FdmVector2& v) { return lInfNormImpl(v); }
+
+//
+
+void FdmBlas2F::set(float s, FdmVector2F* result) { result->set(s); }
+
+void FdmBlas2F::set(const FdmVector2F& v, FdmVector2F* result) {
+    result->set(v);
+}
+
+void FdmBlas2F::set(float s, FdmMatrix2F* result) { setMatrix(s, result); }
+
+void FdmBlas2F::set(const FdmMatrix2F& m, FdmMatrix2F* result) {
+    result->set(m);
+}
+
+double FdmBlas2F::dot(const FdmVector2F& a, const FdmVector2F& b) {
+    return dotImpl(a, b);
+}
+
+void FdmBlas2F::axpy(double a, const FdmVector2F& x, const FdmVector2F& y,
+                     FdmVector2F* result) {
+    axpyImpl(a, x, y, result);
+}
+
+void FdmBlas2F::mvm(const FdmMatrix2F& m, const FdmVector2F& v,
+                    FdmVector2F* result) {
+    mvmImpl(m, v, result);
+}
+
+double FdmBlas2F::mvmAndDot(const FdmMatrix2F& m, const FdmVector2F& v,
+                            FdmVector2F* result) {
+    return mvmAndDotImpl(m, v, result);
+}
+
+double FdmBlas2F::axpyPairAndDot(double a, const FdmVector2F& d,
+                                 const FdmVector2F& q, FdmVector2F* x,
+                                 FdmVector2F* r) {
+    return axpyPairAndDotImpl(a, d, q, x, r);
+}
+
+void FdmBlas2F::residual(const FdmMatrix2F& a, const FdmVector2F& x,
+                         const FdmVector2F& b, FdmVector2F* result) {
+    residualImpl(a, x, b, result);
+}
+
+double FdmBlas2F::l2Norm(const FdmVector2F& v) {
+    return std::sqrt(dot(v, v));
+}
+
+double FdmBlas2F::lInfNorm(const FdmVector2F& v) { return lInfNormImpl(v); }
+
+//
+
+void FdmMixedBlas2::set(float s, FdmVector2F* result) { result->set(s); }
+
+void FdmMixedBlas2::set(const FdmVector2F& v, FdmVector2F* result) {
+    result->set(v);
+}
+
+void FdmMixedBlas2::set(float s, FdmMatrix2* result) { setMatrix(s, result); }
+
+void FdmMixedBlas2::set(const FdmMatrix2& m, FdmMatrix2* result) {
+    result->set(m);
+}
+
+double FdmMixedBlas2::dot(const FdmVector2F& a, const FdmVector2F& b) {
+    return dotImpl(a, b);
+}
+
+void FdmMixedBlas2::axpy(double a, const FdmVector2F& x, const FdmVector2F& y,
+                         FdmVector2F* result) {
+    axpyImpl(a, x, y, result);
+}
+
+void FdmMixedBlas2::mvm(const FdmMatrix2& m, const FdmVector2F& v,
+                        FdmVector2F* result) {
+    mvmImpl(m, v, result);
+}
+
+double FdmMixedBlas2::mvmAndDot(const FdmMatrix2& m, const FdmVector2F& v,
+                                FdmVector2F* result) {
+    return mvmAndDotImpl(m, v, result);
+}
+
+double FdmMixedBlas2::axpyPairAndDot(double a, const FdmVector2F& d,
+                                     const FdmVector2F& q, FdmVector2F* x,
+                                     FdmVector2F* r) {
+    return axpyPairAndDotImpl(a, d, q, x, r);
+}
+
+void FdmMixedBlas2::residual(const FdmMatrix2& a, const FdmVector2F& x,
+                             const FdmVector2F& b, FdmVector2F* result) {
+    residualImpl(a, x, b, result);
+}
+
+double FdmMixedBlas2::l2Norm(const FdmVector2F& v) {
+    return std::sqrt(dot(v, v));
+}
+
+double FdmMixedBlas2::lInfNorm(const FdmVector2F& v) { return lInfNormImpl(v); }
+
 //
 
 void FdmCompressedBlas2::set(double s, VectorND* result) { result->set(s); }
@@ -168,6 +404,43 @@ void FdmCompressedBlas2::mvm(const MatrixCsrD& m, const VectorND& v,
     });
 }
 
+double FdmCompressedBlas2::mvmAndDot(const MatrixCsrD& m, const VectorND& v,
+                                     VectorND* result) {
+    const auto rp = m.rowPointersBegin();
+    const auto ci = m.columnIndicesBegin();
+    const auto nnz = m.nonZeroBegin();
+
+    return parallelChunkedSum(
+        v.size(), kCompressedChunkSize, [&](size_t begin, size_t end) {
+            double dot = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                double sum = 0.0;
+                for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+                    sum += nnz[jj] * v[ci[jj]];
+                }
+
+                (*result)[i] = sum;
+                dot += v[i] * sum;
+            }
+            return dot;
+        });
+}
+
+double FdmCompressedBlas2::axpyPairAndDot(double a, const VectorND& d,
+                                          const VectorND& q, VectorND* x,
+                                          VectorND* r) {
+    return parallelChunkedSum(
+        d.size(), kCompressedChunkSize, [&](size_t begin, size_t end) {
+            double dot = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                (*x)[i] += a * d[i];
+                (*r)[i] -= a * q[i];
+                dot += (*r)[i] * (*r)[i];
+            }
+            return dot;
+        });
+}
+
 void FdmCompressedBlas2::residual(const MatrixCsrD& a, const VectorND& x,
                                   const VectorND& b, VectorND* result) {
     const auto rp = a.rowPointersBegin();
@@ -10,6 +10,11 @@
 #include <jet/math_utils.h>
 #include <jet/parallel.h>
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
 using namespace jet;
 
 void FdmLinearSystem3::clear() {
@@ -26,6 +31,20 @@ void FdmLinearSystem3::resize(const Size3& size) {
 
 //
 
+void FdmLinearSystem3F::clear() {
+    A.clear();
+    x.clear();
+    b.clear();
+}
+
+void FdmLinearSystem3F::resize(const Size3& size) {
+    A.resize(size);
+    x.resize(size);
+    b.resize(size);
+}
+
+//
+
 void FdmCompressedLinearSystem3::clear() {
     A.clear();
     x.clear();
@@ -34,19 +53,79 @@ void FdmCompressedLinearSystem3::clear() {
 
 //
 
-void FdmBlas3::set(double s, FdmVector3* result) { result->set(s); }
+const uint32_t FdmStencilMatrix3::kInvalidRow =
+    std::numeric_limits<uint32_t>::max();
 
-void FdmBlas3::set(const FdmVector3& v, FdmVector3* result) { result->set(v); }
+void FdmStencilMatrix3::clear() {
+    rows.clear();
+    cellIndices.clear();
+    rowIndices.clear();
+}
+
+void FdmStencilMatrix3::resize(
+    const Size3& size,
+    const std::function<bool(size_t, size_t, size_t)>& isActive) {
+    JET_THROW_INVALID_ARG_IF(static_cast<uint64_t>(size.x) * size.y * size.z >=
+                             kInvalidRow);
+
+    rowIndices.resize(size);
+    rowIndices.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        rowIndices(i, j, k) = isActive(i, j, k) ? 0 : kInvalidRow;
+    });
+
+    const size_t numCells = size.x * size.y * size.z;
+    uint32_t* map = rowIndices.data();
+    uint32_t numRows = 0;
+    for (size_t c = 0; c < numCells; ++c) {
+        if (map[c] != kInvalidRow) {
+            map[c] = numRows++;
+        }
+    }
+
+    rows.resize(numRows);
+    rows.set(FdmMatrixRow3F());
+    cellIndices.resize(numRows);
+    for (size_t c = 0; c < numCells; ++c) {
+        if (map[c] != kInvalidRow) {
+            cellIndices[map[c]] = static_cast<uint32_t>(c);
+        }
+    }
+}
 
-void FdmBlas3::set(double s, FdmMatrix3* result) {
-    FdmMatrixRow3 row;
+size_t FdmStencilMatrix3::numberOfRows() const { return rows.size(); }
+
+//
+
+void FdmStencilLinearSystem3::clear() {
+    A.clear();
+    x.clear();
+    b.clear();
+}
+
+void FdmStencilLinearSystem3::resize(
+    const Size3& size,
+    const std::function<bool(size_t, size_t, size_t)>& isActive) {
+    A.resize(size, isActive);
+    x.resize(A.numberOfRows(), 0.0);
+    b.resize(A.numberOfRows(), 0.0);
+}
+
+//
+
+namespace {
+
+// Shared implementations of FdmBlas3 and FdmBlas3F. Reductions are
+// accumulated in double precision regardless of the value type.
+
+template <typename Row>
+void setMatrix(double s, Array3<Row>* result) {
+    Row row;
     row.center = row.right = row.up = row.front = s;
     result->set(row);
 }
 
-void FdmBlas3::set(const FdmMatrix3& m, FdmMatrix3* result) { result->set(m); }
-
-double FdmBlas3::dot(const FdmVector3& a, const FdmVector3& b) {
+template <typename T>
+double dotImpl(const Array3<T>& a, const Array3<T>& b) {
     Size3 size = a.size();
 
     JET_THROW_INVALID_ARG_IF(size != b.size());
@@ -56,7 +135,7 @@ double FdmBlas3::dot(const FdmVector3& a, const FdmVector3& b) {
     for (size_t k = 0; k < size.z; ++k) {
         for (size_t j = 0; j < size.y; ++j) {
             for (size_t i = 0; i < size.x; ++i) {
-                result += a(i, j, k) * b(i, j, k);
+                result += static_cast<double>(a(i, j, k)) * b(i, j, k);
             }
         }
     }
@@ -64,39 +143,48 @@ double FdmBlas3::dot(const FdmVector3& a, const FdmVector3& b) {
     return result;
 }
 
-void FdmBlas3::axpy(double a, const FdmVector3& x, const FdmVector3& y,
-                    FdmVector3* result) {
+template <typename T>
+void axpyImpl(double a, const Array3<T>& x, const Array3<T>& y,
+              Array3<T>* result) {
     Size3 size = x.size();
 
     JET_THROW_INVALID_ARG_IF(size != y.size());
     JET_THROW_INVALID_ARG_IF(size != result->size());
 
+    const T aT = static_cast<T>(a);
     x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        (*result)(i, j, k) = a * x(i, j, k) + y(i, j, k);
+        (*result)(i, j, k) = aT * x(i, j, k) + y(i, j, k);
     });
 }
 
-void FdmBlas3::mvm(const FdmMatrix3& m, const FdmVector3& v,
-                   FdmVector3* result) {
+// Returns (m * v)(i, j, k).
+template <typename T, typename Row>
+T mvmAt(const Array3<Row>& m, const Array3<T>& v, const Size3& size, size_t i,
+        size_t j, size_t k) {
+    return m(i, j, k).center * v(i, j, k) +
+           ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k) : T(0)) +
+           ((i + 1 < size.x) ? m(i, j, k).right * v(i + 1, j, k) : T(0)) +
+           ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k) : T(0)) +
+           ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k) : T(0)) +
+           ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1) : T(0)) +
+           ((k + 1 < size.z) ? m(i, j, k).front * v(i, j, k + 1) : T(0));
+}
+
+template <typename T, typename Row>
+void mvmImpl(const Array3<Row>& m, const Array3<T>& v, Array3<T>* result) {
     Size3 size = m.size();
 
     JET_THROW_INVALID_ARG_IF(size != v.size());
     JET_THROW_INVALID_ARG_IF(size != result->size());
 
     m.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        (*result)(i, j, k) =
-            m(i, j, k).center * v(i, j, k) +
-            ((i > 0) ? m(i - 1, j, k).right * v(i - 1, j, k) : 0.0) +
-            ((i + 1 < size.x) ? m(i, j, k).right * v(i + 1, j, k) : 0.0) +
-            ((j > 0) ? m(i, j - 1, k).up * v(i, j - 1, k) : 0.0) +
-            ((j + 1 < size.y) ? m(i, j, k).up * v(i, j + 1, k) : 0.0) +
-            ((k > 0) ? m(i, j, k - 1).front * v(i, j, k - 1) : 0.0) +
-            ((k + 1 < size.z) ? m(i, j, k).front * v(i, j, k + 1) : 0.0);
+        (*result)(i, j, k) = mvmAt(m, v, size, i, j, k);
     });
 }
 
-void FdmBlas3::residual(const FdmMatrix3& a, const FdmVector3& x,
-                        const FdmVector3& b, FdmVector3* result) {
+template <typename T, typename Row>
+void residualImpl(const Array3<Row>& a, const Array3<T>& x,
+                  const Array3<T>& b, Array3<T>* result) {
     Size3 size = a.size();
 
     JET_THROW_INVALID_ARG_IF(size != x.size());
@@ -106,18 +194,17 @@ void FdmBlas3::residual(const FdmMatrix3& a, const FdmVector3& x,
     a.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
         (*result)(i, j, k) =
             b(i, j, k) - a(i, j, k).center * x(i, j, k) -
-            ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : 0.0) -
-            ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : 0.0) -
-            ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : 0.0) -
-            ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : 0.0) -
-            ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : 0.0) -
-            ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : 0.0);
+            ((i > 0) ? a(i - 1, j, k).right * x(i - 1, j, k) : T(0)) -
+            ((i + 1 < size.x) ? a(i, j, k).right * x(i + 1, j, k) : T(0)) -
+            ((j > 0) ? a(i, j - 1, k).up * x(i, j - 1, k) : T(0)) -
+            ((j + 1 < size.y) ? a(i, j, k).up * x(i, j + 1, k) : T(0)) -
+            ((k > 0) ? a(i, j, k - 1).front * x(i, j, k - 1) : T(0)) -
+            ((k + 1 < size.z) ? a(i, j, k).front * x(i, j, k + 1) : T(0));
     });
 }
 
-double FdmBlas3::l2Norm(const FdmVector3& v) { return std::sqrt(dot(v, v)); }
-
-double FdmBlas3::lInfNorm(const FdmVector3& v) {
+template <typename T>
+double lInfNormImpl(const Array3<T>& v) {
     Size3 size = v.size();
 
     double result = 0.0;
@@ -125,7 +212,7 @@ double FdmBlas3::lInfNorm(const FdmVector3& v) {
     for (size_t k = 0; k < size.z; ++k) {
         for (size_t j = 0; j < size.y; ++j) {
             for (size_t i = 0; i < size.x; ++i) {
-                result = absmax(result, v(i, j, k));
+                result = absmax(result, static_cast<double>(v(i, j, k)));
             }
         }
     }
@@ -133,6 +220,231 @@ double FdmBlas3::lInfNorm(const FdmVector3& v) {
     return std::fabs(result);
 }
 
+// Returns the sum of func(begin, end) over the consecutive chunks of [0, n).
+// The chunks are evaluated in parallel and summed up in order, so the result
+// does not depend on the number of threads.
+template <typename Func>
+double parallelChunkedSum(size_t n, size_t chunkSize, const Func& func) {
+    const size_t numChunks = (n + chunkSize - 1) / chunkSize;
+    std::vector<double> partialSums(numChunks, 0.0);
+    parallelFor(kZeroSize, numChunks, [&](size_t c) {
+        partialSums[c] =
+            func(c * chunkSize, std::min((c + 1) * chunkSize, n));
+    });
+
+    return std::accumulate(partialSums.begin(), partialSums.end(), 0.0);
+}
+
+template <typename T, typename Row>
+double mvmAndDotImpl(const Array3<Row>& m, const Array3<T>& v,
+                     Array3<T>* result) {
+    Size3 size = m.size();
+
+    JET_THROW_INVALID_ARG_IF(size != v.size());
+    JET_THROW_INVALID_ARG_IF(size != result->size());
+
+    return parallelChunkedSum(size.z, 1, [&](size_t kBegin, size_t kEnd) {
+        double sum = 0.0;
+        for (size_t k = kBegin; k < kEnd; ++k) {
+            for (size_t j = 0; j < size.y; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    const T mv = mvmAt(m, v, size, i, j, k);
+                    (*result)(i, j, k) = mv;
+                    sum += static_cast<double>(v(i, j, k)) * mv;
+                }
+            }
+        }
+        return sum;
+    });
+}
+
+template <typename T>
+double axpyPairAndDotImpl(double a, const Array3<T>& d, const Array3<T>& q,
+                          Array3<T>* x, Array3<T>* r) {
+    Size3 size = d.size();
+
+    JET_THROW_INVALID_ARG_IF(size != q.size());
+    JET_THROW_INVALID_ARG_IF(size != x->size());
+    JET_THROW_INVALID_ARG_IF(size != r->size());
+
+    const T aT = static_cast<T>(a);
+    return parallelChunkedSum(size.z, 1, [&](size_t kBegin, size_t kEnd) {
+        double sum = 0.0;
+        for (size_t k = kBegin; k < kEnd; ++k) {
+            for (size_t j = 0; j < size.y; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    (*x)(i, j, k) += aT * d(i, j, k);
+                    const T ri = (*r)(i, j, k) - aT * q(i, j, k);
+                    (*r)(i, j, k) = ri;
+                    sum += static_cast<double>(ri) * ri;
+                }
+            }
+        }
+        return sum;
+    });
+}
+
+// Rows per chunk for the reductions of the compressed vectors.
+const size_t kCompressedChunkSize = 4096;
+
+// Returns (m * v)[row] for the stencil matrix.
+double stencilMvmAt(const FdmStencilMatrix3& m, const VectorND& v,
+                    size_t row) {
+    double sum = m.rows[row].center * v[row];
+    auto addNeighbor = [&](size_t n, double coupling) {
+        sum += coupling * v[n];
+    };
+    m.forEachLowerNeighbor(row, addNeighbor);
+    m.forEachUpperNeighbor(row, addNeighbor);
+    return sum;
+}
+
+}  // namespace
+
+//
+
+void FdmBlas3::set(double s, FdmVector3* result) { result->set(s); }
+
+void FdmBlas3::set(const FdmVector3& v, FdmVector3* result) { result->set(v); }
+
+void FdmBlas3::set(double s, FdmMatrix3* result) { setMatrix(s, result); }
+
+void FdmBlas3::set(const FdmMatrix3& m, FdmMatrix3* result) { result->set(m); }
+
+double FdmBlas3::dot(const FdmVector3& a, const FdmVector3& b) {
+    return dotImpl(a, b);
+}
+
+void FdmBlas3::axpy(double a, const FdmVector3& x, const FdmVector3& y,
+                    FdmVector3* result) {
+    axpyImpl(a, x, y, result);
+}
+
+void FdmBlas3::mvm(const FdmMatrix3& m, const FdmVector3& v,
+                   FdmVector3* result) {
+    mvmImpl(m, v, result);
+}
+
+double FdmBlas3::mvmAndDot(const FdmMatrix3& m, const FdmVector3& v,
+                           FdmVector3* result) {
+    return mvmAndDotImpl(m, v, result);
+}
+
+double FdmBlas3::axpyPairAndDot(double a, const FdmVector3& d,
+                                const FdmVector3& q, FdmVector3* x,
+                                FdmVector3* r) {
+    return axpyPairAndDotImpl(a, d, q, x, r);
+}
+
+void FdmBlas3::residual(const FdmMatrix3& a, const FdmVector3& x,
+                        const FdmVector3& b, FdmVector3* result) {
+    residualImpl(a, x, b, result);
+}
+
+double FdmBlas3::l2Norm(const FdmVector3& v) { return std::sqrt(dot(v, v)); }
+
+double FdmBlas3::lInfNorm(const FdmVector3& v) { return lInfNormImpl(v); }
+
+//
+
+void FdmBlas3F::set(float s, FdmVector3F* result) { result->set(s); }
+
+void FdmBlas3F::set(const FdmVector3F& v, FdmVector3F* result) {
+    result->set(v);
+}
+
+void FdmBlas3F::set(float s, FdmMatrix3F* result) { setMatrix(s, result); }
+
+void FdmBlas3F::set(const FdmMatrix3F& m, FdmMatrix3F* result) {
+    result->set(m);
+}
+
+double FdmBlas3F::dot(const FdmVector3F& a, const FdmVector3F& b) {
+    return dotImpl(a, b);
+}
+
+void FdmBlas3F::axpy(double a, const FdmVector3F& x, const FdmVector3F& y,
+                     FdmVector3F* result) {
+    axpyImpl(a, x, y, result);
+}
+
+void FdmBlas3F::mvm(const FdmMatrix3F& m, const FdmVector3F& v,
+                    FdmVector3F* result) {
+    mvmImpl(m, v, result);
+}
+
+double FdmBlas3F::mvmAndDot(const FdmMatrix3F& m, const FdmVector3F& v,
+                            FdmVector3F* result) {
+    return mvmAndDotImpl(m, v, result);
+}
+
+double FdmBlas3F::axpyPairAndDot(double a, const FdmVector3F& d,
+                                 const FdmVector3F& q, FdmVector3F* x,
+                                 FdmVector3F* r) {
+    return axpyPairAndDotImpl(a, d, q, x, r);
+}
+
+void FdmBlas3F::residual(const FdmMatrix3F& a, const FdmVector3F& x,
+                         const FdmVector3F& b, FdmVector3F* result) {
+    residualImpl(a, x, b, result);
+}
+
+double FdmBlas3F::l2Norm(const FdmVector3F& v) {
+    return std::sqrt(dot(v, v));
+}
+
+double FdmBlas3F::lInfNorm(const FdmVector3F& v) { return lInfNormImpl(v); }
+
+//
+
+void FdmMixedBlas3::set(float s, FdmVector3F* result) { result->set(s); }
+
+void FdmMixedBlas3::set(const FdmVector3F& v, FdmVector3F* result) {
+    result->set(v);
+}
+
+void FdmMixedBlas3::set(float s, FdmMatrix3* result) { setMatrix(s, result); }
+
+void FdmMixedBlas3::set(const FdmMatrix3& m, FdmMatrix3* result) {
+    result->set(m);
+}
+
+double FdmMixedBlas3::dot(const FdmVector3F& a, const FdmVector3F& b) {
+    return dotImpl(a, b);
+}
+
+void FdmMixedBlas3::axpy(double a, const FdmVector3F& x, const FdmVector3F& y,
+                         FdmVector3F* result) {
+    axpyImpl(a, x, y, result);
+}
+
+void FdmMixedBlas3::mvm(const FdmMatrix3& m, const FdmVector3F& v,
+                        FdmVector3F* result) {
+    mvmImpl(m, v, result);
+}
+
+double FdmMixedBlas3::mvmAndDot(const FdmMatrix3& m, const FdmVector3F& v,
+                                FdmVector3F* result) {
+    return mvmAndDotImpl(m, v, result);
+}
+
+double FdmMixedBlas3::axpyPairAndDot(double a, const FdmVector3F& d,
+                                     const FdmVector3F& q, FdmVector3F* x,
+                                     FdmVector3F* r) {
+    return axpyPairAndDotImpl(a, d, q, x, r);
+}
+
+void FdmMixedBlas3::residual(const FdmMatrix3& a, const FdmVector3F& x,
+                             const FdmVector3F& b, FdmVector3F* result) {
+    residualImpl(a, x, b, result);
+}
+
+double FdmMixedBlas3::l2Norm(const FdmVector3F& v) {
+    return std::sqrt(dot(v, v));
+}
+
+double FdmMixedBlas3::lInfNorm(const FdmVector3F& v) { return lInfNormImpl(v); }
+
 //
 
 void FdmCompressedBlas3::set(double s, VectorND* result) { result->set(s); }
@@ -177,6 +489,43 @@ void FdmCompressedBlas3::mvm(const MatrixCsrD& m, const VectorND& v,
     });
 }
 
+double FdmCompressedBlas3::mvmAndDot(const MatrixCsrD& m, const VectorND& v,
+                                     VectorND* result) {
+    const auto rp = m.rowPointersBegin();
+    const auto ci = m.columnIndicesBegin();
+    const auto nnz = m.nonZeroBegin();
+
+    return parallelChunkedSum(
+        v.size(), kCompressedChunkSize, [&](size_t begin, size_t end) {
+            double dot = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                double sum = 0.0;
+                for (size_t jj = rp[i]; jj < rp[i + 1]; ++jj) {
+                    sum += nnz[jj] * v[ci[jj]];
+                }
+
+                (*result)[i] = sum;
+                dot += v[i] * sum;
+            }
+            return dot;
+        });
+}
+
+double FdmCompressedBlas3::axpyPairAndDot(double a, const VectorND& d,
+                                          const VectorND& q, VectorND* x,
+                                          VectorND* r) {
+    return parallelChunkedSum(
+        d.size(), kCompressedChunkSize, [&](size_t begin, size_t end) {
+            double dot = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                (*x)[i] += a * d[i];
+                (*r)[i] -= a * q[i];
+                dot += (*r)[i] * (*r)[i];
+            }
+            return dot;
+        });
+}
+
 void FdmCompressedBlas3::residual(const MatrixCsrD& a, const VectorND& x,
                                   const VectorND& b, VectorND* result) {
     const auto rp = a.rowPointersBegin();
@@ -205,3 +554,81 @@ double FdmCompressedBlas3::l2Norm(const VectorND& v) {
 double FdmCompressedBlas3::lInfNorm(const VectorND& v) {
     return std::fabs(v.absmax());
 }
+
+//
+
+void FdmStencilBlas3::set(double s, VectorND* result) { result->set(s); }
+
+void FdmStencilBlas3::set(const VectorND& v, VectorND* result) {
+    result->set(v);
+}
+
+void FdmStencilBlas3::set(double s, FdmStencilMatrix3* result) {
+    FdmMatrixRow3F row;
+    row.center = row.right = row.up = row.front = static_cast<float>(s);
+    result->rows.set(row);
+}
+
+void FdmStencilBlas3::set(const FdmStencilMatrix3& m,
+                          FdmStencilMatrix3* result) {
+    *result = m;
+}
+
+double FdmStencilBlas3::dot(const VectorND& a, const VectorND& b) {
+    return a.dot(b);
+}
+
+void FdmStencilBlas3::axpy(double a, const VectorND& x, const VectorND& y,
+                           VectorND* result) {
+    *result = a * x + y;
+}
+
+void FdmStencilBlas3::mvm(const FdmStencilMatrix3& m, const VectorND& v,
+                          VectorND* result) {
+    JET_THROW_INVALID_ARG_IF(m.numberOfRows() != v.size());
+    JET_THROW_INVALID_ARG_IF(m.numberOfRows() != result->size());
+
+    v.parallelForEachIndex(
+        [&](size_t i) { (*result)[i] = stencilMvmAt(m, v, i); });
+}
+
+double FdmStencilBlas3::mvmAndDot(const FdmStencilMatrix3& m,
+                                  const VectorND& v, VectorND* result) {
+    JET_THROW_INVALID_ARG_IF(m.numberOfRows() != v.size());
+    JET_THROW_INVALID_ARG_IF(m.numberOfRows() != result->size());
+
+    return parallelChunkedSum(
+        v.size(), kCompressedChunkSize, [&](size_t begin, size_t end) {
+            double dot = 0.0;
+            for (size_t i = begin; i < end; ++i) {
+                const double sum = stencilMvmAt(m, v, i);
+                (*result)[i] = sum;
+                dot += v[i] * sum;
+            }
+            return dot;
+        });
+}
+
+double FdmStencilBlas3::axpyPairAndDot(double a, const VectorND& d,
+                                       const VectorND& q, VectorND* x,
+                                       VectorND* r) {
+    return FdmCompressedBlas3::axpyPairAndDot(a, d, q, x, r);
+}
+
+void FdmStencilBlas3::residual(const FdmStencilMatrix3& a, const VectorND& x,
+                               const VectorND& b, VectorND* result) {
+    JET_THROW_INVALID_ARG_IF(a.numberOfRows() != x.size());
+    JET_THROW_INVALID_ARG_IF(a.numberOfRows() != b.size());
+    JET_THROW_INVALID_ARG_IF(a.numberOfRows() != result->size());
+
+    x.parallelForEachIndex(
+        [&](size_t i) { (*result)[i] = b[i] - stencilMvmAt(a, x, i); });
+}
+
+double FdmStencilBlas3::l2Norm(const VectorND& v) {
+    return std::sqrt(v.dot(v));
+}
+
+double FdmStencilBlas3::lInfNorm(const VectorND& v) {
+    return std::fabs(v.absmax());
+}
@@ -42,9 +42,40 @@ void FdmMgLinearSystem2::resizeWithFinest(const Size2 &finestResolution,
                                        &b.levels);
 }
 
-void FdmMgUtils2::restrict(const FdmVector2 &finer, FdmVector2 *coarser) {
-    JET_ASSERT(finer.size().x == 2 * coarser->size().x);
-    JET_ASSERT(finer.size().y == 2 * coarser->size().y);
+void FdmMgLinearSystem2F::clear() {
+    A.levels.clear();
+    x.levels.clear();
+    b.levels.clear();
+}
+
+size_t FdmMgLinearSystem2F::numberOfLevels() const { return A.levels.size(); }
+
+void FdmMgLinearSystem2F::resizeWithCoarsest(const Size2 &coarsestResolution,
+                                             size_t numberOfLevels) {
+    FdmMgUtils2::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &A.levels);
+    FdmMgUtils2::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &x.levels);
+    FdmMgUtils2::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &b.levels);
+}
+
+void FdmMgLinearSystem2F::resizeWithFinest(const Size2 &finestResolution,
+                                           size_t maxNumberOfLevels) {
+    FdmMgUtils2::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &A.levels);
+    FdmMgUtils2::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &x.levels);
+    FdmMgUtils2::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &b.levels);
+}
+
+namespace {
+
+template <typename T>
+void restrictImpl(const Array2<T> &finer, Array2<T> *coarser) {
+    JET_ASSERT(coarser->size().x == (finer.size().x + 1) / 2);
+    JET_ASSERT(coarser->size().y == (finer.size().y + 1) / 2);
 
     // --*--|--*--|--*--|--*--
     //  1/8   3/8   3/8   1/8
@@ -52,41 +83,56 @@ void FdmMgUtils2::restrict(const FdmVector2 &finer, FdmVector2 *coarser) {
     // -----|-----*-----|-----
     static const std::array<double, 4> kernel = {{0.125, 0.375, 0.375, 0.125}};
 
+    const Size2 m = finer.size();
     const Size2 n = coarser->size();
     parallelRangeFor(
         kZeroSize, n.x, kZeroSize, n.y,
         [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
             std::array<size_t, 4> jIndices;
+            std::array<double, 4> jWeights;
 
             for (size_t j = jBegin; j < jEnd; ++j) {
                 jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
                 jIndices[1] = 2 * j;
-                jIndices[2] = 2 * j + 1;
-                jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
+                jIndices[2] = std::min(2 * j + 1, m.y - 1);
+                jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : jIndices[2];
+                jWeights = kernel;
+                if (2 * j + 1 >= m.y) {
+                    // Zero-padded cell of the odd-sized finer grid
+                    jWeights[2] = 0.0;
+                    jWeights[3] = 0.0;
+                }
 
                 std::array<size_t, 4> iIndices;
+                std::array<double, 4> iWeights;
                 for (size_t i = iBegin; i < iEnd; ++i) {
                     iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
                     iIndices[1] = 2 * i;
-                    iIndices[2] = 2 * i + 1;
-                    iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
+                    iIndices[2] = std::min(2 * i + 1, m.x - 1);
+                    iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : iIndices[2];
+                    iWeights = kernel;
+                    if (2 * i + 1 >= m.x) {
+                        iWeights[2] = 0.0;
+                        iWeights[3] = 0.0;
+                    }
 
                     double sum = 0.0;
                     for (size_t y = 0; y < 4; ++y) {
                         for (size_t x = 0; x < 4; ++x) {
-                            double w = kernel[x] * kernel[y];
+                            double w = iWeights[x] * jWeights[y];
                             sum += w * finer(iIndices[x], jIndices[y]);
                         }
                     }
-                    (*coarser)(i, j) = sum;
+                    (*coarser)(i, j) = static_cast<T>(sum);
                 }
             }
         });
 }
 
-void FdmMgUtils2::correct(const FdmVector2 &coarser, FdmVector2 *finer) {
-    JET_ASSERT(finer->size().x == 2 * coarser.size().x);
-    JET_ASSERT(finer->size().y == 2 * coarser.size().y);
+template <typename T>
+void correctImpl(const Array2<T> &coarser, Array2<T> *finer) {
+    JET_ASSERT(coarser.size().x == (finer->size().x + 1) / 2);
+    JET_ASSERT(coarser.size().y == (finer->size().y + 1) / 2);
 
     // -----|-----*-----|-----
     //           to
@@ -134,10 +180,28 @@ void FdmMgUtils2::correct(const FdmVector2 &coarser, FdmVector2 *finer) {
                         for (size_t x = 0; x < 2; ++x) {
                             double w = iWeights[x] * jWeights[y] *
                                        coarser(iIndices[x], jIndices[y]);
-                            (*finer)(i, j) += w;
+                            (*finer)(i, j) += static_cast<T>(w);
                         }
                     }
                 }
             }
         });
 }
+
+}  // namespace
+
+void FdmMgUtils2::restrict(const FdmVector2 &finer, FdmVector2 *coarser) {
+    restrictImpl(finer, coarser);
+}
+
+void FdmMgUtils2::correct(const FdmVector2 &coarser, FdmVector2 *finer) {
+    correctImpl(coarser, finer);
+}
+
+void FdmMgUtils2::restrict(const FdmVector2F &finer, FdmVector2F *coarser) {
+    restrictImpl(finer, coarser);
+}
+
+void FdmMgUtils2::correct(const FdmVector2F &coarser, FdmVector2F *finer) {
+    correctImpl(coarser, finer);
+}
@@ -40,10 +40,41 @@ void FdmMgLinearSystem3::resizeWithFinest(const Size3 &finestResolution,
                                        &b.levels);
 }
 
-void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
-    JET_ASSERT(finer.size().x == 2 * coarser->size().x);
-    JET_ASSERT(finer.size().y == 2 * coarser->size().y);
-    JET_ASSERT(finer.size().z == 2 * coarser->size().z);
+void FdmMgLinearSystem3F::clear() {
+    A.levels.clear();
+    x.levels.clear();
+    b.levels.clear();
+}
+
+size_t FdmMgLinearSystem3F::numberOfLevels() const { return A.levels.size(); }
+
+void FdmMgLinearSystem3F::resizeWithCoarsest(const Size3 &coarsestResolution,
+                                             size_t numberOfLevels) {
+    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &A.levels);
+    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &x.levels);
+    FdmMgUtils3::resizeArrayWithCoarsest(coarsestResolution, numberOfLevels,
+                                         &b.levels);
+}
+
+void FdmMgLinearSystem3F::resizeWithFinest(const Size3 &finestResolution,
+                                           size_t maxNumberOfLevels) {
+    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &A.levels);
+    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &x.levels);
+    FdmMgUtils3::resizeArrayWithFinest(finestResolution, maxNumberOfLevels,
+                                       &b.levels);
+}
+
+namespace {
+
+template <typename T>
+void restrictImpl(const Array3<T> &finer, Array3<T> *coarser) {
+    JET_ASSERT(coarser->size().x == (finer.size().x + 1) / 2);
+    JET_ASSERT(coarser->size().y == (finer.size().y + 1) / 2);
+    JET_ASSERT(coarser->size().z == (finer.size().z + 1) / 2);
 
     // --*--|--*--|--*--|--*--
     //  1/8   3/8   3/8   1/8
@@ -51,56 +82,77 @@ void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
     // -----|-----*-----|-----
     static const std::array<double, 4> kernel = {{0.125, 0.375, 0.375, 0.125}};
 
+    const Size3 m = finer.size();
     const Size3 n = coarser->size();
     parallelRangeFor(
         kZeroSize, n.x, kZeroSize, n.y, kZeroSize, n.z,
         [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
             size_t kBegin, size_t kEnd) {
             std::array<size_t, 4> kIndices;
+            std::array<double, 4> kWeights;
 
             for (size_t k = kBegin; k < kEnd; ++k) {
                 kIndices[0] = (k > 0) ? 2 * k - 1 : 2 * k;
                 kIndices[1] = 2 * k;
-                kIndices[2] = 2 * k + 1;
-                kIndices[3] = (k + 1 < n.z) ? 2 * k + 2 : 2 * k + 1;
+                kIndices[2] = std::min(2 * k + 1, m.z - 1);
+                kIndices[3] = (k + 1 < n.z) ? 2 * k + 2 : kIndices[2];
+                kWeights = kernel;
+                if (2 * k + 1 >= m.z) {
+                    // Zero-padded cell of the odd-sized finer grid
+                    kWeights[2] = 0.0;
+                    kWeights[3] = 0.0;
+                }
 
                 std::array<size_t, 4> jIndices;
+                std::array<double, 4> jWeights;
 
                 for (size_t j = jBegin; j < jEnd; ++j) {
                     jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
                     jIndices[1] = 2 * j;
-                    jIndices[2] = 2 * j + 1;
-                    jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
+                    jIndices[2] = std::min(2 * j + 1, m.y - 1);
+                    jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : jIndices[2];
+                    jWeights = kernel;
+                    if (2 * j + 1 >= m.y) {
+                        jWeights[2] = 0.0;
+                        jWeights[3] = 0.0;
+                    }
 
                     std::array<size_t, 4> iIndices;
+                    std::array<double, 4> iWeights;
                     for (size_t i = iBegin; i < iEnd; ++i) {
                         iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
                         iIndices[1] = 2 * i;
-                        iIndices[2] = 2 * i + 1;
-                        iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
+                        iIndices[2] = std::min(2 * i + 1, m.x - 1);
+                        iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : iIndices[2];
+                        iWeights = kernel;
+                        if (2 * i + 1 >= m.x) {
+                            iWeights[2] = 0.0;
+                            iWeights[3] = 0.0;
+                        }
 
                         double sum = 0.0;
                         for (size_t z = 0; z < 4; ++z) {
                             for (size_t y = 0; y < 4; ++y) {
                                 for (size_t x = 0; x < 4; ++x) {
                                     double w =
-                                        kernel[x] * kernel[y] * kernel[z];
+                                        iWeights[x] * jWeights[y] * kWeights[z];
                                     sum += w * finer(iIndices[x], jIndices[y],
                                                      kIndices[z]);
                                 }
                             }
                         }
-                        (*coarser)(i, j, k) = sum;
+                        (*coarser)(i, j, k) = static_cast<T>(sum);
                     }
                 }
             }
         });
 }
 
-void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
-    JET_ASSERT(finer->size().x == 2 * coarser.size().x);
-    JET_ASSERT(finer->size().y == 2 * coarser.size().y);
-    JET_ASSERT(finer->size().z == 2 * coarser.size().z);
+template <typename T>
+void correctImpl(const Array3<T> &coarser, Array3<T> *finer) {
+    JET_ASSERT(coarser.size().x == (finer->size().x + 1) / 2);
+    JET_ASSERT(coarser.size().y == (finer->size().y + 1) / 2);
+    JET_ASSERT(coarser.size().z == (finer->size().z + 1) / 2);
 
     // -----|-----*-----|-----
     //           to
@@ -156,7 +208,7 @@ void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
                             kWeights[1] = 0.75;
                         } else {
                             kIndices[0] = ck;
-                            kIndices[1] = (k + 1 < n.y) ? ck + 1 : ck;
+                            kIndices[1] = (k + 1 < n.z) ? ck + 1 : ck;
                             kWeights[0] = 0.75;
                             kWeights[1] = 0.25;
                         }
@@ -168,7 +220,7 @@ void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
                                                kWeights[z] *
                                                coarser(iIndices[x], jIndices[y],
                                                        kIndices[z]);
-                                    (*finer)(i, j, k) += w;
+                                    (*finer)(i, j, k) += static_cast<T>(w);
                                 }
                             }
                         }
@@ -177,3 +229,21 @@ void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
             }
         });
 }
+
+}  // namespace
+
+void FdmMgUtils3::restrict(const FdmVector3 &finer, FdmVector3 *coarser) {
+    restrictImpl(finer, coarser);
+}
+
+void FdmMgUtils3::correct(const FdmVector3 &coarser, FdmVector3 *finer) {
+    correctImpl(coarser, finer);
+}
+
+void FdmMgUtils3::restrict(const FdmVector3F &finer, FdmVector3F *coarser) {
+    restrictImpl(finer, coarser);
+}
+
+void FdmMgUtils3::correct(const FdmVector3F &coarser, FdmVector3F *finer) {
+    correctImpl(coarser, finer);
+}
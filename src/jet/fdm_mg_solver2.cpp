@@ -6,28 +6,53 @@
 
 #include <pch.h>
 
+#include <jet/cg.h>
 #include <jet/fdm_gauss_seidel_solver2.h>
 #include <jet/fdm_mg_solver2.h>
 
 using namespace jet;
 
-FdmMgSolver2::FdmMgSolver2(size_t maxNumberOfLevels,
-                           unsigned int numberOfRestrictionIter,
-                           unsigned int numberOfCorrectionIter,
-                           unsigned int numberOfCoarsestIter,
-                           unsigned int numberOfFinalIter, double maxTolerance,
-                           double sorFactor, bool useRedBlackOrdering) {
-    _mgParams.maxNumberOfLevels = maxNumberOfLevels;
-    _mgParams.numberOfRestrictionIter = numberOfRestrictionIter;
-    _mgParams.numberOfCorrectionIter = numberOfCorrectionIter;
-    _mgParams.numberOfCoarsestIter = numberOfCoarsestIter;
-    _mgParams.numberOfFinalIter = numberOfFinalIter;
-    _mgParams.maxTolerance = maxTolerance;
+namespace {
+
+template <typename BlasType>
+void cgSolve(const typename BlasType::MatrixType& A,
+             const typename BlasType::VectorType& b,
+             unsigned int numberOfIterations, double maxTolerance,
+             typename BlasType::VectorType* x,
+             typename BlasType::VectorType* buffer) {
+    typename BlasType::VectorType d(b.size());
+    typename BlasType::VectorType q(b.size());
+    typename BlasType::VectorType s(b.size());
+    unsigned int lastNumberOfIterations;
+    double lastResidualNorm;
+
+    cg<BlasType>(A, b, numberOfIterations, maxTolerance, x, buffer, &d, &q, &s,
+                 &lastNumberOfIterations, &lastResidualNorm);
+}
+
+// Sets up the same cycle for the double- and single-precision systems.
+template <typename BlasType>
+void setUpParams(size_t maxNumberOfLevels,
+                 unsigned int numberOfRestrictionIter,
+                 unsigned int numberOfCorrectionIter,
+                 unsigned int numberOfCoarsestIter,
+                 unsigned int numberOfFinalIter, double maxTolerance,
+                 double sorFactor, bool useRedBlackOrdering,
+                 MgParameters<BlasType>* params) {
+    typedef typename BlasType::MatrixType MatrixType;
+    typedef typename BlasType::VectorType VectorType;
+
+    params->maxNumberOfLevels = maxNumberOfLevels;
+    params->numberOfRestrictionIter = numberOfRestrictionIter;
+    params->numberOfCorrectionIter = numberOfCorrectionIter;
+    params->numberOfCoarsestIter = numberOfCoarsestIter;
+    params->numberOfFinalIter = numberOfFinalIter;
+    params->maxTolerance = maxTolerance;
     if (useRedBlackOrdering) {
-        _mgParams.relaxFunc = [sorFactor](
-            const FdmMatrix2& A, const FdmVector2& b,
-            unsigned int numberOfIterations, double maxTolerance, FdmVector2* x,
-            FdmVector2* buffer) {
+        params->relaxFunc = [sorFactor](
+            const MatrixType& A, const VectorType& b,
+            unsigned int numberOfIterations, double maxTolerance, VectorType* x,
+            VectorType* buffer) {
             UNUSED_VARIABLE(buffer);
             UNUSED_VARIABLE(maxTolerance);
 
@@ -36,10 +61,10 @@ FdmMgSolver2::FdmMgSolver2(size_t maxNumberOfLevels,
             }
         };
     } else {
-        _mgParams.relaxFunc = [sorFactor](
-            const FdmMatrix2& A, const FdmVector2& b,
-            unsigned int numberOfIterations, double maxTolerance, FdmVector2* x,
-            FdmVector2* buffer) {
+        params->relaxFunc = [sorFactor](
+            const MatrixType& A, const VectorType& b,
+            unsigned int numberOfIterations, double maxTolerance, VectorType* x,
+            VectorType* buffer) {
             UNUSED_VARIABLE(buffer);
             UNUSED_VARIABLE(maxTolerance);
 
@@ -48,8 +73,30 @@ FdmMgSolver2::FdmMgSolver2(size_t maxNumberOfLevels,
             }
         };
     }
-    _mgParams.restrictFunc = FdmMgUtils2::restrict;
-    _mgParams.correctFunc = FdmMgUtils2::correct;
+    params->restrictFunc = [](const VectorType& finer, VectorType* coarser) {
+        FdmMgUtils2::restrict(finer, coarser);
+    };
+    params->correctFunc = [](const VectorType& coarser, VectorType* finer) {
+        FdmMgUtils2::correct(coarser, finer);
+    };
+}
+
+}  // namespace
+
+FdmMgSolver2::FdmMgSolver2(size_t maxNumberOfLevels,
+                           unsigned int numberOfRestrictionIter,
+                           unsigned int numberOfCorrectionIter,
+                           unsigned int numberOfCoarsestIter,
+                           unsigned int numberOfFinalIter, double maxTolerance,
+                           double sorFactor, bool useRedBlackOrdering) {
+    setUpParams(maxNumberOfLevels, numberOfRestrictionIter,
+                numberOfCorrectionIter, numberOfCoarsestIter,
+                numberOfFinalIter, maxTolerance, sorFactor,
+                useRedBlackOrdering, &_mgParams);
+    setUpParams(maxNumberOfLevels, numberOfRestrictionIter,
+                numberOfCorrectionIter, numberOfCoarsestIter,
+                numberOfFinalIter, maxTolerance, sorFactor,
+                useRedBlackOrdering, &_mgParamsF);
 
     _sorFactor = sorFactor;
     _useRedBlackOrdering = useRedBlackOrdering;
@@ -57,18 +104,51 @@ FdmMgSolver2::FdmMgSolver2(size_t maxNumberOfLevels,
 
 const MgParameters<FdmBlas2>& FdmMgSolver2::params() const { return _mgParams; }
 
+const MgParameters<FdmBlas2F>& FdmMgSolver2::singlePrecisionParams() const {
+    return _mgParamsF;
+}
+
 double FdmMgSolver2::sorFactor() const { return _sorFactor; }
 
 bool FdmMgSolver2::useRedBlackOrdering() const { return _useRedBlackOrdering; }
 
+MgCycleType FdmMgSolver2::cycleType() const { return _mgParams.cycleType; }
+
+void FdmMgSolver2::setCycleType(MgCycleType cycleType) {
+    _mgParams.cycleType = cycleType;
+    _mgParamsF.cycleType = cycleType;
+}
+
+bool FdmMgSolver2::isUsingCgAtCoarsestLevel() const {
+    return static_cast<bool>(_mgParams.coarsestSolveFunc);
+}
+
+void FdmMgSolver2::setIsUsingCgAtCoarsestLevel(bool isUsing) {
+    if (isUsing) {
+        _mgParams.coarsestSolveFunc = cgSolve<FdmBlas2>;
+        _mgParamsF.coarsestSolveFunc = cgSolve<FdmBlas2F>;
+    } else {
+        _mgParams.coarsestSolveFunc = nullptr;
+        _mgParamsF.coarsestSolveFunc = nullptr;
+    }
+}
+
 bool FdmMgSolver2::solve(FdmLinearSystem2* system) {
     UNUSED_VARIABLE(system);
     return false;
 }
 
 bool FdmMgSolver2::solve(FdmMgLinearSystem2* system) {
-    FdmMgVector2 buffer = system->x;
+    // Copying into the kept buffer reuses its memory across the solves
+    _buffer = system->x;
     auto result =
-        mgVCycle(system->A, _mgParams, &system->x, &system->b, &buffer);
+        mgCycle(system->A, _mgParams, &system->x, &system->b, &_buffer);
     return result.lastResidualNorm < _mgParams.maxTolerance;
 }
+
+bool FdmMgSolver2::solve(FdmMgLinearSystem2F* system) {
+    _bufferF = system->x;
+    auto result =
+        mgCycle(system->A, _mgParamsF, &system->x, &system->b, &_bufferF);
+    return result.lastResidualNorm < _mgParamsF.maxTolerance;
+}
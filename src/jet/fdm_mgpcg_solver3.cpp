@@ -12,24 +12,27 @@
 
 using namespace jet;
 
-void FdmMgpcgSolver3::Preconditioner::build(FdmMgLinearSystem3* system_,
-                                            MgParameters<FdmBlas3> mgParams_) {
-    system = system_;
+template <typename BlasType>
+void FdmMgpcgSolver3::Preconditioner<BlasType>::build(
+    const MgMatrix<BlasType>* A_, const MgVector<BlasType>& x,
+    MgParameters<BlasType> mgParams_) {
+    A = A_;
     mgParams = mgParams_;
-}
 
-void FdmMgpcgSolver3::Preconditioner::solve(const FdmVector3& b,
-                                            FdmVector3* x) {
-    // Copy dimension
-    FdmMgVector3 mgX = system->x;
-    FdmMgVector3 mgB = system->x;
-    FdmMgVector3 mgBuffer = system->x;
+    // Copy dimension once; the cycle overwrites the coarser levels anyway.
+    mgX = x;
+    mgB = x;
+    mgBuffer = x;
+}
 
+template <typename BlasType>
+void FdmMgpcgSolver3::Preconditioner<BlasType>::solve(
+    const typename BlasType::VectorType& b, typename BlasType::VectorType* x) {
     // Copy input to the top
-    mgX.levels.front().set(*x);
+    mgX.levels.front().set(0);
     mgB.levels.front().set(b);
 
-    mgVCycle(system->A, mgParams, &mgX, &mgB, &mgBuffer);
+    mgCycle(*A, mgParams, &mgX, &mgB, &mgBuffer);
 
     // Copy result to the output
     x->set(mgX.levels.front());
@@ -52,25 +55,57 @@ FdmMgpcgSolver3::FdmMgpcgSolver3(
       _lastResidualNorm(kMaxD) {}
 
 bool FdmMgpcgSolver3::solve(FdmMgLinearSystem3* system) {
-    Size3 size = system->A.levels.front().size();
-    _r.resize(size);
-    _d.resize(size);
-    _q.resize(size);
-    _s.resize(size);
-
-    system->x.levels.front().set(0.0);
-    _r.set(0.0);
-    _d.set(0.0);
-    _q.set(0.0);
-    _s.set(0.0);
-
-    _precond.build(system, params());
-
-    pcg<FdmBlas3, Preconditioner>(system->A.levels.front(),
-                                  system->b.levels.front(),
-                                  _maxNumberOfIterations, _tolerance, &_precond,
-                                  &system->x.levels.front(), &_r, &_d, &_q, &_s,
-                                  &_lastNumberOfIterations, &_lastResidualNorm);
+    _rF.clear();
+    _dF.clear();
+    _qF.clear();
+    _sF.clear();
+    _precondF = Preconditioner<FdmBlas3F>();
+
+    return solveImpl(&system->A, &system->x, &system->b, params(), &_r, &_d,
+                     &_q, &_s, &_precond);
+}
+
+bool FdmMgpcgSolver3::solve(FdmMgLinearSystem3F* system) {
+    _r.clear();
+    _d.clear();
+    _q.clear();
+    _s.clear();
+    _precond = Preconditioner<FdmBlas3>();
+
+    return solveImpl(&system->A, &system->x, &system->b,
+                     singlePrecisionParams(), &_rF, &_dF, &_qF, &_sF,
+                     &_precondF);
+}
+
+template <typename BlasType>
+bool FdmMgpcgSolver3::solveImpl(const MgMatrix<BlasType>* A,
+                                MgVector<BlasType>* x, MgVector<BlasType>* b,
+                                const MgParameters<BlasType>& mgParams,
+                                typename BlasType::VectorType* r,
+                                typename BlasType::VectorType* d,
+                                typename BlasType::VectorType* q,
+                                typename BlasType::VectorType* s,
+                                Preconditioner<BlasType>* precond) {
+    Size3 size = A->levels.front().size();
+    r->resize(size);
+    d->resize(size);
+    q->resize(size);
+    s->resize(size);
+
+    if (!isUsingInitialGuess()) {
+        x->levels.front().set(0);
+    }
+    r->set(0);
+    d->set(0);
+    q->set(0);
+    s->set(0);
+
+    precond->build(A, *x, mgParams);
+
+    pcg<BlasType, Preconditioner<BlasType>>(
+        A->levels.front(), b->levels.front(), _maxNumberOfIterations,
+        _tolerance, precond, &x->levels.front(), r, d, q, s,
+        &_lastNumberOfIterations, &_lastResidualNorm);
 
     JET_INFO << "Residual after solving MGPCG: " << _lastResidualNorm
              << " Number of MGPCG iterations: " << _lastNumberOfIterations;
@@ -6,6 +6,7 @@
 
 #include <pch.h>
 #include <jet/flip_solver2.h>
+#include <jet/grid_samplers2.h>
 
 using namespace jet;
 
@@ -63,27 +64,21 @@ void FlipSolver2::transferFromGridsToParticles() {
         _vDelta(i, j) = static_cast<float>(flow->v(i, j)) - _vDelta(i, j);
     });
 
-    LinearArraySampler2<float, float> uSampler(
+    LinearFaceCenteredArraySampler2<float, float> deltaSampler(
         _uDelta.constAccessor(),
-        flow->gridSpacing().castTo<float>(),
-        flow->uOrigin().castTo<float>());
-    LinearArraySampler2<float, float> vSampler(
         _vDelta.constAccessor(),
         flow->gridSpacing().castTo<float>(),
+        flow->uOrigin().castTo<float>(),
         flow->vOrigin().castTo<float>());
-
-    auto sampler = [uSampler, vSampler](const Vector2D& x) {
-        const auto xf = x.castTo<float>();
-        double u = uSampler(xf);
-        double v = vSampler(xf);
-        return Vector2D(u, v);
-    };
+    LinearGridSampler2<FaceCenteredGrid2> flowSampler(*flow);
 
     // Transfer delta to the particles
     parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        Vector2D flipVel = velocities[i] + sampler(positions[i]);
+        const Vector2D delta =
+            deltaSampler(positions[i].castTo<float>()).castTo<double>();
+        Vector2D flipVel = velocities[i] + delta;
         if (_picBlendingFactor > 0.0) {
-            Vector2D picVel = flow->sample(positions[i]);
+            Vector2D picVel = flowSampler(positions[i]);
             flipVel = lerp(flipVel, picVel, _picBlendingFactor);
         }
         velocities[i] = flipVel;
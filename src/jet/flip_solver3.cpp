@@ -5,6 +5,7 @@
 // property of any third parties.
 
 #include <jet/flip_solver3.h>
+#include <jet/grid_samplers3.h>
 #include <pch.h>
 
 using namespace jet;
@@ -69,29 +70,20 @@ void FlipSolver3::transferFromGridsToParticles() {
             static_cast<float>(flow->w(i, j, k)) - _wDelta(i, j, k);
     });
 
-    LinearArraySampler3<float, float> uSampler(
-        _uDelta.constAccessor(), flow->gridSpacing().castTo<float>(),
-        flow->uOrigin().castTo<float>());
-    LinearArraySampler3<float, float> vSampler(
-        _vDelta.constAccessor(), flow->gridSpacing().castTo<float>(),
-        flow->vOrigin().castTo<float>());
-    LinearArraySampler3<float, float> wSampler(
+    LinearFaceCenteredArraySampler3<float, float> deltaSampler(
+        _uDelta.constAccessor(), _vDelta.constAccessor(),
         _wDelta.constAccessor(), flow->gridSpacing().castTo<float>(),
+        flow->uOrigin().castTo<float>(), flow->vOrigin().castTo<float>(),
         flow->wOrigin().castTo<float>());
-
-    auto sampler = [uSampler, vSampler, wSampler](const Vector3D& x) {
-        const auto xf = x.castTo<float>();
-        double u = uSampler(xf);
-        double v = vSampler(xf);
-        double w = wSampler(xf);
-        return Vector3D(u, v, w);
-    };
+    LinearGridSampler3<FaceCenteredGrid3> flowSampler(*flow);
 
     // Transfer delta to the particles
     parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        Vector3D flipVel = velocities[i] + sampler(positions[i]);
+        const Vector3D delta =
+            deltaSampler(positions[i].castTo<float>()).castTo<double>();
+        Vector3D flipVel = velocities[i] + delta;
         if (_picBlendingFactor > 0.0) {
-            Vector3D picVel = flow->sample(positions[i]);
+            Vector3D picVel = flowSampler(positions[i]);
             flipVel = lerp(flipVel, picVel, _picBlendingFactor);
         }
         velocities[i] = flipVel;
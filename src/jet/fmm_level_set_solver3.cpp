@@ -6,6 +6,7 @@
 
 #include <pch.h>
 
+#include <narrow_band_helpers.h>
 #include <jet/fdm_utils.h>
 #include <jet/fmm_level_set_solver3.h>
 #include <jet/level_set_utils.h>
@@ -19,6 +20,42 @@ using namespace jet;
 static const char kUnknown = 0;
 static const char kKnown = 1;
 static const char kTrial = 2;
+static const char kFrozen = 3;
+
+// Visits the data points in the band, or the entire grid if band is null.
+template <typename Callback>
+inline void forEachBandPoint(const Size3& size,
+                             const std::vector<Point3UI>* band,
+                             const Callback& func) {
+    if (band == nullptr) {
+        for (size_t k = 0; k < size.z; ++k) {
+            for (size_t j = 0; j < size.y; ++j) {
+                for (size_t i = 0; i < size.x; ++i) {
+                    func(i, j, k);
+                }
+            }
+        }
+    } else {
+        for (const Point3UI& pt : *band) {
+            func(pt.x, pt.y, pt.z);
+        }
+    }
+}
+
+template <typename Callback>
+inline void parallelForEachBandPoint(const Size3& size,
+                                     const std::vector<Point3UI>* band,
+                                     const Callback& func) {
+    if (band == nullptr) {
+        parallelFor(kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+                    func);
+    } else {
+        parallelFor(kZeroSize, band->size(), [&](size_t l) {
+            const Point3UI& pt = (*band)[l];
+            func(pt.x, pt.y, pt.z);
+        });
+    }
+}
 
 // Find geometric solution near the boundary
 inline double solveQuadNearBoundary(const Array3<char>& markers,
@@ -221,22 +258,48 @@ FmmLevelSetSolver3::FmmLevelSetSolver3() {}
 void FmmLevelSetSolver3::reinitialize(const ScalarGrid3& inputSdf,
                                       double maxDistance,
                                       ScalarGrid3* outputSdf) {
+    reinitialize(inputSdf, maxDistance, nullptr, outputSdf);
+}
+
+void FmmLevelSetSolver3::reinitializeNarrowBand(const ScalarGrid3& inputSdf,
+                                                double bandWidth,
+                                                ScalarGrid3* outputSdf) {
+    std::vector<Point3UI> band;
+    findNarrowBand(inputSdf.constDataAccessor(), bandWidth, &band);
+
+    reinitialize(inputSdf, bandWidth, &band, outputSdf);
+}
+
+void FmmLevelSetSolver3::reinitialize(const ScalarGrid3& inputSdf,
+                                      double maxDistance,
+                                      const std::vector<Point3UI>* band,
+                                      ScalarGrid3* outputSdf) {
     JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
 
     Size3 size = inputSdf.dataSize();
     Vector3D gridSpacing = inputSdf.gridSpacing();
     Vector3D invGridSpacing = 1.0 / gridSpacing;
     Vector3D invGridSpacingSqr = invGridSpacing * invGridSpacing;
-    Array3<char> markers(size);
+
+    // The data points outside the band are frozen to the clamped input and
+    // never enter the march.
+    Array3<char> markers(size, kFrozen);
 
     auto output = outputSdf->dataAccessor();
 
-    markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        output(i, j, k) = inputSdf(i, j, k);
-    });
+    if (band == nullptr) {
+        markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            output(i, j, k) = inputSdf(i, j, k);
+        });
+    } else {
+        markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            output(i, j, k) =
+                clampToNarrowBand(inputSdf(i, j, k), maxDistance);
+        });
+    }
 
     // Solve geometrically near the boundary
-    markers.forEachIndex([&](size_t i, size_t j, size_t k) {
+    forEachBandPoint(size, band, [&](size_t i, size_t j, size_t k) {
         if (isInsideSdf(output(i, j, k)) &&
             ((i > 0 && !isInsideSdf(output(i - 1, j, k))) ||
              (i + 1 < size.x && !isInsideSdf(output(i + 1, j, k))) ||
@@ -249,7 +312,7 @@ void FmmLevelSetSolver3::reinitialize(const ScalarGrid3& inputSdf,
                 invGridSpacingSqr, -1.0, i, j, k);
         }
     });
-    markers.forEachIndex([&](size_t i, size_t j, size_t k) {
+    forEachBandPoint(size, band, [&](size_t i, size_t j, size_t k) {
         if (!isInsideSdf(output(i, j, k)) &&
             ((i > 0 && isInsideSdf(output(i - 1, j, k))) ||
              (i + 1 < size.x && isInsideSdf(output(i + 1, j, k))) ||
@@ -265,7 +328,7 @@ void FmmLevelSetSolver3::reinitialize(const ScalarGrid3& inputSdf,
 
     for (int sign = 0; sign < 2; ++sign) {
         // Build markers
-        markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        parallelForEachBandPoint(size, band, [&](size_t i, size_t j, size_t k) {
             if (isInsideSdf(output(i, j, k))) {
                 markers(i, j, k) = kKnown;
             } else {
@@ -280,8 +343,8 @@ void FmmLevelSetSolver3::reinitialize(const ScalarGrid3& inputSdf,
         // Enqueue initial candidates
         std::priority_queue<Point3UI, std::vector<Point3UI>, decltype(compare)>
             trial(compare);
-        markers.forEachIndex([&](size_t i, size_t j, size_t k) {
-            if (markers(i, j, k) != kKnown &&
+        forEachBandPoint(size, band, [&](size_t i, size_t j, size_t k) {
+            if (markers(i, j, k) == kUnknown &&
                 ((i > 0 && markers(i - 1, j, k) == kKnown) ||
                  (i + 1 < size.x && markers(i + 1, j, k) == kKnown) ||
                  (j > 0 && markers(i, j - 1, k) == kKnown) ||
@@ -371,9 +434,14 @@ void FmmLevelSetSolver3::reinitialize(const ScalarGrid3& inputSdf,
             }
         }
 
-        // Flip the sign
-        markers.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-            output(i, j, k) = -output(i, j, k);
+        // Flip the sign (and clamp the overshoots of the last front)
+        parallelForEachBandPoint(size, band, [&](size_t i, size_t j, size_t k) {
+            if (band == nullptr) {
+                output(i, j, k) = -output(i, j, k);
+            } else {
+                output(i, j, k) =
+                    -clampToNarrowBand(output(i, j, k), maxDistance);
+            }
         });
     }
 }
@@ -15,6 +15,8 @@ struct ScalarGridSerialized3;
 
 struct VectorGridSerialized3;
 
+struct SparseScalarGridSerialized3;
+
 struct GridSystemData3;
 
 struct ScalarGridSerialized3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -141,6 +143,80 @@ inline flatbuffers::Offset<VectorGridSerialized3> CreateVectorGridSerialized3Dir
       data ? _fbb.CreateVector<uint8_t>(*data) : 0);
 }
 
+struct SparseScalarGridSerialized3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  enum {
+    VT_TYPE = 4,
+    VT_BACKGROUND = 6,
+    VT_DATA = 8
+  };
+  const flatbuffers::String *type() const {
+    return GetPointer<const flatbuffers::String *>(VT_TYPE);
+  }
+  double background() const {
+    return GetField<double>(VT_BACKGROUND, 0.0);
+  }
+  const flatbuffers::Vector<uint8_t> *data() const {
+    return GetPointer<const flatbuffers::Vector<uint8_t> *>(VT_DATA);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_TYPE) &&
+           verifier.Verify(type()) &&
+           VerifyField<double>(verifier, VT_BACKGROUND) &&
+           VerifyOffset(verifier, VT_DATA) &&
+           verifier.Verify(data()) &&
+           verifier.EndTable();
+  }
+};
+
+struct SparseScalarGridSerialized3Builder {
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_type(flatbuffers::Offset<flatbuffers::String> type) {
+    fbb_.AddOffset(SparseScalarGridSerialized3::VT_TYPE, type);
+  }
+  void add_background(double background) {
+    fbb_.AddElement<double>(SparseScalarGridSerialized3::VT_BACKGROUND, background, 0.0);
+  }
+  void add_data(flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data) {
+    fbb_.AddOffset(SparseScalarGridSerialized3::VT_DATA, data);
+  }
+  SparseScalarGridSerialized3Builder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  SparseScalarGridSerialized3Builder &operator=(const SparseScalarGridSerialized3Builder &);
+  flatbuffers::Offset<SparseScalarGridSerialized3> Finish() {
+    const auto end = fbb_.EndTable(start_, 3);
+    auto o = flatbuffers::Offset<SparseScalarGridSerialized3>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<SparseScalarGridSerialized3> CreateSparseScalarGridSerialized3(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> type = 0,
+    double background = 0.0,
+    flatbuffers::Offset<flatbuffers::Vector<uint8_t>> data = 0) {
+  SparseScalarGridSerialized3Builder builder_(_fbb);
+  builder_.add_background(background);
+  builder_.add_data(data);
+  builder_.add_type(type);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<SparseScalarGridSerialized3> CreateSparseScalarGridSerialized3Direct(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *type = nullptr,
+    double background = 0.0,
+    const std::vector<uint8_t> *data = nullptr) {
+  return jet::fbs::CreateSparseScalarGridSerialized3(
+      _fbb,
+      type ? _fbb.CreateString(type) : 0,
+      background,
+      data ? _fbb.CreateVector<uint8_t>(*data) : 0);
+}
+
 struct GridSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum {
     VT_RESOLUTION = 4,
@@ -150,7 +226,9 @@ struct GridSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_SCALARDATA = 12,
     VT_VECTORDATA = 14,
     VT_ADVECTABLESCALARDATA = 16,
-    VT_ADVECTABLEVECTORDATA = 18
+    VT_ADVECTABLEVECTORDATA = 18,
+    VT_SPARSESCALARDATA = 20,
+    VT_ADVECTABLESPARSESCALARDATA = 22
   };
   const jet::fbs::Size3 *resolution() const {
     return GetStruct<const jet::fbs::Size3 *>(VT_RESOLUTION);
@@ -176,6 +254,12 @@ struct GridSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<VectorGridSerialized3>> *advectableVectorData() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<VectorGridSerialized3>> *>(VT_ADVECTABLEVECTORDATA);
   }
+  const flatbuffers::Vector<flatbuffers::Offset<SparseScalarGridSerialized3>> *sparseScalarData() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<SparseScalarGridSerialized3>> *>(VT_SPARSESCALARDATA);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<SparseScalarGridSerialized3>> *advectableSparseScalarData() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<SparseScalarGridSerialized3>> *>(VT_ADVECTABLESPARSESCALARDATA);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<jet::fbs::Size3>(verifier, VT_RESOLUTION) &&
@@ -194,6 +278,12 @@ struct GridSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_ADVECTABLEVECTORDATA) &&
            verifier.Verify(advectableVectorData()) &&
            verifier.VerifyVectorOfTables(advectableVectorData()) &&
+           VerifyOffset(verifier, VT_SPARSESCALARDATA) &&
+           verifier.Verify(sparseScalarData()) &&
+           verifier.VerifyVectorOfTables(sparseScalarData()) &&
+           VerifyOffset(verifier, VT_ADVECTABLESPARSESCALARDATA) &&
+           verifier.Verify(advectableSparseScalarData()) &&
+           verifier.VerifyVectorOfTables(advectableSparseScalarData()) &&
            verifier.EndTable();
   }
 };
@@ -225,13 +315,19 @@ struct GridSystemData3Builder {
   void add_advectableVectorData(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<VectorGridSerialized3>>> advectableVectorData) {
     fbb_.AddOffset(GridSystemData3::VT_ADVECTABLEVECTORDATA, advectableVectorData);
   }
+  void add_sparseScalarData(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<SparseScalarGridSerialized3>>> sparseScalarData) {
+    fbb_.AddOffset(GridSystemData3::VT_SPARSESCALARDATA, sparseScalarData);
+  }
+  void add_advectableSparseScalarData(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<SparseScalarGridSerialized3>>> advectableSparseScalarData) {
+    fbb_.AddOffset(GridSystemData3::VT_ADVECTABLESPARSESCALARDATA, advectableSparseScalarData);
+  }
   GridSystemData3Builder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
   }
   GridSystemData3Builder &operator=(const GridSystemData3Builder &);
   flatbuffers::Offset<GridSystemData3> Finish() {
-    const auto end = fbb_.EndTable(start_, 8);
+    const auto end = fbb_.EndTable(start_, 10);
     auto o = flatbuffers::Offset<GridSystemData3>(end);
     return o;
   }
@@ -246,9 +342,13 @@ inline flatbuffers::Offset<GridSystemData3> CreateGridSystemData3(
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ScalarGridSerialized3>>> scalarData = 0,
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<VectorGridSerialized3>>> vectorData = 0,
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ScalarGridSerialized3>>> advectableScalarData = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<VectorGridSerialized3>>> advectableVectorData = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<VectorGridSerialized3>>> advectableVectorData = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<SparseScalarGridSerialized3>>> sparseScalarData = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<SparseScalarGridSerialized3>>> advectableSparseScalarData = 0) {
   GridSystemData3Builder builder_(_fbb);
   builder_.add_velocityIdx(velocityIdx);
+  builder_.add_advectableSparseScalarData(advectableSparseScalarData);
+  builder_.add_sparseScalarData(sparseScalarData);
   builder_.add_advectableVectorData(advectableVectorData);
   builder_.add_advectableScalarData(advectableScalarData);
   builder_.add_vectorData(vectorData);
@@ -268,7 +368,9 @@ inline flatbuffers::Offset<GridSystemData3> CreateGridSystemData3Direct(
     const std::vector<flatbuffers::Offset<ScalarGridSerialized3>> *scalarData = nullptr,
     const std::vector<flatbuffers::Offset<VectorGridSerialized3>> *vectorData = nullptr,
     const std::vector<flatbuffers::Offset<ScalarGridSerialized3>> *advectableScalarData = nullptr,
-    const std::vector<flatbuffers::Offset<VectorGridSerialized3>> *advectableVectorData = nullptr) {
+    const std::vector<flatbuffers::Offset<VectorGridSerialized3>> *advectableVectorData = nullptr,
+    const std::vector<flatbuffers::Offset<SparseScalarGridSerialized3>> *sparseScalarData = nullptr,
+    const std::vector<flatbuffers::Offset<SparseScalarGridSerialized3>> *advectableSparseScalarData = nullptr) {
   return jet::fbs::CreateGridSystemData3(
       _fbb,
       resolution,
@@ -278,7 +380,9 @@ inline flatbuffers::Offset<GridSystemData3> CreateGridSystemData3Direct(
       scalarData ? _fbb.CreateVector<flatbuffers::Offset<ScalarGridSerialized3>>(*scalarData) : 0,
       vectorData ? _fbb.CreateVector<flatbuffers::Offset<VectorGridSerialized3>>(*vectorData) : 0,
       advectableScalarData ? _fbb.CreateVector<flatbuffers::Offset<ScalarGridSerialized3>>(*advectableScalarData) : 0,
-      advectableVectorData ? _fbb.CreateVector<flatbuffers::Offset<VectorGridSerialized3>>(*advectableVectorData) : 0);
+      advectableVectorData ? _fbb.CreateVector<flatbuffers::Offset<VectorGridSerialized3>>(*advectableVectorData) : 0,
+      sparseScalarData ? _fbb.CreateVector<flatbuffers::Offset<SparseScalarGridSerialized3>>(*sparseScalarData) : 0,
+      advectableSparseScalarData ? _fbb.CreateVector<flatbuffers::Offset<SparseScalarGridSerialized3>>(*advectableSparseScalarData) : 0);
 }
 
 inline const jet::fbs::GridSystemData3 *GetGridSystemData3(const void *buf) {
@@ -183,15 +183,21 @@ inline flatbuffers::Offset<PointNeighborSearcherSerialized3> CreatePointNeighbor
 
 struct ParticleNeighborList3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   enum {
-    VT_DATA = 4
+    VT_OFFSETS = 4,
+    VT_INDICES = 6
   };
-  const flatbuffers::Vector<uint64_t> *data() const {
-    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_DATA);
+  const flatbuffers::Vector<uint64_t> *offsets() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_OFFSETS);
+  }
+  const flatbuffers::Vector<uint32_t> *indices() const {
+    return GetPointer<const flatbuffers::Vector<uint32_t> *>(VT_INDICES);
   }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
-           VerifyOffset(verifier, VT_DATA) &&
-           verifier.Verify(data()) &&
+           VerifyOffset(verifier, VT_OFFSETS) &&
+           verifier.Verify(offsets()) &&
+           VerifyOffset(verifier, VT_INDICES) &&
+           verifier.Verify(indices()) &&
            verifier.EndTable();
   }
 };
@@ -199,8 +205,11 @@ struct ParticleNeighborList3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Tabl
 struct ParticleNeighborList3Builder {
   flatbuffers::FlatBufferBuilder &fbb_;
   flatbuffers::uoffset_t start_;
-  void add_data(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> data) {
-    fbb_.AddOffset(ParticleNeighborList3::VT_DATA, data);
+  void add_offsets(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> offsets) {
+    fbb_.AddOffset(ParticleNeighborList3::VT_OFFSETS, offsets);
+  }
+  void add_indices(flatbuffers::Offset<flatbuffers::Vector<uint32_t>> indices) {
+    fbb_.AddOffset(ParticleNeighborList3::VT_INDICES, indices);
   }
   ParticleNeighborList3Builder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
@@ -208,7 +217,7 @@ struct ParticleNeighborList3Builder {
   }
   ParticleNeighborList3Builder &operator=(const ParticleNeighborList3Builder &);
   flatbuffers::Offset<ParticleNeighborList3> Finish() {
-    const auto end = fbb_.EndTable(start_, 1);
+    const auto end = fbb_.EndTable(start_, 2);
     auto o = flatbuffers::Offset<ParticleNeighborList3>(end);
     return o;
   }
@@ -216,18 +225,22 @@ struct ParticleNeighborList3Builder {
 
 inline flatbuffers::Offset<ParticleNeighborList3> CreateParticleNeighborList3(
     flatbuffers::FlatBufferBuilder &_fbb,
-    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> data = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> offsets = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint32_t>> indices = 0) {
   ParticleNeighborList3Builder builder_(_fbb);
-  builder_.add_data(data);
+  builder_.add_indices(indices);
+  builder_.add_offsets(offsets);
   return builder_.Finish();
 }
 
 inline flatbuffers::Offset<ParticleNeighborList3> CreateParticleNeighborList3Direct(
     flatbuffers::FlatBufferBuilder &_fbb,
-    const std::vector<uint64_t> *data = nullptr) {
+    const std::vector<uint64_t> *offsets = nullptr,
+    const std::vector<uint32_t> *indices = nullptr) {
   return jet::fbs::CreateParticleNeighborList3(
       _fbb,
-      data ? _fbb.CreateVector<uint64_t>(*data) : 0);
+      offsets ? _fbb.CreateVector<uint64_t>(*offsets) : 0,
+      indices ? _fbb.CreateVector<uint32_t>(*indices) : 0);
 }
 
 struct ParticleSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -266,8 +279,8 @@ struct ParticleSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
   const PointNeighborSearcherSerialized3 *neighborSearcher() const {
     return GetPointer<const PointNeighborSearcherSerialized3 *>(VT_NEIGHBORSEARCHER);
   }
-  const flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>> *neighborLists() const {
-    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>> *>(VT_NEIGHBORLISTS);
+  const ParticleNeighborList3 *neighborLists() const {
+    return GetPointer<const ParticleNeighborList3 *>(VT_NEIGHBORLISTS);
   }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
@@ -285,8 +298,7 @@ struct ParticleSystemData3 FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table
            VerifyOffset(verifier, VT_NEIGHBORSEARCHER) &&
            verifier.VerifyTable(neighborSearcher()) &&
            VerifyOffset(verifier, VT_NEIGHBORLISTS) &&
-           verifier.Verify(neighborLists()) &&
-           verifier.VerifyVectorOfTables(neighborLists()) &&
+           verifier.VerifyTable(neighborLists()) &&
            verifier.EndTable();
   }
 };
@@ -318,7 +330,7 @@ struct ParticleSystemData3Builder {
   void add_neighborSearcher(flatbuffers::Offset<PointNeighborSearcherSerialized3> neighborSearcher) {
     fbb_.AddOffset(ParticleSystemData3::VT_NEIGHBORSEARCHER, neighborSearcher);
   }
-  void add_neighborLists(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>>> neighborLists) {
+  void add_neighborLists(flatbuffers::Offset<ParticleNeighborList3> neighborLists) {
     fbb_.AddOffset(ParticleSystemData3::VT_NEIGHBORLISTS, neighborLists);
   }
   ParticleSystemData3Builder(flatbuffers::FlatBufferBuilder &_fbb)
@@ -343,7 +355,7 @@ inline flatbuffers::Offset<ParticleSystemData3> CreateParticleSystemData3(
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ScalarParticleData3>>> scalarDataList = 0,
     flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<VectorParticleData3>>> vectorDataList = 0,
     flatbuffers::Offset<PointNeighborSearcherSerialized3> neighborSearcher = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<ParticleNeighborList3>>> neighborLists = 0) {
+    flatbuffers::Offset<ParticleNeighborList3> neighborLists = 0) {
   ParticleSystemData3Builder builder_(_fbb);
   builder_.add_forceIdx(forceIdx);
   builder_.add_velocityIdx(velocityIdx);
@@ -367,7 +379,7 @@ inline flatbuffers::Offset<ParticleSystemData3> CreateParticleSystemData3Direct(
     const std::vector<flatbuffers::Offset<ScalarParticleData3>> *scalarDataList = nullptr,
     const std::vector<flatbuffers::Offset<VectorParticleData3>> *vectorDataList = nullptr,
     flatbuffers::Offset<PointNeighborSearcherSerialized3> neighborSearcher = 0,
-    const std::vector<flatbuffers::Offset<ParticleNeighborList3>> *neighborLists = nullptr) {
+    flatbuffers::Offset<ParticleNeighborList3> neighborLists = 0) {
   return jet::fbs::CreateParticleSystemData3(
       _fbb,
       radius,
@@ -378,7 +390,7 @@ inline flatbuffers::Offset<ParticleSystemData3> CreateParticleSystemData3Direct(
       scalarDataList ? _fbb.CreateVector<flatbuffers::Offset<ScalarParticleData3>>(*scalarDataList) : 0,
       vectorDataList ? _fbb.CreateVector<flatbuffers::Offset<VectorParticleData3>>(*vectorDataList) : 0,
       neighborSearcher,
-      neighborLists ? _fbb.CreateVector<flatbuffers::Offset<ParticleNeighborList3>>(*neighborLists) : 0);
+      neighborLists);
 }
 
 inline const jet::fbs::ParticleSystemData3 *GetParticleSystemData3(const void *buf) {
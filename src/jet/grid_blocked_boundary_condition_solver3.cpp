@@ -82,9 +82,11 @@ void GridBlockedBoundaryConditionSolver3::onColliderUpdated(
     const auto sdf
         = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(colliderSdf());
 
+    // Without a collider, the distance field is sparse and all cells are
+    // fluid.
     _marker.resize(gridSize);
     _marker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (isInsideSdf((*sdf)(i, j, k))) {
+        if (sdf != nullptr && isInsideSdf((*sdf)(i, j, k))) {
             _marker(i, j, k) = kCollider;
         } else {
             _marker(i, j, k) = kFluid;
@@ -15,8 +15,9 @@
 #include <jet/grid_fluid_solver2.h>
 #include <jet/grid_fractional_single_phase_pressure_solver2.h>
 #include <jet/level_set_utils.h>
+#include <jet/profiler.h>
+#include <jet/reducers.h>
 #include <jet/surface_to_implicit2.h>
-#include <jet/timer.h>
 
 #include <algorithm>
 
@@ -56,13 +57,22 @@ void GridFluidSolver2::setViscosityCoefficient(double newValue) {
 
 double GridFluidSolver2::cfl(double timeIntervalInSeconds) const {
     auto vel = _grids->velocity();
-    double maxVel = 0.0;
-    vel->forEachCellIndex([&](size_t i, size_t j) {
-        Vector2D v =
-            vel->valueAtCellCenter(i, j) + timeIntervalInSeconds * _gravity;
-        maxVel = std::max(maxVel, v.x);
-        maxVel = std::max(maxVel, v.y);
-    });
+    const Size2 res = vel->resolution();
+    const MaxReducer<double> reducer(0.0);
+    const double maxVel = parallelDeterministicReduce(
+        kZeroSize, res.y, reducer.identity(),
+        [&](size_t jBegin, size_t jEnd, double result) {
+            for (size_t j = jBegin; j < jEnd; ++j) {
+                for (size_t i = 0; i < res.x; ++i) {
+                    Vector2D v = vel->valueAtCellCenter(i, j) +
+                                 timeIntervalInSeconds * _gravity;
+                    result = std::max(result, v.x);
+                    result = std::max(result, v.y);
+                }
+            }
+            return result;
+        },
+        reducer);
 
     Vector2D gridSpacing = _grids->gridSpacing();
     double minGridSize = std::min(gridSpacing.x, gridSpacing.y);
@@ -164,15 +174,15 @@ void GridFluidSolver2::setEmitter(const GridEmitter2Ptr& newEmitter) {
 void GridFluidSolver2::onInitialize() {
     // When initializing the solver, update the collider and emitter state as
     // well since they also affects the initial condition of the simulation.
-    Timer timer;
-    updateCollider(0.0);
-    JET_INFO << "Update collider took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver2::updateCollider");
+        updateCollider(0.0);
+    }
 
-    timer.reset();
-    updateEmitter(0.0);
-    JET_INFO << "Update emitter took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver2::updateEmitter");
+        updateEmitter(0.0);
+    }
 }
 
 void GridFluidSolver2::onAdvanceTimeStep(double timeIntervalInSeconds) {
@@ -184,25 +194,25 @@ void GridFluidSolver2::onAdvanceTimeStep(double timeIntervalInSeconds) {
 
     beginAdvanceTimeStep(timeIntervalInSeconds);
 
-    Timer timer;
-    computeExternalForces(timeIntervalInSeconds);
-    JET_INFO << "Computing external force took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver2::computeExternalForces");
+        computeExternalForces(timeIntervalInSeconds);
+    }
 
-    timer.reset();
-    computeViscosity(timeIntervalInSeconds);
-    JET_INFO << "Computing viscosity force took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver2::computeViscosity");
+        computeViscosity(timeIntervalInSeconds);
+    }
 
-    timer.reset();
-    computePressure(timeIntervalInSeconds);
-    JET_INFO << "Computing pressure force took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver2::computePressure");
+        computePressure(timeIntervalInSeconds);
+    }
 
-    timer.reset();
-    computeAdvection(timeIntervalInSeconds);
-    JET_INFO << "Computing advection force took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver2::computeAdvection");
+        computeAdvection(timeIntervalInSeconds);
+    }
 
     endAdvanceTimeStep(timeIntervalInSeconds);
 }
@@ -401,8 +411,8 @@ void GridFluidSolver2::extrapolateIntoCollider(FaceCenteredGrid2* grid) {
     });
 
     unsigned int depth = static_cast<unsigned int>(std::ceil(_maxCfl));
-    extrapolateToRegion(grid->uConstAccessor(), uMarker, depth, u);
-    extrapolateToRegion(grid->vConstAccessor(), vMarker, depth, v);
+    extrapolateToRegion(grid->uConstAccessor(), grid->vConstAccessor(),
+                        uMarker, vMarker, depth, u, v);
 }
 
 ScalarField2Ptr GridFluidSolver2::colliderSdf() const {
@@ -415,15 +425,15 @@ VectorField2Ptr GridFluidSolver2::colliderVelocityField() const {
 
 void GridFluidSolver2::beginAdvanceTimeStep(double timeIntervalInSeconds) {
     // Update collider and emitter
-    Timer timer;
-    updateCollider(timeIntervalInSeconds);
-    JET_INFO << "Update collider took " << timer.durationInSeconds()
-             << " seconds";
-
-    timer.reset();
-    updateEmitter(timeIntervalInSeconds);
-    JET_INFO << "Update emitter took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver2::updateCollider");
+        updateCollider(timeIntervalInSeconds);
+    }
+
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver2::updateEmitter");
+        updateEmitter(timeIntervalInSeconds);
+    }
 
     // Update boundary condition solver
     if (_boundaryConditionSolver != nullptr) {
@@ -15,8 +15,9 @@
 #include <jet/grid_fluid_solver3.h>
 #include <jet/grid_fractional_single_phase_pressure_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/profiler.h>
+#include <jet/reducers.h>
 #include <jet/surface_to_implicit3.h>
-#include <jet/timer.h>
 
 #include <algorithm>
 
@@ -56,14 +57,25 @@ void GridFluidSolver3::setViscosityCoefficient(double newValue) {
 
 double GridFluidSolver3::cfl(double timeIntervalInSeconds) const {
     auto vel = _grids->velocity();
-    double maxVel = 0.0;
-    vel->forEachCellIndex([&](size_t i, size_t j, size_t k) {
-        Vector3D v =
-            vel->valueAtCellCenter(i, j, k) + timeIntervalInSeconds * _gravity;
-        maxVel = std::max(maxVel, v.x);
-        maxVel = std::max(maxVel, v.y);
-        maxVel = std::max(maxVel, v.z);
-    });
+    const Size3 res = vel->resolution();
+    const MaxReducer<double> reducer(0.0);
+    const double maxVel = parallelDeterministicReduce(
+        kZeroSize, res.z, reducer.identity(),
+        [&](size_t kBegin, size_t kEnd, double result) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = 0; j < res.y; ++j) {
+                    for (size_t i = 0; i < res.x; ++i) {
+                        Vector3D v = vel->valueAtCellCenter(i, j, k) +
+                                     timeIntervalInSeconds * _gravity;
+                        result = std::max(result, v.x);
+                        result = std::max(result, v.y);
+                        result = std::max(result, v.z);
+                    }
+                }
+            }
+            return result;
+        },
+        reducer);
 
     Vector3D gridSpacing = _grids->gridSpacing();
     double minGridSize = min3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
@@ -165,15 +177,15 @@ void GridFluidSolver3::setEmitter(const GridEmitter3Ptr& newEmitter) {
 void GridFluidSolver3::onInitialize() {
     // When initializing the solver, update the collider and emitter state as
     // well since they also affects the initial condition of the simulation.
-    Timer timer;
-    updateCollider(0.0);
-    JET_INFO << "Update collider took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver3::updateCollider");
+        updateCollider(0.0);
+    }
 
-    timer.reset();
-    updateEmitter(0.0);
-    JET_INFO << "Update emitter took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver3::updateEmitter");
+        updateEmitter(0.0);
+    }
 }
 
 void GridFluidSolver3::onAdvanceTimeStep(double timeIntervalInSeconds) {
@@ -186,25 +198,25 @@ void GridFluidSolver3::onAdvanceTimeStep(double timeIntervalInSeconds) {
 
     beginAdvanceTimeStep(timeIntervalInSeconds);
 
-    Timer timer;
-    computeExternalForces(timeIntervalInSeconds);
-    JET_INFO << "Computing external force took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver3::computeExternalForces");
+        computeExternalForces(timeIntervalInSeconds);
+    }
 
-    timer.reset();
-    computeViscosity(timeIntervalInSeconds);
-    JET_INFO << "Computing viscosity force took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver3::computeViscosity");
+        computeViscosity(timeIntervalInSeconds);
+    }
 
-    timer.reset();
-    computePressure(timeIntervalInSeconds);
-    JET_INFO << "Computing pressure force took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver3::computePressure");
+        computePressure(timeIntervalInSeconds);
+    }
 
-    timer.reset();
-    computeAdvection(timeIntervalInSeconds);
-    JET_INFO << "Computing advection force took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver3::computeAdvection");
+        computeAdvection(timeIntervalInSeconds);
+    }
 
     endAdvanceTimeStep(timeIntervalInSeconds);
 }
@@ -258,11 +270,16 @@ void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
         // Solve advections for custom scalar fields
         size_t n = _grids->numberOfAdvectableScalarData();
         for (size_t i = 0; i < n; ++i) {
-            auto grid = _grids->advectableScalarDataAt(i);
+            advectScalarData(i, timeIntervalInSeconds);
+        }
+
+        // Solve advections for sparse scalar fields
+        n = _grids->numberOfAdvectableSparseScalarData();
+        for (size_t i = 0; i < n; ++i) {
+            auto grid = _grids->advectableSparseScalarDataAt(i);
             auto grid0 = grid->clone();
             _advectionSolver->advect(*grid0, *vel, timeIntervalInSeconds,
                                      grid.get(), *colliderSdf());
-            extrapolateIntoCollider(grid.get());
         }
 
         // Solve advections for custom vector fields
@@ -310,6 +327,16 @@ void GridFluidSolver3::computeAdvection(double timeIntervalInSeconds) {
     }
 }
 
+void GridFluidSolver3::advectScalarData(size_t index,
+                                        double timeIntervalInSeconds) {
+    auto vel = velocity();
+    auto grid = _grids->advectableScalarDataAt(index);
+    auto grid0 = grid->clone();
+    _advectionSolver->advect(*grid0, *vel, timeIntervalInSeconds, grid.get(),
+                             *colliderSdf());
+    extrapolateIntoCollider(grid.get());
+}
+
 ScalarField3Ptr GridFluidSolver3::fluidSdf() const {
     return std::make_shared<ConstantScalarField3>(-kMaxD);
 }
@@ -421,9 +448,9 @@ void GridFluidSolver3::extrapolateIntoCollider(FaceCenteredGrid3* grid) {
     });
 
     unsigned int depth = static_cast<unsigned int>(std::ceil(_maxCfl));
-    extrapolateToRegion(grid->uConstAccessor(), uMarker, depth, u);
-    extrapolateToRegion(grid->vConstAccessor(), vMarker, depth, v);
-    extrapolateToRegion(grid->wConstAccessor(), wMarker, depth, w);
+    extrapolateToRegion(grid->uConstAccessor(), grid->vConstAccessor(),
+                        grid->wConstAccessor(), uMarker, vMarker, wMarker,
+                        depth, u, v, w);
 }
 
 ScalarField3Ptr GridFluidSolver3::colliderSdf() const {
@@ -436,15 +463,15 @@ VectorField3Ptr GridFluidSolver3::colliderVelocityField() const {
 
 void GridFluidSolver3::beginAdvanceTimeStep(double timeIntervalInSeconds) {
     // Update collider and emitter
-    Timer timer;
-    updateCollider(timeIntervalInSeconds);
-    JET_INFO << "Update collider took " << timer.durationInSeconds()
-             << " seconds";
-
-    timer.reset();
-    updateEmitter(timeIntervalInSeconds);
-    JET_INFO << "Update emitter took " << timer.durationInSeconds()
-             << " seconds";
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver3::updateCollider");
+        updateCollider(timeIntervalInSeconds);
+    }
+
+    {
+        JET_PROFILE_SCOPE("GridFluidSolver3::updateEmitter");
+        updateEmitter(timeIntervalInSeconds);
+    }
 
     // Update boundary condition solver
     if (_boundaryConditionSolver != nullptr) {
@@ -82,9 +82,8 @@ void GridFractionalBoundaryConditionSolver2::constrainVelocity(
 
     // Free-slip: Extrapolate fluid velocity into the collider
     extrapolateToRegion(
-        velocity->uConstAccessor(), uMarker, extrapolationDepth, u);
-    extrapolateToRegion(
-        velocity->vConstAccessor(), vMarker, extrapolationDepth, v);
+        velocity->uConstAccessor(), velocity->vConstAccessor(),
+        uMarker, vMarker, extrapolationDepth, u, v);
 
     // No-flux: project the extrapolated velocity to the collider's surface
     // normal
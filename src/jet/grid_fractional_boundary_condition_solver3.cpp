@@ -10,6 +10,7 @@
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/grid_fractional_boundary_condition_solver3.h>
 #include <jet/level_set_utils.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
 #include <jet/surface_to_implicit3.h>
 #include <algorithm>
 
@@ -27,7 +28,11 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
     FaceCenteredGrid3* velocity,
     unsigned int extrapolationDepth) {
     Size3 size = velocity->resolution();
-    if (_colliderSdf == nullptr || _colliderSdf->resolution() != size) {
+    const bool isColliderSdfUpToDate =
+        (_colliderSdf != nullptr && _colliderSdf->resolution() == size) ||
+        (_emptyColliderSdf != nullptr &&
+         _emptyColliderSdf->resolution() == size);
+    if (!isColliderSdfUpToDate) {
         updateCollider(
             collider(),
             size,
@@ -35,6 +40,8 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
             velocity->origin());
     }
 
+    const ScalarField3Ptr sdf = colliderSdf();
+
     auto u = velocity->uAccessor();
     auto v = velocity->vAccessor();
     auto w = velocity->wAccessor();
@@ -54,8 +61,8 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
     // Assign collider's velocity first and initialize markers
     velocity->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
         Vector3D pt = uPos(i, j, k);
-        double phi0 = _colliderSdf->sample(pt - Vector3D(0.5 * h.x, 0.0, 0.0));
-        double phi1 = _colliderSdf->sample(pt + Vector3D(0.5 * h.x, 0.0, 0.0));
+        double phi0 = sdf->sample(pt - Vector3D(0.5 * h.x, 0.0, 0.0));
+        double phi1 = sdf->sample(pt + Vector3D(0.5 * h.x, 0.0, 0.0));
         double frac = fractionInsideSdf(phi0, phi1);
         frac = 1.0 - clamp(frac, 0.0, 1.0);
 
@@ -70,8 +77,8 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
 
     velocity->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
         Vector3D pt = vPos(i, j, k);
-        double phi0 = _colliderSdf->sample(pt - Vector3D(0.0, 0.5 * h.y, 0.0));
-        double phi1 = _colliderSdf->sample(pt + Vector3D(0.0, 0.5 * h.y, 0.0));
+        double phi0 = sdf->sample(pt - Vector3D(0.0, 0.5 * h.y, 0.0));
+        double phi1 = sdf->sample(pt + Vector3D(0.0, 0.5 * h.y, 0.0));
         double frac = fractionInsideSdf(phi0, phi1);
         frac = 1.0 - clamp(frac, 0.0, 1.0);
 
@@ -86,8 +93,8 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
 
     velocity->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
         Vector3D pt = wPos(i, j, k);
-        double phi0 = _colliderSdf->sample(pt - Vector3D(0.0, 0.0, 0.5 * h.z));
-        double phi1 = _colliderSdf->sample(pt + Vector3D(0.0, 0.0, 0.5 * h.z));
+        double phi0 = sdf->sample(pt - Vector3D(0.0, 0.0, 0.5 * h.z));
+        double phi1 = sdf->sample(pt + Vector3D(0.0, 0.0, 0.5 * h.z));
         double frac = fractionInsideSdf(phi0, phi1);
         frac = 1.0 - clamp(frac, 0.0, 1.0);
 
@@ -102,20 +109,18 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
 
     // Free-slip: Extrapolate fluid velocity into the collider
     extrapolateToRegion(
-        velocity->uConstAccessor(), uMarker, extrapolationDepth, u);
-    extrapolateToRegion(
-        velocity->vConstAccessor(), vMarker, extrapolationDepth, v);
-    extrapolateToRegion(
-        velocity->wConstAccessor(), wMarker, extrapolationDepth, w);
+        velocity->uConstAccessor(), velocity->vConstAccessor(),
+        velocity->wConstAccessor(), uMarker, vMarker, wMarker,
+        extrapolationDepth, u, v, w);
 
     // No-flux: project the extrapolated velocity to the collider's surface
     // normal
     velocity->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
         Vector3D pt = uPos(i, j, k);
-        if (isInsideSdf(_colliderSdf->sample(pt))) {
+        if (isInsideSdf(sdf->sample(pt))) {
             Vector3D colliderVel = collider()->velocityAt(pt);
             Vector3D vel = velocity->sample(pt);
-            Vector3D g = _colliderSdf->gradient(pt);
+            Vector3D g = sdf->gradient(pt);
             if (g.lengthSquared() > 0.0) {
                 Vector3D n = g.normalized();
                 Vector3D velr = vel - colliderVel;
@@ -134,10 +139,10 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
 
     velocity->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
         Vector3D pt = vPos(i, j, k);
-        if (isInsideSdf(_colliderSdf->sample(pt))) {
+        if (isInsideSdf(sdf->sample(pt))) {
             Vector3D colliderVel = collider()->velocityAt(pt);
             Vector3D vel = velocity->sample(pt);
-            Vector3D g = _colliderSdf->gradient(pt);
+            Vector3D g = sdf->gradient(pt);
             if (g.lengthSquared() > 0.0) {
                 Vector3D n = g.normalized();
                 Vector3D velr = vel - colliderVel;
@@ -156,10 +161,10 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
 
     velocity->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
         Vector3D pt = wPos(i, j, k);
-        if (isInsideSdf(_colliderSdf->sample(pt))) {
+        if (isInsideSdf(sdf->sample(pt))) {
             Vector3D colliderVel = collider()->velocityAt(pt);
             Vector3D vel = velocity->sample(pt);
-            Vector3D g = _colliderSdf->gradient(pt);
+            Vector3D g = sdf->gradient(pt);
             if (g.lengthSquared() > 0.0) {
                 Vector3D n = g.normalized();
                 Vector3D velr = vel - colliderVel;
@@ -233,7 +238,11 @@ void GridFractionalBoundaryConditionSolver3::constrainVelocity(
 }
 
 ScalarField3Ptr GridFractionalBoundaryConditionSolver3::colliderSdf() const {
-    return _colliderSdf;
+    if (_colliderSdf != nullptr) {
+        return _colliderSdf;
+    } else {
+        return _emptyColliderSdf;
+    }
 }
 
 VectorField3Ptr
@@ -245,12 +254,15 @@ void GridFractionalBoundaryConditionSolver3::onColliderUpdated(
     const Size3& gridSize,
     const Vector3D& gridSpacing,
     const Vector3D& gridOrigin) {
-    if (_colliderSdf == nullptr) {
-        _colliderSdf = std::make_shared<CellCenteredScalarGrid3>();
-    }
-    _colliderSdf->resize(gridSize, gridSpacing, gridOrigin);
-
     if (collider() != nullptr) {
+        // The distance to a collider differs from the background almost
+        // everywhere, so a sparse grid would activate every tile.
+        _emptyColliderSdf.reset();
+        if (_colliderSdf == nullptr) {
+            _colliderSdf = std::make_shared<CellCenteredScalarGrid3>();
+        }
+        _colliderSdf->resize(gridSize, gridSpacing, gridOrigin);
+
         Surface3Ptr surface = collider()->surface();
         ImplicitSurface3Ptr implicitSurface
             = std::dynamic_pointer_cast<ImplicitSurface3>(surface);
@@ -269,7 +281,13 @@ void GridFractionalBoundaryConditionSolver3::onColliderUpdated(
         .withDerivativeResolution(gridSpacing.x)
         .makeShared();
     } else {
-        _colliderSdf->fill(kMaxD);
+        // Without a collider, the distance field is the background only.
+        _colliderSdf.reset();
+        if (_emptyColliderSdf == nullptr) {
+            _emptyColliderSdf =
+                std::make_shared<SparseCellCenteredScalarGrid3>();
+        }
+        _emptyColliderSdf->resize(gridSize, gridSpacing, gridOrigin, kMaxD);
 
         _colliderVel = CustomVectorField3::builder()
             .withFunction([] (const Vector3D&) {
@@ -26,7 +26,9 @@ const double kMinWeight = 0.01;
 
 namespace {
 
-void restrict(const Array2<float>& finer, Array2<float>* coarser) {
+void restrict(const Array2<float>& finer,
+              const std::array<bool, 2>& isStaggered,
+              Array2<float>* coarser) {
     // --*--|--*--|--*--|--*--
     //  1/8   3/8   3/8   1/8
     //           to
@@ -41,13 +43,14 @@ void restrict(const Array2<float>& finer, Array2<float>* coarser) {
     static const std::array<float, 4> staggeredKernel = {{0.f, 1.f, 0.f, 0.f}};
 
     std::array<int, 2> kernelSize;
-    kernelSize[0] = finer.size().x != 2 * coarser->size().x ? 3 : 4;
-    kernelSize[1] = finer.size().y != 2 * coarser->size().y ? 3 : 4;
+    kernelSize[0] = isStaggered[0] ? 3 : 4;
+    kernelSize[1] = isStaggered[1] ? 3 : 4;
 
     std::array<std::array<float, 4>, 2> kernels;
     kernels[0] = (kernelSize[0] == 3) ? staggeredKernel : centeredKernel;
     kernels[1] = (kernelSize[1] == 3) ? staggeredKernel : centeredKernel;
 
+    const Size2 m = finer.size();
     const Size2 n = coarser->size();
     parallelRangeFor(
         kZeroSize, n.x, kZeroSize, n.y,
@@ -57,26 +60,26 @@ void restrict(const Array2<float>& finer, Array2<float>* coarser) {
             for (size_t j = jBegin; j < jEnd; ++j) {
                 if (kernelSize[1] == 3) {
                     jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
-                    jIndices[1] = 2 * j;
-                    jIndices[2] = (j + 1 < n.y) ? 2 * j + 1 : 2 * j;
+                    jIndices[1] = std::min(2 * j, m.y - 1);
+                    jIndices[2] = (j + 1 < n.y) ? 2 * j + 1 : jIndices[1];
                 } else {
                     jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
                     jIndices[1] = 2 * j;
-                    jIndices[2] = 2 * j + 1;
-                    jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
+                    jIndices[2] = std::min(2 * j + 1, m.y - 1);
+                    jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : jIndices[2];
                 }
 
                 std::array<size_t, 4> iIndices{{0, 0, 0, 0}};
                 for (size_t i = iBegin; i < iEnd; ++i) {
                     if (kernelSize[0] == 3) {
                         iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
-                        iIndices[1] = 2 * i;
-                        iIndices[2] = (i + 1 < n.x) ? 2 * i + 1 : 2 * i;
+                        iIndices[1] = std::min(2 * i, m.x - 1);
+                        iIndices[2] = (i + 1 < n.x) ? 2 * i + 1 : iIndices[1];
                     } else {
                         iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
                         iIndices[1] = 2 * i;
-                        iIndices[2] = 2 * i + 1;
-                        iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
+                        iIndices[2] = std::min(2 * i + 1, m.x - 1);
+                        iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : iIndices[2];
                     }
 
                     float sum = 0.0f;
@@ -92,8 +95,8 @@ void restrict(const Array2<float>& finer, Array2<float>* coarser) {
         });
 }
 
-void buildSingleSystem(FdmMatrix2* A, FdmVector2* b,
-                       const Array2<float>& fluidSdf,
+template <typename Matrix, typename Vector>
+void buildSingleSystem(Matrix* A, Vector* b, const Array2<float>& fluidSdf,
                        const Array2<float>& uWeights,
                        const Array2<float>& vWeights,
                        std::function<Vector2D(const Vector2D&)> boundaryVel,
@@ -197,7 +200,7 @@ void buildSingleSystem(FdmMatrix2* A, FdmVector2* b,
                 (*b)(i, j) = 0.0;
             }
         } else {
-            row.center = 1.0;
+            row.center = 2.0 * (invHSqr.x + invHSqr.y);
         }
     });
 }
@@ -354,24 +357,57 @@ void GridFractionalSinglePhasePressureSolver2::solve(
     bool useCompressed) {
     UNUSED_VARIABLE(timeIntervalInSeconds);
 
+    const bool isWarmStart =
+        _isWarmStarting && _systemSolver != nullptr &&
+        pressure().size() == input.resolution();
+
     buildWeights(input, boundarySdf, boundaryVelocity, fluidSdf);
     buildSystem(input, useCompressed);
 
     if (_systemSolver != nullptr) {
+        const bool wasUsingInitialGuess = _systemSolver->isUsingInitialGuess();
+        _systemSolver->setIsUsingInitialGuess(isWarmStart);
+
         // Solve the system
         if (_mgSystemSolver == nullptr) {
             if (useCompressed) {
+                if (isWarmStart) {
+                    compressSolution();
+                }
                 _system.clear();
+                _systemF.clear();
                 _systemSolver->solveCompressed(&_compSystem);
                 decompressSolution();
             } else {
                 _compSystem.clear();
-                _systemSolver->solve(&_system);
+                if (isSolvingInSinglePrecision(useCompressed)) {
+                    solveSinglePrecision(isWarmStart);
+                } else {
+                    _systemSolver->solve(&_system);
+                }
             }
+        } else if (isSolvingInSinglePrecision(useCompressed)) {
+            solveSinglePrecision(isWarmStart);
         } else {
             _mgSystemSolver->solve(&_mgSystem);
         }
 
+        _systemSolver->setIsUsingInitialGuess(wasUsingInitialGuess);
+
+        // Record the iterations saved by the warm start
+        _lastNumberOfIterations = _systemSolver->lastNumberOfIterations();
+        if (isWarmStart) {
+            _lastNumberOfSavedIterations =
+                static_cast<int>(_coldStartNumberOfIterations) -
+                static_cast<int>(_lastNumberOfIterations);
+            JET_INFO << "Warm-started pressure solve took "
+                     << _lastNumberOfIterations << " iterations, saved "
+                     << _lastNumberOfSavedIterations << " iterations";
+        } else {
+            _coldStartNumberOfIterations = _lastNumberOfIterations;
+            _lastNumberOfSavedIterations = 0;
+        }
+
         // Apply pressure gradient
         applyPressureGradient(input, output);
     }
@@ -392,19 +428,50 @@ void GridFractionalSinglePhasePressureSolver2::setLinearSystemSolver(
     const FdmLinearSystemSolver2Ptr& solver) {
     _systemSolver = solver;
     _mgSystemSolver = std::dynamic_pointer_cast<FdmMgSolver2>(_systemSolver);
+    _cgSystemSolver = std::dynamic_pointer_cast<FdmCgSolver2>(_systemSolver);
 
     if (_mgSystemSolver == nullptr) {
         // In case of non-mg system, use flat structure.
         _mgSystem.clear();
+        _mgSystemF.clear();
     } else {
         // In case of mg system, use multi-level structure.
         _system.clear();
+        _systemF.clear();
         _compSystem.clear();
     }
 }
 
+bool GridFractionalSinglePhasePressureSolver2::isUsingSinglePrecision() const {
+    return _isUsingSinglePrecision;
+}
+
+void GridFractionalSinglePhasePressureSolver2::setIsUsingSinglePrecision(
+    bool isUsing) {
+    _isUsingSinglePrecision = isUsing;
+}
+
+bool GridFractionalSinglePhasePressureSolver2::isWarmStarting() const {
+    return _isWarmStarting;
+}
+
+void GridFractionalSinglePhasePressureSolver2::setIsWarmStarting(
+    bool isWarmStarting) {
+    _isWarmStarting = isWarmStarting;
+}
+
+unsigned int GridFractionalSinglePhasePressureSolver2::lastNumberOfIterations()
+    const {
+    return _lastNumberOfIterations;
+}
+
+int GridFractionalSinglePhasePressureSolver2::lastNumberOfSavedIterations()
+    const {
+    return _lastNumberOfSavedIterations;
+}
+
 const FdmVector2& GridFractionalSinglePhasePressureSolver2::pressure() const {
-    if (_mgSystemSolver == nullptr) {
+    if (_mgSystemSolver == nullptr || _mgSystem.x.levels.empty()) {
         return _system.x;
     } else {
         return _mgSystem.x.levels.front();
@@ -482,10 +549,55 @@ void GridFractionalSinglePhasePressureSolver2::buildWeights(
         auto& coarserVWeight = _vWeights[l];
 
         // Fluid SDF
-        restrict(finerFluidSdf, &coarserFluidSdf);
-        restrict(finerUWeight, &coarserUWeight);
-        restrict(finerVWeight, &coarserVWeight);
+        restrict(finerFluidSdf, {{false, false}}, &coarserFluidSdf);
+        restrict(finerUWeight, {{true, false}}, &coarserUWeight);
+        restrict(finerVWeight, {{false, true}}, &coarserVWeight);
+    }
+}
+
+bool GridFractionalSinglePhasePressureSolver2::isSolvingInSinglePrecision(
+    bool useCompressed) const {
+    return _isUsingSinglePrecision &&
+           (_mgSystemSolver != nullptr ||
+            (_cgSystemSolver != nullptr && !useCompressed));
+}
+
+void GridFractionalSinglePhasePressureSolver2::solveSinglePrecision(
+    bool isWarmStart) {
+    if (_mgSystemSolver != nullptr) {
+        // As in the double solve, the cycle starts from the last solution
+        // kept in the float system.
+        _mgSystemSolver->solve(&_mgSystemF);
+
+        const auto& xF = _mgSystemF.x.levels.front();
+        auto& x = _mgSystem.x.levels.front();
+        x.parallelForEachIndex([&](size_t i, size_t j) { x(i, j) = xF(i, j); });
+        return;
+    }
+
+    if (isWarmStart) {
+        _systemF.x.parallelForEachIndex([&](size_t i, size_t j) {
+            _systemF.x(i, j) = static_cast<float>(_system.x(i, j));
+        });
     }
+
+    _cgSystemSolver->solve(&_systemF);
+
+    _system.x.parallelForEachIndex([&](size_t i, size_t j) {
+        _system.x(i, j) = _systemF.x(i, j);
+    });
+}
+
+void GridFractionalSinglePhasePressureSolver2::compressSolution() {
+    const auto acc = _fluidSdf[0].constAccessor();
+
+    size_t row = 0;
+    _fluidSdf[0].forEachIndex([&](size_t i, size_t j) {
+        if (isInsideSdf(acc(i, j))) {
+            _compSystem.x[row] = _system.x(i, j);
+            ++row;
+        }
+    });
 }
 
 void GridFractionalSinglePhasePressureSolver2::decompressSolution() {
@@ -507,20 +619,39 @@ void GridFractionalSinglePhasePressureSolver2::buildSystem(
     size_t numLevels = 1;
 
     if (_mgSystemSolver == nullptr) {
-        if (!useCompressed) {
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            // Only the pressure is kept in double
+            _system.A.clear();
+            _system.b.clear();
+            _system.x.resize(size);
+            _systemF.resize(size);
+        } else if (!useCompressed) {
             _system.resize(size);
+            _systemF.clear();
         }
     } else {
         // Build levels
         size_t maxLevels = _mgSystemSolver->params().maxNumberOfLevels;
-        FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.A.levels);
-        FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.x.levels);
-        FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.b.levels);
-
-        numLevels = _mgSystem.A.levels.size();
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            // Only the finest pressure is kept in double
+            _mgSystemF.resizeWithFinest(size, maxLevels);
+            _mgSystem.A.levels.clear();
+            _mgSystem.b.levels.clear();
+            _mgSystem.x.levels.resize(1);
+            _mgSystem.x.levels.front().resize(size);
+
+            numLevels = _mgSystemF.A.levels.size();
+        } else {
+            FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.A.levels);
+            FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.x.levels);
+            FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.b.levels);
+            _mgSystemF.clear();
+
+            numLevels = _mgSystem.A.levels.size();
+        }
     }
 
     // Build top level
@@ -530,33 +661,47 @@ void GridFractionalSinglePhasePressureSolver2::buildSystem(
             buildSingleSystem(&_compSystem.A, &_compSystem.x, &_compSystem.b,
                               _fluidSdf[0], _uWeights[0], _vWeights[0],
                               _boundaryVel, *finer);
+        } else if (isSolvingInSinglePrecision(useCompressed)) {
+            buildSingleSystem(&_systemF.A, &_systemF.b, _fluidSdf[0],
+                              _uWeights[0], _vWeights[0], _boundaryVel,
+                              *finer);
         } else {
             buildSingleSystem(&_system.A, &_system.b, _fluidSdf[0],
                               _uWeights[0], _vWeights[0], _boundaryVel, *finer);
         }
+    } else if (isSolvingInSinglePrecision(useCompressed)) {
+        buildSingleSystem(&_mgSystemF.A.levels.front(),
+                          &_mgSystemF.b.levels.front(), _fluidSdf[0],
+                          _uWeights[0], _vWeights[0], _boundaryVel, *finer);
     } else {
         buildSingleSystem(&_mgSystem.A.levels.front(),
                           &_mgSystem.b.levels.front(), _fluidSdf[0],
                           _uWeights[0], _vWeights[0], _boundaryVel, *finer);
     }
 
-    // Build sub-levels
+    // Build sub-levels. The multigrid cycle overwrites the coarser RHS with
+    // the restricted residual, so the velocity is not down-sampled and only
+    // the geometry of the coarser grid is used.
     FaceCenteredGrid2 coarser;
     for (size_t l = 1; l < numLevels; ++l) {
         auto res = finer->resolution();
         auto h = finer->gridSpacing();
         auto o = finer->origin();
-        res.x = res.x >> 1;
-        res.y = res.y >> 1;
+        res.x = (res.x + 1) >> 1;
+        res.y = (res.y + 1) >> 1;
         h *= 2.0;
 
-        // Down sample
         coarser.resize(res, h, o);
-        coarser.fill(finer->sampler());
 
-        buildSingleSystem(&_mgSystem.A.levels[l], &_mgSystem.b.levels[l],
-                          _fluidSdf[l], _uWeights[l], _vWeights[l],
-                          _boundaryVel, coarser);
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            buildSingleSystem(&_mgSystemF.A.levels[l], &_mgSystemF.b.levels[l],
+                              _fluidSdf[l], _uWeights[l], _vWeights[l],
+                              _boundaryVel, coarser);
+        } else {
+            buildSingleSystem(&_mgSystem.A.levels[l], &_mgSystem.b.levels[l],
+                              _fluidSdf[l], _uWeights[l], _vWeights[l],
+                              _boundaryVel, coarser);
+        }
 
         finer = &coarser;
     }
@@ -26,7 +26,9 @@ const double kMinWeight = 0.01;
 
 namespace {
 
-void restrict(const Array3<float>& finer, Array3<float>* coarser) {
+void restrict(const Array3<float>& finer,
+              const std::array<bool, 3>& isStaggered,
+              Array3<float>* coarser) {
     // --*--|--*--|--*--|--*--
     //  1/8   3/8   3/8   1/8
     //           to
@@ -41,15 +43,16 @@ void restrict(const Array3<float>& finer, Array3<float>* coarser) {
     static const std::array<float, 4> staggeredKernel = {{0.f, 1.f, 0.f, 0.f}};
 
     std::array<int, 3> kernelSize;
-    kernelSize[0] = finer.size().x != 2 * coarser->size().x ? 3 : 4;
-    kernelSize[1] = finer.size().y != 2 * coarser->size().y ? 3 : 4;
-    kernelSize[2] = finer.size().z != 2 * coarser->size().z ? 3 : 4;
+    kernelSize[0] = isStaggered[0] ? 3 : 4;
+    kernelSize[1] = isStaggered[1] ? 3 : 4;
+    kernelSize[2] = isStaggered[2] ? 3 : 4;
 
     std::array<std::array<float, 4>, 3> kernels;
     kernels[0] = (kernelSize[0] == 3) ? staggeredKernel : centeredKernel;
     kernels[1] = (kernelSize[1] == 3) ? staggeredKernel : centeredKernel;
     kernels[2] = (kernelSize[2] == 3) ? staggeredKernel : centeredKernel;
 
+    const Size3 m = finer.size();
     const Size3 n = coarser->size();
     parallelRangeFor(
         kZeroSize, n.x, kZeroSize, n.y, kZeroSize, n.z,
@@ -60,13 +63,13 @@ void restrict(const Array3<float>& finer, Array3<float>* coarser) {
             for (size_t k = kBegin; k < kEnd; ++k) {
                 if (kernelSize[2] == 3) {
                     kIndices[0] = (k > 0) ? 2 * k - 1 : 2 * k;
-                    kIndices[1] = 2 * k;
-                    kIndices[2] = (k + 1 < n.z) ? 2 * k + 1 : 2 * k;
+                    kIndices[1] = std::min(2 * k, m.z - 1);
+                    kIndices[2] = (k + 1 < n.z) ? 2 * k + 1 : kIndices[1];
                 } else {
                     kIndices[0] = (k > 0) ? 2 * k - 1 : 2 * k;
                     kIndices[1] = 2 * k;
-                    kIndices[2] = 2 * k + 1;
-                    kIndices[3] = (k + 1 < n.z) ? 2 * k + 2 : 2 * k + 1;
+                    kIndices[2] = std::min(2 * k + 1, m.z - 1);
+                    kIndices[3] = (k + 1 < n.z) ? 2 * k + 2 : kIndices[2];
                 }
 
                 std::array<size_t, 4> jIndices;
@@ -74,26 +77,28 @@ void restrict(const Array3<float>& finer, Array3<float>* coarser) {
                 for (size_t j = jBegin; j < jEnd; ++j) {
                     if (kernelSize[1] == 3) {
                         jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
-                        jIndices[1] = 2 * j;
-                        jIndices[2] = (j + 1 < n.y) ? 2 * j + 1 : 2 * j;
+                        jIndices[1] = std::min(2 * j, m.y - 1);
+                        jIndices[2] = (j + 1 < n.y) ? 2 * j + 1 : jIndices[1];
                     } else {
                         jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
                         jIndices[1] = 2 * j;
-                        jIndices[2] = 2 * j + 1;
-                        jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
+                        jIndices[2] = std::min(2 * j + 1, m.y - 1);
+                        jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : jIndices[2];
                     }
 
                     std::array<size_t, 4> iIndices;
                     for (size_t i = iBegin; i < iEnd; ++i) {
                         if (kernelSize[0] == 3) {
                             iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
-                            iIndices[1] = 2 * i;
-                            iIndices[2] = (i + 1 < n.x) ? 2 * i + 1 : 2 * i;
+                            iIndices[1] = std::min(2 * i, m.x - 1);
+                            iIndices[2] =
+                                (i + 1 < n.x) ? 2 * i + 1 : iIndices[1];
                         } else {
                             iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
                             iIndices[1] = 2 * i;
-                            iIndices[2] = 2 * i + 1;
-                            iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
+                            iIndices[2] = std::min(2 * i + 1, m.x - 1);
+                            iIndices[3] =
+                                (i + 1 < n.x) ? 2 * i + 2 : iIndices[2];
                         }
 
                         float sum = 0.0f;
@@ -114,13 +119,13 @@ void restrict(const Array3<float>& finer, Array3<float>* coarser) {
         });
 }
 
-void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
-                       const Array3<float>& fluidSdf,
-                       const Array3<float>& uWeights,
-                       const Array3<float>& vWeights,
-                       const Array3<float>& wWeights,
-                       std::function<Vector3D(const Vector3D&)> boundaryVel,
-                       const FaceCenteredGrid3& input) {
+// Computes the row and the RHS of every grid point, and invokes
+// func(i, j, k, row, rhs) in parallel.
+template <typename Callback>
+void forEachRow(const Array3<float>& fluidSdf, const Array3<float>& uWeights,
+                const Array3<float>& vWeights, const Array3<float>& wWeights,
+                const std::function<Vector3D(const Vector3D&)>& boundaryVel,
+                const FaceCenteredGrid3& input, const Callback& func) {
     const Size3 size = input.resolution();
     const auto uPos = input.uPosition();
     const auto vPos = input.vPosition();
@@ -129,13 +134,9 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
     const Vector3D invH = 1.0 / input.gridSpacing();
     const Vector3D invHSqr = invH * invH;
 
-    // Build linear system
-    A->parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        auto& row = (*A)(i, j, k);
-
-        // initialize
-        row.center = row.right = row.up = row.front = 0.0;
-        (*b)(i, j, k) = 0.0;
+    fluidSdf.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        FdmMatrixRow3 row;
+        double bijk = 0.0;
 
         double centerPhi = fluidSdf(i, j, k);
 
@@ -153,10 +154,9 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) +=
-                    uWeights(i + 1, j, k) * input.u(i + 1, j, k) * invH.x;
+                bijk += uWeights(i + 1, j, k) * input.u(i + 1, j, k) * invH.x;
             } else {
-                (*b)(i, j, k) += input.u(i + 1, j, k) * invH.x;
+                bijk += input.u(i + 1, j, k) * invH.x;
             }
 
             if (i > 0) {
@@ -169,9 +169,9 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) -= uWeights(i, j, k) * input.u(i, j, k) * invH.x;
+                bijk -= uWeights(i, j, k) * input.u(i, j, k) * invH.x;
             } else {
-                (*b)(i, j, k) -= input.u(i, j, k) * invH.x;
+                bijk -= input.u(i, j, k) * invH.x;
             }
 
             if (j + 1 < size.y) {
@@ -185,10 +185,9 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) +=
-                    vWeights(i, j + 1, k) * input.v(i, j + 1, k) * invH.y;
+                bijk += vWeights(i, j + 1, k) * input.v(i, j + 1, k) * invH.y;
             } else {
-                (*b)(i, j, k) += input.v(i, j + 1, k) * invH.y;
+                bijk += input.v(i, j + 1, k) * invH.y;
             }
 
             if (j > 0) {
@@ -201,9 +200,9 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) -= vWeights(i, j, k) * input.v(i, j, k) * invH.y;
+                bijk -= vWeights(i, j, k) * input.v(i, j, k) * invH.y;
             } else {
-                (*b)(i, j, k) -= input.v(i, j, k) * invH.y;
+                bijk -= input.v(i, j, k) * invH.y;
             }
 
             if (k + 1 < size.z) {
@@ -217,10 +216,9 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) +=
-                    wWeights(i, j, k + 1) * input.w(i, j, k + 1) * invH.z;
+                bijk += wWeights(i, j, k + 1) * input.w(i, j, k + 1) * invH.z;
             } else {
-                (*b)(i, j, k) += input.w(i, j, k + 1) * invH.z;
+                bijk += input.w(i, j, k + 1) * invH.z;
             }
 
             if (k > 0) {
@@ -233,9 +231,9 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     theta = std::max(theta, 0.01);
                     row.center += term / theta;
                 }
-                (*b)(i, j, k) -= wWeights(i, j, k) * input.w(i, j, k) * invH.z;
+                bijk -= wWeights(i, j, k) * input.w(i, j, k) * invH.z;
             } else {
-                (*b)(i, j, k) -= input.w(i, j, k) * invH.z;
+                bijk -= input.w(i, j, k) * invH.z;
             }
 
             // Accumulate contributions from the moving boundary
@@ -252,20 +250,74 @@ void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
                     boundaryVel(wPos(i, j, k + 1)).z * invH.z -
                 (1.0 - wWeights(i, j, k)) * boundaryVel(wPos(i, j, k)).z *
                     invH.z;
-            (*b)(i, j, k) += boundaryContribution;
+            bijk += boundaryContribution;
 
             // If row.center is near-zero, the cell is likely inside a solid
             // boundary.
             if (row.center < kEpsilonD) {
                 row.center = 1.0;
-                (*b)(i, j, k) = 0.0;
+                bijk = 0.0;
             }
         } else {
-            row.center = 1.0;
+            row.center = 2.0 * (invHSqr.x + invHSqr.y + invHSqr.z);
         }
+
+        func(i, j, k, row, bijk);
     });
 }
 
+// Stores the row in the precision of the matrix.
+void setRow(const FdmMatrixRow3& row, FdmMatrixRow3* result) {
+    *result = row;
+}
+
+void setRow(const FdmMatrixRow3& row, FdmMatrixRow3F* result) {
+    result->center = static_cast<float>(row.center);
+    result->right = static_cast<float>(row.right);
+    result->up = static_cast<float>(row.up);
+    result->front = static_cast<float>(row.front);
+}
+
+template <typename Matrix, typename Vector>
+void buildSingleSystem(Matrix* A, Vector* b, const Array3<float>& fluidSdf,
+                       const Array3<float>& uWeights,
+                       const Array3<float>& vWeights,
+                       const Array3<float>& wWeights,
+                       std::function<Vector3D(const Vector3D&)> boundaryVel,
+                       const FaceCenteredGrid3& input) {
+    forEachRow(fluidSdf, uWeights, vWeights, wWeights, boundaryVel, input,
+               [&](size_t i, size_t j, size_t k, const FdmMatrixRow3& row,
+                   double rhs) {
+                   setRow(row, &(*A)(i, j, k));
+                   (*b)(i, j, k) = rhs;
+               });
+}
+
+void buildSingleSystem(FdmStencilLinearSystem3* system,
+                       const Array3<float>& fluidSdf,
+                       const Array3<float>& uWeights,
+                       const Array3<float>& vWeights,
+                       const Array3<float>& wWeights,
+                       std::function<Vector3D(const Vector3D&)> boundaryVel,
+                       const FaceCenteredGrid3& input) {
+    system->resize(fluidSdf.size(), [&](size_t i, size_t j, size_t k) {
+        return isInsideSdf(fluidSdf(i, j, k));
+    });
+
+    FdmStencilMatrix3& A = system->A;
+    forEachRow(fluidSdf, uWeights, vWeights, wWeights, boundaryVel, input,
+               [&](size_t i, size_t j, size_t k, const FdmMatrixRow3& row,
+                   double rhs) {
+                   const uint32_t r = A.rowIndices(i, j, k);
+                   if (r == FdmStencilMatrix3::kInvalidRow) {
+                       return;
+                   }
+
+                   setRow(row, &A.rows[r]);
+                   system->b[r] = rhs;
+               });
+}
+
 void buildSingleSystem(MatrixCsrD* A, VectorND* x, VectorND* b,
                        const Array3<float>& fluidSdf,
                        const Array3<float>& uWeights,
@@ -460,24 +512,62 @@ void GridFractionalSinglePhasePressureSolver3::solve(
     bool useCompressed) {
     UNUSED_VARIABLE(timeIntervalInSeconds);
 
+    const bool isWarmStart =
+        _isWarmStarting && _systemSolver != nullptr &&
+        pressure().size() == input.resolution();
+
     buildWeights(input, boundarySdf, boundaryVelocity, fluidSdf);
     buildSystem(input, useCompressed);
 
     if (_systemSolver != nullptr) {
+        const bool wasUsingInitialGuess = _systemSolver->isUsingInitialGuess();
+        _systemSolver->setIsUsingInitialGuess(isWarmStart);
+
         // Solve the system
         if (_mgSystemSolver == nullptr) {
             if (useCompressed) {
+                if (isWarmStart) {
+                    compressSolution();
+                }
                 _system.clear();
-                _systemSolver->solveCompressed(&_compSystem);
+                _systemF.clear();
+                if (_isUsingStencilSystem) {
+                    _systemSolver->solveStencil(&_stencilSystem);
+                } else {
+                    _systemSolver->solveCompressed(&_compSystem);
+                }
                 decompressSolution();
             } else {
                 _compSystem.clear();
-                _systemSolver->solve(&_system);
+                _stencilSystem.clear();
+                if (isSolvingInSinglePrecision(useCompressed)) {
+                    solveSinglePrecision(isWarmStart);
+                } else {
+                    _systemSolver->solve(&_system);
+                }
             }
+        } else if (isSolvingInSinglePrecision(useCompressed)) {
+            solveSinglePrecision(isWarmStart);
         } else {
             _mgSystemSolver->solve(&_mgSystem);
         }
 
+        _systemSolver->setIsUsingInitialGuess(wasUsingInitialGuess);
+
+        // Record the iterations saved by the warm start
+        _lastNumberOfIterations = _systemSolver->lastNumberOfIterations();
+        if (isWarmStart) {
+            _lastNumberOfSavedIterations =
+                static_cast<int>(_coldStartNumberOfIterations) -
+                static_cast<int>(_lastNumberOfIterations);
+            JET_INFO << "Warm-started pressure solve took "
+                     << _lastNumberOfIterations << " iterations, saved "
+                     << _lastNumberOfSavedIterations << " iterations";
+        } else {
+            _coldStartNumberOfIterations = _lastNumberOfIterations;
+            _lastNumberOfSavedIterations = 0;
+        }
+
         // Apply pressure gradient
         applyPressureGradient(input, output);
     }
@@ -498,19 +588,60 @@ void GridFractionalSinglePhasePressureSolver3::setLinearSystemSolver(
     const FdmLinearSystemSolver3Ptr& solver) {
     _systemSolver = solver;
     _mgSystemSolver = std::dynamic_pointer_cast<FdmMgSolver3>(_systemSolver);
+    _cgSystemSolver = std::dynamic_pointer_cast<FdmCgSolver3>(_systemSolver);
 
     if (_mgSystemSolver == nullptr) {
         // In case of non-mg system, use flat structure.
         _mgSystem.clear();
+        _mgSystemF.clear();
     } else {
         // In case of mg system, use multi-level structure.
         _system.clear();
+        _systemF.clear();
         _compSystem.clear();
+        _stencilSystem.clear();
     }
 }
 
+bool GridFractionalSinglePhasePressureSolver3::isUsingStencilSystem() const {
+    return _isUsingStencilSystem;
+}
+
+void GridFractionalSinglePhasePressureSolver3::setIsUsingStencilSystem(
+    bool isUsing) {
+    _isUsingStencilSystem = isUsing;
+}
+
+bool GridFractionalSinglePhasePressureSolver3::isUsingSinglePrecision() const {
+    return _isUsingSinglePrecision;
+}
+
+void GridFractionalSinglePhasePressureSolver3::setIsUsingSinglePrecision(
+    bool isUsing) {
+    _isUsingSinglePrecision = isUsing;
+}
+
+bool GridFractionalSinglePhasePressureSolver3::isWarmStarting() const {
+    return _isWarmStarting;
+}
+
+void GridFractionalSinglePhasePressureSolver3::setIsWarmStarting(
+    bool isWarmStarting) {
+    _isWarmStarting = isWarmStarting;
+}
+
+unsigned int GridFractionalSinglePhasePressureSolver3::lastNumberOfIterations()
+    const {
+    return _lastNumberOfIterations;
+}
+
+int GridFractionalSinglePhasePressureSolver3::lastNumberOfSavedIterations()
+    const {
+    return _lastNumberOfSavedIterations;
+}
+
 const FdmVector3& GridFractionalSinglePhasePressureSolver3::pressure() const {
-    if (_mgSystemSolver == nullptr) {
+    if (_mgSystemSolver == nullptr || _mgSystem.x.levels.empty()) {
         return _system.x;
     } else {
         return _mgSystem.x.levels.front();
@@ -628,17 +759,85 @@ void GridFractionalSinglePhasePressureSolver3::buildWeights(
         auto& coarserWWeight = _wWeights[l];
 
         // Fluid SDF
-        restrict(finerFluidSdf, &coarserFluidSdf);
-        restrict(finerUWeight, &coarserUWeight);
-        restrict(finerVWeight, &coarserVWeight);
-        restrict(finerWWeight, &coarserWWeight);
+        restrict(finerFluidSdf, {{false, false, false}}, &coarserFluidSdf);
+        restrict(finerUWeight, {{true, false, false}}, &coarserUWeight);
+        restrict(finerVWeight, {{false, true, false}}, &coarserVWeight);
+        restrict(finerWWeight, {{false, false, true}}, &coarserWWeight);
+    }
+}
+
+bool GridFractionalSinglePhasePressureSolver3::isSolvingInSinglePrecision(
+    bool useCompressed) const {
+    return _isUsingSinglePrecision &&
+           (_mgSystemSolver != nullptr ||
+            (_cgSystemSolver != nullptr && !useCompressed));
+}
+
+void GridFractionalSinglePhasePressureSolver3::solveSinglePrecision(
+    bool isWarmStart) {
+    if (_mgSystemSolver != nullptr) {
+        // As in the double solve, the cycle starts from the last solution
+        // kept in the float system.
+        _mgSystemSolver->solve(&_mgSystemF);
+
+        const auto& xF = _mgSystemF.x.levels.front();
+        auto& x = _mgSystem.x.levels.front();
+        x.parallelForEachIndex(
+            [&](size_t i, size_t j, size_t k) { x(i, j, k) = xF(i, j, k); });
+        return;
+    }
+
+    if (isWarmStart) {
+        _systemF.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            _systemF.x(i, j, k) = static_cast<float>(_system.x(i, j, k));
+        });
+    }
+
+    _cgSystemSolver->solve(&_systemF);
+
+    _system.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        _system.x(i, j, k) = _systemF.x(i, j, k);
+    });
+}
+
+void GridFractionalSinglePhasePressureSolver3::compressSolution() {
+    const auto acc = _fluidSdf[0].constAccessor();
+
+    if (_isUsingStencilSystem) {
+        const auto& rowIndices = _stencilSystem.A.rowIndices;
+        rowIndices.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            const uint32_t row = rowIndices(i, j, k);
+            if (row != FdmStencilMatrix3::kInvalidRow) {
+                _stencilSystem.x[row] = _system.x(i, j, k);
+            }
+        });
+        return;
     }
+
+    size_t row = 0;
+    _fluidSdf[0].forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (isInsideSdf(acc(i, j, k))) {
+            _compSystem.x[row] = _system.x(i, j, k);
+            ++row;
+        }
+    });
 }
 
 void GridFractionalSinglePhasePressureSolver3::decompressSolution() {
     const auto acc = _fluidSdf[0].constAccessor();
     _system.x.resize(acc.size());
 
+    if (_isUsingStencilSystem) {
+        const auto& rowIndices = _stencilSystem.A.rowIndices;
+        _system.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            const uint32_t row = rowIndices(i, j, k);
+            _system.x(i, j, k) = (row == FdmStencilMatrix3::kInvalidRow)
+                                     ? 0.0
+                                     : _stencilSystem.x[row];
+        });
+        return;
+    }
+
     size_t row = 0;
     _fluidSdf[0].forEachIndex([&](size_t i, size_t j, size_t k) {
         if (isInsideSdf(acc(i, j, k))) {
@@ -654,34 +853,68 @@ void GridFractionalSinglePhasePressureSolver3::buildSystem(
     size_t numLevels = 1;
 
     if (_mgSystemSolver == nullptr) {
-        if (!useCompressed) {
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            // Only the pressure is kept in double
+            _system.A.clear();
+            _system.b.clear();
+            _system.x.resize(size);
+            _systemF.resize(size);
+        } else if (!useCompressed) {
             _system.resize(size);
+            _systemF.clear();
         }
     } else {
         // Build levels
         size_t maxLevels = _mgSystemSolver->params().maxNumberOfLevels;
-        FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.A.levels);
-        FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.x.levels);
-        FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.b.levels);
-
-        numLevels = _mgSystem.A.levels.size();
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            // Only the finest pressure is kept in double
+            _mgSystemF.resizeWithFinest(size, maxLevels);
+            _mgSystem.A.levels.clear();
+            _mgSystem.b.levels.clear();
+            _mgSystem.x.levels.resize(1);
+            _mgSystem.x.levels.front().resize(size);
+
+            numLevels = _mgSystemF.A.levels.size();
+        } else {
+            FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.A.levels);
+            FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.x.levels);
+            FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.b.levels);
+            _mgSystemF.clear();
+
+            numLevels = _mgSystem.A.levels.size();
+        }
     }
 
     // Build top level
     const FaceCenteredGrid3* finer = &input;
     if (_mgSystemSolver == nullptr) {
-        if (useCompressed) {
+        if (useCompressed && _isUsingStencilSystem) {
+            _compSystem.clear();
+            buildSingleSystem(&_stencilSystem, _fluidSdf[0], _uWeights[0],
+                              _vWeights[0], _wWeights[0], _boundaryVel,
+                              *finer);
+        } else if (useCompressed) {
+            _stencilSystem.clear();
             buildSingleSystem(&_compSystem.A, &_compSystem.x, &_compSystem.b,
                               _fluidSdf[0], _uWeights[0], _vWeights[0],
                               _wWeights[0], _boundaryVel, *finer);
+        } else if (isSolvingInSinglePrecision(useCompressed)) {
+            buildSingleSystem(&_systemF.A, &_systemF.b, _fluidSdf[0],
+                              _uWeights[0], _vWeights[0], _wWeights[0],
+                              _boundaryVel, *finer);
         } else {
             buildSingleSystem(&_system.A, &_system.b, _fluidSdf[0],
                               _uWeights[0], _vWeights[0], _wWeights[0],
                               _boundaryVel, *finer);
         }
+    } else if (isSolvingInSinglePrecision(useCompressed)) {
+        buildSingleSystem(&_mgSystemF.A.levels.front(),
+                          &_mgSystemF.b.levels.front(), _fluidSdf[0],
+                          _uWeights[0], _vWeights[0], _wWeights[0],
+                          _boundaryVel, *finer);
     } else {
         buildSingleSystem(&_mgSystem.A.levels.front(),
                           &_mgSystem.b.levels.front(), _fluidSdf[0],
@@ -689,24 +922,30 @@ void GridFractionalSinglePhasePressureSolver3::buildSystem(
                           _boundaryVel, *finer);
     }
 
-    // Build sub-levels
+    // Build sub-levels. The multigrid cycle overwrites the coarser RHS with
+    // the restricted residual, so the velocity is not down-sampled and only
+    // the geometry of the coarser grid is used.
     FaceCenteredGrid3 coarser;
     for (size_t l = 1; l < numLevels; ++l) {
         auto res = finer->resolution();
         auto h = finer->gridSpacing();
         auto o = finer->origin();
-        res.x = res.x >> 1;
-        res.y = res.y >> 1;
-        res.z = res.z >> 1;
+        res.x = (res.x + 1) >> 1;
+        res.y = (res.y + 1) >> 1;
+        res.z = (res.z + 1) >> 1;
         h *= 2.0;
 
-        // Down sample
         coarser.resize(res, h, o);
-        coarser.fill(finer->sampler());
 
-        buildSingleSystem(&_mgSystem.A.levels[l], &_mgSystem.b.levels[l],
-                          _fluidSdf[l], _uWeights[l], _vWeights[l],
-                          _wWeights[l], _boundaryVel, coarser);
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            buildSingleSystem(&_mgSystemF.A.levels[l], &_mgSystemF.b.levels[l],
+                              _fluidSdf[l], _uWeights[l], _vWeights[l],
+                              _wWeights[l], _boundaryVel, coarser);
+        } else {
+            buildSingleSystem(&_mgSystem.A.levels[l], &_mgSystem.b.levels[l],
+                              _fluidSdf[l], _uWeights[l], _vWeights[l],
+                              _wWeights[l], _boundaryVel, coarser);
+        }
 
         finer = &coarser;
     }
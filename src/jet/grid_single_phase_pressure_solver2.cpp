@@ -6,6 +6,8 @@
 
 #include <pch.h>
 
+#include "dirty_block_helpers.h"
+
 #include <jet/constants.h>
 #include <jet/fdm_iccg_solver2.h>
 #include <jet/grid_blocked_boundary_condition_solver2.h>
@@ -22,47 +24,62 @@ const double kDefaultTolerance = 1e-6;
 
 namespace {
 
-void buildSingleSystem(FdmMatrix2* A, FdmVector2* b,
-                       const Array2<char>& markers,
-                       const FaceCenteredGrid2& input) {
-    Size2 size = input.resolution();
-    Vector2D invH = 1.0 / input.gridSpacing();
+// Rebuilds the rows that read a marker of a dirty block.
+template <typename Matrix>
+void buildSingleMatrix(Matrix* A, const Array2<char>& markers,
+                       const Vector2D& gridSpacing,
+                       const Array2<char>& dirtyBlocks) {
+    Size2 size = markers.size();
+    Vector2D invH = 1.0 / gridSpacing;
     Vector2D invHSqr = invH * invH;
 
-    A->parallelForEachIndex([&](size_t i, size_t j) {
-        auto& row = (*A)(i, j);
-
-        // initialize
-        row.center = row.right = row.up = 0.0;
-        (*b)(i, j) = 0.0;
-
-        if (markers(i, j) == kFluid) {
-            (*b)(i, j) = input.divergenceAtCellCenter(i, j);
+    parallelForEachDirtyBlock(
+        dirtyBlocks, size, true,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
+            for (size_t j = jBegin; j < jEnd; ++j) {
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    auto& row = (*A)(i, j);
+
+                    // initialize
+                    row.center = row.right = row.up = 0.0;
+
+                    if (markers(i, j) == kFluid) {
+                        if (i + 1 < size.x && markers(i + 1, j) != kBoundary) {
+                            row.center += invHSqr.x;
+                            if (markers(i + 1, j) == kFluid) {
+                                row.right -= invHSqr.x;
+                            }
+                        }
 
-            if (i + 1 < size.x && markers(i + 1, j) != kBoundary) {
-                row.center += invHSqr.x;
-                if (markers(i + 1, j) == kFluid) {
-                    row.right -= invHSqr.x;
-                }
-            }
+                        if (i > 0 && markers(i - 1, j) != kBoundary) {
+                            row.center += invHSqr.x;
+                        }
 
-            if (i > 0 && markers(i - 1, j) != kBoundary) {
-                row.center += invHSqr.x;
-            }
+                        if (j + 1 < size.y && markers(i, j + 1) != kBoundary) {
+                            row.center += invHSqr.y;
+                            if (markers(i, j + 1) == kFluid) {
+                                row.up -= invHSqr.y;
+                            }
+                        }
 
-            if (j + 1 < size.y && markers(i, j + 1) != kBoundary) {
-                row.center += invHSqr.y;
-                if (markers(i, j + 1) == kFluid) {
-                    row.up -= invHSqr.y;
+                        if (j > 0 && markers(i, j - 1) != kBoundary) {
+                            row.center += invHSqr.y;
+                        }
+                    } else {
+                        row.center = 2.0 * (invHSqr.x + invHSqr.y);
+                    }
                 }
             }
+        });
+}
 
-            if (j > 0 && markers(i, j - 1) != kBoundary) {
-                row.center += invHSqr.y;
-            }
-        } else {
-            row.center = 1.0;
-        }
+template <typename Vector>
+void buildSingleRhs(Vector* b, const Array2<char>& markers,
+                    const FaceCenteredGrid2& input) {
+    b->parallelForEachIndex([&](size_t i, size_t j) {
+        (*b)(i, j) = (markers(i, j) == kFluid)
+                         ? input.divergenceAtCellCenter(i, j)
+                         : 0.0;
     });
 }
 
@@ -158,25 +175,58 @@ void GridSinglePhasePressureSolver2::solve(const FaceCenteredGrid2& input,
     UNUSED_VARIABLE(timeIntervalInSeconds);
     UNUSED_VARIABLE(boundaryVelocity);
 
+    const bool isWarmStart =
+        _isWarmStarting && _systemSolver != nullptr &&
+        pressure().size() == input.resolution();
+
     auto pos = input.cellCenterPosition();
     buildMarkers(input.resolution(), pos, boundarySdf, fluidSdf);
     buildSystem(input, useCompressed);
 
     if (_systemSolver != nullptr) {
+        const bool wasUsingInitialGuess = _systemSolver->isUsingInitialGuess();
+        _systemSolver->setIsUsingInitialGuess(isWarmStart);
+
         // Solve the system
         if (_mgSystemSolver == nullptr) {
             if (useCompressed) {
+                if (isWarmStart) {
+                    compressSolution();
+                }
                 _system.clear();
+                _systemF.clear();
                 _systemSolver->solveCompressed(&_compSystem);
                 decompressSolution();
             } else {
                 _compSystem.clear();
-                _systemSolver->solve(&_system);
+                if (isSolvingInSinglePrecision(useCompressed)) {
+                    solveSinglePrecision(isWarmStart);
+                } else {
+                    _systemSolver->solve(&_system);
+                }
             }
+        } else if (isSolvingInSinglePrecision(useCompressed)) {
+            solveSinglePrecision(isWarmStart);
         } else {
             _mgSystemSolver->solve(&_mgSystem);
         }
 
+        _systemSolver->setIsUsingInitialGuess(wasUsingInitialGuess);
+
+        // Record the iterations saved by the warm start
+        _lastNumberOfIterations = _systemSolver->lastNumberOfIterations();
+        if (isWarmStart) {
+            _lastNumberOfSavedIterations =
+                static_cast<int>(_coldStartNumberOfIterations) -
+                static_cast<int>(_lastNumberOfIterations);
+            JET_INFO << "Warm-started pressure solve took "
+                     << _lastNumberOfIterations << " iterations, saved "
+                     << _lastNumberOfSavedIterations << " iterations";
+        } else {
+            _coldStartNumberOfIterations = _lastNumberOfIterations;
+            _lastNumberOfSavedIterations = 0;
+        }
+
         // Apply pressure gradient
         applyPressureGradient(input, output);
     }
@@ -196,19 +246,46 @@ void GridSinglePhasePressureSolver2::setLinearSystemSolver(
     const FdmLinearSystemSolver2Ptr& solver) {
     _systemSolver = solver;
     _mgSystemSolver = std::dynamic_pointer_cast<FdmMgSolver2>(_systemSolver);
+    _cgSystemSolver = std::dynamic_pointer_cast<FdmCgSolver2>(_systemSolver);
 
     if (_mgSystemSolver == nullptr) {
         // In case of non-mg system, use flat structure.
         _mgSystem.clear();
+        _mgSystemF.clear();
     } else {
         // In case of mg system, use multi-level structure.
         _system.clear();
+        _systemF.clear();
         _compSystem.clear();
     }
 }
 
+bool GridSinglePhasePressureSolver2::isUsingSinglePrecision() const {
+    return _isUsingSinglePrecision;
+}
+
+void GridSinglePhasePressureSolver2::setIsUsingSinglePrecision(bool isUsing) {
+    _isUsingSinglePrecision = isUsing;
+}
+
+bool GridSinglePhasePressureSolver2::isWarmStarting() const {
+    return _isWarmStarting;
+}
+
+void GridSinglePhasePressureSolver2::setIsWarmStarting(bool isWarmStarting) {
+    _isWarmStarting = isWarmStarting;
+}
+
+unsigned int GridSinglePhasePressureSolver2::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+int GridSinglePhasePressureSolver2::lastNumberOfSavedIterations() const {
+    return _lastNumberOfSavedIterations;
+}
+
 const FdmVector2& GridSinglePhasePressureSolver2::pressure() const {
-    if (_mgSystemSolver == nullptr) {
+    if (_mgSystemSolver == nullptr || _mgSystem.x.levels.empty()) {
         return _system.x;
     } else {
         return _mgSystem.x.levels.front();
@@ -223,6 +300,7 @@ void GridSinglePhasePressureSolver2::buildMarkers(
     if (_mgSystemSolver != nullptr) {
         maxLevels = _mgSystemSolver->params().maxNumberOfLevels;
     }
+    const size_t lastNumberOfLevels = _markers.size();
     FdmMgUtils2::resizeArrayWithFinest(size, maxLevels, &_markers);
 
     // Build top-level markers
@@ -237,29 +315,48 @@ void GridSinglePhasePressureSolver2::buildMarkers(
         }
     });
 
-    // Build sub-level markers
+    // Find the blocks whose markers changed since the last build, and skip
+    // the rest if there are none
+    _dirtyBlocks.resize(_markers.size());
+    if (_markers.size() != lastNumberOfLevels || _lastMarkers.size() != size) {
+        for (size_t l = 0; l < _markers.size(); ++l) {
+            _dirtyBlocks[l].resize(dirtyBlockResolution(_markers[l].size()));
+            _dirtyBlocks[l].set(1);
+        }
+    } else if (markDirtyBlocks(_markers[0], _lastMarkers, &_dirtyBlocks[0])) {
+        for (size_t l = 1; l < _markers.size(); ++l) {
+            coarsenDirtyBlocks(_dirtyBlocks[l - 1], _markers[l].size(),
+                               &_dirtyBlocks[l]);
+        }
+    } else {
+        return;
+    }
+    _lastMarkers.set(_markers[0]);
+
+    // Build sub-level markers of the changed blocks
     for (size_t l = 1; l < _markers.size(); ++l) {
         const auto& finer = _markers[l - 1];
         auto& coarser = _markers[l];
+        const Size2 m = finer.size();
         const Size2 n = coarser.size();
 
-        parallelRangeFor(
-            kZeroSize, n.x, kZeroSize, n.y,
+        parallelForEachDirtyBlock(
+            _dirtyBlocks[l], n, false,
             [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd) {
                 std::array<size_t, 4> jIndices;
 
                 for (size_t j = jBegin; j < jEnd; ++j) {
                     jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
                     jIndices[1] = 2 * j;
-                    jIndices[2] = 2 * j + 1;
-                    jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
+                    jIndices[2] = std::min(2 * j + 1, m.y - 1);
+                    jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : jIndices[2];
 
                     std::array<size_t, 4> iIndices;
                     for (size_t i = iBegin; i < iEnd; ++i) {
                         iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
                         iIndices[1] = 2 * i;
-                        iIndices[2] = 2 * i + 1;
-                        iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
+                        iIndices[2] = std::min(2 * i + 1, m.x - 1);
+                        iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : iIndices[2];
 
                         int cnt[3] = {0, 0, 0};
                         for (size_t y = 0; y < 4; ++y) {
@@ -283,6 +380,50 @@ void GridSinglePhasePressureSolver2::buildMarkers(
     }
 }
 
+bool GridSinglePhasePressureSolver2::isSolvingInSinglePrecision(
+    bool useCompressed) const {
+    return _isUsingSinglePrecision &&
+           (_mgSystemSolver != nullptr ||
+            (_cgSystemSolver != nullptr && !useCompressed));
+}
+
+void GridSinglePhasePressureSolver2::solveSinglePrecision(bool isWarmStart) {
+    if (_mgSystemSolver != nullptr) {
+        // As in the double solve, the cycle starts from the last solution
+        // kept in the float system.
+        _mgSystemSolver->solve(&_mgSystemF);
+
+        const auto& xF = _mgSystemF.x.levels.front();
+        auto& x = _mgSystem.x.levels.front();
+        x.parallelForEachIndex([&](size_t i, size_t j) { x(i, j) = xF(i, j); });
+        return;
+    }
+
+    if (isWarmStart) {
+        _systemF.x.parallelForEachIndex([&](size_t i, size_t j) {
+            _systemF.x(i, j) = static_cast<float>(_system.x(i, j));
+        });
+    }
+
+    _cgSystemSolver->solve(&_systemF);
+
+    _system.x.parallelForEachIndex([&](size_t i, size_t j) {
+        _system.x(i, j) = _systemF.x(i, j);
+    });
+}
+
+void GridSinglePhasePressureSolver2::compressSolution() {
+    const auto acc = _markers[0].constAccessor();
+
+    size_t row = 0;
+    _markers[0].forEachIndex([&](size_t i, size_t j) {
+        if (acc(i, j) == kFluid) {
+            _compSystem.x[row] = _system.x(i, j);
+            ++row;
+        }
+    });
+}
+
 void GridSinglePhasePressureSolver2::decompressSolution() {
     const auto acc = _markers[0].constAccessor();
     _system.x.resize(acc.size());
@@ -299,57 +440,100 @@ void GridSinglePhasePressureSolver2::decompressSolution() {
 void GridSinglePhasePressureSolver2::buildSystem(const FaceCenteredGrid2& input,
                                                  bool useCompressed) {
     Size2 size = input.resolution();
+    Vector2D h = input.gridSpacing();
     size_t numLevels = 1;
 
+    // The matrices only depend on the markers and the grid spacing. Unless
+    // the grid spacing or the matrix layout changed since the last build,
+    // only the rows around the blocks with changed markers are rebuilt.
+    bool isMatrixReusable = h == _lastGridSpacing;
+    _lastGridSpacing = h;
+
     if (_mgSystemSolver == nullptr) {
-        if (!useCompressed) {
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            // Only the pressure is kept in double
+            isMatrixReusable = isMatrixReusable && _systemF.A.size() == size;
+            _system.A.clear();
+            _system.b.clear();
+            _system.x.resize(size);
+            _systemF.resize(size);
+        } else if (!useCompressed) {
+            isMatrixReusable = isMatrixReusable && _system.A.size() == size;
             _system.resize(size);
+            _systemF.clear();
         }
     } else {
         // Build levels
         size_t maxLevels = _mgSystemSolver->params().maxNumberOfLevels;
-        FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.A.levels);
-        FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.x.levels);
-        FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.b.levels);
-
-        numLevels = _mgSystem.A.levels.size();
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            // Only the finest pressure is kept in double
+            isMatrixReusable = isMatrixReusable &&
+                               !_mgSystemF.A.levels.empty() &&
+                               _mgSystemF.A.levels.front().size() == size &&
+                               _mgSystemF.A.levels.size() == _markers.size();
+            _mgSystemF.resizeWithFinest(size, maxLevels);
+            _mgSystem.A.levels.clear();
+            _mgSystem.b.levels.clear();
+            _mgSystem.x.levels.resize(1);
+            _mgSystem.x.levels.front().resize(size);
+
+            numLevels = _mgSystemF.A.levels.size();
+        } else {
+            isMatrixReusable = isMatrixReusable &&
+                               !_mgSystem.A.levels.empty() &&
+                               _mgSystem.A.levels.front().size() == size &&
+                               _mgSystem.A.levels.size() == _markers.size();
+            FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.A.levels);
+            FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.x.levels);
+            FdmMgUtils2::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.b.levels);
+            _mgSystemF.clear();
+
+            numLevels = _mgSystem.A.levels.size();
+        }
+    }
+
+    if (!isMatrixReusable) {
+        for (auto& dirtyBlocks : _dirtyBlocks) {
+            dirtyBlocks.set(1);
+        }
     }
 
     // Build top level
-    const FaceCenteredGrid2* finer = &input;
     if (_mgSystemSolver == nullptr) {
         if (useCompressed) {
             buildSingleSystem(&_compSystem.A, &_compSystem.x, &_compSystem.b,
-                              _markers[0], *finer);
+                              _markers[0], input);
+        } else if (isSolvingInSinglePrecision(useCompressed)) {
+            buildSingleMatrix(&_systemF.A, _markers[0], h, _dirtyBlocks[0]);
+            buildSingleRhs(&_systemF.b, _markers[0], input);
         } else {
-            buildSingleSystem(&_system.A, &_system.b, _markers[0], *finer);
+            buildSingleMatrix(&_system.A, _markers[0], h, _dirtyBlocks[0]);
+            buildSingleRhs(&_system.b, _markers[0], input);
         }
+    } else if (isSolvingInSinglePrecision(useCompressed)) {
+        buildSingleMatrix(&_mgSystemF.A.levels.front(), _markers[0], h,
+                          _dirtyBlocks[0]);
+        buildSingleRhs(&_mgSystemF.b.levels.front(), _markers[0], input);
     } else {
-        buildSingleSystem(&_mgSystem.A.levels.front(),
-                          &_mgSystem.b.levels.front(), _markers[0], *finer);
+        buildSingleMatrix(&_mgSystem.A.levels.front(), _markers[0], h,
+                          _dirtyBlocks[0]);
+        buildSingleRhs(&_mgSystem.b.levels.front(), _markers[0], input);
     }
 
-    // Build sub-levels
-    FaceCenteredGrid2 coarser;
+    // Build sub-levels. The multigrid cycle overwrites the coarser RHS with
+    // the restricted residual, so only the matrices are needed.
     for (size_t l = 1; l < numLevels; ++l) {
-        auto res = finer->resolution();
-        auto h = finer->gridSpacing();
-        auto o = finer->origin();
-        res.x = res.x >> 1;
-        res.y = res.y >> 1;
         h *= 2.0;
-
-        // Down sample
-        coarser.resize(res, h, o);
-        coarser.fill(finer->sampler());
-
-        buildSingleSystem(&_mgSystem.A.levels[l], &_mgSystem.b.levels[l],
-                          _markers[l], coarser);
-
-        finer = &coarser;
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            buildSingleMatrix(&_mgSystemF.A.levels[l], _markers[l], h,
+                              _dirtyBlocks[l]);
+        } else {
+            buildSingleMatrix(&_mgSystem.A.levels[l], _markers[l], h,
+                              _dirtyBlocks[l]);
+        }
     }
 }
 
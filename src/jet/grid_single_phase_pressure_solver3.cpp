@@ -6,6 +6,8 @@
 
 #include <pch.h>
 
+#include "dirty_block_helpers.h"
+
 #include <jet/constants.h>
 #include <jet/fdm_iccg_solver3.h>
 #include <jet/grid_blocked_boundary_condition_solver3.h>
@@ -22,59 +24,122 @@ const double kDefaultTolerance = 1e-6;
 
 namespace {
 
-void buildSingleSystem(FdmMatrix3* A, FdmVector3* b,
-                       const Array3<char>& markers,
-                       const FaceCenteredGrid3& input) {
-    Size3 size = input.resolution();
-    Vector3D invH = 1.0 / input.gridSpacing();
-    Vector3D invHSqr = invH * invH;
+// Returns the row of the fluid cell (i, j, k).
+FdmMatrixRow3 buildFluidRow(const Array3<char>& markers,
+                            const Vector3D& invHSqr, size_t i, size_t j,
+                            size_t k) {
+    Size3 size = markers.size();
+    FdmMatrixRow3 row;
+
+    if (i + 1 < size.x && markers(i + 1, j, k) != kBoundary) {
+        row.center += invHSqr.x;
+        if (markers(i + 1, j, k) == kFluid) {
+            row.right -= invHSqr.x;
+        }
+    }
 
-    // Build linear system
-    A->parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        auto& row = (*A)(i, j, k);
+    if (i > 0 && markers(i - 1, j, k) != kBoundary) {
+        row.center += invHSqr.x;
+    }
 
-        // initialize
-        row.center = row.right = row.up = row.front = 0.0;
-        (*b)(i, j, k) = 0.0;
+    if (j + 1 < size.y && markers(i, j + 1, k) != kBoundary) {
+        row.center += invHSqr.y;
+        if (markers(i, j + 1, k) == kFluid) {
+            row.up -= invHSqr.y;
+        }
+    }
 
-        if (markers(i, j, k) == kFluid) {
-            (*b)(i, j, k) = input.divergenceAtCellCenter(i, j, k);
+    if (j > 0 && markers(i, j - 1, k) != kBoundary) {
+        row.center += invHSqr.y;
+    }
 
-            if (i + 1 < size.x && markers(i + 1, j, k) != kBoundary) {
-                row.center += invHSqr.x;
-                if (markers(i + 1, j, k) == kFluid) {
-                    row.right -= invHSqr.x;
-                }
-            }
+    if (k + 1 < size.z && markers(i, j, k + 1) != kBoundary) {
+        row.center += invHSqr.z;
+        if (markers(i, j, k + 1) == kFluid) {
+            row.front -= invHSqr.z;
+        }
+    }
 
-            if (i > 0 && markers(i - 1, j, k) != kBoundary) {
-                row.center += invHSqr.x;
-            }
+    if (k > 0 && markers(i, j, k - 1) != kBoundary) {
+        row.center += invHSqr.z;
+    }
 
-            if (j + 1 < size.y && markers(i, j + 1, k) != kBoundary) {
-                row.center += invHSqr.y;
-                if (markers(i, j + 1, k) == kFluid) {
-                    row.up -= invHSqr.y;
-                }
-            }
+    return row;
+}
 
-            if (j > 0 && markers(i, j - 1, k) != kBoundary) {
-                row.center += invHSqr.y;
-            }
+// Stores the row in the precision of the matrix.
+void setRow(const FdmMatrixRow3& row, FdmMatrixRow3* result) {
+    *result = row;
+}
 
-            if (k + 1 < size.z && markers(i, j, k + 1) != kBoundary) {
-                row.center += invHSqr.z;
-                if (markers(i, j, k + 1) == kFluid) {
-                    row.front -= invHSqr.z;
+void setRow(const FdmMatrixRow3& row, FdmMatrixRow3F* result) {
+    result->center = static_cast<float>(row.center);
+    result->right = static_cast<float>(row.right);
+    result->up = static_cast<float>(row.up);
+    result->front = static_cast<float>(row.front);
+}
+
+// Rebuilds the rows that read a marker of a dirty block.
+template <typename Matrix>
+void buildSingleMatrix(Matrix* A, const Array3<char>& markers,
+                       const Vector3D& gridSpacing,
+                       const Array3<char>& dirtyBlocks) {
+    Vector3D invH = 1.0 / gridSpacing;
+    Vector3D invHSqr = invH * invH;
+
+    parallelForEachDirtyBlock(
+        dirtyBlocks, A->size(), true,
+        [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
+            size_t kBegin, size_t kEnd) {
+            for (size_t k = kBegin; k < kEnd; ++k) {
+                for (size_t j = jBegin; j < jEnd; ++j) {
+                    for (size_t i = iBegin; i < iEnd; ++i) {
+                        FdmMatrixRow3 row;
+
+                        if (markers(i, j, k) == kFluid) {
+                            row = buildFluidRow(markers, invHSqr, i, j, k);
+                        } else {
+                            row.center =
+                                2.0 * (invHSqr.x + invHSqr.y + invHSqr.z);
+                        }
+
+                        setRow(row, &(*A)(i, j, k));
+                    }
                 }
             }
+        });
+}
 
-            if (k > 0 && markers(i, j, k - 1) != kBoundary) {
-                row.center += invHSqr.z;
-            }
-        } else {
-            row.center = 1.0;
+template <typename Vector>
+void buildSingleRhs(Vector* b, const Array3<char>& markers,
+                    const FaceCenteredGrid3& input) {
+    b->parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        (*b)(i, j, k) = (markers(i, j, k) == kFluid)
+                            ? input.divergenceAtCellCenter(i, j, k)
+                            : 0.0;
+    });
+}
+
+void buildSingleSystem(FdmStencilLinearSystem3* system,
+                       const Array3<char>& markers,
+                       const FaceCenteredGrid3& input) {
+    Vector3D invH = 1.0 / input.gridSpacing();
+    Vector3D invHSqr = invH * invH;
+
+    system->resize(markers.size(), [&](size_t i, size_t j, size_t k) {
+        return markers(i, j, k) == kFluid;
+    });
+
+    FdmStencilMatrix3& A = system->A;
+    A.rowIndices.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        const uint32_t r = A.rowIndices(i, j, k);
+        if (r == FdmStencilMatrix3::kInvalidRow) {
+            return;
         }
+
+        setRow(buildFluidRow(markers, invHSqr, i, j, k), &A.rows[r]);
+
+        system->b[r] = input.divergenceAtCellCenter(i, j, k);
     });
 }
 
@@ -188,25 +253,63 @@ void GridSinglePhasePressureSolver3::solve(const FaceCenteredGrid3& input,
     UNUSED_VARIABLE(timeIntervalInSeconds);
     UNUSED_VARIABLE(boundaryVelocity);
 
+    const bool isWarmStart =
+        _isWarmStarting && _systemSolver != nullptr &&
+        pressure().size() == input.resolution();
+
     auto pos = input.cellCenterPosition();
     buildMarkers(input.resolution(), pos, boundarySdf, fluidSdf);
     buildSystem(input, useCompressed);
 
     if (_systemSolver != nullptr) {
+        const bool wasUsingInitialGuess = _systemSolver->isUsingInitialGuess();
+        _systemSolver->setIsUsingInitialGuess(isWarmStart);
+
         // Solve the system
         if (_mgSystemSolver == nullptr) {
             if (useCompressed) {
+                if (isWarmStart) {
+                    compressSolution();
+                }
                 _system.clear();
-                _systemSolver->solveCompressed(&_compSystem);
+                _systemF.clear();
+                if (_isUsingStencilSystem) {
+                    _systemSolver->solveStencil(&_stencilSystem);
+                } else {
+                    _systemSolver->solveCompressed(&_compSystem);
+                }
                 decompressSolution();
             } else {
                 _compSystem.clear();
-                _systemSolver->solve(&_system);
+                _stencilSystem.clear();
+                if (isSolvingInSinglePrecision(useCompressed)) {
+                    solveSinglePrecision(isWarmStart);
+                } else {
+                    _systemSolver->solve(&_system);
+                }
             }
+        } else if (isSolvingInSinglePrecision(useCompressed)) {
+            solveSinglePrecision(isWarmStart);
         } else {
             _mgSystemSolver->solve(&_mgSystem);
         }
 
+        _systemSolver->setIsUsingInitialGuess(wasUsingInitialGuess);
+
+        // Record the iterations saved by the warm start
+        _lastNumberOfIterations = _systemSolver->lastNumberOfIterations();
+        if (isWarmStart) {
+            _lastNumberOfSavedIterations =
+                static_cast<int>(_coldStartNumberOfIterations) -
+                static_cast<int>(_lastNumberOfIterations);
+            JET_INFO << "Warm-started pressure solve took "
+                     << _lastNumberOfIterations << " iterations, saved "
+                     << _lastNumberOfSavedIterations << " iterations";
+        } else {
+            _coldStartNumberOfIterations = _lastNumberOfIterations;
+            _lastNumberOfSavedIterations = 0;
+        }
+
         // Apply pressure gradient
         applyPressureGradient(input, output);
     }
@@ -226,19 +329,55 @@ void GridSinglePhasePressureSolver3::setLinearSystemSolver(
     const FdmLinearSystemSolver3Ptr& solver) {
     _systemSolver = solver;
     _mgSystemSolver = std::dynamic_pointer_cast<FdmMgSolver3>(_systemSolver);
+    _cgSystemSolver = std::dynamic_pointer_cast<FdmCgSolver3>(_systemSolver);
 
     if (_mgSystemSolver == nullptr) {
         // In case of non-mg system, use flat structure.
         _mgSystem.clear();
+        _mgSystemF.clear();
     } else {
         // In case of mg system, use multi-level structure.
         _system.clear();
+        _systemF.clear();
         _compSystem.clear();
+        _stencilSystem.clear();
     }
 }
 
+bool GridSinglePhasePressureSolver3::isUsingStencilSystem() const {
+    return _isUsingStencilSystem;
+}
+
+void GridSinglePhasePressureSolver3::setIsUsingStencilSystem(bool isUsing) {
+    _isUsingStencilSystem = isUsing;
+}
+
+bool GridSinglePhasePressureSolver3::isUsingSinglePrecision() const {
+    return _isUsingSinglePrecision;
+}
+
+void GridSinglePhasePressureSolver3::setIsUsingSinglePrecision(bool isUsing) {
+    _isUsingSinglePrecision = isUsing;
+}
+
+bool GridSinglePhasePressureSolver3::isWarmStarting() const {
+    return _isWarmStarting;
+}
+
+void GridSinglePhasePressureSolver3::setIsWarmStarting(bool isWarmStarting) {
+    _isWarmStarting = isWarmStarting;
+}
+
+unsigned int GridSinglePhasePressureSolver3::lastNumberOfIterations() const {
+    return _lastNumberOfIterations;
+}
+
+int GridSinglePhasePressureSolver3::lastNumberOfSavedIterations() const {
+    return _lastNumberOfSavedIterations;
+}
+
 const FdmVector3& GridSinglePhasePressureSolver3::pressure() const {
-    if (_mgSystemSolver == nullptr) {
+    if (_mgSystemSolver == nullptr || _mgSystem.x.levels.empty()) {
         return _system.x;
     } else {
         return _mgSystem.x.levels.front();
@@ -254,6 +393,7 @@ void GridSinglePhasePressureSolver3::buildMarkers(
     if (_mgSystemSolver != nullptr) {
         maxLevels = _mgSystemSolver->params().maxNumberOfLevels;
     }
+    const size_t lastNumberOfLevels = _markers.size();
     FdmMgUtils3::resizeArrayWithFinest(size, maxLevels, &_markers);
 
     // Build top-level markers
@@ -268,14 +408,33 @@ void GridSinglePhasePressureSolver3::buildMarkers(
         }
     });
 
-    // Build sub-level markers
+    // Find the blocks whose markers changed since the last build, and skip
+    // the rest if there are none
+    _dirtyBlocks.resize(_markers.size());
+    if (_markers.size() != lastNumberOfLevels || _lastMarkers.size() != size) {
+        for (size_t l = 0; l < _markers.size(); ++l) {
+            _dirtyBlocks[l].resize(dirtyBlockResolution(_markers[l].size()));
+            _dirtyBlocks[l].set(1);
+        }
+    } else if (markDirtyBlocks(_markers[0], _lastMarkers, &_dirtyBlocks[0])) {
+        for (size_t l = 1; l < _markers.size(); ++l) {
+            coarsenDirtyBlocks(_dirtyBlocks[l - 1], _markers[l].size(),
+                               &_dirtyBlocks[l]);
+        }
+    } else {
+        return;
+    }
+    _lastMarkers.set(_markers[0]);
+
+    // Build sub-level markers of the changed blocks
     for (size_t l = 1; l < _markers.size(); ++l) {
         const auto& finer = _markers[l - 1];
         auto& coarser = _markers[l];
+        const Size3 m = finer.size();
         const Size3 n = coarser.size();
 
-        parallelRangeFor(
-            kZeroSize, n.x, kZeroSize, n.y, kZeroSize, n.z,
+        parallelForEachDirtyBlock(
+            _dirtyBlocks[l], n, false,
             [&](size_t iBegin, size_t iEnd, size_t jBegin, size_t jEnd,
                 size_t kBegin, size_t kEnd) {
                 std::array<size_t, 4> kIndices;
@@ -283,23 +442,24 @@ void GridSinglePhasePressureSolver3::buildMarkers(
                 for (size_t k = kBegin; k < kEnd; ++k) {
                     kIndices[0] = (k > 0) ? 2 * k - 1 : 2 * k;
                     kIndices[1] = 2 * k;
-                    kIndices[2] = 2 * k + 1;
-                    kIndices[3] = (k + 1 < n.z) ? 2 * k + 2 : 2 * k + 1;
+                    kIndices[2] = std::min(2 * k + 1, m.z - 1);
+                    kIndices[3] = (k + 1 < n.z) ? 2 * k + 2 : kIndices[2];
 
                     std::array<size_t, 4> jIndices;
 
                     for (size_t j = jBegin; j < jEnd; ++j) {
                         jIndices[0] = (j > 0) ? 2 * j - 1 : 2 * j;
                         jIndices[1] = 2 * j;
-                        jIndices[2] = 2 * j + 1;
-                        jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : 2 * j + 1;
+                        jIndices[2] = std::min(2 * j + 1, m.y - 1);
+                        jIndices[3] = (j + 1 < n.y) ? 2 * j + 2 : jIndices[2];
 
                         std::array<size_t, 4> iIndices;
                         for (size_t i = iBegin; i < iEnd; ++i) {
                             iIndices[0] = (i > 0) ? 2 * i - 1 : 2 * i;
                             iIndices[1] = 2 * i;
-                            iIndices[2] = 2 * i + 1;
-                            iIndices[3] = (i + 1 < n.x) ? 2 * i + 2 : 2 * i + 1;
+                            iIndices[2] = std::min(2 * i + 1, m.x - 1);
+                            iIndices[3] =
+                                (i + 1 < n.x) ? 2 * i + 2 : iIndices[2];
 
                             int cnt[3] = {0, 0, 0};
                             for (size_t z = 0; z < 4; ++z) {
@@ -327,10 +487,77 @@ void GridSinglePhasePressureSolver3::buildMarkers(
     }
 }
 
+bool GridSinglePhasePressureSolver3::isSolvingInSinglePrecision(
+    bool useCompressed) const {
+    return _isUsingSinglePrecision &&
+           (_mgSystemSolver != nullptr ||
+            (_cgSystemSolver != nullptr && !useCompressed));
+}
+
+void GridSinglePhasePressureSolver3::solveSinglePrecision(bool isWarmStart) {
+    if (_mgSystemSolver != nullptr) {
+        // As in the double solve, the cycle starts from the last solution
+        // kept in the float system.
+        _mgSystemSolver->solve(&_mgSystemF);
+
+        const auto& xF = _mgSystemF.x.levels.front();
+        auto& x = _mgSystem.x.levels.front();
+        x.parallelForEachIndex(
+            [&](size_t i, size_t j, size_t k) { x(i, j, k) = xF(i, j, k); });
+        return;
+    }
+
+    if (isWarmStart) {
+        _systemF.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            _systemF.x(i, j, k) = static_cast<float>(_system.x(i, j, k));
+        });
+    }
+
+    _cgSystemSolver->solve(&_systemF);
+
+    _system.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+        _system.x(i, j, k) = _systemF.x(i, j, k);
+    });
+}
+
+void GridSinglePhasePressureSolver3::compressSolution() {
+    const auto acc = _markers[0].constAccessor();
+
+    if (_isUsingStencilSystem) {
+        const auto& rowIndices = _stencilSystem.A.rowIndices;
+        rowIndices.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            const uint32_t row = rowIndices(i, j, k);
+            if (row != FdmStencilMatrix3::kInvalidRow) {
+                _stencilSystem.x[row] = _system.x(i, j, k);
+            }
+        });
+        return;
+    }
+
+    size_t row = 0;
+    _markers[0].forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (acc(i, j, k) == kFluid) {
+            _compSystem.x[row] = _system.x(i, j, k);
+            ++row;
+        }
+    });
+}
+
 void GridSinglePhasePressureSolver3::decompressSolution() {
     const auto acc = _markers[0].constAccessor();
     _system.x.resize(acc.size());
 
+    if (_isUsingStencilSystem) {
+        const auto& rowIndices = _stencilSystem.A.rowIndices;
+        _system.x.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            const uint32_t row = rowIndices(i, j, k);
+            _system.x(i, j, k) = (row == FdmStencilMatrix3::kInvalidRow)
+                                     ? 0.0
+                                     : _stencilSystem.x[row];
+        });
+        return;
+    }
+
     size_t row = 0;
     _markers[0].forEachIndex([&](size_t i, size_t j, size_t k) {
         if (acc(i, j, k) == kFluid) {
@@ -343,58 +570,104 @@ void GridSinglePhasePressureSolver3::decompressSolution() {
 void GridSinglePhasePressureSolver3::buildSystem(const FaceCenteredGrid3& input,
                                                  bool useCompressed) {
     Size3 size = input.resolution();
+    Vector3D h = input.gridSpacing();
     size_t numLevels = 1;
 
+    // The matrices only depend on the markers and the grid spacing. Unless
+    // the grid spacing or the matrix layout changed since the last build,
+    // only the rows around the blocks with changed markers are rebuilt.
+    bool isMatrixReusable = h == _lastGridSpacing;
+    _lastGridSpacing = h;
+
     if (_mgSystemSolver == nullptr) {
-        if (!useCompressed) {
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            // Only the pressure is kept in double
+            isMatrixReusable = isMatrixReusable && _systemF.A.size() == size;
+            _system.A.clear();
+            _system.b.clear();
+            _system.x.resize(size);
+            _systemF.resize(size);
+        } else if (!useCompressed) {
+            isMatrixReusable = isMatrixReusable && _system.A.size() == size;
             _system.resize(size);
+            _systemF.clear();
         }
     } else {
         // Build levels
         size_t maxLevels = _mgSystemSolver->params().maxNumberOfLevels;
-        FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.A.levels);
-        FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.x.levels);
-        FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
-                                           &_mgSystem.b.levels);
-
-        numLevels = _mgSystem.A.levels.size();
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            // Only the finest pressure is kept in double
+            isMatrixReusable = isMatrixReusable &&
+                               !_mgSystemF.A.levels.empty() &&
+                               _mgSystemF.A.levels.front().size() == size &&
+                               _mgSystemF.A.levels.size() == _markers.size();
+            _mgSystemF.resizeWithFinest(size, maxLevels);
+            _mgSystem.A.levels.clear();
+            _mgSystem.b.levels.clear();
+            _mgSystem.x.levels.resize(1);
+            _mgSystem.x.levels.front().resize(size);
+
+            numLevels = _mgSystemF.A.levels.size();
+        } else {
+            isMatrixReusable = isMatrixReusable &&
+                               !_mgSystem.A.levels.empty() &&
+                               _mgSystem.A.levels.front().size() == size &&
+                               _mgSystem.A.levels.size() == _markers.size();
+            FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.A.levels);
+            FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.x.levels);
+            FdmMgUtils3::resizeArrayWithFinest(size, maxLevels,
+                                               &_mgSystem.b.levels);
+            _mgSystemF.clear();
+
+            numLevels = _mgSystem.A.levels.size();
+        }
+    }
+
+    if (!isMatrixReusable) {
+        for (auto& dirtyBlocks : _dirtyBlocks) {
+            dirtyBlocks.set(1);
+        }
     }
 
     // Build top level
-    const FaceCenteredGrid3* finer = &input;
     if (_mgSystemSolver == nullptr) {
-        if (useCompressed) {
+        if (useCompressed && _isUsingStencilSystem) {
+            _compSystem.clear();
+            buildSingleSystem(&_stencilSystem, _markers[0], input);
+        } else if (useCompressed) {
+            _stencilSystem.clear();
             buildSingleSystem(&_compSystem.A, &_compSystem.x, &_compSystem.b,
-                              _markers[0], *finer);
+                              _markers[0], input);
+        } else if (isSolvingInSinglePrecision(useCompressed)) {
+            buildSingleMatrix(&_systemF.A, _markers[0], h, _dirtyBlocks[0]);
+            buildSingleRhs(&_systemF.b, _markers[0], input);
         } else {
-            buildSingleSystem(&_system.A, &_system.b, _markers[0], *finer);
+            buildSingleMatrix(&_system.A, _markers[0], h, _dirtyBlocks[0]);
+            buildSingleRhs(&_system.b, _markers[0], input);
         }
+    } else if (isSolvingInSinglePrecision(useCompressed)) {
+        buildSingleMatrix(&_mgSystemF.A.levels.front(), _markers[0], h,
+                          _dirtyBlocks[0]);
+        buildSingleRhs(&_mgSystemF.b.levels.front(), _markers[0], input);
     } else {
-        buildSingleSystem(&_mgSystem.A.levels.front(),
-                          &_mgSystem.b.levels.front(), _markers[0], *finer);
+        buildSingleMatrix(&_mgSystem.A.levels.front(), _markers[0], h,
+                          _dirtyBlocks[0]);
+        buildSingleRhs(&_mgSystem.b.levels.front(), _markers[0], input);
     }
 
-    // Build sub-levels
-    FaceCenteredGrid3 coarser;
+    // Build sub-levels. The multigrid cycle overwrites the coarser RHS with
+    // the restricted residual, so only the matrices are needed.
     for (size_t l = 1; l < numLevels; ++l) {
-        auto res = finer->resolution();
-        auto h = finer->gridSpacing();
-        auto o = finer->origin();
-        res.x = res.x >> 1;
-        res.y = res.y >> 1;
-        res.z = res.z >> 1;
         h *= 2.0;
-
-        // Down sample
-        coarser.resize(res, h, o);
-        coarser.fill(finer->sampler());
-
-        buildSingleSystem(&_mgSystem.A.levels[l], &_mgSystem.b.levels[l],
-                          _markers[l], coarser);
-
-        finer = &coarser;
+        if (isSolvingInSinglePrecision(useCompressed)) {
+            buildSingleMatrix(&_mgSystemF.A.levels[l], _markers[l], h,
+                              _dirtyBlocks[l]);
+        } else {
+            buildSingleMatrix(&_mgSystem.A.levels[l], _markers[l], h,
+                              _dirtyBlocks[l]);
+        }
     }
 }
 
@@ -23,6 +23,49 @@
 
 using namespace jet;
 
+namespace {
+
+void serializeSparseGrid(
+    flatbuffers::FlatBufferBuilder* builder,
+    const std::vector<SparseScalarGrid3Ptr>& gridList,
+    std::vector<flatbuffers::Offset<fbs::SparseScalarGridSerialized3>>*
+        fbsGridList) {
+    for (const auto& grid : gridList) {
+        auto type = builder->CreateString(grid->typeName());
+
+        std::vector<uint8_t> gridSerialized;
+        grid->serialize(&gridSerialized);
+        auto fbsGrid = fbs::CreateSparseScalarGridSerialized3(
+            *builder, type, grid->data().background(),
+            builder->CreateVector(gridSerialized.data(),
+                                  gridSerialized.size()));
+        fbsGridList->push_back(fbsGrid);
+    }
+}
+
+void deserializeSparseGrid(
+    const flatbuffers::Vector<
+        flatbuffers::Offset<fbs::SparseScalarGridSerialized3>>* fbsGridList,
+    std::vector<SparseScalarGrid3Ptr>* gridList) {
+    for (const auto& grid : (*fbsGridList)) {
+        auto type = grid->type()->c_str();
+
+        std::vector<uint8_t> gridSerialized(
+            grid->data()->begin(),
+            grid->data()->end());
+
+        // The grid keeps its background value while deserializing, so only
+        // the tiles that differ from it are activated.
+        auto newGrid = Factory::buildSparseScalarGrid3(type);
+        newGrid->fill(grid->background());
+        newGrid->deserialize(gridSerialized);
+
+        gridList->push_back(newGrid);
+    }
+}
+
+}  // namespace
+
 GridSystemData3::GridSystemData3()
 : GridSystemData3({0, 0, 0}, {1, 1, 1}, {0, 0, 0}) {
 }
@@ -52,6 +95,12 @@ GridSystemData3::GridSystemData3(const GridSystemData3& other) {
     for (auto& data : other._advectableVectorDataList) {
         _advectableVectorDataList.push_back(data->clone());
     }
+    for (auto& data : other._sparseScalarDataList) {
+        _sparseScalarDataList.push_back(data->clone());
+    }
+    for (auto& data : other._advectableSparseScalarDataList) {
+        _advectableSparseScalarDataList.push_back(data->clone());
+    }
 
     JET_ASSERT(_advectableVectorDataList.size() > 0);
 
@@ -86,6 +135,14 @@ void GridSystemData3::resize(
     for (auto& data : _advectableVectorDataList) {
         data->resize(resolution, gridSpacing, origin);
     }
+    for (auto& data : _sparseScalarDataList) {
+        data->resize(resolution, gridSpacing, origin,
+                     data->data().background());
+    }
+    for (auto& data : _advectableSparseScalarDataList) {
+        data->resize(resolution, gridSpacing, origin,
+                     data->data().background());
+    }
 }
 
 Size3 GridSystemData3::resolution() const {
@@ -140,6 +197,24 @@ size_t GridSystemData3::addAdvectableVectorData(
     return attrIdx;
 }
 
+size_t GridSystemData3::addSparseScalarData(
+    const SparseScalarGridBuilder3Ptr& builder,
+    double background) {
+    size_t attrIdx = _sparseScalarDataList.size();
+    _sparseScalarDataList.push_back(
+        builder->build(resolution(), gridSpacing(), origin(), background));
+    return attrIdx;
+}
+
+size_t GridSystemData3::addAdvectableSparseScalarData(
+    const SparseScalarGridBuilder3Ptr& builder,
+    double background) {
+    size_t attrIdx = _advectableSparseScalarDataList.size();
+    _advectableSparseScalarDataList.push_back(
+        builder->build(resolution(), gridSpacing(), origin(), background));
+    return attrIdx;
+}
+
 const FaceCenteredGrid3Ptr& GridSystemData3::velocity() const {
     return _velocity;
 }
@@ -166,6 +241,16 @@ GridSystemData3::advectableVectorDataAt(size_t idx) const {
     return _advectableVectorDataList[idx];
 }
 
+const SparseScalarGrid3Ptr&
+GridSystemData3::sparseScalarDataAt(size_t idx) const {
+    return _sparseScalarDataList[idx];
+}
+
+const SparseScalarGrid3Ptr&
+GridSystemData3::advectableSparseScalarDataAt(size_t idx) const {
+    return _advectableSparseScalarDataList[idx];
+}
+
 size_t GridSystemData3::numberOfScalarData() const {
     return _scalarDataList.size();
 }
@@ -182,6 +267,14 @@ size_t GridSystemData3::numberOfAdvectableVectorData() const {
     return _advectableVectorDataList.size();
 }
 
+size_t GridSystemData3::numberOfSparseScalarData() const {
+    return _sparseScalarDataList.size();
+}
+
+size_t GridSystemData3::numberOfAdvectableSparseScalarData() const {
+    return _advectableSparseScalarDataList.size();
+}
+
 void GridSystemData3::serialize(std::vector<uint8_t>* buffer) const {
     flatbuffers::FlatBufferBuilder builder(1024);
 
@@ -195,6 +288,10 @@ void GridSystemData3::serialize(std::vector<uint8_t>* buffer) const {
         advScalarDataList;
     std::vector<flatbuffers::Offset<fbs::VectorGridSerialized3>>
         advVectorDataList;
+    std::vector<flatbuffers::Offset<fbs::SparseScalarGridSerialized3>>
+        sparseScalarDataList;
+    std::vector<flatbuffers::Offset<fbs::SparseScalarGridSerialized3>>
+        advSparseScalarDataList;
 
     serializeGrid(
         &builder,
@@ -216,6 +313,14 @@ void GridSystemData3::serialize(std::vector<uint8_t>* buffer) const {
         _advectableVectorDataList,
         fbs::CreateVectorGridSerialized3,
         &advVectorDataList);
+    serializeSparseGrid(
+        &builder,
+        _sparseScalarDataList,
+        &sparseScalarDataList);
+    serializeSparseGrid(
+        &builder,
+        _advectableSparseScalarDataList,
+        &advSparseScalarDataList);
 
     auto gsd = fbs::CreateGridSystemData3(
         builder,
@@ -226,7 +331,9 @@ void GridSystemData3::serialize(std::vector<uint8_t>* buffer) const {
         builder.CreateVector(scalarDataList),
         builder.CreateVector(vectorDataList),
         builder.CreateVector(advScalarDataList),
-        builder.CreateVector(advVectorDataList));
+        builder.CreateVector(advVectorDataList),
+        builder.CreateVector(sparseScalarDataList),
+        builder.CreateVector(advSparseScalarDataList));
 
     builder.Finish(gsd);
 
@@ -249,6 +356,8 @@ void GridSystemData3::deserialize(const std::vector<uint8_t>& buffer) {
     _vectorDataList.clear();
     _advectableScalarDataList.clear();
     _advectableVectorDataList.clear();
+    _sparseScalarDataList.clear();
+    _advectableSparseScalarDataList.clear();
 
     deserializeGrid(
         gsd->scalarData(),
@@ -267,6 +376,18 @@ void GridSystemData3::deserialize(const std::vector<uint8_t>& buffer) {
         Factory::buildVectorGrid3,
         &_advectableVectorDataList);
 
+    // Buffers written before the sparse layers were added do not have them.
+    if (gsd->sparseScalarData() != nullptr) {
+        deserializeSparseGrid(
+            gsd->sparseScalarData(),
+            &_sparseScalarDataList);
+    }
+    if (gsd->advectableSparseScalarData() != nullptr) {
+        deserializeSparseGrid(
+            gsd->advectableSparseScalarData(),
+            &_advectableSparseScalarDataList);
+    }
+
     _velocityIdx = static_cast<size_t>(gsd->velocityIdx());
     _velocity = std::dynamic_pointer_cast<FaceCenteredGrid3>(
         _advectableVectorDataList[_velocityIdx]);
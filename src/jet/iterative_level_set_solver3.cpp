@@ -5,6 +5,7 @@
 // property of any third parties.
 
 #include <pch.h>
+#include <narrow_band_helpers.h>
 #include <jet/array_utils.h>
 #include <jet/fdm_utils.h>
 #include <jet/iterative_level_set_solver3.h>
@@ -13,6 +14,7 @@
 #include <algorithm>
 #include <limits>
 #include <utility>  // just make cpplint happy..
+#include <vector>
 
 using namespace jet;
 
@@ -50,29 +52,8 @@ void IterativeLevelSetSolver3::reinitialize(
     for (unsigned int n = 0; n < numberOfIterations; ++n) {
         inputSdf.parallelForEachDataPointIndex(
             [&](size_t i, size_t j, size_t k) {
-                double s = sign(outputAcc, gridSpacing, i, j, k);
-
-                std::array<double, 2> dx, dy, dz;
-
-                getDerivatives(outputAcc, gridSpacing, i, j, k, &dx, &dy, &dz);
-
-                // Explicit Euler step
-                double val = outputAcc(i, j, k)
-                    - dtau * std::max(s, 0.0)
-                        * (std::sqrt(square(std::max(dx[0], 0.0))
-                                   + square(std::min(dx[1], 0.0))
-                                   + square(std::max(dy[0], 0.0))
-                                   + square(std::min(dy[1], 0.0))
-                                   + square(std::max(dz[0], 0.0))
-                                   + square(std::min(dz[1], 0.0))) - 1.0)
-                    - dtau * std::min(s, 0.0)
-                        * (std::sqrt(square(std::min(dx[0], 0.0))
-                                   + square(std::max(dx[1], 0.0))
-                                   + square(std::min(dy[0], 0.0))
-                                   + square(std::max(dy[1], 0.0))
-                                   + square(std::min(dz[0], 0.0))
-                                   + square(std::max(dz[1], 0.0))) - 1.0);
-                tempAcc(i, j, k) = val;
+                tempAcc(i, j, k) =
+                    reinitializeAt(outputAcc, gridSpacing, dtau, i, j, k);
             });
 
         std::swap(tempAcc, outputAcc);
@@ -82,6 +63,57 @@ void IterativeLevelSetSolver3::reinitialize(
     copyRange3(outputAcc, size.x, size.y, size.z, &outputSdfAcc);
 }
 
+void IterativeLevelSetSolver3::reinitializeNarrowBand(
+    const ScalarGrid3& inputSdf,
+    double bandWidth,
+    ScalarGrid3* outputSdf) {
+    const Size3 size = inputSdf.dataSize();
+    const Vector3D gridSpacing = inputSdf.gridSpacing();
+
+    JET_THROW_INVALID_ARG_IF(!inputSdf.hasSameShape(*outputSdf));
+
+    std::vector<Point3UI> band;
+    findNarrowBand(inputSdf.constDataAccessor(), bandWidth, &band);
+
+    // The data points outside the band are clamped once and stay fixed, so
+    // both buffers start with the same values.
+    ArrayAccessor3<double> outputAcc = outputSdf->dataAccessor();
+    inputSdf.parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        outputAcc(i, j, k) = clampToNarrowBand(inputSdf(i, j, k), bandWidth);
+    });
+
+    Array3<double> temp(size);
+    ArrayAccessor3<double> tempAcc = temp.accessor();
+    copyRange3(outputAcc, size.x, size.y, size.z, &tempAcc);
+
+    const double dtau = pseudoTimeStep(outputAcc, gridSpacing, band);
+    const unsigned int numberOfIterations
+        = distanceToNumberOfIterations(bandWidth, dtau);
+
+    JET_INFO << "Reinitializing " << band.size()
+             << " points in the narrow band with pseudoTimeStep: " << dtau
+             << " numberOfIterations: " << numberOfIterations;
+
+    for (unsigned int n = 0; n < numberOfIterations; ++n) {
+        parallelFor(kZeroSize, band.size(), [&](size_t l) {
+            const Point3UI& pt = band[l];
+            tempAcc(pt.x, pt.y, pt.z) = clampToNarrowBand(
+                reinitializeAt(outputAcc, gridSpacing, dtau, pt.x, pt.y, pt.z),
+                bandWidth);
+        });
+
+        std::swap(tempAcc, outputAcc);
+    }
+
+    auto outputSdfAcc = outputSdf->dataAccessor();
+    if (outputAcc.data() != outputSdfAcc.data()) {
+        parallelFor(kZeroSize, band.size(), [&](size_t l) {
+            const Point3UI& pt = band[l];
+            outputSdfAcc(pt.x, pt.y, pt.z) = outputAcc(pt.x, pt.y, pt.z);
+        });
+    }
+}
+
 void IterativeLevelSetSolver3::extrapolate(
     const ScalarGrid3& input,
     const ScalarField3& sdf,
@@ -267,6 +299,37 @@ void IterativeLevelSetSolver3::setMaxCfl(double newMaxCfl) {
     _maxCfl = std::max(newMaxCfl, 0.0);
 }
 
+double IterativeLevelSetSolver3::reinitializeAt(
+    const ConstArrayAccessor3<double>& sdf,
+    const Vector3D& gridSpacing,
+    double dtau,
+    size_t i,
+    size_t j,
+    size_t k) const {
+    double s = sign(sdf, gridSpacing, i, j, k);
+
+    std::array<double, 2> dx, dy, dz;
+
+    getDerivatives(sdf, gridSpacing, i, j, k, &dx, &dy, &dz);
+
+    // Explicit Euler step
+    return sdf(i, j, k)
+        - dtau * std::max(s, 0.0)
+            * (std::sqrt(square(std::max(dx[0], 0.0))
+                       + square(std::min(dx[1], 0.0))
+                       + square(std::max(dy[0], 0.0))
+                       + square(std::min(dy[1], 0.0))
+                       + square(std::max(dz[0], 0.0))
+                       + square(std::min(dz[1], 0.0))) - 1.0)
+        - dtau * std::min(s, 0.0)
+            * (std::sqrt(square(std::min(dx[0], 0.0))
+                       + square(std::max(dx[1], 0.0))
+                       + square(std::min(dy[0], 0.0))
+                       + square(std::max(dy[1], 0.0))
+                       + square(std::min(dz[0], 0.0))
+                       + square(std::max(dz[1], 0.0))) - 1.0);
+}
+
 unsigned int IterativeLevelSetSolver3::distanceToNumberOfIterations(
     double distance,
     double dtau) {
@@ -309,3 +372,24 @@ double IterativeLevelSetSolver3::pseudoTimeStep(
 
     return dtau;
 }
+
+double IterativeLevelSetSolver3::pseudoTimeStep(
+    ConstArrayAccessor3<double> sdf,
+    const Vector3D& gridSpacing,
+    const std::vector<Point3UI>& band) {
+    const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+    double maxS = -std::numeric_limits<double>::max();
+    double dtau = _maxCfl * h;
+
+    for (const Point3UI& pt : band) {
+        double s = sign(sdf, gridSpacing, pt.x, pt.y, pt.z);
+        maxS = std::max(s, maxS);
+    }
+
+    while (dtau * maxS / h > _maxCfl) {
+        dtau *= 0.5;
+    }
+
+    return dtau;
+}
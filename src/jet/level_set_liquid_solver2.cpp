@@ -10,7 +10,7 @@
 #include <jet/fmm_level_set_solver2.h>
 #include <jet/level_set_liquid_solver2.h>
 #include <jet/level_set_utils.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
 
 #include <algorithm>
 
@@ -83,10 +83,10 @@ void LevelSetLiquidSolver2::onBeginAdvanceTimeStep(
 void LevelSetLiquidSolver2::onEndAdvanceTimeStep(double timeIntervalInSeconds) {
     double currentCfl = cfl(timeIntervalInSeconds);
 
-    Timer timer;
-    reinitialize(currentCfl);
-    JET_INFO << "reinitializing level set field took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("LevelSetLiquidSolver2::reinitialize");
+        reinitialize(currentCfl);
+    }
 
     // Measure current volume
     double currentVol = computeVolume();
@@ -106,10 +106,10 @@ void LevelSetLiquidSolver2::onEndAdvanceTimeStep(double timeIntervalInSeconds) {
 void LevelSetLiquidSolver2::computeAdvection(double timeIntervalInSeconds) {
     double currentCfl = cfl(timeIntervalInSeconds);
 
-    Timer timer;
-    extrapolateVelocityToAir(currentCfl);
-    JET_INFO << "velocity extrapolation took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("LevelSetLiquidSolver2::extrapolateVelocityToAir");
+        extrapolateVelocityToAir(currentCfl);
+    }
 
     GridFluidSolver2::computeAdvection(timeIntervalInSeconds);
 }
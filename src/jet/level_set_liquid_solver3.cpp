@@ -10,7 +10,7 @@
 #include <jet/fmm_level_set_solver3.h>
 #include <jet/level_set_liquid_solver3.h>
 #include <jet/level_set_utils.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
 
 #include <algorithm>
 
@@ -51,6 +51,14 @@ void LevelSetLiquidSolver3::setMinReinitializeDistance(double distance) {
     _minReinitializeDistance = distance;
 }
 
+double LevelSetLiquidSolver3::narrowBandWidth() const {
+    return _narrowBandWidth;
+}
+
+void LevelSetLiquidSolver3::setNarrowBandWidth(double width) {
+    _narrowBandWidth = std::max(width, 0.0);
+}
+
 void LevelSetLiquidSolver3::setIsGlobalCompensationEnabled(bool isEnabled) {
     _isGlobalCompensationEnabled = isEnabled;
 }
@@ -83,10 +91,10 @@ void LevelSetLiquidSolver3::onBeginAdvanceTimeStep(
 void LevelSetLiquidSolver3::onEndAdvanceTimeStep(double timeIntervalInSeconds) {
     double currentCfl = cfl(timeIntervalInSeconds);
 
-    Timer timer;
-    reinitialize(currentCfl);
-    JET_INFO << "reinitializing level set field took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("LevelSetLiquidSolver3::reinitialize");
+        reinitialize(currentCfl);
+    }
 
     // Measure current volume
     double currentVol = computeVolume();
@@ -106,14 +114,29 @@ void LevelSetLiquidSolver3::onEndAdvanceTimeStep(double timeIntervalInSeconds) {
 void LevelSetLiquidSolver3::computeAdvection(double timeIntervalInSeconds) {
     double currentCfl = cfl(timeIntervalInSeconds);
 
-    Timer timer;
-    extrapolateVelocityToAir(currentCfl);
-    JET_INFO << "velocity extrapolation took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("LevelSetLiquidSolver3::extrapolateVelocityToAir");
+        extrapolateVelocityToAir(currentCfl);
+    }
 
     GridFluidSolver3::computeAdvection(timeIntervalInSeconds);
 }
 
+void LevelSetLiquidSolver3::advectScalarData(size_t index,
+                                             double timeIntervalInSeconds) {
+    if (index != _signedDistanceFieldId || _narrowBandWidth <= 0.0) {
+        GridFluidSolver3::advectScalarData(index, timeIntervalInSeconds);
+        return;
+    }
+
+    auto sdf = signedDistanceField();
+    auto sdf0 = sdf->clone();
+    advectionSolver()->advectNarrowBand(
+        *sdf0, *velocity(), timeIntervalInSeconds,
+        bandWidth(cfl(timeIntervalInSeconds)), sdf.get(), *colliderSdf());
+    extrapolateIntoCollider(sdf.get());
+}
+
 ScalarField3Ptr LevelSetLiquidSolver3::fluidSdf() const {
     return signedDistanceField();
 }
@@ -123,6 +146,13 @@ void LevelSetLiquidSolver3::reinitialize(double currentCfl) {
         auto sdf = signedDistanceField();
         auto sdf0 = sdf->clone();
 
+        if (_narrowBandWidth > 0.0) {
+            _levelSetSolver->reinitializeNarrowBand(
+                *sdf0, bandWidth(currentCfl), sdf.get());
+            extrapolateIntoCollider(sdf.get());
+            return;
+        }
+
         const Vector3D gridSpacing = sdf->gridSpacing();
         const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
         const double maxReinitDist
@@ -178,8 +208,9 @@ void LevelSetLiquidSolver3::extrapolateVelocityToAir(double currentCfl) {
 
     const Vector3D gridSpacing = sdf->gridSpacing();
     const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
-    const double maxDist
-        = std::max(2.0 * currentCfl, _minReinitializeDistance) * h;
+    const double maxDist = (_narrowBandWidth > 0.0)
+        ? bandWidth(currentCfl)
+        : std::max(2.0 * currentCfl, _minReinitializeDistance) * h;
 
     JET_INFO << "Max velocity extrapolation distance: " << maxDist;
 
@@ -189,6 +220,15 @@ void LevelSetLiquidSolver3::extrapolateVelocityToAir(double currentCfl) {
     applyBoundaryCondition();
 }
 
+double LevelSetLiquidSolver3::bandWidth(double currentCfl) const {
+    const Vector3D gridSpacing = signedDistanceField()->gridSpacing();
+    const double h = max3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+
+    // The front should not leave the band within a time-step, and the
+    // upwind stencils need two more cells.
+    return std::max(_narrowBandWidth, 2.0 * currentCfl + 2.0) * h;
+}
+
 void LevelSetLiquidSolver3::addVolume(double volDiff) {
     auto sdf = signedDistanceField();
     const Vector3D gridSpacing = sdf->gridSpacing();
@@ -5,6 +5,7 @@
 // property of any third parties.
 
 #include <pch.h>
+#include <narrow_band_helpers.h>
 #include <jet/level_set_solver3.h>
 
 using namespace jet;
@@ -12,3 +13,15 @@ using namespace jet;
 LevelSetSolver3::LevelSetSolver3() {}
 
 LevelSetSolver3::~LevelSetSolver3() {}
+
+void LevelSetSolver3::reinitializeNarrowBand(const ScalarGrid3& inputSdf,
+                                             double bandWidth,
+                                             ScalarGrid3* outputSdf) {
+    reinitialize(inputSdf, bandWidth, outputSdf);
+
+    auto output = outputSdf->dataAccessor();
+    outputSdf->parallelForEachDataPointIndex(
+        [&](size_t i, size_t j, size_t k) {
+            output(i, j, k) = clampToNarrowBand(output(i, j, k), bandWidth);
+        });
+}
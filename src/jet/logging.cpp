@@ -9,13 +9,21 @@
 #include <jet/logging.h>
 #include <jet/macros.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace jet {
 
@@ -25,7 +33,8 @@ static std::ostream* infoOutStream = &std::cout;
 static std::ostream* warnOutStream = &std::cout;
 static std::ostream* errorOutStream = &std::cerr;
 static std::ostream* debugOutStream = &std::cout;
-static LoggingLevel sLoggingLevel = LoggingLevel::All;
+static std::atomic<uint8_t> sLoggingLevel(
+    static_cast<uint8_t>(LoggingLevel::All));
 
 inline std::ostream* levelToStream(LoggingLevel level) {
     switch (level) {
@@ -61,33 +70,192 @@ inline bool isLeq(LoggingLevel a, LoggingLevel b) {
     return (uint8_t)a <= (uint8_t)b;
 }
 
+namespace {
+
+// Number of the messages a thread can queue before waiting for the sink
+const size_t kLogBufferCapacity = 1024;
+
+struct LogMessage {
+    LoggingLevel level = LoggingLevel::Info;
+    std::string text;
+};
+
+// Single-producer single-consumer ring buffer. The owning thread pushes the
+// messages and whoever holds sDrainMutex pops them.
+struct LogBuffer {
+    std::array<LogMessage, kLogBufferCapacity> messages;
+    std::atomic<size_t> head{0};
+    std::atomic<size_t> tail{0};
+
+    bool push(LogMessage* message) {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == kLogBufferCapacity) {
+            return false;
+        }
+
+        messages[t % kLogBufferCapacity] = std::move(*message);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) ==
+               tail.load(std::memory_order_acquire);
+    }
+};
+
+std::atomic<bool> sIsAsync(false);
+
+// The buffers are only locked when a thread logs its first message and when
+// the sink collects them.
+std::mutex sBuffersMutex;
+std::vector<std::shared_ptr<LogBuffer>> sBuffers;
+thread_local std::shared_ptr<LogBuffer> tBuffer;
+
+// Serializes the consumers, that is, the sink thread and flush.
+std::mutex sDrainMutex;
+
+std::mutex sSinkMutex;
+std::condition_variable sSinkCondition;
+std::thread sSinkThread;
+bool sStopSink = false;
+
+LogBuffer& threadBuffer() {
+    if (!tBuffer) {
+        tBuffer = std::make_shared<LogBuffer>();
+
+        std::lock_guard<std::mutex> lock(sBuffersMutex);
+        sBuffers.push_back(tBuffer);
+    }
+
+    return *tBuffer;
+}
+
+void write(const LogMessage& message) {
+    auto strm = levelToStream(message.level);
+    (*strm) << message.text << std::endl;
+    strm->flush();
+}
+
+// Writes out the queued messages and returns true if there were any.
+bool drain() {
+    std::lock_guard<std::mutex> drainLock(sDrainMutex);
+
+    std::vector<std::shared_ptr<LogBuffer>> buffers;
+    {
+        // Forget the empty buffers of the finished threads
+        std::lock_guard<std::mutex> lock(sBuffersMutex);
+        sBuffers.erase(
+            std::remove_if(sBuffers.begin(), sBuffers.end(),
+                           [](const std::shared_ptr<LogBuffer>& buffer) {
+                               return buffer.use_count() == 1 &&
+                                      buffer->isEmpty();
+                           }),
+            sBuffers.end());
+        buffers = sBuffers;
+    }
+
+    bool hasDrained = false;
+    std::lock_guard<std::mutex> lock(critical);
+    for (const auto& buffer : buffers) {
+        const size_t h = buffer->head.load(std::memory_order_relaxed);
+        const size_t t = buffer->tail.load(std::memory_order_acquire);
+        for (size_t i = h; i < t; ++i) {
+            LogMessage& message = buffer->messages[i % kLogBufferCapacity];
+            write(message);
+            message.text.clear();
+        }
+        buffer->head.store(t, std::memory_order_release);
+        hasDrained = hasDrained || (h != t);
+    }
+
+    return hasDrained;
+}
+
+void sinkLoop() {
+    while (true) {
+        const bool hasDrained = drain();
+
+        std::unique_lock<std::mutex> lock(sSinkMutex);
+        if (sStopSink) {
+            break;
+        }
+        if (!hasDrained) {
+            sSinkCondition.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+}
+
+void startSink() {
+    std::lock_guard<std::mutex> lock(sSinkMutex);
+    if (!sSinkThread.joinable()) {
+        sStopSink = false;
+        sSinkThread = std::thread(sinkLoop);
+    }
+}
+
+void stopSink() {
+    {
+        std::lock_guard<std::mutex> lock(sSinkMutex);
+        sStopSink = true;
+    }
+    sSinkCondition.notify_all();
+
+    if (sSinkThread.joinable()) {
+        sSinkThread.join();
+    }
+}
+
+// Stops the sink thread at exit, after writing out the queued messages.
+struct SinkGuard {
+    ~SinkGuard() { Logging::setAsync(false); }
+} sSinkGuard;
+
+}  // namespace
+
 Logger::Logger(LoggingLevel level) : _level(level) {}
 
 Logger::~Logger() {
-    std::lock_guard<std::mutex> lock(critical);
-    if (isLeq(sLoggingLevel, _level)) {
-        auto strm = levelToStream(_level);
-        (*strm) << _buffer.str() << std::endl;
-        strm->flush();
+    if (!Logging::isEnabled(_level)) {
+        return;
+    }
+
+    LogMessage message;
+    message.level = _level;
+    message.text = _buffer.str();
+
+    if (sIsAsync.load(std::memory_order_acquire)) {
+        // Help the sink if this thread is logging faster than it can write
+        LogBuffer& buffer = threadBuffer();
+        while (!buffer.push(&message)) {
+            drain();
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(critical);
+        write(message);
     }
 }
 
 void Logging::setInfoStream(std::ostream* strm) {
+    flush();
     std::lock_guard<std::mutex> lock(critical);
     infoOutStream = strm;
 }
 
 void Logging::setWarnStream(std::ostream* strm) {
+    flush();
     std::lock_guard<std::mutex> lock(critical);
     warnOutStream = strm;
 }
 
 void Logging::setErrorStream(std::ostream* strm) {
+    flush();
     std::lock_guard<std::mutex> lock(critical);
     errorOutStream = strm;
 }
 
 void Logging::setDebugStream(std::ostream* strm) {
+    flush();
     std::lock_guard<std::mutex> lock(critical);
     debugOutStream = strm;
 }
@@ -108,7 +276,10 @@ std::string Logging::getHeader(LoggingLevel level) {
     localtime_s(&time, &now);
     strftime(timeStr, sizeof(timeStr), "%F %T", &time);
 #else
-    strftime(timeStr, sizeof(timeStr), "%F %T", std::localtime(&now));
+    // Headers are made outside the lock, so use the reentrant version
+    tm time;
+    localtime_r(&now, &time);
+    strftime(timeStr, sizeof(timeStr), "%F %T", &time);
 #endif
     char header[256];
     snprintf(header, sizeof(header), "[%s] %s ", levelToString(level).c_str(),
@@ -117,12 +288,32 @@ std::string Logging::getHeader(LoggingLevel level) {
 }
 
 void Logging::setLevel(LoggingLevel level) {
-    std::lock_guard<std::mutex> lock(critical);
-    sLoggingLevel = level;
+    sLoggingLevel = static_cast<uint8_t>(level);
+}
+
+bool Logging::isEnabled(LoggingLevel level) {
+    return isLeq(static_cast<LoggingLevel>(
+                     sLoggingLevel.load(std::memory_order_relaxed)),
+                 level);
 }
 
 void Logging::mute() { setLevel(LoggingLevel::Off); }
 
 void Logging::unmute() { setLevel(LoggingLevel::All); }
 
+void Logging::setAsync(bool isAsync) {
+    if (isAsync) {
+        startSink();
+        sIsAsync = true;
+    } else {
+        sIsAsync = false;
+        stopSink();
+        drain();
+    }
+}
+
+bool Logging::isAsync() { return sIsAsync; }
+
+void Logging::flush() { drain(); }
+
 }  // namespace jet
@@ -0,0 +1,182 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <semi_lagrangian_helpers.h>
+#include <jet/array_samplers2.h>
+#include <jet/mac_cormack_advection2.h>
+#include <jet/parallel.h>
+#include <algorithm>
+
+using namespace jet;
+
+namespace {
+
+inline double elementMin(double a, double b) { return std::min(a, b); }
+
+inline double elementMax(double a, double b) { return std::max(a, b); }
+
+inline Vector2D elementMin(const Vector2D& a, const Vector2D& b) {
+    return min(a, b);
+}
+
+inline Vector2D elementMax(const Vector2D& a, const Vector2D& b) {
+    return max(a, b);
+}
+
+// Linearly interpolates the data at \p pt, and stores the element-wise min
+// and max of the data points used for the interpolation.
+template <typename T>
+T sampleWithBounds(const ConstArrayAccessor2<T>& data,
+                   const Vector2D& gridSpacing, const Vector2D& origin,
+                   const Vector2D& pt, T* lower, T* upper) {
+    ssize_t i, j;
+    double fx, fy;
+
+    const Vector2D normalizedX = (pt - origin) / gridSpacing;
+
+    const ssize_t iSize = static_cast<ssize_t>(data.size().x);
+    const ssize_t jSize = static_cast<ssize_t>(data.size().y);
+
+    getBarycentric(normalizedX.x, 0, iSize - 1, &i, &fx);
+    getBarycentric(normalizedX.y, 0, jSize - 1, &j, &fy);
+
+    const ssize_t ip1 = std::min(i + 1, iSize - 1);
+    const ssize_t jp1 = std::min(j + 1, jSize - 1);
+
+    const T values[4] = {data(i, j), data(ip1, j), data(i, jp1),
+                         data(ip1, jp1)};
+
+    T minValue = values[0];
+    T maxValue = values[0];
+    for (int n = 1; n < 4; ++n) {
+        minValue = elementMin(minValue, values[n]);
+        maxValue = elementMax(maxValue, values[n]);
+    }
+    *lower = minValue;
+    *upper = maxValue;
+
+    return bilerp(values[0], values[1], values[2], values[3], fx, fy);
+}
+
+// Advects the data points of a single array. Both the input and the output
+// arrays are described by the data and the position of the first element.
+template <typename T>
+void advectArray(const ConstArrayAccessor2<T>& input,
+                 const Vector2D& inputGridSpacing,
+                 const Vector2D& inputOrigin, const FlowSampler2& flow,
+                 const BoundarySampler2& boundarySdf, double dt, double h,
+                 bool isClamping, const Vector2D& outputGridSpacing,
+                 const Vector2D& outputOrigin, ArrayAccessor2<T> output,
+                 Array2<T>* forward, Array2<T>* lower, Array2<T>* upper) {
+    const Size2 size = output.size();
+    forward->resize(size);
+    lower->resize(size);
+    upper->resize(size);
+
+    LinearArraySampler2<T, double> inputSampler(input, inputGridSpacing,
+                                                inputOrigin);
+    auto forwardAcc = forward->accessor();
+    auto lowerAcc = lower->accessor();
+    auto upperAcc = upper->accessor();
+
+    // Forward semi-Lagrangian step. The points inside the boundary keep the
+    // input so the backward step near the boundary interpolates valid data.
+    parallelFor(kZeroSize, size.x, kZeroSize, size.y, [&](size_t i,
+                                                          size_t j) {
+        const Vector2D pt = outputOrigin + outputGridSpacing * Vector2D(i, j);
+        if (boundarySdf(pt) > 0.0) {
+            const Vector2D departure = backTrace(flow, dt, h, pt, boundarySdf);
+            forwardAcc(i, j) =
+                sampleWithBounds(input, inputGridSpacing, inputOrigin,
+                                 departure, &lowerAcc(i, j), &upperAcc(i, j));
+        } else {
+            forwardAcc(i, j) = inputSampler(pt);
+        }
+    });
+
+    // Backward step from the forward result, and the error correction.
+    LinearArraySampler2<T, double> forwardSampler(
+        forward->constAccessor(), outputGridSpacing, outputOrigin);
+    parallelFor(kZeroSize, size.x, kZeroSize, size.y, [&](size_t i,
+                                                          size_t j) {
+        const Vector2D pt = outputOrigin + outputGridSpacing * Vector2D(i, j);
+        if (boundarySdf(pt) > 0.0) {
+            const Vector2D arrival = backTrace(flow, -dt, h, pt, boundarySdf);
+            const T error = inputSampler(pt) - forwardSampler(arrival);
+            T result = forwardAcc(i, j) + 0.5 * error;
+            if (isClamping) {
+                result = elementMax(lowerAcc(i, j),
+                                    elementMin(result, upperAcc(i, j)));
+            }
+            output(i, j) = result;
+        }
+    });
+}
+
+double minGridSpacing(const Vector2D& gridSpacing) {
+    return std::min(gridSpacing.x, gridSpacing.y);
+}
+
+}  // namespace
+
+MacCormackAdvection2::MacCormackAdvection2() {}
+
+void MacCormackAdvection2::advect(const ScalarGrid2& input,
+                                  const VectorField2& flow, double dt,
+                                  ScalarGrid2* output,
+                                  const ScalarField2& boundarySdf) {
+    FlowSampler2 flowSampler(flow);
+    BoundarySampler2 boundarySampler(boundarySdf);
+    const double h = minGridSpacing(output->gridSpacing());
+
+    advectArray(input.constDataAccessor(), input.gridSpacing(),
+                input.dataOrigin(), flowSampler, boundarySampler, dt, h,
+                _isClamping, output->gridSpacing(), output->dataOrigin(),
+                output->dataAccessor(), &_scalarStep.values,
+                &_scalarStep.lower, &_scalarStep.upper);
+}
+
+void MacCormackAdvection2::advect(const CollocatedVectorGrid2& input,
+                                  const VectorField2& flow, double dt,
+                                  CollocatedVectorGrid2* output,
+                                  const ScalarField2& boundarySdf) {
+    FlowSampler2 flowSampler(flow);
+    BoundarySampler2 boundarySampler(boundarySdf);
+    const double h = minGridSpacing(output->gridSpacing());
+
+    advectArray(input.constDataAccessor(), input.gridSpacing(),
+                input.dataOrigin(), flowSampler, boundarySampler, dt, h,
+                _isClamping, output->gridSpacing(), output->dataOrigin(),
+                output->dataAccessor(), &_vectorStep.values,
+                &_vectorStep.lower, &_vectorStep.upper);
+}
+
+void MacCormackAdvection2::advect(const FaceCenteredGrid2& input,
+                                  const VectorField2& flow, double dt,
+                                  FaceCenteredGrid2* output,
+                                  const ScalarField2& boundarySdf) {
+    FlowSampler2 flowSampler(flow);
+    BoundarySampler2 boundarySampler(boundarySdf);
+    const double h = minGridSpacing(output->gridSpacing());
+
+    advectArray(input.uConstAccessor(), input.gridSpacing(), input.uOrigin(),
+                flowSampler, boundarySampler, dt, h, _isClamping,
+                output->gridSpacing(), output->uOrigin(),
+                output->uAccessor(), &_uStep.values, &_uStep.lower,
+                &_uStep.upper);
+    advectArray(input.vConstAccessor(), input.gridSpacing(), input.vOrigin(),
+                flowSampler, boundarySampler, dt, h, _isClamping,
+                output->gridSpacing(), output->vOrigin(),
+                output->vAccessor(), &_vStep.values, &_vStep.lower,
+                &_vStep.upper);
+}
+
+bool MacCormackAdvection2::isClamping() const { return _isClamping; }
+
+void MacCormackAdvection2::setIsClamping(bool isClamping) {
+    _isClamping = isClamping;
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <semi_lagrangian_helpers.h>
+#include <jet/array_samplers3.h>
+#include <jet/mac_cormack_advection3.h>
+#include <jet/parallel.h>
+#include <algorithm>
+
+using namespace jet;
+
+namespace {
+
+inline double elementMin(double a, double b) { return std::min(a, b); }
+
+inline double elementMax(double a, double b) { return std::max(a, b); }
+
+inline Vector3D elementMin(const Vector3D& a, const Vector3D& b) {
+    return min(a, b);
+}
+
+inline Vector3D elementMax(const Vector3D& a, const Vector3D& b) {
+    return max(a, b);
+}
+
+// Linearly interpolates the data at \p pt, and stores the element-wise min
+// and max of the data points used for the interpolation.
+template <typename T>
+T sampleWithBounds(const ConstArrayAccessor3<T>& data,
+                   const Vector3D& gridSpacing, const Vector3D& origin,
+                   const Vector3D& pt, T* lower, T* upper) {
+    ssize_t i, j, k;
+    double fx, fy, fz;
+
+    const Vector3D normalizedX = (pt - origin) / gridSpacing;
+
+    const ssize_t iSize = static_cast<ssize_t>(data.size().x);
+    const ssize_t jSize = static_cast<ssize_t>(data.size().y);
+    const ssize_t kSize = static_cast<ssize_t>(data.size().z);
+
+    getBarycentric(normalizedX.x, 0, iSize - 1, &i, &fx);
+    getBarycentric(normalizedX.y, 0, jSize - 1, &j, &fy);
+    getBarycentric(normalizedX.z, 0, kSize - 1, &k, &fz);
+
+    const ssize_t ip1 = std::min(i + 1, iSize - 1);
+    const ssize_t jp1 = std::min(j + 1, jSize - 1);
+    const ssize_t kp1 = std::min(k + 1, kSize - 1);
+
+    const T values[8] = {data(i, j, k),     data(ip1, j, k),
+                         data(i, jp1, k),   data(ip1, jp1, k),
+                         data(i, j, kp1),   data(ip1, j, kp1),
+                         data(i, jp1, kp1), data(ip1, jp1, kp1)};
+
+    T minValue = values[0];
+    T maxValue = values[0];
+    for (int n = 1; n < 8; ++n) {
+        minValue = elementMin(minValue, values[n]);
+        maxValue = elementMax(maxValue, values[n]);
+    }
+    *lower = minValue;
+    *upper = maxValue;
+
+    return trilerp(values[0], values[1], values[2], values[3], values[4],
+                   values[5], values[6], values[7], fx, fy, fz);
+}
+
+// Advects the data points of a single array. Both the input and the output
+// arrays are described by the data and the position of the first element.
+template <typename T>
+void advectArray(const ConstArrayAccessor3<T>& input,
+                 const Vector3D& inputGridSpacing,
+                 const Vector3D& inputOrigin, const FlowSampler3& flow,
+                 const BoundarySampler3& boundarySdf, double dt, double h,
+                 bool isClamping, const Vector3D& outputGridSpacing,
+                 const Vector3D& outputOrigin, ArrayAccessor3<T> output,
+                 Array3<T>* forward, Array3<T>* lower, Array3<T>* upper) {
+    const Size3 size = output.size();
+    forward->resize(size);
+    lower->resize(size);
+    upper->resize(size);
+
+    LinearArraySampler3<T, double> inputSampler(input, inputGridSpacing,
+                                                inputOrigin);
+    auto forwardAcc = forward->accessor();
+    auto lowerAcc = lower->accessor();
+    auto upperAcc = upper->accessor();
+
+    // Forward semi-Lagrangian step. The points inside the boundary keep the
+    // input so the backward step near the boundary interpolates valid data.
+    parallelFor(kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+                [&](size_t i, size_t j, size_t k) {
+                    const Vector3D pt =
+                        outputOrigin + outputGridSpacing * Vector3D(i, j, k);
+                    if (boundarySdf(pt) > 0.0) {
+                        const Vector3D departure =
+                            backTrace(flow, dt, h, pt, boundarySdf);
+                        forwardAcc(i, j, k) = sampleWithBounds(
+                            input, inputGridSpacing, inputOrigin, departure,
+                            &lowerAcc(i, j, k), &upperAcc(i, j, k));
+                    } else {
+                        forwardAcc(i, j, k) = inputSampler(pt);
+                    }
+                });
+
+    // Backward step from the forward result, and the error correction.
+    LinearArraySampler3<T, double> forwardSampler(
+        forward->constAccessor(), outputGridSpacing, outputOrigin);
+    parallelFor(kZeroSize, size.x, kZeroSize, size.y, kZeroSize, size.z,
+                [&](size_t i, size_t j, size_t k) {
+                    const Vector3D pt =
+                        outputOrigin + outputGridSpacing * Vector3D(i, j, k);
+                    if (boundarySdf(pt) > 0.0) {
+                        const Vector3D arrival =
+                            backTrace(flow, -dt, h, pt, boundarySdf);
+                        const T error =
+                            inputSampler(pt) - forwardSampler(arrival);
+                        T result = forwardAcc(i, j, k) + 0.5 * error;
+                        if (isClamping) {
+                            result = elementMax(
+                                lowerAcc(i, j, k),
+                                elementMin(result, upperAcc(i, j, k)));
+                        }
+                        output(i, j, k) = result;
+                    }
+                });
+}
+
+double minGridSpacing(const Vector3D& gridSpacing) {
+    return min3(gridSpacing.x, gridSpacing.y, gridSpacing.z);
+}
+
+}  // namespace
+
+MacCormackAdvection3::MacCormackAdvection3() {}
+
+void MacCormackAdvection3::advect(const ScalarGrid3& input,
+                                  const VectorField3& flow, double dt,
+                                  ScalarGrid3* output,
+                                  const ScalarField3& boundarySdf) {
+    FlowSampler3 flowSampler(flow);
+    BoundarySampler3 boundarySampler(boundarySdf);
+    const double h = minGridSpacing(output->gridSpacing());
+
+    advectArray(input.constDataAccessor(), input.gridSpacing(),
+                input.dataOrigin(), flowSampler, boundarySampler, dt, h,
+                _isClamping, output->gridSpacing(), output->dataOrigin(),
+                output->dataAccessor(), &_scalarStep.values,
+                &_scalarStep.lower, &_scalarStep.upper);
+}
+
+void MacCormackAdvection3::advect(const CollocatedVectorGrid3& input,
+                                  const VectorField3& flow, double dt,
+                                  CollocatedVectorGrid3* output,
+                                  const ScalarField3& boundarySdf) {
+    FlowSampler3 flowSampler(flow);
+    BoundarySampler3 boundarySampler(boundarySdf);
+    const double h = minGridSpacing(output->gridSpacing());
+
+    advectArray(input.constDataAccessor(), input.gridSpacing(),
+                input.dataOrigin(), flowSampler, boundarySampler, dt, h,
+                _isClamping, output->gridSpacing(), output->dataOrigin(),
+                output->dataAccessor(), &_vectorStep.values,
+                &_vectorStep.lower, &_vectorStep.upper);
+}
+
+void MacCormackAdvection3::advect(const FaceCenteredGrid3& input,
+                                  const VectorField3& flow, double dt,
+                                  FaceCenteredGrid3* output,
+                                  const ScalarField3& boundarySdf) {
+    FlowSampler3 flowSampler(flow);
+    BoundarySampler3 boundarySampler(boundarySdf);
+    const double h = minGridSpacing(output->gridSpacing());
+
+    advectArray(input.uConstAccessor(), input.gridSpacing(), input.uOrigin(),
+                flowSampler, boundarySampler, dt, h, _isClamping,
+                output->gridSpacing(), output->uOrigin(),
+                output->uAccessor(), &_uStep.values, &_uStep.lower,
+                &_uStep.upper);
+    advectArray(input.vConstAccessor(), input.gridSpacing(), input.vOrigin(),
+                flowSampler, boundarySampler, dt, h, _isClamping,
+                output->gridSpacing(), output->vOrigin(),
+                output->vAccessor(), &_vStep.values, &_vStep.lower,
+                &_vStep.upper);
+    advectArray(input.wConstAccessor(), input.gridSpacing(), input.wOrigin(),
+                flowSampler, boundarySampler, dt, h, _isClamping,
+                output->gridSpacing(), output->wOrigin(),
+                output->wAccessor(), &_wStep.values, &_wStep.lower,
+                &_wStep.upper);
+}
+
+bool MacCormackAdvection3::isClamping() const { return _isClamping; }
+
+void MacCormackAdvection3::setIsClamping(bool isClamping) {
+    _isClamping = isClamping;
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_NARROW_BAND_HELPERS_H_
+#define SRC_JET_NARROW_BAND_HELPERS_H_
+
+#include <jet/array_accessor3.h>
+#include <jet/constants.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+#include <jet/point3.h>
+
+#include <cmath>
+#include <vector>
+
+namespace jet {
+
+// Collects the data points whose |sdf| is less than or equal to \p bandWidth
+// in i-first, j-next, k-last order. The slices are scanned in parallel.
+inline void findNarrowBand(const ConstArrayAccessor3<double>& sdf,
+                           double bandWidth, std::vector<Point3UI>* band) {
+    const Size3 size = sdf.size();
+
+    std::vector<std::vector<Point3UI>> slices(size.z);
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
+        for (size_t j = 0; j < size.y; ++j) {
+            for (size_t i = 0; i < size.x; ++i) {
+                if (std::fabs(sdf(i, j, k)) <= bandWidth) {
+                    slices[k].push_back(Point3UI(i, j, k));
+                }
+            }
+        }
+    });
+
+    size_t numberOfPoints = 0;
+    for (const auto& slice : slices) {
+        numberOfPoints += slice.size();
+    }
+
+    band->clear();
+    band->reserve(numberOfPoints);
+    for (const auto& slice : slices) {
+        band->insert(band->end(), slice.begin(), slice.end());
+    }
+}
+
+// Clamps the level set value to the band.
+inline double clampToNarrowBand(double phi, double bandWidth) {
+    return clamp(phi, -bandWidth, bandWidth);
+}
+
+}  // namespace jet
+
+#endif  // SRC_JET_NARROW_BAND_HELPERS_H_
@@ -0,0 +1,63 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <jet/neighbor_lists.h>
+
+using namespace jet;
+
+NeighborLists::NeighborLists() {
+}
+
+size_t NeighborLists::size() const {
+    return _offsets.empty() ? 0 : _offsets.size() - 1;
+}
+
+bool NeighborLists::empty() const {
+    return size() == 0;
+}
+
+size_t NeighborLists::numberOfNeighbors() const {
+    return _indices.size();
+}
+
+size_t NeighborLists::numberOfNeighbors(size_t i) const {
+    JET_ASSERT(i < size());
+    return _offsets[i + 1] - _offsets[i];
+}
+
+ConstArrayAccessor1<uint32_t> NeighborLists::operator[](size_t i) const {
+    JET_ASSERT(i < size());
+    return ConstArrayAccessor1<uint32_t>(
+        _offsets[i + 1] - _offsets[i], _indices.data() + _offsets[i]);
+}
+
+const std::vector<size_t>& NeighborLists::offsets() const {
+    return _offsets;
+}
+
+const std::vector<uint32_t>& NeighborLists::indices() const {
+    return _indices;
+}
+
+void NeighborLists::clear() {
+    _offsets.clear();
+    _indices.clear();
+}
+
+void NeighborLists::set(
+    const std::vector<size_t>& offsets,
+    const std::vector<uint32_t>& indices) {
+    if (offsets.empty()) {
+        JET_THROW_INVALID_ARG_IF(!indices.empty());
+    } else {
+        JET_THROW_INVALID_ARG_IF(offsets.front() != 0);
+        JET_THROW_INVALID_ARG_IF(offsets.back() != indices.size());
+    }
+
+    _offsets = offsets;
+    _indices = indices;
+}
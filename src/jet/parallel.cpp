@@ -4,10 +4,12 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <thread_pool.h>
 #include <jet/parallel.h>
 
 #include <memory>
 #include <thread>
+#include <utility>
 
 #if defined(JET_TASKING_TBB)
 # include <tbb/task_arena.h>
@@ -31,10 +33,26 @@ void setMaxNumberOfThreads(unsigned int numThreads) {
     }
 #elif defined(JET_TASKING_OPENMP)
     omp_set_num_threads(numThreads);
+#elif defined(JET_TASKING_CPP11THREADS)
+    // The calling thread also runs the tasks, so one less worker is needed
+    ThreadPool::instance().resize(std::max(numThreads, 1u) - 1u);
 #endif
     sMaxNumberOfThreads = std::max(numThreads, 1u);
 }
 
 unsigned int maxNumberOfThreads() { return sMaxNumberOfThreads; }
 
+namespace internal {
+
+void runChunks(size_t numberOfChunks,
+               const std::function<void(size_t)>& func) {
+    ThreadPool::instance().run(numberOfChunks, func);
+}
+
+void submitTask(std::function<void()> task) {
+    ThreadPool::instance().submit(std::move(task));
+}
+
+}  // namespace internal
+
 }  // namespace jet
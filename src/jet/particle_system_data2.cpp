@@ -17,7 +17,7 @@
 #include <jet/parallel.h>
 #include <jet/particle_system_data2.h>
 #include <jet/point_parallel_hash_grid_searcher2.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
 
 #include <algorithm>
 #include <vector>
@@ -26,6 +26,27 @@ using namespace jet;
 
 static const size_t kDefaultHashGridResolution = 64;
 
+namespace {
+
+// Enumerates the neighbor pairs, excluding the self pairs, for
+// NeighborLists::build.
+struct NeighborPairEnumerator {
+    const ParticleSystemData2* particles;
+    double radius;
+
+    template <typename Visitor>
+    void operator()(const Visitor& visit) const {
+        particles->parallelForEachNearbyPoint(
+            radius, [&](size_t i, size_t j, const Vector2D&) {
+                if (i != j) {
+                    visit(i, j);
+                }
+            });
+    }
+};
+
+}  // namespace
+
 ParticleSystemData2::ParticleSystemData2()
 : ParticleSystemData2(0) {
 }
@@ -40,6 +61,7 @@ ParticleSystemData2::ParticleSystemData2(size_t numberOfParticles) {
         kDefaultHashGridResolution,
         kDefaultHashGridResolution,
         2.0 * _radius);
+    onNeighborSearcherChanged();
 
     resize(numberOfParticles);
 }
@@ -197,15 +219,15 @@ const PointNeighborSearcher2Ptr& ParticleSystemData2::neighborSearcher() const {
 void ParticleSystemData2::setNeighborSearcher(
     const PointNeighborSearcher2Ptr& newNeighborSearcher) {
     _neighborSearcher = newNeighborSearcher;
+    onNeighborSearcherChanged();
 }
 
-const std::vector<std::vector<size_t>>&
-ParticleSystemData2::neighborLists() const {
+const NeighborLists& ParticleSystemData2::neighborLists() const {
     return _neighborLists;
 }
 
 void ParticleSystemData2::buildNeighborSearcher(double maxSearchRadius) {
-    Timer timer;
+    JET_PROFILE_SCOPE("ParticleSystemData2::buildNeighborSearcher");
 
     // Use PointParallelHashGridSearcher2 by default
     _neighborSearcher = std::make_shared<PointParallelHashGridSearcher2>(
@@ -214,35 +236,95 @@ void ParticleSystemData2::buildNeighborSearcher(double maxSearchRadius) {
         2.0 * maxSearchRadius);
 
     _neighborSearcher->build(positions());
-
-    JET_INFO << "Building neighbor searcher took: "
-             << timer.durationInSeconds()
-             << " seconds";
+    onNeighborSearcherChanged();
 }
 
 void ParticleSystemData2::buildNeighborLists(double maxSearchRadius) {
-    Timer timer;
+    JET_PROFILE_SCOPE("ParticleSystemData2::buildNeighborLists");
 
-    _neighborLists.resize(numberOfParticles());
+    _neighborLists.build(
+        numberOfParticles(),
+        NeighborPairEnumerator{this, maxSearchRadius});
 
-    auto points = positions();
-    for (size_t i = 0; i < numberOfParticles(); ++i) {
-        Vector2D origin = points[i];
-        _neighborLists[i].clear();
+    updateSoaLayout();
+}
 
-        _neighborSearcher->forEachNearbyPoint(
-            origin,
-            maxSearchRadius,
-            [&](size_t j, const Vector2D&) {
-                if (i != j) {
-                    _neighborLists[i].push_back(j);
-                }
-            });
+void ParticleSystemData2::reorderParticles(const std::vector<size_t>& order) {
+    JET_THROW_INVALID_ARG_IF(order.size() != numberOfParticles());
+
+    for (auto& attr : _scalarDataList) {
+        ScalarData temp(attr);
+        parallelFor(kZeroSize, order.size(), [&](size_t i) {
+            attr[i] = temp[order[i]];
+        });
+    }
+
+    for (auto& attr : _vectorDataList) {
+        VectorData temp(attr);
+        parallelFor(kZeroSize, order.size(), [&](size_t i) {
+            attr[i] = temp[order[i]];
+        });
+    }
+
+    _lastParticleOrder = order;
+
+    // Indices in the searcher and the lists refer to the old order
+    _neighborSearcher->build(positions());
+    _neighborLists.clear();
+    updateSoaLayout();
+}
+
+void ParticleSystemData2::sortParticles() {
+    JET_PROFILE_SCOPE("ParticleSystemData2::sortParticles");
+
+    const PointParallelHashGridSearcher2* searcher = _parallelHashGridSearcher;
+    PointParallelHashGridSearcher2Ptr tempSearcher;
+
+    if (searcher == nullptr
+        || searcher->sortedIndices().size() != numberOfParticles()) {
+        tempSearcher = std::make_shared<PointParallelHashGridSearcher2>(
+        kDefaultHashGridResolution,
+        kDefaultHashGridResolution,
+        2.0 * _radius);
+        tempSearcher->build(positions());
+        searcher = tempSearcher.get();
+    }
+
+    reorderParticles(searcher->sortedIndices());
+}
+
+const std::vector<size_t>& ParticleSystemData2::lastParticleOrder() const {
+    return _lastParticleOrder;
+}
+
+bool ParticleSystemData2::isUsingSoaLayout() const {
+    return _isUsingSoaLayout;
+}
+
+void ParticleSystemData2::setIsUsingSoaLayout(bool isUsing) {
+    _isUsingSoaLayout = isUsing;
+
+    if (_isUsingSoaLayout) {
+        updateSoaLayout();
+    } else {
+        _soaPositions = SoaVectorArray2();
+        _soaVelocities = SoaVectorArray2();
     }
+}
 
-    JET_INFO << "Building neighbor list took: "
-             << timer.durationInSeconds()
-             << " seconds";
+const SoaVectorArray2& ParticleSystemData2::soaPositions() const {
+    return _soaPositions;
+}
+
+const SoaVectorArray2& ParticleSystemData2::soaVelocities() const {
+    return _soaVelocities;
+}
+
+void ParticleSystemData2::updateSoaLayout() {
+    if (_isUsingSoaLayout) {
+        _soaPositions.set(positions());
+        _soaVelocities.set(velocities());
+    }
 }
 
 void ParticleSystemData2::serialize(std::vector<uint8_t>* buffer) const {
@@ -282,7 +364,11 @@ void ParticleSystemData2::set(const ParticleSystemData2& other) {
     }
 
     _neighborSearcher = other._neighborSearcher->clone();
+    onNeighborSearcherChanged();
     _neighborLists = other._neighborLists;
+    _isUsingSoaLayout = other._isUsingSoaLayout;
+    _soaPositions = other._soaPositions;
+    _soaVelocities = other._soaVelocities;
 }
 
 ParticleSystemData2& ParticleSystemData2::operator=(
@@ -291,6 +377,11 @@ ParticleSystemData2& ParticleSystemData2::operator=(
     return *this;
 }
 
+void ParticleSystemData2::onNeighborSearcherChanged() {
+    _parallelHashGridSearcher
+        = dynamic_cast<const PointParallelHashGridSearcher2*>(_neighborSearcher.get());
+}
+
 void ParticleSystemData2::serializeParticleSystemData(
     flatbuffers::FlatBufferBuilder* builder,
     flatbuffers::Offset<fbs::ParticleSystemData2>* fbsParticleSystemData)
@@ -333,17 +424,13 @@ void ParticleSystemData2::serializeParticleSystemData(
             neighborSearcherSerialized.size()));
 
     // Copy neighbor lists
-    std::vector<flatbuffers::Offset<fbs::ParticleNeighborList2>> neighborLists;
-    for (const auto& neighbors : _neighborLists) {
-        std::vector<uint64_t> neighbors64(neighbors.begin(), neighbors.end());
-        flatbuffers::Offset<fbs::ParticleNeighborList2> fbsNeighborList
-            = fbs::CreateParticleNeighborList2(
-                *builder,
-                builder->CreateVector(neighbors64.data(), neighbors64.size()));
-        neighborLists.push_back(fbsNeighborList);
-    }
-
-    auto fbsNeighborLists = builder->CreateVector(neighborLists);
+    const auto& offsets = _neighborLists.offsets();
+    std::vector<uint64_t> offsets64(offsets.begin(), offsets.end());
+    const auto& indices = _neighborLists.indices();
+    auto fbsNeighborLists = fbs::CreateParticleNeighborList2(
+        *builder,
+        builder->CreateVector(offsets64.data(), offsets64.size()),
+        builder->CreateVector(indices.data(), indices.size()));
 
     // Copy the searcher
     *fbsParticleSystemData = fbs::CreateParticleSystemData2(
@@ -407,19 +494,20 @@ void ParticleSystemData2::deserializeParticleSystemData(
         fbsNeighborSearcher->data()->begin(),
         fbsNeighborSearcher->data()->end());
     _neighborSearcher->deserialize(neighborSearcherSerialized);
+    onNeighborSearcherChanged();
 
     // Copy neighbor list
     auto fbsNeighborLists = fbsParticleSystemData->neighborLists();
-    _neighborLists.resize(fbsNeighborLists->size());
-    for (uint32_t i = 0; i < fbsNeighborLists->size(); ++i) {
-        auto fbsNeighborList = fbsNeighborLists->Get(i);
-        _neighborLists[i].resize(fbsNeighborList->data()->size());
-        std::transform(
-            fbsNeighborList->data()->begin(),
-            fbsNeighborList->data()->end(),
-            _neighborLists[i].begin(),
-            [] (uint64_t val) {
-                return static_cast<size_t>(val);
-            });
-    }
+    std::vector<size_t> offsets(fbsNeighborLists->offsets()->size());
+    std::transform(
+        fbsNeighborLists->offsets()->begin(),
+        fbsNeighborLists->offsets()->end(),
+        offsets.begin(),
+        [](uint64_t val) {
+        return static_cast<size_t>(val);
+    });
+    std::vector<uint32_t> indices(
+        fbsNeighborLists->indices()->begin(),
+        fbsNeighborLists->indices()->end());
+    _neighborLists.set(offsets, indices);
 }
@@ -17,7 +17,7 @@
 #include <jet/parallel.h>
 #include <jet/particle_system_data3.h>
 #include <jet/point_parallel_hash_grid_searcher3.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
 
 #include <algorithm>
 #include <vector>
@@ -26,6 +26,27 @@ using namespace jet;
 
 static const size_t kDefaultHashGridResolution = 64;
 
+namespace {
+
+// Enumerates the neighbor pairs, excluding the self pairs, for
+// NeighborLists::build.
+struct NeighborPairEnumerator {
+    const ParticleSystemData3* particles;
+    double radius;
+
+    template <typename Visitor>
+    void operator()(const Visitor& visit) const {
+        particles->parallelForEachNearbyPoint(
+            radius, [&](size_t i, size_t j, const Vector3D&) {
+                if (i != j) {
+                    visit(i, j);
+                }
+            });
+    }
+};
+
+}  // namespace
+
 ParticleSystemData3::ParticleSystemData3()
 : ParticleSystemData3(0) {
 }
@@ -41,6 +62,7 @@ ParticleSystemData3::ParticleSystemData3(size_t numberOfParticles) {
         kDefaultHashGridResolution,
         kDefaultHashGridResolution,
         2.0 * _radius);
+    onNeighborSearcherChanged();
 
     resize(numberOfParticles);
 }
@@ -198,15 +220,15 @@ const PointNeighborSearcher3Ptr& ParticleSystemData3::neighborSearcher() const {
 void ParticleSystemData3::setNeighborSearcher(
     const PointNeighborSearcher3Ptr& newNeighborSearcher) {
     _neighborSearcher = newNeighborSearcher;
+    onNeighborSearcherChanged();
 }
 
-const std::vector<std::vector<size_t>>&
-ParticleSystemData3::neighborLists() const {
+const NeighborLists& ParticleSystemData3::neighborLists() const {
     return _neighborLists;
 }
 
 void ParticleSystemData3::buildNeighborSearcher(double maxSearchRadius) {
-    Timer timer;
+    JET_PROFILE_SCOPE("ParticleSystemData3::buildNeighborSearcher");
 
     // Use PointParallelHashGridSearcher3 by default
     _neighborSearcher = std::make_shared<PointParallelHashGridSearcher3>(
@@ -216,35 +238,96 @@ void ParticleSystemData3::buildNeighborSearcher(double maxSearchRadius) {
         2.0 * maxSearchRadius);
 
     _neighborSearcher->build(positions());
-
-    JET_INFO << "Building neighbor searcher took: "
-             << timer.durationInSeconds()
-             << " seconds";
+    onNeighborSearcherChanged();
 }
 
 void ParticleSystemData3::buildNeighborLists(double maxSearchRadius) {
-    Timer timer;
+    JET_PROFILE_SCOPE("ParticleSystemData3::buildNeighborLists");
 
-    _neighborLists.resize(numberOfParticles());
+    _neighborLists.build(
+        numberOfParticles(),
+        NeighborPairEnumerator{this, maxSearchRadius});
 
-    auto points = positions();
-    for (size_t i = 0; i < numberOfParticles(); ++i) {
-        Vector3D origin = points[i];
-        _neighborLists[i].clear();
+    updateSoaLayout();
+}
 
-        _neighborSearcher->forEachNearbyPoint(
-            origin,
-            maxSearchRadius,
-            [&](size_t j, const Vector3D&) {
-                if (i != j) {
-                    _neighborLists[i].push_back(j);
-                }
-            });
+void ParticleSystemData3::reorderParticles(const std::vector<size_t>& order) {
+    JET_THROW_INVALID_ARG_IF(order.size() != numberOfParticles());
+
+    for (auto& attr : _scalarDataList) {
+        ScalarData temp(attr);
+        parallelFor(kZeroSize, order.size(), [&](size_t i) {
+            attr[i] = temp[order[i]];
+        });
     }
 
-    JET_INFO << "Building neighbor list took: "
-             << timer.durationInSeconds()
-             << " seconds";
+    for (auto& attr : _vectorDataList) {
+        VectorData temp(attr);
+        parallelFor(kZeroSize, order.size(), [&](size_t i) {
+            attr[i] = temp[order[i]];
+        });
+    }
+
+    _lastParticleOrder = order;
+
+    // Indices in the searcher and the lists refer to the old order
+    _neighborSearcher->build(positions());
+    _neighborLists.clear();
+    updateSoaLayout();
+}
+
+void ParticleSystemData3::sortParticles() {
+    JET_PROFILE_SCOPE("ParticleSystemData3::sortParticles");
+
+    const PointParallelHashGridSearcher3* searcher = _parallelHashGridSearcher;
+    PointParallelHashGridSearcher3Ptr tempSearcher;
+
+    if (searcher == nullptr
+        || searcher->sortedIndices().size() != numberOfParticles()) {
+        tempSearcher = std::make_shared<PointParallelHashGridSearcher3>(
+        kDefaultHashGridResolution,
+        kDefaultHashGridResolution,
+        kDefaultHashGridResolution,
+        2.0 * _radius);
+        tempSearcher->build(positions());
+        searcher = tempSearcher.get();
+    }
+
+    reorderParticles(searcher->sortedIndices());
+}
+
+const std::vector<size_t>& ParticleSystemData3::lastParticleOrder() const {
+    return _lastParticleOrder;
+}
+
+bool ParticleSystemData3::isUsingSoaLayout() const {
+    return _isUsingSoaLayout;
+}
+
+void ParticleSystemData3::setIsUsingSoaLayout(bool isUsing) {
+    _isUsingSoaLayout = isUsing;
+
+    if (_isUsingSoaLayout) {
+        updateSoaLayout();
+    } else {
+        _soaPositions = SoaVectorArray3();
+        _soaVelocities = SoaVectorArray3();
+    }
+}
+
+const SoaVectorArray3& ParticleSystemData3::soaPositions() const {
+    return _soaPositions;
+}
+
+const SoaVectorArray3& ParticleSystemData3::soaVelocities() const {
+    return _soaVelocities;
+}
+
+void ParticleSystemData3::updateSoaLayout() {
+    if (_isUsingSoaLayout) {
+        _soaPositions.set(positions());
+        _soaVelocities.set(velocities());
+    }
 }
 
 void ParticleSystemData3::serialize(std::vector<uint8_t>* buffer) const {
@@ -284,7 +367,11 @@ void ParticleSystemData3::set(const ParticleSystemData3& other) {
     }
 
     _neighborSearcher = other._neighborSearcher->clone();
+    onNeighborSearcherChanged();
     _neighborLists = other._neighborLists;
+    _isUsingSoaLayout = other._isUsingSoaLayout;
+    _soaPositions = other._soaPositions;
+    _soaVelocities = other._soaVelocities;
 }
 
 ParticleSystemData3& ParticleSystemData3::operator=(
@@ -293,6 +380,11 @@ ParticleSystemData3& ParticleSystemData3::operator=(
     return *this;
 }
 
+void ParticleSystemData3::onNeighborSearcherChanged() {
+    _parallelHashGridSearcher
+        = dynamic_cast<const PointParallelHashGridSearcher3*>(_neighborSearcher.get());
+}
+
 void ParticleSystemData3::serializeParticleSystemData(
     flatbuffers::FlatBufferBuilder* builder,
     flatbuffers::Offset<fbs::ParticleSystemData3>* fbsParticleSystemData)
@@ -335,17 +427,13 @@ void ParticleSystemData3::serializeParticleSystemData(
             neighborSearcherSerialized.size()));
 
     // Copy neighbor lists
-    std::vector<flatbuffers::Offset<fbs::ParticleNeighborList3>> neighborLists;
-    for (const auto& neighbors : _neighborLists) {
-        std::vector<uint64_t> neighbors64(neighbors.begin(), neighbors.end());
-        flatbuffers::Offset<fbs::ParticleNeighborList3> fbsNeighborList
-            = fbs::CreateParticleNeighborList3(
-                *builder,
-                builder->CreateVector(neighbors64.data(), neighbors64.size()));
-        neighborLists.push_back(fbsNeighborList);
-    }
-
-    auto fbsNeighborLists = builder->CreateVector(neighborLists);
+    const auto& offsets = _neighborLists.offsets();
+    std::vector<uint64_t> offsets64(offsets.begin(), offsets.end());
+    const auto& indices = _neighborLists.indices();
+    auto fbsNeighborLists = fbs::CreateParticleNeighborList3(
+        *builder,
+        builder->CreateVector(offsets64.data(), offsets64.size()),
+        builder->CreateVector(indices.data(), indices.size()));
 
     // Copy the searcher
     *fbsParticleSystemData = fbs::CreateParticleSystemData3(
@@ -409,19 +497,20 @@ void ParticleSystemData3::deserializeParticleSystemData(
         fbsNeighborSearcher->data()->begin(),
         fbsNeighborSearcher->data()->end());
     _neighborSearcher->deserialize(neighborSearcherSerialized);
+    onNeighborSearcherChanged();
 
     // Copy neighbor list
     auto fbsNeighborLists = fbsParticleSystemData->neighborLists();
-    _neighborLists.resize(fbsNeighborLists->size());
-    for (uint32_t i = 0; i < fbsNeighborLists->size(); ++i) {
-        auto fbsNeighborList = fbsNeighborLists->Get(i);
-        _neighborLists[i].resize(fbsNeighborList->data()->size());
-        std::transform(
-            fbsNeighborList->data()->begin(),
-            fbsNeighborList->data()->end(),
-            _neighborLists[i].begin(),
-            [](uint64_t val) {
-            return static_cast<size_t>(val);
-        });
-    }
+    std::vector<size_t> offsets(fbsNeighborLists->offsets()->size());
+    std::transform(
+        fbsNeighborLists->offsets()->begin(),
+        fbsNeighborLists->offsets()->end(),
+        offsets.begin(),
+        [](uint64_t val) {
+        return static_cast<size_t>(val);
+    });
+    std::vector<uint32_t> indices(
+        fbsNeighborLists->indices()->begin(),
+        fbsNeighborLists->indices()->end());
+    _neighborLists.set(offsets, indices);
 }
@@ -10,7 +10,7 @@
 #include <jet/constant_vector_field3.h>
 #include <jet/parallel.h>
 #include <jet/particle_system_solver3.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
 
 #include <algorithm>
 
@@ -89,37 +89,46 @@ void ParticleSystemSolver3::setWind(const VectorField3Ptr& newWind) {
     _wind = newWind;
 }
 
+unsigned int ParticleSystemSolver3::particleSortingInterval() const {
+    return _particleSortingInterval;
+}
+
+void ParticleSystemSolver3::setParticleSortingInterval(
+    unsigned int newInterval) {
+    _particleSortingInterval = newInterval;
+}
+
 void ParticleSystemSolver3::onInitialize() {
     // When initializing the solver, update the collider and emitter state as
     // well since they also affects the initial condition of the simulation.
-    Timer timer;
-    updateCollider(0.0);
-    JET_INFO << "Update collider took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("ParticleSystemSolver3::updateCollider");
+        updateCollider(0.0);
+    }
 
-    timer.reset();
-    updateEmitter(0.0);
-    JET_INFO << "Update emitter took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("ParticleSystemSolver3::updateEmitter");
+        updateEmitter(0.0);
+    }
 }
 
 void ParticleSystemSolver3::onAdvanceTimeStep(double timeStepInSeconds) {
     beginAdvanceTimeStep(timeStepInSeconds);
 
-    Timer timer;
-    accumulateForces(timeStepInSeconds);
-    JET_INFO << "Accumulating forces took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("ParticleSystemSolver3::accumulateForces");
+        accumulateForces(timeStepInSeconds);
+    }
 
-    timer.reset();
-    timeIntegration(timeStepInSeconds);
-    JET_INFO << "Time integration took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("ParticleSystemSolver3::timeIntegration");
+        timeIntegration(timeStepInSeconds);
+    }
 
-    timer.reset();
-    resolveCollision();
-    JET_INFO << "Resolving collision took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("ParticleSystemSolver3::resolveCollision");
+        resolveCollision();
+    }
 
     endAdvanceTimeStep(timeStepInSeconds);
 }
@@ -137,15 +146,22 @@ void ParticleSystemSolver3::beginAdvanceTimeStep(double timeStepInSeconds) {
     setRange1(forces.size(), Vector3D(), &forces);
 
     // Update collider and emitter
-    Timer timer;
-    updateCollider(timeStepInSeconds);
-    JET_INFO << "Update collider took "
-             << timer.durationInSeconds() << " seconds";
-
-    timer.reset();
-    updateEmitter(timeStepInSeconds);
-    JET_INFO << "Update emitter took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("ParticleSystemSolver3::updateCollider");
+        updateCollider(timeStepInSeconds);
+    }
+
+    {
+        JET_PROFILE_SCOPE("ParticleSystemSolver3::updateEmitter");
+        updateEmitter(timeStepInSeconds);
+    }
+
+    // Sort particles for better memory locality
+    if (_particleSortingInterval > 0
+        && ++_numberOfStepsSinceSorting >= _particleSortingInterval) {
+        _particleSystemData->sortParticles();
+        _numberOfStepsSinceSorting = 0;
+    }
 
     // Allocate buffers
     size_t n = _particleSystemData->numberOfParticles();
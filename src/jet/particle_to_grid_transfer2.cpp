@@ -0,0 +1,55 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <counting_sort_helpers.h>
+#include <jet/parallel.h>
+#include <jet/particle_to_grid_transfer2.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+ParticleToGridTransfer2::ParticleToGridTransfer2() {
+}
+
+ParticleToGridTransfer2::ParticleToGridTransfer2(
+    const ParticleToGridTransfer2& other)
+: _isDeterministic(other._isDeterministic) {
+}
+
+ParticleToGridTransfer2& ParticleToGridTransfer2::operator=(
+    const ParticleToGridTransfer2& other) {
+    _isDeterministic = other._isDeterministic;
+    return *this;
+}
+
+bool ParticleToGridTransfer2::isDeterministic() const {
+    return _isDeterministic;
+}
+
+void ParticleToGridTransfer2::setIsDeterministic(bool isDeterministic) {
+    _isDeterministic = isDeterministic;
+}
+
+void ParticleToGridTransfer2::buildBuckets(const Size2& resolution) {
+    const size_t numberOfParticles = _keys.size();
+    const size_t numberOfBuckets = resolution.x * resolution.y;
+
+    if (_bucketCountsCapacity < numberOfBuckets) {
+        _bucketCounts.reset(new std::atomic<size_t>[numberOfBuckets]);
+        _bucketCountsCapacity = numberOfBuckets;
+    }
+
+    // The sorted buckets make the accumulation order independent of thread
+    // scheduling.
+    _slots.resize(numberOfParticles);
+    _bucketStarts.resize(numberOfBuckets + 1);
+    _sortedIndices.resize(numberOfParticles);
+    parallelCountingSort(_keys.data(), numberOfParticles, numberOfBuckets,
+                         _bucketCounts.get(), _slots.data(),
+                         _bucketStarts.data(), _sortedIndices.data());
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <counting_sort_helpers.h>
+#include <jet/parallel.h>
+#include <jet/particle_to_grid_transfer3.h>
+
+#include <algorithm>
+
+using namespace jet;
+
+ParticleToGridTransfer3::ParticleToGridTransfer3() {
+}
+
+ParticleToGridTransfer3::ParticleToGridTransfer3(
+    const ParticleToGridTransfer3& other)
+: _isDeterministic(other._isDeterministic) {
+}
+
+ParticleToGridTransfer3& ParticleToGridTransfer3::operator=(
+    const ParticleToGridTransfer3& other) {
+    _isDeterministic = other._isDeterministic;
+    return *this;
+}
+
+bool ParticleToGridTransfer3::isDeterministic() const {
+    return _isDeterministic;
+}
+
+void ParticleToGridTransfer3::setIsDeterministic(bool isDeterministic) {
+    _isDeterministic = isDeterministic;
+}
+
+void ParticleToGridTransfer3::buildBuckets(const Size3& resolution) {
+    const size_t numberOfParticles = _keys.size();
+    const size_t numberOfBuckets = resolution.x * resolution.y * resolution.z;
+
+    if (_bucketCountsCapacity < numberOfBuckets) {
+        _bucketCounts.reset(new std::atomic<size_t>[numberOfBuckets]);
+        _bucketCountsCapacity = numberOfBuckets;
+    }
+
+    // The sorted buckets make the accumulation order independent of thread
+    // scheduling.
+    _slots.resize(numberOfParticles);
+    _bucketStarts.resize(numberOfBuckets + 1);
+    _sortedIndices.resize(numberOfParticles);
+    parallelCountingSort(_keys.data(), numberOfParticles, numberOfBuckets,
+                         _bucketCounts.get(), _slots.data(),
+                         _bucketStarts.data(), _sortedIndices.data());
+}
@@ -5,9 +5,12 @@
 // property of any third parties.
 
 #include <pch.h>
+#include <sph_simd_helpers.h>
 #include <jet/bcc_lattice_point_generator.h>
 #include <jet/parallel.h>
 #include <jet/pci_sph_solver3.h>
+#include <jet/reducers.h>
+#include <jet/scratch_arena.h>
 #include <jet/sph_kernels3.h>
 
 #include <algorithm>
@@ -63,10 +66,15 @@ void PciSphSolver3::accumulatePressureForce(
     auto f = particles->forces();
 
     // Predicted density ds
-    Array1<double> ds(numberOfParticles, 0.0);
+    ScratchBuffer<double> ds =
+        ScratchArena::threadLocal().allocate<double>(numberOfParticles);
 
     SphStdKernel3 kernel(particles->kernelRadius());
 
+    // SoA copy of the predicted positions for the vectorized kernels
+    const bool isUsingSoaLayout = particles->isUsingSoaLayout();
+    SoaVectorArray3 tempSoaPositions;
+
     // Initialize buffers
     parallelFor(
         kZeroSize,
@@ -101,18 +109,27 @@ void PciSphSolver3::accumulatePressureForce(
             _tempPositions,
             _tempVelocities);
 
+        if (isUsingSoaLayout) {
+            tempSoaPositions.set(_tempPositions.constAccessor());
+        }
+
         // Compute pressure from density error
         parallelFor(
             kZeroSize,
             numberOfParticles,
             [&] (size_t i) {
                 double weightSum = 0.0;
-                const auto& neighbors = particles->neighborLists()[i];
-
-                for (size_t j : neighbors) {
-                    double dist
-                        = _tempPositions[j].distanceTo(_tempPositions[i]);
-                    weightSum += kernel(dist);
+                const auto neighbors = particles->neighborLists()[i];
+
+                if (isUsingSoaLayout) {
+                    weightSum = sumOfKernelNearby(
+                        kernel, tempSoaPositions, i, neighbors);
+                } else {
+                    for (size_t j : neighbors) {
+                        double dist
+                            = _tempPositions[j].distanceTo(_tempPositions[i]);
+                        weightSum += kernel(dist);
+                    }
                 }
                 weightSum += kernel(0);
 
@@ -136,10 +153,10 @@ void PciSphSolver3::accumulatePressureForce(
             x, ds.constAccessor(), p, _pressureForces.accessor());
 
         // Compute max density error
-        maxDensityError = 0.0;
-        for (size_t i = 0; i < numberOfParticles; ++i) {
-            maxDensityError = absmax(maxDensityError, _densityErrors[i]);
-        }
+        maxDensityError = parallelMapReduce(
+            kZeroSize, numberOfParticles,
+            [&](size_t i) { return _densityErrors[i]; },
+            AbsMaxReducer<double>());
 
         densityErrorRatio = maxDensityError / targetDensity;
         maxNumIter = k + 1;
@@ -8,7 +8,7 @@
 
 #include <jet/constants.h>
 #include <jet/physics_animation.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
 
 #include <limits>
 
@@ -87,11 +87,10 @@ void PhysicsAnimation::advanceTimeStep(double timeIntervalInSeconds) {
             JET_INFO << "Begin onAdvanceTimeStep: " << actualTimeInterval
                      << " (1/" << 1.0 / actualTimeInterval << ") seconds";
 
-            Timer timer;
-            onAdvanceTimeStep(actualTimeInterval);
-
-            JET_INFO << "End onAdvanceTimeStep (took "
-                     << timer.durationInSeconds() << " seconds)";
+            {
+                JET_PROFILE_SCOPE("PhysicsAnimation::onAdvanceTimeStep");
+                onAdvanceTimeStep(actualTimeInterval);
+            }
 
             _currentTime += actualTimeInterval;
         }
@@ -110,11 +109,10 @@ void PhysicsAnimation::advanceTimeStep(double timeIntervalInSeconds) {
             JET_INFO << "Begin onAdvanceTimeStep: " << actualTimeInterval
                      << " (1/" << 1.0 / actualTimeInterval << ") seconds";
 
-            Timer timer;
-            onAdvanceTimeStep(actualTimeInterval);
-
-            JET_INFO << "End onAdvanceTimeStep (took "
-                     << timer.durationInSeconds() << " seconds)";
+            {
+                JET_PROFILE_SCOPE("PhysicsAnimation::onAdvanceTimeStep");
+                onAdvanceTimeStep(actualTimeInterval);
+            }
 
             remainingTime -= actualTimeInterval;
             _currentTime += actualTimeInterval;
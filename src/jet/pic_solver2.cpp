@@ -10,9 +10,10 @@
 
 #include <pch.h>
 #include <jet/array_utils.h>
+#include <jet/grid_samplers2.h>
 #include <jet/level_set_utils.h>
 #include <jet/pic_solver2.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
 #include <algorithm>
 
 using namespace jet;
@@ -51,61 +52,79 @@ void PicSolver2::setParticleEmitter(const ParticleEmitter2Ptr& newEmitter) {
     newEmitter->setTarget(_particles);
 }
 
+bool PicSolver2::useDeterministicTransfer() const {
+    return _particleToGridTransfer.isDeterministic();
+}
+
+void PicSolver2::setUseDeterministicTransfer(bool onoff) {
+    _particleToGridTransfer.setIsDeterministic(onoff);
+}
+
+unsigned int PicSolver2::particleSortingInterval() const {
+    return _particleSortingInterval;
+}
+
+void PicSolver2::setParticleSortingInterval(unsigned int newInterval) {
+    _particleSortingInterval = newInterval;
+}
+
 void PicSolver2::onInitialize() {
     GridFluidSolver2::onInitialize();
 
-    Timer timer;
-    updateParticleEmitter(0.0);
-    JET_INFO << "Update particle emitter took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver2::updateParticleEmitter");
+        updateParticleEmitter(0.0);
+    }
 }
 
 void PicSolver2::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
     UNUSED_VARIABLE(timeIntervalInSeconds);
 
-    Timer timer;
-    updateParticleEmitter(timeIntervalInSeconds);
-    JET_INFO << "Update particle emitter took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver2::updateParticleEmitter");
+        updateParticleEmitter(timeIntervalInSeconds);
+    }
+
+    sortParticlesIfNeeded();
 
     JET_INFO << "Number of PIC-type particles: "
              << _particles->numberOfParticles();
 
-    timer.reset();
-    transferFromParticlesToGrids();
-    JET_INFO << "transferFromParticlesToGrids took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver2::transferFromParticlesToGrids");
+        transferFromParticlesToGrids();
+    }
 
-    timer.reset();
-    buildSignedDistanceField();
-    JET_INFO << "buildSignedDistanceField took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver2::buildSignedDistanceField");
+        buildSignedDistanceField();
+    }
 
-    timer.reset();
-    extrapolateVelocityToAir();
-    JET_INFO << "extrapolateVelocityToAir took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver2::extrapolateVelocityToAir");
+        extrapolateVelocityToAir();
+    }
 
     applyBoundaryCondition();
 }
 
 void PicSolver2::computeAdvection(double timeIntervalInSeconds) {
-    Timer timer;
-    extrapolateVelocityToAir();
-    JET_INFO << "extrapolateVelocityToAir took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver2::extrapolateVelocityToAir");
+        extrapolateVelocityToAir();
+    }
 
     applyBoundaryCondition();
 
-    timer.reset();
-    transferFromGridsToParticles();
-    JET_INFO << "transferFromGridsToParticles took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver2::transferFromGridsToParticles");
+        transferFromGridsToParticles();
+    }
 
-    timer.reset();
-    moveParticles(timeIntervalInSeconds);
-    JET_INFO << "moveParticles took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver2::moveParticles");
+        moveParticles(timeIntervalInSeconds);
+    }
 }
 
 ScalarField2Ptr PicSolver2::fluidSdf() const {
@@ -118,55 +137,34 @@ void PicSolver2::transferFromParticlesToGrids() {
     auto velocities = _particles->velocities();
     size_t numberOfParticles = _particles->numberOfParticles();
 
-    // Clear velocity to zero
-    flow->fill(Vector2D());
-
     // Weighted-average velocity
     auto u = flow->uAccessor();
     auto v = flow->vAccessor();
-    Array2<double> uWeight(u.size());
-    Array2<double> vWeight(v.size());
     _uMarkers.resize(u.size());
     _vMarkers.resize(v.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
-    LinearArraySampler2<double, double> uSampler(
-        flow->uConstAccessor(),
-        flow->gridSpacing(),
-        flow->uOrigin());
-    LinearArraySampler2<double, double> vSampler(
-        flow->vConstAccessor(),
-        flow->gridSpacing(),
-        flow->vOrigin());
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point2UI, 4> indices;
-        std::array<double, 4> weights;
-
-        uSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 4; ++j) {
-            u(indices[j]) += velocities[i].x * weights[j];
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
 
-        vSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 4; ++j) {
-            v(indices[j]) += velocities[i].y * weights[j];
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-    }
+    auto positionFunc = [&](size_t i) { return positions[i]; };
 
-    uWeight.parallelForEachIndex([&](size_t i, size_t j) {
-        if (uWeight(i, j) > 0.0) {
-            u(i, j) /= uWeight(i, j);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j) {
-        if (vWeight(i, j) > 0.0) {
-            v(i, j) /= vWeight(i, j);
-        }
-    });
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        positionFunc,
+        [&](size_t i, const Vector2D&, const Point2UI&) {
+            return velocities[i].x;
+        },
+        flow->gridSpacing(),
+        flow->uOrigin(),
+        u,
+        _uMarkers.accessor());
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        positionFunc,
+        [&](size_t i, const Vector2D&, const Point2UI&) {
+            return velocities[i].y;
+        },
+        flow->gridSpacing(),
+        flow->vOrigin(),
+        v,
+        _vMarkers.accessor());
 }
 
 void PicSolver2::transferFromGridsToParticles() {
@@ -175,8 +173,9 @@ void PicSolver2::transferFromGridsToParticles() {
     auto velocities = _particles->velocities();
     size_t numberOfParticles = _particles->numberOfParticles();
 
+    LinearGridSampler2<FaceCenteredGrid2> sampler(*flow);
     parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        velocities[i] = flow->sample(positions[i]);
+        velocities[i] = sampler(positions[i]);
     });
 }
 
@@ -254,8 +253,8 @@ void PicSolver2::extrapolateVelocityToAir() {
     auto v = vel->vAccessor();
 
     unsigned int depth = static_cast<unsigned int>(std::ceil(maxCfl()));
-    extrapolateToRegion(vel->uConstAccessor(), _uMarkers, depth, u);
-    extrapolateToRegion(vel->vConstAccessor(), _vMarkers, depth, v);
+    extrapolateToRegion(vel->uConstAccessor(), vel->vConstAccessor(),
+                        _uMarkers, _vMarkers, depth, u, v);
 }
 
 void PicSolver2::buildSignedDistanceField() {
@@ -265,11 +264,10 @@ void PicSolver2::buildSignedDistanceField() {
     double radius = 1.2 * maxH / std::sqrt(2.0);
 
     _particles->buildNeighborSearcher(2 * radius);
-    auto searcher = _particles->neighborSearcher();
     sdf->parallelForEachDataPointIndex([&] (size_t i, size_t j) {
         Vector2D pt = sdfPos(i, j);
         double minDist = 2.0 * radius;
-        searcher->forEachNearbyPoint(
+        _particles->forEachNearbyPoint(
             pt, 2.0 * radius, [&] (size_t, const Vector2D& x) {
                 minDist = std::min(minDist, pt.distanceTo(x));
             });
@@ -279,6 +277,19 @@ void PicSolver2::buildSignedDistanceField() {
     extrapolateIntoCollider(sdf.get());
 }
 
+void PicSolver2::onParticlesReordered(const std::vector<size_t>& order) {
+    UNUSED_VARIABLE(order);
+}
+
+void PicSolver2::sortParticlesIfNeeded() {
+    if (_particleSortingInterval > 0
+        && ++_numberOfStepsSinceSorting >= _particleSortingInterval) {
+        _particles->sortParticles();
+        onParticlesReordered(_particles->lastParticleOrder());
+        _numberOfStepsSinceSorting = 0;
+    }
+}
+
 void PicSolver2::updateParticleEmitter(double timeIntervalInSeconds) {
     if (_particleEmitter != nullptr) {
         _particleEmitter->update(currentTimeInSeconds(), timeIntervalInSeconds);
@@ -10,9 +10,10 @@
 
 #include <pch.h>
 #include <jet/array_utils.h>
+#include <jet/grid_samplers3.h>
 #include <jet/level_set_utils.h>
 #include <jet/pic_solver3.h>
-#include <jet/timer.h>
+#include <jet/profiler.h>
 #include <algorithm>
 
 using namespace jet;
@@ -51,13 +52,29 @@ void PicSolver3::setParticleEmitter(const ParticleEmitter3Ptr& newEmitter) {
     newEmitter->setTarget(_particles);
 }
 
+bool PicSolver3::useDeterministicTransfer() const {
+    return _particleToGridTransfer.isDeterministic();
+}
+
+void PicSolver3::setUseDeterministicTransfer(bool onoff) {
+    _particleToGridTransfer.setIsDeterministic(onoff);
+}
+
+unsigned int PicSolver3::particleSortingInterval() const {
+    return _particleSortingInterval;
+}
+
+void PicSolver3::setParticleSortingInterval(unsigned int newInterval) {
+    _particleSortingInterval = newInterval;
+}
+
 void PicSolver3::onInitialize() {
     GridFluidSolver3::onInitialize();
 
-    Timer timer;
-    updateParticleEmitter(0.0);
-    JET_INFO << "Update particle emitter took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver3::updateParticleEmitter");
+        updateParticleEmitter(0.0);
+    }
 }
 
 void PicSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
@@ -66,49 +83,51 @@ void PicSolver3::onBeginAdvanceTimeStep(double timeIntervalInSeconds) {
     JET_INFO << "Number of PIC-type particles: "
              << _particles->numberOfParticles();
 
-    Timer timer;
-    updateParticleEmitter(timeIntervalInSeconds);
-    JET_INFO << "Update particle emitter took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver3::updateParticleEmitter");
+        updateParticleEmitter(timeIntervalInSeconds);
+    }
+
+    sortParticlesIfNeeded();
 
     JET_INFO << "Number of PIC-type particles: "
              << _particles->numberOfParticles();
 
-    timer.reset();
-    transferFromParticlesToGrids();
-    JET_INFO << "transferFromParticlesToGrids took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver3::transferFromParticlesToGrids");
+        transferFromParticlesToGrids();
+    }
 
-    timer.reset();
-    buildSignedDistanceField();
-    JET_INFO << "buildSignedDistanceField took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver3::buildSignedDistanceField");
+        buildSignedDistanceField();
+    }
 
-    timer.reset();
-    extrapolateVelocityToAir();
-    JET_INFO << "extrapolateVelocityToAir took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver3::extrapolateVelocityToAir");
+        extrapolateVelocityToAir();
+    }
 
     applyBoundaryCondition();
 }
 
 void PicSolver3::computeAdvection(double timeIntervalInSeconds) {
-    Timer timer;
-    extrapolateVelocityToAir();
-    JET_INFO << "extrapolateVelocityToAir took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver3::extrapolateVelocityToAir");
+        extrapolateVelocityToAir();
+    }
 
     applyBoundaryCondition();
 
-    timer.reset();
-    transferFromGridsToParticles();
-    JET_INFO << "transferFromGridsToParticles took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver3::transferFromGridsToParticles");
+        transferFromGridsToParticles();
+    }
 
-    timer.reset();
-    moveParticles(timeIntervalInSeconds);
-    JET_INFO << "moveParticles took "
-             << timer.durationInSeconds() << " seconds";
+    {
+        JET_PROFILE_SCOPE("PicSolver3::moveParticles");
+        moveParticles(timeIntervalInSeconds);
+    }
 }
 
 ScalarField3Ptr PicSolver3::fluidSdf() const {
@@ -121,75 +140,46 @@ void PicSolver3::transferFromParticlesToGrids() {
     auto velocities = _particles->velocities();
     size_t numberOfParticles = _particles->numberOfParticles();
 
-    // Clear velocity to zero
-    flow->fill(Vector3D());
-
     // Weighted-average velocity
     auto u = flow->uAccessor();
     auto v = flow->vAccessor();
     auto w = flow->wAccessor();
-    Array3<double> uWeight(u.size());
-    Array3<double> vWeight(v.size());
-    Array3<double> wWeight(w.size());
     _uMarkers.resize(u.size());
     _vMarkers.resize(v.size());
     _wMarkers.resize(w.size());
-    _uMarkers.set(0);
-    _vMarkers.set(0);
-    _wMarkers.set(0);
-    LinearArraySampler3<double, double> uSampler(
-        flow->uConstAccessor(),
+
+    auto positionFunc = [&](size_t i) { return positions[i]; };
+
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        positionFunc,
+        [&](size_t i, const Vector3D&, const Point3UI&) {
+            return velocities[i].x;
+        },
         flow->gridSpacing(),
-        flow->uOrigin());
-    LinearArraySampler3<double, double> vSampler(
-        flow->vConstAccessor(),
+        flow->uOrigin(),
+        u,
+        _uMarkers.accessor());
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        positionFunc,
+        [&](size_t i, const Vector3D&, const Point3UI&) {
+            return velocities[i].y;
+        },
         flow->gridSpacing(),
-        flow->vOrigin());
-    LinearArraySampler3<double, double> wSampler(
-        flow->wConstAccessor(),
+        flow->vOrigin(),
+        v,
+        _vMarkers.accessor());
+    _particleToGridTransfer.transfer(
+        numberOfParticles,
+        positionFunc,
+        [&](size_t i, const Vector3D&, const Point3UI&) {
+            return velocities[i].z;
+        },
         flow->gridSpacing(),
-        flow->wOrigin());
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        std::array<Point3UI, 8> indices;
-        std::array<double, 8> weights;
-
-        uSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            u(indices[j]) += velocities[i].x * weights[j];
-            uWeight(indices[j]) += weights[j];
-            _uMarkers(indices[j]) = 1;
-        }
-
-        vSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            v(indices[j]) += velocities[i].y * weights[j];
-            vWeight(indices[j]) += weights[j];
-            _vMarkers(indices[j]) = 1;
-        }
-
-        wSampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
-        for (int j = 0; j < 8; ++j) {
-            w(indices[j]) += velocities[i].z * weights[j];
-            wWeight(indices[j]) += weights[j];
-            _wMarkers(indices[j]) = 1;
-        }
-    }
-
-    uWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (uWeight(i, j, k) > 0.0) {
-            u(i, j, k) /= uWeight(i, j, k);
-        }
-    });
-    vWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (vWeight(i, j, k) > 0.0) {
-            v(i, j, k) /= vWeight(i, j, k);
-        }
-    });
-    wWeight.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
-        if (wWeight(i, j, k) > 0.0) {
-            w(i, j, k) /= wWeight(i, j, k);
-        }
-    });
+        flow->wOrigin(),
+        w,
+        _wMarkers.accessor());
 }
 
 void PicSolver3::transferFromGridsToParticles() {
@@ -198,8 +188,9 @@ void PicSolver3::transferFromGridsToParticles() {
     auto velocities = _particles->velocities();
     size_t numberOfParticles = _particles->numberOfParticles();
 
+    LinearGridSampler3<FaceCenteredGrid3> sampler(*flow);
     parallelFor(kZeroSize, numberOfParticles, [&](size_t i) {
-        velocities[i] = flow->sample(positions[i]);
+        velocities[i] = sampler(positions[i]);
     });
 }
 
@@ -288,9 +279,9 @@ void PicSolver3::extrapolateVelocityToAir() {
     auto w = vel->wAccessor();
 
     unsigned int depth = static_cast<unsigned int>(std::ceil(maxCfl()));
-    extrapolateToRegion(vel->uConstAccessor(), _uMarkers, depth, u);
-    extrapolateToRegion(vel->vConstAccessor(), _vMarkers, depth, v);
-    extrapolateToRegion(vel->wConstAccessor(), _wMarkers, depth, w);
+    extrapolateToRegion(vel->uConstAccessor(), vel->vConstAccessor(),
+                        vel->wConstAccessor(), _uMarkers, _vMarkers,
+                        _wMarkers, depth, u, v, w);
 }
 
 void PicSolver3::buildSignedDistanceField() {
@@ -302,11 +293,10 @@ void PicSolver3::buildSignedDistanceField() {
     double sdfBandRadius = 2.0 * radius;
 
     _particles->buildNeighborSearcher(2 * radius);
-    auto searcher = _particles->neighborSearcher();
     sdf->parallelForEachDataPointIndex([&] (size_t i, size_t j, size_t k) {
         Vector3D pt = sdfPos(i, j, k);
         double minDist = sdfBandRadius;
-        searcher->forEachNearbyPoint(
+        _particles->forEachNearbyPoint(
             pt, sdfBandRadius, [&] (size_t, const Vector3D& x) {
                 minDist = std::min(minDist, pt.distanceTo(x));
             });
@@ -316,6 +306,19 @@ void PicSolver3::buildSignedDistanceField() {
     extrapolateIntoCollider(sdf.get());
 }
 
+void PicSolver3::onParticlesReordered(const std::vector<size_t>& order) {
+    UNUSED_VARIABLE(order);
+}
+
+void PicSolver3::sortParticlesIfNeeded() {
+    if (_particleSortingInterval > 0
+        && ++_numberOfStepsSinceSorting >= _particleSortingInterval) {
+        _particles->sortParticles();
+        onParticlesReordered(_particles->lastParticleOrder());
+        _numberOfStepsSinceSorting = 0;
+    }
+}
+
 void PicSolver3::updateParticleEmitter(double timeIntervalInSeconds) {
     if (_particleEmitter != nullptr) {
         _particleEmitter->update(currentTimeInSeconds(), timeIntervalInSeconds);
@@ -10,13 +10,17 @@
 
 #include <pch.h>
 
+#include <counting_sort_helpers.h>
 #include <fbs_helpers.h>
 #include <generated/point_hash_grid_searcher3_generated.h>
 
 #include <jet/array1.h>
+#include <jet/parallel.h>
 #include <jet/point_hash_grid_searcher3.h>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 using namespace jet;
@@ -60,39 +64,37 @@ void PointHashGridSearcher3::build(
         return;
     }
 
-    // Put points into buckets
-    for (size_t i = 0; i < points.size(); ++i) {
+    // Generate hash key for each point
+    size_t numberOfBuckets = _buckets.size();
+    std::vector<size_t> keys(points.size());
+    parallelFor(kZeroSize, points.size(), [&](size_t i) {
         _points[i] = points[i];
-        size_t key = getHashKeyFromPosition(points[i]);
-        _buckets[key].push_back(i);
-    }
+        keys[i] = getHashKeyFromPosition(points[i]);
+    });
+
+    // Sort the point indices by key. Each bucket keeps the points in the
+    // order they were given.
+    std::vector<size_t> slots(points.size());
+    std::vector<size_t> bucketStarts(numberOfBuckets + 1);
+    std::vector<size_t> sortedIndices(points.size());
+    std::unique_ptr<std::atomic<size_t>[]> bucketCounts(
+        new std::atomic<size_t>[numberOfBuckets]);
+    parallelCountingSort(keys.data(), points.size(), numberOfBuckets,
+                         bucketCounts.get(), slots.data(),
+                         bucketStarts.data(), sortedIndices.data());
+
+    // Put points into buckets
+    parallelFor(kZeroSize, numberOfBuckets, [&](size_t b) {
+        _buckets[b].assign(sortedIndices.begin() + bucketStarts[b],
+                           sortedIndices.begin() + bucketStarts[b + 1]);
+    });
 }
 
 void PointHashGridSearcher3::forEachNearbyPoint(
     const Vector3D& origin,
     double radius,
-    const std::function<void(size_t, const Vector3D&)>& callback) const {
-    if (_buckets.empty()) {
-        return;
-    }
-
-    size_t nearbyKeys[8];
-    getNearbyKeys(origin, nearbyKeys);
-
-    const double queryRadiusSquared = radius * radius;
-
-    for (int i = 0; i < 8; i++) {
-        const auto& bucket = _buckets[nearbyKeys[i]];
-        size_t numberOfPointsInBucket = bucket.size();
-
-        for (size_t j = 0; j < numberOfPointsInBucket; ++j) {
-            size_t pointIndex = bucket[j];
-            double rSquared = (_points[pointIndex] - origin).lengthSquared();
-            if (rSquared <= queryRadiusSquared) {
-                callback(pointIndex, _points[pointIndex]);
-            }
-        }
-    }
+    const ForEachNearbyPointFunc& callback) const {
+    forEachNearbyPoint<ForEachNearbyPointFunc>(origin, radius, callback);
 }
 
 bool PointHashGridSearcher3::hasNearbyPoint(
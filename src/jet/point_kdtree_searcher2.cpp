@@ -31,9 +31,10 @@ void PointKdTreeSearcher2::build(const ConstArrayAccessor1<Vector2D>& points) {
 }
 
 void PointKdTreeSearcher2::forEachNearbyPoint(
-    const Vector2D& origin, double radius,
+    const Vector2D& origin,
+    double radius,
     const ForEachNearbyPointFunc& callback) const {
-    _tree.forEachNearbyPoint(origin, radius, callback);
+    forEachNearbyPoint<ForEachNearbyPointFunc>(origin, radius, callback);
 }
 
 bool PointKdTreeSearcher2::hasNearbyPoint(const Vector2D& origin,
@@ -31,9 +31,10 @@ void PointKdTreeSearcher3::build(const ConstArrayAccessor1<Vector3D>& points) {
 }
 
 void PointKdTreeSearcher3::forEachNearbyPoint(
-    const Vector3D& origin, double radius,
+    const Vector3D& origin,
+    double radius,
     const ForEachNearbyPointFunc& callback) const {
-    _tree.forEachNearbyPoint(origin, radius, callback);
+    forEachNearbyPoint<ForEachNearbyPointFunc>(origin, radius, callback);
 }
 
 bool PointKdTreeSearcher3::hasNearbyPoint(const Vector3D& origin,
@@ -9,14 +9,18 @@
 #endif
 
 #include <pch.h>
+#include <counting_sort_helpers.h>
 #include <fbs_helpers.h>
 #include <generated/point_parallel_hash_grid_searcher2_generated.h>
 
 #include <jet/constants.h>
 #include <jet/parallel.h>
 #include <jet/point_parallel_hash_grid_searcher2.h>
+#include <jet/scratch_arena.h>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 
 using namespace jet;
@@ -55,50 +59,36 @@ void PointParallelHashGridSearcher2::build(
 
     // Allocate memory chuncks
     size_t numberOfPoints = points.size();
-    std::vector<size_t> tempKeys(numberOfPoints);
-    _startIndexTable.resize(_resolution.x * _resolution.y);
-    _endIndexTable.resize(_resolution.x * _resolution.y);
-    parallelFill(_startIndexTable.begin(), _startIndexTable.end(), kMaxSize);
-    parallelFill(_endIndexTable.begin(), _endIndexTable.end(), kMaxSize);
+    size_t numberOfBuckets = _resolution.x * _resolution.y;
+    ScratchArena& arena = ScratchArena::threadLocal();
+    ScratchBuffer<size_t> tempKeys = arena.allocate<size_t>(numberOfPoints);
+    ScratchBuffer<size_t> slots = arena.allocate<size_t>(numberOfPoints);
+    ScratchBuffer<std::atomic<size_t>> bucketCounts =
+        arena.allocate<std::atomic<size_t>>(numberOfBuckets);
+    ScratchBuffer<size_t> bucketStarts =
+        arena.allocate<size_t>(numberOfBuckets + 1);
+    _startIndexTable.resize(numberOfBuckets);
+    _endIndexTable.resize(numberOfBuckets);
     _keys.resize(numberOfPoints);
     _sortedIndices.resize(numberOfPoints);
     _points.resize(numberOfPoints);
 
-    if (numberOfPoints == 0) {
-        return;
-    }
-
-    // Initialize indices array and generate hash key for each point
+    // Generate hash key for each point
     parallelFor(
         kZeroSize,
         numberOfPoints,
         [&](size_t i) {
-            _sortedIndices[i] = i;
-            _points[i] = points[i];
             tempKeys[i] = getHashKeyFromPosition(points[i]);
         });
 
-    // Sort indices based on hash key
-    parallelSort(
-        _sortedIndices.begin(),
-        _sortedIndices.end(),
-        [&tempKeys](size_t indexA, size_t indexB) {
-            return tempKeys[indexA] < tempKeys[indexB];
-        });
-
-    // Re-order point and key arrays
-    parallelFor(
-        kZeroSize,
-        numberOfPoints,
-        [&](size_t i) {
-            _points[i] = points[_sortedIndices[i]];
-            _keys[i] = tempKeys[_sortedIndices[i]];
-        });
-
-    // Now _points and _keys are sorted by points' hash key values.
-    // Let's fill in start/end index table with _keys.
+    // The hash keys are bounded by the number of buckets, so a counting sort
+    // replaces the comparison sort, and its bucket offsets fill in the
+    // start/end index table.
+    parallelCountingSort(tempKeys.data(), numberOfPoints, numberOfBuckets,
+                         bucketCounts.data(), slots.data(),
+                         bucketStarts.data(), _sortedIndices.data());
 
-    // Assume that _keys array looks like:
+    // Assume that the sorted keys look like:
     // [5|8|8|10|10|10]
     // Then _startIndexTable and _endIndexTable should be like:
     // [.....|0|...|1|..|3|..]
@@ -106,68 +96,34 @@ void PointParallelHashGridSearcher2::build(
     //       ^5    ^8   ^10
     // So that _endIndexTable[i] - _startIndexTable[i] is the number points
     // in i-th table bucket.
+    parallelFor(
+        kZeroSize,
+        numberOfBuckets,
+        [&](size_t b) {
+            if (bucketStarts[b] < bucketStarts[b + 1]) {
+                _startIndexTable[b] = bucketStarts[b];
+                _endIndexTable[b] = bucketStarts[b + 1];
+            } else {
+                _startIndexTable[b] = kMaxSize;
+                _endIndexTable[b] = kMaxSize;
+            }
+        });
 
-    _startIndexTable[_keys[0]] = 0;
-    _endIndexTable[_keys[numberOfPoints - 1]] = numberOfPoints;
-
+    // Re-order point and key arrays
     parallelFor(
-        (size_t)1,
+        kZeroSize,
         numberOfPoints,
         [&](size_t i) {
-            if (_keys[i] > _keys[i - 1]) {
-                _startIndexTable[_keys[i]] = i;
-                _endIndexTable[_keys[i - 1]] = i;
-            }
+            _points[i] = points[_sortedIndices[i]];
+            _keys[i] = tempKeys[_sortedIndices[i]];
         });
-
-    size_t sumNumberOfPointsPerBucket = 0;
-    size_t maxNumberOfPointsPerBucket = 0;
-    size_t numberOfNonEmptyBucket = 0;
-    for (size_t i = 0; i < _startIndexTable.size(); ++i) {
-        if (_startIndexTable[i] != kMaxSize) {
-            size_t numberOfPointsInBucket
-                = _endIndexTable[i] - _startIndexTable[i];
-            sumNumberOfPointsPerBucket += numberOfPointsInBucket;
-            maxNumberOfPointsPerBucket =
-                std::max(maxNumberOfPointsPerBucket, numberOfPointsInBucket);
-            ++numberOfNonEmptyBucket;
-        }
-    }
-
-    JET_INFO << "Average number of points per non-empty bucket: "
-             << static_cast<float>(sumNumberOfPointsPerBucket)
-                / static_cast<float>(numberOfNonEmptyBucket);
-    JET_INFO << "Max number of points per bucket: "
-             << maxNumberOfPointsPerBucket;
 }
 
 void PointParallelHashGridSearcher2::forEachNearbyPoint(
     const Vector2D& origin,
     double radius,
     const ForEachNearbyPointFunc& callback) const {
-    size_t nearbyKeys[4];
-    getNearbyKeys(origin, nearbyKeys);
-
-    const double queryRadiusSquared = radius * radius;
-
-    for (int i = 0; i < 4; i++) {
-        size_t nearbyKey = nearbyKeys[i];
-        size_t start = _startIndexTable[nearbyKey];
-        size_t end = _endIndexTable[nearbyKey];
-
-        // Empty bucket -- continue to next bucket
-        if (start == kMaxSize) {
-            continue;
-        }
-
-        for (size_t j = start; j < end; ++j) {
-            Vector2D direction = _points[j] - origin;
-            double distanceSquared = direction.lengthSquared();
-            if (distanceSquared <= queryRadiusSquared) {
-                callback(_sortedIndices[j], _points[j]);
-            }
-        }
-    }
+    forEachNearbyPoint<ForEachNearbyPointFunc>(origin, radius, callback);
 }
 
 bool PointParallelHashGridSearcher2::hasNearbyPoint(
@@ -8,6 +8,7 @@
 #include <jet/matrix2x2.h>
 #include <jet/point_particle_emitter2.h>
 #include <jet/samplers.h>
+#include <jet/scratch_arena.h>
 
 namespace jet {
 
@@ -71,36 +72,31 @@ void PointParticleEmitter2::onUpdate(
         = newMaxTotalNumberOfEmittedParticles - _numberOfEmittedParticles;
 
     if (maxNumberOfNewParticles > 0) {
-        Array1<Vector2D> candidatePositions;
-        Array1<Vector2D> candidateVelocities;
-        Array1<Vector2D> newPositions;
-        Array1<Vector2D> newVelocities;
+        ScratchArena& arena = ScratchArena::threadLocal();
+        ScratchBuffer<Vector2D> newPositions =
+            arena.allocate<Vector2D>(maxNumberOfNewParticles);
+        ScratchBuffer<Vector2D> newVelocities =
+            arena.allocate<Vector2D>(maxNumberOfNewParticles);
 
-        emit(
-            &candidatePositions,
-            &candidateVelocities,
-            maxNumberOfNewParticles);
+        emit(newPositions.accessor(), newVelocities.accessor());
 
-        newPositions.append(candidatePositions);
-        newVelocities.append(candidateVelocities);
-
-        particles->addParticles(newPositions, newVelocities);
+        particles->addParticles(
+            newPositions.constAccessor(), newVelocities.constAccessor());
 
         _numberOfEmittedParticles += newPositions.size();
     }
 }
 
 void PointParticleEmitter2::emit(
-    Array1<Vector2D>* newPositions,
-    Array1<Vector2D>* newVelocities,
-    size_t maxNewNumberOfParticles) {
-    for (size_t i = 0; i < maxNewNumberOfParticles; ++i) {
+    ArrayAccessor1<Vector2D> newPositions,
+    ArrayAccessor1<Vector2D> newVelocities) {
+    for (size_t i = 0; i < newPositions.size(); ++i) {
         double newAngleInRadian = (random() - 0.5) * _spreadAngleInRadians;
         Matrix2x2D rotationMatrix =
             Matrix2x2D::makeRotationMatrix(newAngleInRadian);
 
-        newPositions->append(_origin);
-        newVelocities->append(_speed * (rotationMatrix * _direction));
+        newPositions[i] = _origin;
+        newVelocities[i] = _speed * (rotationMatrix * _direction);
     }
 }
 
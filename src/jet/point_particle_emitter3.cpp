@@ -7,6 +7,7 @@
 #include <pch.h>
 #include <jet/point_particle_emitter3.h>
 #include <jet/samplers.h>
+#include <jet/scratch_arena.h>
 
 namespace jet {
 
@@ -70,38 +71,33 @@ void PointParticleEmitter3::onUpdate(
         = newMaxTotalNumberOfEmittedParticles - _numberOfEmittedParticles;
 
     if (maxNumberOfNewParticles > 0) {
-        Array1<Vector3D> candidatePositions;
-        Array1<Vector3D> candidateVelocities;
-        Array1<Vector3D> newPositions;
-        Array1<Vector3D> newVelocities;
+        ScratchArena& arena = ScratchArena::threadLocal();
+        ScratchBuffer<Vector3D> newPositions =
+            arena.allocate<Vector3D>(maxNumberOfNewParticles);
+        ScratchBuffer<Vector3D> newVelocities =
+            arena.allocate<Vector3D>(maxNumberOfNewParticles);
 
-        emit(
-            &candidatePositions,
-            &candidateVelocities,
-            maxNumberOfNewParticles);
+        emit(newPositions.accessor(), newVelocities.accessor());
 
-        newPositions.append(candidatePositions);
-        newVelocities.append(candidateVelocities);
-
-        particles->addParticles(newPositions, newVelocities);
+        particles->addParticles(
+            newPositions.constAccessor(), newVelocities.constAccessor());
 
         _numberOfEmittedParticles += newPositions.size();
     }
 }
 
 void PointParticleEmitter3::emit(
-    Array1<Vector3D>* newPositions,
-    Array1<Vector3D>* newVelocities,
-    size_t maxNewNumberOfParticles) {
-    for (size_t i = 0; i < maxNewNumberOfParticles; ++i) {
+    ArrayAccessor1<Vector3D> newPositions,
+    ArrayAccessor1<Vector3D> newVelocities) {
+    for (size_t i = 0; i < newPositions.size(); ++i) {
         Vector3D newDirection = uniformSampleCone(
             random(),
             random(),
             _direction,
             _spreadAngleInRadians);
 
-        newPositions->append(_origin);
-        newVelocities->append(_speed * newDirection);
+        newPositions[i] = _origin;
+        newVelocities[i] = _speed * newDirection;
     }
 }
 
@@ -0,0 +1,225 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/profiler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+using namespace jet;
+
+namespace {
+
+// Number of zones kept per thread
+const size_t kRingBufferCapacity = 1 << 16;
+
+// Ring buffer of a single thread. Only the owning thread records into it, so
+// its mutex is only contended while the zones are being collected.
+struct RingBuffer {
+    std::mutex mutex;
+    std::vector<ProfilerEvent> events;
+    size_t next = 0;
+    bool isFull = false;
+    unsigned int threadIndex = 0;
+
+    void push(const ProfilerEvent& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (events.size() < kRingBufferCapacity) {
+            events.push_back(event);
+        } else {
+            events[next] = event;
+            isFull = true;
+        }
+        next = (next + 1) % kRingBufferCapacity;
+    }
+};
+
+std::atomic<bool> sIsEnabled(false);
+std::atomic<int64_t> sFrameIndex(0);
+const std::chrono::steady_clock::time_point sStartTime =
+    std::chrono::steady_clock::now();
+
+// The buffers outlive their threads so that the zones of finished threads can
+// still be exported.
+std::mutex sBuffersMutex;
+std::vector<std::shared_ptr<RingBuffer>> sBuffers;
+
+thread_local unsigned int tDepth = 0;
+thread_local std::shared_ptr<RingBuffer> tBuffer;
+
+RingBuffer& threadBuffer() {
+    if (!tBuffer) {
+        tBuffer = std::make_shared<RingBuffer>();
+
+        std::lock_guard<std::mutex> lock(sBuffersMutex);
+        tBuffer->threadIndex = static_cast<unsigned int>(sBuffers.size());
+        sBuffers.push_back(tBuffer);
+    }
+
+    return *tBuffer;
+}
+
+void writeJsonString(const char* str, std::ostream* strm) {
+    (*strm) << '"';
+    for (const char* c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            (*strm) << '\\';
+        }
+        (*strm) << *c;
+    }
+    (*strm) << '"';
+}
+
+}  // namespace
+
+void Profiler::setEnabled(bool enabled) { sIsEnabled = enabled; }
+
+bool Profiler::isEnabled() {
+    return sIsEnabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setFrameIndex(int64_t frameIndex) { sFrameIndex = frameIndex; }
+
+int64_t Profiler::frameIndex() {
+    return sFrameIndex.load(std::memory_order_relaxed);
+}
+
+int64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - sStartTime)
+        .count();
+}
+
+void Profiler::record(const char* name, int64_t beginTime, int64_t endTime,
+                      unsigned int depth) {
+    RingBuffer& buffer = threadBuffer();
+
+    ProfilerEvent event;
+    event.name = name;
+    event.beginTime = beginTime;
+    event.endTime = endTime;
+    event.frameIndex = frameIndex();
+    event.threadIndex = buffer.threadIndex;
+    event.depth = depth;
+
+    buffer.push(event);
+}
+
+std::vector<ProfilerEvent> Profiler::events() {
+    std::vector<ProfilerEvent> result;
+
+    std::lock_guard<std::mutex> buffersLock(sBuffersMutex);
+    for (const auto& buffer : sBuffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        if (buffer->isFull) {
+            // Oldest zones first
+            result.insert(result.end(), buffer->events.begin() + buffer->next,
+                          buffer->events.end());
+            result.insert(result.end(), buffer->events.begin(),
+                          buffer->events.begin() + buffer->next);
+        } else {
+            result.insert(result.end(), buffer->events.begin(),
+                          buffer->events.end());
+        }
+    }
+
+    std::stable_sort(result.begin(), result.end(),
+                     [](const ProfilerEvent& a, const ProfilerEvent& b) {
+                         return a.beginTime < b.beginTime;
+                     });
+
+    return result;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> buffersLock(sBuffersMutex);
+    for (const auto& buffer : sBuffers) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+        buffer->events.clear();
+        buffer->next = 0;
+        buffer->isFull = false;
+    }
+}
+
+void Profiler::writeChromeTrace(std::ostream* strm) {
+    const std::vector<ProfilerEvent> allEvents = events();
+
+    // Fixed-point microseconds keep the nanosecond resolution regardless of
+    // the run time, which the default precision would round off.
+    const std::ios_base::fmtflags flags = strm->flags();
+    const std::streamsize precision = strm->precision();
+    (*strm) << std::fixed << std::setprecision(3);
+
+    (*strm) << "{\"traceEvents\":[";
+    for (size_t i = 0; i < allEvents.size(); ++i) {
+        const ProfilerEvent& event = allEvents[i];
+
+        // Chrome expects the times in microseconds
+        (*strm) << (i > 0 ? ",\n" : "\n") << "{\"name\":";
+        writeJsonString(event.name, strm);
+        (*strm) << ",\"cat\":\"jet\",\"ph\":\"X\""
+                << ",\"ts\":" << event.beginTime / 1000.0
+                << ",\"dur\":" << (event.endTime - event.beginTime) / 1000.0
+                << ",\"pid\":0,\"tid\":" << event.threadIndex
+                << ",\"args\":{\"frame\":" << event.frameIndex << "}}";
+    }
+    (*strm) << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+    strm->flags(flags);
+    strm->precision(precision);
+}
+
+void Profiler::writeFrameSummaryCsv(std::ostream* strm) {
+    struct Summary {
+        size_t count = 0;
+        int64_t totalTime = 0;
+        int64_t maxTime = 0;
+    };
+
+    std::map<std::pair<int64_t, std::string>, Summary> summaries;
+    for (const ProfilerEvent& event : events()) {
+        Summary& summary = summaries[std::make_pair(event.frameIndex,
+                                                    std::string(event.name))];
+        const int64_t duration = event.endTime - event.beginTime;
+        ++summary.count;
+        summary.totalTime += duration;
+        summary.maxTime = std::max(summary.maxTime, duration);
+    }
+
+    (*strm) << "frame,zone,count,total_seconds,max_seconds\n";
+    for (const auto& entry : summaries) {
+        const Summary& summary = entry.second;
+        (*strm) << entry.first.first << ',' << entry.first.second << ','
+                << summary.count << ',' << summary.totalTime * 1e-9 << ','
+                << summary.maxTime * 1e-9 << '\n';
+    }
+}
+
+ProfilerScope::ProfilerScope(const char* name)
+    : _name(nullptr), _beginTime(0), _depth(0) {
+    if (Profiler::isEnabled()) {
+        _name = name;
+        _depth = tDepth++;
+        _beginTime = Profiler::now();
+    }
+}
+
+ProfilerScope::~ProfilerScope() {
+    if (_name != nullptr) {
+        const int64_t endTime = Profiler::now();
+        --tDepth;
+        Profiler::record(_name, _beginTime, endTime, _depth);
+    }
+}
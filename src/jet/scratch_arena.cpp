@@ -0,0 +1,89 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <jet/scratch_arena.h>
+
+#include <atomic>
+#include <new>
+
+using namespace jet;
+
+namespace {
+
+// Smallest block size; the size class c holds blocks of kMinBlockSize << c
+// bytes.
+const size_t kMinBlockSize = 256;
+
+std::atomic<size_t> sNumberOfHeapAllocations(0);
+std::atomic<size_t> sHeapBytesAllocated(0);
+std::atomic<size_t> sBytesServed(0);
+
+size_t blockSize(size_t sizeClass) { return kMinBlockSize << sizeClass; }
+
+}  // namespace
+
+const size_t ScratchArena::kNumberOfSizeClasses;
+
+ScratchArena::ScratchArena() {}
+
+ScratchArena::~ScratchArena() { releaseCachedBlocks(); }
+
+size_t ScratchArena::numberOfCachedBytes() const {
+    return _numberOfCachedBytes;
+}
+
+void ScratchArena::releaseCachedBlocks() {
+    for (auto& blocks : _freeBlocks) {
+        for (void* block : blocks) {
+            ::operator delete(block);
+        }
+        blocks.clear();
+    }
+    _numberOfCachedBytes = 0;
+}
+
+ScratchArena& ScratchArena::threadLocal() {
+    static thread_local ScratchArena arena;
+    return arena;
+}
+
+size_t ScratchArena::numberOfHeapAllocations() {
+    return sNumberOfHeapAllocations;
+}
+
+size_t ScratchArena::heapBytesAllocated() { return sHeapBytesAllocated; }
+
+size_t ScratchArena::bytesServed() { return sBytesServed; }
+
+void* ScratchArena::acquire(size_t bytes, size_t* sizeClass) {
+    size_t c = 0;
+    while (blockSize(c) < bytes) {
+        ++c;
+    }
+    JET_ASSERT(c < kNumberOfSizeClasses);
+
+    *sizeClass = c;
+    sBytesServed += bytes;
+
+    std::vector<void*>& blocks = _freeBlocks[c];
+    if (!blocks.empty()) {
+        void* block = blocks.back();
+        blocks.pop_back();
+        _numberOfCachedBytes -= blockSize(c);
+        return block;
+    }
+
+    ++sNumberOfHeapAllocations;
+    sHeapBytesAllocated += blockSize(c);
+    return ::operator new(blockSize(c));
+}
+
+void ScratchArena::release(void* block, size_t sizeClass) {
+    _freeBlocks[sizeClass].push_back(block);
+    _numberOfCachedBytes += blockSize(sizeClass);
+}
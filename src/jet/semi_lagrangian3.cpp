@@ -5,10 +5,14 @@
 // property of any third parties.
 
 #include <pch.h>
+#include <narrow_band_helpers.h>
+#include <semi_lagrangian_helpers.h>
+#include <sparse_grid_helpers.h>
 #include <jet/array_samplers3.h>
 #include <jet/parallel.h>
 #include <jet/semi_lagrangian3.h>
 #include <algorithm>
+#include <vector>
 
 using namespace jet;
 
@@ -33,16 +37,60 @@ void SemiLagrangian3::advect(
         output->gridSpacing().x,
         output->gridSpacing().y,
         output->gridSpacing().z);
+    FlowSampler3 flowSampler(flow);
+    BoundarySampler3 boundarySampler(boundarySdf);
 
     output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
+        if (boundarySampler(inputDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
-                flow, dt, h, outputDataPos(i, j, k), boundarySdf);
+                flowSampler, dt, h, outputDataPos(i, j, k), boundarySampler);
             outputDataAcc(i, j, k) = inputSamplerFunc(pt);
         }
     });
 }
 
+void SemiLagrangian3::advectNarrowBand(
+    const ScalarGrid3& input,
+    const VectorField3& flow,
+    double dt,
+    double bandWidth,
+    ScalarGrid3* output,
+    const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
+
+    auto inputDataAcc = input.constDataAccessor();
+    auto outputDataPos = output->dataPosition();
+    auto outputDataAcc = output->dataAccessor();
+    auto inputSamplerFunc = getScalarSamplerFunc(input);
+    auto inputDataPos = input.dataPosition();
+
+    std::vector<Point3UI> band;
+    findNarrowBand(inputDataAcc, bandWidth, &band);
+
+    output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        outputDataAcc(i, j, k) =
+            clampToNarrowBand(inputDataAcc(i, j, k), bandWidth);
+    });
+
+    double h = min3(
+        output->gridSpacing().x,
+        output->gridSpacing().y,
+        output->gridSpacing().z);
+    FlowSampler3 flowSampler(flow);
+    BoundarySampler3 boundarySampler(boundarySdf);
+
+    parallelFor(kZeroSize, band.size(), [&](size_t l) {
+        const Point3UI& idx = band[l];
+        if (boundarySampler(inputDataPos(idx.x, idx.y, idx.z)) > 0.0) {
+            Vector3D pt = backTrace(flowSampler, dt, h,
+                                    outputDataPos(idx.x, idx.y, idx.z),
+                                    boundarySampler);
+            outputDataAcc(idx.x, idx.y, idx.z) =
+                clampToNarrowBand(inputSamplerFunc(pt), bandWidth);
+        }
+    });
+}
+
 void SemiLagrangian3::advect(
     const CollocatedVectorGrid3& input,
     const VectorField3& flow,
@@ -55,15 +103,17 @@ void SemiLagrangian3::advect(
         output->gridSpacing().x,
         output->gridSpacing().y,
         output->gridSpacing().z);
+    FlowSampler3 flowSampler(flow);
+    BoundarySampler3 boundarySampler(boundarySdf);
 
     auto outputDataPos = output->dataPosition();
     auto outputDataAcc = output->dataAccessor();
     auto inputDataPos = input.dataPosition();
 
     output->parallelForEachDataPointIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(inputDataPos(i, j, k)) > 0.0) {
+        if (boundarySampler(inputDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
-                flow, dt, h, outputDataPos(i, j, k), boundarySdf);
+                flowSampler, dt, h, outputDataPos(i, j, k), boundarySampler);
             outputDataAcc(i, j, k) = inputSamplerFunc(pt);
         }
     });
@@ -81,15 +131,17 @@ void SemiLagrangian3::advect(
         output->gridSpacing().x,
         output->gridSpacing().y,
         output->gridSpacing().z);
+    FlowSampler3 flowSampler(flow);
+    BoundarySampler3 boundarySampler(boundarySdf);
 
     auto uTargetDataPos = output->uPosition();
     auto uTargetDataAcc = output->uAccessor();
     auto uSourceDataPos = input.uPosition();
 
     output->parallelForEachUIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(uSourceDataPos(i, j, k)) > 0.0) {
+        if (boundarySampler(uSourceDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
-                flow, dt, h, uTargetDataPos(i, j, k), boundarySdf);
+                flowSampler, dt, h, uTargetDataPos(i, j, k), boundarySampler);
             uTargetDataAcc(i, j, k) = inputSamplerFunc(pt).x;
         }
     });
@@ -99,9 +151,9 @@ void SemiLagrangian3::advect(
     auto vSourceDataPos = input.vPosition();
 
     output->parallelForEachVIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(vSourceDataPos(i, j, k)) > 0.0) {
+        if (boundarySampler(vSourceDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
-                flow, dt, h, vTargetDataPos(i, j, k), boundarySdf);
+                flowSampler, dt, h, vTargetDataPos(i, j, k), boundarySampler);
             vTargetDataAcc(i, j, k) = inputSamplerFunc(pt).y;
         }
     });
@@ -111,52 +163,42 @@ void SemiLagrangian3::advect(
     auto wSourceDataPos = input.wPosition();
 
     output->parallelForEachWIndex([&](size_t i, size_t j, size_t k) {
-        if (boundarySdf.sample(wSourceDataPos(i, j, k)) > 0.0) {
+        if (boundarySampler(wSourceDataPos(i, j, k)) > 0.0) {
             Vector3D pt = backTrace(
-                flow, dt, h, wTargetDataPos(i, j, k), boundarySdf);
+                flowSampler, dt, h, wTargetDataPos(i, j, k), boundarySampler);
             wTargetDataAcc(i, j, k) = inputSamplerFunc(pt).z;
         }
     });
 }
 
-Vector3D SemiLagrangian3::backTrace(
+void SemiLagrangian3::advect(
+    const SparseScalarGrid3& input,
     const VectorField3& flow,
     double dt,
-    double h,
-    const Vector3D& startPt,
+    SparseScalarGrid3* output,
     const ScalarField3& boundarySdf) {
+    JET_THROW_INVALID_ARG_IF(!input.hasSameShape(*output));
 
-    double remainingT = dt;
-    Vector3D pt0 = startPt;
-    Vector3D pt1 = startPt;
-
-    while (remainingT > kEpsilonD) {
-        // Adaptive time-stepping
-        Vector3D vel0 = flow.sample(pt0);
-        double numSubSteps
-            = std::max(std::ceil(vel0.length() * remainingT / h), 1.0);
-        dt = remainingT / numSubSteps;
-
-        // Mid-point rule
-        Vector3D midPt = pt0 - 0.5 * dt * vel0;
-        Vector3D midVel = flow.sample(midPt);
-        pt1 = pt0 - dt * midVel;
-
-        // Boundary handling
-        double phi0 = boundarySdf.sample(pt0);
-        double phi1 = boundarySdf.sample(pt1);
-
-        if (phi0 * phi1 < 0.0) {
-            double w = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
-            pt1 = w * pt0 + (1.0 - w) * pt1;
-            break;
-        }
-
-        remainingT -= dt;
-        pt0 = pt1;
-    }
+    const TiledArray3<double>& inputData = input.data();
+    const Vector3D inputGridSpacing = input.gridSpacing();
+    const Vector3D inputOrigin = input.dataOrigin();
 
-    return pt1;
+    double h = min3(
+        output->gridSpacing().x,
+        output->gridSpacing().y,
+        output->gridSpacing().z);
+    FlowSampler3 flowSampler(flow);
+    BoundarySampler3 boundarySampler(boundarySdf);
+
+    output->fill(inputData.background());
+    output->fill([&](const Vector3D& pt) {
+        Vector3D samplePt = pt;
+        if (boundarySampler(pt) > 0.0) {
+            samplePt = backTrace(flowSampler, dt, h, pt, boundarySampler);
+        }
+        return sampleTiled(inputData, inputGridSpacing, inputOrigin,
+                           samplePt);
+    });
 }
 
 std::function<double(const Vector3D&)>
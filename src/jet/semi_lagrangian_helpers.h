@@ -0,0 +1,284 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_SEMI_LAGRANGIAN_HELPERS_H_
+#define SRC_JET_SEMI_LAGRANGIAN_HELPERS_H_
+
+#include <sparse_grid_helpers.h>
+#include <jet/cell_centered_scalar_grid2.h>
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/cell_centered_vector_grid2.h>
+#include <jet/cell_centered_vector_grid3.h>
+#include <jet/constant_scalar_field2.h>
+#include <jet/constant_scalar_field3.h>
+#include <jet/constants.h>
+#include <jet/grid_samplers2.h>
+#include <jet/grid_samplers3.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
+#include <jet/sparse_vertex_centered_scalar_grid3.h>
+#include <jet/vertex_centered_scalar_grid2.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+#include <jet/vertex_centered_vector_grid2.h>
+#include <jet/vertex_centered_vector_grid3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <typeinfo>
+
+namespace jet {
+
+// Samples the flow field with the statically-typed sampler if the field is
+// one of the built-in grids, so the back-tracing does not go through the
+// virtual function and std::function for every sample. Other fields are
+// sampled through the virtual function.
+class FlowSampler2 {
+ public:
+    explicit FlowSampler2(const VectorField2& flow) : _flow(flow) {
+        const std::type_info& type = typeid(flow);
+        if (type == typeid(FaceCenteredGrid2)) {
+            _type = kFaceCentered;
+            _faceCenteredSampler = LinearGridSampler2<FaceCenteredGrid2>(
+                static_cast<const FaceCenteredGrid2&>(flow));
+        } else if (type == typeid(CellCenteredVectorGrid2) ||
+                   type == typeid(VertexCenteredVectorGrid2)) {
+            _type = kCollocated;
+            _collocatedSampler = LinearGridSampler2<CollocatedVectorGrid2>(
+                static_cast<const CollocatedVectorGrid2&>(flow));
+        }
+    }
+
+    Vector2D operator()(const Vector2D& pt) const {
+        switch (_type) {
+            case kFaceCentered:
+                return _faceCenteredSampler(pt);
+            case kCollocated:
+                return _collocatedSampler(pt);
+            default:
+                return _flow.sample(pt);
+        }
+    }
+
+ private:
+    enum Type { kFaceCentered, kCollocated, kGeneric };
+
+    const VectorField2& _flow;
+    Type _type = kGeneric;
+    LinearGridSampler2<FaceCenteredGrid2> _faceCenteredSampler;
+    LinearGridSampler2<CollocatedVectorGrid2> _collocatedSampler;
+};
+
+// Samples the boundary signed-distance field. The constant field, which is
+// the default boundary, is resolved once, and the built-in scalar grids are
+// sampled with the statically-typed sampler.
+class BoundarySampler2 {
+ public:
+    explicit BoundarySampler2(const ScalarField2& sdf) : _sdf(sdf) {
+        const std::type_info& type = typeid(sdf);
+        if (type == typeid(ConstantScalarField2)) {
+            _type = kConstant;
+            _value = sdf.sample(Vector2D());
+        } else if (type == typeid(CellCenteredScalarGrid2) ||
+                   type == typeid(VertexCenteredScalarGrid2)) {
+            _type = kGrid;
+            _gridSampler = LinearGridSampler2<ScalarGrid2>(
+                static_cast<const ScalarGrid2&>(sdf));
+        }
+    }
+
+    double operator()(const Vector2D& pt) const {
+        switch (_type) {
+            case kConstant:
+                return _value;
+            case kGrid:
+                return _gridSampler(pt);
+            default:
+                return _sdf.sample(pt);
+        }
+    }
+
+ private:
+    enum Type { kConstant, kGrid, kGeneric };
+
+    const ScalarField2& _sdf;
+    Type _type = kGeneric;
+    double _value = 0.0;
+    LinearGridSampler2<ScalarGrid2> _gridSampler;
+};
+
+// Back-traces \p startPt along the flow for \p dt with the mid-point rule and
+// the adaptive sub-steps (CFL <= 1). The trace stops at the boundary. With the
+// negative \p dt, the point is traced forward.
+inline Vector2D backTrace(const FlowSampler2& flow, double dt, double h,
+                          const Vector2D& startPt,
+                          const BoundarySampler2& boundarySdf) {
+    double remainingT = dt;
+    Vector2D pt0 = startPt;
+    Vector2D pt1 = startPt;
+
+    while (std::fabs(remainingT) > kEpsilonD) {
+        // Adaptive time-stepping
+        Vector2D vel0 = flow(pt0);
+        double numSubSteps
+            = std::max(std::ceil(vel0.length() * std::fabs(remainingT) / h),
+                       1.0);
+        dt = remainingT / numSubSteps;
+
+        // Mid-point rule
+        Vector2D midPt = pt0 - 0.5 * dt * vel0;
+        Vector2D midVel = flow(midPt);
+        pt1 = pt0 - dt * midVel;
+
+        // Boundary handling
+        double phi0 = boundarySdf(pt0);
+        double phi1 = boundarySdf(pt1);
+
+        if (phi0 * phi1 < 0.0) {
+            double w = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
+            pt1 = w * pt0 + (1.0 - w) * pt1;
+            break;
+        }
+
+        remainingT -= dt;
+        pt0 = pt1;
+    }
+
+    return pt1;
+}
+
+// 3-D version of FlowSampler2.
+class FlowSampler3 {
+ public:
+    explicit FlowSampler3(const VectorField3& flow) : _flow(flow) {
+        const std::type_info& type = typeid(flow);
+        if (type == typeid(FaceCenteredGrid3)) {
+            _type = kFaceCentered;
+            _faceCenteredSampler = LinearGridSampler3<FaceCenteredGrid3>(
+                static_cast<const FaceCenteredGrid3&>(flow));
+        } else if (type == typeid(CellCenteredVectorGrid3) ||
+                   type == typeid(VertexCenteredVectorGrid3)) {
+            _type = kCollocated;
+            _collocatedSampler = LinearGridSampler3<CollocatedVectorGrid3>(
+                static_cast<const CollocatedVectorGrid3&>(flow));
+        }
+    }
+
+    Vector3D operator()(const Vector3D& pt) const {
+        switch (_type) {
+            case kFaceCentered:
+                return _faceCenteredSampler(pt);
+            case kCollocated:
+                return _collocatedSampler(pt);
+            default:
+                return _flow.sample(pt);
+        }
+    }
+
+ private:
+    enum Type { kFaceCentered, kCollocated, kGeneric };
+
+    const VectorField3& _flow;
+    Type _type = kGeneric;
+    LinearGridSampler3<FaceCenteredGrid3> _faceCenteredSampler;
+    LinearGridSampler3<CollocatedVectorGrid3> _collocatedSampler;
+};
+
+// 3-D version of BoundarySampler2. The sparse scalar grids are sampled from
+// their tiled storage directly, and a sparse grid without any active tile is
+// resolved once as the constant background.
+class BoundarySampler3 {
+ public:
+    explicit BoundarySampler3(const ScalarField3& sdf) : _sdf(sdf) {
+        const std::type_info& type = typeid(sdf);
+        if (type == typeid(ConstantScalarField3)) {
+            _type = kConstant;
+            _value = sdf.sample(Vector3D());
+        } else if (type == typeid(CellCenteredScalarGrid3) ||
+                   type == typeid(VertexCenteredScalarGrid3)) {
+            _type = kGrid;
+            _gridSampler = LinearGridSampler3<ScalarGrid3>(
+                static_cast<const ScalarGrid3&>(sdf));
+        } else if (type == typeid(SparseCellCenteredScalarGrid3) ||
+                   type == typeid(SparseVertexCenteredScalarGrid3)) {
+            const auto& grid = static_cast<const SparseScalarGrid3&>(sdf);
+            if (grid.data().numberOfActiveTiles() == 0) {
+                _type = kConstant;
+                _value = grid.data().background();
+            } else {
+                _type = kSparseGrid;
+                _tiledData = &grid.data();
+                _tiledGridSpacing = grid.gridSpacing();
+                _tiledOrigin = grid.dataOrigin();
+            }
+        }
+    }
+
+    double operator()(const Vector3D& pt) const {
+        switch (_type) {
+            case kConstant:
+                return _value;
+            case kGrid:
+                return _gridSampler(pt);
+            case kSparseGrid:
+                return sampleTiled(*_tiledData, _tiledGridSpacing,
+                                   _tiledOrigin, pt);
+            default:
+                return _sdf.sample(pt);
+        }
+    }
+
+ private:
+    enum Type { kConstant, kGrid, kSparseGrid, kGeneric };
+
+    const ScalarField3& _sdf;
+    Type _type = kGeneric;
+    double _value = 0.0;
+    LinearGridSampler3<ScalarGrid3> _gridSampler;
+    const TiledArray3<double>* _tiledData = nullptr;
+    Vector3D _tiledGridSpacing;
+    Vector3D _tiledOrigin;
+};
+
+// 3-D version of backTrace.
+inline Vector3D backTrace(const FlowSampler3& flow, double dt, double h,
+                          const Vector3D& startPt,
+                          const BoundarySampler3& boundarySdf) {
+    double remainingT = dt;
+    Vector3D pt0 = startPt;
+    Vector3D pt1 = startPt;
+
+    while (std::fabs(remainingT) > kEpsilonD) {
+        // Adaptive time-stepping
+        Vector3D vel0 = flow(pt0);
+        double numSubSteps
+            = std::max(std::ceil(vel0.length() * std::fabs(remainingT) / h),
+                       1.0);
+        dt = remainingT / numSubSteps;
+
+        // Mid-point rule
+        Vector3D midPt = pt0 - 0.5 * dt * vel0;
+        Vector3D midVel = flow(midPt);
+        pt1 = pt0 - dt * midVel;
+
+        // Boundary handling
+        double phi0 = boundarySdf(pt0);
+        double phi1 = boundarySdf(pt1);
+
+        if (phi0 * phi1 < 0.0) {
+            double w = std::fabs(phi1) / (std::fabs(phi0) + std::fabs(phi1));
+            pt1 = w * pt0 + (1.0 - w) * pt1;
+            break;
+        }
+
+        remainingT -= dt;
+        pt0 = pt1;
+    }
+
+    return pt1;
+}
+
+}  // namespace jet
+
+#endif  // SRC_JET_SEMI_LAGRANGIAN_HELPERS_H_
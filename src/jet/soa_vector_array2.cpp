@@ -0,0 +1,69 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <jet/parallel.h>
+#include <jet/soa_vector_array2.h>
+
+using namespace jet;
+
+SoaVectorArray2::SoaVectorArray2() {
+}
+
+SoaVectorArray2::SoaVectorArray2(
+    const ConstArrayAccessor1<Vector2D>& vectors) {
+    set(vectors);
+}
+
+size_t SoaVectorArray2::size() const {
+    return _x.size();
+}
+
+void SoaVectorArray2::resize(size_t size) {
+    _x.resize(size, 0.0);
+    _y.resize(size, 0.0);
+}
+
+Vector2D SoaVectorArray2::operator[](size_t i) const {
+    JET_ASSERT(i < size());
+    return Vector2D(_x[i], _y[i]);
+}
+
+void SoaVectorArray2::set(size_t i, const Vector2D& value) {
+    JET_ASSERT(i < size());
+    _x[i] = value.x;
+    _y[i] = value.y;
+}
+
+void SoaVectorArray2::set(const ConstArrayAccessor1<Vector2D>& vectors) {
+    resize(vectors.size());
+    parallelFor(kZeroSize, vectors.size(), [&](size_t i) {
+        set(i, vectors[i]);
+    });
+}
+
+void SoaVectorArray2::copyTo(ArrayAccessor1<Vector2D> vectors) const {
+    JET_THROW_INVALID_ARG_IF(vectors.size() != size());
+    parallelFor(kZeroSize, size(), [&](size_t i) {
+        vectors[i] = (*this)[i];
+    });
+}
+
+double* SoaVectorArray2::x() {
+    return _x.data();
+}
+
+const double* SoaVectorArray2::x() const {
+    return _x.data();
+}
+
+double* SoaVectorArray2::y() {
+    return _y.data();
+}
+
+const double* SoaVectorArray2::y() const {
+    return _y.data();
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <jet/parallel.h>
+#include <jet/soa_vector_array3.h>
+
+using namespace jet;
+
+SoaVectorArray3::SoaVectorArray3() {
+}
+
+SoaVectorArray3::SoaVectorArray3(
+    const ConstArrayAccessor1<Vector3D>& vectors) {
+    set(vectors);
+}
+
+size_t SoaVectorArray3::size() const {
+    return _x.size();
+}
+
+void SoaVectorArray3::resize(size_t size) {
+    _x.resize(size, 0.0);
+    _y.resize(size, 0.0);
+    _z.resize(size, 0.0);
+}
+
+Vector3D SoaVectorArray3::operator[](size_t i) const {
+    JET_ASSERT(i < size());
+    return Vector3D(_x[i], _y[i], _z[i]);
+}
+
+void SoaVectorArray3::set(size_t i, const Vector3D& value) {
+    JET_ASSERT(i < size());
+    _x[i] = value.x;
+    _y[i] = value.y;
+    _z[i] = value.z;
+}
+
+void SoaVectorArray3::set(const ConstArrayAccessor1<Vector3D>& vectors) {
+    resize(vectors.size());
+    parallelFor(kZeroSize, vectors.size(), [&](size_t i) {
+        set(i, vectors[i]);
+    });
+}
+
+void SoaVectorArray3::copyTo(ArrayAccessor1<Vector3D> vectors) const {
+    JET_THROW_INVALID_ARG_IF(vectors.size() != size());
+    parallelFor(kZeroSize, size(), [&](size_t i) {
+        vectors[i] = (*this)[i];
+    });
+}
+
+double* SoaVectorArray3::x() {
+    return _x.data();
+}
+
+const double* SoaVectorArray3::x() const {
+    return _x.data();
+}
+
+double* SoaVectorArray3::y() {
+    return _y.data();
+}
+
+const double* SoaVectorArray3::y() const {
+    return _y.data();
+}
+
+double* SoaVectorArray3::z() {
+    return _z.data();
+}
+
+const double* SoaVectorArray3::z() const {
+    return _z.data();
+}
@@ -0,0 +1,116 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <private_helpers.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
+
+#include <utility>  // just make cpplint happy..
+
+using namespace jet;
+
+SparseCellCenteredScalarGrid3::SparseCellCenteredScalarGrid3() {}
+
+SparseCellCenteredScalarGrid3::SparseCellCenteredScalarGrid3(
+    const Size3& resolution, const Vector3D& gridSpacing,
+    const Vector3D& origin, double background) {
+    resize(resolution, gridSpacing, origin, background);
+}
+
+SparseCellCenteredScalarGrid3::SparseCellCenteredScalarGrid3(
+    const SparseCellCenteredScalarGrid3& other) {
+    set(other);
+}
+
+Size3 SparseCellCenteredScalarGrid3::dataSize() const {
+    // The size of the data should be the same as the grid resolution.
+    return resolution();
+}
+
+Vector3D SparseCellCenteredScalarGrid3::dataOrigin() const {
+    return origin() + 0.5 * gridSpacing();
+}
+
+std::shared_ptr<SparseScalarGrid3> SparseCellCenteredScalarGrid3::clone()
+    const {
+    return CLONE_W_CUSTOM_DELETER(SparseCellCenteredScalarGrid3);
+}
+
+void SparseCellCenteredScalarGrid3::swap(Grid3* other) {
+    SparseCellCenteredScalarGrid3* sameType =
+        dynamic_cast<SparseCellCenteredScalarGrid3*>(other);
+    if (sameType != nullptr) {
+        swapSparseScalarGrid(sameType);
+    }
+}
+
+void SparseCellCenteredScalarGrid3::set(
+    const SparseCellCenteredScalarGrid3& other) {
+    setSparseScalarGrid(other);
+}
+
+SparseCellCenteredScalarGrid3& SparseCellCenteredScalarGrid3::operator=(
+    const SparseCellCenteredScalarGrid3& other) {
+    set(other);
+    return *this;
+}
+
+SparseCellCenteredScalarGrid3::Builder
+SparseCellCenteredScalarGrid3::builder() {
+    return Builder();
+}
+
+SparseCellCenteredScalarGrid3::Builder&
+SparseCellCenteredScalarGrid3::Builder::withResolution(
+    const Size3& resolution) {
+    _resolution = resolution;
+    return *this;
+}
+
+SparseCellCenteredScalarGrid3::Builder&
+SparseCellCenteredScalarGrid3::Builder::withGridSpacing(
+    const Vector3D& gridSpacing) {
+    _gridSpacing = gridSpacing;
+    return *this;
+}
+
+SparseCellCenteredScalarGrid3::Builder&
+SparseCellCenteredScalarGrid3::Builder::withOrigin(
+    const Vector3D& gridOrigin) {
+    _gridOrigin = gridOrigin;
+    return *this;
+}
+
+SparseCellCenteredScalarGrid3::Builder&
+SparseCellCenteredScalarGrid3::Builder::withBackground(double background) {
+    _background = background;
+    return *this;
+}
+
+SparseCellCenteredScalarGrid3
+SparseCellCenteredScalarGrid3::Builder::build() const {
+    return SparseCellCenteredScalarGrid3(_resolution, _gridSpacing,
+                 _gridOrigin, _background);
+}
+
+SparseCellCenteredScalarGrid3Ptr
+SparseCellCenteredScalarGrid3::Builder::makeShared() const {
+    return std::shared_ptr<SparseCellCenteredScalarGrid3>(
+        new SparseCellCenteredScalarGrid3(_resolution, _gridSpacing,
+                  _gridOrigin, _background),
+        [](SparseCellCenteredScalarGrid3* obj) { delete obj; });
+}
+
+SparseScalarGrid3Ptr SparseCellCenteredScalarGrid3::Builder::build(
+    const Size3& resolution,
+    const Vector3D& gridSpacing,
+    const Vector3D& gridOrigin,
+    double background) const {
+    return std::shared_ptr<SparseCellCenteredScalarGrid3>(
+        new SparseCellCenteredScalarGrid3(resolution, gridSpacing,
+                                          gridOrigin, background),
+        [](SparseCellCenteredScalarGrid3* obj) { delete obj; });
+}
@@ -0,0 +1,343 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <fbs_helpers.h>
+#include <generated/vector_grid3_generated.h>
+#include <private_helpers.h>
+#include <sparse_grid_helpers.h>
+
+#include <jet/sparse_face_centered_grid3.h>
+
+#include <flatbuffers/flatbuffers.h>
+
+#include <algorithm>
+#include <utility>  // just make cpplint happy..
+#include <vector>
+
+using namespace jet;
+
+SparseFaceCenteredGrid3::SparseFaceCenteredGrid3() {}
+
+SparseFaceCenteredGrid3::SparseFaceCenteredGrid3(const Size3& resolution,
+                                                 const Vector3D& gridSpacing,
+                                                 const Vector3D& origin,
+                                                 const Vector3D& background) {
+    resize(resolution, gridSpacing, origin, background);
+}
+
+SparseFaceCenteredGrid3::SparseFaceCenteredGrid3(
+    const SparseFaceCenteredGrid3& other) {
+    set(other);
+}
+
+void SparseFaceCenteredGrid3::swap(Grid3* other) {
+    SparseFaceCenteredGrid3* sameType =
+        dynamic_cast<SparseFaceCenteredGrid3*>(other);
+
+    if (sameType != nullptr) {
+        swapGrid(sameType);
+
+        _dataU.swap(sameType->_dataU);
+        _dataV.swap(sameType->_dataV);
+        _dataW.swap(sameType->_dataW);
+        std::swap(_dataOriginU, sameType->_dataOriginU);
+        std::swap(_dataOriginV, sameType->_dataOriginV);
+        std::swap(_dataOriginW, sameType->_dataOriginW);
+    }
+}
+
+void SparseFaceCenteredGrid3::set(const SparseFaceCenteredGrid3& other) {
+    setGrid(other);
+
+    _dataU = other._dataU;
+    _dataV = other._dataV;
+    _dataW = other._dataW;
+    _dataOriginU = other._dataOriginU;
+    _dataOriginV = other._dataOriginV;
+    _dataOriginW = other._dataOriginW;
+}
+
+SparseFaceCenteredGrid3& SparseFaceCenteredGrid3::operator=(
+    const SparseFaceCenteredGrid3& other) {
+    set(other);
+    return *this;
+}
+
+std::shared_ptr<SparseFaceCenteredGrid3> SparseFaceCenteredGrid3::clone()
+    const {
+    return CLONE_W_CUSTOM_DELETER(SparseFaceCenteredGrid3);
+}
+
+void SparseFaceCenteredGrid3::clear() {
+    _dataU.clear();
+    _dataV.clear();
+    _dataW.clear();
+}
+
+void SparseFaceCenteredGrid3::resize(const Size3& resolution,
+                                     const Vector3D& gridSpacing,
+                                     const Vector3D& origin,
+                                     const Vector3D& background) {
+    setSizeParameters(resolution, gridSpacing, origin);
+
+    if (resolution != Size3(0, 0, 0)) {
+        _dataU.resize(resolution + Size3(1, 0, 0), background.x);
+        _dataV.resize(resolution + Size3(0, 1, 0), background.y);
+        _dataW.resize(resolution + Size3(0, 0, 1), background.z);
+    } else {
+        _dataU.resize(Size3(0, 0, 0), background.x);
+        _dataV.resize(Size3(0, 0, 0), background.y);
+        _dataW.resize(Size3(0, 0, 0), background.z);
+    }
+    _dataOriginU = origin + 0.5 * Vector3D(0.0, gridSpacing.y, gridSpacing.z);
+    _dataOriginV = origin + 0.5 * Vector3D(gridSpacing.x, 0.0, gridSpacing.z);
+    _dataOriginW = origin + 0.5 * Vector3D(gridSpacing.x, gridSpacing.y, 0.0);
+}
+
+const double& SparseFaceCenteredGrid3::u(size_t i, size_t j, size_t k) const {
+    return _dataU(i, j, k);
+}
+
+const double& SparseFaceCenteredGrid3::v(size_t i, size_t j, size_t k) const {
+    return _dataV(i, j, k);
+}
+
+const double& SparseFaceCenteredGrid3::w(size_t i, size_t j, size_t k) const {
+    return _dataW(i, j, k);
+}
+
+Vector3D SparseFaceCenteredGrid3::valueAtCellCenter(size_t i, size_t j,
+                                                    size_t k) const {
+    JET_ASSERT(i < resolution().x && j < resolution().y && k < resolution().z);
+
+    return 0.5 * Vector3D(_dataU(i, j, k) + _dataU(i + 1, j, k),
+                          _dataV(i, j, k) + _dataV(i, j + 1, k),
+                          _dataW(i, j, k) + _dataW(i, j, k + 1));
+}
+
+double SparseFaceCenteredGrid3::divergenceAtCellCenter(size_t i, size_t j,
+                                                       size_t k) const {
+    JET_ASSERT(i < resolution().x && j < resolution().y && k < resolution().z);
+
+    const Vector3D& gs = gridSpacing();
+
+    double leftU = _dataU(i, j, k);
+    double rightU = _dataU(i + 1, j, k);
+    double bottomV = _dataV(i, j, k);
+    double topV = _dataV(i, j + 1, k);
+    double backW = _dataW(i, j, k);
+    double frontW = _dataW(i, j, k + 1);
+
+    return (rightU - leftU) / gs.x + (topV - bottomV) / gs.y +
+           (frontW - backW) / gs.z;
+}
+
+TiledArray3<double>& SparseFaceCenteredGrid3::uData() { return _dataU; }
+
+const TiledArray3<double>& SparseFaceCenteredGrid3::uData() const {
+    return _dataU;
+}
+
+TiledArray3<double>& SparseFaceCenteredGrid3::vData() { return _dataV; }
+
+const TiledArray3<double>& SparseFaceCenteredGrid3::vData() const {
+    return _dataV;
+}
+
+TiledArray3<double>& SparseFaceCenteredGrid3::wData() { return _dataW; }
+
+const TiledArray3<double>& SparseFaceCenteredGrid3::wData() const {
+    return _dataW;
+}
+
+Size3 SparseFaceCenteredGrid3::uSize() const { return _dataU.size(); }
+
+Size3 SparseFaceCenteredGrid3::vSize() const { return _dataV.size(); }
+
+Size3 SparseFaceCenteredGrid3::wSize() const { return _dataW.size(); }
+
+Vector3D SparseFaceCenteredGrid3::uOrigin() const { return _dataOriginU; }
+
+Vector3D SparseFaceCenteredGrid3::vOrigin() const { return _dataOriginV; }
+
+Vector3D SparseFaceCenteredGrid3::wOrigin() const { return _dataOriginW; }
+
+size_t SparseFaceCenteredGrid3::numberOfActiveTiles() const {
+    return _dataU.numberOfActiveTiles() + _dataV.numberOfActiveTiles() +
+           _dataW.numberOfActiveTiles();
+}
+
+size_t SparseFaceCenteredGrid3::memoryUsage() const {
+    return _dataU.memoryUsage() + _dataV.memoryUsage() + _dataW.memoryUsage();
+}
+
+void SparseFaceCenteredGrid3::fill(const Vector3D& value) {
+    _dataU.setBackground(value.x);
+    _dataV.setBackground(value.y);
+    _dataW.setBackground(value.z);
+}
+
+void SparseFaceCenteredGrid3::fill(
+    const std::function<Vector3D(const Vector3D&)>& func, double tolerance) {
+    fillTiled([&func](const Vector3D& x) { return func(x).x; },
+              gridSpacing(), _dataOriginU, tolerance, &_dataU);
+    fillTiled([&func](const Vector3D& x) { return func(x).y; },
+              gridSpacing(), _dataOriginV, tolerance, &_dataV);
+    fillTiled([&func](const Vector3D& x) { return func(x).z; },
+              gridSpacing(), _dataOriginW, tolerance, &_dataW);
+}
+
+void SparseFaceCenteredGrid3::copyFrom(const FaceCenteredGrid3& other,
+                                       double tolerance) {
+    JET_ASSERT(other.resolution() == resolution());
+
+    _dataU.copyFrom(other.uConstAccessor(), tolerance);
+    _dataV.copyFrom(other.vConstAccessor(), tolerance);
+    _dataW.copyFrom(other.wConstAccessor(), tolerance);
+}
+
+void SparseFaceCenteredGrid3::copyTo(FaceCenteredGrid3* other) const {
+    JET_ASSERT(other->resolution() == resolution());
+
+    _dataU.copyTo(other->uAccessor());
+    _dataV.copyTo(other->vAccessor());
+    _dataW.copyTo(other->wAccessor());
+}
+
+Vector3D SparseFaceCenteredGrid3::sample(const Vector3D& x) const {
+    return Vector3D(sampleTiled(_dataU, gridSpacing(), _dataOriginU, x),
+                    sampleTiled(_dataV, gridSpacing(), _dataOriginV, x),
+                    sampleTiled(_dataW, gridSpacing(), _dataOriginW, x));
+}
+
+double SparseFaceCenteredGrid3::divergence(const Vector3D& x) const {
+    std::array<Point3UI, 8> indices;
+    std::array<double, 8> weights;
+    getTiledCoordinatesAndWeights(resolution(), gridSpacing(),
+                                  origin() + 0.5 * gridSpacing(), x, &indices,
+                                  &weights);
+
+    double result = 0.0;
+
+    for (int n = 0; n < 8; ++n) {
+        result += weights[n] * divergenceAtCellCenter(
+                                   indices[n].x, indices[n].y, indices[n].z);
+    }
+
+    return result;
+}
+
+void SparseFaceCenteredGrid3::serialize(std::vector<uint8_t>* buffer) const {
+    flatbuffers::FlatBufferBuilder builder(1024);
+
+    auto fbsResolution = jetToFbs(resolution());
+    auto fbsGridSpacing = jetToFbs(gridSpacing());
+    auto fbsOrigin = jetToFbs(origin());
+
+    std::vector<double> gridData;
+    getData(&gridData);
+    auto data = builder.CreateVector(gridData.data(), gridData.size());
+
+    auto fbsGrid = fbs::CreateVectorGrid3(builder, &fbsResolution,
+                                          &fbsGridSpacing, &fbsOrigin, data);
+
+    builder.Finish(fbsGrid);
+
+    uint8_t* buf = builder.GetBufferPointer();
+    size_t size = builder.GetSize();
+
+    buffer->resize(size);
+    memcpy(buffer->data(), buf, size);
+}
+
+void SparseFaceCenteredGrid3::deserialize(const std::vector<uint8_t>& buffer) {
+    auto fbsGrid = fbs::GetVectorGrid3(buffer.data());
+
+    resize(fbsToJet(*fbsGrid->resolution()), fbsToJet(*fbsGrid->gridSpacing()),
+           fbsToJet(*fbsGrid->origin()),
+           Vector3D(_dataU.background(), _dataV.background(),
+                    _dataW.background()));
+
+    auto data = fbsGrid->data();
+    std::vector<double> gridData(data->size());
+    std::copy(data->begin(), data->end(), gridData.begin());
+
+    setData(gridData);
+}
+
+SparseFaceCenteredGrid3::Builder SparseFaceCenteredGrid3::builder() {
+    return Builder();
+}
+
+void SparseFaceCenteredGrid3::getData(std::vector<double>* data) const {
+    const Size3 us = uSize();
+    const Size3 vs = vSize();
+    const Size3 ws = wSize();
+    const size_t uCount = us.x * us.y * us.z;
+    const size_t vCount = vs.x * vs.y * vs.z;
+    const size_t wCount = ws.x * ws.y * ws.z;
+    data->resize(uCount + vCount + wCount);
+
+    double* ptr = data->data();
+    _dataU.copyTo(ArrayAccessor3<double>(us, ptr));
+    _dataV.copyTo(ArrayAccessor3<double>(vs, ptr + uCount));
+    _dataW.copyTo(ArrayAccessor3<double>(ws, ptr + uCount + vCount));
+}
+
+void SparseFaceCenteredGrid3::setData(const std::vector<double>& data) {
+    const Size3 us = uSize();
+    const Size3 vs = vSize();
+    const Size3 ws = wSize();
+    const size_t uCount = us.x * us.y * us.z;
+    const size_t vCount = vs.x * vs.y * vs.z;
+    JET_ASSERT(uCount + vCount + ws.x * ws.y * ws.z == data.size());
+
+    const double* ptr = data.data();
+    _dataU.copyFrom(ConstArrayAccessor3<double>(us, ptr));
+    _dataV.copyFrom(ConstArrayAccessor3<double>(vs, ptr + uCount));
+    _dataW.copyFrom(ConstArrayAccessor3<double>(ws, ptr + uCount + vCount));
+}
+
+SparseFaceCenteredGrid3::Builder&
+SparseFaceCenteredGrid3::Builder::withResolution(const Size3& resolution) {
+    _resolution = resolution;
+    return *this;
+}
+
+SparseFaceCenteredGrid3::Builder&
+SparseFaceCenteredGrid3::Builder::withGridSpacing(
+    const Vector3D& gridSpacing) {
+    _gridSpacing = gridSpacing;
+    return *this;
+}
+
+SparseFaceCenteredGrid3::Builder&
+SparseFaceCenteredGrid3::Builder::withOrigin(const Vector3D& gridOrigin) {
+    _gridOrigin = gridOrigin;
+    return *this;
+}
+
+SparseFaceCenteredGrid3::Builder&
+SparseFaceCenteredGrid3::Builder::withBackground(
+    const Vector3D& background) {
+    _background = background;
+    return *this;
+}
+
+SparseFaceCenteredGrid3 SparseFaceCenteredGrid3::Builder::build() const {
+    return SparseFaceCenteredGrid3(_resolution, _gridSpacing, _gridOrigin,
+                                   _background);
+}
+
+SparseFaceCenteredGrid3Ptr SparseFaceCenteredGrid3::Builder::makeShared()
+    const {
+    return std::shared_ptr<SparseFaceCenteredGrid3>(
+        new SparseFaceCenteredGrid3(_resolution, _gridSpacing, _gridOrigin,
+                                    _background),
+        [](SparseFaceCenteredGrid3* obj) { delete obj; });
+}
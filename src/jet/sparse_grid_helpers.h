@@ -0,0 +1,164 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_SPARSE_GRID_HELPERS_H_
+#define SRC_JET_SPARSE_GRID_HELPERS_H_
+
+#include <jet/constants.h>
+#include <jet/math_utils.h>
+#include <jet/parallel.h>
+#include <jet/point3.h>
+#include <jet/tiled_array3.h>
+#include <jet/vector3.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace jet {
+
+// Returns the data points and the weights for the linear interpolation at
+// \p x, the same as LinearArraySampler3 does for a dense array.
+inline void getTiledCoordinatesAndWeights(const Size3& size,
+                                          const Vector3D& gridSpacing,
+                                          const Vector3D& origin,
+                                          const Vector3D& x,
+                                          std::array<Point3UI, 8>* indices,
+                                          std::array<double, 8>* weights) {
+    ssize_t i, j, k;
+    double fx, fy, fz;
+
+    const Vector3D normalizedX = (x - origin) / gridSpacing;
+
+    const ssize_t iSize = static_cast<ssize_t>(size.x);
+    const ssize_t jSize = static_cast<ssize_t>(size.y);
+    const ssize_t kSize = static_cast<ssize_t>(size.z);
+
+    getBarycentric(normalizedX.x, 0, iSize - 1, &i, &fx);
+    getBarycentric(normalizedX.y, 0, jSize - 1, &j, &fy);
+    getBarycentric(normalizedX.z, 0, kSize - 1, &k, &fz);
+
+    const ssize_t ip1 = std::min(i + 1, iSize - 1);
+    const ssize_t jp1 = std::min(j + 1, jSize - 1);
+    const ssize_t kp1 = std::min(k + 1, kSize - 1);
+
+    (*indices)[0] = Point3UI(i, j, k);
+    (*indices)[1] = Point3UI(ip1, j, k);
+    (*indices)[2] = Point3UI(i, jp1, k);
+    (*indices)[3] = Point3UI(ip1, jp1, k);
+    (*indices)[4] = Point3UI(i, j, kp1);
+    (*indices)[5] = Point3UI(ip1, j, kp1);
+    (*indices)[6] = Point3UI(i, jp1, kp1);
+    (*indices)[7] = Point3UI(ip1, jp1, kp1);
+
+    (*weights)[0] = (1 - fx) * (1 - fy) * (1 - fz);
+    (*weights)[1] = fx * (1 - fy) * (1 - fz);
+    (*weights)[2] = (1 - fx) * fy * (1 - fz);
+    (*weights)[3] = fx * fy * (1 - fz);
+    (*weights)[4] = (1 - fx) * (1 - fy) * fz;
+    (*weights)[5] = fx * (1 - fy) * fz;
+    (*weights)[6] = (1 - fx) * fy * fz;
+    (*weights)[7] = fx * fy * fz;
+}
+
+// Linearly interpolates the tiled data at \p x.
+inline double sampleTiled(const TiledArray3<double>& data,
+                          const Vector3D& gridSpacing, const Vector3D& origin,
+                          const Vector3D& x) {
+    std::array<Point3UI, 8> indices;
+    std::array<double, 8> weights;
+    getTiledCoordinatesAndWeights(data.size(), gridSpacing, origin, x,
+                                  &indices, &weights);
+
+    double result = 0.0;
+    for (int n = 0; n < 8; ++n) {
+        result +=
+            weights[n] * data(indices[n].x, indices[n].y, indices[n].z);
+    }
+    return result;
+}
+
+// Fills the tiled data with the position-to-value mapping function. Only the
+// tiles with a value farther than \p tolerance from the background are
+// activated. The function is evaluated once per data point.
+inline void fillTiled(const std::function<double(const Vector3D&)>& func,
+                      const Vector3D& gridSpacing, const Vector3D& origin,
+                      double tolerance, TiledArray3<double>* data) {
+    const size_t tileSize = TiledArray3<double>::kTileSize;
+    const Size3 size = data->size();
+    const Size3 tiles = data->tileResolution();
+    const double background = data->background();
+
+    // Evaluates the tiles in parallel and keeps the values of the occupied
+    // ones until they are activated.
+    std::vector<std::vector<double>> tileValues(tiles.x * tiles.y * tiles.z);
+    parallelFor(kZeroSize, tiles.x, kZeroSize, tiles.y, kZeroSize, tiles.z,
+                [&](size_t ti, size_t tj, size_t tk) {
+                    const size_t iEnd = std::min((ti + 1) * tileSize, size.x);
+                    const size_t jEnd = std::min((tj + 1) * tileSize, size.y);
+                    const size_t kEnd = std::min((tk + 1) * tileSize, size.z);
+
+                    std::array<double, TiledArray3<double>::kTileVolume>
+                        values;
+                    size_t n = 0;
+                    bool occupied = false;
+                    for (size_t k = tk * tileSize; k < kEnd; ++k) {
+                        for (size_t j = tj * tileSize; j < jEnd; ++j) {
+                            for (size_t i = ti * tileSize; i < iEnd; ++i) {
+                                const double value = func(
+                                    origin + gridSpacing * Vector3D(i, j, k));
+                                occupied |=
+                                    std::fabs(value - background) > tolerance;
+                                values[n++] = value;
+                            }
+                        }
+                    }
+
+                    if (occupied) {
+                        tileValues[ti + tiles.x * (tj + tiles.y * tk)].assign(
+                            values.begin(), values.begin() + n);
+                    }
+                });
+
+    data->clear();
+    for (size_t tk = 0; tk < tiles.z; ++tk) {
+        for (size_t tj = 0; tj < tiles.y; ++tj) {
+            for (size_t ti = 0; ti < tiles.x; ++ti) {
+                if (!tileValues[ti + tiles.x * (tj + tiles.y * tk)].empty()) {
+                    data->activateTile(ti, tj, tk);
+                }
+            }
+        }
+    }
+
+    parallelFor(kZeroSize, tiles.x, kZeroSize, tiles.y, kZeroSize, tiles.z,
+                [&](size_t ti, size_t tj, size_t tk) {
+                    const std::vector<double>& values =
+                        tileValues[ti + tiles.x * (tj + tiles.y * tk)];
+                    if (values.empty()) {
+                        return;
+                    }
+
+                    const size_t iEnd = std::min((ti + 1) * tileSize, size.x);
+                    const size_t jEnd = std::min((tj + 1) * tileSize, size.y);
+                    const size_t kEnd = std::min((tk + 1) * tileSize, size.z);
+
+                    size_t n = 0;
+                    for (size_t k = tk * tileSize; k < kEnd; ++k) {
+                        for (size_t j = tj * tileSize; j < jEnd; ++j) {
+                            for (size_t i = ti * tileSize; i < iEnd; ++i) {
+                                *data->find(i, j, k) = values[n++];
+                            }
+                        }
+                    }
+                });
+}
+
+}  // namespace jet
+
+#endif  // SRC_JET_SPARSE_GRID_HELPERS_H_
@@ -0,0 +1,182 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <fbs_helpers.h>
+#include <generated/scalar_grid3_generated.h>
+#include <sparse_grid_helpers.h>
+
+#include <jet/sparse_scalar_grid3.h>
+
+#include <flatbuffers/flatbuffers.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace jet;
+
+SparseScalarGrid3::SparseScalarGrid3() {}
+
+SparseScalarGrid3::~SparseScalarGrid3() {}
+
+void SparseScalarGrid3::clear() { _data.clear(); }
+
+void SparseScalarGrid3::resize(const Size3& resolution,
+                               const Vector3D& gridSpacing,
+                               const Vector3D& origin, double background) {
+    setSizeParameters(resolution, gridSpacing, origin);
+
+    _data.resize(dataSize(), background);
+}
+
+const double& SparseScalarGrid3::operator()(size_t i, size_t j,
+                                            size_t k) const {
+    return _data(i, j, k);
+}
+
+Vector3D SparseScalarGrid3::gradientAtDataPoint(size_t i, size_t j,
+                                                size_t k) const {
+    const Size3 ds = _data.size();
+
+    JET_ASSERT(i < ds.x && j < ds.y && k < ds.z);
+
+    const double left = _data((i > 0) ? i - 1 : i, j, k);
+    const double right = _data((i + 1 < ds.x) ? i + 1 : i, j, k);
+    const double down = _data(i, (j > 0) ? j - 1 : j, k);
+    const double up = _data(i, (j + 1 < ds.y) ? j + 1 : j, k);
+    const double back = _data(i, j, (k > 0) ? k - 1 : k);
+    const double front = _data(i, j, (k + 1 < ds.z) ? k + 1 : k);
+
+    return 0.5 * Vector3D(right - left, up - down, front - back) /
+           gridSpacing();
+}
+
+TiledArray3<double>& SparseScalarGrid3::data() { return _data; }
+
+const TiledArray3<double>& SparseScalarGrid3::data() const { return _data; }
+
+SparseScalarGrid3::DataPositionFunc SparseScalarGrid3::dataPosition() const {
+    Vector3D o = dataOrigin();
+    Vector3D h = gridSpacing();
+    return [o, h](size_t i, size_t j, size_t k) -> Vector3D {
+        return o + h * Vector3D({i, j, k});
+    };
+}
+
+void SparseScalarGrid3::fill(double value) { _data.setBackground(value); }
+
+void SparseScalarGrid3::fill(
+    const std::function<double(const Vector3D&)>& func, double tolerance) {
+    fillTiled(func, gridSpacing(), dataOrigin(), tolerance, &_data);
+}
+
+void SparseScalarGrid3::copyFrom(const ScalarGrid3& other, double tolerance) {
+    JET_ASSERT(other.dataSize() == dataSize());
+
+    _data.copyFrom(other.constDataAccessor(), tolerance);
+}
+
+void SparseScalarGrid3::copyTo(ScalarGrid3* other) const {
+    JET_ASSERT(other->dataSize() == dataSize());
+
+    _data.copyTo(other->dataAccessor());
+}
+
+void SparseScalarGrid3::forEachActiveDataPointIndex(
+    const std::function<void(size_t, size_t, size_t)>& func) const {
+    _data.forEachActiveIndex(func);
+}
+
+void SparseScalarGrid3::parallelForEachActiveDataPointIndex(
+    const std::function<void(size_t, size_t, size_t)>& func) const {
+    _data.parallelForEachActiveIndex(func);
+}
+
+double SparseScalarGrid3::sample(const Vector3D& x) const {
+    return sampleTiled(_data, gridSpacing(), dataOrigin(), x);
+}
+
+Vector3D SparseScalarGrid3::gradient(const Vector3D& x) const {
+    std::array<Point3UI, 8> indices;
+    std::array<double, 8> weights;
+    getTiledCoordinatesAndWeights(_data.size(), gridSpacing(), dataOrigin(),
+                                  x, &indices, &weights);
+
+    Vector3D result;
+
+    for (int i = 0; i < 8; ++i) {
+        result += weights[i] *
+                  gradientAtDataPoint(indices[i].x, indices[i].y, indices[i].z);
+    }
+
+    return result;
+}
+
+void SparseScalarGrid3::serialize(std::vector<uint8_t>* buffer) const {
+    flatbuffers::FlatBufferBuilder builder(1024);
+
+    auto fbsResolution = jetToFbs(resolution());
+    auto fbsGridSpacing = jetToFbs(gridSpacing());
+    auto fbsOrigin = jetToFbs(origin());
+
+    std::vector<double> gridData;
+    getData(&gridData);
+    auto data = builder.CreateVector(gridData.data(), gridData.size());
+
+    auto fbsGrid = fbs::CreateScalarGrid3(builder, &fbsResolution,
+                                          &fbsGridSpacing, &fbsOrigin, data);
+
+    builder.Finish(fbsGrid);
+
+    uint8_t* buf = builder.GetBufferPointer();
+    size_t size = builder.GetSize();
+
+    buffer->resize(size);
+    memcpy(buffer->data(), buf, size);
+}
+
+void SparseScalarGrid3::deserialize(const std::vector<uint8_t>& buffer) {
+    auto fbsGrid = fbs::GetScalarGrid3(buffer.data());
+
+    resize(fbsToJet(*fbsGrid->resolution()), fbsToJet(*fbsGrid->gridSpacing()),
+           fbsToJet(*fbsGrid->origin()), _data.background());
+
+    auto data = fbsGrid->data();
+    std::vector<double> gridData(data->size());
+    std::copy(data->begin(), data->end(), gridData.begin());
+
+    setData(gridData);
+}
+
+void SparseScalarGrid3::swapSparseScalarGrid(SparseScalarGrid3* other) {
+    swapGrid(other);
+
+    _data.swap(other->_data);
+}
+
+void SparseScalarGrid3::setSparseScalarGrid(const SparseScalarGrid3& other) {
+    setGrid(other);
+
+    _data = other._data;
+}
+
+void SparseScalarGrid3::getData(std::vector<double>* data) const {
+    const Size3 ds = dataSize();
+    data->resize(ds.x * ds.y * ds.z);
+    _data.copyTo(ArrayAccessor3<double>(ds, data->data()));
+}
+
+void SparseScalarGrid3::setData(const std::vector<double>& data) {
+    const Size3 ds = dataSize();
+    JET_ASSERT(ds.x * ds.y * ds.z == data.size());
+
+    _data.copyFrom(ConstArrayAccessor3<double>(ds, data.data()));
+}
+
+SparseScalarGridBuilder3::SparseScalarGridBuilder3() {}
+
+SparseScalarGridBuilder3::~SparseScalarGridBuilder3() {}
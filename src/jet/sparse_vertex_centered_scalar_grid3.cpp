@@ -0,0 +1,119 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+#include <private_helpers.h>
+#include <jet/sparse_vertex_centered_scalar_grid3.h>
+
+#include <utility>  // just make cpplint happy..
+
+using namespace jet;
+
+SparseVertexCenteredScalarGrid3::SparseVertexCenteredScalarGrid3() {}
+
+SparseVertexCenteredScalarGrid3::SparseVertexCenteredScalarGrid3(
+    const Size3& resolution, const Vector3D& gridSpacing,
+    const Vector3D& origin, double background) {
+    resize(resolution, gridSpacing, origin, background);
+}
+
+SparseVertexCenteredScalarGrid3::SparseVertexCenteredScalarGrid3(
+    const SparseVertexCenteredScalarGrid3& other) {
+    set(other);
+}
+
+Size3 SparseVertexCenteredScalarGrid3::dataSize() const {
+    if (resolution() != Size3(0, 0, 0)) {
+        return resolution() + Size3(1, 1, 1);
+    } else {
+        return Size3(0, 0, 0);
+    }
+}
+
+Vector3D SparseVertexCenteredScalarGrid3::dataOrigin() const {
+    return origin();
+}
+
+std::shared_ptr<SparseScalarGrid3> SparseVertexCenteredScalarGrid3::clone()
+    const {
+    return CLONE_W_CUSTOM_DELETER(SparseVertexCenteredScalarGrid3);
+}
+
+void SparseVertexCenteredScalarGrid3::swap(Grid3* other) {
+    SparseVertexCenteredScalarGrid3* sameType =
+        dynamic_cast<SparseVertexCenteredScalarGrid3*>(other);
+    if (sameType != nullptr) {
+        swapSparseScalarGrid(sameType);
+    }
+}
+
+void SparseVertexCenteredScalarGrid3::set(
+    const SparseVertexCenteredScalarGrid3& other) {
+    setSparseScalarGrid(other);
+}
+
+SparseVertexCenteredScalarGrid3& SparseVertexCenteredScalarGrid3::operator=(
+    const SparseVertexCenteredScalarGrid3& other) {
+    set(other);
+    return *this;
+}
+
+SparseVertexCenteredScalarGrid3::Builder
+SparseVertexCenteredScalarGrid3::builder() {
+    return Builder();
+}
+
+SparseVertexCenteredScalarGrid3::Builder&
+SparseVertexCenteredScalarGrid3::Builder::withResolution(
+    const Size3& resolution) {
+    _resolution = resolution;
+    return *this;
+}
+
+SparseVertexCenteredScalarGrid3::Builder&
+SparseVertexCenteredScalarGrid3::Builder::withGridSpacing(
+    const Vector3D& gridSpacing) {
+    _gridSpacing = gridSpacing;
+    return *this;
+}
+
+SparseVertexCenteredScalarGrid3::Builder&
+SparseVertexCenteredScalarGrid3::Builder::withOrigin(
+    const Vector3D& gridOrigin) {
+    _gridOrigin = gridOrigin;
+    return *this;
+}
+
+SparseVertexCenteredScalarGrid3::Builder&
+SparseVertexCenteredScalarGrid3::Builder::withBackground(double background) {
+    _background = background;
+    return *this;
+}
+
+SparseVertexCenteredScalarGrid3
+SparseVertexCenteredScalarGrid3::Builder::build() const {
+    return SparseVertexCenteredScalarGrid3(_resolution, _gridSpacing,
+                 _gridOrigin, _background);
+}
+
+SparseVertexCenteredScalarGrid3Ptr
+SparseVertexCenteredScalarGrid3::Builder::makeShared() const {
+    return std::shared_ptr<SparseVertexCenteredScalarGrid3>(
+        new SparseVertexCenteredScalarGrid3(_resolution, _gridSpacing,
+                  _gridOrigin, _background),
+        [](SparseVertexCenteredScalarGrid3* obj) { delete obj; });
+}
+
+SparseScalarGrid3Ptr SparseVertexCenteredScalarGrid3::Builder::build(
+    const Size3& resolution,
+    const Vector3D& gridSpacing,
+    const Vector3D& gridOrigin,
+    double background) const {
+    return std::shared_ptr<SparseVertexCenteredScalarGrid3>(
+        new SparseVertexCenteredScalarGrid3(resolution, gridSpacing,
+                                            gridOrigin, background),
+        [](SparseVertexCenteredScalarGrid3* obj) { delete obj; });
+}
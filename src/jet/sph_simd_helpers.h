@@ -0,0 +1,215 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_SPH_SIMD_HELPERS_H_
+#define SRC_JET_SPH_SIMD_HELPERS_H_
+
+#include <jet/array_accessor1.h>
+#include <jet/simd.h>
+#include <jet/soa_vector_array2.h>
+#include <jet/soa_vector_array3.h>
+#include <jet/sph_kernels2.h>
+#include <jet/sph_kernels3.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace jet {
+
+// Invokes func(indices, mask) for every kSimdDoubleWidth neighbors. The last
+// chunk is padded with a valid neighbor index, and the mask zeroes out the
+// padded lanes.
+template <typename Func>
+inline void forEachNeighborChunk(
+    const ConstArrayAccessor1<uint32_t>& neighbors,
+    const Func& func) {
+    const size_t n = neighbors.size();
+    size_t k = 0;
+    for (; k + kSimdDoubleWidth <= n; k += kSimdDoubleWidth) {
+        func(neighbors.data() + k, SimdDouble(1.0));
+    }
+
+    if (k < n) {
+        uint32_t tail[kSimdDoubleWidth];
+        for (size_t l = 0; l < kSimdDoubleWidth; ++l) {
+            tail[l] = neighbors[k + std::min(l, n - k - 1)];
+        }
+        func(tail, SimdDouble::laneMask(n - k));
+    }
+}
+
+inline double sumOfKernelNearby(
+    const SphStdKernel2& kernel,
+    const SoaVectorArray2& positions,
+    size_t i,
+    const ConstArrayAccessor1<uint32_t>& neighbors) {
+    const SimdDouble xi(positions.x()[i]);
+    const SimdDouble yi(positions.y()[i]);
+    SimdDouble sum;
+
+    forEachNeighborChunk(neighbors, [&](const uint32_t* j, SimdDouble mask) {
+        const SimdDouble dx = SimdDouble::gather(positions.x(), j) - xi;
+        const SimdDouble dy = SimdDouble::gather(positions.y(), j) - yi;
+        const SimdDouble dist = SimdDouble::sqrt(dx * dx + dy * dy);
+        sum += mask * kernel(dist);
+    });
+
+    return sum.sum();
+}
+
+inline double sumOfKernelNearby(
+    const SphStdKernel3& kernel,
+    const SoaVectorArray3& positions,
+    size_t i,
+    const ConstArrayAccessor1<uint32_t>& neighbors) {
+    const SimdDouble xi(positions.x()[i]);
+    const SimdDouble yi(positions.y()[i]);
+    const SimdDouble zi(positions.z()[i]);
+    SimdDouble sum;
+
+    forEachNeighborChunk(neighbors, [&](const uint32_t* j, SimdDouble mask) {
+        const SimdDouble dx = SimdDouble::gather(positions.x(), j) - xi;
+        const SimdDouble dy = SimdDouble::gather(positions.y(), j) - yi;
+        const SimdDouble dz = SimdDouble::gather(positions.z(), j) - zi;
+        const SimdDouble dist = SimdDouble::sqrt(dx * dx + dy * dy + dz * dz);
+        sum += mask * kernel(dist);
+    });
+
+    return sum.sum();
+}
+
+// Returns the symmetric pressure gradient force on i-th particle divided by
+// the squared mass.
+inline Vector2D pressureForceNearby(
+    const SphSpikyKernel2& kernel,
+    const SoaVectorArray2& positions,
+    const ConstArrayAccessor1<double>& densities,
+    const ConstArrayAccessor1<double>& pressures,
+    size_t i,
+    const ConstArrayAccessor1<uint32_t>& neighbors) {
+    const SimdDouble xi(positions.x()[i]);
+    const SimdDouble yi(positions.y()[i]);
+    const SimdDouble ci(pressures[i] / (densities[i] * densities[i]));
+    SimdDouble fx, fy;
+
+    forEachNeighborChunk(neighbors, [&](const uint32_t* j, SimdDouble mask) {
+        const SimdDouble dx = SimdDouble::gather(positions.x(), j) - xi;
+        const SimdDouble dy = SimdDouble::gather(positions.y(), j) - yi;
+        const SimdDouble dist = SimdDouble::sqrt(dx * dx + dy * dy);
+        const SimdDouble dj = SimdDouble::gather(densities.data(), j);
+        const SimdDouble pj = SimdDouble::gather(pressures.data(), j);
+
+        // -(ci + cj) * gradient(dist, dir) with dir = (xj - xi) / dist
+        const SimdDouble c = mask * (ci + pj / (dj * dj))
+            * kernel.firstDerivative(dist)
+            * SimdDouble::reciprocalIfPositive(dist);
+        fx += c * dx;
+        fy += c * dy;
+    });
+
+    return Vector2D(fx.sum(), fy.sum());
+}
+
+// Returns the symmetric pressure gradient force on i-th particle divided by
+// the squared mass.
+inline Vector3D pressureForceNearby(
+    const SphSpikyKernel3& kernel,
+    const SoaVectorArray3& positions,
+    const ConstArrayAccessor1<double>& densities,
+    const ConstArrayAccessor1<double>& pressures,
+    size_t i,
+    const ConstArrayAccessor1<uint32_t>& neighbors) {
+    const SimdDouble xi(positions.x()[i]);
+    const SimdDouble yi(positions.y()[i]);
+    const SimdDouble zi(positions.z()[i]);
+    const SimdDouble ci(pressures[i] / (densities[i] * densities[i]));
+    SimdDouble fx, fy, fz;
+
+    forEachNeighborChunk(neighbors, [&](const uint32_t* j, SimdDouble mask) {
+        const SimdDouble dx = SimdDouble::gather(positions.x(), j) - xi;
+        const SimdDouble dy = SimdDouble::gather(positions.y(), j) - yi;
+        const SimdDouble dz = SimdDouble::gather(positions.z(), j) - zi;
+        const SimdDouble dist = SimdDouble::sqrt(dx * dx + dy * dy + dz * dz);
+        const SimdDouble dj = SimdDouble::gather(densities.data(), j);
+        const SimdDouble pj = SimdDouble::gather(pressures.data(), j);
+
+        // -(ci + cj) * gradient(dist, dir) with dir = (xj - xi) / dist
+        const SimdDouble c = mask * (ci + pj / (dj * dj))
+            * kernel.firstDerivative(dist)
+            * SimdDouble::reciprocalIfPositive(dist);
+        fx += c * dx;
+        fy += c * dy;
+        fz += c * dz;
+    });
+
+    return Vector3D(fx.sum(), fy.sum(), fz.sum());
+}
+
+// Returns the viscosity force on i-th particle divided by the squared mass and
+// the viscosity coefficient.
+inline Vector2D viscosityForceNearby(
+    const SphSpikyKernel2& kernel,
+    const SoaVectorArray2& positions,
+    const SoaVectorArray2& velocities,
+    const ConstArrayAccessor1<double>& densities,
+    size_t i,
+    const ConstArrayAccessor1<uint32_t>& neighbors) {
+    const SimdDouble xi(positions.x()[i]);
+    const SimdDouble yi(positions.y()[i]);
+    const SimdDouble ui(velocities.x()[i]);
+    const SimdDouble vi(velocities.y()[i]);
+    SimdDouble fx, fy;
+
+    forEachNeighborChunk(neighbors, [&](const uint32_t* j, SimdDouble mask) {
+        const SimdDouble dx = SimdDouble::gather(positions.x(), j) - xi;
+        const SimdDouble dy = SimdDouble::gather(positions.y(), j) - yi;
+        const SimdDouble dist = SimdDouble::sqrt(dx * dx + dy * dy);
+        const SimdDouble dj = SimdDouble::gather(densities.data(), j);
+
+        const SimdDouble c = mask * kernel.secondDerivative(dist) / dj;
+        fx += c * (SimdDouble::gather(velocities.x(), j) - ui);
+        fy += c * (SimdDouble::gather(velocities.y(), j) - vi);
+    });
+
+    return Vector2D(fx.sum(), fy.sum());
+}
+
+// Returns the viscosity force on i-th particle divided by the squared mass and
+// the viscosity coefficient.
+inline Vector3D viscosityForceNearby(
+    const SphSpikyKernel3& kernel,
+    const SoaVectorArray3& positions,
+    const SoaVectorArray3& velocities,
+    const ConstArrayAccessor1<double>& densities,
+    size_t i,
+    const ConstArrayAccessor1<uint32_t>& neighbors) {
+    const SimdDouble xi(positions.x()[i]);
+    const SimdDouble yi(positions.y()[i]);
+    const SimdDouble zi(positions.z()[i]);
+    const SimdDouble ui(velocities.x()[i]);
+    const SimdDouble vi(velocities.y()[i]);
+    const SimdDouble wi(velocities.z()[i]);
+    SimdDouble fx, fy, fz;
+
+    forEachNeighborChunk(neighbors, [&](const uint32_t* j, SimdDouble mask) {
+        const SimdDouble dx = SimdDouble::gather(positions.x(), j) - xi;
+        const SimdDouble dy = SimdDouble::gather(positions.y(), j) - yi;
+        const SimdDouble dz = SimdDouble::gather(positions.z(), j) - zi;
+        const SimdDouble dist = SimdDouble::sqrt(dx * dx + dy * dy + dz * dz);
+        const SimdDouble dj = SimdDouble::gather(densities.data(), j);
+
+        const SimdDouble c = mask * kernel.secondDerivative(dist) / dj;
+        fx += c * (SimdDouble::gather(velocities.x(), j) - ui);
+        fy += c * (SimdDouble::gather(velocities.y(), j) - vi);
+        fz += c * (SimdDouble::gather(velocities.z(), j) - wi);
+    });
+
+    return Vector3D(fx.sum(), fy.sum(), fz.sum());
+}
+
+}  // namespace jet
+
+#endif  // SRC_JET_SPH_SIMD_HELPERS_H_
@@ -6,10 +6,12 @@
 
 #include <pch.h>
 #include <physics_helpers.h>
+#include <sph_simd_helpers.h>
 #include <jet/parallel.h>
+#include <jet/profiler.h>
+#include <jet/reducers.h>
 #include <jet/sph_kernels2.h>
 #include <jet/sph_solver2.h>
-#include <jet/timer.h>
 
 #include <algorithm>
 
@@ -102,11 +104,10 @@ unsigned int SphSolver2::numberOfSubTimeSteps(
     const double kernelRadius = particles->kernelRadius();
     const double mass = particles->mass();
 
-    double maxForceMagnitude = 0.0;
-
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        maxForceMagnitude = std::max(maxForceMagnitude, f[i].length());
-    }
+    const double maxForceMagnitude = parallelMapReduce(
+        kZeroSize, numberOfParticles,
+        [&](size_t i) { return f[i].length(); },
+        MaxReducer<double>(0.0));
 
     double timeStepLimitBySpeed
         = kTimeStepLimitBySpeedFactor * kernelRadius / _speedOfSound;
@@ -132,14 +133,10 @@ void SphSolver2::onBeginAdvanceTimeStep(double timeStepInSeconds) {
 
     auto particles = sphSystemData();
 
-    Timer timer;
+    JET_PROFILE_SCOPE("SphSolver2::onBeginAdvanceTimeStep");
     particles->buildNeighborSearcher();
     particles->buildNeighborLists();
     particles->updateDensities();
-
-    JET_INFO << "Building neighbor lists and updating densities took "
-             << timer.durationInSeconds()
-             << " seconds";
 }
 
 void SphSolver2::onEndAdvanceTimeStep(double timeStepInSeconds) {
@@ -149,14 +146,17 @@ void SphSolver2::onEndAdvanceTimeStep(double timeStepInSeconds) {
     size_t numberOfParticles = particles->numberOfParticles();
     auto densities = particles->densities();
 
-    double maxDensity = 0.0;
-    for (size_t i = 0; i < numberOfParticles; ++i) {
-        maxDensity = std::max(maxDensity, densities[i]);
-    }
+    // The max density is only reported, so skip it when nobody listens
+    if (JET_LOG_IS_ON(LoggingLevel::Info)) {
+        const double maxDensity = parallelMapReduce(
+            kZeroSize, numberOfParticles,
+            [&](size_t i) { return densities[i]; },
+            MaxReducer<double>(0.0));
 
-    JET_INFO << "Max density: " << maxDensity << " "
-             << "Max density / target density ratio: "
-             << maxDensity / particles->targetDensity();
+        JET_INFO << "Max density: " << maxDensity << " "
+                 << "Max density / target density ratio: "
+                 << maxDensity / particles->targetDensity();
+    }
 }
 
 void SphSolver2::accumulateNonPressureForces(double timeStepInSeconds) {
@@ -213,11 +213,31 @@ void SphSolver2::accumulatePressureForce(
     const double massSquared = square(particles->mass());
     const SphSpikyKernel2 kernel(particles->kernelRadius());
 
+    if (particles->isUsingSoaLayout()) {
+        // Reuse the SoA copy if the positions are the particles' own.
+        SoaVectorArray2 convertedPositions;
+        const SoaVectorArray2* soaPositions = &particles->soaPositions();
+        if (positions.data() != particles->positions().data()) {
+            convertedPositions.set(positions);
+            soaPositions = &convertedPositions;
+        }
+
+        parallelFor(
+            kZeroSize,
+            numberOfParticles,
+            [&](size_t i) {
+                pressureForces[i] += massSquared * pressureForceNearby(
+                    kernel, *soaPositions, densities, pressures, i,
+                    particles->neighborLists()[i]);
+            });
+        return;
+    }
+
     parallelFor(
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
+            const auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = positions[i].distanceTo(positions[j]);
 
@@ -244,11 +264,27 @@ void SphSolver2::accumulateViscosityForce() {
     const double massSquared = square(particles->mass());
     const SphSpikyKernel2 kernel(particles->kernelRadius());
 
+    if (particles->isUsingSoaLayout()) {
+        const auto& soaPositions = particles->soaPositions();
+        const auto& soaVelocities = particles->soaVelocities();
+
+        parallelFor(
+            kZeroSize,
+            numberOfParticles,
+            [&](size_t i) {
+                f[i] += viscosityCoefficient() * massSquared
+                    * viscosityForceNearby(
+                        kernel, soaPositions, soaVelocities, d, i,
+                        particles->neighborLists()[i]);
+            });
+        return;
+    }
+
     parallelFor(
         kZeroSize,
         numberOfParticles,
         [&](size_t i) {
-            const auto& neighbors = particles->neighborLists()[i];
+            const auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = x[i].distanceTo(x[j]);
 
@@ -278,7 +314,7 @@ void SphSolver2::computePseudoViscosity(double timeStepInSeconds) {
             double weightSum = 0.0;
             Vector2D smoothedVelocity;
 
-            const auto& neighbors = particles->neighborLists()[i];
+            const auto neighbors = particles->neighborLists()[i];
             for (size_t j : neighbors) {
                 double dist = x[i].distanceTo(x[j]);
                 double wj = mass / d[j] * kernel(dist);
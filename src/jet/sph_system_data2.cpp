@@ -12,6 +12,7 @@
 #include <pch.h>
 
 #include <fbs_helpers.h>
+#include <sph_simd_helpers.h>
 #include <generated/sph_system_data2_generated.h>
 
 #include <jet/parallel.h>
@@ -70,6 +71,19 @@ void SphSystemData2::updateDensities() {
     auto d = densities();
     const double m = mass();
 
+    if (isUsingSoaLayout() && neighborLists().size() == numberOfParticles()) {
+        const SphStdKernel2 kernel(_kernelRadius);
+        const double selfWeight = kernel(0.0);
+        const auto& soaPositions = this->soaPositions();
+
+        parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
+            double sum = jet::sumOfKernelNearby(
+                kernel, soaPositions, i, neighborLists()[i]);
+            d[i] = m * (sum + selfWeight);
+        });
+        return;
+    }
+
     parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
         double sum = sumOfKernelNearby(p[i]);
         d[i] = m * sum;
@@ -118,7 +132,7 @@ double SphSystemData2::kernelRadius() const { return _kernelRadius; }
 double SphSystemData2::sumOfKernelNearby(const Vector2D& origin) const {
     double sum = 0.0;
     SphStdKernel2 kernel(_kernelRadius);
-    neighborSearcher()->forEachNearbyPoint(
+    forEachNearbyPoint(
         origin, _kernelRadius, [&](size_t, const Vector2D& neighborPosition) {
             double dist = origin.distanceTo(neighborPosition);
             sum += kernel(dist);
@@ -133,7 +147,7 @@ double SphSystemData2::interpolate(
     SphStdKernel2 kernel(_kernelRadius);
     const double m = mass();
 
-    neighborSearcher()->forEachNearbyPoint(
+    forEachNearbyPoint(
         origin, _kernelRadius, [&](size_t i, const Vector2D& neighborPosition) {
             double dist = origin.distanceTo(neighborPosition);
             double weight = m / d[i] * kernel(dist);
@@ -150,7 +164,7 @@ Vector2D SphSystemData2::interpolate(
     SphStdKernel2 kernel(_kernelRadius);
     const double m = mass();
 
-    neighborSearcher()->forEachNearbyPoint(
+    forEachNearbyPoint(
         origin, _kernelRadius, [&](size_t i, const Vector2D& neighborPosition) {
             double dist = origin.distanceTo(neighborPosition);
             double weight = m / d[i] * kernel(dist);
@@ -165,7 +179,7 @@ Vector2D SphSystemData2::gradientAt(
     Vector2D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    const auto neighbors = neighborLists()[i];
     Vector2D origin = p[i];
     SphSpikyKernel2 kernel(_kernelRadius);
     const double m = mass();
@@ -189,7 +203,7 @@ double SphSystemData2::laplacianAt(
     double sum = 0.0;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    const auto neighbors = neighborLists()[i];
     Vector2D origin = p[i];
     SphSpikyKernel2 kernel(_kernelRadius);
     const double m = mass();
@@ -209,7 +223,7 @@ Vector2D SphSystemData2::laplacianAt(
     Vector2D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    const auto neighbors = neighborLists()[i];
     Vector2D origin = p[i];
     SphSpikyKernel2 kernel(_kernelRadius);
     const double m = mass();
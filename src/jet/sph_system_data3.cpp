@@ -12,6 +12,7 @@
 #include <pch.h>
 
 #include <fbs_helpers.h>
+#include <sph_simd_helpers.h>
 #include <generated/sph_system_data3_generated.h>
 
 #include <jet/bcc_lattice_point_generator.h>
@@ -70,6 +71,19 @@ void SphSystemData3::updateDensities() {
     auto d = densities();
     const double m = mass();
 
+    if (isUsingSoaLayout() && neighborLists().size() == numberOfParticles()) {
+        const SphStdKernel3 kernel(_kernelRadius);
+        const double selfWeight = kernel(0.0);
+        const auto& soaPositions = this->soaPositions();
+
+        parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
+            double sum = jet::sumOfKernelNearby(
+                kernel, soaPositions, i, neighborLists()[i]);
+            d[i] = m * (sum + selfWeight);
+        });
+        return;
+    }
+
     parallelFor(kZeroSize, numberOfParticles(), [&](size_t i) {
         double sum = sumOfKernelNearby(p[i]);
         d[i] = m * sum;
@@ -118,7 +132,7 @@ double SphSystemData3::kernelRadius() const { return _kernelRadius; }
 double SphSystemData3::sumOfKernelNearby(const Vector3D& origin) const {
     double sum = 0.0;
     SphStdKernel3 kernel(_kernelRadius);
-    neighborSearcher()->forEachNearbyPoint(
+    forEachNearbyPoint(
         origin, _kernelRadius, [&](size_t, const Vector3D& neighborPosition) {
             double dist = origin.distanceTo(neighborPosition);
             sum += kernel(dist);
@@ -133,7 +147,7 @@ double SphSystemData3::interpolate(
     SphStdKernel3 kernel(_kernelRadius);
     const double m = mass();
 
-    neighborSearcher()->forEachNearbyPoint(
+    forEachNearbyPoint(
         origin, _kernelRadius, [&](size_t i, const Vector3D& neighborPosition) {
             double dist = origin.distanceTo(neighborPosition);
             double weight = m / d[i] * kernel(dist);
@@ -150,7 +164,7 @@ Vector3D SphSystemData3::interpolate(
     SphStdKernel3 kernel(_kernelRadius);
     const double m = mass();
 
-    neighborSearcher()->forEachNearbyPoint(
+    forEachNearbyPoint(
         origin, _kernelRadius, [&](size_t i, const Vector3D& neighborPosition) {
             double dist = origin.distanceTo(neighborPosition);
             double weight = m / d[i] * kernel(dist);
@@ -165,7 +179,7 @@ Vector3D SphSystemData3::gradientAt(
     Vector3D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    const auto neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
@@ -189,7 +203,7 @@ double SphSystemData3::laplacianAt(
     double sum = 0.0;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    const auto neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
@@ -209,7 +223,7 @@ Vector3D SphSystemData3::laplacianAt(
     Vector3D sum;
     auto p = positions();
     auto d = densities();
-    const auto& neighbors = neighborLists()[i];
+    const auto neighbors = neighborLists()[i];
     Vector3D origin = p[i];
     SphSpikyKernel3 kernel(_kernelRadius);
     const double m = mass();
@@ -39,12 +39,10 @@ void SphericalPointsToImplicit3::convert(
     particles.addParticles(points);
     particles.buildNeighborSearcher(2.0 * _radius);
 
-    const auto neighborSearcher = particles.neighborSearcher();
-
     auto temp = output->clone();
     temp->fill([&](const Vector3D& x) {
         double minDist = 2.0 * _radius;
-        neighborSearcher->forEachNearbyPoint(
+        particles.forEachNearbyPoint(
             x, 2.0 * _radius, [&](size_t, const Vector3D& xj) {
                 minDist = std::min(minDist, (x - xj).length());
             });
@@ -0,0 +1,257 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <pch.h>
+
+#include <thread_pool.h>
+#include <jet/parallel.h>
+
+#include <exception>
+#include <utility>
+
+using namespace jet;
+
+namespace {
+
+// The pool and the deque index of the worker running on this thread.
+thread_local const ThreadPool* tPool = nullptr;
+thread_local size_t tQueueIndex = 0;
+
+// Completion state of a ThreadPool::run call, which lives on the stack of the
+// calling thread.
+struct Job {
+    const std::function<void(size_t)>* func;
+    size_t remaining;
+    std::exception_ptr exception;
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    void runChunk(size_t chunk) {
+        std::exception_ptr e;
+        try {
+            (*func)(chunk);
+        } catch (...) {
+            e = std::current_exception();
+        }
+
+        // The caller can return as soon as it sees the last chunk done, so
+        // nothing may touch the job after the lock is released.
+        std::lock_guard<std::mutex> lock(mutex);
+        if (e && !exception) {
+            exception = e;
+        }
+        if (--remaining == 0) {
+            condition.notify_all();
+        }
+    }
+
+    bool isDone() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return remaining == 0;
+    }
+};
+
+unsigned int defaultNumberOfWorkers() {
+    const unsigned int numThreadsHint = maxNumberOfThreads();
+    return (numThreadsHint == 0u ? 8u : numThreadsHint) - 1u;
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(unsigned int numberOfWorkers)
+    : _numberOfQueuedTasks(0) {
+    start(numberOfWorkers);
+}
+
+ThreadPool::~ThreadPool() { stop(); }
+
+unsigned int ThreadPool::numberOfWorkers() const {
+    return static_cast<unsigned int>(_workers.size());
+}
+
+void ThreadPool::resize(unsigned int numberOfWorkers) {
+    if (numberOfWorkers != _workers.size()) {
+        stop();
+        start(numberOfWorkers);
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    if (_workers.empty()) {
+        task();
+        return;
+    }
+
+    std::vector<Task> tasks(1, std::move(task));
+    push(currentQueueIndex(), &tasks);
+}
+
+void ThreadPool::run(size_t numberOfChunks,
+                     const std::function<void(size_t)>& func) {
+    if (_workers.empty() || numberOfChunks == 1) {
+        for (size_t chunk = 0; chunk < numberOfChunks; ++chunk) {
+            func(chunk);
+        }
+        return;
+    }
+
+    if (numberOfChunks == 0) {
+        return;
+    }
+
+    Job job;
+    job.func = &func;
+    job.remaining = numberOfChunks;
+
+    // The owner pops from the back, so push in reverse to run the chunks in
+    // order. The first chunk is kept for the calling thread.
+    std::vector<Task> tasks;
+    tasks.reserve(numberOfChunks - 1);
+    for (size_t chunk = numberOfChunks - 1; chunk > 0; --chunk) {
+        Job* jobPtr = &job;
+        tasks.emplace_back([jobPtr, chunk]() { jobPtr->runChunk(chunk); });
+    }
+
+    const size_t queueIndex = currentQueueIndex();
+    push(queueIndex, &tasks);
+
+    job.runChunk(0);
+
+    // Help with the pending tasks, possibly of other loops, until all the
+    // chunks are done. If there is nothing left to take, the remaining
+    // chunks are running on the other threads.
+    Task task;
+    while (!job.isDone()) {
+        if (pop(queueIndex, &task)) {
+            task();
+            task = nullptr;
+        } else {
+            std::unique_lock<std::mutex> lock(job.mutex);
+            job.condition.wait(lock, [&job]() { return job.remaining == 0; });
+        }
+    }
+
+    if (job.exception) {
+        std::rethrow_exception(job.exception);
+    }
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool(defaultNumberOfWorkers());
+    return pool;
+}
+
+void ThreadPool::start(unsigned int numberOfWorkers) {
+    _stop = false;
+
+    // One deque per worker, plus the injection deque for the other threads
+    _queues.clear();
+    for (unsigned int i = 0; i <= numberOfWorkers; ++i) {
+        _queues.emplace_back(new Queue());
+    }
+
+    _workers.reserve(numberOfWorkers);
+    for (unsigned int i = 0; i < numberOfWorkers; ++i) {
+        _workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _sleepCondition.notify_all();
+
+    for (std::thread& worker : _workers) {
+        worker.join();
+    }
+    _workers.clear();
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    tPool = this;
+    tQueueIndex = index;
+
+    Task task;
+    while (true) {
+        if (pop(index, &task)) {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _sleepCondition.wait(lock, [this]() {
+            return _stop || _numberOfQueuedTasks > 0;
+        });
+
+        if (_stop && _numberOfQueuedTasks == 0) {
+            break;
+        }
+    }
+
+    tPool = nullptr;
+}
+
+size_t ThreadPool::currentQueueIndex() const {
+    return (tPool == this) ? tQueueIndex : _queues.size() - 1;
+}
+
+void ThreadPool::push(size_t queueIndex, std::vector<Task>* tasks) {
+    Queue& queue = *_queues[queueIndex];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (Task& task : *tasks) {
+            queue.tasks.push_back(std::move(task));
+        }
+    }
+
+    _numberOfQueuedTasks += tasks->size();
+
+    // Taking the lock makes sure that a worker about to sleep sees the count
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+    }
+    if (tasks->size() == 1) {
+        _sleepCondition.notify_one();
+    } else {
+        _sleepCondition.notify_all();
+    }
+}
+
+bool ThreadPool::pop(size_t queueIndex, Task* task) {
+    if (_numberOfQueuedTasks == 0) {
+        return false;
+    }
+
+    // Own deque first, newest task first
+    {
+        Queue& queue = *_queues[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            *task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            --_numberOfQueuedTasks;
+            return true;
+        }
+    }
+
+    // Then steal the oldest task from the others
+    const size_t numberOfQueues = _queues.size();
+    for (size_t i = 1; i < numberOfQueues; ++i) {
+        Queue& queue = *_queues[(queueIndex + i) % numberOfQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            *task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            --_numberOfQueuedTasks;
+            return true;
+        }
+    }
+
+    return false;
+}
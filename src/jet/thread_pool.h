@@ -0,0 +1,94 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#ifndef SRC_JET_THREAD_POOL_H_
+#define SRC_JET_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jet {
+
+//!
+//! \brief Persistent work-stealing thread pool.
+//!
+//! Each worker owns a task deque. A worker pops tasks from the back of its own
+//! deque and steals from the front of the others when it runs out of work.
+//! Tasks submitted from outside the pool go to a shared injection deque. A
+//! thread waiting for a parallel loop keeps running the pending tasks, so the
+//! loops can be nested without deadlocks.
+//!
+class ThreadPool {
+ public:
+    //! Constructs a pool with given number of worker threads.
+    explicit ThreadPool(unsigned int numberOfWorkers);
+
+    //! Finishes the pending tasks and joins the worker threads.
+    ~ThreadPool();
+
+    //! Returns the number of worker threads.
+    unsigned int numberOfWorkers() const;
+
+    //!
+    //! \brief Restarts the pool with given number of worker threads.
+    //!
+    //! The pending tasks are finished by the old workers first. This function
+    //! should not be called while a parallel loop is running.
+    //!
+    void resize(unsigned int numberOfWorkers);
+
+    //! Submits a task without waiting for it.
+    void submit(std::function<void()> task);
+
+    //!
+    //! \brief Calls \p func for each chunk index in [0, \p numberOfChunks).
+    //!
+    //! The calling thread runs the chunks together with the workers and
+    //! returns when all the chunks are done. An exception thrown by a chunk
+    //! is rethrown to the caller.
+    //!
+    void run(size_t numberOfChunks, const std::function<void(size_t)>& func);
+
+    //! Returns the pool shared by the parallel functions.
+    static ThreadPool& instance();
+
+ private:
+    typedef std::function<void()> Task;
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> _workers;
+    std::vector<std::unique_ptr<Queue>> _queues;
+    std::atomic<size_t> _numberOfQueuedTasks;
+    std::mutex _sleepMutex;
+    std::condition_variable _sleepCondition;
+    bool _stop = false;
+
+    void start(unsigned int numberOfWorkers);
+
+    void stop();
+
+    void workerLoop(size_t index);
+
+    size_t currentQueueIndex() const;
+
+    void push(size_t queueIndex, std::vector<Task>* tasks);
+
+    bool pop(size_t queueIndex, Task* task);
+};
+
+}  // namespace jet
+
+#endif  // SRC_JET_THREAD_POOL_H_
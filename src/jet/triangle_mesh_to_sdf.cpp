@@ -28,8 +28,10 @@
 // SOFTWARE.
 
 #include <pch.h>
+#include <fast_sweeping_helpers.h>
 #include <jet/array_utils.h>
 #include <jet/array3.h>
+#include <jet/parallel.h>
 #include <jet/triangle_mesh_to_sdf.h>
 #include <algorithm>
 #include <vector>
@@ -38,6 +40,10 @@ using namespace jet;
 
 namespace jet {
 
+// Number of grid points along each axis of the tiles which the triangles are
+// binned into. Each tile is processed by a single task.
+static const ssize_t kTileSize = 8;
+
 static void checkNeighbor(
     const TriangleMesh3& mesh,
     const Vector3D& gx,
@@ -49,8 +55,11 @@ static void checkNeighbor(
     ssize_t k1,
     ScalarGrid3* sdf,
     Array3<size_t>* closestTri) {
-    if ((*closestTri)(i1, j1, k1) != kMaxSize) {
-        size_t t = (*closestTri)(i1, j1, k1);
+    size_t t = (*closestTri)(i1, j1, k1);
+
+    // The distance to the current closest triangle is already known, so only
+    // a different triangle can shorten it.
+    if (t != kMaxSize && t != (*closestTri)(i0, j0, k0)) {
         Triangle3 tri = mesh.triangle(t);
 
         double d = tri.closestDistance(gx);
@@ -62,6 +71,9 @@ static void checkNeighbor(
     }
 }
 
+// Sweeps in the direction (di, dj, dk), propagating the closest triangles
+// from the upwind neighbors. The first layer along each axis has no upwind
+// neighbor and is skipped.
 static void sweep(
     const TriangleMesh3& mesh,
     int di,
@@ -73,58 +85,75 @@ static void sweep(
     Vector3D h = sdf->gridSpacing();
     Vector3D origin = sdf->dataOrigin();
 
-    ssize_t ni = static_cast<ssize_t>(size.x);
-    ssize_t nj = static_cast<ssize_t>(size.y);
-    ssize_t nk = static_cast<ssize_t>(size.z);
-
-    ssize_t i0, i1;
-    if (di > 0) {
-        i0 = 1;
-        i1 = ni;
-    } else {
-        i0 = ni - 2;
-        i1 = -1;
-    }
+    ssize_t iFirst = (di > 0) ? 0 : static_cast<ssize_t>(size.x) - 1;
+    ssize_t jFirst = (dj > 0) ? 0 : static_cast<ssize_t>(size.y) - 1;
+    ssize_t kFirst = (dk > 0) ? 0 : static_cast<ssize_t>(size.z) - 1;
+
+    sweepBlocks(size, di < 0, dj < 0, dk < 0,
+        [&](size_t iU, size_t jU, size_t kU) {
+            ssize_t i = static_cast<ssize_t>(iU);
+            ssize_t j = static_cast<ssize_t>(jU);
+            ssize_t k = static_cast<ssize_t>(kU);
+            if (i == iFirst || j == jFirst || k == kFirst) {
+                return;
+            }
 
-    ssize_t j0, j1;
-    if (dj > 0) {
-        j0 = 1;
-        j1 = nj;
-    } else {
-        j0 = nj - 2;
-        j1 = -1;
-    }
+            Vector3D gx({ i, j, k });
+            gx *= h;
+            gx += origin;
+
+            checkNeighbor(
+                mesh, gx, i, j, k, i - di, j, k, sdf, closestTri);
+            checkNeighbor(
+                mesh, gx, i, j, k, i, j - dj, k, sdf, closestTri);
+            checkNeighbor(
+                mesh, gx, i, j, k, i - di, j - dj, k, sdf, closestTri);
+            checkNeighbor(
+                mesh, gx, i, j, k, i, j, k - dk, sdf, closestTri);
+            checkNeighbor(
+                mesh, gx, i, j, k, i - di, j, k - dk, sdf, closestTri);
+            checkNeighbor(
+                mesh, gx, i, j, k, i, j - dj, k - dk, sdf, closestTri);
+            checkNeighbor(
+                mesh, gx, i, j, k, i - di, j - dj, k - dk, sdf, closestTri);
+        });
+}
 
-    ssize_t k0, k1;
-    if (dk > 0) {
-        k0 = 1;
-        k1 = nk;
-    } else {
-        k0 = nk - 2;
-        k1 = -1;
-    }
+// Appends each triangle index to the tiles overlapped by its index range
+// [lower, upper]. The triangles are visited in order, so each tile lists its
+// triangles in increasing order.
+static void binTriangles(
+    const std::vector<Point3I>& lower,
+    const std::vector<Point3I>& upper,
+    const Size3& numberOfTiles,
+    std::vector<std::vector<size_t>>* tiles) {
+    tiles->assign(
+        numberOfTiles.x * numberOfTiles.y * numberOfTiles.z,
+        std::vector<size_t>());
+
+    for (size_t t = 0; t < lower.size(); ++t) {
+        if (lower[t].x > upper[t].x
+            || lower[t].y > upper[t].y
+            || lower[t].z > upper[t].z) {
+            continue;
+        }
 
-    for (ssize_t k = k0; k != k1; k += dk) {
-        for (ssize_t j = j0; j != j1; j += dj) {
-            for (ssize_t i = i0; i != i1; i += di) {
-                Vector3D gx({ i, j, k });
-                gx *= h;
-                gx += origin;
-
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j - dj, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j - dj, k, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i, j - dj, k - dk, sdf, closestTri);
-                checkNeighbor(
-                    mesh, gx, i, j, k, i - di, j - dj, k - dk, sdf, closestTri);
+        Point3UI tileLower(
+            static_cast<size_t>(lower[t].x / kTileSize),
+            static_cast<size_t>(lower[t].y / kTileSize),
+            static_cast<size_t>(lower[t].z / kTileSize));
+        Point3UI tileUpper(
+            static_cast<size_t>(upper[t].x / kTileSize),
+            static_cast<size_t>(upper[t].y / kTileSize),
+            static_cast<size_t>(upper[t].z / kTileSize));
+
+        for (size_t tk = tileLower.z; tk <= tileUpper.z; ++tk) {
+            for (size_t tj = tileLower.y; tj <= tileUpper.y; ++tj) {
+                for (size_t ti = tileLower.x; ti <= tileUpper.x; ++ti) {
+                    size_t n = ti + numberOfTiles.x
+                        * (tj + numberOfTiles.y * tk);
+                    (*tiles)[n].push_back(t);
+                }
             }
         }
     }
@@ -219,7 +248,9 @@ void triangleMeshToSdf(
     Array3<unsigned int> intersectionCount(size, 0);
 
     // We begin by initializing distances near the mesh, and figuring out
-    // intersection counts
+    // intersection counts. The index ranges of the triangles are computed
+    // first, and the triangles are binned into tiles so that each grid point
+    // is only written by the task of its own tile.
 
     auto gridPos = sdf->dataPosition();
 
@@ -228,10 +259,14 @@ void triangleMeshToSdf(
     ssize_t maxSizeX = static_cast<ssize_t>(size.x);
     ssize_t maxSizeY = static_cast<ssize_t>(size.y);
     ssize_t maxSizeZ = static_cast<ssize_t>(size.z);
-    for (size_t t = 0; t < nTri; ++t) {
-        Point3UI indices = mesh.pointIndex(t);
 
-        Triangle3 tri = mesh.triangle(t);
+    std::vector<Point3I> distanceLower(nTri);
+    std::vector<Point3I> distanceUpper(nTri);
+    std::vector<Point3I> countLower(nTri);
+    std::vector<Point3I> countUpper(nTri);
+
+    parallelFor(kZeroSize, nTri, [&](size_t t) {
+        Point3UI indices = mesh.pointIndex(t);
 
         Vector3D pt1 = mesh.point(indices.x);
         Vector3D pt2 = mesh.point(indices.y);
@@ -242,7 +277,7 @@ void triangleMeshToSdf(
         Vector3D f2 = (pt2 - origin) / h;
         Vector3D f3 = (pt3 - origin) / h;
 
-        // Do distances nearby
+        // Range of distances nearby
         ssize_t i0 = static_cast<ssize_t>(min3<double>(f1.x, f2.x, f3.x));
         i0 = clamp(i0 - bandwidth, kZeroSSize, maxSizeX - 1);
         ssize_t i1 = static_cast<ssize_t>(max3<double>(f1.x, f2.x, f3.x));
@@ -258,20 +293,10 @@ void triangleMeshToSdf(
         ssize_t k1 = static_cast<ssize_t>(max3<double>(f1.z, f2.z, f3.z));
         k1 = clamp(k1 + bandwidth + 1, kZeroSSize, maxSizeZ - 1);
 
-        for (ssize_t k = k0; k <= k1; ++k) {
-            for (ssize_t j = j0; j <= j1; ++j) {
-                for (ssize_t i = i0; i <= i1; ++i) {
-                    Vector3D gx = gridPos(i, j, k);
-                    double d = tri.closestDistance(gx);
-                    if (d < (*sdf)(i, j, k)) {
-                        (*sdf)(i, j, k) = d;
-                        closestTri(i, j, k) = t;
-                    }
-                }
-            }
-        }
+        distanceLower[t] = Point3I(i0, j0, k0);
+        distanceUpper[t] = Point3I(i1, j1, k1);
 
-        // Do intersection counts
+        // Range of intersection counts, which only spans the (j, k) rows
         j0 = static_cast<ssize_t>(std::ceil(min3<double>(f1.y, f2.y, f3.y)));
         j0 = clamp(j0 - bandwidth, kZeroSSize, maxSizeY - 1);
         j1 = static_cast<ssize_t>(std::floor(max3<double>(f1.y, f2.y, f3.y)));
@@ -281,31 +306,104 @@ void triangleMeshToSdf(
         k1 = static_cast<ssize_t>(std::floor(max3<double>(f1.z, f2.z, f3.z)));
         k1 = clamp(k1 + bandwidth + 1, kZeroSSize, maxSizeZ - 1);
 
-        for (ssize_t k = k0; k <= k1; ++k) {
-            for (ssize_t j = j0; j <= j1; ++j) {
-                double a, b, c;
-                double jD = static_cast<double>(j);
-                double kD = static_cast<double>(k);
-                if (pointInTriangle2D(
-                    jD, kD, f1.y, f1.z, f2.y, f2.z, f3.y, f3.z, &a, &b, &c)) {
-                    // intersection i coordinate
-                    double fi = a * f1.x + b * f2.x + c * f3.x;
-
-                    // intersection is in (iInterval - 1, iInterval]
-                    int iInterval = static_cast<int>(std::ceil(fi));
-                    if (iInterval < 0) {
-                        // we enlarge the first interval to include everything
-                        // to the -x direction
-                        ++intersectionCount(0, j, k);
-                    } else if (iInterval < static_cast<int>(size.x)) {
-                        ++intersectionCount(iInterval, j, k);
+        countLower[t] = Point3I(0, j0, k0);
+        countUpper[t] = Point3I(0, j1, k1);
+    });
+
+    const size_t tileSize = static_cast<size_t>(kTileSize);
+    const Size3 numberOfTiles(
+        (size.x + tileSize - 1) / tileSize,
+        (size.y + tileSize - 1) / tileSize,
+        (size.z + tileSize - 1) / tileSize);
+
+    // Do distances nearby. The triangles of a tile are visited in increasing
+    // order, so the ties are resolved the same way as the serial loop.
+    std::vector<std::vector<size_t>> tiles;
+    binTriangles(distanceLower, distanceUpper, numberOfTiles, &tiles);
+
+    parallelFor(kZeroSize, tiles.size(), [&](size_t n) {
+        const ssize_t ti = static_cast<ssize_t>(n % numberOfTiles.x);
+        const ssize_t tj = static_cast<ssize_t>(
+            (n / numberOfTiles.x) % numberOfTiles.y);
+        const ssize_t tk = static_cast<ssize_t>(
+            n / (numberOfTiles.x * numberOfTiles.y));
+
+        for (size_t t : tiles[n]) {
+            Triangle3 tri = mesh.triangle(t);
+
+            ssize_t i0 = std::max(distanceLower[t].x, ti * kTileSize);
+            ssize_t i1 = std::min(distanceUpper[t].x, (ti + 1) * kTileSize - 1);
+            ssize_t j0 = std::max(distanceLower[t].y, tj * kTileSize);
+            ssize_t j1 = std::min(distanceUpper[t].y, (tj + 1) * kTileSize - 1);
+            ssize_t k0 = std::max(distanceLower[t].z, tk * kTileSize);
+            ssize_t k1 = std::min(distanceUpper[t].z, (tk + 1) * kTileSize - 1);
+
+            for (ssize_t k = k0; k <= k1; ++k) {
+                for (ssize_t j = j0; j <= j1; ++j) {
+                    for (ssize_t i = i0; i <= i1; ++i) {
+                        Vector3D gx = gridPos(i, j, k);
+                        double d = tri.closestDistance(gx);
+                        if (d < (*sdf)(i, j, k)) {
+                            (*sdf)(i, j, k) = d;
+                            closestTri(i, j, k) = t;
+                        }
                     }
-                    // we ignore intersections that are beyond the +x side of
-                    // the grid
                 }
             }
         }
-    }
+    });
+
+    // Do intersection counts. A (j, k) row is only touched by the task of
+    // the tile column containing it.
+    binTriangles(
+        countLower,
+        countUpper,
+        Size3(1, numberOfTiles.y, numberOfTiles.z),
+        &tiles);
+
+    parallelFor(kZeroSize, tiles.size(), [&](size_t n) {
+        const ssize_t tj = static_cast<ssize_t>(n % numberOfTiles.y);
+        const ssize_t tk = static_cast<ssize_t>(n / numberOfTiles.y);
+
+        for (size_t t : tiles[n]) {
+            Point3UI indices = mesh.pointIndex(t);
+
+            Vector3D f1 = (mesh.point(indices.x) - origin) / h;
+            Vector3D f2 = (mesh.point(indices.y) - origin) / h;
+            Vector3D f3 = (mesh.point(indices.z) - origin) / h;
+
+            ssize_t j0 = std::max(countLower[t].y, tj * kTileSize);
+            ssize_t j1 = std::min(countUpper[t].y, (tj + 1) * kTileSize - 1);
+            ssize_t k0 = std::max(countLower[t].z, tk * kTileSize);
+            ssize_t k1 = std::min(countUpper[t].z, (tk + 1) * kTileSize - 1);
+
+            for (ssize_t k = k0; k <= k1; ++k) {
+                for (ssize_t j = j0; j <= j1; ++j) {
+                    double a, b, c;
+                    double jD = static_cast<double>(j);
+                    double kD = static_cast<double>(k);
+                    if (pointInTriangle2D(
+                        jD, kD, f1.y, f1.z, f2.y, f2.z, f3.y, f3.z,
+                        &a, &b, &c)) {
+                        // intersection i coordinate
+                        double fi = a * f1.x + b * f2.x + c * f3.x;
+
+                        // intersection is in (iInterval - 1, iInterval]
+                        int iInterval = static_cast<int>(std::ceil(fi));
+                        if (iInterval < 0) {
+                            // we enlarge the first interval to include
+                            // everything to the -x direction
+                            ++intersectionCount(0, j, k);
+                        } else if (iInterval < static_cast<int>(size.x)) {
+                            ++intersectionCount(iInterval, j, k);
+                        }
+                        // we ignore intersections that are beyond the +x
+                        // side of the grid
+                    }
+                }
+            }
+        }
+    });
 
     // and now we fill in the rest of the distances with fast sweeping
     for (unsigned int pass = 0; pass < 2; ++pass) {
@@ -320,7 +418,7 @@ void triangleMeshToSdf(
     }
 
     // then figure out signs (inside/outside) from intersection counts
-    for (size_t k = 0; k < size.z; ++k) {
+    parallelFor(kZeroSize, size.z, [&](size_t k) {
         for (size_t j = 0; j < size.y; ++j) {
             unsigned int totalCount = 0U;
             for (size_t i = 0; i < size.x; ++i) {
@@ -332,7 +430,7 @@ void triangleMeshToSdf(
                 }
             }
         }
-    }
+    });
 }
 
 }  // namespace jet
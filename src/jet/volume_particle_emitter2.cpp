@@ -51,12 +51,12 @@ void VolumeParticleEmitter2::onUpdate(double currentTimeInSeconds,
         return;
     }
 
-    Array1<Vector2D> newPositions;
-    Array1<Vector2D> newVelocities;
+    _newPositions.clear();
+    _newVelocities.clear();
 
-    emit(particles, &newPositions, &newVelocities);
+    emit(particles, &_newPositions, &_newVelocities);
 
-    particles->addParticles(newPositions, newVelocities);
+    particles->addParticles(_newPositions, _newVelocities);
 }
 
 void VolumeParticleEmitter2::emit(const ParticleSystemData2Ptr& particles,
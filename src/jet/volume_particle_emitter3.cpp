@@ -50,12 +50,12 @@ void VolumeParticleEmitter3::onUpdate(double currentTimeInSeconds,
         return;
     }
 
-    Array1<Vector3D> newPositions;
-    Array1<Vector3D> newVelocities;
+    _newPositions.clear();
+    _newVelocities.clear();
 
-    emit(particles, &newPositions, &newVelocities);
+    emit(particles, &_newPositions, &_newVelocities);
 
-    particles->addParticles(newPositions, newVelocities);
+    particles->addParticles(_newPositions, _newVelocities);
 }
 
 void VolumeParticleEmitter3::emit(const ParticleSystemData3Ptr& particles,
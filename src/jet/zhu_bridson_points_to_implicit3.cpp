@@ -44,7 +44,6 @@ void ZhuBridsonPointsToImplicit3::convert(
     particles.addParticles(points);
     particles.buildNeighborSearcher(_kernelRadius);
 
-    const auto neighborSearcher = particles.neighborSearcher();
     const double isoContValue = _cutOffThreshold * _kernelRadius;
 
     auto temp = output->clone();
@@ -56,7 +55,7 @@ void ZhuBridsonPointsToImplicit3::convert(
             wSum += wi;
             xAvg += wi * xi;
         };
-        neighborSearcher->forEachNearbyPoint(x, _kernelRadius, func);
+        particles.forEachNearbyPoint(x, _kernelRadius, func);
 
         if (wSum > 0.0) {
             xAvg /= wSum;
@@ -0,0 +1,128 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_amgpcg_solver.h"
+#include "pybind11_utils.h"
+
+#include <jet/fdm_amgpcg_solver2.h>
+#include <jet/fdm_amgpcg_solver3.h>
+
+namespace py = pybind11;
+using namespace jet;
+
+void addFdmAmgpcgSolver2(py::module& m) {
+    py::class_<FdmAmgpcgSolver2, FdmAmgpcgSolver2Ptr, FdmLinearSystemSolver2>(
+        m, "FdmAmgpcgSolver2",
+        R"pbdoc(
+        2-D finite difference-type linear system solver using conjugate gradient
+        preconditioned by algebraic multigrid.
+        )pbdoc")
+        .def(py::init([](uint32_t maxNumberOfIterations, double tolerance,
+                         size_t maxNumberOfLevels, uint32_t smootherDegree,
+                         double strengthThreshold) {
+                 AmgParameters params;
+                 params.maxNumberOfLevels = maxNumberOfLevels;
+                 params.smootherDegree = smootherDegree;
+                 params.strengthThreshold = strengthThreshold;
+                 return std::make_shared<FdmAmgpcgSolver2>(
+                     maxNumberOfIterations, tolerance, params);
+             }),
+             py::arg("maxNumberOfIterations"), py::arg("tolerance"),
+             py::arg("maxNumberOfLevels") = 10, py::arg("smootherDegree") = 3,
+             py::arg("strengthThreshold") = 0.08)
+        .def_property_readonly("maxNumberOfIterations",
+                               &FdmAmgpcgSolver2::maxNumberOfIterations,
+                               R"pbdoc(
+            Max number of AMGPCG iterations.
+            )pbdoc")
+        .def_property_readonly("lastNumberOfIterations",
+                               &FdmAmgpcgSolver2::lastNumberOfIterations,
+                               R"pbdoc(
+            The last number of AMGPCG iterations the solver made.
+            )pbdoc")
+        .def_property_readonly("tolerance", &FdmAmgpcgSolver2::tolerance,
+                               R"pbdoc(
+            The max residual tolerance for the AMGPCG method.
+            )pbdoc")
+        .def_property_readonly("lastResidual", &FdmAmgpcgSolver2::lastResidual,
+                               R"pbdoc(
+            The last residual after the AMGPCG iterations.
+            )pbdoc")
+        .def_property_readonly("lastNumberOfLevels",
+                               &FdmAmgpcgSolver2::lastNumberOfLevels,
+                               R"pbdoc(
+            The number of levels of the last AMG hierarchy.
+            )pbdoc")
+        .def_property("isReusingHierarchy",
+                      &FdmAmgpcgSolver2::isReusingHierarchy,
+                      &FdmAmgpcgSolver2::setIsReusingHierarchy,
+                      R"pbdoc(
+            True if the hierarchy is reused while the sparsity pattern of the
+            matrix does not change.
+            )pbdoc")
+        .def_property_readonly("isLastHierarchyReused",
+                               &FdmAmgpcgSolver2::isLastHierarchyReused,
+                               R"pbdoc(
+            True if the last solve reused the previous hierarchy.
+            )pbdoc");
+}
+
+void addFdmAmgpcgSolver3(py::module& m) {
+    py::class_<FdmAmgpcgSolver3, FdmAmgpcgSolver3Ptr, FdmLinearSystemSolver3>(
+        m, "FdmAmgpcgSolver3",
+        R"pbdoc(
+        3-D finite difference-type linear system solver using conjugate gradient
+        preconditioned by algebraic multigrid.
+        )pbdoc")
+        .def(py::init([](uint32_t maxNumberOfIterations, double tolerance,
+                         size_t maxNumberOfLevels, uint32_t smootherDegree,
+                         double strengthThreshold) {
+                 AmgParameters params;
+                 params.maxNumberOfLevels = maxNumberOfLevels;
+                 params.smootherDegree = smootherDegree;
+                 params.strengthThreshold = strengthThreshold;
+                 return std::make_shared<FdmAmgpcgSolver3>(
+                     maxNumberOfIterations, tolerance, params);
+             }),
+             py::arg("maxNumberOfIterations"), py::arg("tolerance"),
+             py::arg("maxNumberOfLevels") = 10, py::arg("smootherDegree") = 3,
+             py::arg("strengthThreshold") = 0.08)
+        .def_property_readonly("maxNumberOfIterations",
+                               &FdmAmgpcgSolver3::maxNumberOfIterations,
+                               R"pbdoc(
+            Max number of AMGPCG iterations.
+            )pbdoc")
+        .def_property_readonly("lastNumberOfIterations",
+                               &FdmAmgpcgSolver3::lastNumberOfIterations,
+                               R"pbdoc(
+            The last number of AMGPCG iterations the solver made.
+            )pbdoc")
+        .def_property_readonly("tolerance", &FdmAmgpcgSolver3::tolerance,
+                               R"pbdoc(
+            The max residual tolerance for the AMGPCG method.
+            )pbdoc")
+        .def_property_readonly("lastResidual", &FdmAmgpcgSolver3::lastResidual,
+                               R"pbdoc(
+            The last residual after the AMGPCG iterations.
+            )pbdoc")
+        .def_property_readonly("lastNumberOfLevels",
+                               &FdmAmgpcgSolver3::lastNumberOfLevels,
+                               R"pbdoc(
+            The number of levels of the last AMG hierarchy.
+            )pbdoc")
+        .def_property("isReusingHierarchy",
+                      &FdmAmgpcgSolver3::isReusingHierarchy,
+                      &FdmAmgpcgSolver3::setIsReusingHierarchy,
+                      R"pbdoc(
+            True if the hierarchy is reused while the sparsity pattern of the
+            matrix does not change.
+            )pbdoc")
+        .def_property_readonly("isLastHierarchyReused",
+                               &FdmAmgpcgSolver3::isLastHierarchyReused,
+                               R"pbdoc(
+            True if the last solve reused the previous hierarchy.
+            )pbdoc");
+}
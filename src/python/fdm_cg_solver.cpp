@@ -38,6 +38,13 @@ void addFdmCgSolver2(py::module& m) {
         .def_property_readonly("lastResidual", &FdmCgSolver2::lastResidual,
                                R"pbdoc(
             The last residual after the CG iterations.
+            )pbdoc")
+        .def_property("isUsingSinglePrecision",
+                      &FdmCgSolver2::isUsingSinglePrecision,
+                      &FdmCgSolver2::setIsUsingSinglePrecision,
+                      R"pbdoc(
+            True if the system is solved with single-precision CG and refined
+            in double precision.
             )pbdoc");
 }
 
@@ -66,5 +73,12 @@ void addFdmCgSolver3(py::module& m) {
         .def_property_readonly("lastResidual", &FdmCgSolver3::lastResidual,
                                R"pbdoc(
             The last residual after the CG iterations.
+            )pbdoc")
+        .def_property("isUsingSinglePrecision",
+                      &FdmCgSolver3::isUsingSinglePrecision,
+                      &FdmCgSolver3::setIsUsingSinglePrecision,
+                      R"pbdoc(
+            True if the system is solved with single-precision CG and refined
+            in double precision.
             )pbdoc");
 }
@@ -38,6 +38,12 @@ void addFdmIccgSolver2(py::module& m) {
         .def_property_readonly("lastResidual", &FdmIccgSolver2::lastResidual,
                                R"pbdoc(
             The last residual after the ICCG iterations.
+            )pbdoc")
+        .def_property("isUsingParallelPreconditioner",
+                      &FdmIccgSolver2::isUsingParallelPreconditioner,
+                      &FdmIccgSolver2::setIsUsingParallelPreconditioner,
+                      R"pbdoc(
+            True if the preconditioner is built and applied in parallel.
             )pbdoc");
 }
 
@@ -66,5 +72,11 @@ void addFdmIccgSolver3(py::module& m) {
         .def_property_readonly("lastResidual", &FdmIccgSolver3::lastResidual,
                                R"pbdoc(
             The last residual after the ICCG iterations.
+            )pbdoc")
+        .def_property("isUsingParallelPreconditioner",
+                      &FdmIccgSolver3::isUsingParallelPreconditioner,
+                      &FdmIccgSolver3::setIsUsingParallelPreconditioner,
+                      R"pbdoc(
+            True if the preconditioner is built and applied in parallel.
             )pbdoc");
 }
@@ -18,7 +18,13 @@ void addFdmLinearSystemSolver2(py::module& m) {
         m, "FdmLinearSystemSolver2",
         R"pbdoc(
         Abstract base class for 2-D finite difference-type linear system solver.
-        )pbdoc");
+        )pbdoc")
+        .def_property("isUsingInitialGuess",
+                      &FdmLinearSystemSolver2::isUsingInitialGuess,
+                      &FdmLinearSystemSolver2::setIsUsingInitialGuess,
+                      R"pbdoc(
+            True if the solver starts from the given solution vector.
+            )pbdoc");
 }
 
 void addFdmLinearSystemSolver3(py::module& m) {
@@ -26,5 +32,11 @@ void addFdmLinearSystemSolver3(py::module& m) {
         m, "FdmLinearSystemSolver3",
         R"pbdoc(
         Abstract base class for 3-D finite difference-type linear system solver.
-        )pbdoc");
+        )pbdoc")
+        .def_property("isUsingInitialGuess",
+                      &FdmLinearSystemSolver3::isUsingInitialGuess,
+                      &FdmLinearSystemSolver3::setIsUsingInitialGuess,
+                      R"pbdoc(
+            True if the solver starts from the given solution vector.
+            )pbdoc");
 }
@@ -13,6 +13,14 @@
 namespace py = pybind11;
 using namespace jet;
 
+void addMgCycleType(py::module& m) {
+    py::enum_<MgCycleType>(m, "MgCycleType")
+        .value("V", MgCycleType::kV)
+        .value("W", MgCycleType::kW)
+        .value("F", MgCycleType::kF)
+        .export_values();
+}
+
 void addFdmMgSolver2(py::module& m) {
     py::class_<FdmMgSolver2, FdmMgSolver2Ptr, FdmLinearSystemSolver2>(
         m, "FdmMgSolver2",
@@ -67,7 +75,18 @@ void addFdmMgSolver2(py::module& m) {
             )pbdoc")
         .def_property_readonly("sorFactor", &FdmMgSolver2::sorFactor)
         .def_property_readonly("useRedBlackOrdering",
-                               &FdmMgSolver2::useRedBlackOrdering);
+                               &FdmMgSolver2::useRedBlackOrdering)
+        .def_property("cycleType", &FdmMgSolver2::cycleType,
+                      &FdmMgSolver2::setCycleType,
+                      R"pbdoc(
+            Multigrid cycle type (V, W, or F).
+            )pbdoc")
+        .def_property("isUsingCgAtCoarsestLevel",
+                      &FdmMgSolver2::isUsingCgAtCoarsestLevel,
+                      &FdmMgSolver2::setIsUsingCgAtCoarsestLevel,
+                      R"pbdoc(
+            True if CG solves the coarsest level instead of the relaxation.
+            )pbdoc");
 }
 
 void addFdmMgSolver3(py::module& m) {
@@ -124,5 +143,16 @@ void addFdmMgSolver3(py::module& m) {
             )pbdoc")
         .def_property_readonly("sorFactor", &FdmMgSolver3::sorFactor)
         .def_property_readonly("useRedBlackOrdering",
-                               &FdmMgSolver3::useRedBlackOrdering);
+                               &FdmMgSolver3::useRedBlackOrdering)
+        .def_property("cycleType", &FdmMgSolver3::cycleType,
+                      &FdmMgSolver3::setCycleType,
+                      R"pbdoc(
+            Multigrid cycle type (V, W, or F).
+            )pbdoc")
+        .def_property("isUsingCgAtCoarsestLevel",
+                      &FdmMgSolver3::isUsingCgAtCoarsestLevel,
+                      &FdmMgSolver3::setIsUsingCgAtCoarsestLevel,
+                      R"pbdoc(
+            True if CG solves the coarsest level instead of the relaxation.
+            )pbdoc");
 }
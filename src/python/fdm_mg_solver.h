@@ -11,6 +11,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+void addMgCycleType(pybind11::module& m);
 void addFdmMgSolver2(pybind11::module& m);
 void addFdmMgSolver3(pybind11::module& m);
 
@@ -48,6 +48,32 @@ void addGridFractionalSinglePhasePressureSolver2(py::module& m) {
             &GridFractionalSinglePhasePressureSolver2::setLinearSystemSolver,
             R"pbdoc(
             "The linear system solver."
+            )pbdoc")
+        .def_property(
+            "isUsingSinglePrecision",
+            &GridFractionalSinglePhasePressureSolver2::isUsingSinglePrecision,
+            &GridFractionalSinglePhasePressureSolver2::setIsUsingSinglePrecision,
+            R"pbdoc(
+            True if the pressure system is stored in single precision.
+            )pbdoc")
+        .def_property(
+            "isWarmStarting",
+            &GridFractionalSinglePhasePressureSolver2::isWarmStarting,
+            &GridFractionalSinglePhasePressureSolver2::setIsWarmStarting,
+            R"pbdoc(
+            True if the solve starts from the last pressure.
+            )pbdoc")
+        .def_property_readonly(
+            "lastNumberOfIterations",
+            &GridFractionalSinglePhasePressureSolver2::lastNumberOfIterations,
+            R"pbdoc(
+            The number of iterations of the last linear system solve.
+            )pbdoc")
+        .def_property_readonly(
+            "lastNumberOfSavedIterations",
+            &GridFractionalSinglePhasePressureSolver2::lastNumberOfSavedIterations,
+            R"pbdoc(
+            The estimated number of iterations saved by the warm start.
             )pbdoc");
 }
 
@@ -86,5 +112,31 @@ void addGridFractionalSinglePhasePressureSolver3(py::module& m) {
             &GridFractionalSinglePhasePressureSolver3::setLinearSystemSolver,
             R"pbdoc(
             "The linear system solver."
+            )pbdoc")
+        .def_property(
+            "isUsingSinglePrecision",
+            &GridFractionalSinglePhasePressureSolver3::isUsingSinglePrecision,
+            &GridFractionalSinglePhasePressureSolver3::setIsUsingSinglePrecision,
+            R"pbdoc(
+            True if the pressure system is stored in single precision.
+            )pbdoc")
+        .def_property(
+            "isWarmStarting",
+            &GridFractionalSinglePhasePressureSolver3::isWarmStarting,
+            &GridFractionalSinglePhasePressureSolver3::setIsWarmStarting,
+            R"pbdoc(
+            True if the solve starts from the last pressure.
+            )pbdoc")
+        .def_property_readonly(
+            "lastNumberOfIterations",
+            &GridFractionalSinglePhasePressureSolver3::lastNumberOfIterations,
+            R"pbdoc(
+            The number of iterations of the last linear system solve.
+            )pbdoc")
+        .def_property_readonly(
+            "lastNumberOfSavedIterations",
+            &GridFractionalSinglePhasePressureSolver3::lastNumberOfSavedIterations,
+            R"pbdoc(
+            The estimated number of iterations saved by the warm start.
             )pbdoc");
 }
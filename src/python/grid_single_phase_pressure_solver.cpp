@@ -39,6 +39,32 @@ void addGridSinglePhasePressureSolver2(py::module& m) {
                     &GridSinglePhasePressureSolver2::setLinearSystemSolver,
                     R"pbdoc(
             "The linear system solver."
+            )pbdoc")
+        .def_property(
+            "isUsingSinglePrecision",
+            &GridSinglePhasePressureSolver2::isUsingSinglePrecision,
+            &GridSinglePhasePressureSolver2::setIsUsingSinglePrecision,
+            R"pbdoc(
+            True if the pressure system is stored in single precision.
+            )pbdoc")
+        .def_property(
+            "isWarmStarting",
+            &GridSinglePhasePressureSolver2::isWarmStarting,
+            &GridSinglePhasePressureSolver2::setIsWarmStarting,
+            R"pbdoc(
+            True if the solve starts from the last pressure.
+            )pbdoc")
+        .def_property_readonly(
+            "lastNumberOfIterations",
+            &GridSinglePhasePressureSolver2::lastNumberOfIterations,
+            R"pbdoc(
+            The number of iterations of the last linear system solve.
+            )pbdoc")
+        .def_property_readonly(
+            "lastNumberOfSavedIterations",
+            &GridSinglePhasePressureSolver2::lastNumberOfSavedIterations,
+            R"pbdoc(
+            The estimated number of iterations saved by the warm start.
             )pbdoc");
 }
 
@@ -68,5 +94,31 @@ void addGridSinglePhasePressureSolver3(py::module& m) {
             &GridSinglePhasePressureSolver3::setLinearSystemSolver,
             R"pbdoc(
             "The linear system solver."
+            )pbdoc")
+        .def_property(
+            "isUsingSinglePrecision",
+            &GridSinglePhasePressureSolver3::isUsingSinglePrecision,
+            &GridSinglePhasePressureSolver3::setIsUsingSinglePrecision,
+            R"pbdoc(
+            True if the pressure system is stored in single precision.
+            )pbdoc")
+        .def_property(
+            "isWarmStarting",
+            &GridSinglePhasePressureSolver3::isWarmStarting,
+            &GridSinglePhasePressureSolver3::setIsWarmStarting,
+            R"pbdoc(
+            True if the solve starts from the last pressure.
+            )pbdoc")
+        .def_property_readonly(
+            "lastNumberOfIterations",
+            &GridSinglePhasePressureSolver3::lastNumberOfIterations,
+            R"pbdoc(
+            The number of iterations of the last linear system solve.
+            )pbdoc")
+        .def_property_readonly(
+            "lastNumberOfSavedIterations",
+            &GridSinglePhasePressureSolver3::lastNumberOfSavedIterations,
+            R"pbdoc(
+            The estimated number of iterations saved by the warm start.
             )pbdoc");
 }
@@ -138,6 +138,16 @@ void addLevelSetLiquidSolver3(py::module& m) {
         .def("setMinReinitializeDistance",
              &LevelSetLiquidSolver3::setMinReinitializeDistance,
              R"pbdoc(Sets minimum reinitialization distance.)pbdoc")
+        .def_property("narrowBandWidth",
+                      &LevelSetLiquidSolver3::narrowBandWidth,
+                      &LevelSetLiquidSolver3::setNarrowBandWidth,
+                      R"pbdoc(
+             The narrow band half-width in number of grid cells.
+
+             When positive, the level set is advected, reinitialized, and used
+             for velocity extrapolation only within the band around the zero
+             level set. Zero, which is the default, disables the narrow band.
+             )pbdoc")
         .def("setIsGlobalCompensationEnabled",
              &LevelSetLiquidSolver3::setIsGlobalCompensationEnabled,
              R"pbdoc(
@@ -25,5 +25,7 @@ void addLogging(pybind11::module& m) {
     py::class_<Logging>(m, "Logging")
         .def_static("setLevel", &Logging::setLevel)
         .def_static("mute", &Logging::mute)
-        .def_static("unmute", &Logging::unmute);
+        .def_static("unmute", &Logging::unmute)
+        .def_static("setAsync", &Logging::setAsync)
+        .def_static("flush", &Logging::flush);
 }
@@ -25,6 +25,8 @@
 #include "cylinder.h"
 #include "eno_level_set_solver.h"
 #include "face_centered_grid.h"
+#include "fast_sweeping_level_set_solver.h"
+#include "fdm_amgpcg_solver.h"
 #include "fdm_cg_solver.h"
 #include "fdm_gauss_seidel_solver.h"
 #include "fdm_iccg_solver.h"
@@ -55,6 +57,7 @@
 #include "level_set_liquid_solver.h"
 #include "level_set_solver.h"
 #include "logging.h"
+#include "mac_cormack_advection.h"
 #include "marching_cubes.h"
 #include "particle_emitter.h"
 #include "particle_emitter_set.h"
@@ -234,6 +237,8 @@ PYBIND11_MODULE(pyjet, m) {
     addSemiLagrangian3(m);
     addCubicSemiLagrangian2(m);
     addCubicSemiLagrangian3(m);
+    addMacCormackAdvection2(m);
+    addMacCormackAdvection3(m);
     addFdmLinearSystemSolver2(m);
     addFdmLinearSystemSolver3(m);
     addFdmJacobiSolver2(m);
@@ -244,6 +249,9 @@ PYBIND11_MODULE(pyjet, m) {
     addFdmCgSolver3(m);
     addFdmIccgSolver2(m);
     addFdmIccgSolver3(m);
+    addFdmAmgpcgSolver2(m);
+    addFdmAmgpcgSolver3(m);
+    addMgCycleType(m);
     addFdmMgSolver2(m);
     addFdmMgSolver3(m);
     addFdmMgpcgSolver2(m);
@@ -276,6 +284,8 @@ PYBIND11_MODULE(pyjet, m) {
     addEnoLevelSetSolver3(m);
     addFmmLevelSetSolver2(m);
     addFmmLevelSetSolver3(m);
+    addFastSweepingLevelSetSolver2(m);
+    addFastSweepingLevelSetSolver3(m);
     addPointsToImplicit2(m);
     addPointsToImplicit3(m);
     addSphericalPointsToImplicit2(m);
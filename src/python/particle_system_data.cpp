@@ -192,7 +192,16 @@ void addParticleSystemData2(py::module& m) {
              default, PointParallelHashGridSearcher2 is used.
              )pbdoc")
         .def_property_readonly("neighborLists",
-                               &ParticleSystemData2::neighborLists,
+                               [](const ParticleSystemData2& instance) {
+                                   const auto& lists = instance.neighborLists();
+                                   std::vector<std::vector<size_t>> result(
+                                       lists.size());
+                                   for (size_t i = 0; i < lists.size(); ++i) {
+                                       result[i].assign(lists[i].begin(),
+                                                        lists[i].end());
+                                   }
+                                   return result;
+                               },
                                R"pbdoc(
              The neighbor lists.
 
@@ -200,6 +209,35 @@ void addParticleSystemData2(py::module& m) {
              PointParallelHashGridSearcher2::buildNeighborLists. Each list stores
              indices of the neighbors.
              )pbdoc")
+        .def("sortParticles", &ParticleSystemData2::sortParticles,
+             R"pbdoc(
+             Sorts the particles by their hash grid cells.
+
+             Particles close to each other are stored close in memory. All the
+             particle attributes are permuted, the neighbor searcher is rebuilt,
+             and the neighbor lists are cleared.
+             )pbdoc")
+        .def_property_readonly("lastParticleOrder",
+                               &ParticleSystemData2::lastParticleOrder,
+                               R"pbdoc(
+             The permutation of the last particle reordering.
+
+             The i-th particle after the last sorting is the one that was at
+             lastParticleOrder[i] before.
+             )pbdoc")
+        .def_property("isUsingSoaLayout",
+                      &ParticleSystemData2::isUsingSoaLayout,
+                      &ParticleSystemData2::setIsUsingSoaLayout,
+                      R"pbdoc(
+             True if SoA copies of the positions and velocities are kept.
+
+             The copies are used by the vectorized SPH kernels and refreshed
+             when the neighbor lists are built.
+             )pbdoc")
+        .def("updateSoaLayout", &ParticleSystemData2::updateSoaLayout,
+             R"pbdoc(
+             Copies the current positions and velocities to the SoA arrays.
+             )pbdoc")
         .def("set",
              [](ParticleSystemData2& instance,
                 const ParticleSystemData2Ptr& other) { instance.set(*other); },
@@ -387,7 +425,16 @@ void addParticleSystemData3(py::module& m) {
              default, PointParallelHashGridSearcher2 is used.
              )pbdoc")
         .def_property_readonly("neighborLists",
-                               &ParticleSystemData3::neighborLists,
+                               [](const ParticleSystemData3& instance) {
+                                   const auto& lists = instance.neighborLists();
+                                   std::vector<std::vector<size_t>> result(
+                                       lists.size());
+                                   for (size_t i = 0; i < lists.size(); ++i) {
+                                       result[i].assign(lists[i].begin(),
+                                                        lists[i].end());
+                                   }
+                                   return result;
+                               },
                                R"pbdoc(
              The neighbor lists.
 
@@ -395,6 +442,35 @@ void addParticleSystemData3(py::module& m) {
              PointParallelHashGridSearcher2::buildNeighborLists. Each list stores
              indices of the neighbors.
              )pbdoc")
+        .def("sortParticles", &ParticleSystemData3::sortParticles,
+             R"pbdoc(
+             Sorts the particles by their hash grid cells.
+
+             Particles close to each other are stored close in memory. All the
+             particle attributes are permuted, the neighbor searcher is rebuilt,
+             and the neighbor lists are cleared.
+             )pbdoc")
+        .def_property_readonly("lastParticleOrder",
+                               &ParticleSystemData3::lastParticleOrder,
+                               R"pbdoc(
+             The permutation of the last particle reordering.
+
+             The i-th particle after the last sorting is the one that was at
+             lastParticleOrder[i] before.
+             )pbdoc")
+        .def_property("isUsingSoaLayout",
+                      &ParticleSystemData3::isUsingSoaLayout,
+                      &ParticleSystemData3::setIsUsingSoaLayout,
+                      R"pbdoc(
+             True if SoA copies of the positions and velocities are kept.
+
+             The copies are used by the vectorized SPH kernels and refreshed
+             when the neighbor lists are built.
+             )pbdoc")
+        .def("updateSoaLayout", &ParticleSystemData3::updateSoaLayout,
+             R"pbdoc(
+             Copies the current positions and velocities to the SoA arrays.
+             )pbdoc")
         .def("set",
              [](ParticleSystemData3& instance,
                 const ParticleSystemData3Ptr& other) { instance.set(*other); },
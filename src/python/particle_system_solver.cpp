@@ -85,6 +85,14 @@ void addParticleSystemSolver2(py::module& m) {
 
              Wind can be applied to the particle system by setting a vector field to
              the solver.
+             )pbdoc")
+        .def_property("particleSortingInterval",
+                      &ParticleSystemSolver2::particleSortingInterval,
+                      &ParticleSystemSolver2::setParticleSortingInterval,
+                      R"pbdoc(
+             The number of time-steps between spatial particle sorting.
+
+             Zero, which is the default, disables the sorting.
              )pbdoc");
 }
 
@@ -160,5 +168,13 @@ void addParticleSystemSolver3(py::module& m) {
 
              Wind can be applied to the particle system by setting a vector field to
              the solver.
+             )pbdoc")
+        .def_property("particleSortingInterval",
+                      &ParticleSystemSolver3::particleSortingInterval,
+                      &ParticleSystemSolver3::setParticleSortingInterval,
+                      R"pbdoc(
+             The number of time-steps between spatial particle sorting.
+
+             Zero, which is the default, disables the sorting.
              )pbdoc");
 }
@@ -47,7 +47,17 @@ void addPicSolver2(py::module& m) {
                                R"pbdoc(Returns particleSystemData.)pbdoc")
         .def_property("particleEmitter", &PicSolver2::particleEmitter,
                       &PicSolver2::setParticleEmitter,
-                      R"pbdoc(Particle emitter property.)pbdoc");
+                      R"pbdoc(Particle emitter property.)pbdoc")
+        .def_property(
+            "useDeterministicTransfer",
+            &PicSolver2::useDeterministicTransfer,
+            &PicSolver2::setUseDeterministicTransfer,
+            R"pbdoc(True if particle-to-grid transfer is bitwise deterministic.)pbdoc")
+        .def_property(
+            "particleSortingInterval",
+            &PicSolver2::particleSortingInterval,
+            &PicSolver2::setParticleSortingInterval,
+            R"pbdoc(Number of time-steps between spatial particle sorting (0 disables).)pbdoc");
 }
 
 void addPicSolver3(py::module& m) {
@@ -84,5 +94,15 @@ void addPicSolver3(py::module& m) {
                                R"pbdoc(Returns particleSystemData.)pbdoc")
         .def_property("particleEmitter", &PicSolver3::particleEmitter,
                       &PicSolver3::setParticleEmitter,
-                      R"pbdoc(Particle emitter property.)pbdoc");
+                      R"pbdoc(Particle emitter property.)pbdoc")
+        .def_property(
+            "useDeterministicTransfer",
+            &PicSolver3::useDeterministicTransfer,
+            &PicSolver3::setUseDeterministicTransfer,
+            R"pbdoc(True if particle-to-grid transfer is bitwise deterministic.)pbdoc")
+        .def_property(
+            "particleSortingInterval",
+            &PicSolver3::particleSortingInterval,
+            &PicSolver3::setParticleSortingInterval,
+            R"pbdoc(Number of time-steps between spatial particle sorting (0 disables).)pbdoc");
 }
@@ -15,12 +15,71 @@
 #include <jet/cubic_semi_lagrangian2.h>
 #include <jet/custom_scalar_field2.h>
 #include <jet/custom_vector_field2.h>
+#include <jet/logging.h>
+#include <jet/mac_cormack_advection2.h>
 #include <jet/semi_lagrangian2.h>
+#include <jet/timer.h>
 
 #include <algorithm>
+#include <string>
 
 using namespace jet;
 
+namespace {
+
+double zalesakSdf(const Vector2D& pt) {
+    Box2 box(Vector2D(0.5 - 0.025, 0.6), Vector2D(0.5 + 0.025, 0.85));
+    double disk = pt.distanceTo(Vector2D(0.5, 0.75)) - 0.15;
+    double slot = box.closestDistance(pt);
+    if (!box.boundingBox().contains(pt)) {
+        slot *= -1.0;
+    }
+    return std::max(disk, slot);
+}
+
+// Rotates the Zalesak disk once with given solver and resolution, and logs
+// the wall-clock time and the area where the inside/outside classification
+// differs from the initial shape. Returns the final signed distance.
+CellCenteredScalarGrid2 rotateZalesak(const std::string& name,
+                                      AdvectionSolver2* solver,
+                                      size_t resolution) {
+    const double h = 1.0 / static_cast<double>(resolution);
+    CellCenteredScalarGrid2 sdf(resolution, resolution, h, h);
+    CellCenteredScalarGrid2 sdf2(resolution, resolution, h, h);
+    sdf.fill(zalesakSdf);
+
+    CustomVectorField2 flow([](const Vector2D& pt) {
+        return Vector2D(kPiD / 3.14 * (0.5 - pt.y), kPiD / 3.14 * (pt.x - 0.5));
+    });
+
+    Timer timer;
+    for (int i = 0; i < 628; ++i) {
+        solver->advect(sdf, flow, 0.02, &sdf2);
+        sdf.swap(&sdf2);
+    }
+    const double seconds = timer.durationInSeconds();
+
+    // Measures the error on a fixed fine lattice so the resolutions compare.
+    const size_t n = 400;
+    double errorArea = 0.0;
+    for (size_t j = 0; j < n; ++j) {
+        for (size_t i = 0; i < n; ++i) {
+            const Vector2D pt((i + 0.5) / n, (j + 0.5) / n);
+            if ((sdf.sample(pt) < 0.0) != (zalesakSdf(pt) < 0.0)) {
+                errorArea += 1.0 / (n * n);
+            }
+        }
+    }
+
+    JET_INFO << name << " resolution: " << resolution
+             << " time: " << seconds << " sec"
+             << " shape error area: " << errorArea;
+
+    return sdf;
+}
+
+}  // namespace
+
 JET_TESTS(SemiLagrangian2);
 
 JET_BEGIN_TEST_F(SemiLagrangian2, Boundary) {
@@ -118,3 +177,36 @@ JET_BEGIN_TEST_F(CubicSemiLagrangian2, Zalesak) {
     saveData(sdf.constDataAccessor(), "rev0628_#grid2,iso.npy");
 }
 JET_END_TEST_F
+
+JET_TESTS(MacCormackAdvection2);
+
+JET_BEGIN_TEST_F(MacCormackAdvection2, Zalesak) {
+    CellCenteredScalarGrid2 sdf(200, 200, 1.0/200.0, 1.0/200.0);
+    sdf.fill(zalesakSdf);
+    saveData(sdf.constDataAccessor(), "orig_#grid2,iso.npy");
+
+    MacCormackAdvection2 solver;
+    sdf = rotateZalesak("MacCormack", &solver, 200);
+
+    saveData(sdf.constDataAccessor(), "rev0628_#grid2,iso.npy");
+}
+JET_END_TEST_F
+
+JET_BEGIN_TEST_F(MacCormackAdvection2, ResolutionComparison) {
+    // Compares the semi-Lagrangian method at the full resolution against
+    // MacCormack at the half resolution. The timing and the shape error of
+    // each run go to the log.
+    SemiLagrangian2 semiLagrangian;
+    MacCormackAdvection2 macCormack;
+
+    CellCenteredScalarGrid2 sdf;
+    sdf = rotateZalesak("SemiLagrangian", &semiLagrangian, 200);
+    saveData(sdf.constDataAccessor(), "sl200_#grid2,iso.npy");
+
+    sdf = rotateZalesak("SemiLagrangian", &semiLagrangian, 100);
+    saveData(sdf.constDataAccessor(), "sl100_#grid2,iso.npy");
+
+    sdf = rotateZalesak("MacCormack", &macCormack, 100);
+    saveData(sdf.constDataAccessor(), "mc100_#grid2,iso.npy");
+}
+JET_END_TEST_F
@@ -0,0 +1,49 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "mem_perf_tests.h"
+
+#include <jet/fdm_cg_solver3.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+TEST(FdmCgSolver3, Memory) {
+    const size_t n = 200;
+
+    const size_t mem0 = getCurrentRSS();
+
+    FdmLinearSystem3 system;
+    system.resize({n, n, n});
+
+    FdmCgSolver3 solver(1, 0.0);
+    solver.solve(&system);
+
+    const size_t mem1 = getCurrentRSS();
+
+    const auto msg = makeReadableByteSize(mem1 - mem0);
+
+    printMemReport(msg.first, msg.second);
+}
+
+TEST(FdmCgSolver3, MemorySinglePrecision) {
+    const size_t n = 200;
+
+    const size_t mem0 = getCurrentRSS();
+
+    FdmLinearSystem3F system;
+    system.resize({n, n, n});
+
+    FdmCgSolver3 solver(1, 0.0);
+    solver.solve(&system);
+
+    const size_t mem1 = getCurrentRSS();
+
+    const auto msg = makeReadableByteSize(mem1 - mem0);
+
+    printMemReport(msg.first, msg.second);
+}
@@ -32,3 +32,21 @@ TEST(FdmIccgSolver3, Memory) {
 
     printMemReport(msg.first, msg.second);
 }
+
+TEST(FdmIccgSolver3, StencilMemory) {
+    const size_t n = 300;
+
+    const size_t mem0 = getCurrentRSS();
+
+    FdmStencilLinearSystem3 system;
+    system.resize({n, n, n}, [](size_t, size_t, size_t) { return true; });
+
+    FdmIccgSolver3 solver(1, 0.0);
+    solver.solveStencil(&system);
+
+    const size_t mem1 = getCurrentRSS();
+
+    const auto msg = makeReadableByteSize(mem1 - mem0);
+
+    printMemReport(msg.first, msg.second);
+}
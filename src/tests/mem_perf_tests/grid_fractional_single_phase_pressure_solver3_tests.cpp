@@ -8,6 +8,8 @@
 
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_mg_solver3.h>
 #include <jet/grid_fractional_single_phase_pressure_solver3.h>
 
 #include <gtest/gtest.h>
@@ -41,6 +43,27 @@ void runExperiment(size_t n, double height, bool compressed) {
                  ConstantVectorField3({0, 0, 0}), fluidSdf, compressed);
 }
 
+// Measures the memory the pressure solve keeps, while the solver is alive.
+size_t runPrecisionExperiment(size_t n,
+                              const FdmLinearSystemSolver3Ptr& systemSolver,
+                              bool singlePrecision) {
+    FaceCenteredGrid3 vel(n, n, n);
+    CellCenteredScalarGrid3 fluidSdf(n, n, n);
+
+    vel.fill(Vector3D(0, 1, 0));
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.5 * n; });
+
+    const size_t mem0 = getCurrentRSS();
+
+    GridFractionalSinglePhasePressureSolver3 solver;
+    solver.setLinearSystemSolver(systemSolver);
+    solver.setIsUsingSinglePrecision(singlePrecision);
+    solver.solve(vel, 1.0, &vel, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf, false);
+
+    return getCurrentRSS() - mem0;
+}
+
 }  // namespace
 
 TEST(GridFractionalSinglePhasePressureSolver3, FullUncompressed) {
@@ -90,3 +113,33 @@ TEST(GridFractionalSinglePhasePressureSolver3, FreeSurfaceCompressed) {
 
     printMemReport(msg.first, msg.second);
 }
+
+TEST(GridFractionalSinglePhasePressureSolver3, CgDoublePrecision) {
+    const auto msg = makeReadableByteSize(
+        runPrecisionExperiment(128, std::make_shared<FdmCgSolver3>(1, 0.0),
+                               false));
+
+    printMemReport(msg.first, msg.second);
+}
+
+TEST(GridFractionalSinglePhasePressureSolver3, CgSinglePrecision) {
+    const auto msg = makeReadableByteSize(
+        runPrecisionExperiment(128, std::make_shared<FdmCgSolver3>(1, 0.0),
+                               true));
+
+    printMemReport(msg.first, msg.second);
+}
+
+TEST(GridFractionalSinglePhasePressureSolver3, MgDoublePrecision) {
+    const auto msg = makeReadableByteSize(runPrecisionExperiment(
+        128, std::make_shared<FdmMgSolver3>(4, 1, 1, 1, 1), false));
+
+    printMemReport(msg.first, msg.second);
+}
+
+TEST(GridFractionalSinglePhasePressureSolver3, MgSinglePrecision) {
+    const auto msg = makeReadableByteSize(runPrecisionExperiment(
+        128, std::make_shared<FdmMgSolver3>(4, 1, 1, 1, 1), true));
+
+    printMemReport(msg.first, msg.second);
+}
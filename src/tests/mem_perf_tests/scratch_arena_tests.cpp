@@ -0,0 +1,54 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "mem_perf_tests.h"
+
+#include <jet/array1.h>
+#include <jet/bcc_lattice_point_generator.h>
+#include <jet/pci_sph_solver3.h>
+#include <jet/scratch_arena.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+TEST(ScratchArena, PciSphSolver3Frames) {
+    const double spacing = 1.0 / 50.0;
+
+    auto solver = PciSphSolver3::builder()
+                      .withTargetSpacing(spacing)
+                      .makeShared();
+    solver->setIsUsingFixedSubTimeSteps(true);
+    solver->setNumberOfFixedSubTimeSteps(1);
+
+    Array1<Vector3D> points;
+    BccLatticePointGenerator generator;
+    generator.generate(
+        BoundingBox3D({0, 0, 0}, {1, 0.5, 1}), spacing, &points);
+    solver->sphSystemData()->addParticles(points);
+
+    Frame frame(0, 1.0 / 60.0);
+    for (int i = 0; i < 4; ++i, ++frame) {
+        const size_t served0 = ScratchArena::bytesServed();
+        const size_t heap0 = ScratchArena::heapBytesAllocated();
+
+        solver->update(frame);
+
+        // The served bytes would have been heap allocations without the arena
+        const auto served =
+            makeReadableByteSize(ScratchArena::bytesServed() - served0);
+        const size_t heapBytes = ScratchArena::heapBytesAllocated() - heap0;
+        const auto heap = makeReadableByteSize(heapBytes);
+
+        printMemReport(served.first, served.second + " of scratch buffers");
+        printMemReport(heap.first, heap.second + " allocated from heap");
+
+        // Only the first frame fills the arena
+        if (i > 0) {
+            EXPECT_EQ(0u, heapBytes);
+        }
+    }
+}
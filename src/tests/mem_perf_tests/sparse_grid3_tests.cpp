@@ -0,0 +1,116 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "mem_perf_tests.h"
+
+#include <jet/grid_fractional_boundary_condition_solver3.h>
+#include <jet/grid_system_data3.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
+#include <jet/sparse_face_centered_grid3.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+namespace {
+
+// A splash occupying a small fraction of a large tank.
+double splash(const Vector3D& pt) {
+    const double r = pt.distanceTo(Vector3D(0.5, 0.2, 0.5));
+    return (r < 0.1) ? 1.0 : 0.0;
+}
+
+void printPerVoxelReport(size_t bytes, size_t numberOfVoxels) {
+    printMemReport(static_cast<double>(bytes) / numberOfVoxels,
+                   "B per active voxel");
+}
+
+}  // namespace
+
+TEST(SparseCellCenteredScalarGrid3, Memory) {
+    const size_t n = 300;
+    const double h = 1.0 / n;
+
+    const size_t mem0 = getCurrentRSS();
+
+    SparseCellCenteredScalarGrid3 grid(Size3(n, n, n), Vector3D(h, h, h));
+    grid.fill(splash);
+
+    const size_t mem1 = getCurrentRSS();
+
+    const size_t numberOfVoxels =
+        grid.data().numberOfActiveTiles() * TiledArray3<double>::kTileVolume;
+
+    const auto msg = makeReadableByteSize(mem1 - mem0);
+
+    printMemReport(msg.first, msg.second);
+    printPerVoxelReport(mem1 - mem0, numberOfVoxels);
+    printPerVoxelReport(grid.data().memoryUsage(), numberOfVoxels);
+}
+
+TEST(SparseFaceCenteredGrid3, Memory) {
+    const size_t n = 300;
+    const double h = 1.0 / n;
+
+    const size_t mem0 = getCurrentRSS();
+
+    SparseFaceCenteredGrid3 grid(Size3(n, n, n), Vector3D(h, h, h));
+    grid.fill([](const Vector3D& pt) {
+        return Vector3D(0.0, splash(pt), 0.0);
+    });
+
+    const size_t mem1 = getCurrentRSS();
+
+    const size_t numberOfVoxels =
+        grid.numberOfActiveTiles() * TiledArray3<double>::kTileVolume;
+
+    const auto msg = makeReadableByteSize(mem1 - mem0);
+
+    printMemReport(msg.first, msg.second);
+    printPerVoxelReport(mem1 - mem0, numberOfVoxels);
+    printPerVoxelReport(grid.memoryUsage(), numberOfVoxels);
+}
+
+TEST(GridFractionalBoundaryConditionSolver3, ColliderSdfMemory) {
+    const size_t n = 300;
+    const double h = 1.0 / n;
+
+    const size_t mem0 = getCurrentRSS();
+
+    GridFractionalBoundaryConditionSolver3 solver;
+    solver.updateCollider(nullptr, Size3(n, n, n), Vector3D(h, h, h),
+                          Vector3D());
+
+    const size_t mem1 = getCurrentRSS();
+
+    const auto msg = makeReadableByteSize(mem1 - mem0);
+
+    printMemReport(msg.first, msg.second);
+}
+
+TEST(GridSystemData3, SparseScalarDataMemory) {
+    const size_t n = 300;
+    const double h = 1.0 / n;
+
+    GridSystemData3 grids(Size3(n, n, n), Vector3D(h, h, h), Vector3D());
+
+    const size_t mem0 = getCurrentRSS();
+
+    size_t idx = grids.addAdvectableSparseScalarData(
+        std::make_shared<SparseCellCenteredScalarGrid3::Builder>());
+    auto grid = grids.advectableSparseScalarDataAt(idx);
+    grid->fill(splash);
+
+    const size_t mem1 = getCurrentRSS();
+
+    const size_t numberOfVoxels =
+        grid->data().numberOfActiveTiles() * TiledArray3<double>::kTileVolume;
+
+    const auto msg = makeReadableByteSize(mem1 - mem0);
+
+    printMemReport(msg.first, msg.second);
+    printPerVoxelReport(mem1 - mem0, numberOfVoxels);
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array_utils.h>
+#include <jet/face_centered_grid3.h>
+
+#include <benchmark/benchmark.h>
+
+using jet::Vector3D;
+
+class ArrayUtils : public ::benchmark::Fixture {
+ protected:
+    jet::FaceCenteredGrid3 velocity;
+    jet::FaceCenteredGrid3 extrapolatedVelocity;
+    jet::Array3<char> uMarker;
+    jet::Array3<char> vMarker;
+    jet::Array3<char> wMarker;
+    size_t numberOfCells = 0;
+
+    void SetUp(const ::benchmark::State& state) {
+        const size_t res = static_cast<size_t>(state.range(0));
+        const double dx = 1.0 / static_cast<double>(res);
+
+        const jet::Size3 resolution(res, res, res);
+        const Vector3D gridSpacing(dx, dx, dx);
+
+        velocity.resize(resolution, gridSpacing);
+        extrapolatedVelocity.resize(resolution, gridSpacing);
+        numberOfCells = res * res * res;
+
+        velocity.fill([](const Vector3D& x) {
+            return Vector3D(0.5 - x.y, x.x - 0.5, 0.1);
+        });
+
+        // Fluid in a sphere, similar to the markers of a liquid simulation
+        auto mark = [](const Vector3D& x) -> char {
+            return x.distanceTo(Vector3D(0.5, 0.5, 0.5)) < 0.3 ? 1 : 0;
+        };
+
+        auto uPos = velocity.uPosition();
+        uMarker.resize(velocity.uSize());
+        uMarker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            uMarker(i, j, k) = mark(uPos(i, j, k));
+        });
+
+        auto vPos = velocity.vPosition();
+        vMarker.resize(velocity.vSize());
+        vMarker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            vMarker(i, j, k) = mark(vPos(i, j, k));
+        });
+
+        auto wPos = velocity.wPosition();
+        wMarker.resize(velocity.wSize());
+        wMarker.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            wMarker(i, j, k) = mark(wPos(i, j, k));
+        });
+    }
+};
+
+BENCHMARK_DEFINE_F(ArrayUtils, ExtrapolateToRegion)
+(benchmark::State& state) {
+    const unsigned int depth = static_cast<unsigned int>(state.range(1));
+
+    while (state.KeepRunning()) {
+        jet::extrapolateToRegion(velocity.uConstAccessor(), uMarker, depth,
+                                 extrapolatedVelocity.uAccessor());
+        jet::extrapolateToRegion(velocity.vConstAccessor(), vMarker, depth,
+                                 extrapolatedVelocity.vAccessor());
+        jet::extrapolateToRegion(velocity.wConstAccessor(), wMarker, depth,
+                                 extrapolatedVelocity.wAccessor());
+    }
+
+    state.SetItemsProcessed(state.iterations() * numberOfCells);
+}
+
+BENCHMARK_REGISTER_F(ArrayUtils, ExtrapolateToRegion)
+    ->Args({128, 5})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(ArrayUtils, ExtrapolateToRegionFaceCentered)
+(benchmark::State& state) {
+    const unsigned int depth = static_cast<unsigned int>(state.range(1));
+
+    while (state.KeepRunning()) {
+        jet::extrapolateToRegion(
+            velocity.uConstAccessor(), velocity.vConstAccessor(),
+            velocity.wConstAccessor(), uMarker, vMarker, wMarker, depth,
+            extrapolatedVelocity.uAccessor(), extrapolatedVelocity.vAccessor(),
+            extrapolatedVelocity.wAccessor());
+    }
+
+    state.SetItemsProcessed(state.iterations() * numberOfCells);
+}
+
+BENCHMARK_REGISTER_F(ArrayUtils, ExtrapolateToRegionFaceCentered)
+    ->Args({128, 5})
+    ->Unit(benchmark::kMillisecond);
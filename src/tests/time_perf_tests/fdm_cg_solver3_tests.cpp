@@ -0,0 +1,54 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/fdm_cg_solver3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using jet::FdmLinearSystem3;
+
+class FdmCgSolver3 : public ::benchmark::Fixture {
+ public:
+    FdmLinearSystem3 system;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto n = static_cast<size_t>(state.range(0));
+
+        system.resize({n, n, n});
+
+        std::mt19937 rng;
+        std::uniform_real_distribution<> d(-1.0, 1.0);
+
+        // Poisson equation with Dirichlet boundaries
+        system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+            system.A(i, j, k).center = 6.0;
+            system.A(i, j, k).right = (i + 1 < n) ? -1.0 : 0.0;
+            system.A(i, j, k).up = (j + 1 < n) ? -1.0 : 0.0;
+            system.A(i, j, k).front = (k + 1 < n) ? -1.0 : 0.0;
+            system.b(i, j, k) = d(rng);
+        });
+    }
+};
+
+BENCHMARK_DEFINE_F(FdmCgSolver3, Solve)(benchmark::State& state) {
+    jet::FdmCgSolver3 solver(1000, 1e-6);
+    solver.setIsUsingSinglePrecision(state.range(1) == 1);
+
+    while (state.KeepRunning()) {
+        solver.solve(&system);
+    }
+
+    state.counters["iterations"] = solver.lastNumberOfIterations();
+}
+
+BENCHMARK_REGISTER_F(FdmCgSolver3, Solve)
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Args({128, 0})
+    ->Args({128, 1})
+    ->Unit(benchmark::kMillisecond);
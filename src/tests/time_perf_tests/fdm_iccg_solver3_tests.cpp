@@ -0,0 +1,107 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/fdm_iccg_solver3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using jet::FdmCompressedLinearSystem3;
+using jet::FdmLinearSystem3;
+
+class FdmIccgSolver3 : public ::benchmark::Fixture {
+ public:
+    FdmLinearSystem3 system;
+    FdmCompressedLinearSystem3 compSystem;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto n = static_cast<size_t>(state.range(0));
+
+        system.resize({n, n, n});
+
+        std::mt19937 rng;
+        std::uniform_real_distribution<> d(-1.0, 1.0);
+
+        // Poisson equation with Dirichlet boundaries
+        system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+            system.A(i, j, k).center = 6.0;
+            system.A(i, j, k).right = (i + 1 < n) ? -1.0 : 0.0;
+            system.A(i, j, k).up = (j + 1 < n) ? -1.0 : 0.0;
+            system.A(i, j, k).front = (k + 1 < n) ? -1.0 : 0.0;
+            system.b(i, j, k) = d(rng);
+        });
+
+        if (state.range(2) == 1) {
+            buildCompressedSystem();
+        }
+    }
+
+    void buildCompressedSystem() {
+        const auto acc = system.b.constAccessor();
+        const auto size = system.b.size();
+
+        compSystem.clear();
+        system.b.forEachIndex([&](size_t i, size_t j, size_t k) {
+            std::vector<double> row(1, 6.0);
+            std::vector<size_t> colIdx(1, acc.index(i, j, k));
+
+            auto addNeighbor = [&](size_t ni, size_t nj, size_t nk) {
+                row.push_back(-1.0);
+                colIdx.push_back(acc.index(ni, nj, nk));
+            };
+
+            if (i > 0) {
+                addNeighbor(i - 1, j, k);
+            }
+            if (i + 1 < size.x) {
+                addNeighbor(i + 1, j, k);
+            }
+            if (j > 0) {
+                addNeighbor(i, j - 1, k);
+            }
+            if (j + 1 < size.y) {
+                addNeighbor(i, j + 1, k);
+            }
+            if (k > 0) {
+                addNeighbor(i, j, k - 1);
+            }
+            if (k + 1 < size.z) {
+                addNeighbor(i, j, k + 1);
+            }
+
+            compSystem.A.addRow(row, colIdx);
+            compSystem.b.append(system.b(i, j, k));
+        });
+        compSystem.x.resize(compSystem.b.size(), 0.0);
+    }
+};
+
+BENCHMARK_DEFINE_F(FdmIccgSolver3, Solve)(benchmark::State& state) {
+    jet::FdmIccgSolver3 solver(1000, 1e-6);
+    solver.setIsUsingParallelPreconditioner(state.range(1) == 1);
+
+    const bool compressed = state.range(2) == 1;
+    while (state.KeepRunning()) {
+        if (compressed) {
+            solver.solveCompressed(&compSystem);
+        } else {
+            solver.solve(&system);
+        }
+    }
+
+    state.counters["iterations"] = solver.lastNumberOfIterations();
+}
+
+BENCHMARK_REGISTER_F(FdmIccgSolver3, Solve)
+    ->Args({64, 0, 0})
+    ->Args({64, 1, 0})
+    ->Args({64, 0, 1})
+    ->Args({64, 1, 1})
+    ->Args({256, 0, 0})
+    ->Args({256, 1, 0})
+    ->Unit(benchmark::kMillisecond);
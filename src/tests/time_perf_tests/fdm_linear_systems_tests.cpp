@@ -16,6 +16,8 @@ using jet::FdmMatrix2;
 using jet::FdmVector2;
 using jet::FdmMatrix3;
 using jet::FdmVector3;
+using jet::FdmMatrix3F;
+using jet::FdmVector3F;
 using jet::FdmCompressedLinearSystem3;
 using jet::Size3;
 
@@ -70,6 +72,32 @@ class FdmBlas3 : public ::benchmark::Fixture {
     }
 };
 
+class FdmBlas3F : public ::benchmark::Fixture {
+ public:
+    FdmMatrix3F m;
+    FdmVector3F a;
+    FdmVector3F b;
+
+    void SetUp(const ::benchmark::State& state) {
+        const auto dim = static_cast<size_t>(state.range(0));
+
+        m.resize(dim, dim, dim);
+        a.resize(dim, dim, dim);
+        b.resize(dim, dim, dim);
+
+        std::mt19937 rng;
+        std::uniform_real_distribution<float> d(0.0f, 1.0f);
+
+        m.forEachIndex([&](size_t i, size_t j, size_t k) {
+            m(i, j, k).center = d(rng);
+            m(i, j, k).right = d(rng);
+            m(i, j, k).up = d(rng);
+            m(i, j, k).front = d(rng);
+            a(i, j, k) = d(rng);
+        });
+    }
+};
+
 class FdmCompressedBlas3 : public ::benchmark::Fixture {
  public:
     FdmCompressedLinearSystem3 system;
@@ -169,6 +197,37 @@ BENCHMARK_DEFINE_F(FdmBlas3, Mvm)(benchmark::State& state) {
 
 BENCHMARK_REGISTER_F(FdmBlas3, Mvm)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
 
+BENCHMARK_DEFINE_F(FdmBlas3, MvmThenDot)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        jet::FdmBlas3::mvm(m, a, &b);
+        benchmark::DoNotOptimize(jet::FdmBlas3::dot(a, b));
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmBlas3, MvmThenDot)
+    ->Arg(1 << 4)
+    ->Arg(1 << 6)
+    ->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmBlas3, MvmAndDot)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(jet::FdmBlas3::mvmAndDot(m, a, &b));
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmBlas3, MvmAndDot)
+    ->Arg(1 << 4)
+    ->Arg(1 << 6)
+    ->Arg(1 << 8);
+
+BENCHMARK_DEFINE_F(FdmBlas3F, Mvm)(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        jet::FdmBlas3F::mvm(m, a, &b);
+    }
+}
+
+BENCHMARK_REGISTER_F(FdmBlas3F, Mvm)->Arg(1 << 4)->Arg(1 << 6)->Arg(1 << 8);
+
 BENCHMARK_DEFINE_F(FdmCompressedBlas3, Mvm)(benchmark::State& state) {
     while (state.KeepRunning()) {
         jet::FdmCompressedBlas3::mvm(system.A, system.b, &system.x);
@@ -0,0 +1,77 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/bcc_lattice_point_generator.h>
+#include <jet/flip_solver3.h>
+#include <jet/logging.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+using jet::Array1;
+using jet::BoundingBox3D;
+using jet::Vector3D;
+
+class FlipSolver3 : public ::benchmark::Fixture {
+ protected:
+    jet::FlipSolver3Ptr solver;
+
+    void SetUp(const ::benchmark::State& state) {
+        jet::Logging::mute();
+
+        const size_t res = static_cast<size_t>(state.range(0));
+        const double dx = 1.0 / static_cast<double>(res);
+
+        solver = jet::FlipSolver3::builder()
+                     .withResolution({res, res, res})
+                     .withDomainSizeX(1.0)
+                     .makeShared();
+        solver->setIsUsingFixedSubTimeSteps(true);
+        solver->setNumberOfFixedSubTimeSteps(1);
+
+        // Shuffle the particles to mimic the memory layout after many frames
+        // of emission and mixing.
+        Array1<Vector3D> points;
+        jet::BccLatticePointGenerator generator;
+        generator.generate(
+            BoundingBox3D({0, 0, 0}, {1, 0.5, 1}), 0.5 * dx, &points);
+        std::mt19937 rng(0);
+        std::shuffle(points.begin(), points.end(), rng);
+
+        auto particles = solver->particleSystemData();
+        particles->addParticles(points);
+
+        if (state.range(1) != 0) {
+            particles->sortParticles();
+        }
+    }
+
+    void TearDown(const ::benchmark::State&) {
+        solver.reset();
+        jet::Logging::unmute();
+    }
+};
+
+BENCHMARK_DEFINE_F(FlipSolver3, AdvanceSingleFrame)
+(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        solver->advanceSingleFrame();
+    }
+
+    state.SetItemsProcessed(
+        state.iterations() * solver->particleSystemData()->numberOfParticles());
+}
+
+// Grid resolution x sorted (1) or emission order (0)
+BENCHMARK_REGISTER_F(FlipSolver3, AdvanceSingleFrame)
+    ->Args({32, 0})
+    ->Args({32, 1})
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Unit(benchmark::kMillisecond);
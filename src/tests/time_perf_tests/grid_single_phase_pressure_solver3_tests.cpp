@@ -0,0 +1,98 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/fdm_amgpcg_solver3.h>
+#include <jet/fdm_iccg_solver3.h>
+#include <jet/fdm_mgpcg_solver3.h>
+#include <jet/grid_single_phase_pressure_solver3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+
+using jet::kMaxD;
+using jet::Size3;
+using jet::Vector3D;
+using jet::FaceCenteredGrid3;
+using jet::CellCenteredScalarGrid3;
+using jet::ConstantScalarField3;
+using jet::ConstantVectorField3;
+using jet::MgCycleType;
+
+class GridSinglePhasePressureSolver3 : public ::benchmark::Fixture {
+ public:
+    FaceCenteredGrid3 vel;
+    FaceCenteredGrid3 output;
+    CellCenteredScalarGrid3 fluidSdf;
+    jet::GridSinglePhasePressureSolver3 solver;
+
+    void SetUp(const ::benchmark::State& state) {
+        const Size3 res(static_cast<size_t>(state.range(0)),
+                        static_cast<size_t>(state.range(1)),
+                        static_cast<size_t>(state.range(2)));
+        const Vector3D h(1.0 / res.x, 1.0 / res.x, 1.0 / res.x);
+
+        vel.resize(res, h);
+        vel.forEachUIndex([&](size_t i, size_t j, size_t k) {
+            vel.u(i, j, k) = (i == 0 || i == res.x)
+                                 ? 0.0
+                                 : std::sin(7.0 * j / res.y + 3.0 * k / res.z);
+        });
+        vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+            vel.v(i, j, k) =
+                (j == 0 || j == res.y) ? 0.0 : std::cos(5.0 * i / res.x);
+        });
+        output.resize(res, h);
+
+        // Free surface at 60% of the domain height
+        const double height = 0.6 * res.y * h.y;
+        fluidSdf.resize(res, h);
+        fluidSdf.fill([&](const Vector3D& x) { return x.y - height; });
+
+        // 0: ICCG, 1: MGPCG with V-cycle, 2: W-cycle, 3: F-cycle, 4: AMGPCG
+        const auto solverType = state.range(3);
+        if (solverType == 0) {
+            solver.setLinearSystemSolver(
+                std::make_shared<jet::FdmIccgSolver3>(2000, 1e-6));
+        } else if (solverType == 4) {
+            solver.setLinearSystemSolver(
+                std::make_shared<jet::FdmAmgpcgSolver3>(300, 1e-6));
+        } else {
+            auto mgpcg = std::make_shared<jet::FdmMgpcgSolver3>(
+                300, 8, 5, 5, 20, 20, 1e-6);
+            if (solverType == 2) {
+                mgpcg->setCycleType(MgCycleType::kW);
+            } else if (solverType == 3) {
+                mgpcg->setCycleType(MgCycleType::kF);
+            }
+            solver.setLinearSystemSolver(mgpcg);
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(GridSinglePhasePressureSolver3, Solve)
+(benchmark::State& state) {
+    bool compressed = state.range(3) == 0 || state.range(3) == 4;
+    while (state.KeepRunning()) {
+        solver.solve(vel, 1.0, &output, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf, compressed);
+    }
+}
+
+BENCHMARK_REGISTER_F(GridSinglePhasePressureSolver3, Solve)
+    ->Args({64, 64, 64, 0})
+    ->Args({64, 64, 64, 1})
+    ->Args({64, 64, 64, 2})
+    ->Args({64, 64, 64, 3})
+    ->Args({64, 64, 64, 4})
+    ->Args({95, 47, 63, 0})
+    ->Args({95, 47, 63, 1})
+    ->Args({95, 47, 63, 2})
+    ->Args({95, 47, 63, 3})
+    ->Args({95, 47, 63, 4})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,132 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/eno_level_set_solver3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
+#include <jet/fmm_level_set_solver3.h>
+#include <jet/upwind_level_set_solver3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+using jet::Vector3D;
+
+class LevelSetSolvers3 : public ::benchmark::Fixture {
+ protected:
+    jet::CellCenteredScalarGrid3 sdf;
+    jet::CellCenteredScalarGrid3 reinitializedSdf;
+    jet::FaceCenteredGrid3 velocity;
+    jet::FaceCenteredGrid3 extrapolatedVelocity;
+    double maxDistance = 0.0;
+    size_t numberOfCells = 0;
+
+    void SetUp(const ::benchmark::State& state) {
+        const size_t res = static_cast<size_t>(state.range(0));
+        const double dx = 1.0 / static_cast<double>(res);
+
+        const jet::Size3 resolution(res, res, res);
+        const Vector3D gridSpacing(dx, dx, dx);
+
+        sdf.resize(resolution, gridSpacing);
+        reinitializedSdf.resize(resolution, gridSpacing);
+        velocity.resize(resolution, gridSpacing);
+        extrapolatedVelocity.resize(resolution, gridSpacing);
+        maxDistance = 5.0 * dx;
+        numberOfCells = res * res * res;
+
+        // Distorted sphere
+        sdf.fill([](const Vector3D& x) {
+            return 2.0 * (x.distanceTo(Vector3D(0.5, 0.5, 0.5)) - 0.3);
+        });
+        velocity.fill([](const Vector3D& x) {
+            return Vector3D(0.5 - x.y, x.x - 0.5, 0.1);
+        });
+    }
+
+    void reinitialize(jet::LevelSetSolver3* solver, benchmark::State& state) {
+        while (state.KeepRunning()) {
+            solver->reinitialize(sdf, maxDistance, &reinitializedSdf);
+        }
+
+        state.SetItemsProcessed(state.iterations() * numberOfCells);
+    }
+
+    void extrapolate(jet::LevelSetSolver3* solver, benchmark::State& state) {
+        while (state.KeepRunning()) {
+            solver->extrapolate(velocity, sdf, maxDistance,
+                                &extrapolatedVelocity);
+        }
+
+        state.SetItemsProcessed(state.iterations() * numberOfCells);
+    }
+};
+
+BENCHMARK_DEFINE_F(LevelSetSolvers3, ReinitializeFmm)
+(benchmark::State& state) {
+    jet::FmmLevelSetSolver3 solver;
+    reinitialize(&solver, state);
+}
+
+BENCHMARK_REGISTER_F(LevelSetSolvers3, ReinitializeFmm)
+    ->Arg(64)
+    ->Arg(128)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LevelSetSolvers3, ReinitializeFastSweeping)
+(benchmark::State& state) {
+    jet::FastSweepingLevelSetSolver3 solver;
+    reinitialize(&solver, state);
+}
+
+BENCHMARK_REGISTER_F(LevelSetSolvers3, ReinitializeFastSweeping)
+    ->Arg(64)
+    ->Arg(128)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LevelSetSolvers3, ReinitializeUpwind)
+(benchmark::State& state) {
+    jet::UpwindLevelSetSolver3 solver;
+    reinitialize(&solver, state);
+}
+
+BENCHMARK_REGISTER_F(LevelSetSolvers3, ReinitializeUpwind)
+    ->Arg(64)
+    ->Arg(128)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LevelSetSolvers3, ReinitializeEno)
+(benchmark::State& state) {
+    jet::EnoLevelSetSolver3 solver;
+    reinitialize(&solver, state);
+}
+
+BENCHMARK_REGISTER_F(LevelSetSolvers3, ReinitializeEno)
+    ->Arg(64)
+    ->Arg(128)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LevelSetSolvers3, ExtrapolateFmm)
+(benchmark::State& state) {
+    jet::FmmLevelSetSolver3 solver;
+    extrapolate(&solver, state);
+}
+
+BENCHMARK_REGISTER_F(LevelSetSolvers3, ExtrapolateFmm)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LevelSetSolvers3, ExtrapolateFastSweeping)
+(benchmark::State& state) {
+    jet::FastSweepingLevelSetSolver3 solver;
+    extrapolate(&solver, state);
+}
+
+BENCHMARK_REGISTER_F(LevelSetSolvers3, ExtrapolateFastSweeping)
+    ->Arg(64)
+    ->Unit(benchmark::kMillisecond);
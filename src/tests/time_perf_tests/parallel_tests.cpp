@@ -5,9 +5,11 @@
 // property of any third parties.
 
 #include <jet/parallel.h>
+#include <jet/reducers.h>
 
 #include <benchmark/benchmark.h>
 
+#include <functional>
 #include <random>
 
 class Parallel : public ::benchmark::Fixture {
@@ -87,3 +89,133 @@ BENCHMARK_REGISTER_F(Parallel, ParallelRangeFor)
     ->Args({1 << 24, 2})
     ->Args({1 << 24, 4})
     ->Args({1 << 24, 8});
+
+// Many small loops in a row, similar to the per-substep grid operations. The
+// cost is dominated by the overhead of launching the parallel loops. Build
+// with JET_TASKING_SYSTEM set to CPP11Threads, TBB, or OpenMP to compare the
+// tasking systems.
+BENCHMARK_DEFINE_F(Parallel, ManySmallLoops)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    while (state.KeepRunning()) {
+        for (int loop = 0; loop < 100; ++loop) {
+            jet::parallelFor(jet::kZeroSize, n, [this](size_t i) {
+                c[i] = 1.0 / std::sqrt(a[i] / b[i] + 1.0);
+            });
+        }
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, ManySmallLoops)
+    ->UseRealTime()
+    ->Args({1 << 10, 1})
+    ->Args({1 << 10, 2})
+    ->Args({1 << 10, 4})
+    ->Args({1 << 10, 8});
+
+BENCHMARK_DEFINE_F(Parallel, NestedParallelFor)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    const size_t m = static_cast<size_t>(std::sqrt(static_cast<double>(n)));
+
+    while (state.KeepRunning()) {
+        jet::parallelFor(jet::kZeroSize, m, [&](size_t j) {
+            jet::parallelFor(jet::kZeroSize, m, [&](size_t i) {
+                const size_t k = i + j * m;
+                c[k] = 1.0 / std::sqrt(a[k] / b[k] + 1.0);
+            });
+        });
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, NestedParallelFor)
+    ->UseRealTime()
+    ->Args({1 << 16, 1})
+    ->Args({1 << 16, 2})
+    ->Args({1 << 16, 4})
+    ->Args({1 << 16, 8});
+
+BENCHMARK_DEFINE_F(Parallel, ParallelReduce)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(jet::parallelReduce(
+            jet::kZeroSize, n, 0.0,
+            [this](size_t iBegin, size_t iEnd, double init) {
+                double result = init;
+                for (size_t i = iBegin; i < iEnd; ++i) {
+                    result += a[i] * b[i];
+                }
+                return result;
+            },
+            std::plus<double>()));
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, ParallelReduce)
+    ->UseRealTime()
+    ->Args({1 << 8, 1})
+    ->Args({1 << 8, 8})
+    ->Args({1 << 16, 1})
+    ->Args({1 << 16, 8})
+    ->Args({1 << 24, 1})
+    ->Args({1 << 24, 8});
+
+BENCHMARK_DEFINE_F(Parallel, ParallelMapReduceMax)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = d(rng);
+    }
+
+    while (state.KeepRunning()) {
+        benchmark::DoNotOptimize(jet::parallelMapReduce(
+            jet::kZeroSize, n, [this](size_t i) { return a[i]; },
+            jet::AbsMaxReducer<double>()));
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, ParallelMapReduceMax)
+    ->UseRealTime()
+    ->Args({1 << 16, 1})
+    ->Args({1 << 16, 8})
+    ->Args({1 << 22, 1})
+    ->Args({1 << 22, 8});
+
+BENCHMARK_DEFINE_F(Parallel, ParallelSort)(benchmark::State& state) {
+    unsigned int oldNumThreads = jet::maxNumberOfThreads();
+    jet::setMaxNumberOfThreads(numThreads);
+
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = d(rng);
+    }
+
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        c = a;
+        state.ResumeTiming();
+
+        jet::parallelSort(c.begin(), c.end());
+    }
+
+    jet::setMaxNumberOfThreads(oldNumThreads);
+}
+
+BENCHMARK_REGISTER_F(Parallel, ParallelSort)
+    ->UseRealTime()
+    ->Args({1 << 16, 1})
+    ->Args({1 << 16, 4})
+    ->Args({1 << 20, 1})
+    ->Args({1 << 20, 4});
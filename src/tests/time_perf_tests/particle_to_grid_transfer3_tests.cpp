@@ -0,0 +1,151 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/array3.h>
+#include <jet/array_samplers3.h>
+#include <jet/parallel.h>
+#include <jet/particle_to_grid_transfer3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using jet::Array1;
+using jet::Array3;
+using jet::Point3UI;
+using jet::Vector3D;
+
+// Number of particles x number of threads
+static void transferArgs(benchmark::internal::Benchmark* b) {
+    for (int n : {1 << 16, 1 << 20, 1 << 23}) {
+        for (int t : {1, 2, 4, 8}) {
+            b->Args({n, t});
+        }
+    }
+}
+
+class ParticleToGridTransfer3 : public ::benchmark::Fixture {
+ protected:
+    std::mt19937 rng{0};
+    std::uniform_real_distribution<> dist{0.0, 1.0};
+    Array1<Vector3D> positions;
+    Array1<Vector3D> velocities;
+    Array3<double> grid;
+    Array3<char> markers;
+    unsigned int numThreads = 0;
+
+    void SetUp(const ::benchmark::State& state) {
+        size_t n = static_cast<size_t>(state.range(0));
+
+        positions.resize(n);
+        velocities.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            positions[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+            velocities[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+        }
+
+        grid.resize(129, 128, 128);
+        markers.resize(129, 128, 128);
+
+        numThreads = jet::maxNumberOfThreads();
+        jet::setMaxNumberOfThreads(static_cast<unsigned int>(state.range(1)));
+    }
+
+    void TearDown(const ::benchmark::State&) {
+        jet::setMaxNumberOfThreads(numThreads);
+    }
+};
+
+BENCHMARK_DEFINE_F(ParticleToGridTransfer3, SerialScatter)
+(benchmark::State& state) {
+    const Vector3D gridSpacing(1.0 / 128.0, 1.0 / 128.0, 1.0 / 128.0);
+    const Vector3D origin(0.0, 0.5 / 128.0, 0.5 / 128.0);
+
+    while (state.KeepRunning()) {
+        Array3<double> weightSum(grid.size());
+        grid.set(0.0);
+        markers.set(0);
+
+        jet::LinearArraySampler3<double, double> sampler(
+            grid.constAccessor(), gridSpacing, origin);
+        for (size_t i = 0; i < positions.size(); ++i) {
+            std::array<Point3UI, 8> indices;
+            std::array<double, 8> weights;
+
+            sampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
+            for (int j = 0; j < 8; ++j) {
+                grid(indices[j]) += velocities[i].x * weights[j];
+                weightSum(indices[j]) += weights[j];
+                markers(indices[j]) = 1;
+            }
+        }
+
+        grid.parallelForEachIndex([&](size_t i, size_t j, size_t k) {
+            if (weightSum(i, j, k) > 0.0) {
+                grid(i, j, k) /= weightSum(i, j, k);
+            }
+        });
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(ParticleToGridTransfer3, SerialScatter)
+    ->Args({1 << 16, 1})
+    ->Args({1 << 20, 1})
+    ->Args({1 << 23, 1});
+
+BENCHMARK_DEFINE_F(ParticleToGridTransfer3, Transfer)
+(benchmark::State& state) {
+    const Vector3D gridSpacing(1.0 / 128.0, 1.0 / 128.0, 1.0 / 128.0);
+    const Vector3D origin(0.0, 0.5 / 128.0, 0.5 / 128.0);
+    jet::ParticleToGridTransfer3 transfer;
+
+    while (state.KeepRunning()) {
+        transfer.transfer(
+            positions.size(),
+            [&](size_t i) { return positions[i]; },
+            [&](size_t i, const Vector3D&, const Point3UI&) {
+                return velocities[i].x;
+            },
+            gridSpacing,
+            origin,
+            grid.accessor(),
+            markers.accessor());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(ParticleToGridTransfer3, Transfer)
+    ->Apply(transferArgs);
+
+BENCHMARK_DEFINE_F(ParticleToGridTransfer3, DeterministicTransfer)
+(benchmark::State& state) {
+    const Vector3D gridSpacing(1.0 / 128.0, 1.0 / 128.0, 1.0 / 128.0);
+    const Vector3D origin(0.0, 0.5 / 128.0, 0.5 / 128.0);
+    jet::ParticleToGridTransfer3 transfer;
+    transfer.setIsDeterministic(true);
+
+    while (state.KeepRunning()) {
+        transfer.transfer(
+            positions.size(),
+            [&](size_t i) { return positions[i]; },
+            [&](size_t i, const Vector3D&, const Point3UI&) {
+                return velocities[i].x;
+            },
+            gridSpacing,
+            origin,
+            grid.accessor(),
+            markers.accessor());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(ParticleToGridTransfer3, DeterministicTransfer)
+    ->Apply(transferArgs);
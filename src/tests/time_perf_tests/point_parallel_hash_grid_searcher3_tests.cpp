@@ -39,12 +39,15 @@ BENCHMARK_DEFINE_F(PointParallelHashGridSearcher3, Build)
         jet::PointParallelHashGridSearcher3 grid(64, 64, 64, 1.0 / 64.0);
         grid.build(points);
     }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
 }
 
 BENCHMARK_REGISTER_F(PointParallelHashGridSearcher3, Build)
     ->Arg(1 << 5)
     ->Arg(1 << 10)
-    ->Arg(1 << 20);
+    ->Arg(1 << 20)
+    ->Arg(1 << 22)
+    ->Unit(benchmark::kMillisecond);
 
 BENCHMARK_DEFINE_F(PointParallelHashGridSearcher3, ForEachNearbyPoints)
 (benchmark::State& state) {
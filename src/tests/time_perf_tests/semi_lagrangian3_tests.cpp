@@ -0,0 +1,96 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/custom_vector_field3.h>
+#include <jet/face_centered_grid3.h>
+#include <jet/semi_lagrangian3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+
+using jet::Vector3D;
+
+class SemiLagrangian3 : public ::benchmark::Fixture {
+ protected:
+    jet::FaceCenteredGrid3 velocity;
+    jet::FaceCenteredGrid3 advectedVelocity;
+    jet::CellCenteredScalarGrid3 density;
+    jet::CellCenteredScalarGrid3 advectedDensity;
+    std::unique_ptr<jet::VectorField3> flow;
+    size_t numberOfCells = 0;
+
+    void SetUp(const ::benchmark::State& state) {
+        const size_t res = static_cast<size_t>(state.range(0));
+        const double dx = 1.0 / static_cast<double>(res);
+
+        const jet::Size3 resolution(res, res, res);
+        const Vector3D gridSpacing(dx, dx, dx);
+
+        velocity.resize(resolution, gridSpacing);
+        advectedVelocity.resize(resolution, gridSpacing);
+        density.resize(resolution, gridSpacing);
+        advectedDensity.resize(resolution, gridSpacing);
+        numberOfCells = res * res * res;
+
+        velocity.fill([](const Vector3D& x) {
+            return Vector3D(0.5 - x.y, x.x - 0.5, 0.1 * std::sin(x.z));
+        });
+        density.fill([](const Vector3D& x) {
+            return std::sin(5.0 * x.x) * std::cos(3.0 * x.y) * x.z;
+        });
+
+        // Wrapping the grid with the custom field hides its type, so the
+        // back-tracing samples it through the virtual function.
+        if (state.range(1) != 0) {
+            const jet::FaceCenteredGrid3* grid = &velocity;
+            flow.reset(new jet::CustomVectorField3(
+                [grid](const Vector3D& x) { return grid->sample(x); }));
+        } else {
+            flow.reset();
+        }
+    }
+
+    const jet::VectorField3& flowField() const {
+        if (flow) {
+            return *flow;
+        }
+        return velocity;
+    }
+};
+
+BENCHMARK_DEFINE_F(SemiLagrangian3, AdvectScalar)(benchmark::State& state) {
+    jet::SemiLagrangian3 solver;
+    while (state.KeepRunning()) {
+        solver.advect(density, flowField(), 0.01, &advectedDensity);
+    }
+
+    state.SetItemsProcessed(state.iterations() * numberOfCells);
+}
+
+// Grid resolution x type-erased flow (1) or face-centered grid (0)
+BENCHMARK_REGISTER_F(SemiLagrangian3, AdvectScalar)
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(SemiLagrangian3, AdvectFaceCentered)
+(benchmark::State& state) {
+    jet::SemiLagrangian3 solver;
+    while (state.KeepRunning()) {
+        solver.advect(velocity, flowField(), 0.01, &advectedVelocity);
+    }
+
+    state.SetItemsProcessed(state.iterations() * numberOfCells);
+}
+
+// Grid resolution x type-erased flow (1) or face-centered grid (0)
+BENCHMARK_REGISTER_F(SemiLagrangian3, AdvectFaceCentered)
+    ->Args({64, 0})
+    ->Args({64, 1})
+    ->Unit(benchmark::kMillisecond);
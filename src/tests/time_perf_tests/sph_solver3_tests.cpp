@@ -0,0 +1,80 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array1.h>
+#include <jet/bcc_lattice_point_generator.h>
+#include <jet/logging.h>
+#include <jet/sph_solver3.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+using jet::Array1;
+using jet::BoundingBox3D;
+using jet::Vector3D;
+
+class SphSolver3 : public ::benchmark::Fixture {
+ protected:
+    jet::SphSolver3Ptr solver;
+
+    void SetUp(const ::benchmark::State& state) {
+        jet::Logging::mute();
+
+        const double spacing = 1.0 / static_cast<double>(state.range(0));
+
+        solver = jet::SphSolver3::builder()
+                     .withTargetSpacing(spacing)
+                     .makeShared();
+        solver->setIsUsingFixedSubTimeSteps(true);
+        solver->setNumberOfFixedSubTimeSteps(1);
+
+        // Shuffle the particles to mimic the memory layout after many frames
+        // of emission and mixing.
+        Array1<Vector3D> points;
+        jet::BccLatticePointGenerator generator;
+        generator.generate(
+            BoundingBox3D({0, 0, 0}, {1, 0.5, 1}), spacing, &points);
+        std::mt19937 rng(0);
+        std::shuffle(points.begin(), points.end(), rng);
+
+        auto particles = solver->sphSystemData();
+        particles->addParticles(points);
+
+        if (state.range(1) != 0) {
+            particles->sortParticles();
+        }
+
+        particles->setIsUsingSoaLayout(state.range(2) != 0);
+    }
+
+    void TearDown(const ::benchmark::State&) {
+        solver.reset();
+        jet::Logging::unmute();
+    }
+};
+
+BENCHMARK_DEFINE_F(SphSolver3, AdvanceSingleFrame)
+(benchmark::State& state) {
+    while (state.KeepRunning()) {
+        solver->advanceSingleFrame();
+    }
+
+    state.SetItemsProcessed(
+        state.iterations() * solver->sphSystemData()->numberOfParticles());
+}
+
+// Particles per unit length x sorted (1) or emission order (0) x SoA layout
+// with vectorized kernels (1) or AoS layout (0)
+BENCHMARK_REGISTER_F(SphSolver3, AdvanceSingleFrame)
+    ->Args({32, 0, 0})
+    ->Args({32, 1, 0})
+    ->Args({32, 1, 1})
+    ->Args({64, 0, 0})
+    ->Args({64, 1, 0})
+    ->Args({64, 1, 1})
+    ->Unit(benchmark::kMillisecond);
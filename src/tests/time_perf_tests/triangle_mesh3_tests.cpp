@@ -5,9 +5,12 @@
 // property of any third parties.
 
 #include <jet/triangle_mesh3.h>
+#include <jet/triangle_mesh_to_sdf.h>
+#include <jet/vertex_centered_scalar_grid3.h>
 
 #include <benchmark/benchmark.h>
 
+#include <algorithm>
 #include <random>
 
 using jet::Vector3D;
@@ -37,3 +40,29 @@ BENCHMARK_DEFINE_F(TriangleMesh3, ClosestPoint)(benchmark::State& state) {
 }
 
 BENCHMARK_REGISTER_F(TriangleMesh3, ClosestPoint);
+
+BENCHMARK_DEFINE_F(TriangleMesh3, TriangleMeshToSdf)
+(benchmark::State& state) {
+    const size_t res = static_cast<size_t>(state.range(0));
+
+    jet::BoundingBox3D box = triMesh.boundingBox();
+    box.expand(0.2 * box.width());
+    const double dx =
+        std::max({box.width(), box.height(), box.depth()}) /
+        static_cast<double>(res);
+
+    jet::VertexCenteredScalarGrid3 sdf(res, res, res, dx, dx, dx,
+                                       box.lowerCorner.x, box.lowerCorner.y,
+                                       box.lowerCorner.z);
+
+    while (state.KeepRunning()) {
+        jet::triangleMeshToSdf(triMesh, &sdf);
+    }
+
+    state.SetItemsProcessed(state.iterations() * res * res * res);
+}
+
+BENCHMARK_REGISTER_F(TriangleMesh3, TriangleMeshToSdf)
+    ->Arg(64)
+    ->Arg(128)
+    ->Unit(benchmark::kMillisecond);
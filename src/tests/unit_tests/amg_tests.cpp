@@ -0,0 +1,157 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/amg.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+// Builds the 2-D Laplacian with the Neumann boundary condition, where the
+// coefficient of each face is scaled by a smooth function of the position.
+void buildNeumannLaplacian(size_t width, size_t height, double scale,
+                           MatrixCsrD* A) {
+    auto coef = [&](size_t i0, size_t j0, size_t i1, size_t j1) {
+        const double phase = 0.3 * (i0 + i1) + 0.2 * (j0 + j1);
+        return scale * (1.0 + 0.5 * std::sin(phase));
+    };
+
+    A->clear();
+    for (size_t j = 0; j < height; ++j) {
+        for (size_t i = 0; i < width; ++i) {
+            std::vector<double> values;
+            std::vector<size_t> columns;
+            double center = 0.0;
+            auto addNeighbor = [&](size_t ni, size_t nj) {
+                const double c = coef(i, j, ni, nj);
+                values.push_back(-c);
+                columns.push_back(ni + nj * width);
+                center += c;
+            };
+
+            if (j > 0) {
+                addNeighbor(i, j - 1);
+            }
+            if (i > 0) {
+                addNeighbor(i - 1, j);
+            }
+            const size_t centerPos = values.size();
+            values.push_back(0.0);
+            columns.push_back(i + j * width);
+            if (i + 1 < width) {
+                addNeighbor(i + 1, j);
+            }
+            if (j + 1 < height) {
+                addNeighbor(i, j + 1);
+            }
+            values[centerPos] = center;
+
+            A->addRow(values, columns);
+        }
+    }
+}
+
+double dot(const VectorND& a, const VectorND& b) {
+    double sum = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+}  // namespace
+
+TEST(AmgHierarchy, Build) {
+    MatrixCsrD A;
+    buildNeumannLaplacian(40, 30, 1.0, &A);
+
+    AmgHierarchyD amg;
+    amg.build(A, AmgParameters());
+
+    EXPECT_LT(1u, amg.numberOfLevels());
+    EXPECT_EQ(A.rows(), amg.matrix(0).rows());
+    EXPECT_GE(256u, amg.matrix(amg.numberOfLevels() - 1).rows());
+
+    for (size_t level = 1; level < amg.numberOfLevels(); ++level) {
+        const MatrixCsrD& coarseA = amg.matrix(level);
+        const MatrixCsrD& P = amg.prolongation(level - 1);
+        EXPECT_EQ(amg.matrix(level - 1).rows(), P.rows());
+        EXPECT_EQ(coarseA.rows(), P.cols());
+        EXPECT_GT(amg.matrix(level - 1).rows(), coarseA.rows());
+
+        // Galerkin operator of the Neumann Laplacian is symmetric with zero
+        // row sums.
+        for (size_t i = 0; i < coarseA.rows(); ++i) {
+            double rowSum = 0.0;
+            double rowMax = 0.0;
+            for (size_t k = coarseA.rowPointer(i);
+                 k < coarseA.rowPointer(i + 1); ++k) {
+                const size_t j = coarseA.columnIndex(k);
+                const double value = coarseA.nonZero(k);
+                EXPECT_NEAR(value, coarseA(j, i), 1e-9);
+                rowSum += value;
+                rowMax = std::max(rowMax, std::fabs(value));
+            }
+            EXPECT_NEAR(0.0, rowSum, 1e-9 * rowMax);
+        }
+    }
+}
+
+TEST(AmgHierarchy, VCycleIsSymmetric) {
+    MatrixCsrD A;
+    buildNeumannLaplacian(33, 27, 1.0, &A);
+    // Makes the matrix non-singular.
+    for (size_t k = A.rowPointer(0); k < A.rowPointer(1); ++k) {
+        if (A.columnIndex(k) == 0) {
+            A.nonZero(k) += 1.0;
+        }
+    }
+
+    AmgHierarchyD amg;
+    amg.build(A, AmgParameters());
+
+    VectorND a(A.rows()), b(A.rows()), ma, mb;
+    for (size_t i = 0; i < A.rows(); ++i) {
+        a[i] = std::sin(0.7 * i);
+        b[i] = std::cos(1.3 * i) + 0.1;
+    }
+    amg.vCycle(a, &ma);
+    amg.vCycle(b, &mb);
+
+    EXPECT_NEAR(dot(ma, b), dot(a, mb), 1e-9 * std::fabs(dot(ma, b)));
+    EXPECT_LT(0.0, dot(ma, a));
+    EXPECT_LT(0.0, dot(mb, b));
+}
+
+TEST(AmgHierarchy, Rebuild) {
+    MatrixCsrD A;
+    buildNeumannLaplacian(40, 30, 1.0, &A);
+    MatrixCsrD scaledA;
+    buildNeumannLaplacian(40, 30, 2.5, &scaledA);
+    MatrixCsrD otherA;
+    buildNeumannLaplacian(30, 40, 1.0, &otherA);
+
+    AmgHierarchyD amg;
+    amg.build(A, AmgParameters());
+    EXPECT_TRUE(amg.hasSameSparsity(scaledA));
+    EXPECT_FALSE(amg.hasSameSparsity(otherA));
+
+    amg.rebuild(scaledA);
+
+    AmgHierarchyD expected;
+    expected.build(scaledA, AmgParameters());
+
+    ASSERT_EQ(expected.numberOfLevels(), amg.numberOfLevels());
+    for (size_t level = 1; level < amg.numberOfLevels(); ++level) {
+        EXPECT_TRUE(expected.matrix(level).isSimilar(amg.matrix(level), 1e-9));
+    }
+}
@@ -157,3 +157,113 @@ TEST(ArrayUtils, ExtrapolateToRegion3) {
         }
     }
 }
+
+TEST(ArrayUtils, ExtrapolateToRegion3Depth) {
+    Array3<double> data(9, 9, 9, -1.0);
+    Array3<char> valid(9, 9, 9, 0);
+    Array3<double> output(9, 9, 9);
+
+    data(4, 4, 4) = 7.0;
+    valid(4, 4, 4) = 1;
+
+    extrapolateToRegion(
+        data.constAccessor(), valid.constAccessor(), 2, output.accessor());
+
+    output.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const size_t dist = (i > 4 ? i - 4 : 4 - i) + (j > 4 ? j - 4 : 4 - j)
+            + (k > 4 ? k - 4 : 4 - k);
+        if (dist <= 2) {
+            EXPECT_DOUBLE_EQ(7.0, output(i, j, k));
+        } else {
+            EXPECT_DOUBLE_EQ(-1.0, output(i, j, k));
+        }
+    });
+}
+
+TEST(ArrayUtils, ExtrapolateToRegionFaceCentered2) {
+    Array2<double> u(11, 10);
+    Array2<double> v(10, 11);
+    Array2<char> uValid(11, 10);
+    Array2<char> vValid(10, 11);
+
+    u.forEachIndex([&](size_t i, size_t j) {
+        u(i, j) = static_cast<double>(i * 3 + j * 7);
+        uValid(i, j) = ((i * 5 + j * 3) % 7 == 0) ? 1 : 0;
+    });
+    v.forEachIndex([&](size_t i, size_t j) {
+        v(i, j) = static_cast<double>(i * 2 + j * 5);
+        vValid(i, j) = ((i * 3 + j * 2) % 11 == 0) ? 1 : 0;
+    });
+
+    Array2<double> uAnswer(u.size());
+    Array2<double> vAnswer(v.size());
+    extrapolateToRegion(
+        u.constAccessor(), uValid.constAccessor(), 3, uAnswer.accessor());
+    extrapolateToRegion(
+        v.constAccessor(), vValid.constAccessor(), 3, vAnswer.accessor());
+
+    Array2<double> uOutput(u.size());
+    Array2<double> vOutput(v.size());
+    extrapolateToRegion(
+        u.constAccessor(), v.constAccessor(),
+        uValid.constAccessor(), vValid.constAccessor(), 3,
+        uOutput.accessor(), vOutput.accessor());
+
+    u.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_DOUBLE_EQ(uAnswer(i, j), uOutput(i, j));
+    });
+    v.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_DOUBLE_EQ(vAnswer(i, j), vOutput(i, j));
+    });
+}
+
+TEST(ArrayUtils, ExtrapolateToRegionFaceCentered3) {
+    Array3<double> u(9, 8, 7);
+    Array3<double> v(8, 9, 7);
+    Array3<double> w(8, 8, 8);
+    Array3<char> uValid(u.size());
+    Array3<char> vValid(v.size());
+    Array3<char> wValid(w.size());
+
+    u.forEachIndex([&](size_t i, size_t j, size_t k) {
+        u(i, j, k) = static_cast<double>(i + j * 3 + k * 5);
+        uValid(i, j, k) = ((i * 5 + j * 3 + k) % 13 == 0) ? 1 : 0;
+    });
+    v.forEachIndex([&](size_t i, size_t j, size_t k) {
+        v(i, j, k) = static_cast<double>(i * 2 + j + k * 7);
+        vValid(i, j, k) = ((i + j * 7 + k * 2) % 17 == 0) ? 1 : 0;
+    });
+    w.forEachIndex([&](size_t i, size_t j, size_t k) {
+        w(i, j, k) = static_cast<double>(i * 4 + j * 2 + k);
+        wValid(i, j, k) = (i > 5 && j < 3) ? 1 : 0;
+    });
+
+    Array3<double> uAnswer(u.size());
+    Array3<double> vAnswer(v.size());
+    Array3<double> wAnswer(w.size());
+    extrapolateToRegion(
+        u.constAccessor(), uValid.constAccessor(), 4, uAnswer.accessor());
+    extrapolateToRegion(
+        v.constAccessor(), vValid.constAccessor(), 4, vAnswer.accessor());
+    extrapolateToRegion(
+        w.constAccessor(), wValid.constAccessor(), 4, wAnswer.accessor());
+
+    Array3<double> uOutput(u.size());
+    Array3<double> vOutput(v.size());
+    Array3<double> wOutput(w.size());
+    extrapolateToRegion(
+        u.constAccessor(), v.constAccessor(), w.constAccessor(),
+        uValid.constAccessor(), vValid.constAccessor(),
+        wValid.constAccessor(), 4,
+        uOutput.accessor(), vOutput.accessor(), wOutput.accessor());
+
+    u.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(uAnswer(i, j, k), uOutput(i, j, k));
+    });
+    v.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(vAnswer(i, j, k), vOutput(i, j, k));
+    });
+    w.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(wAnswer(i, j, k), wOutput(i, j, k));
+    });
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_linear_system_solver_test_helper2.h"
+
+#include <jet/fdm_amgpcg_solver2.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+TEST(FdmAmgpcgSolver2, SolveLowRes) {
+    FdmLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestLinearSystem(&system, {3, 3});
+
+    FdmAmgpcgSolver2 solver(100, 1e-9);
+    solver.solve(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmAmgpcgSolver2, Solve) {
+    FdmLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestLinearSystem(&system,
+                                                            {128, 128});
+
+    FdmAmgpcgSolver2 solver(100, 1e-4);
+
+    EXPECT_TRUE(solver.solve(&system));
+    EXPECT_LT(1u, solver.lastNumberOfLevels());
+}
+
+TEST(FdmAmgpcgSolver2, SolveCompressed) {
+    FdmCompressedLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestCompressedLinearSystem(
+        &system, {3, 3});
+
+    FdmAmgpcgSolver2 solver(100, 1e-4);
+    solver.solveCompressed(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmAmgpcgSolver2, ReuseHierarchy) {
+    FdmCompressedLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestCompressedLinearSystem(
+        &system, {40, 30});
+
+    FdmAmgpcgSolver2 solver(100, 1e-9);
+    EXPECT_TRUE(solver.isReusingHierarchy());
+
+    solver.solveCompressed(&system);
+    EXPECT_FALSE(solver.isLastHierarchyReused());
+    const unsigned int numberOfIterations = solver.lastNumberOfIterations();
+    const VectorND x = system.x;
+
+    solver.solveCompressed(&system);
+    EXPECT_TRUE(solver.isLastHierarchyReused());
+    EXPECT_EQ(numberOfIterations, solver.lastNumberOfIterations());
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_DOUBLE_EQ(x[i], system.x[i]);
+    }
+
+    solver.setIsReusingHierarchy(false);
+    solver.solveCompressed(&system);
+    EXPECT_FALSE(solver.isLastHierarchyReused());
+    EXPECT_EQ(numberOfIterations, solver.lastNumberOfIterations());
+}
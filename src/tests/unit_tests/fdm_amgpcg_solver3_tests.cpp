@@ -0,0 +1,82 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_linear_system_solver_test_helper3.h"
+
+#include <jet/fdm_amgpcg_solver3.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+TEST(FdmAmgpcgSolver3, SolveLowRes) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {3, 3, 3});
+
+    FdmAmgpcgSolver3 solver(100, 1e-9);
+    solver.solve(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmAmgpcgSolver3, Solve) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {32, 32, 32});
+
+    FdmAmgpcgSolver3 solver(100, 1e-4);
+
+    EXPECT_TRUE(solver.solve(&system));
+    EXPECT_LT(1u, solver.lastNumberOfLevels());
+}
+
+TEST(FdmAmgpcgSolver3, SolveCompressed) {
+    FdmCompressedLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(
+        &system, {3, 3, 3});
+
+    FdmAmgpcgSolver3 solver(100, 1e-4);
+    solver.solveCompressed(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmAmgpcgSolver3, SolveStencil) {
+    FdmStencilLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestStencilLinearSystem(&system,
+                                                                   {3, 3, 3});
+
+    FdmAmgpcgSolver3 solver(100, 1e-4);
+    solver.solveStencil(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmAmgpcgSolver3, ReuseHierarchy) {
+    FdmCompressedLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(
+        &system, {20, 16, 12});
+
+    FdmAmgpcgSolver3 solver(100, 1e-9);
+    EXPECT_TRUE(solver.isReusingHierarchy());
+
+    solver.solveCompressed(&system);
+    EXPECT_FALSE(solver.isLastHierarchyReused());
+    const unsigned int numberOfIterations = solver.lastNumberOfIterations();
+    const VectorND x = system.x;
+
+    solver.solveCompressed(&system);
+    EXPECT_TRUE(solver.isLastHierarchyReused());
+    EXPECT_EQ(numberOfIterations, solver.lastNumberOfIterations());
+    for (size_t i = 0; i < x.size(); ++i) {
+        EXPECT_DOUBLE_EQ(x[i], system.x[i]);
+    }
+
+    solver.setIsReusingHierarchy(false);
+    solver.solveCompressed(&system);
+    EXPECT_FALSE(solver.isLastHierarchyReused());
+    EXPECT_EQ(numberOfIterations, solver.lastNumberOfIterations());
+}
@@ -32,3 +32,49 @@ TEST(FdmCgSolver2, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmCgSolver2, SolveSinglePrecision) {
+    FdmLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestLinearSystem(&system, {32, 32});
+    FdmLinearSystem2 expected = system;
+
+    FdmCgSolver2 solverD(1000, 1e-9);
+    solverD.solve(&expected);
+
+    FdmCgSolver2 solver(1000, 1e-9);
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+    solver.solve(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+
+    FdmVector2 residual(system.x.size());
+    FdmBlas2::residual(system.A, system.x, system.b, &residual);
+    EXPECT_GT(1e-8, FdmBlas2::l2Norm(residual));
+
+    system.x.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_NEAR(expected.x(i, j), system.x(i, j), 1e-7);
+    });
+}
+
+TEST(FdmCgSolver2, SolveFloat) {
+    FdmLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestLinearSystem(&system, {3, 3});
+
+    FdmLinearSystem2F systemF;
+    systemF.resize(system.A.size());
+    system.A.forEachIndex([&](size_t i, size_t j) {
+        const FdmMatrixRow2& row = system.A(i, j);
+        FdmMatrixRow2F& rowF = systemF.A(i, j);
+        rowF.center = static_cast<float>(row.center);
+        rowF.right = static_cast<float>(row.right);
+        rowF.up = static_cast<float>(row.up);
+        systemF.b(i, j) = static_cast<float>(system.b(i, j));
+    });
+
+    FdmCgSolver2 solver(100, 1e-5);
+    solver.solve(&systemF);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
@@ -32,3 +32,61 @@ TEST(FdmCgSolver3, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmCgSolver3, SolveStencil) {
+    FdmStencilLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestStencilLinearSystem(&system,
+                                                                   {3, 3, 3});
+
+    FdmCgSolver3 solver(100, 1e-9);
+    solver.solveStencil(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmCgSolver3, SolveSinglePrecision) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {16, 16, 16});
+    FdmLinearSystem3 expected = system;
+
+    FdmCgSolver3 solverD(1000, 1e-9);
+    solverD.solve(&expected);
+
+    FdmCgSolver3 solver(1000, 1e-9);
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+    solver.solve(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+
+    FdmVector3 residual(system.x.size());
+    FdmBlas3::residual(system.A, system.x, system.b, &residual);
+    EXPECT_GT(1e-8, FdmBlas3::l2Norm(residual));
+
+    system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected.x(i, j, k), system.x(i, j, k), 1e-7);
+    });
+}
+
+TEST(FdmCgSolver3, SolveFloat) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {3, 3, 3});
+
+    FdmLinearSystem3F systemF;
+    systemF.resize(system.A.size());
+    system.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const FdmMatrixRow3& row = system.A(i, j, k);
+        FdmMatrixRow3F& rowF = systemF.A(i, j, k);
+        rowF.center = static_cast<float>(row.center);
+        rowF.right = static_cast<float>(row.right);
+        rowF.up = static_cast<float>(row.up);
+        rowF.front = static_cast<float>(row.front);
+        systemF.b(i, j, k) = static_cast<float>(system.b(i, j, k));
+    });
+
+    FdmCgSolver3 solver(100, 1e-5);
+    solver.solve(&systemF);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
@@ -111,3 +111,14 @@ TEST(FdmGaussSeidelSolver3, SolveCompressed) {
 
     EXPECT_LT(norm1, norm0);
 }
+
+TEST(FdmGaussSeidelSolver3, SolveStencil) {
+    FdmStencilLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestStencilLinearSystem(&system,
+                                                                   {3, 3, 3});
+
+    FdmGaussSeidelSolver3 solver(100, 10, 1e-9);
+    solver.solveStencil(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
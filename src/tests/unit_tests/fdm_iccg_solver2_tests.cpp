@@ -38,3 +38,47 @@ TEST(FdmIccgSolver2, SolveCompressed) {
     FdmIccgSolver2 solver(200, 1e-4);
     EXPECT_TRUE(solver.solve(&system));
 }
+
+TEST(FdmIccgSolver2, SolveParallelPreconditioner) {
+    FdmLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestLinearSystem(&system,
+                                                            {160, 96});
+    FdmLinearSystem2 systemParallel = system;
+
+    FdmIccgSolver2 solver(100, 1e-9);
+    solver.solve(&system);
+
+    FdmIccgSolver2 solverParallel(100, 1e-9);
+    EXPECT_FALSE(solverParallel.isUsingParallelPreconditioner());
+    solverParallel.setIsUsingParallelPreconditioner(true);
+    EXPECT_TRUE(solverParallel.isUsingParallelPreconditioner());
+    solverParallel.solve(&systemParallel);
+
+    EXPECT_EQ(solver.lastNumberOfIterations(),
+              solverParallel.lastNumberOfIterations());
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), solverParallel.lastResidual());
+    system.x.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_DOUBLE_EQ(system.x(i, j), systemParallel.x(i, j));
+    });
+}
+
+TEST(FdmIccgSolver2, SolveCompressedParallelPreconditioner) {
+    FdmCompressedLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestCompressedLinearSystem(
+        &system, {32, 24});
+    FdmCompressedLinearSystem2 systemParallel = system;
+
+    FdmIccgSolver2 solver(100, 1e-9);
+    solver.solveCompressed(&system);
+
+    FdmIccgSolver2 solverParallel(100, 1e-9);
+    solverParallel.setIsUsingParallelPreconditioner(true);
+    solverParallel.solveCompressed(&systemParallel);
+
+    EXPECT_EQ(solver.lastNumberOfIterations(),
+              solverParallel.lastNumberOfIterations());
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), solverParallel.lastResidual());
+    for (size_t i = 0; i < system.x.size(); ++i) {
+        EXPECT_DOUBLE_EQ(system.x[i], systemParallel.x[i]);
+    }
+}
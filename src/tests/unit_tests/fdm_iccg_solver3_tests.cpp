@@ -43,3 +43,79 @@ TEST(FdmIccgSolver3, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmIccgSolver3, SolveStencil) {
+    FdmStencilLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestStencilLinearSystem(&system,
+                                                                   {3, 3, 3});
+
+    FdmIccgSolver3 solver(100, 1e-4);
+    solver.solveStencil(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
+
+TEST(FdmIccgSolver3, SolveStencilParallelPreconditioner) {
+    FdmStencilLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestStencilLinearSystem(
+        &system, {64, 40, 24});
+    FdmStencilLinearSystem3 systemParallel = system;
+
+    FdmIccgSolver3 solver(100, 1e-9);
+    solver.solveStencil(&system);
+
+    FdmIccgSolver3 solverParallel(100, 1e-9);
+    solverParallel.setIsUsingParallelPreconditioner(true);
+    solverParallel.solveStencil(&systemParallel);
+
+    EXPECT_EQ(solver.lastNumberOfIterations(),
+              solverParallel.lastNumberOfIterations());
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), solverParallel.lastResidual());
+    for (size_t i = 0; i < system.x.size(); ++i) {
+        EXPECT_DOUBLE_EQ(system.x[i], systemParallel.x[i]);
+    }
+}
+
+TEST(FdmIccgSolver3, SolveParallelPreconditioner) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system,
+                                                            {64, 40, 24});
+    FdmLinearSystem3 systemParallel = system;
+
+    FdmIccgSolver3 solver(100, 1e-9);
+    solver.solve(&system);
+
+    FdmIccgSolver3 solverParallel(100, 1e-9);
+    EXPECT_FALSE(solverParallel.isUsingParallelPreconditioner());
+    solverParallel.setIsUsingParallelPreconditioner(true);
+    EXPECT_TRUE(solverParallel.isUsingParallelPreconditioner());
+    solverParallel.solve(&systemParallel);
+
+    EXPECT_EQ(solver.lastNumberOfIterations(),
+              solverParallel.lastNumberOfIterations());
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), solverParallel.lastResidual());
+    system.x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(system.x(i, j, k), systemParallel.x(i, j, k));
+    });
+}
+
+TEST(FdmIccgSolver3, SolveCompressedParallelPreconditioner) {
+    FdmCompressedLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(
+        &system, {80, 80, 80});
+    FdmCompressedLinearSystem3 systemParallel = system;
+
+    FdmIccgSolver3 solver(10, 1e-4);
+    solver.solveCompressed(&system);
+
+    FdmIccgSolver3 solverParallel(10, 1e-4);
+    solverParallel.setIsUsingParallelPreconditioner(true);
+    solverParallel.solveCompressed(&systemParallel);
+
+    EXPECT_EQ(solver.lastNumberOfIterations(),
+              solverParallel.lastNumberOfIterations());
+    EXPECT_DOUBLE_EQ(solver.lastResidual(), solverParallel.lastResidual());
+    for (size_t i = 0; i < system.x.size(); ++i) {
+        EXPECT_DOUBLE_EQ(system.x[i], systemParallel.x[i]);
+    }
+}
@@ -32,3 +32,14 @@ TEST(FdmJacobiSolver3, SolveCompressed) {
 
     EXPECT_GT(solver.tolerance(), solver.lastResidual());
 }
+
+TEST(FdmJacobiSolver3, SolveStencil) {
+    FdmStencilLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestStencilLinearSystem(&system,
+                                                                   {3, 3, 3});
+
+    FdmJacobiSolver3 solver(100, 10, 1e-9);
+    solver.solveStencil(&system);
+
+    EXPECT_GT(solver.tolerance(), solver.lastResidual());
+}
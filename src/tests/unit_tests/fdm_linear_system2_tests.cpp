@@ -0,0 +1,110 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_linear_system_solver_test_helper2.h"
+
+#include <jet/fdm_linear_system2.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+namespace {
+
+void fillTestVector(FdmVector2* v, double phase) {
+    v->forEachIndex([&](size_t i, size_t j) {
+        (*v)(i, j) = std::sin(phase + 0.3 * i + 0.7 * j);
+    });
+}
+
+}  // namespace
+
+TEST(FdmBlas2, MvmAndDot) {
+    FdmLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestLinearSystem(&system, {9, 7});
+
+    FdmVector2 v(system.x.size());
+    fillTestVector(&v, 0.5);
+
+    FdmVector2 expected(v.size());
+    FdmBlas2::mvm(system.A, v, &expected);
+    const double expectedDot = FdmBlas2::dot(v, expected);
+
+    FdmVector2 result(v.size());
+    const double dot = FdmBlas2::mvmAndDot(system.A, v, &result);
+
+    EXPECT_NEAR(expectedDot, dot, 1e-12);
+    result.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_DOUBLE_EQ(expected(i, j), result(i, j));
+    });
+}
+
+TEST(FdmBlas2, AxpyPairAndDot) {
+    const Size2 size(9, 7);
+    FdmVector2 d(size), q(size), x(size), r(size);
+    fillTestVector(&d, 0.1);
+    fillTestVector(&q, 0.2);
+    fillTestVector(&x, 0.3);
+    fillTestVector(&r, 0.4);
+
+    FdmVector2 expectedX(x), expectedR(r);
+    FdmBlas2::axpy(0.25, d, expectedX, &expectedX);
+    FdmBlas2::axpy(-0.25, q, expectedR, &expectedR);
+    const double expectedDot = FdmBlas2::dot(expectedR, expectedR);
+
+    const double dot = FdmBlas2::axpyPairAndDot(0.25, d, q, &x, &r);
+
+    EXPECT_NEAR(expectedDot, dot, 1e-12);
+    x.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_DOUBLE_EQ(expectedX(i, j), x(i, j));
+        EXPECT_DOUBLE_EQ(expectedR(i, j), r(i, j));
+    });
+}
+
+TEST(FdmCompressedBlas2, MvmAndDot) {
+    FdmCompressedLinearSystem2 system;
+    FdmLinearSystemSolverTestHelper2::buildTestCompressedLinearSystem(
+        &system, {9, 7});
+
+    VectorND v(system.b.size());
+    v.forEachIndex([&](size_t i) { v[i] = std::sin(0.5 + 0.3 * i); });
+
+    VectorND expected(v.size());
+    FdmCompressedBlas2::mvm(system.A, v, &expected);
+    const double expectedDot = FdmCompressedBlas2::dot(v, expected);
+
+    VectorND result(v.size());
+    const double dot = FdmCompressedBlas2::mvmAndDot(system.A, v, &result);
+
+    EXPECT_NEAR(expectedDot, dot, 1e-12);
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_DOUBLE_EQ(expected[i], result[i]);
+    }
+}
+
+TEST(FdmCompressedBlas2, AxpyPairAndDot) {
+    const size_t n = 10000;
+    VectorND d(n), q(n), x(n), r(n);
+    for (size_t i = 0; i < n; ++i) {
+        d[i] = std::sin(0.1 + 0.3 * i);
+        q[i] = std::sin(0.2 + 0.3 * i);
+        x[i] = std::sin(0.3 + 0.3 * i);
+        r[i] = std::sin(0.4 + 0.3 * i);
+    }
+
+    VectorND expectedX(x), expectedR(r);
+    FdmCompressedBlas2::axpy(0.25, d, expectedX, &expectedX);
+    FdmCompressedBlas2::axpy(-0.25, q, expectedR, &expectedR);
+    const double expectedDot = FdmCompressedBlas2::dot(expectedR, expectedR);
+
+    const double dot = FdmCompressedBlas2::axpyPairAndDot(0.25, d, q, &x, &r);
+
+    EXPECT_NEAR(expectedDot, dot, 1e-9);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_DOUBLE_EQ(expectedX[i], x[i]);
+        EXPECT_DOUBLE_EQ(expectedR[i], r[i]);
+    }
+}
@@ -0,0 +1,208 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include "fdm_linear_system_solver_test_helper3.h"
+
+#include <jet/fdm_linear_system3.h>
+
+#include <gtest/gtest.h>
+
+using namespace jet;
+
+namespace {
+
+void fillTestVector(FdmVector3* v, double phase) {
+    v->forEachIndex([&](size_t i, size_t j, size_t k) {
+        (*v)(i, j, k) = std::sin(phase + 0.3 * i + 0.7 * j + 1.1 * k);
+    });
+}
+
+}  // namespace
+
+TEST(FdmBlas3, MvmAndDot) {
+    FdmLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestLinearSystem(&system, {9, 7, 5});
+
+    FdmVector3 v(system.x.size());
+    fillTestVector(&v, 0.5);
+
+    FdmVector3 expected(v.size());
+    FdmBlas3::mvm(system.A, v, &expected);
+    const double expectedDot = FdmBlas3::dot(v, expected);
+
+    FdmVector3 result(v.size());
+    const double dot = FdmBlas3::mvmAndDot(system.A, v, &result);
+
+    EXPECT_NEAR(expectedDot, dot, 1e-12);
+    result.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(expected(i, j, k), result(i, j, k));
+    });
+}
+
+TEST(FdmBlas3, AxpyPairAndDot) {
+    const Size3 size(9, 7, 5);
+    FdmVector3 d(size), q(size), x(size), r(size);
+    fillTestVector(&d, 0.1);
+    fillTestVector(&q, 0.2);
+    fillTestVector(&x, 0.3);
+    fillTestVector(&r, 0.4);
+
+    FdmVector3 expectedX(x), expectedR(r);
+    FdmBlas3::axpy(0.25, d, expectedX, &expectedX);
+    FdmBlas3::axpy(-0.25, q, expectedR, &expectedR);
+    const double expectedDot = FdmBlas3::dot(expectedR, expectedR);
+
+    const double dot = FdmBlas3::axpyPairAndDot(0.25, d, q, &x, &r);
+
+    EXPECT_NEAR(expectedDot, dot, 1e-12);
+    x.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(expectedX(i, j, k), x(i, j, k));
+        EXPECT_DOUBLE_EQ(expectedR(i, j, k), r(i, j, k));
+    });
+}
+
+TEST(FdmCompressedBlas3, MvmAndDot) {
+    FdmCompressedLinearSystem3 system;
+    FdmLinearSystemSolverTestHelper3::buildTestCompressedLinearSystem(
+        &system, {9, 7, 5});
+
+    VectorND v(system.b.size());
+    v.forEachIndex([&](size_t i) { v[i] = std::sin(0.5 + 0.3 * i); });
+
+    VectorND expected(v.size());
+    FdmCompressedBlas3::mvm(system.A, v, &expected);
+    const double expectedDot = FdmCompressedBlas3::dot(v, expected);
+
+    VectorND result(v.size());
+    const double dot = FdmCompressedBlas3::mvmAndDot(system.A, v, &result);
+
+    EXPECT_NEAR(expectedDot, dot, 1e-12);
+    for (size_t i = 0; i < v.size(); ++i) {
+        EXPECT_DOUBLE_EQ(expected[i], result[i]);
+    }
+}
+
+TEST(FdmCompressedBlas3, AxpyPairAndDot) {
+    const size_t n = 10000;
+    VectorND d(n), q(n), x(n), r(n);
+    for (size_t i = 0; i < n; ++i) {
+        d[i] = std::sin(0.1 + 0.3 * i);
+        q[i] = std::sin(0.2 + 0.3 * i);
+        x[i] = std::sin(0.3 + 0.3 * i);
+        r[i] = std::sin(0.4 + 0.3 * i);
+    }
+
+    VectorND expectedX(x), expectedR(r);
+    FdmCompressedBlas3::axpy(0.25, d, expectedX, &expectedX);
+    FdmCompressedBlas3::axpy(-0.25, q, expectedR, &expectedR);
+    const double expectedDot = FdmCompressedBlas3::dot(expectedR, expectedR);
+
+    const double dot = FdmCompressedBlas3::axpyPairAndDot(0.25, d, q, &x, &r);
+
+    EXPECT_NEAR(expectedDot, dot, 1e-9);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_DOUBLE_EQ(expectedX[i], x[i]);
+        EXPECT_DOUBLE_EQ(expectedR[i], r[i]);
+    }
+}
+
+TEST(FdmStencilMatrix3, Resize) {
+    FdmStencilMatrix3 matrix;
+    matrix.resize({4, 3, 2}, [](size_t i, size_t j, size_t k) {
+        return (i + j + k) % 2 == 0;
+    });
+
+    EXPECT_EQ(12u, matrix.numberOfRows());
+    EXPECT_EQ(Size3(4, 3, 2), matrix.rowIndices.size());
+
+    size_t row = 0;
+    matrix.rowIndices.forEachIndex([&](size_t i, size_t j, size_t k) {
+        if ((i + j + k) % 2 == 0) {
+            EXPECT_EQ(row, matrix.rowIndices(i, j, k));
+            EXPECT_EQ(i + 4 * (j + 3 * k), matrix.cellIndices[row]);
+            EXPECT_EQ(0.0f, matrix.rows[row].center);
+            ++row;
+        } else {
+            EXPECT_EQ(FdmStencilMatrix3::kInvalidRow,
+                      matrix.rowIndices(i, j, k));
+        }
+    });
+}
+
+TEST(FdmStencilBlas3, Mvm) {
+    // Poisson-like system with holes of inactive points
+    const Size3 size(9, 7, 5);
+    auto isActive = [](size_t i, size_t j, size_t k) {
+        return (i + 2 * j + 3 * k) % 5 != 0;
+    };
+
+    FdmMatrix3 denseMatrix(size);
+    FdmVector3 v(size);
+    fillTestVector(&v, 0.5);
+    denseMatrix.forEachIndex([&](size_t i, size_t j, size_t k) {
+        FdmMatrixRow3& row = denseMatrix(i, j, k);
+        if (!isActive(i, j, k)) {
+            row.center = 1.0;
+            v(i, j, k) = 0.0;
+            return;
+        }
+
+        row.center = 6.0;
+        if (i + 1 < size.x && isActive(i + 1, j, k)) {
+            row.right = -1.0 - 0.1 * i;
+        }
+        if (j + 1 < size.y && isActive(i, j + 1, k)) {
+            row.up = -1.0 - 0.1 * j;
+        }
+        if (k + 1 < size.z && isActive(i, j, k + 1)) {
+            row.front = -1.0 - 0.1 * k;
+        }
+    });
+
+    FdmStencilMatrix3 stencilMatrix;
+    stencilMatrix.resize(size, isActive);
+    VectorND stencilV(stencilMatrix.numberOfRows());
+    denseMatrix.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const uint32_t row = stencilMatrix.rowIndices(i, j, k);
+        if (row != FdmStencilMatrix3::kInvalidRow) {
+            const FdmMatrixRow3& denseRow = denseMatrix(i, j, k);
+            stencilMatrix.rows[row].center = (float)denseRow.center;
+            stencilMatrix.rows[row].right = (float)denseRow.right;
+            stencilMatrix.rows[row].up = (float)denseRow.up;
+            stencilMatrix.rows[row].front = (float)denseRow.front;
+            stencilV[row] = v(i, j, k);
+        }
+    });
+
+    FdmVector3 expected(size);
+    FdmBlas3::mvm(denseMatrix, v, &expected);
+
+    VectorND result(stencilV.size());
+    FdmStencilBlas3::mvm(stencilMatrix, stencilV, &result);
+
+    VectorND fusedResult(stencilV.size());
+    const double dot =
+        FdmStencilBlas3::mvmAndDot(stencilMatrix, stencilV, &fusedResult);
+
+    // The coefficients are rounded to float in the stencil matrix.
+    double expectedDot = 0.0;
+    denseMatrix.forEachIndex([&](size_t i, size_t j, size_t k) {
+        const uint32_t row = stencilMatrix.rowIndices(i, j, k);
+        if (row != FdmStencilMatrix3::kInvalidRow) {
+            EXPECT_NEAR(expected(i, j, k), result[row], 1e-6);
+            EXPECT_DOUBLE_EQ(result[row], fusedResult[row]);
+            expectedDot += v(i, j, k) * expected(i, j, k);
+        }
+    });
+    EXPECT_NEAR(expectedDot, dot, 1e-4);
+
+    VectorND b(stencilV.size(), 1.0);
+    VectorND residual(stencilV.size());
+    FdmStencilBlas3::residual(stencilMatrix, stencilV, b, &residual);
+    for (size_t i = 0; i < residual.size(); ++i) {
+        EXPECT_DOUBLE_EQ(1.0 - result[i], residual[i]);
+    }
+}
@@ -117,6 +117,25 @@ class FdmLinearSystemSolverTestHelper3 {
 
         system->x.resize(system->b.size(), 0.0);
     }
+
+    static void buildTestStencilLinearSystem(FdmStencilLinearSystem3* system,
+                                             const Size3& size) {
+        FdmLinearSystem3 denseSystem;
+        buildTestLinearSystem(&denseSystem, size);
+
+        system->resize(size, [](size_t, size_t, size_t) { return true; });
+
+        denseSystem.A.forEachIndex([&](size_t i, size_t j, size_t k) {
+            const size_t row = system->A.rowIndices(i, j, k);
+            const FdmMatrixRow3& denseRow = denseSystem.A(i, j, k);
+            FdmMatrixRow3F& stencilRow = system->A.rows[row];
+            stencilRow.center = static_cast<float>(denseRow.center);
+            stencilRow.right = static_cast<float>(denseRow.right);
+            stencilRow.up = static_cast<float>(denseRow.up);
+            stencilRow.front = static_cast<float>(denseRow.front);
+            system->b[row] = denseSystem.b(i, j, k);
+        });
+    }
 };
 
 }  // namespace jet
@@ -8,16 +8,19 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 using namespace jet;
 
 TEST(FdmMgUtils2, ResizeArrayWithFinest) {
     std::vector<Array2<double>> levels;
     FdmMgUtils2::resizeArrayWithFinest({100, 200}, 4, &levels);
 
-    EXPECT_EQ(3u, levels.size());
+    EXPECT_EQ(4u, levels.size());
     EXPECT_EQ(Size2(100, 200), levels[0].size());
     EXPECT_EQ(Size2(50, 100), levels[1].size());
     EXPECT_EQ(Size2(25, 50), levels[2].size());
+    EXPECT_EQ(Size2(13, 25), levels[3].size());
 
     FdmMgUtils2::resizeArrayWithFinest({32, 16}, 6, &levels);
     EXPECT_EQ(5u, levels.size());
@@ -29,4 +32,32 @@ TEST(FdmMgUtils2, ResizeArrayWithFinest) {
 
     FdmMgUtils2::resizeArrayWithFinest({16, 16}, 6, &levels);
     EXPECT_EQ(5u, levels.size());
+
+    FdmMgUtils2::resizeArrayWithFinest({37, 20}, 10, &levels);
+    EXPECT_EQ(6u, levels.size());
+    EXPECT_EQ(Size2(37, 20), levels[0].size());
+    EXPECT_EQ(Size2(19, 10), levels[1].size());
+    EXPECT_EQ(Size2(10, 5), levels[2].size());
+    EXPECT_EQ(Size2(5, 3), levels[3].size());
+    EXPECT_EQ(Size2(3, 2), levels[4].size());
+    EXPECT_EQ(Size2(2, 1), levels[5].size());
+}
+
+TEST(FdmMgUtils2, RestrictAndCorrectOddSize) {
+    FdmVector2 finer(7, 6, 3.0);
+    FdmVector2 coarser(4, 3);
+
+    FdmMgUtils2::restrict(finer, &coarser);
+    EXPECT_DOUBLE_EQ(3.0, coarser(1, 1));
+
+    // Every finer cell contributes 1/4 in total, including the padded ones.
+    EXPECT_DOUBLE_EQ(0.25 * std::accumulate(finer.begin(), finer.end(), 0.0),
+                     std::accumulate(coarser.begin(), coarser.end(), 0.0));
+
+    coarser.set(3.0);
+    finer.set(1.0);
+    FdmMgUtils2::correct(coarser, &finer);
+    finer.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_DOUBLE_EQ(4.0, finer(i, j));
+    });
 }
@@ -0,0 +1,55 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/fdm_mg_linear_system3.h>
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+using namespace jet;
+
+TEST(FdmMgUtils3, ResizeArrayWithFinest) {
+    std::vector<Array3<double>> levels;
+    FdmMgUtils3::resizeArrayWithFinest({384, 192, 256}, 4, &levels);
+
+    EXPECT_EQ(4u, levels.size());
+    EXPECT_EQ(Size3(384, 192, 256), levels[0].size());
+    EXPECT_EQ(Size3(192, 96, 128), levels[1].size());
+    EXPECT_EQ(Size3(96, 48, 64), levels[2].size());
+    EXPECT_EQ(Size3(48, 24, 32), levels[3].size());
+
+    FdmMgUtils3::resizeArrayWithFinest({37, 20, 11}, 10, &levels);
+    EXPECT_EQ(5u, levels.size());
+    EXPECT_EQ(Size3(37, 20, 11), levels[0].size());
+    EXPECT_EQ(Size3(19, 10, 6), levels[1].size());
+    EXPECT_EQ(Size3(10, 5, 3), levels[2].size());
+    EXPECT_EQ(Size3(5, 3, 2), levels[3].size());
+    EXPECT_EQ(Size3(3, 2, 1), levels[4].size());
+
+    FdmMgUtils3::resizeArrayWithFinest({16, 16, 16}, 10, &levels);
+    EXPECT_EQ(5u, levels.size());
+    EXPECT_EQ(Size3(1, 1, 1), levels[4].size());
+}
+
+TEST(FdmMgUtils3, RestrictAndCorrectOddSize) {
+    FdmVector3 finer(7, 6, 5, 3.0);
+    FdmVector3 coarser(4, 3, 3);
+
+    FdmMgUtils3::restrict(finer, &coarser);
+    EXPECT_DOUBLE_EQ(3.0, coarser(1, 1, 1));
+
+    // Every finer cell contributes 1/8 in total, including the padded ones.
+    EXPECT_DOUBLE_EQ(0.125 * std::accumulate(finer.begin(), finer.end(), 0.0),
+                     std::accumulate(coarser.begin(), coarser.end(), 0.0));
+
+    coarser.set(3.0);
+    finer.set(1.0);
+    FdmMgUtils3::correct(coarser, &finer);
+    finer.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(4.0, finer(i, j, k));
+    });
+}
@@ -10,18 +10,16 @@
 
 using namespace jet;
 
-TEST(FdmMgSolver3, Solve) {
-    size_t levels = 6;
-    FdmMgLinearSystem3 system;
-    system.resizeWithCoarsest({4, 4, 4}, levels);
+namespace {
 
-    // Simple Poisson eq.
-    for (size_t l = 0; l < system.numberOfLevels(); ++l) {
+template <typename System>
+void buildPoissonSystem(System* system) {
+    for (size_t l = 0; l < system->numberOfLevels(); ++l) {
         double invdx = pow(0.5, l);
-        FdmMatrix3& A = system.A[l];
-        FdmVector3& b = system.b[l];
+        auto& A = system->A[l];
+        auto& b = system->b[l];
 
-        system.x[l].set(0);
+        system->x[l].set(0);
 
         A.forEachIndex([&](size_t i, size_t j, size_t k) {
             if (i > 0) {
@@ -54,6 +52,17 @@ TEST(FdmMgSolver3, Solve) {
             }
         });
     }
+}
+
+}  // namespace
+
+TEST(FdmMgSolver3, Solve) {
+    size_t levels = 6;
+    FdmMgLinearSystem3 system;
+    system.resizeWithCoarsest({4, 4, 4}, levels);
+
+    // Simple Poisson eq.
+    buildPoissonSystem(&system);
 
     auto buffer = system.x[0];
     FdmBlas3::residual(system.A[0], system.x[0], system.b[0], &buffer);
@@ -67,3 +76,59 @@ TEST(FdmMgSolver3, Solve) {
 
     EXPECT_LT(norm1, norm0);
 }
+
+TEST(FdmMgSolver3, SolveSinglePrecision) {
+    size_t levels = 6;
+    FdmMgLinearSystem3F system;
+    system.resizeWithCoarsest({4, 4, 4}, levels);
+
+    // Simple Poisson eq.
+    buildPoissonSystem(&system);
+
+    auto buffer = system.x[0];
+    FdmBlas3F::residual(system.A[0], system.x[0], system.b[0], &buffer);
+    double norm0 = FdmBlas3F::l2Norm(buffer);
+
+    FdmMgSolver3 solver(levels, 5, 5, 20, 20, 1e-9);
+    solver.setIsUsingCgAtCoarsestLevel(true);
+    solver.solve(&system);
+
+    FdmBlas3F::residual(system.A[0], system.x[0], system.b[0], &buffer);
+    double norm1 = FdmBlas3F::l2Norm(buffer);
+
+    EXPECT_LT(norm1, 0.1 * norm0);
+}
+
+TEST(FdmMgSolver3, SolveNonPowerOfTwo) {
+    const MgCycleType cycleTypes[] = {MgCycleType::kV, MgCycleType::kW,
+                                      MgCycleType::kF};
+
+    double norms[3];
+    for (size_t c = 0; c < 3; ++c) {
+        size_t levels = 4;
+        FdmMgLinearSystem3 system;
+        system.resizeWithFinest({37, 20, 29}, levels);
+
+        buildPoissonSystem(&system);
+
+        auto buffer = system.x[0];
+        FdmBlas3::residual(system.A[0], system.x[0], system.b[0], &buffer);
+        double norm0 = FdmBlas3::l2Norm(buffer);
+
+        FdmMgSolver3 solver(levels, 5, 5, 20, 20, 1e-9);
+        solver.setCycleType(cycleTypes[c]);
+        solver.setIsUsingCgAtCoarsestLevel(true);
+        EXPECT_EQ(cycleTypes[c], solver.cycleType());
+        EXPECT_TRUE(solver.isUsingCgAtCoarsestLevel());
+        solver.solve(&system);
+
+        FdmBlas3::residual(system.A[0], system.x[0], system.b[0], &buffer);
+        norms[c] = FdmBlas3::l2Norm(buffer);
+
+        EXPECT_LT(norms[c], norm0);
+    }
+
+    // W- and F-cycles spend more work on the coarser levels per cycle.
+    EXPECT_LE(norms[1], norms[0]);
+    EXPECT_LE(norms[2], norms[0]);
+}
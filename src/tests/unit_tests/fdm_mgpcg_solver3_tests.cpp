@@ -10,18 +10,16 @@
 
 using namespace jet;
 
-TEST(FdmMgpcgSolver3, Solve) {
-    size_t levels = 4;
-    FdmMgLinearSystem3 system;
-    system.resizeWithCoarsest({4, 4, 4}, levels);
+namespace {
 
-    // Simple Poisson eq.
-    for (size_t l = 0; l < system.numberOfLevels(); ++l) {
+template <typename System>
+void buildPoissonSystem(System* system) {
+    for (size_t l = 0; l < system->numberOfLevels(); ++l) {
         double invdx = pow(0.5, l);
-        FdmMatrix3& A = system.A[l];
-        FdmVector3& b = system.b[l];
+        auto& A = system->A[l];
+        auto& b = system->b[l];
 
-        system.x[l].set(0);
+        system->x[l].set(0);
 
         A.forEachIndex([&](size_t i, size_t j, size_t k) {
             if (i > 0) {
@@ -54,7 +52,52 @@ TEST(FdmMgpcgSolver3, Solve) {
             }
         });
     }
+}
+
+}  // namespace
+
+TEST(FdmMgpcgSolver3, Solve) {
+    size_t levels = 4;
+    FdmMgLinearSystem3 system;
+    system.resizeWithCoarsest({4, 4, 4}, levels);
+
+    // Simple Poisson eq.
+    buildPoissonSystem(&system);
 
     FdmMgpcgSolver3 solver(50, levels, 5, 5, 10, 10, 1e-4, 1.5, false);
     EXPECT_TRUE(solver.solve(&system));
 }
+
+TEST(FdmMgpcgSolver3, SolveSinglePrecision) {
+    size_t levels = 4;
+    FdmMgLinearSystem3F system;
+    system.resizeWithFinest({37, 20, 29}, levels);
+
+    // Simple Poisson eq.
+    buildPoissonSystem(&system);
+
+    FdmMgpcgSolver3 solver(50, levels, 5, 5, 10, 10, 1e-4, 1.5, false);
+    EXPECT_TRUE(solver.solve(&system));
+    EXPECT_GT(50u, solver.lastNumberOfIterations());
+    EXPECT_GE(1e-4, solver.lastResidual());
+}
+
+TEST(FdmMgpcgSolver3, SolveNonPowerOfTwo) {
+    const MgCycleType cycleTypes[] = {MgCycleType::kV, MgCycleType::kW,
+                                      MgCycleType::kF};
+
+    for (MgCycleType cycleType : cycleTypes) {
+        size_t levels = 5;
+        FdmMgLinearSystem3 system;
+        system.resizeWithFinest({37, 20, 29}, levels);
+        EXPECT_EQ(levels, system.numberOfLevels());
+
+        buildPoissonSystem(&system);
+
+        FdmMgpcgSolver3 solver(50, levels, 5, 5, 10, 10, 1e-4, 1.5, false);
+        solver.setCycleType(cycleType);
+        solver.setIsUsingCgAtCoarsestLevel(true);
+        EXPECT_TRUE(solver.solve(&system));
+        EXPECT_GT(50u, solver.lastNumberOfIterations());
+    }
+}
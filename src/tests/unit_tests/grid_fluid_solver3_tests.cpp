@@ -4,8 +4,14 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/cell_centered_scalar_grid3.h>
 #include <jet/grid_fluid_solver3.h>
+#include <jet/parallel.h>
+#include <jet/semi_lagrangian3.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
 
 using namespace jet;
 
@@ -52,6 +58,39 @@ TEST(GridFluidSolver3, ResizeGridSystemData) {
     EXPECT_EQ(9.0, solver.gridOrigin().z);
 }
 
+TEST(GridFluidSolver3, Cfl) {
+    unsigned int oldNumThreads = maxNumberOfThreads();
+
+    GridFluidSolver3 solver;
+    solver.resizeGrid(Size3(13, 20, 17), Vector3D(0.5, 0.25, 0.75),
+                      Vector3D());
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> d(-3.0, 3.0);
+    auto vel = solver.velocity();
+    vel->fill([&](const Vector3D&) {
+        return Vector3D(d(rng), d(rng), d(rng));
+    }, ExecutionPolicy::kSerial);
+
+    // Serial loop that cfl used before the parallel reduction
+    const double dt = 0.1;
+    double maxVel = 0.0;
+    vel->forEachCellIndex([&](size_t i, size_t j, size_t k) {
+        Vector3D v = vel->valueAtCellCenter(i, j, k) + dt * solver.gravity();
+        maxVel = std::max(maxVel, v.x);
+        maxVel = std::max(maxVel, v.y);
+        maxVel = std::max(maxVel, v.z);
+    });
+    const double expected = maxVel * dt / 0.25;
+
+    for (unsigned int numThreads : {1u, 2u, 3u, 8u}) {
+        setMaxNumberOfThreads(numThreads);
+        EXPECT_EQ(expected, solver.cfl(dt)) << numThreads;
+    }
+
+    setMaxNumberOfThreads(oldNumThreads);
+}
+
 TEST(GridFluidSolver3, MinimumResolution) {
     GridFluidSolver3 solver;
 
@@ -95,3 +134,39 @@ TEST(GridFluidSolver3, GravityOnly) {
         EXPECT_NEAR(0.0, solver.velocity()->w(i, j, k), 1e-8);
     });
 }
+
+TEST(GridFluidSolver3, AdvectsSparseScalarData) {
+    GridFluidSolver3 solver;
+    solver.setGravity(Vector3D());
+    solver.setAdvectionSolver(std::make_shared<SemiLagrangian3>());
+    solver.setDiffusionSolver(nullptr);
+    solver.setPressureSolver(nullptr);
+
+    solver.resizeGrid(Size3(32, 32, 32), Vector3D(1, 1, 1) / 32.0,
+                      Vector3D());
+    solver.velocity()->fill(Vector3D(1.0, 0.5, 0.0));
+
+    auto grids = solver.gridSystemData();
+    size_t denseIdx = grids->addAdvectableScalarData(
+        std::make_shared<CellCenteredScalarGrid3::Builder>());
+    size_t sparseIdx = grids->addAdvectableSparseScalarData(
+        std::make_shared<SparseCellCenteredScalarGrid3::Builder>());
+
+    auto blob = [](const Vector3D& pt) {
+        const double r = pt.distanceTo(Vector3D(0.3, 0.4, 0.5));
+        return (r < 0.15) ? 1.0 - r : 0.0;
+    };
+    auto dense = grids->advectableScalarDataAt(denseIdx);
+    auto sparse = grids->advectableSparseScalarDataAt(sparseIdx);
+    dense->fill(blob);
+    sparse->fill(blob);
+
+    Frame frame(0, 0.05);
+    solver.update(frame);
+
+    EXPECT_LT(0u, sparse->data().numberOfActiveTiles());
+    EXPECT_LT(sparse->data().numberOfActiveTiles(), 4u * 4u * 4u);
+    dense->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR((*dense)(i, j, k), (*sparse)(i, j, k), 1e-12);
+    });
+}
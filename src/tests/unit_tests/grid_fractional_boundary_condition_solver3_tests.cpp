@@ -89,3 +89,53 @@ TEST(GridFractionalBoundaryConditionSolver3, OpenDomain) {
         }
     });
 }
+
+TEST(GridFractionalBoundaryConditionSolver3, ColliderSdfStorage) {
+    GridFractionalBoundaryConditionSolver3 bndSolver;
+    Size3 gridSize(20, 20, 20);
+    Vector3D gridSpacing(1.0, 1.0, 1.0);
+    Vector3D gridOrigin(-10.0, -10.0, -10.0);
+
+    // Without a collider, the distance field has no active tile.
+    bndSolver.updateCollider(nullptr, gridSize, gridSpacing, gridOrigin);
+
+    auto sparseSdf = std::dynamic_pointer_cast<SparseCellCenteredScalarGrid3>(
+        bndSolver.colliderSdf());
+    ASSERT_NE(nullptr, sparseSdf);
+    EXPECT_EQ(gridSize, sparseSdf->resolution());
+    EXPECT_EQ(0u, sparseSdf->data().numberOfActiveTiles());
+    EXPECT_EQ(kMaxD, sparseSdf->sample(Vector3D(1.0, -2.5, 3.0)));
+
+    // With a collider, the distance field is dense.
+    auto plane = std::make_shared<Plane3>(Vector3D(0, 1, 0), Vector3D());
+    auto collider = std::make_shared<RigidBodyCollider3>(plane);
+    bndSolver.updateCollider(collider, gridSize, gridSpacing, gridOrigin);
+
+    auto sdf = std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
+        bndSolver.colliderSdf());
+    ASSERT_NE(nullptr, sdf);
+    EXPECT_EQ(gridSize, sdf->resolution());
+
+    auto pos = sdf->dataPosition();
+    sdf->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(pos(i, j, k).y, (*sdf)(i, j, k));
+    });
+    EXPECT_NEAR(-2.5, sdf->sample(Vector3D(1.0, -2.5, 3.0)), 1e-12);
+
+    FaceCenteredGrid3 velocity(gridSize, gridSpacing, gridOrigin);
+    velocity.fill(Vector3D(1.0, -1.0, 1.0));
+
+    bndSolver.constrainVelocity(&velocity);
+
+    // The flow into the collider is removed inside the collider.
+    velocity.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        if (j < 8) {
+            EXPECT_NEAR(0.0, velocity.v(i, j, k), 1e-12);
+        }
+    });
+
+    // Removing the collider drops the dense distance field.
+    bndSolver.updateCollider(nullptr, gridSize, gridSpacing, gridOrigin);
+    EXPECT_EQ(nullptr, std::dynamic_pointer_cast<CellCenteredScalarGrid3>(
+                           bndSolver.colliderSdf()));
+}
@@ -7,7 +7,9 @@
 #include <jet/cell_centered_scalar_grid2.h>
 #include <jet/cell_centered_vector_grid2.h>
 #include <jet/face_centered_grid2.h>
+#include <jet/fdm_cg_solver2.h>
 #include <jet/fdm_mg_solver2.h>
+#include <jet/fdm_mgpcg_solver2.h>
 #include <jet/grid_fractional_single_phase_pressure_solver2.h>
 
 #include <gtest/gtest.h>
@@ -157,3 +159,66 @@ TEST(GridFractionalSinglePhasePressureSolver2, SolveFreeSurfaceMg) {
         }
     }
 }
+
+TEST(GridFractionalSinglePhasePressureSolver2, SinglePrecision) {
+    const Size2 res(24, 20);
+    FaceCenteredGrid2 vel(res, Vector2D(1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j) {
+        vel.v(i, j) = (j == 0 || j == res.y) ? 0.0 : std::sin(0.3 * i);
+    });
+    CellCenteredScalarGrid2 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector2D& x) { return x.y - 0.5; });
+
+    GridFractionalSinglePhasePressureSolver2 solver;
+    solver.setLinearSystemSolver(std::make_shared<FdmCgSolver2>(200, 1e-5));
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid2 expected(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &expected, ConstantScalarField2(kMaxD),
+                 ConstantVectorField2({0, 0}), fluidSdf);
+
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid2 actual(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &actual, ConstantScalarField2(kMaxD),
+                 ConstantVectorField2({0, 0}), fluidSdf);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(res, solver.pressure().size());
+
+    expected.forEachVIndex([&](size_t i, size_t j) {
+        EXPECT_NEAR(expected.v(i, j), actual.v(i, j), 1e-4);
+    });
+}
+
+TEST(GridFractionalSinglePhasePressureSolver2, SinglePrecisionMultigrid) {
+    const Size2 res(24, 20);
+    FaceCenteredGrid2 vel(res, Vector2D(1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j) {
+        vel.v(i, j) = (j == 0 || j == res.y) ? 0.0 : std::sin(0.3 * i);
+    });
+    CellCenteredScalarGrid2 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector2D& x) { return x.y - 0.5; });
+
+    GridFractionalSinglePhasePressureSolver2 solver;
+    solver.setLinearSystemSolver(
+        std::make_shared<FdmMgpcgSolver2>(100, 3, 5, 5, 10, 10, 1e-5));
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid2 expected(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &expected, ConstantScalarField2(kMaxD),
+                 ConstantVectorField2({0, 0}), fluidSdf);
+
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid2 actual(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &actual, ConstantScalarField2(kMaxD),
+                 ConstantVectorField2({0, 0}), fluidSdf);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(res, solver.pressure().size());
+
+    expected.forEachVIndex([&](size_t i, size_t j) {
+        EXPECT_NEAR(expected.v(i, j), actual.v(i, j), 1e-4);
+    });
+}
@@ -6,6 +6,7 @@
 
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/fdm_cg_solver3.h>
 #include <jet/fdm_iccg_solver3.h>
 #include <jet/fdm_mgpcg_solver3.h>
 #include <jet/grid_fractional_single_phase_pressure_solver3.h>
@@ -131,3 +132,174 @@ TEST(GridFractionalSinglePhasePressureSolver3, SolveFreeSurfaceCompressed) {
         }
     }
 }
+
+TEST(GridFractionalSinglePhasePressureSolver3, SolveFreeSurfaceStencil) {
+    FaceCenteredGrid3 vel(3, 3, 3);
+    CellCenteredScalarGrid3 fluidSdf(3, 3, 3);
+
+    vel.fill(Vector3D());
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (j == 0 || j == 3) {
+                    vel.v(i, j, k) = 0.0;
+                } else {
+                    vel.v(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 2.0; });
+
+    GridFractionalSinglePhasePressureSolver3 solver;
+    EXPECT_FALSE(solver.isUsingStencilSystem());
+    solver.setIsUsingStencilSystem(true);
+    EXPECT_TRUE(solver.isUsingStencilSystem());
+    solver.solve(vel, 1.0, &vel, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf, true);
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 4; ++i) {
+                EXPECT_NEAR(0.0, vel.u(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.v(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.w(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    const auto& pressure = solver.pressure();
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 2; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                double p = static_cast<double>(1.5 - j);
+                EXPECT_NEAR(p, pressure(i, j, k), 1e-6);
+            }
+        }
+    }
+}
+
+TEST(GridFractionalSinglePhasePressureSolver3, WarmStart) {
+    const Size3 res(24, 20, 16);
+    FaceCenteredGrid3 vel(res, Vector3D(1, 1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        vel.v(i, j, k) = (j == 0 || j == res.y)
+                             ? 0.0
+                             : std::sin(0.3 * i) * std::cos(0.2 * k);
+    });
+    CellCenteredScalarGrid3 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.47; });
+
+    for (int useMg = 0; useMg < 2; ++useMg) {
+        GridFractionalSinglePhasePressureSolver3 solver;
+        if (useMg) {
+            solver.setLinearSystemSolver(std::make_shared<FdmMgpcgSolver3>(
+                200, 4, 5, 5, 20, 20, 1e-9));
+        } else {
+            solver.setLinearSystemSolver(
+                std::make_shared<FdmIccgSolver3>(200, 1e-9));
+        }
+        solver.setIsWarmStarting(true);
+
+        FaceCenteredGrid3 cold, warm;
+        cold.resize(res, vel.gridSpacing());
+        warm.resize(res, vel.gridSpacing());
+
+        solver.solve(vel, 1.0, &cold, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf);
+        const unsigned int coldIterations = solver.lastNumberOfIterations();
+        EXPECT_LT(0u, coldIterations);
+
+        solver.solve(vel, 1.0, &warm, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf);
+        EXPECT_GT(coldIterations, solver.lastNumberOfIterations());
+        EXPECT_LT(0, solver.lastNumberOfSavedIterations());
+
+        cold.forEachVIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(cold.v(i, j, k), warm.v(i, j, k), 1e-6);
+        });
+    }
+}
+
+TEST(GridFractionalSinglePhasePressureSolver3, SinglePrecision) {
+    const Size3 res(24, 20, 16);
+    FaceCenteredGrid3 vel(res, Vector3D(1, 1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        vel.v(i, j, k) = (j == 0 || j == res.y)
+                             ? 0.0
+                             : std::sin(0.3 * i) * std::cos(0.2 * k);
+    });
+    CellCenteredScalarGrid3 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.5; });
+
+    GridFractionalSinglePhasePressureSolver3 solver;
+    solver.setLinearSystemSolver(std::make_shared<FdmCgSolver3>(200, 1e-5));
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid3 expected(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &expected, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid3 actual(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &actual, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(res, solver.pressure().size());
+
+    expected.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected.v(i, j, k), actual.v(i, j, k), 1e-4);
+    });
+}
+
+TEST(GridFractionalSinglePhasePressureSolver3, SinglePrecisionMultigrid) {
+    const Size3 res(24, 20, 16);
+    FaceCenteredGrid3 vel(res, Vector3D(1, 1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        vel.v(i, j, k) = (j == 0 || j == res.y)
+                             ? 0.0
+                             : std::sin(0.3 * i) * std::cos(0.2 * k);
+    });
+    CellCenteredScalarGrid3 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.5; });
+
+    GridFractionalSinglePhasePressureSolver3 solver;
+    solver.setLinearSystemSolver(
+        std::make_shared<FdmMgpcgSolver3>(100, 3, 5, 5, 10, 10, 1e-5));
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid3 expected(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &expected, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid3 actual(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &actual, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(res, solver.pressure().size());
+
+    expected.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected.v(i, j, k), actual.v(i, j, k), 1e-4);
+    });
+}
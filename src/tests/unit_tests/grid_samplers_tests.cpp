@@ -0,0 +1,112 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid2.h>
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/grid_samplers2.h>
+#include <jet/grid_samplers3.h>
+#include <jet/vertex_centered_vector_grid2.h>
+#include <jet/vertex_centered_vector_grid3.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace jet;
+
+TEST(LinearFaceCenteredArraySampler2, Sample) {
+    FaceCenteredGrid2 grid({5, 4}, {0.5, 0.25}, {-1.0, 2.0});
+    grid.fill([](const Vector2D& x) {
+        return Vector2D(std::sin(x.x + 2.0 * x.y), std::cos(3.0 * x.x - x.y));
+    });
+
+    LinearArraySampler2<double, double> uSampler(
+        grid.uConstAccessor(), grid.gridSpacing(), grid.uOrigin());
+    LinearArraySampler2<double, double> vSampler(
+        grid.vConstAccessor(), grid.gridSpacing(), grid.vOrigin());
+    LinearGridSampler2<FaceCenteredGrid2> sampler(grid);
+
+    // Includes the points outside the grid to test the clamping.
+    for (int j = -3; j < 25; ++j) {
+        for (int i = -3; i < 32; ++i) {
+            Vector2D pt(-1.3 + 0.11 * i, 1.9 + 0.047 * j);
+            Vector2D result = sampler(pt);
+            EXPECT_EQ(uSampler(pt), result.x);
+            EXPECT_EQ(vSampler(pt), result.y);
+            EXPECT_EQ(grid.sample(pt), result);
+        }
+    }
+}
+
+TEST(LinearFaceCenteredArraySampler3, Sample) {
+    FaceCenteredGrid3 grid({5, 4, 3}, {0.5, 0.25, 0.75}, {-1.0, 2.0, 0.5});
+    grid.fill([](const Vector3D& x) {
+        return Vector3D(std::sin(x.x + 2.0 * x.y), std::cos(3.0 * x.x - x.z),
+                        x.x * x.y - x.z);
+    });
+
+    LinearArraySampler3<double, double> uSampler(
+        grid.uConstAccessor(), grid.gridSpacing(), grid.uOrigin());
+    LinearArraySampler3<double, double> vSampler(
+        grid.vConstAccessor(), grid.gridSpacing(), grid.vOrigin());
+    LinearArraySampler3<double, double> wSampler(
+        grid.wConstAccessor(), grid.gridSpacing(), grid.wOrigin());
+    LinearGridSampler3<FaceCenteredGrid3> sampler(grid);
+
+    // Includes the points outside the grid to test the clamping.
+    for (int k = -2; k < 14; ++k) {
+        for (int j = -3; j < 25; ++j) {
+            for (int i = -3; i < 32; ++i) {
+                Vector3D pt(-1.3 + 0.11 * i, 1.9 + 0.047 * j, 0.3 + 0.19 * k);
+                Vector3D result = sampler(pt);
+                EXPECT_EQ(uSampler(pt), result.x);
+                EXPECT_EQ(vSampler(pt), result.y);
+                EXPECT_EQ(wSampler(pt), result.z);
+                EXPECT_EQ(grid.sample(pt), result);
+            }
+        }
+    }
+}
+
+TEST(LinearGridSampler2, Sample) {
+    CellCenteredScalarGrid2 scalarGrid({6, 5}, {0.5, 0.5}, {1.0, -1.0});
+    scalarGrid.fill([](const Vector2D& x) { return x.x * x.x - x.y; });
+    VertexCenteredVectorGrid2 vectorGrid({4, 7}, {0.3, 0.2}, {0.0, 0.5});
+    vectorGrid.fill([](const Vector2D& x) { return Vector2D(x.y, -x.x); });
+
+    LinearGridSampler2<ScalarGrid2> scalarSampler(scalarGrid);
+    LinearGridSampler2<CollocatedVectorGrid2> vectorSampler(vectorGrid);
+
+    for (int j = -2; j < 20; ++j) {
+        for (int i = -2; i < 20; ++i) {
+            Vector2D pt(0.7 + 0.19 * i, -1.2 + 0.23 * j);
+            EXPECT_EQ(scalarGrid.sample(pt), scalarSampler(pt));
+            EXPECT_EQ(vectorGrid.sample(pt), vectorSampler(pt));
+        }
+    }
+}
+
+TEST(LinearGridSampler3, Sample) {
+    CellCenteredScalarGrid3 scalarGrid({6, 5, 4}, {0.5, 0.5, 0.25},
+                                       {1.0, -1.0, 0.0});
+    scalarGrid.fill([](const Vector3D& x) { return x.x * x.x - x.y * x.z; });
+    VertexCenteredVectorGrid3 vectorGrid({4, 7, 3}, {0.3, 0.2, 0.4},
+                                         {0.0, 0.5, -0.5});
+    vectorGrid.fill(
+        [](const Vector3D& x) { return Vector3D(x.y, -x.x, x.z * x.x); });
+
+    LinearGridSampler3<ScalarGrid3> scalarSampler(scalarGrid);
+    LinearGridSampler3<CollocatedVectorGrid3> vectorSampler(vectorGrid);
+
+    for (int k = -2; k < 10; ++k) {
+        for (int j = -2; j < 20; ++j) {
+            for (int i = -2; i < 20; ++i) {
+                Vector3D pt(0.7 + 0.19 * i, -1.2 + 0.23 * j, -0.6 + 0.17 * k);
+                EXPECT_EQ(scalarGrid.sample(pt), scalarSampler(pt));
+                EXPECT_EQ(vectorGrid.sample(pt), vectorSampler(pt));
+            }
+        }
+    }
+}
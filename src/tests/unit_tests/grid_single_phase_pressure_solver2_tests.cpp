@@ -6,7 +6,10 @@
 
 #include <jet/cell_centered_scalar_grid2.h>
 #include <jet/face_centered_grid2.h>
+#include <jet/fdm_cg_solver2.h>
+#include <jet/fdm_iccg_solver2.h>
 #include <jet/fdm_mg_solver2.h>
+#include <jet/fdm_mgpcg_solver2.h>
 #include <jet/grid_single_phase_pressure_solver2.h>
 
 #include <gtest/gtest.h>
@@ -337,3 +340,160 @@ TEST(GridSinglePhasePressureSolver2, SolveSinglePhaseWithMg) {
         }
     }
 }
+
+TEST(GridSinglePhasePressureSolver2, WarmStart) {
+    const Size2 res(64, 48);
+    FaceCenteredGrid2 vel(res, Vector2D(1, 1) / 64.0);
+    vel.forEachVIndex([&](size_t i, size_t j) {
+        vel.v(i, j) = (j == 0 || j == res.y) ? 0.0 : std::sin(0.3 * i);
+    });
+    CellCenteredScalarGrid2 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector2D& x) { return x.y - 0.5; });
+
+    for (int solverType = 0; solverType < 3; ++solverType) {
+        GridSinglePhasePressureSolver2 solver;
+        if (solverType == 2) {
+            solver.setLinearSystemSolver(std::make_shared<FdmMgpcgSolver2>(
+                200, 4, 5, 5, 20, 20, 1e-9));
+        } else {
+            solver.setLinearSystemSolver(
+                std::make_shared<FdmIccgSolver2>(200, 1e-9));
+        }
+        const bool useCompressed = solverType == 1;
+        EXPECT_FALSE(solver.isWarmStarting());
+        solver.setIsWarmStarting(true);
+
+        FaceCenteredGrid2 cold, warm;
+        cold.resize(res, vel.gridSpacing());
+        warm.resize(res, vel.gridSpacing());
+
+        solver.solve(vel, 1.0, &cold, ConstantScalarField2(kMaxD),
+                     ConstantVectorField2({0, 0}), fluidSdf, useCompressed);
+        const unsigned int coldIterations = solver.lastNumberOfIterations();
+        EXPECT_LT(0u, coldIterations);
+        EXPECT_EQ(0, solver.lastNumberOfSavedIterations());
+
+        // The last pressure is the solution, and the reused matrix gives the
+        // same result.
+        solver.solve(vel, 1.0, &warm, ConstantScalarField2(kMaxD),
+                     ConstantVectorField2({0, 0}), fluidSdf, useCompressed);
+        EXPECT_GT(coldIterations, solver.lastNumberOfIterations());
+        EXPECT_LT(0, solver.lastNumberOfSavedIterations());
+
+        cold.forEachVIndex([&](size_t i, size_t j) {
+            EXPECT_NEAR(cold.v(i, j), warm.v(i, j), 1e-6);
+        });
+    }
+}
+
+TEST(GridSinglePhasePressureSolver2, UpdateChangedMarkerBlocks) {
+    const Size2 res(37, 29);
+    const Vector2D h = Vector2D(1, 1) / 37.0;
+    FaceCenteredGrid2 vel(res, h);
+    vel.forEachVIndex([&](size_t i, size_t j) {
+        vel.v(i, j) = (j == 0 || j == res.y) ? 0.0 : std::sin(0.3 * i);
+    });
+    CellCenteredScalarGrid2 fluidSdf(res, h);
+    fluidSdf.fill([&](const Vector2D& x) { return x.y - 0.6; });
+
+    // The obstacle moves by about one cell, so only a few blocks change.
+    CellCenteredScalarGrid2 boundarySdf0(res, h);
+    CellCenteredScalarGrid2 boundarySdf1(res, h);
+    boundarySdf0.fill([&](const Vector2D& x) {
+        return x.distanceTo(Vector2D(0.3, 0.3)) - 0.1;
+    });
+    boundarySdf1.fill([&](const Vector2D& x) {
+        return x.distanceTo(Vector2D(0.33, 0.3)) - 0.1;
+    });
+
+    const FdmLinearSystemSolver2Ptr systemSolvers[] = {
+        std::make_shared<FdmCgSolver2>(200, 1e-9),
+        std::make_shared<FdmMgpcgSolver2>(100, 3, 5, 5, 10, 10, 1e-9)};
+
+    for (const auto& systemSolver : systemSolvers) {
+        GridSinglePhasePressureSolver2 solver;
+        solver.setLinearSystemSolver(systemSolver);
+
+        FaceCenteredGrid2 actual(res, h);
+        solver.solve(vel, 1.0, &actual, boundarySdf0,
+                     ConstantVectorField2({0, 0}), fluidSdf);
+        solver.solve(vel, 1.0, &actual, boundarySdf1,
+                     ConstantVectorField2({0, 0}), fluidSdf);
+
+        GridSinglePhasePressureSolver2 freshSolver;
+        freshSolver.setLinearSystemSolver(systemSolver);
+
+        FaceCenteredGrid2 expected(res, h);
+        freshSolver.solve(vel, 1.0, &expected, boundarySdf1,
+                          ConstantVectorField2({0, 0}), fluidSdf);
+
+        const auto& p = solver.pressure();
+        const auto& q = freshSolver.pressure();
+        p.forEachIndex([&](size_t i, size_t j) {
+            EXPECT_NEAR(q(i, j), p(i, j), 1e-9);
+        });
+    }
+}
+
+TEST(GridSinglePhasePressureSolver2, SinglePrecision) {
+    const Size2 res(24, 20);
+    FaceCenteredGrid2 vel(res, Vector2D(1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j) {
+        vel.v(i, j) = (j == 0 || j == res.y) ? 0.0 : std::sin(0.3 * i);
+    });
+    CellCenteredScalarGrid2 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector2D& x) { return x.y - 0.5; });
+
+    GridSinglePhasePressureSolver2 solver;
+    solver.setLinearSystemSolver(std::make_shared<FdmCgSolver2>(200, 1e-5));
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid2 expected(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &expected, ConstantScalarField2(kMaxD),
+                 ConstantVectorField2({0, 0}), fluidSdf);
+
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid2 actual(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &actual, ConstantScalarField2(kMaxD),
+                 ConstantVectorField2({0, 0}), fluidSdf);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(res, solver.pressure().size());
+
+    expected.forEachVIndex([&](size_t i, size_t j) {
+        EXPECT_NEAR(expected.v(i, j), actual.v(i, j), 1e-4);
+    });
+}
+
+TEST(GridSinglePhasePressureSolver2, SinglePrecisionMultigrid) {
+    const Size2 res(24, 20);
+    FaceCenteredGrid2 vel(res, Vector2D(1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j) {
+        vel.v(i, j) = (j == 0 || j == res.y) ? 0.0 : std::sin(0.3 * i);
+    });
+    CellCenteredScalarGrid2 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector2D& x) { return x.y - 0.5; });
+
+    GridSinglePhasePressureSolver2 solver;
+    solver.setLinearSystemSolver(
+        std::make_shared<FdmMgpcgSolver2>(100, 3, 5, 5, 10, 10, 1e-5));
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid2 expected(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &expected, ConstantScalarField2(kMaxD),
+                 ConstantVectorField2({0, 0}), fluidSdf);
+
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid2 actual(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &actual, ConstantScalarField2(kMaxD),
+                 ConstantVectorField2({0, 0}), fluidSdf);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(res, solver.pressure().size());
+
+    expected.forEachVIndex([&](size_t i, size_t j) {
+        EXPECT_NEAR(expected.v(i, j), actual.v(i, j), 1e-4);
+    });
+}
@@ -7,6 +7,9 @@
 #include <gtest/gtest.h>
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/face_centered_grid3.h>
+#include <jet/fdm_cg_solver3.h>
+#include <jet/fdm_iccg_solver3.h>
+#include <jet/fdm_mgpcg_solver3.h>
 #include <jet/grid_single_phase_pressure_solver3.h>
 
 using namespace jet;
@@ -247,6 +250,68 @@ TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceCompressed) {
     }
 }
 
+TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceStencil) {
+    FaceCenteredGrid3 vel(3, 3, 3);
+    CellCenteredScalarGrid3 fluidSdf(3, 3, 3);
+
+    vel.fill(Vector3D());
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                if (j == 0 || j == 3) {
+                    vel.v(i, j, k) = 0.0;
+                } else {
+                    vel.v(i, j, k) = 1.0;
+                }
+            }
+        }
+    }
+
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 2.0; });
+
+    GridSinglePhasePressureSolver3 solver;
+    EXPECT_FALSE(solver.isUsingStencilSystem());
+    solver.setIsUsingStencilSystem(true);
+    EXPECT_TRUE(solver.isUsingStencilSystem());
+    solver.solve(vel, 1.0, &vel, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf, true);
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 4; ++i) {
+                EXPECT_NEAR(0.0, vel.u(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 4; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.v(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    for (size_t k = 0; k < 4; ++k) {
+        for (size_t j = 0; j < 3; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                EXPECT_NEAR(0.0, vel.w(i, j, k), 1e-6);
+            }
+        }
+    }
+
+    const auto& pressure = solver.pressure();
+    for (size_t k = 0; k < 3; ++k) {
+        for (size_t j = 0; j < 2; ++j) {
+            for (size_t i = 0; i < 3; ++i) {
+                double p = static_cast<double>(2 - j);
+                EXPECT_NEAR(p, pressure(i, j, k), 1e-6);
+            }
+        }
+    }
+}
+
 TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundary) {
     FaceCenteredGrid3 vel(3, 3, 3);
     CellCenteredScalarGrid3 fluidSdf(3, 3, 3);
@@ -312,3 +377,207 @@ TEST(GridSinglePhasePressureSolver3, SolveFreeSurfaceWithBoundary) {
         }
     }
 }
+
+TEST(GridSinglePhasePressureSolver3, WarmStart) {
+    const Size3 res(24, 20, 16);
+    FaceCenteredGrid3 vel(res, Vector3D(1, 1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        vel.v(i, j, k) = (j == 0 || j == res.y)
+                             ? 0.0
+                             : std::sin(0.3 * i) * std::cos(0.2 * k);
+    });
+    CellCenteredScalarGrid3 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.5; });
+
+    for (int useMg = 0; useMg < 2; ++useMg) {
+        GridSinglePhasePressureSolver3 solver;
+        if (useMg) {
+            solver.setLinearSystemSolver(std::make_shared<FdmMgpcgSolver3>(
+                200, 4, 5, 5, 20, 20, 1e-9));
+        } else {
+            solver.setLinearSystemSolver(
+                std::make_shared<FdmIccgSolver3>(200, 1e-9));
+        }
+        EXPECT_FALSE(solver.isWarmStarting());
+        solver.setIsWarmStarting(true);
+
+        FaceCenteredGrid3 cold, warm;
+        cold.resize(res, vel.gridSpacing());
+        warm.resize(res, vel.gridSpacing());
+
+        solver.solve(vel, 1.0, &cold, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf);
+        const unsigned int coldIterations = solver.lastNumberOfIterations();
+        EXPECT_LT(0u, coldIterations);
+        EXPECT_EQ(0, solver.lastNumberOfSavedIterations());
+
+        // The last pressure is the solution, and the reused matrix gives the
+        // same result.
+        solver.solve(vel, 1.0, &warm, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf);
+        EXPECT_GT(coldIterations, solver.lastNumberOfIterations());
+        EXPECT_LT(0, solver.lastNumberOfSavedIterations());
+        EXPECT_EQ(static_cast<int>(coldIterations),
+                  static_cast<int>(solver.lastNumberOfIterations()) +
+                      solver.lastNumberOfSavedIterations());
+
+        cold.forEachVIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(cold.v(i, j, k), warm.v(i, j, k), 1e-6);
+        });
+    }
+}
+
+TEST(GridSinglePhasePressureSolver3, WarmStartCompressed) {
+    const Size3 res(24, 20, 16);
+    FaceCenteredGrid3 vel(res, Vector3D(1, 1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        vel.v(i, j, k) = (j == 0 || j == res.y)
+                             ? 0.0
+                             : std::sin(0.3 * i) * std::cos(0.2 * k);
+    });
+    CellCenteredScalarGrid3 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.5; });
+
+    for (int useStencil = 0; useStencil < 2; ++useStencil) {
+        GridSinglePhasePressureSolver3 solver;
+        solver.setLinearSystemSolver(
+            std::make_shared<FdmIccgSolver3>(200, 1e-9));
+        solver.setIsUsingStencilSystem(useStencil == 1);
+        solver.setIsWarmStarting(true);
+
+        FaceCenteredGrid3 cold, warm;
+        cold.resize(res, vel.gridSpacing());
+        warm.resize(res, vel.gridSpacing());
+
+        solver.solve(vel, 1.0, &cold, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf, true);
+        const unsigned int coldIterations = solver.lastNumberOfIterations();
+
+        solver.solve(vel, 1.0, &warm, ConstantScalarField3(kMaxD),
+                     ConstantVectorField3({0, 0, 0}), fluidSdf, true);
+        EXPECT_GT(coldIterations, solver.lastNumberOfIterations());
+        EXPECT_LT(0, solver.lastNumberOfSavedIterations());
+
+        cold.forEachVIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(cold.v(i, j, k), warm.v(i, j, k), 1e-6);
+        });
+    }
+}
+
+TEST(GridSinglePhasePressureSolver3, UpdateChangedMarkerBlocks) {
+    const Size3 res(37, 20, 29);
+    const Vector3D h = Vector3D(1, 1, 1) / 37.0;
+    FaceCenteredGrid3 vel(res, h);
+    vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        vel.v(i, j, k) = (j == 0 || j == res.y)
+                             ? 0.0
+                             : std::sin(0.3 * i) * std::cos(0.2 * k);
+    });
+    CellCenteredScalarGrid3 fluidSdf(res, h);
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.4; });
+
+    // The obstacle moves by about one cell, so only a few blocks change.
+    CellCenteredScalarGrid3 boundarySdf0(res, h);
+    CellCenteredScalarGrid3 boundarySdf1(res, h);
+    boundarySdf0.fill([&](const Vector3D& x) {
+        return x.distanceTo(Vector3D(0.3, 0.25, 0.3)) - 0.1;
+    });
+    boundarySdf1.fill([&](const Vector3D& x) {
+        return x.distanceTo(Vector3D(0.33, 0.25, 0.3)) - 0.1;
+    });
+
+    const FdmLinearSystemSolver3Ptr systemSolvers[] = {
+        std::make_shared<FdmCgSolver3>(200, 1e-9),
+        std::make_shared<FdmMgpcgSolver3>(100, 3, 5, 5, 10, 10, 1e-9)};
+
+    for (const auto& systemSolver : systemSolvers) {
+        GridSinglePhasePressureSolver3 solver;
+        solver.setLinearSystemSolver(systemSolver);
+
+        FaceCenteredGrid3 actual(res, h);
+        solver.solve(vel, 1.0, &actual, boundarySdf0,
+                     ConstantVectorField3({0, 0, 0}), fluidSdf);
+        solver.solve(vel, 1.0, &actual, boundarySdf1,
+                     ConstantVectorField3({0, 0, 0}), fluidSdf);
+
+        GridSinglePhasePressureSolver3 freshSolver;
+        freshSolver.setLinearSystemSolver(systemSolver);
+
+        FaceCenteredGrid3 expected(res, h);
+        freshSolver.solve(vel, 1.0, &expected, boundarySdf1,
+                          ConstantVectorField3({0, 0, 0}), fluidSdf);
+
+        const auto& p = solver.pressure();
+        const auto& q = freshSolver.pressure();
+        p.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_NEAR(q(i, j, k), p(i, j, k), 1e-9);
+        });
+    }
+}
+
+TEST(GridSinglePhasePressureSolver3, SinglePrecision) {
+    const Size3 res(24, 20, 16);
+    FaceCenteredGrid3 vel(res, Vector3D(1, 1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        vel.v(i, j, k) = (j == 0 || j == res.y)
+                             ? 0.0
+                             : std::sin(0.3 * i) * std::cos(0.2 * k);
+    });
+    CellCenteredScalarGrid3 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.5; });
+
+    GridSinglePhasePressureSolver3 solver;
+    solver.setLinearSystemSolver(std::make_shared<FdmCgSolver3>(200, 1e-5));
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid3 expected(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &expected, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid3 actual(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &actual, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(res, solver.pressure().size());
+
+    expected.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected.v(i, j, k), actual.v(i, j, k), 1e-4);
+    });
+}
+
+TEST(GridSinglePhasePressureSolver3, SinglePrecisionMultigrid) {
+    const Size3 res(24, 20, 16);
+    FaceCenteredGrid3 vel(res, Vector3D(1, 1, 1) / 24.0);
+    vel.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        vel.v(i, j, k) = (j == 0 || j == res.y)
+                             ? 0.0
+                             : std::sin(0.3 * i) * std::cos(0.2 * k);
+    });
+    CellCenteredScalarGrid3 fluidSdf(res, vel.gridSpacing());
+    fluidSdf.fill([&](const Vector3D& x) { return x.y - 0.5; });
+
+    GridSinglePhasePressureSolver3 solver;
+    solver.setLinearSystemSolver(
+        std::make_shared<FdmMgpcgSolver3>(100, 3, 5, 5, 10, 10, 1e-5));
+    EXPECT_FALSE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid3 expected(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &expected, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+
+    solver.setIsUsingSinglePrecision(true);
+    EXPECT_TRUE(solver.isUsingSinglePrecision());
+
+    FaceCenteredGrid3 actual(res, vel.gridSpacing());
+    solver.solve(vel, 1.0, &actual, ConstantScalarField3(kMaxD),
+                 ConstantVectorField3({0, 0, 0}), fluidSdf);
+    EXPECT_LT(0u, solver.lastNumberOfIterations());
+    EXPECT_EQ(res, solver.pressure().size());
+
+    expected.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected.v(i, j, k), actual.v(i, j, k), 1e-4);
+    });
+}
@@ -6,6 +6,8 @@
 
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/cell_centered_vector_grid3.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
+#include <jet/sparse_vertex_centered_scalar_grid3.h>
 #include <jet/vertex_centered_scalar_grid3.h>
 #include <jet/vertex_centered_vector_grid3.h>
 
@@ -192,3 +194,112 @@ TEST(GridSystemData3, Serialize) {
         EXPECT_EQ(velocity->w(i, j, k), velocity2->w(i, j, k));
     });
 }
+
+TEST(GridSystemData3, SparseScalarData) {
+    GridSystemData3 grids({40, 30, 20}, {0.5, 0.5, 0.5}, {-1.0, 2.0, 3.0});
+
+    size_t sparseIdx0 = grids.addSparseScalarData(
+        std::make_shared<SparseCellCenteredScalarGrid3::Builder>());
+    size_t sparseIdx1 = grids.addAdvectableSparseScalarData(
+        std::make_shared<SparseVertexCenteredScalarGrid3::Builder>(), 5.0);
+
+    EXPECT_EQ(0u, grids.numberOfScalarData());
+    EXPECT_EQ(0u, grids.numberOfAdvectableScalarData());
+    EXPECT_EQ(1u, grids.numberOfSparseScalarData());
+    EXPECT_EQ(1u, grids.numberOfAdvectableSparseScalarData());
+
+    auto sparse0 = grids.sparseScalarDataAt(sparseIdx0);
+    auto sparse1 = grids.advectableSparseScalarDataAt(sparseIdx1);
+    EXPECT_TRUE(
+        std::dynamic_pointer_cast<SparseCellCenteredScalarGrid3>(sparse0)
+        != nullptr);
+    EXPECT_TRUE(
+        std::dynamic_pointer_cast<SparseVertexCenteredScalarGrid3>(sparse1)
+        != nullptr);
+    EXPECT_EQ(Size3(40, 30, 20), sparse0->resolution());
+    EXPECT_EQ(Size3(41, 31, 21), sparse1->dataSize());
+    EXPECT_EQ(0.0, sparse0->data().background());
+    EXPECT_EQ(5.0, sparse1->data().background());
+    EXPECT_EQ(0u, sparse1->data().numberOfActiveTiles());
+
+    sparse0->data().set(3, 4, 5, 1.0);
+    sparse1->data().set(40, 30, 20, -2.0);
+
+    GridSystemData3 grids2(grids);
+    auto sparse0_2 = grids2.sparseScalarDataAt(sparseIdx0);
+    EXPECT_TRUE(sparse0 != sparse0_2);
+    EXPECT_EQ(1.0, (*sparse0_2)(3, 4, 5));
+    EXPECT_EQ(-2.0, (*grids2.advectableSparseScalarDataAt(sparseIdx1))(
+        40, 30, 20));
+
+    // Resizing keeps the background value and deactivates the tiles.
+    grids.resize({20, 20, 20}, {1.0, 1.0, 1.0}, {0.0, 0.0, 0.0});
+    EXPECT_EQ(Size3(20, 20, 20), sparse0->resolution());
+    EXPECT_EQ(Size3(21, 21, 21), sparse1->dataSize());
+    EXPECT_EQ(5.0, sparse1->data().background());
+    EXPECT_EQ(0u, sparse1->data().numberOfActiveTiles());
+    EXPECT_EQ(5.0, (*sparse1)(20, 20, 20));
+}
+
+TEST(GridSystemData3, SerializeSparseScalarData) {
+    std::vector<uint8_t> buffer;
+
+    GridSystemData3 grids({40, 30, 20}, {0.5, 0.5, 0.5}, {-1.0, 2.0, 3.0});
+    size_t scalarIdx = grids.addScalarData(
+        std::make_shared<CellCenteredScalarGrid3::Builder>(), 1.0);
+    size_t sparseIdx0 = grids.addSparseScalarData(
+        std::make_shared<SparseCellCenteredScalarGrid3::Builder>());
+    size_t sparseIdx1 = grids.addAdvectableSparseScalarData(
+        std::make_shared<SparseVertexCenteredScalarGrid3::Builder>(), 5.0);
+
+    auto sparse0 = grids.sparseScalarDataAt(sparseIdx0);
+    auto sparse1 = grids.advectableSparseScalarDataAt(sparseIdx1);
+    sparse0->fill([](const Vector3D& pt) {
+        return (pt.x < 2.0) ? pt.length() : 0.0;
+    });
+    sparse1->fill([](const Vector3D& pt) {
+        return (pt.z > 10.0) ? pt.y : 5.0;
+    });
+    EXPECT_LT(0u, sparse0->data().numberOfActiveTiles());
+    EXPECT_LT(0u, sparse1->data().numberOfActiveTiles());
+
+    grids.serialize(&buffer);
+
+    GridSystemData3 grids2;
+    grids2.deserialize(buffer);
+
+    EXPECT_EQ(1u, grids2.numberOfScalarData());
+    EXPECT_EQ(1.0, (*grids2.scalarDataAt(scalarIdx))(0, 0, 0));
+    EXPECT_EQ(1u, grids2.numberOfSparseScalarData());
+    EXPECT_EQ(1u, grids2.numberOfAdvectableSparseScalarData());
+
+    auto sparse0_2 = grids2.sparseScalarDataAt(sparseIdx0);
+    auto sparse1_2 = grids2.advectableSparseScalarDataAt(sparseIdx1);
+    EXPECT_TRUE(
+        std::dynamic_pointer_cast<SparseCellCenteredScalarGrid3>(sparse0_2)
+        != nullptr);
+    EXPECT_TRUE(
+        std::dynamic_pointer_cast<SparseVertexCenteredScalarGrid3>(sparse1_2)
+        != nullptr);
+
+    for (const auto& pair : {std::make_pair(sparse0, sparse0_2),
+                             std::make_pair(sparse1, sparse1_2)}) {
+        const auto& a = pair.first;
+        const auto& b = pair.second;
+        EXPECT_EQ(a->resolution(), b->resolution());
+        EXPECT_EQ(a->gridSpacing(), b->gridSpacing());
+        EXPECT_EQ(a->origin(), b->origin());
+        EXPECT_EQ(a->data().background(), b->data().background());
+        EXPECT_EQ(a->data().numberOfActiveTiles(),
+                  b->data().numberOfActiveTiles());
+
+        const Size3 ds = a->dataSize();
+        for (size_t k = 0; k < ds.z; ++k) {
+            for (size_t j = 0; j < ds.y; ++j) {
+                for (size_t i = 0; i < ds.x; ++i) {
+                    EXPECT_EQ((*a)(i, j, k), (*b)(i, j, k));
+                }
+            }
+        }
+    }
+}
@@ -69,3 +69,44 @@ TEST(LevelSetLiquidSolver3, ComputeVolume) {
 
     EXPECT_NEAR(ans, volume, 0.001);
 }
+
+TEST(LevelSetLiquidSolver3, NarrowBand) {
+    const double dx = 1.0 / 32.0;
+    const double radius = 0.15;
+
+    LevelSetLiquidSolver3 full;
+    LevelSetLiquidSolver3 band;
+    band.setNarrowBandWidth(4.0);
+    EXPECT_DOUBLE_EQ(4.0, band.narrowBandWidth());
+
+    for (LevelSetLiquidSolver3* solver : {&full, &band}) {
+        auto data = solver->gridSystemData();
+        data->resize(Size3(32, 32, 32), Vector3D(dx, dx, dx), Vector3D());
+
+        const Vector3D center = data->boundingBox().midPoint();
+        solver->signedDistanceField()->fill([&](const Vector3D& x) {
+            return x.distanceTo(center) - radius;
+        });
+    }
+
+    Frame frame(0, 1.0 / 60.0);
+    for (; frame.index < 5; frame.advance()) {
+        full.update(frame);
+        band.update(frame);
+    }
+
+    auto sdf0 = full.signedDistanceField();
+    auto sdf1 = band.signedDistanceField();
+    const double bandWidth = 4.0 * dx;
+
+    sdf0->forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const double phi = (*sdf1)(i, j, k);
+        EXPECT_LE(std::fabs(phi), bandWidth + kEpsilonD);
+        if (std::fabs((*sdf0)(i, j, k)) < 2.0 * dx) {
+            EXPECT_NEAR((*sdf0)(i, j, k), phi, 0.5 * dx)
+                << i << ", " << j << ", " << k;
+        }
+    });
+
+    EXPECT_NEAR(full.computeVolume(), band.computeVolume(), 1e-3);
+}
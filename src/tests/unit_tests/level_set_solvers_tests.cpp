@@ -9,6 +9,8 @@
 #include <jet/cell_centered_scalar_grid3.h>
 #include <jet/eno_level_set_solver2.h>
 #include <jet/eno_level_set_solver3.h>
+#include <jet/fast_sweeping_level_set_solver2.h>
+#include <jet/fast_sweeping_level_set_solver3.h>
 #include <jet/fdm_utils.h>
 #include <jet/fmm_level_set_solver2.h>
 #include <jet/fmm_level_set_solver3.h>
@@ -74,6 +76,35 @@ TEST(UpwindLevelSetSolver3, Reinitialize) {
     }
 }
 
+TEST(UpwindLevelSetSolver3, ReinitializeNarrowBand) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+
+    // Distorted input with twice the slope of the distance.
+    sdf.fill([](const Vector3D& x) {
+        return 2.0 * ((x - Vector3D(20, 20, 20)).length() - 8.0);
+    });
+
+    UpwindLevelSetSolver3 solver;
+    solver.reinitializeNarrowBand(sdf, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                const double input = sdf(i, j, k);
+                const double output = temp(i, j, k);
+                EXPECT_LE(std::fabs(output), 5.0);
+                if (std::fabs(input) <= 4.0) {
+                    EXPECT_NEAR(0.5 * input, output, 0.7)
+                        << i << ", " << j << ", " << k;
+                } else if (std::fabs(input) > 5.0) {
+                    EXPECT_DOUBLE_EQ(input > 0.0 ? 5.0 : -5.0, output)
+                        << i << ", " << j << ", " << k;
+                }
+            }
+        }
+    }
+}
+
 TEST(UpwindLevelSetSolver3, Extrapolate) {
     CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
     CellCenteredScalarGrid3 field(40, 30, 50);
@@ -232,6 +263,36 @@ TEST(FmmLevelSetSolver3, Reinitialize) {
     }
 }
 
+TEST(FmmLevelSetSolver3, ReinitializeNarrowBand) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+    CellCenteredScalarGrid3 full(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+
+    FmmLevelSetSolver3 solver;
+    solver.reinitialize(sdf, 5.0, &full);
+    solver.reinitializeNarrowBand(sdf, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                const double input = sdf(i, j, k);
+                const double output = temp(i, j, k);
+                EXPECT_LE(std::fabs(output), 5.0);
+                if (std::fabs(input) <= 4.0) {
+                    EXPECT_NEAR(full(i, j, k), output, 1e-9)
+                        << i << ", " << j << ", " << k;
+                } else if (std::fabs(input) > 5.0) {
+                    EXPECT_DOUBLE_EQ(input > 0.0 ? 5.0 : -5.0, output)
+                        << i << ", " << j << ", " << k;
+                }
+            }
+        }
+    }
+}
+
 TEST(FmmLevelSetSolver3, Extrapolate) {
     CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
     CellCenteredScalarGrid3 field(40, 30, 50);
@@ -253,3 +314,104 @@ TEST(FmmLevelSetSolver3, Extrapolate) {
         }
     }
 }
+
+TEST(FastSweepingLevelSetSolver2, Reinitialize) {
+    CellCenteredScalarGrid2 sdf(40, 30), temp(40, 30);
+
+    // Distorted input with twice the slope of the distance.
+    sdf.fill([](const Vector2D& x) {
+        return 2.0 * ((x - Vector2D(20, 20)).length() - 8.0);
+    });
+
+    FastSweepingLevelSetSolver2 solver;
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    for (size_t j = 0; j < 30; ++j) {
+        for (size_t i = 0; i < 40; ++i) {
+            const double answer = 0.5 * sdf(i, j);
+            if (std::fabs(answer) < 4.0) {
+                EXPECT_NEAR(answer, temp(i, j), 0.4);
+            } else if (std::fabs(answer) > 6.0) {
+                EXPECT_DOUBLE_EQ(sdf(i, j), temp(i, j));
+            }
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver2, Extrapolate) {
+    CellCenteredScalarGrid2 sdf(40, 30), temp(40, 30);
+    CellCenteredScalarGrid2 field(40, 30);
+
+    sdf.fill([](const Vector2D& x) {
+        return (x - Vector2D(20, 20)).length() - 8.0;
+    });
+    field.fill(5.0);
+
+    FastSweepingLevelSetSolver2 solver;
+    solver.extrapolate(field, sdf, 5.0, &temp);
+
+    for (size_t j = 0; j < 30; ++j) {
+        for (size_t i = 0; i < 40; ++i) {
+            EXPECT_DOUBLE_EQ(5.0, temp(i, j));
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver3, Reinitialize) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+
+    // Distorted input with twice the slope of the distance.
+    sdf.fill([](const Vector3D& x) {
+        return 2.0 * ((x - Vector3D(20, 20, 20)).length() - 8.0);
+    });
+
+    FastSweepingLevelSetSolver3 solver;
+    solver.reinitialize(sdf, 5.0, &temp);
+
+    for (size_t k = 0; k < 50; ++k) {
+        for (size_t j = 0; j < 30; ++j) {
+            for (size_t i = 0; i < 40; ++i) {
+                const double answer = 0.5 * sdf(i, j, k);
+                if (std::fabs(answer) < 4.0) {
+                    EXPECT_NEAR(answer, temp(i, j, k), 0.4)
+                        << i << ", " << j << ", " << k;
+                } else if (std::fabs(answer) > 6.0) {
+                    EXPECT_DOUBLE_EQ(sdf(i, j, k), temp(i, j, k))
+                        << i << ", " << j << ", " << k;
+                }
+            }
+        }
+    }
+}
+
+TEST(FastSweepingLevelSetSolver3, Extrapolate) {
+    CellCenteredScalarGrid3 sdf(40, 30, 50), temp(40, 30, 50);
+    CellCenteredScalarGrid3 field(40, 30, 50);
+
+    sdf.fill([](const Vector3D& x) {
+        return (x - Vector3D(20, 20, 20)).length() - 8.0;
+    });
+
+    // Constant along the radial direction, so the extrapolation should keep
+    // the value outside.
+    field.fill([](const Vector3D& x) {
+        const Vector3D r = x - Vector3D(20, 20, 20);
+        return (r.length() < 8.0) ? r.normalized().z : -10.0;
+    });
+
+    FastSweepingLevelSetSolver3 solver;
+    solver.extrapolate(field, sdf, 5.0, &temp);
+
+    temp.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D r = temp.dataPosition()(i, j, k) - Vector3D(20, 20, 20);
+        const double phi = sdf(i, j, k);
+        if (phi < 0.0) {
+            EXPECT_DOUBLE_EQ(field(i, j, k), temp(i, j, k));
+        } else if (phi < 4.0) {
+            EXPECT_NEAR(r.normalized().z, temp(i, j, k), 0.2)
+                << i << ", " << j << ", " << k;
+        } else if (phi > 5.0) {
+            EXPECT_DOUBLE_EQ(-10.0, temp(i, j, k));
+        }
+    });
+}
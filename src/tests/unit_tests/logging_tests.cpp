@@ -0,0 +1,96 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <unit_tests_utils.h>
+
+#include <jet/logging.h>
+#include <jet/parallel.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+using namespace jet;
+
+namespace {
+
+int countLines(const std::string& str, const std::string& pattern) {
+    int count = 0;
+    std::istringstream strm(str);
+    std::string line;
+    while (std::getline(strm, line)) {
+        if (line.find(pattern) != std::string::npos) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+int sideEffect(int* counter) { return ++(*counter); }
+
+// Redirects all the logs to the given stream, and sends them back to the
+// stream of main when it goes out of scope.
+class ScopedLogStream {
+ public:
+    explicit ScopedLogStream(std::ostream* strm) {
+        Logging::setAllStream(strm);
+    }
+
+    ~ScopedLogStream() { Logging::setAllStream(getUnitTestsLogStream()); }
+};
+
+}  // namespace
+
+TEST(Logging, SkipsDisabledLevels) {
+    std::stringstream strm;
+    ScopedLogStream scopedStream(&strm);
+    Logging::setLevel(LoggingLevel::Warn);
+
+    int counter = 0;
+    JET_INFO << "info " << sideEffect(&counter);
+    JET_DEBUG << "debug " << sideEffect(&counter);
+    EXPECT_EQ(0, counter);
+    EXPECT_TRUE(strm.str().empty());
+
+    JET_WARN << "warn " << sideEffect(&counter);
+    EXPECT_EQ(1, counter);
+    EXPECT_EQ(1, countLines(strm.str(), "warn 1"));
+
+    EXPECT_FALSE(Logging::isEnabled(LoggingLevel::Info));
+    EXPECT_TRUE(Logging::isEnabled(LoggingLevel::Error));
+
+    Logging::unmute();
+}
+
+TEST(Logging, MacroInIfElse) {
+    std::stringstream strm;
+    ScopedLogStream scopedStream(&strm);
+
+    bool flag = false;
+    if (flag)
+        JET_INFO << "then";
+    else
+        JET_INFO << "else";
+
+    EXPECT_EQ(0, countLines(strm.str(), "then"));
+    EXPECT_EQ(1, countLines(strm.str(), "else"));
+}
+
+TEST(Logging, AsyncSink) {
+    std::stringstream strm;
+    ScopedLogStream scopedStream(&strm);
+    Logging::setAsync(true);
+    EXPECT_TRUE(Logging::isAsync());
+
+    // More messages than a thread buffer holds
+    const size_t n = 3000;
+    parallelFor(kZeroSize, n, [](size_t i) {
+        JET_INFO << "async message " << i;
+    });
+
+    Logging::setAsync(false);
+    EXPECT_FALSE(Logging::isAsync());
+    EXPECT_EQ(static_cast<int>(n), countLines(strm.str(), "async message"));
+}
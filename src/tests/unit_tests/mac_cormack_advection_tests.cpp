@@ -0,0 +1,132 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid2.h>
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/constant_vector_field2.h>
+#include <jet/constant_vector_field3.h>
+#include <jet/mac_cormack_advection2.h>
+#include <jet/mac_cormack_advection3.h>
+#include <jet/semi_lagrangian2.h>
+#include <jet/vertex_centered_vector_grid3.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace jet;
+
+namespace {
+
+double bump(const Vector2D& pt) {
+    const double r = pt.distanceTo(Vector2D(0.3, 0.5));
+    return (r < 0.2) ? std::cos(kPiD * r / 0.4) : 0.0;
+}
+
+}  // namespace
+
+TEST(MacCormackAdvection2, TranslatesMoreAccurately) {
+    CellCenteredScalarGrid2 input(64, 64, 1.0 / 64.0, 1.0 / 64.0);
+    input.fill(bump);
+    ConstantVectorField2 flow(Vector2D(1.0, 0.0));
+
+    const double dt = 0.0123;
+    const int numberOfSteps = 20;
+
+    auto advectAll = [&](AdvectionSolver2* solver) {
+        CellCenteredScalarGrid2 a(input), b(input);
+        for (int i = 0; i < numberOfSteps; ++i) {
+            solver->advect(a, flow, dt, &b);
+            a.swap(&b);
+        }
+        return a;
+    };
+
+    SemiLagrangian2 semiLagrangian;
+    MacCormackAdvection2 macCormack;
+    const CellCenteredScalarGrid2 slResult = advectAll(&semiLagrangian);
+    const CellCenteredScalarGrid2 mcResult = advectAll(&macCormack);
+
+    const Vector2D shift(dt * numberOfSteps, 0.0);
+    double slError = 0.0;
+    double mcError = 0.0;
+    double mcMin = kMaxD;
+    double mcMax = -kMaxD;
+    auto pos = input.dataPosition();
+    input.forEachDataPointIndex([&](size_t i, size_t j) {
+        const double expected = bump(pos(i, j) - shift);
+        slError += square(slResult(i, j) - expected);
+        mcError += square(mcResult(i, j) - expected);
+        mcMin = std::min(mcMin, mcResult(i, j));
+        mcMax = std::max(mcMax, mcResult(i, j));
+    });
+
+    EXPECT_LT(mcError, 0.5 * slError);
+
+    // The limiter does not create new extrema.
+    EXPECT_LE(0.0, mcMin);
+    EXPECT_GE(1.0, mcMax);
+}
+
+TEST(MacCormackAdvection3, PreservesConstantFields) {
+    CellCenteredScalarGrid3 scalar(16, 12, 10, 0.1, 0.1, 0.1, 0.0, 0.0, 0.0,
+                                   3.0);
+    CellCenteredScalarGrid3 scalarOut(16, 12, 10, 0.1, 0.1, 0.1);
+    VertexCenteredVectorGrid3 vector(16, 12, 10, 0.1, 0.1, 0.1, 0.0, 0.0,
+                                     0.0, 1.0, -2.0, 0.5);
+    VertexCenteredVectorGrid3 vectorOut(16, 12, 10, 0.1, 0.1, 0.1);
+    FaceCenteredGrid3 face(16, 12, 10, 0.1, 0.1, 0.1, 0.0, 0.0, 0.0, 0.3,
+                           0.2, -0.1);
+    FaceCenteredGrid3 faceOut(16, 12, 10, 0.1, 0.1, 0.1);
+
+    MacCormackAdvection3 solver;
+    solver.advect(scalar, face, 0.5, &scalarOut);
+    solver.advect(vector, face, 0.5, &vectorOut);
+    solver.advect(face, face, 0.5, &faceOut);
+
+    scalarOut.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(3.0, scalarOut(i, j, k), 1e-12);
+    });
+    vectorOut.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(1.0, vectorOut(i, j, k).x, 1e-12);
+        EXPECT_NEAR(-2.0, vectorOut(i, j, k).y, 1e-12);
+        EXPECT_NEAR(0.5, vectorOut(i, j, k).z, 1e-12);
+    });
+    faceOut.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(0.3, faceOut.u(i, j, k), 1e-12);
+    });
+    faceOut.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(0.2, faceOut.v(i, j, k), 1e-12);
+    });
+    faceOut.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(-0.1, faceOut.w(i, j, k), 1e-12);
+    });
+}
+
+TEST(MacCormackAdvection3, Boundary) {
+    CellCenteredScalarGrid3 input(20, 20, 20, 0.05, 0.05, 0.05);
+    input.fill([](const Vector3D& pt) { return pt.x; });
+    CellCenteredScalarGrid3 output(20, 20, 20, 0.05, 0.05, 0.05, 0.0, 0.0,
+                                   0.0, -1.0);
+    ConstantVectorField3 flow(Vector3D(1.0, 0.0, 0.0));
+    CellCenteredScalarGrid3 boundarySdf(20, 20, 20, 0.05, 0.05, 0.05);
+    boundarySdf.fill([](const Vector3D& pt) { return pt.y - 0.5; });
+
+    MacCormackAdvection3 solver;
+    solver.advect(input, flow, 0.1, &output, boundarySdf);
+
+    // The points inside the boundary are untouched, and the linear field is
+    // translated exactly away from the domain boundary.
+    auto pos = output.dataPosition();
+    output.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        const Vector3D pt = pos(i, j, k);
+        if (pt.y < 0.5) {
+            EXPECT_EQ(-1.0, output(i, j, k));
+        } else if (pt.x > 0.2 && pt.x < 0.8) {
+            EXPECT_NEAR(pt.x - 0.1, output(i, j, k), 1e-9);
+        }
+    });
+}
@@ -4,18 +4,32 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <unit_tests_utils.h>
+
 #include <jet/jet.h>
 #include <gtest/gtest.h>
 #include <fstream>
+#include <iostream>
 
 using namespace jet;
 
+namespace {
+
+std::ostream* sLogStream = &std::cout;
+
+}  // namespace
+
+std::ostream* getUnitTestsLogStream() {
+    return sLogStream;
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
 
     std::ofstream logFile("unit_tests.log");
     if (logFile) {
         Logging::setAllStream(&logFile);
+        sLogStream = &logFile;
     }
 
     int ret = RUN_ALL_TESTS();
@@ -0,0 +1,74 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/neighbor_lists.h>
+#include <jet/parallel.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+using namespace jet;
+
+TEST(NeighborLists, Constructors) {
+    NeighborLists lists;
+    EXPECT_EQ(0u, lists.size());
+    EXPECT_TRUE(lists.empty());
+    EXPECT_EQ(0u, lists.numberOfNeighbors());
+}
+
+TEST(NeighborLists, Build) {
+    // Point i is a neighbor of point j if |i - j| is 1 or 2.
+    const size_t n = 100;
+    const auto forEachPair = [&](const std::function<void(size_t, size_t)>& visit) {
+        parallelFor(kZeroSize, n, [&](size_t i) {
+            for (size_t j = (i < 2 ? 0 : i - 2); j < std::min(n, i + 3); ++j) {
+                if (i != j) {
+                    visit(i, j);
+                }
+            }
+        });
+    };
+
+    NeighborLists lists;
+    lists.build(n, forEachPair);
+
+    EXPECT_EQ(n, lists.size());
+    EXPECT_EQ(4 * n - 6, lists.numberOfNeighbors());
+    EXPECT_EQ(n + 1, lists.offsets().size());
+    EXPECT_EQ(0u, lists.offsets().front());
+    EXPECT_EQ(lists.numberOfNeighbors(), lists.offsets().back());
+
+    EXPECT_EQ(2u, lists.numberOfNeighbors(0));
+    EXPECT_EQ(3u, lists.numberOfNeighbors(1));
+    EXPECT_EQ(4u, lists.numberOfNeighbors(50));
+
+    const auto neighbors = lists[50];
+    ASSERT_EQ(4u, neighbors.size());
+    EXPECT_EQ(48u, neighbors[0]);
+    EXPECT_EQ(49u, neighbors[1]);
+    EXPECT_EQ(51u, neighbors[2]);
+    EXPECT_EQ(52u, neighbors[3]);
+
+    lists.clear();
+    EXPECT_TRUE(lists.empty());
+}
+
+TEST(NeighborLists, Set) {
+    NeighborLists lists;
+    lists.set({0, 2, 2, 3}, {1, 2, 0});
+
+    EXPECT_EQ(3u, lists.size());
+    EXPECT_EQ(2u, lists.numberOfNeighbors(0));
+    EXPECT_EQ(0u, lists.numberOfNeighbors(1));
+    EXPECT_EQ(1u, lists.numberOfNeighbors(2));
+    EXPECT_EQ(0u, lists[2][0]);
+
+    EXPECT_THROW(lists.set({1, 2}, {0}), std::invalid_argument);
+    EXPECT_THROW(lists.set({0, 2}, {0}), std::invalid_argument);
+}
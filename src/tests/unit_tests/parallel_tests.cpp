@@ -9,6 +9,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <numeric>
 #include <random>
 
@@ -16,6 +17,27 @@ using namespace jet;
 
 static unsigned int sNumCores = std::thread::hardware_concurrency();
 
+namespace {
+
+size_t sumOfIndices(size_t start, size_t end, size_t init) {
+    size_t result = init;
+    for (size_t i = start; i < end; ++i) {
+        result += i;
+    }
+    return result;
+}
+
+// Checks the sums of the indices of the empty, small and large ranges.
+template <typename ReduceFunc>
+void checkSumsOfIndices(const ReduceFunc& reduce, unsigned int numThreads) {
+    for (size_t n : {0, 1, 5, 1000}) {
+        const size_t expected = (n > 0) ? n * (n - 1) / 2 : 0;
+        EXPECT_EQ(expected, reduce(n)) << numThreads;
+    }
+}
+
+}  // namespace
+
 TEST(Parallel, Fill) {
     size_t N = std::max(20u, (3 * sNumCores) / 2);
     std::vector<double> a(N);
@@ -215,3 +237,104 @@ TEST(Parallel, Reduce) {
     int expected = std::accumulate(a.begin(), a.end(), 0);
     EXPECT_EQ(expected, sum);
 }
+
+TEST(Parallel, NestedFor) {
+    unsigned int oldNumThreads = maxNumberOfThreads();
+    setMaxNumberOfThreads(4);
+
+    const size_t N = 64;
+    Array2<int> a(N, N, 0);
+
+    parallelFor(kZeroSize, N, [&](size_t j) {
+        parallelFor(kZeroSize, N, [&](size_t i) {
+            a(i, j) += static_cast<int>(i + j);
+        });
+    });
+
+    a.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_EQ(static_cast<int>(i + j), a(i, j));
+    });
+
+    setMaxNumberOfThreads(oldNumThreads);
+}
+
+TEST(Parallel, SortWithThreads) {
+    unsigned int oldNumThreads = maxNumberOfThreads();
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<> d(0.0, 1.0);
+
+    for (unsigned int numThreads : {1u, 2u, 3u, 8u}) {
+        setMaxNumberOfThreads(numThreads);
+
+        std::vector<double> a(10000);
+        for (double& val : a) {
+            val = d(rng);
+        }
+
+        parallelSort(a.begin(), a.end());
+
+        EXPECT_TRUE(std::is_sorted(a.begin(), a.end())) << numThreads;
+    }
+
+    setMaxNumberOfThreads(oldNumThreads);
+}
+
+TEST(Parallel, ReduceWithThreads) {
+    unsigned int oldNumThreads = maxNumberOfThreads();
+
+    for (unsigned int numThreads : {1u, 2u, 8u}) {
+        setMaxNumberOfThreads(numThreads);
+
+        checkSumsOfIndices(
+            [](size_t n) {
+                return parallelReduce(kZeroSize, n, kZeroSize, sumOfIndices,
+                                      std::plus<size_t>());
+            },
+            numThreads);
+    }
+
+    setMaxNumberOfThreads(oldNumThreads);
+}
+
+TEST(Parallel, DeterministicReduce) {
+    unsigned int oldNumThreads = maxNumberOfThreads();
+
+    // Floating-point sums depend on the order of the additions
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> d(-1e6, 1e6);
+    std::vector<double> values(100000);
+    for (double& value : values) {
+        value = d(rng) * d(rng);
+    }
+
+    auto sumFunc = [&](size_t start, size_t end, double init) {
+        double result = init;
+        for (size_t i = start; i < end; ++i) {
+            result += values[i];
+        }
+        return result;
+    };
+
+    const double serialSum = parallelDeterministicReduce(
+        kZeroSize, values.size(), 0.0, sumFunc, std::plus<double>(),
+        ExecutionPolicy::kSerial);
+
+    for (unsigned int numThreads : {1u, 2u, 3u, 8u}) {
+        setMaxNumberOfThreads(numThreads);
+
+        const double sum = parallelDeterministicReduce(
+            kZeroSize, values.size(), 0.0, sumFunc, std::plus<double>());
+        EXPECT_EQ(serialSum, sum) << numThreads;
+
+        checkSumsOfIndices(
+            [](size_t n) {
+                return parallelDeterministicReduce(kZeroSize, n, kZeroSize,
+                                                   sumOfIndices,
+                                                   std::plus<size_t>());
+            },
+            numThreads);
+    }
+
+    setMaxNumberOfThreads(oldNumThreads);
+}
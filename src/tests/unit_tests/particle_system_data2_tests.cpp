@@ -5,9 +5,12 @@
 // property of any third parties.
 
 #include <jet/particle_system_data2.h>
+#include <jet/point_parallel_hash_grid_searcher2.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 using namespace jet;
@@ -204,6 +207,60 @@ TEST(ParticleSystemData2, BuildNeighborLists) {
     }
 }
 
+TEST(ParticleSystemData2, SortParticles) {
+    ParticleSystemData2 particleSystem;
+    ParticleSystemData2::VectorData positions = {
+        {0.7, 0.2}, {0.7, 0.8}, {0.9, 0.4}, {0.5, 0.1},
+        {0.6, 0.3}, {0.1, 0.6}, {0.5, 1.0}, {0.6, 0.7}};
+    particleSystem.addParticles(positions);
+    particleSystem.setRadius(0.1);
+
+    const size_t a0 = particleSystem.addScalarData();
+    auto scalars = particleSystem.scalarDataAt(a0);
+    auto velocities = particleSystem.velocities();
+    for (size_t i = 0; i < positions.size(); ++i) {
+        scalars[i] = static_cast<double>(i);
+        velocities[i] = 2.0 * positions[i];
+    }
+
+    particleSystem.buildNeighborSearcher(0.1);
+    particleSystem.buildNeighborLists(0.1);
+    particleSystem.sortParticles();
+
+    const auto& order = particleSystem.lastParticleOrder();
+    ASSERT_EQ(positions.size(), order.size());
+    EXPECT_EQ(0u, particleSystem.neighborLists().size());
+
+    std::vector<size_t> sortedOrder(order);
+    std::sort(sortedOrder.begin(), sortedOrder.end());
+    for (size_t i = 0; i < sortedOrder.size(); ++i) {
+        EXPECT_EQ(i, sortedOrder[i]);
+    }
+
+    const auto& searcher = std::dynamic_pointer_cast<
+        PointParallelHashGridSearcher2>(particleSystem.neighborSearcher());
+    ASSERT_NE(nullptr, searcher);
+
+    // Hash key of each particle in the new order should be non-decreasing.
+    std::vector<size_t> keys(order.size());
+    for (size_t s = 0; s < order.size(); ++s) {
+        keys[searcher->sortedIndices()[s]] = searcher->keys()[s];
+    }
+
+    scalars = particleSystem.scalarDataAt(a0);
+    velocities = particleSystem.velocities();
+    auto newPositions = particleSystem.positions();
+    for (size_t i = 0; i < order.size(); ++i) {
+        EXPECT_EQ(positions[order[i]], newPositions[i]);
+        EXPECT_EQ(2.0 * positions[order[i]], velocities[i]);
+        EXPECT_DOUBLE_EQ(static_cast<double>(order[i]), scalars[i]);
+
+        if (i > 0) {
+            EXPECT_LE(keys[i - 1], keys[i]);
+        }
+    }
+}
+
 TEST(ParticleSystemData2, Serialization) {
     ParticleSystemData2 particleSystem;
 
@@ -259,3 +316,45 @@ TEST(ParticleSystemData2, Serialization) {
         }
     }
 }
+
+TEST(ParticleSystemData2, SoaLayout) {
+    ParticleSystemData2 particleSystem;
+    EXPECT_FALSE(particleSystem.isUsingSoaLayout());
+
+    Array1<Vector2D> positions;
+    Array1<Vector2D> velocities;
+    for (size_t i = 0; i < 100; ++i) {
+        const double t = static_cast<double>(i);
+        positions.append(Vector2D(0.01 * t, 0.02 * t));
+        velocities.append(Vector2D(t, -t));
+    }
+    particleSystem.addParticles(positions, velocities);
+
+    particleSystem.setIsUsingSoaLayout(true);
+    EXPECT_TRUE(particleSystem.isUsingSoaLayout());
+
+    const auto& soaPositions = particleSystem.soaPositions();
+    const auto& soaVelocities = particleSystem.soaVelocities();
+    ASSERT_EQ(100u, soaPositions.size());
+    ASSERT_EQ(100u, soaVelocities.size());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(soaPositions.x())
+                  % kSimdAlignment);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(soaVelocities.y())
+                  % kSimdAlignment);
+
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT_EQ(positions[i].x, soaPositions.x()[i]);
+        EXPECT_EQ(velocities[i].x, soaVelocities.x()[i]);
+        EXPECT_EQ(positions[i].y, soaPositions.y()[i]);
+        EXPECT_EQ(velocities[i].y, soaVelocities.y()[i]);
+    }
+
+    // Copies are refreshed by updateSoaLayout
+    particleSystem.positions()[3] = Vector2D(5.0, 6.0);
+    EXPECT_NE(particleSystem.positions()[3], soaPositions[3]);
+    particleSystem.updateSoaLayout();
+    EXPECT_EQ(particleSystem.positions()[3], soaPositions[3]);
+
+    particleSystem.setIsUsingSoaLayout(false);
+    EXPECT_EQ(0u, particleSystem.soaPositions().size());
+}
@@ -0,0 +1,136 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array2.h>
+#include <jet/array_samplers2.h>
+#include <jet/parallel.h>
+#include <jet/particle_to_grid_transfer2.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace jet;
+
+namespace {
+
+void serialScatter(
+    const Array1<Vector2D>& positions,
+    const Array1<double>& values,
+    const Vector2D& gridSpacing,
+    const Vector2D& origin,
+    Array2<double>* grid,
+    Array2<char>* markers) {
+    Array2<double> weightSum(grid->size());
+    grid->set(0.0);
+    markers->set(0);
+
+    LinearArraySampler2<double, double> sampler(
+        grid->constAccessor(), gridSpacing, origin);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        std::array<Point2UI, 4> indices;
+        std::array<double, 4> weights;
+
+        sampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
+        for (int j = 0; j < 4; ++j) {
+            (*grid)(indices[j]) += values[i] * weights[j];
+            weightSum(indices[j]) += weights[j];
+            (*markers)(indices[j]) = 1;
+        }
+    }
+
+    grid->forEachIndex([&](size_t i, size_t j) {
+        if (weightSum(i, j) > 0.0) {
+            (*grid)(i, j) /= weightSum(i, j);
+        }
+    });
+}
+
+}  // namespace
+
+TEST(ParticleToGridTransfer2, Transfer) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> dist(-0.1, 1.1);
+
+    Array1<Vector2D> positions(1000);
+    Array1<double> values(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector2D(dist(rng), dist(rng));
+        values[i] = dist(rng);
+    }
+
+    const Vector2D gridSpacing(0.1, 0.125);
+    const Vector2D origin(0.05, 0.0);
+    Array2<double> expected(10, 8);
+    Array2<char> expectedMarkers(10, 8);
+    serialScatter(
+        positions, values, gridSpacing, origin, &expected, &expectedMarkers);
+
+    ParticleToGridTransfer2 transfer;
+    EXPECT_FALSE(transfer.isDeterministic());
+
+    Array2<double> grid(10, 8, 123.0);
+    Array2<char> markers(10, 8, 2);
+    transfer.transfer(
+        positions.size(),
+        [&](size_t i) { return positions[i]; },
+        [&](size_t i, const Vector2D&, const Point2UI&) { return values[i]; },
+        gridSpacing,
+        origin,
+        grid.accessor(),
+        markers.accessor());
+
+    grid.forEachIndex([&](size_t i, size_t j) {
+        EXPECT_NEAR(expected(i, j), grid(i, j), 1e-12);
+        EXPECT_EQ(expectedMarkers(i, j), markers(i, j));
+    });
+}
+
+TEST(ParticleToGridTransfer2, DeterministicTransfer) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> dist(0.0, 1.0);
+
+    Array1<Vector2D> positions(5000);
+    Array1<double> values(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector2D(dist(rng), dist(rng));
+        values[i] = dist(rng);
+    }
+
+    const Vector2D gridSpacing(0.125, 0.125);
+    const Vector2D origin(0.0, 0.0625);
+    Array2<double> expected(9, 8);
+    Array2<char> expectedMarkers(9, 8);
+    serialScatter(
+        positions, values, gridSpacing, origin, &expected, &expectedMarkers);
+
+    ParticleToGridTransfer2 transfer;
+    transfer.setIsDeterministic(true);
+    EXPECT_TRUE(transfer.isDeterministic());
+
+    const unsigned int numThreads = maxNumberOfThreads();
+    for (unsigned int n : {1u, 2u, 7u}) {
+        setMaxNumberOfThreads(n);
+
+        Array2<double> grid(9, 8);
+        Array2<char> markers(9, 8);
+        transfer.transfer(
+            positions.size(),
+            [&](size_t i) { return positions[i]; },
+            [&](size_t i, const Vector2D&, const Point2UI&) {
+                return values[i];
+            },
+            gridSpacing,
+            origin,
+            grid.accessor(),
+            markers.accessor());
+
+        grid.forEachIndex([&](size_t i, size_t j) {
+            EXPECT_EQ(expected(i, j), grid(i, j));
+            EXPECT_EQ(expectedMarkers(i, j), markers(i, j));
+        });
+    }
+    setMaxNumberOfThreads(numThreads);
+}
@@ -0,0 +1,136 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array3.h>
+#include <jet/array_samplers3.h>
+#include <jet/parallel.h>
+#include <jet/particle_to_grid_transfer3.h>
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace jet;
+
+namespace {
+
+void serialScatter(
+    const Array1<Vector3D>& positions,
+    const Array1<double>& values,
+    const Vector3D& gridSpacing,
+    const Vector3D& origin,
+    Array3<double>* grid,
+    Array3<char>* markers) {
+    Array3<double> weightSum(grid->size());
+    grid->set(0.0);
+    markers->set(0);
+
+    LinearArraySampler3<double, double> sampler(
+        grid->constAccessor(), gridSpacing, origin);
+    for (size_t i = 0; i < positions.size(); ++i) {
+        std::array<Point3UI, 8> indices;
+        std::array<double, 8> weights;
+
+        sampler.getCoordinatesAndWeights(positions[i], &indices, &weights);
+        for (int j = 0; j < 8; ++j) {
+            (*grid)(indices[j]) += values[i] * weights[j];
+            weightSum(indices[j]) += weights[j];
+            (*markers)(indices[j]) = 1;
+        }
+    }
+
+    grid->forEachIndex([&](size_t i, size_t j, size_t k) {
+        if (weightSum(i, j, k) > 0.0) {
+            (*grid)(i, j, k) /= weightSum(i, j, k);
+        }
+    });
+}
+
+}  // namespace
+
+TEST(ParticleToGridTransfer3, Transfer) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> dist(-0.1, 1.1);
+
+    Array1<Vector3D> positions(1000);
+    Array1<double> values(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+        values[i] = dist(rng);
+    }
+
+    const Vector3D gridSpacing(0.1, 0.125, 0.2);
+    const Vector3D origin(0.05, 0.0, 0.1);
+    Array3<double> expected(10, 8, 5);
+    Array3<char> expectedMarkers(10, 8, 5);
+    serialScatter(
+        positions, values, gridSpacing, origin, &expected, &expectedMarkers);
+
+    ParticleToGridTransfer3 transfer;
+    EXPECT_FALSE(transfer.isDeterministic());
+
+    Array3<double> grid(10, 8, 5, 123.0);
+    Array3<char> markers(10, 8, 5, 2);
+    transfer.transfer(
+        positions.size(),
+        [&](size_t i) { return positions[i]; },
+        [&](size_t i, const Vector3D&, const Point3UI&) { return values[i]; },
+        gridSpacing,
+        origin,
+        grid.accessor(),
+        markers.accessor());
+
+    grid.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(expected(i, j, k), grid(i, j, k), 1e-12);
+        EXPECT_EQ(expectedMarkers(i, j, k), markers(i, j, k));
+    });
+}
+
+TEST(ParticleToGridTransfer3, DeterministicTransfer) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> dist(0.0, 1.0);
+
+    Array1<Vector3D> positions(5000);
+    Array1<double> values(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        positions[i] = Vector3D(dist(rng), dist(rng), dist(rng));
+        values[i] = dist(rng);
+    }
+
+    const Vector3D gridSpacing(0.125, 0.125, 0.125);
+    const Vector3D origin(0.0, 0.0625, 0.0625);
+    Array3<double> expected(9, 8, 8);
+    Array3<char> expectedMarkers(9, 8, 8);
+    serialScatter(
+        positions, values, gridSpacing, origin, &expected, &expectedMarkers);
+
+    ParticleToGridTransfer3 transfer;
+    transfer.setIsDeterministic(true);
+    EXPECT_TRUE(transfer.isDeterministic());
+
+    const unsigned int numThreads = maxNumberOfThreads();
+    for (unsigned int n : {1u, 2u, 7u}) {
+        setMaxNumberOfThreads(n);
+
+        Array3<double> grid(9, 8, 8);
+        Array3<char> markers(9, 8, 8);
+        transfer.transfer(
+            positions.size(),
+            [&](size_t i) { return positions[i]; },
+            [&](size_t i, const Vector3D&, const Point3UI&) {
+                return values[i];
+            },
+            gridSpacing,
+            origin,
+            grid.accessor(),
+            markers.accessor());
+
+        grid.forEachIndex([&](size_t i, size_t j, size_t k) {
+            EXPECT_EQ(expected(i, j, k), grid(i, j, k));
+            EXPECT_EQ(expectedMarkers(i, j, k), markers(i, j, k));
+        });
+    }
+    setMaxNumberOfThreads(numThreads);
+}
@@ -4,6 +4,7 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/bcc_lattice_point_generator.h>
 #include <jet/pci_sph_solver3.h>
 #include <gtest/gtest.h>
 
@@ -29,3 +30,31 @@ TEST(PciSphSolver3, Parameters) {
     solver.setMaxNumberOfIterations(10);
     EXPECT_DOUBLE_EQ(10, solver.maxNumberOfIterations());
 }
+
+TEST(PciSphSolver3, SoaLayout) {
+    Array1<Vector3D> points;
+    BccLatticePointGenerator pointsGenerator;
+    BoundingBox3D bbox(Vector3D(0, 0, 0), Vector3D(0.5, 0.5, 0.5));
+    pointsGenerator.generate(bbox, 0.05, &points);
+
+    PciSphSolver3 aosSolver;
+    aosSolver.sphSystemData()->setTargetSpacing(0.05);
+    aosSolver.sphSystemData()->addParticles(points);
+
+    PciSphSolver3 soaSolver;
+    soaSolver.sphSystemData()->setTargetSpacing(0.05);
+    soaSolver.sphSystemData()->addParticles(points);
+    soaSolver.sphSystemData()->setIsUsingSoaLayout(true);
+
+    for (Frame frame(0, 1.0 / 60.0); frame.index < 3; ++frame) {
+        aosSolver.update(frame);
+        soaSolver.update(frame);
+    }
+
+    // Vectorized kernels only change the summation order
+    auto aosPositions = aosSolver.sphSystemData()->positions();
+    auto soaPositions = soaSolver.sphSystemData()->positions();
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_NEAR(0.0, aosPositions[i].distanceTo(soaPositions[i]), 1e-9);
+    }
+}
@@ -11,6 +11,9 @@
 #include <jet/point_parallel_hash_grid_searcher2.h>
 #include <jet/triangle_point_generator.h>
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
 
 using namespace jet;
 
@@ -51,6 +54,38 @@ TEST(PointHashGridSearcher2, ForEachNearbyPointEmpty) {
         });
 }
 
+TEST(PointHashGridSearcher2, ParallelForEachNearbyPoint) {
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<> d(0.0, 4.0);
+    Array1<Vector2D> points(200);
+    for (auto& pt : points) {
+        pt = Vector2D(d(rng), d(rng));
+    }
+
+    const double radius = 0.5;
+    PointHashGridSearcher2 searcher(4, 4, 2.0 * radius);
+    searcher.build(points.accessor());
+
+    std::vector<std::vector<size_t>> neighbors(points.size());
+    searcher.parallelForEachNearbyPoint(
+        radius, [&](size_t i, size_t j, const Vector2D& xj) {
+            EXPECT_EQ(points[j], xj);
+            neighbors[i].push_back(j);
+        });
+
+    for (size_t i = 0; i < points.size(); ++i) {
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < points.size(); ++j) {
+            if (points[i].distanceTo(points[j]) <= radius) {
+                expected.push_back(j);
+            }
+        }
+
+        std::sort(neighbors[i].begin(), neighbors[i].end());
+        EXPECT_EQ(expected, neighbors[i]);
+    }
+}
+
 TEST(PointParallelHashGridSearcher2, Build) {
     Array1<Vector2D> points;
     TrianglePointGenerator pointsGenerator;
@@ -8,6 +8,7 @@
 #include <jet/array3.h>
 #include <jet/bcc_lattice_point_generator.h>
 #include <jet/bounding_box3.h>
+#include <jet/constants.h>
 #include <jet/point_hash_grid_searcher3.h>
 #include <jet/point_parallel_hash_grid_searcher3.h>
 #include <gtest/gtest.h>
@@ -97,6 +98,51 @@ TEST(PointParallelHashGridSearcher3, Build) {
     });
 }
 
+TEST(PointParallelHashGridSearcher3, BuildMatchesBuckets) {
+    Array1<Vector3D> points;
+    BccLatticePointGenerator pointsGenerator;
+    BoundingBox3D bbox(
+        Vector3D(0, 0, 0),
+        Vector3D(1, 1, 1));
+    double spacing = 0.05;
+
+    pointsGenerator.generate(bbox, spacing, &points);
+
+    PointHashGridSearcher3 pointSearcher(8, 8, 8, 0.1);
+    pointSearcher.build(points);
+
+    PointParallelHashGridSearcher3 parallelSearcher(8, 8, 8, 0.1);
+    parallelSearcher.build(points);
+
+    // Both searchers should list the points of each bucket in the input
+    // order, regardless of the thread scheduling.
+    const auto& buckets = pointSearcher.buckets();
+    const auto& startIndexTable = parallelSearcher.startIndexTable();
+    const auto& endIndexTable = parallelSearcher.endIndexTable();
+    const auto& sortedIndices = parallelSearcher.sortedIndices();
+    const auto& keys = parallelSearcher.keys();
+    ASSERT_EQ(buckets.size(), startIndexTable.size());
+
+    for (size_t key = 0; key < buckets.size(); ++key) {
+        const auto& bucket = buckets[key];
+        if (bucket.empty()) {
+            EXPECT_EQ(kMaxSize, startIndexTable[key]);
+            EXPECT_EQ(kMaxSize, endIndexTable[key]);
+            continue;
+        }
+
+        ASSERT_EQ(bucket.size(), endIndexTable[key] - startIndexTable[key]);
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            EXPECT_EQ(bucket[i], sortedIndices[startIndexTable[key] + i]);
+            EXPECT_EQ(key, keys[startIndexTable[key] + i]);
+        }
+
+        for (size_t i = 1; i < bucket.size(); ++i) {
+            EXPECT_LT(bucket[i - 1], bucket[i]);
+        }
+    }
+}
+
 TEST(PointHashGridSearcher3, CopyConstructor) {
     Array1<Vector3D> points = {
         Vector3D(0, 1, 3),
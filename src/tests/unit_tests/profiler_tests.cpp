@@ -0,0 +1,154 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/parallel.h>
+#include <jet/profiler.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace jet;
+
+TEST(Profiler, NestedScopes) {
+    Profiler::clear();
+    Profiler::setEnabled(true);
+    Profiler::setFrameIndex(3);
+    {
+        JET_PROFILE_SCOPE("outer");
+        {
+            JET_PROFILE_SCOPE("inner");
+        }
+    }
+    Profiler::setEnabled(false);
+
+    std::vector<ProfilerEvent> events = Profiler::events();
+    ASSERT_EQ(2u, events.size());
+
+    EXPECT_EQ(std::string("outer"), events[0].name);
+    EXPECT_EQ(0u, events[0].depth);
+    EXPECT_EQ(3, events[0].frameIndex);
+
+    EXPECT_EQ(std::string("inner"), events[1].name);
+    EXPECT_EQ(1u, events[1].depth);
+    EXPECT_EQ(3, events[1].frameIndex);
+
+    EXPECT_LE(events[0].beginTime, events[1].beginTime);
+    EXPECT_LE(events[1].endTime, events[0].endTime);
+
+    Profiler::clear();
+    EXPECT_TRUE(Profiler::events().empty());
+}
+
+TEST(Profiler, Disabled) {
+    Profiler::clear();
+    Profiler::setEnabled(false);
+    {
+        JET_PROFILE_SCOPE("disabled");
+    }
+
+    EXPECT_TRUE(Profiler::events().empty());
+}
+
+TEST(Profiler, MultipleThreads) {
+    Profiler::clear();
+    Profiler::setEnabled(true);
+    parallelFor(kZeroSize, static_cast<size_t>(100), [](size_t) {
+        JET_PROFILE_SCOPE("chunk");
+    });
+    Profiler::setEnabled(false);
+
+    size_t numberOfChunks = 0;
+    for (const ProfilerEvent& event : Profiler::events()) {
+        if (std::string(event.name) == "chunk") {
+            ++numberOfChunks;
+            EXPECT_EQ(0u, event.depth);
+        }
+    }
+    EXPECT_EQ(100u, numberOfChunks);
+
+    Profiler::clear();
+}
+
+TEST(Profiler, WriteChromeTrace) {
+    Profiler::clear();
+    Profiler::setEnabled(true);
+    Profiler::setFrameIndex(7);
+    {
+        JET_PROFILE_SCOPE("zone \"quoted\"");
+    }
+    Profiler::setEnabled(false);
+
+    std::stringstream strm;
+    Profiler::writeChromeTrace(&strm);
+    const std::string json = strm.str();
+
+    EXPECT_EQ(0u, json.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"name\":\"zone \\\"quoted\\\"\""));
+    EXPECT_NE(std::string::npos, json.find("\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, json.find("\"args\":{\"frame\":7}"));
+
+    Profiler::clear();
+}
+
+TEST(Profiler, WriteChromeTraceAfterLongRun) {
+    Profiler::clear();
+
+    // A zone recorded about 1000 seconds after the start
+    const int64_t beginTime = Profiler::now() + 1000000001234;
+    Profiler::record("late", beginTime, beginTime + 1500, 0);
+
+    std::stringstream strm;
+    strm.precision(2);
+    Profiler::writeChromeTrace(&strm);
+    const std::string json = strm.str();
+
+    const size_t tsPos = json.find("\"ts\":");
+    const size_t durPos = json.find("\"dur\":");
+    ASSERT_NE(std::string::npos, tsPos);
+    ASSERT_NE(std::string::npos, durPos);
+
+    // Microseconds with the nanosecond digits
+    const size_t tsEnd = json.find(',', tsPos);
+    const std::string ts = json.substr(tsPos + 5, tsEnd - tsPos - 5);
+    EXPECT_EQ(std::string::npos, ts.find('e'));
+    EXPECT_DOUBLE_EQ(beginTime / 1000.0, std::stod(ts));
+    EXPECT_DOUBLE_EQ(1.5, std::stod(json.substr(durPos + 6)));
+
+    // The stream formatting is restored
+    EXPECT_EQ(2, strm.precision());
+    EXPECT_FALSE(strm.flags() & std::ios_base::fixed);
+
+    Profiler::clear();
+}
+
+TEST(Profiler, WriteFrameSummaryCsv) {
+    Profiler::clear();
+    Profiler::setEnabled(true);
+    for (int frame = 0; frame < 2; ++frame) {
+        Profiler::setFrameIndex(frame);
+        for (int i = 0; i < 3; ++i) {
+            JET_PROFILE_SCOPE("step");
+        }
+    }
+    Profiler::setEnabled(false);
+
+    std::stringstream strm;
+    Profiler::writeFrameSummaryCsv(&strm);
+
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(strm, line)) {
+        lines.push_back(line);
+    }
+
+    ASSERT_EQ(3u, lines.size());
+    EXPECT_EQ("frame,zone,count,total_seconds,max_seconds", lines[0]);
+    EXPECT_EQ(0u, lines[1].find("0,step,3,"));
+    EXPECT_EQ(0u, lines[2].find("1,step,3,"));
+
+    Profiler::clear();
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/reducers.h>
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+using namespace jet;
+
+TEST(Reducers, Max) {
+    std::vector<double> values = {3.0, -7.0, 5.0, 1.0, 5.0};
+    auto func = [&](size_t i) { return values[i]; };
+
+    EXPECT_EQ(5.0, parallelMapReduce(kZeroSize, values.size(), func,
+                                     MaxReducer<double>()));
+    EXPECT_EQ(10.0, parallelMapReduce(kZeroSize, values.size(), func,
+                                      MaxReducer<double>(10.0)));
+    EXPECT_EQ(std::numeric_limits<double>::lowest(),
+              parallelMapReduce(kZeroSize, kZeroSize, func,
+                                MaxReducer<double>()));
+}
+
+TEST(Reducers, Min) {
+    std::vector<double> values = {3.0, -7.0, 5.0, 1.0, 5.0};
+    auto func = [&](size_t i) { return values[i]; };
+
+    EXPECT_EQ(-7.0, parallelMapReduce(kZeroSize, values.size(), func,
+                                      MinReducer<double>()));
+    EXPECT_EQ(-10.0, parallelMapReduce(kZeroSize, values.size(), func,
+                                       MinReducer<double>(-10.0)));
+}
+
+TEST(Reducers, AbsMax) {
+    std::vector<double> values(1000, 0.0);
+    values[10] = 4.0;
+    values[500] = -4.0;
+    values[700] = 2.0;
+    auto func = [&](size_t i) { return values[i]; };
+
+    // Same as the serial loop, which keeps the last of the ties
+    double expected = 0.0;
+    for (double value : values) {
+        expected = absmax(expected, value);
+    }
+
+    const double result = parallelMapReduce(kZeroSize, values.size(), func,
+                                            AbsMaxReducer<double>());
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(-4.0, result);
+}
+
+TEST(Reducers, KahanSum) {
+    // 1 + 1e-16 * n loses all the small values with the naive summation
+    const size_t n = 100000;
+    auto func = [](size_t i) { return (i == 0) ? 1.0 : 1e-16; };
+
+    const KahanSum<double> result = parallelMapReduce(
+        kZeroSize, n, func, KahanSumReducer<double>());
+    EXPECT_NEAR(1.0 + 1e-16 * (n - 1), result.sum, 1e-15);
+
+    double naiveSum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        naiveSum += func(i);
+    }
+    EXPECT_EQ(1.0, naiveSum);
+}
+
+TEST(Reducers, ArgMax) {
+    std::vector<double> values(1000, 0.0);
+    values[300] = 9.0;
+    values[800] = 9.0;
+    auto func = [&](size_t i) { return values[i]; };
+
+    auto result = parallelMapReduce(kZeroSize, values.size(), func,
+                                    ArgMaxReducer<double>());
+    EXPECT_EQ(9.0, result.first);
+    EXPECT_EQ(300u, result.second);
+
+    auto empty = parallelMapReduce(kZeroSize, kZeroSize, func,
+                                   ArgMaxReducer<double>());
+    EXPECT_EQ(kMaxSize, empty.second);
+}
+
+TEST(Reducers, MapReduceWithThreads) {
+    unsigned int oldNumThreads = maxNumberOfThreads();
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<double> d(-1e6, 1e6);
+    std::vector<double> values(100000);
+    for (double& value : values) {
+        value = d(rng) * d(rng);
+    }
+    values[77777] = values[12345] = 1e13;
+    auto func = [&](size_t i) { return values[i]; };
+
+    const KahanSum<double> serialSum =
+        parallelMapReduce(kZeroSize, values.size(), func,
+                          KahanSumReducer<double>(), ExecutionPolicy::kSerial);
+    const auto serialArgMax =
+        parallelMapReduce(kZeroSize, values.size(), func,
+                          ArgMaxReducer<double>(), ExecutionPolicy::kSerial);
+    EXPECT_EQ(12345u, serialArgMax.second);
+
+    // Bitwise the same results regardless of the number of threads
+    for (unsigned int numThreads : {1u, 2u, 3u, 8u}) {
+        setMaxNumberOfThreads(numThreads);
+
+        const KahanSum<double> sum = parallelMapReduce(
+            kZeroSize, values.size(), func, KahanSumReducer<double>());
+        EXPECT_EQ(serialSum.sum, sum.sum) << numThreads;
+        EXPECT_EQ(serialSum.compensation, sum.compensation) << numThreads;
+
+        const auto argMax = parallelMapReduce(kZeroSize, values.size(), func,
+                                              ArgMaxReducer<double>());
+        EXPECT_EQ(serialArgMax, argMax) << numThreads;
+    }
+
+    setMaxNumberOfThreads(oldNumThreads);
+}
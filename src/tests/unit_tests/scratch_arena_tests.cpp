@@ -0,0 +1,85 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/scratch_arena.h>
+#include <jet/vector3.h>
+#include <gtest/gtest.h>
+#include <utility>
+
+using namespace jet;
+
+TEST(ScratchArena, Allocate) {
+    ScratchArena arena;
+
+    ScratchBuffer<double> buffer = arena.allocate<double>(1000);
+    EXPECT_EQ(1000u, buffer.size());
+    ASSERT_TRUE(buffer.data() != nullptr);
+
+    for (size_t i = 0; i < buffer.size(); ++i) {
+        buffer[i] = static_cast<double>(i);
+    }
+
+    auto acc = buffer.constAccessor();
+    EXPECT_EQ(1000u, acc.size());
+    EXPECT_EQ(999.0, acc[999]);
+
+    ScratchBuffer<Vector3D> vectors = arena.allocate<Vector3D>(10);
+    for (size_t i = 0; i < vectors.size(); ++i) {
+        EXPECT_EQ(Vector3D(), vectors[i]);
+    }
+
+    ScratchBuffer<int> empty = arena.allocate<int>(0);
+    EXPECT_EQ(0u, empty.size());
+    EXPECT_TRUE(empty.data() == nullptr);
+}
+
+TEST(ScratchArena, ReusesBlocks) {
+    ScratchArena arena;
+
+    const double* ptr = nullptr;
+    {
+        ScratchBuffer<double> buffer = arena.allocate<double>(1 << 20);
+        ptr = buffer.data();
+        EXPECT_EQ(0u, arena.numberOfCachedBytes());
+    }
+    EXPECT_LE((1u << 20) * sizeof(double), arena.numberOfCachedBytes());
+
+    const size_t numberOfHeapAllocations =
+        ScratchArena::numberOfHeapAllocations();
+    const size_t heapBytesAllocated = ScratchArena::heapBytesAllocated();
+
+    // Same size class
+    {
+        ScratchBuffer<double> buffer = arena.allocate<double>(1000000);
+        EXPECT_EQ(ptr, buffer.data());
+    }
+    EXPECT_EQ(numberOfHeapAllocations, ScratchArena::numberOfHeapAllocations());
+    EXPECT_EQ(heapBytesAllocated, ScratchArena::heapBytesAllocated());
+
+    arena.releaseCachedBlocks();
+    EXPECT_EQ(0u, arena.numberOfCachedBytes());
+}
+
+TEST(ScratchArena, Move) {
+    ScratchArena arena;
+
+    ScratchBuffer<double> buffer = arena.allocate<double>(100);
+    const double* ptr = buffer.data();
+
+    ScratchBuffer<double> buffer2(std::move(buffer));
+    EXPECT_EQ(0u, buffer.size());
+    EXPECT_EQ(100u, buffer2.size());
+    EXPECT_EQ(ptr, buffer2.data());
+
+    ScratchBuffer<double> buffer3;
+    buffer3 = std::move(buffer2);
+    EXPECT_EQ(100u, buffer3.size());
+    EXPECT_EQ(ptr, buffer3.data());
+    EXPECT_EQ(0u, arena.numberOfCachedBytes());
+
+    buffer3 = ScratchBuffer<double>();
+    EXPECT_LT(0u, arena.numberOfCachedBytes());
+}
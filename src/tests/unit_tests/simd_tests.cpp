@@ -0,0 +1,106 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/simd.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace jet;
+
+TEST(SimdDouble, Constructors) {
+    double values[kSimdDoubleWidth];
+
+    SimdDouble zero;
+    zero.store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(0.0, values[i]);
+    }
+
+    SimdDouble three(3.0);
+    three.store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(3.0, values[i]);
+    }
+}
+
+TEST(SimdDouble, LoadAndGather) {
+    std::vector<double> data = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+    const uint32_t indices[] = {7, 2, 5, 0};
+    double values[kSimdDoubleWidth];
+
+    SimdDouble::load(data.data() + 1).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(data[i + 1], values[i]);
+    }
+
+    SimdDouble::gather(data.data(), indices).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(data[indices[i]], values[i]);
+    }
+}
+
+TEST(SimdDouble, LaneMask) {
+    double values[kSimdDoubleWidth];
+
+    for (size_t n = 0; n <= kSimdDoubleWidth; ++n) {
+        SimdDouble::laneMask(n).store(values);
+        for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+            EXPECT_DOUBLE_EQ(i < n ? 1.0 : 0.0, values[i]);
+        }
+        EXPECT_DOUBLE_EQ(static_cast<double>(n), SimdDouble::laneMask(n).sum());
+    }
+}
+
+TEST(SimdDouble, Arithmetic) {
+    std::vector<double> a = {1.0, -2.0, 3.0, 0.0};
+    std::vector<double> b = {4.0, 5.0, -6.0, 2.0};
+    const SimdDouble va = SimdDouble::load(a.data());
+    const SimdDouble vb = SimdDouble::load(b.data());
+    double values[kSimdDoubleWidth];
+
+    double expectedSum = 0.0;
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        expectedSum += a[i] + b[i];
+    }
+    EXPECT_DOUBLE_EQ(expectedSum, (va + vb).sum());
+
+    (va - vb).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(a[i] - b[i], values[i]);
+    }
+
+    (va * vb).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(a[i] * b[i], values[i]);
+    }
+
+    (va / vb).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(a[i] / b[i], values[i]);
+    }
+
+    SimdDouble::min(va, vb).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(std::min(a[i], b[i]), values[i]);
+    }
+
+    SimdDouble::max(va, vb).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(std::max(a[i], b[i]), values[i]);
+    }
+
+    SimdDouble::sqrt(vb * vb).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(std::fabs(b[i]), values[i]);
+    }
+
+    SimdDouble::reciprocalIfPositive(va).store(values);
+    for (size_t i = 0; i < kSimdDoubleWidth; ++i) {
+        EXPECT_DOUBLE_EQ(a[i] > 0.0 ? 1.0 / a[i] : 0.0, values[i]);
+    }
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/face_centered_grid3.h>
+#include <jet/sparse_face_centered_grid3.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+Vector3D swirl(const Vector3D& pt) {
+    const Vector3D r = pt - Vector3D(0.25, 0.3, 0.35);
+    if (r.length() > 0.15) {
+        return Vector3D();
+    }
+    return Vector3D(-r.y, r.x, 0.5 * r.z);
+}
+
+}  // namespace
+
+TEST(SparseFaceCenteredGrid3, Constructors) {
+    SparseFaceCenteredGrid3 grid1;
+    EXPECT_EQ(Size3(0, 0, 0), grid1.resolution());
+    EXPECT_EQ(Size3(0, 0, 0), grid1.uSize());
+
+    SparseFaceCenteredGrid3 grid2(Size3(5, 4, 3), Vector3D(1.0, 2.0, 3.0),
+                                  Vector3D(4.0, 5.0, 6.0),
+                                  Vector3D(7.0, 8.0, 9.0));
+    EXPECT_EQ(Size3(6, 4, 3), grid2.uSize());
+    EXPECT_EQ(Size3(5, 5, 3), grid2.vSize());
+    EXPECT_EQ(Size3(5, 4, 4), grid2.wSize());
+    EXPECT_EQ(Vector3D(4.0, 6.0, 7.5), grid2.uOrigin());
+    EXPECT_EQ(Vector3D(4.5, 5.0, 7.5), grid2.vOrigin());
+    EXPECT_EQ(Vector3D(4.5, 6.0, 6.0), grid2.wOrigin());
+    EXPECT_EQ(0u, grid2.numberOfActiveTiles());
+    EXPECT_EQ(Vector3D(7.0, 8.0, 9.0), grid2.sample(Vector3D(6.0, 7.0, 8.0)));
+    EXPECT_EQ(Vector3D(7.0, 8.0, 9.0), grid2.valueAtCellCenter(1, 2, 1));
+    EXPECT_EQ(0.0, grid2.divergenceAtCellCenter(1, 2, 1));
+
+    auto grid3 = SparseFaceCenteredGrid3::builder()
+                     .withResolution(Size3(8, 8, 8))
+                     .withBackground(Vector3D(1.0, 0.0, 0.0))
+                     .makeShared();
+    grid3->uData().set(2, 2, 2, 3.0);
+    auto grid4 = grid3->clone();
+    EXPECT_EQ(3.0, grid4->u(2, 2, 2));
+    EXPECT_EQ(1.0, grid4->u(3, 2, 2));
+}
+
+TEST(SparseFaceCenteredGrid3, SampleMatchesDense) {
+    FaceCenteredGrid3 dense(Size3(30, 35, 40), Vector3D(0.025, 0.025, 0.025));
+    dense.fill(swirl);
+
+    SparseFaceCenteredGrid3 sparse(dense.resolution(), dense.gridSpacing());
+    sparse.copyFrom(dense);
+    EXPECT_LT(0u, sparse.numberOfActiveTiles());
+    EXPECT_LT(sparse.numberOfActiveTiles(), 3u * 4u * 5u * 5u);
+
+    SparseFaceCenteredGrid3 filled(dense.resolution(), dense.gridSpacing());
+    filled.fill(swirl);
+    EXPECT_EQ(sparse.numberOfActiveTiles(), filled.numberOfActiveTiles());
+
+    for (double x = -0.02; x < 0.8; x += 0.031) {
+        for (double y = -0.02; y < 0.9; y += 0.029) {
+            const Vector3D pt(x, y, 0.33);
+            const Vector3D a = dense.sample(pt);
+            const Vector3D b = sparse.sample(pt);
+            const Vector3D c = filled.sample(pt);
+            EXPECT_NEAR(a.x, b.x, 1e-12);
+            EXPECT_NEAR(a.y, b.y, 1e-12);
+            EXPECT_NEAR(a.z, b.z, 1e-12);
+            EXPECT_NEAR(a.x, c.x, 1e-12);
+            EXPECT_NEAR(a.y, c.y, 1e-12);
+            EXPECT_NEAR(a.z, c.z, 1e-12);
+        }
+    }
+
+    dense.forEachCellIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_DOUBLE_EQ(dense.divergenceAtCellCenter(i, j, k),
+                         sparse.divergenceAtCellCenter(i, j, k));
+    });
+
+    FaceCenteredGrid3 result(dense.resolution(), dense.gridSpacing(),
+                             Vector3D(), Vector3D(1.0, 2.0, 3.0));
+    sparse.copyTo(&result);
+    dense.forEachUIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(dense.u(i, j, k), result.u(i, j, k));
+    });
+    dense.forEachVIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(dense.v(i, j, k), result.v(i, j, k));
+    });
+    dense.forEachWIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(dense.w(i, j, k), result.w(i, j, k));
+    });
+}
+
+TEST(SparseFaceCenteredGrid3, Serialization) {
+    SparseFaceCenteredGrid3 grid1(Size3(10, 12, 9), Vector3D(1.0, 2.0, 3.0),
+                                  Vector3D(-5.0, 3.0, 1.0));
+    grid1.uData().set(10, 3, 4, 1.0);
+    grid1.vData().set(2, 12, 4, 2.0);
+    grid1.wData().set(2, 3, 9, 3.0);
+
+    std::vector<uint8_t> buffer;
+    grid1.serialize(&buffer);
+
+    FaceCenteredGrid3 dense;
+    dense.deserialize(buffer);
+    EXPECT_EQ(grid1.resolution(), dense.resolution());
+    EXPECT_EQ(1.0, dense.u(10, 3, 4));
+    EXPECT_EQ(2.0, dense.v(2, 12, 4));
+    EXPECT_EQ(3.0, dense.w(2, 3, 9));
+
+    SparseFaceCenteredGrid3 grid2;
+    grid2.deserialize(buffer);
+    EXPECT_EQ(grid1.resolution(), grid2.resolution());
+    EXPECT_EQ(3u, grid2.numberOfActiveTiles());
+    EXPECT_EQ(1.0, grid2.u(10, 3, 4));
+    EXPECT_EQ(2.0, grid2.v(2, 12, 4));
+    EXPECT_EQ(3.0, grid2.w(2, 3, 9));
+}
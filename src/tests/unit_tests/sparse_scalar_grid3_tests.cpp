@@ -0,0 +1,220 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/cell_centered_scalar_grid3.h>
+#include <jet/constant_vector_field3.h>
+#include <jet/mac_cormack_advection3.h>
+#include <jet/semi_lagrangian3.h>
+#include <jet/sparse_cell_centered_scalar_grid3.h>
+#include <jet/sparse_vertex_centered_scalar_grid3.h>
+#include <jet/vertex_centered_scalar_grid3.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace jet;
+
+namespace {
+
+double ball(const Vector3D& pt) {
+    const double r = pt.distanceTo(Vector3D(0.3, 0.4, 0.5));
+    return (r < 0.15) ? 1.0 - r : 0.0;
+}
+
+}  // namespace
+
+TEST(SparseCellCenteredScalarGrid3, Constructors) {
+    SparseCellCenteredScalarGrid3 grid1;
+    EXPECT_EQ(Size3(0, 0, 0), grid1.resolution());
+    EXPECT_EQ(Size3(0, 0, 0), grid1.dataSize());
+
+    SparseCellCenteredScalarGrid3 grid2(Size3(5, 4, 3),
+                                        Vector3D(1.0, 2.0, 3.0),
+                                        Vector3D(4.0, 5.0, 6.0), 7.0);
+    EXPECT_EQ(Size3(5, 4, 3), grid2.resolution());
+    EXPECT_EQ(Size3(5, 4, 3), grid2.dataSize());
+    EXPECT_DOUBLE_EQ(4.5, grid2.dataOrigin().x);
+    EXPECT_DOUBLE_EQ(6.0, grid2.dataOrigin().y);
+    EXPECT_DOUBLE_EQ(7.5, grid2.dataOrigin().z);
+    EXPECT_EQ(0u, grid2.data().numberOfActiveTiles());
+    EXPECT_EQ(7.0, grid2(4, 3, 2));
+    EXPECT_EQ(7.0, grid2.sample(Vector3D(5.0, 6.0, 7.0)));
+
+    grid2.data().set(1, 2, 0, 3.0);
+    SparseCellCenteredScalarGrid3 grid3(grid2);
+    EXPECT_EQ(3.0, grid3(1, 2, 0));
+    EXPECT_EQ(1u, grid3.data().numberOfActiveTiles());
+
+    auto grid4 = SparseCellCenteredScalarGrid3::builder()
+                     .withResolution(Size3(10, 20, 30))
+                     .withGridSpacing(Vector3D(0.1, 0.1, 0.1))
+                     .withBackground(-1.0)
+                     .makeShared();
+    EXPECT_EQ(Size3(10, 20, 30), grid4->dataSize());
+    EXPECT_EQ(-1.0, grid4->sample(Vector3D(0.5, 0.5, 0.5)));
+}
+
+TEST(SparseCellCenteredScalarGrid3, SampleMatchesDense) {
+    CellCenteredScalarGrid3 dense(Size3(40, 30, 35),
+                                  Vector3D(0.02, 0.03, 0.025));
+    dense.fill(ball);
+
+    SparseCellCenteredScalarGrid3 sparse(dense.resolution(),
+                                         dense.gridSpacing());
+    sparse.copyFrom(dense);
+    EXPECT_LT(sparse.data().numberOfActiveTiles(), 5u * 4u * 5u);
+
+    SparseCellCenteredScalarGrid3 filled(dense.resolution(),
+                                         dense.gridSpacing());
+    filled.fill(ball);
+    EXPECT_EQ(sparse.data().numberOfActiveTiles(),
+              filled.data().numberOfActiveTiles());
+
+    for (double x = -0.05; x < 0.9; x += 0.037) {
+        for (double y = -0.05; y < 0.95; y += 0.041) {
+            const Vector3D pt(x, y, 0.48);
+            EXPECT_NEAR(dense.sample(pt), sparse.sample(pt), 1e-12);
+            EXPECT_NEAR(dense.sample(pt), filled.sample(pt), 1e-12);
+            const Vector3D g = dense.gradient(pt);
+            const Vector3D h = sparse.gradient(pt);
+            EXPECT_NEAR(g.x, h.x, 1e-12);
+            EXPECT_NEAR(g.y, h.y, 1e-12);
+            EXPECT_NEAR(g.z, h.z, 1e-12);
+        }
+    }
+
+    CellCenteredScalarGrid3 result(dense.resolution(), dense.gridSpacing(),
+                                   Vector3D(), 5.0);
+    sparse.copyTo(&result);
+    dense.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(dense(i, j, k), result(i, j, k));
+    });
+}
+
+TEST(SparseCellCenteredScalarGrid3, Serialization) {
+    SparseCellCenteredScalarGrid3 grid1(Size3(15, 14, 13),
+                                        Vector3D(1.0, 2.0, 3.0),
+                                        Vector3D(-5.0, 3.0, 1.0));
+    grid1.data().set(3, 2, 1, 4.0);
+    grid1.data().set(14, 13, 12, -4.0);
+
+    std::vector<uint8_t> buffer;
+    grid1.serialize(&buffer);
+
+    // The dense and the sparse grids read each other.
+    CellCenteredScalarGrid3 dense;
+    dense.deserialize(buffer);
+    EXPECT_EQ(grid1.resolution(), dense.resolution());
+    EXPECT_EQ(4.0, dense(3, 2, 1));
+    EXPECT_EQ(-4.0, dense(14, 13, 12));
+
+    dense.serialize(&buffer);
+    SparseCellCenteredScalarGrid3 grid2;
+    grid2.deserialize(buffer);
+    EXPECT_EQ(grid1.resolution(), grid2.resolution());
+    EXPECT_DOUBLE_EQ(-5.0, grid2.origin().x);
+    EXPECT_EQ(2u, grid2.data().numberOfActiveTiles());
+    grid1.forEachCellIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(grid1(i, j, k), grid2(i, j, k));
+    });
+}
+
+TEST(SparseCellCenteredScalarGrid3, Swap) {
+    SparseCellCenteredScalarGrid3 grid1(Size3(5, 4, 3));
+    SparseCellCenteredScalarGrid3 grid2(Size3(9, 10, 11), Vector3D(1, 1, 1),
+                                        Vector3D(), 2.0);
+    grid1.data().set(1, 1, 1, 1.0);
+
+    grid1.swap(&grid2);
+    EXPECT_EQ(Size3(9, 10, 11), grid1.resolution());
+    EXPECT_EQ(2.0, grid1(1, 1, 1));
+    EXPECT_EQ(Size3(5, 4, 3), grid2.resolution());
+    EXPECT_EQ(1.0, grid2(1, 1, 1));
+}
+
+TEST(SparseVertexCenteredScalarGrid3, SampleMatchesDense) {
+    VertexCenteredScalarGrid3 dense(Size3(30, 20, 25),
+                                    Vector3D(0.03, 0.04, 0.035),
+                                    Vector3D(0.01, -0.02, 0.0), 0.5);
+    dense.fill([](const Vector3D& pt) { return ball(pt) + 0.5; });
+
+    SparseVertexCenteredScalarGrid3 sparse(dense.resolution(),
+                                           dense.gridSpacing(),
+                                           dense.origin(), 0.5);
+    EXPECT_EQ(dense.dataSize(), sparse.dataSize());
+    EXPECT_EQ(dense.dataOrigin(), sparse.dataOrigin());
+
+    sparse.copyFrom(dense);
+    EXPECT_LT(0u, sparse.data().numberOfActiveTiles());
+
+    size_t count = 0;
+    sparse.forEachActiveDataPointIndex(
+        [&](size_t, size_t, size_t) { ++count; });
+    EXPECT_LT(count, dense.dataSize().x * dense.dataSize().y *
+                         dense.dataSize().z);
+
+    for (double x = 0.0; x < 1.0; x += 0.043) {
+        for (double z = 0.0; z < 1.0; z += 0.039) {
+            const Vector3D pt(x, 0.41, z);
+            EXPECT_NEAR(dense.sample(pt), sparse.sample(pt), 1e-12);
+        }
+    }
+
+    auto clone = sparse.clone();
+    EXPECT_EQ(sparse.data().numberOfActiveTiles(),
+              clone->data().numberOfActiveTiles());
+    EXPECT_DOUBLE_EQ(sparse.sample(Vector3D(0.3, 0.4, 0.5)),
+                     clone->sample(Vector3D(0.3, 0.4, 0.5)));
+}
+
+TEST(SparseCellCenteredScalarGrid3, AdvectMatchesDense) {
+    const Size3 res(40, 30, 35);
+    const Vector3D h(0.025, 0.025, 0.025);
+    ConstantVectorField3 flow(Vector3D(1.0, 0.5, -0.25));
+
+    // The boundary is a sphere stored in a sparse grid and in a dense grid,
+    // so both the sparse and the dense boundary samplers are used.
+    auto sphere = [](const Vector3D& pt) {
+        const double r = pt.distanceTo(Vector3D(0.5, 0.35, 0.4)) - 0.1;
+        return std::min(r, 0.2);
+    };
+    CellCenteredScalarGrid3 denseBoundary(res, h);
+    denseBoundary.fill(sphere);
+    SparseCellCenteredScalarGrid3 sparseBoundary(res, h, Vector3D(), 0.2);
+    sparseBoundary.fill(sphere);
+    EXPECT_LT(0u, sparseBoundary.data().numberOfActiveTiles());
+
+    CellCenteredScalarGrid3 denseInput(res, h);
+    denseInput.fill(ball);
+    SparseCellCenteredScalarGrid3 sparseInput(res, h);
+    sparseInput.fill(ball);
+
+    SemiLagrangian3 semiLagrangian;
+    CellCenteredScalarGrid3 denseOutput(denseInput);
+    semiLagrangian.advect(denseInput, flow, 0.05, &denseOutput,
+                          denseBoundary);
+    SparseCellCenteredScalarGrid3 sparseOutput(res, h);
+    semiLagrangian.advect(sparseInput, flow, 0.05, &sparseOutput,
+                          sparseBoundary);
+
+    EXPECT_LT(0u, sparseOutput.data().numberOfActiveTiles());
+    EXPECT_LT(sparseOutput.data().numberOfActiveTiles(), 5u * 4u * 5u);
+    denseOutput.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(denseOutput(i, j, k), sparseOutput(i, j, k), 1e-12);
+    });
+
+    // The solvers without a sparse path advect a dense copy.
+    MacCormackAdvection3 macCormack;
+    macCormack.advect(denseInput, flow, 0.05, &denseOutput, denseBoundary);
+    AdvectionSolver3& solver = macCormack;
+    solver.advect(sparseInput, flow, 0.05, &sparseOutput, sparseBoundary);
+
+    EXPECT_LT(sparseOutput.data().numberOfActiveTiles(), 5u * 4u * 5u);
+    denseOutput.forEachDataPointIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_NEAR(denseOutput(i, j, k), sparseOutput(i, j, k), 1e-12);
+    });
+}
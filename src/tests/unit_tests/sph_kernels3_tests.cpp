@@ -111,3 +111,37 @@ TEST(SphSpikyKernel3, SecondDerivative) {
     EXPECT_LT(value1, value0);
     EXPECT_LT(value2, value1);
 }
+
+TEST(SphStdKernel3, SimdEvaluation) {
+    SphStdKernel3 kernel(10.0);
+
+    for (int i = 0; i <= 12; ++i) {
+        const double dist = static_cast<double>(i);
+        const SimdDouble simdDist(dist);
+        EXPECT_NEAR(kernel(dist), kernel(simdDist).sum() / kSimdDoubleWidth,
+                    1e-12);
+        EXPECT_NEAR(kernel.firstDerivative(dist),
+                    kernel.firstDerivative(simdDist).sum() / kSimdDoubleWidth,
+                    1e-12);
+        EXPECT_NEAR(kernel.secondDerivative(dist),
+                    kernel.secondDerivative(simdDist).sum() / kSimdDoubleWidth,
+                    1e-12);
+    }
+}
+
+TEST(SphSpikyKernel3, SimdEvaluation) {
+    SphSpikyKernel3 kernel(10.0);
+
+    for (int i = 0; i <= 12; ++i) {
+        const double dist = static_cast<double>(i);
+        const SimdDouble simdDist(dist);
+        EXPECT_NEAR(kernel(dist), kernel(simdDist).sum() / kSimdDoubleWidth,
+                    1e-12);
+        EXPECT_NEAR(kernel.firstDerivative(dist),
+                    kernel.firstDerivative(simdDist).sum() / kSimdDoubleWidth,
+                    1e-12);
+        EXPECT_NEAR(kernel.secondDerivative(dist),
+                    kernel.secondDerivative(simdDist).sum() / kSimdDoubleWidth,
+                    1e-12);
+    }
+}
@@ -4,6 +4,7 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/triangle_point_generator.h>
 #include <jet/sph_solver2.h>
 #include <gtest/gtest.h>
 
@@ -61,3 +62,31 @@ TEST(SphSolver2, Parameters) {
 
     EXPECT_TRUE(solver.sphSystemData() != nullptr);
 }
+
+TEST(SphSolver2, SoaLayout) {
+    Array1<Vector2D> points;
+    TrianglePointGenerator pointsGenerator;
+    BoundingBox2D bbox(Vector2D(0, 0), Vector2D(0.5, 0.5));
+    pointsGenerator.generate(bbox, 0.05, &points);
+
+    SphSolver2 aosSolver;
+    aosSolver.sphSystemData()->setTargetSpacing(0.05);
+    aosSolver.sphSystemData()->addParticles(points);
+
+    SphSolver2 soaSolver;
+    soaSolver.sphSystemData()->setTargetSpacing(0.05);
+    soaSolver.sphSystemData()->addParticles(points);
+    soaSolver.sphSystemData()->setIsUsingSoaLayout(true);
+
+    for (Frame frame(0, 1.0 / 60.0); frame.index < 3; ++frame) {
+        aosSolver.update(frame);
+        soaSolver.update(frame);
+    }
+
+    // Vectorized kernels only change the summation order
+    auto aosPositions = aosSolver.sphSystemData()->positions();
+    auto soaPositions = soaSolver.sphSystemData()->positions();
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_NEAR(0.0, aosPositions[i].distanceTo(soaPositions[i]), 1e-9);
+    }
+}
@@ -4,6 +4,7 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/triangle_point_generator.h>
 #include <jet/sph_system_data2.h>
 #include <gtest/gtest.h>
 #include <vector>
@@ -138,3 +139,28 @@ TEST(SphSystemData2, Serialization) {
         }
     }
 }
+
+TEST(SphSystemData2, SoaLayoutDensities) {
+    Array1<Vector2D> points;
+    TrianglePointGenerator pointsGenerator;
+    BoundingBox2D bbox(Vector2D(0, 0), Vector2D(1, 1));
+    pointsGenerator.generate(bbox, 0.1, &points);
+
+    SphSystemData2 data;
+    data.setTargetSpacing(0.1);
+    data.addParticles(points);
+    data.buildNeighborSearcher();
+    data.buildNeighborLists();
+    data.updateDensities();
+
+    auto densities = data.densities();
+    std::vector<double> expected(densities.begin(), densities.end());
+
+    data.setIsUsingSoaLayout(true);
+    data.buildNeighborLists();
+    data.updateDensities();
+
+    for (size_t i = 0; i < data.numberOfParticles(); ++i) {
+        EXPECT_NEAR(expected[i], densities[i], 1e-9 * expected[i]);
+    }
+}
@@ -4,6 +4,7 @@
 // personal capacity and am not conveying any rights to any intellectual
 // property of any third parties.
 
+#include <jet/bcc_lattice_point_generator.h>
 #include <jet/sph_system_data3.h>
 #include <gtest/gtest.h>
 #include <vector>
@@ -140,3 +141,28 @@ TEST(SphSystemData3, Serialization) {
         }
     }
 }
+
+TEST(SphSystemData3, SoaLayoutDensities) {
+    Array1<Vector3D> points;
+    BccLatticePointGenerator pointsGenerator;
+    BoundingBox3D bbox(Vector3D(0, 0, 0), Vector3D(1, 1, 1));
+    pointsGenerator.generate(bbox, 0.1, &points);
+
+    SphSystemData3 data;
+    data.setTargetSpacing(0.1);
+    data.addParticles(points);
+    data.buildNeighborSearcher();
+    data.buildNeighborLists();
+    data.updateDensities();
+
+    auto densities = data.densities();
+    std::vector<double> expected(densities.begin(), densities.end());
+
+    data.setIsUsingSoaLayout(true);
+    data.buildNeighborLists();
+    data.updateDensities();
+
+    for (size_t i = 0; i < data.numberOfParticles(); ++i) {
+        EXPECT_NEAR(expected[i], densities[i], 1e-9 * expected[i]);
+    }
+}
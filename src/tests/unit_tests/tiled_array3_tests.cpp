@@ -0,0 +1,158 @@
+// Copyright (c) 2018 Doyub Kim
+//
+// I am making my contributions/submissions to this project solely in my
+// personal capacity and am not conveying any rights to any intellectual
+// property of any third parties.
+
+#include <jet/array3.h>
+#include <jet/tiled_array3.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+using namespace jet;
+
+TEST(TiledArray3, Constructors) {
+    TiledArray3<double> arr0;
+    EXPECT_EQ(Size3(0, 0, 0), arr0.size());
+    EXPECT_EQ(0u, arr0.numberOfActiveTiles());
+
+    TiledArray3<double> arr1(Size3(17, 8, 9), 3.0);
+    EXPECT_EQ(Size3(17, 8, 9), arr1.size());
+    EXPECT_EQ(Size3(3, 1, 2), arr1.tileResolution());
+    EXPECT_EQ(3.0, arr1.background());
+    EXPECT_EQ(0u, arr1.numberOfActiveTiles());
+    EXPECT_EQ(3.0, arr1(16, 7, 8));
+    EXPECT_FALSE(arr1.isActive(16, 7, 8));
+}
+
+TEST(TiledArray3, SetAndActivate) {
+    TiledArray3<double> arr(Size3(20, 20, 20), -1.0);
+
+    // Setting the background value does not activate the tile.
+    arr.set(3, 4, 5, -1.0);
+    EXPECT_EQ(0u, arr.numberOfActiveTiles());
+
+    arr.set(3, 4, 5, 2.0);
+    EXPECT_EQ(1u, arr.numberOfActiveTiles());
+    EXPECT_TRUE(arr.isTileActive(0, 0, 0));
+    EXPECT_TRUE(arr.isActive(7, 7, 7));
+    EXPECT_EQ(2.0, arr(3, 4, 5));
+    EXPECT_EQ(-1.0, arr(3, 4, 6));
+    EXPECT_EQ(nullptr, arr.find(8, 0, 0));
+
+    arr.set(19, 19, 19, 5.0);
+    EXPECT_EQ(2u, arr.numberOfActiveTiles());
+    EXPECT_TRUE(arr.isTileActive(2, 2, 2));
+    EXPECT_EQ(5.0, *arr.find(19, 19, 19));
+
+    *arr.find(16, 17, 18) = 7.0;
+    EXPECT_EQ(7.0, arr(16, 17, 18));
+
+    // Deactivating the first tile moves the last one into its slot.
+    arr.deactivateTile(0, 0, 0);
+    EXPECT_EQ(1u, arr.numberOfActiveTiles());
+    EXPECT_EQ(-1.0, arr(3, 4, 5));
+    EXPECT_EQ(5.0, arr(19, 19, 19));
+    EXPECT_EQ(7.0, arr(16, 17, 18));
+
+    arr.clear();
+    EXPECT_EQ(0u, arr.numberOfActiveTiles());
+    EXPECT_EQ(-1.0, arr(19, 19, 19));
+}
+
+TEST(TiledArray3, Prune) {
+    TiledArray3<double> arr(Size3(24, 8, 8));
+    arr.set(0, 0, 0, 1e-3);
+    arr.set(8, 0, 0, 1.0);
+    arr.set(16, 0, 0, 2.0);
+    arr.set(0, 0, 0, 0.0);
+    EXPECT_EQ(3u, arr.numberOfActiveTiles());
+
+    arr.prune();
+    EXPECT_EQ(2u, arr.numberOfActiveTiles());
+    EXPECT_FALSE(arr.isTileActive(0, 0, 0));
+    EXPECT_EQ(1.0, arr(8, 0, 0));
+    EXPECT_EQ(2.0, arr(16, 0, 0));
+
+    arr.set(20, 1, 1, 1e-3);
+    arr.set(16, 0, 0, 1e-3);
+    arr.prune(1e-2);
+    EXPECT_EQ(1u, arr.numberOfActiveTiles());
+    EXPECT_EQ(1.0, arr(8, 0, 0));
+
+    // The remaining tiles keep their order.
+    std::vector<size_t> tiles;
+    arr.forEachActiveTile([&](size_t ti, size_t tj, size_t tk) {
+        tiles.push_back(ti + 3 * (tj + tk));
+    });
+    EXPECT_EQ(std::vector<size_t>({1}), tiles);
+}
+
+TEST(TiledArray3, DenseConversion) {
+    Array3<double> dense(Size3(21, 10, 13), 1.0);
+    dense(2, 3, 4) = 5.0;
+    dense(20, 9, 12) = -2.0;
+    dense(10, 1, 9) = 1.0 + 1e-6;
+
+    TiledArray3<double> arr(dense.size(), 1.0);
+    arr.copyFrom(dense.constAccessor(), 1e-3);
+    EXPECT_EQ(2u, arr.numberOfActiveTiles());
+    EXPECT_TRUE(arr.isTileActive(0, 0, 0));
+    EXPECT_TRUE(arr.isTileActive(2, 1, 1));
+
+    arr.copyFrom(dense.constAccessor());
+    EXPECT_EQ(3u, arr.numberOfActiveTiles());
+
+    Array3<double> result(dense.size(), 0.0);
+    arr.copyTo(result.accessor());
+    dense.forEachIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_EQ(dense(i, j, k), result(i, j, k));
+        EXPECT_EQ(dense(i, j, k), arr(i, j, k));
+    });
+}
+
+TEST(TiledArray3, ForEachActiveIndex) {
+    TiledArray3<double> arr(Size3(12, 9, 10));
+    arr.set(1, 1, 1, 1.0);
+    arr.set(11, 8, 9, 2.0);
+
+    // Only the indices within the array size are visited.
+    size_t count = 0;
+    arr.forEachActiveIndex([&](size_t i, size_t j, size_t k) {
+        EXPECT_TRUE(arr.isActive(i, j, k));
+        EXPECT_LT(i, 12u);
+        EXPECT_LT(j, 9u);
+        EXPECT_LT(k, 10u);
+        ++count;
+    });
+    EXPECT_EQ(8u * 8u * 8u + 4u * 1u * 2u, count);
+
+    std::atomic<size_t> parallelCount(0);
+    arr.parallelForEachActiveIndex([&](size_t i, size_t j, size_t k) {
+        *arr.find(i, j, k) += 1.0;
+        ++parallelCount;
+    });
+    EXPECT_EQ(count, parallelCount.load());
+    EXPECT_EQ(2.0, arr(1, 1, 1));
+    EXPECT_EQ(3.0, arr(11, 8, 9));
+    EXPECT_EQ(1.0, arr(0, 0, 0));
+    EXPECT_EQ(0.0, arr(8, 0, 0));
+
+    std::atomic<size_t> tileCount(0);
+    arr.parallelForEachActiveTile([&](size_t ti, size_t tj, size_t tk) {
+        EXPECT_TRUE(arr.isTileActive(ti, tj, tk));
+        ++tileCount;
+    });
+    EXPECT_EQ(2u, tileCount.load());
+}
+
+TEST(TiledArray3, MemoryUsage) {
+    TiledArray3<double> arr(Size3(64, 64, 64));
+    const size_t empty = arr.memoryUsage();
+    EXPECT_LT(empty, 64u * 64u * 64u * sizeof(double) / 100u);
+
+    arr.activateTile(1, 2, 3);
+    EXPECT_LE(empty + 512u * sizeof(double), arr.memoryUsage());
+}
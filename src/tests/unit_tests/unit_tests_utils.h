@@ -10,6 +10,11 @@
 #include <gtest/gtest.h>
 #include <jet/vector3.h>
 
+#include <ostream>
+
+// Returns the stream that main writes the logs of the unit tests to.
+std::ostream* getUnitTestsLogStream();
+
 #define EXPECT_VECTOR2_EQ(expected, actual)     \
     EXPECT_DOUBLE_EQ((expected).x, (actual).x); \
     EXPECT_DOUBLE_EQ((expected).y, (actual).y);